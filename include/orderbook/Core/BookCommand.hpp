@@ -0,0 +1,74 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "LatencyTrace.hpp"
+#include "../Utilities/InlineVector.hpp"
+#include <string>
+
+namespace orderbook {
+
+/**
+ * @brief Book operation, applied one at a time or in batches
+ *
+ * The order record carries everything each operation needs: symbol_id
+ * routes the command, id names the order, and price/quantity are the new
+ * values for a modify. A mass cancel uses account_id instead of id
+ * (EmptyId = every order in the book).
+ */
+struct BookCommand {
+    enum class Type : uint8_t { Add, Cancel, Modify, MassCancel };
+
+    Order order;
+    Type type = Type::Add;
+    uint32_t source = 0;        // Caller-defined origin (e.g. session index)
+    uint64_t tag = 0;           // Caller-defined correlation value echoed in the result
+    bool risk_prechecked = false;   // Stateless risk checks already passed; the book runs the position check only
+    LatencyTrace* trace = nullptr;  // Stamped by the book for an Add when set; must outlive the command
+
+    static BookCommand add(const Order& order, uint32_t source = 0, uint64_t tag = 0) {
+        return BookCommand{order, Type::Add, source, tag};
+    }
+
+    static BookCommand cancel(SymbolId symbol, OrderId id, uint32_t source = 0, uint64_t tag = 0) {
+        Order order;
+        order.id = id;
+        order.symbol_id = symbol;
+        return BookCommand{order, Type::Cancel, source, tag};
+    }
+
+    static BookCommand modify(SymbolId symbol, OrderId id, Price new_price, Quantity new_quantity,
+                              uint32_t source = 0, uint64_t tag = 0) {
+        Order order;
+        order.id = id;
+        order.symbol_id = symbol;
+        order.price = new_price;
+        order.quantity = new_quantity;
+        return BookCommand{order, Type::Modify, source, tag};
+    }
+
+    static BookCommand massCancel(SymbolId symbol, AccountId account = InternTable::EmptyId,
+                                  uint32_t source = 0, uint64_t tag = 0) {
+        Order order;
+        order.symbol_id = symbol;
+        order.account_id = account;
+        return BookCommand{order, Type::MassCancel, source, tag};
+    }
+};
+
+/**
+ * @brief Outcome of a BookCommand
+ */
+struct BookCommandResult {
+    BookCommand::Type type = BookCommand::Type::Add;
+    bool success = false;
+    OrderId order_id{0};
+    SymbolId symbol_id = 0;
+    uint32_t source = 0;
+    uint64_t tag = 0;
+    size_t cancelled = 0;       // Orders removed by a MassCancel
+    Quantity resting = 0;       // Quantity an Add or Modify left in the book (0 = not resting)
+    InlineVector<Trade, 4> trades;  // Trades an Add generated
+    std::string error;          // Empty on success
+};
+
+}
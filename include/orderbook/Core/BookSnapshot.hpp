@@ -0,0 +1,62 @@
+#pragma once
+#include "Types.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace orderbook {
+
+/**
+ * @brief First bytes of one book's snapshot section
+ *
+ * A section is the header, the symbol name, the account name table and then
+ * every resting order, bids before asks, each side from the best level out
+ * and each level in queue order. Reading the orders back in sequence and
+ * appending each to its level rebuilds the queues, levels and order index
+ * exactly. Fields are read with memcpy, so sections need no alignment.
+ */
+struct BookSnapshotHeader {
+    static constexpr uint64_t Magic = 0x50414E534B4F4F42ull;   // "BOOKSNAP", little-endian
+    static constexpr uint32_t Version = 1;
+
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t order_record_size;
+    uint64_t section_size;          // Whole section, header included
+    uint64_t journal_sequence;      // Last journal record reflected in the section (0 = none)
+    uint64_t next_trade_id;         // Trade ID counter when taken
+    uint64_t book_sequence;         // Market data sequence when taken
+    int64_t taken_ns;
+    double tick_size;
+    uint64_t order_count;
+    uint32_t account_count;
+    uint32_t symbol_length;
+};
+
+/**
+ * @brief Account table entry: the ID orders in the section use, then length name bytes
+ */
+struct BookSnapshotName {
+    uint32_t id;
+    uint32_t length;
+};
+
+/**
+ * @brief One resting order
+ */
+struct BookSnapshotOrder {
+    uint64_t order_id;
+    PriceTicks ticks;
+    Quantity quantity;
+    Quantity filled_quantity;
+    int64_t entered_ns;             // OrderMetadata timestamp
+    uint32_t account_id;            // Section account table ID
+    uint8_t side;
+    uint8_t type;
+    uint8_t tif;
+    uint8_t status;
+};
+
+static_assert(std::is_trivially_copyable<BookSnapshotHeader>::value, "Snapshot header must be POD");
+static_assert(sizeof(BookSnapshotOrder) == 48, "Snapshot order layout is part of the file format");
+
+}
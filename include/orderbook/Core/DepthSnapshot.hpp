@@ -0,0 +1,149 @@
+#pragma once
+#include "Types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief A reader's consistent copy of a DepthSnapshot, with depth queries
+ *
+ * Levels are stored best first as parallel arrays (ticks, quantity and
+ * price * quantity per level). Cumulative quantity and notional are built
+ * with vectorized prefix sums when the copy is taken, so every query is a
+ * binary search over monotonic arrays. Queries only see the mirrored
+ * levels: sizes beyond them have no answer.
+ *
+ * Reuse one view per reader thread; its arrays are sized once.
+ */
+class DepthView {
+public:
+    /**
+     * @brief One side of the book, best level first
+     */
+    struct Levels {
+        std::vector<PriceTicks> ticks;
+        std::vector<Quantity> quantity;
+        std::vector<double> notional;               // Price * quantity per level
+        std::vector<Quantity> cumulative_quantity;  // Through each level, inclusive
+        std::vector<double> cumulative_notional;
+        size_t count = 0;
+    };
+
+    /**
+     * @brief Quantity resting at or better than a price
+     * @param side Book side to walk (Buy = bids, Sell = asks)
+     * @param limit Worst price to include
+     */
+    Quantity quantityTo(Side side, Price limit) const;
+
+    /**
+     * @brief Average price of filling a size against one side
+     * @param side Book side to walk (Sell = asks for a buyer)
+     * @param size Quantity to fill
+     * @return VWAP, or nullopt if the mirrored levels hold less than size (or size is 0)
+     */
+    std::optional<Price> vwapTo(Side side, Quantity size) const;
+
+    /**
+     * @brief Worst price reached when filling a size against one side
+     * @param side Book side to walk
+     * @param size Quantity that must be available
+     * @return Price of the level that completes size, or nullopt if the mirrored levels hold less
+     */
+    std::optional<Price> priceFor(Side side, Quantity size) const;
+
+    const Levels& levels(Side side) const { return side == Side::Buy ? bids_ : asks_; }
+    SequenceNumber getBookSequence() const { return book_sequence_; }
+    uint64_t getVersion() const { return version_; }
+
+private:
+    friend class DepthSnapshot;
+
+    Levels bids_;
+    Levels asks_;
+    TickSize tick_size_;
+    SequenceNumber book_sequence_ = 0;
+    uint64_t version_ = 0;
+
+    /**
+     * @brief Index of the level at which cumulative quantity first reaches size
+     * @return Level index, or count if the side holds less
+     */
+    size_t levelFilling(const Levels& levels, Quantity size) const;
+};
+
+/**
+ * @brief Seqlocked structure-of-arrays mirror of a book's top levels
+ *
+ * The owning book's matching thread rewrites the mirror after changes that
+ * reach the mirrored levels (beginWrite, writeLevel, endWrite). Readers on
+ * any thread copy it with read(), retrying while a write is in progress;
+ * they never block or slow the writer. A write only costs one pass over the
+ * mirrored levels.
+ *
+ * The level arrays hold atomics accessed relaxed, so a copy that overlaps a
+ * write is well defined and is simply discarded by the version check.
+ */
+class DepthSnapshot {
+public:
+    /**
+     * @param levels Levels mirrored per side
+     * @param tick_size Tick size of the owning book
+     */
+    DepthSnapshot(size_t levels, TickSize tick_size);
+
+    DepthSnapshot(const DepthSnapshot&) = delete;
+    DepthSnapshot& operator=(const DepthSnapshot&) = delete;
+
+    /**
+     * @brief Take a consistent copy and build its prefix sums (any thread)
+     * @param view Reader's view, resized on first use
+     */
+    void read(DepthView& view) const;
+
+    size_t capacity() const { return capacity_; }
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+    // Writer side: the owning book's matching thread only
+
+    /**
+     * @brief Whether a change at this price can alter the mirrored levels
+     */
+    bool covers(Side side, PriceTicks ticks) const;
+
+    void beginWrite();
+    void writeLevel(Side side, size_t index, PriceTicks ticks, Quantity quantity, Price price);
+
+    /**
+     * @brief Publish the levels written since beginWrite()
+     * @param bid_count Bid levels written
+     * @param ask_count Ask levels written
+     * @param book_sequence Book sequence the levels reflect
+     */
+    void endWrite(size_t bid_count, size_t ask_count, SequenceNumber book_sequence);
+
+private:
+    struct Levels {
+        std::unique_ptr<std::atomic<PriceTicks>[]> ticks;
+        std::unique_ptr<std::atomic<Quantity>[]> quantity;
+        std::unique_ptr<std::atomic<double>[]> notional;
+        std::atomic<size_t> count{0};
+        size_t written = 0;         // Writer's copy of count
+    };
+
+    const size_t capacity_;
+    const TickSize tick_size_;
+    Levels bids_;
+    Levels asks_;
+    std::atomic<SequenceNumber> book_sequence_{0};
+    std::atomic<uint64_t> version_{0};      // Odd while a write is in progress
+
+    Levels& sideOf(Side side) { return side == Side::Buy ? bids_ : asks_; }
+};
+
+}
@@ -1,11 +1,30 @@
 #pragma once
 #include "Types.hpp"
+#include "InternTable.hpp"
 #include <memory>
 #include <vector>
 #include <functional>
+#include <optional>
+#include <atomic>
+
+// Compile-time log floor: levels below this are removed entirely (0=DEBUG .. 3=ERROR)
+#ifndef ORDERBOOK_MIN_LOG_LEVEL
+#define ORDERBOOK_MIN_LOG_LEVEL 0
+#endif
 
 namespace orderbook {
 
+// Held as a constant rather than compared as a literal, so a floor of 0 does
+// not turn every check into an always-true comparison (-Wtype-limits)
+constexpr int MinLogLevel = ORDERBOOK_MIN_LOG_LEVEL;
+
+/**
+ * @brief Check whether a level survives the compile-time log floor
+ */
+constexpr bool isLogLevelCompiled(LogLevel level) {
+    return static_cast<int>(level) >= MinLogLevel;
+}
+
 // Forward declarations
 class Order;
 class Trade;
@@ -36,6 +55,7 @@ struct MarketDepth {
     std::vector<Level> bids;
     std::vector<Level> asks;
     Timestamp timestamp;
+    SymbolId symbol_id = 0;
 };
 
 struct BestPrices {
@@ -44,6 +64,7 @@ struct BestPrices {
     std::optional<Quantity> bid_size;
     std::optional<Quantity> ask_size;
     Timestamp timestamp;
+    SymbolId symbol_id = 0;
 };
 
 // Abstract interfaces
@@ -75,6 +96,38 @@ public:
      * @return Portfolio reference
      */
     virtual const Portfolio& getPortfolio(const std::string& account) const = 0;
+    
+    /**
+     * @brief Pre-trade check keyed by the order's interned account and symbol IDs
+     * @param order The order to validate
+     * @return RiskCheck result with approval/rejection and reason
+     */
+    virtual RiskCheck checkOrder(const Order& order) = 0;
+    
+    /**
+     * @brief The checks that read no position state (size, price bands)
+     *
+     * Safe to call from any thread, so they can run ahead of matching on the
+     * submitting thread; checkOrder() is this plus checkOrderPosition().
+     * @param order The order to validate
+     * @return RiskCheck result with approval/rejection and reason
+     */
+    virtual RiskCheck checkOrderStateless(const Order& order) const = 0;
+    
+    /**
+     * @brief The position-dependent check alone, for orders already through checkOrderStateless()
+     * @param order The order to validate
+     * @return RiskCheck result with approval/rejection and reason
+     */
+    virtual RiskCheck checkOrderPosition(const Order& order) = 0;
+    
+    /**
+     * @brief Update both accounts' positions after a fill
+     * @param trade The executed trade
+     * @param buy_account Interned account of the buy order
+     * @param sell_account Interned account of the sell order
+     */
+    virtual void onFill(const Trade& trade, AccountId buy_account, AccountId sell_account) = 0;
 };
 
 /**
@@ -115,6 +168,47 @@ public:
     virtual void subscribe(std::function<void(const std::string&)> callback) = 0;
 };
 
+/**
+ * @brief Interface for journaling book activity, e.g. to a write-ahead log
+ *
+ * Books call it on their matching thread: each inbound operation before it
+ * is applied, rejected ones included, and each trade as it executes. Books
+ * on different threads may share one journal.
+ */
+class IOrderJournal {
+public:
+    virtual ~IOrderJournal() = default;
+    
+    /**
+     * @brief Record an incoming order
+     * @param symbol Book the order was sent to
+     * @param order The order as received
+     */
+    virtual void recordAdd(SymbolId symbol, const Order& order) = 0;
+    
+    /**
+     * @brief Record a cancel request
+     * @param symbol Book the request was sent to
+     * @param id Order to cancel
+     */
+    virtual void recordCancel(SymbolId symbol, OrderId id) = 0;
+    
+    /**
+     * @brief Record a modify request
+     * @param symbol Book the request was sent to
+     * @param id Order to modify
+     * @param new_price New price (0 = unchanged)
+     * @param new_quantity New quantity (0 = unchanged)
+     */
+    virtual void recordModify(SymbolId symbol, OrderId id, Price new_price, Quantity new_quantity) = 0;
+    
+    /**
+     * @brief Record an executed trade
+     * @param trade The executed trade
+     */
+    virtual void recordTrade(const Trade& trade) = 0;
+};
+
 /**
  * @brief Interface for structured logging
  */
@@ -122,6 +216,17 @@ class ILogger {
 public:
     virtual ~ILogger() = default;
     
+    /**
+     * @brief Check whether a level would be logged
+     * Non-virtual so a filtered call site costs one load and one branch
+     * @param level Log level
+     * @return true if messages at this level are emitted
+     */
+    bool isEnabled(LogLevel level) const {
+        return isLogLevelCompiled(level) &&
+               level >= enabled_level_.load(std::memory_order_relaxed);
+    }
+    
     /**
      * @brief Log a message at specified level
      * @param level Log level
@@ -174,11 +279,42 @@ public:
      * @param level Minimum level to log
      */
     virtual void setLogLevel(LogLevel level) = 0;
+
+protected:
+    /**
+     * @brief Publish the runtime level used by isEnabled()
+     * @param level Minimum level to emit
+     */
+    void setEnabledLevel(LogLevel level) {
+        enabled_level_.store(level, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<LogLevel> enabled_level_{LogLevel::DEBUG};
 };
 
+/**
+ * @brief Log with deferred formatting
+ * The message and context expressions are only evaluated when the level is enabled,
+ * and levels below ORDERBOOK_MIN_LOG_LEVEL compile away.
+ */
+#define ORDERBOOK_LOG(logger, level, message, context)                               \
+    do {                                                                             \
+        if (::orderbook::isLogLevelCompiled(level) &&                                \
+            (logger) && (logger)->isEnabled(level)) {                                \
+            (logger)->log((level), (message), (context));                            \
+        }                                                                            \
+    } while (0)
+
+#define LOG_DEBUG(logger, message, context) ORDERBOOK_LOG(logger, ::orderbook::LogLevel::DEBUG, message, context)
+#define LOG_INFO(logger, message, context)  ORDERBOOK_LOG(logger, ::orderbook::LogLevel::INFO, message, context)
+#define LOG_WARN(logger, message, context)  ORDERBOOK_LOG(logger, ::orderbook::LogLevel::WARN, message, context)
+#define LOG_ERROR(logger, message, context) ORDERBOOK_LOG(logger, ::orderbook::LogLevel::ERROR, message, context)
+
 // Convenience type aliases for shared pointers
 using RiskManagerPtr = std::shared_ptr<IRiskManager>;
 using MarketDataPublisherPtr = std::shared_ptr<IMarketDataPublisher>;
 using LoggerPtr = std::shared_ptr<ILogger>;
+using OrderJournalPtr = std::shared_ptr<IOrderJournal>;
 
 }
\ No newline at end of file
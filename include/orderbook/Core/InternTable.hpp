@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <mutex>
+
+namespace orderbook {
+
+// Small integer handles for interned strings
+using SymbolId = uint32_t;
+using AccountId = uint32_t;
+
+/**
+ * @brief Thread-safe string interning table
+ *
+ * Maps strings such as symbols and account names to dense 32-bit IDs so hot
+ * structures can carry an integer instead of a std::string. ID 0 is always the
+ * empty string. Interned names are never removed, so references returned by
+ * name() stay valid for the lifetime of the table.
+ */
+class InternTable {
+public:
+    static constexpr uint32_t EmptyId = 0;
+
+    InternTable() {
+        names_.emplace_back();
+        ids_.emplace(names_.back(), EmptyId);
+    }
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    /**
+     * @brief Get the ID for a string, adding it if not yet present
+     * @param value String to intern
+     * @return Stable ID for the string
+     */
+    uint32_t intern(std::string_view value) {
+        if (value.empty()) {
+            return EmptyId;
+        }
+
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(value);
+            if (it != ids_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(value);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(names_.size());
+        names_.emplace_back(value);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    /**
+     * @brief Look up an existing ID without interning
+     * @param value String to look up
+     * @return ID if the string has been interned
+     */
+    std::optional<uint32_t> find(std::string_view value) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(value);
+        if (it == ids_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Get the string for an ID
+     * @param id Interned ID
+     * @return Interned string, or the empty string for unknown IDs
+     */
+    const std::string& name(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : names_[EmptyId];
+    }
+
+    /**
+     * @brief Get number of interned strings (including the empty string)
+     * @return Table size
+     */
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+
+    /**
+     * @brief Process-wide symbol table
+     */
+    static InternTable& symbols() {
+        static InternTable table;
+        return table;
+    }
+
+    /**
+     * @brief Process-wide account table
+     */
+    static InternTable& accounts() {
+        static InternTable table;
+        return table;
+    }
+
+private:
+    // Keys view into names_, whose elements never move once added
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::deque<std::string> names_;
+};
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "../Utilities/TscClock.hpp"
+#include <cstdint>
+
+namespace orderbook {
+
+/**
+ * @brief Where an inbound order's time went on its way through the server
+ *
+ * Carried with an order when its session traces latency: the session stamps
+ * receipt and parsing, the gateway dispatch and matching, and the book the
+ * end of its risk check. The order's own execution reports echo the stamps
+ * back to the client (tags 5001-5006), with the encoder adding the moment
+ * the report was encoded.
+ *
+ * Stamps are raw TscClock counter values. The receipt stamp goes on the
+ * wire as-is, so a client on the same host (which shares the counter) can
+ * line it up with its own send and receive times; every later stage is
+ * sent as nanoseconds since receipt and is meaningful anywhere.
+ */
+struct LatencyTrace {
+    enum Stage : uint8_t {
+        Received,       // Socket read carrying the order completed
+        Parsed,         // Order parsed and queued for the gateway
+        Dispatched,     // Gateway took the shard lock; the book is next
+        RiskChecked,    // Book journaled the order and passed its risk check
+        Matched,        // Matching and the book update are done
+        StageCount
+    };
+
+    uint64_t ticks[StageCount] = {};    // 0 = stage not reached
+
+    void stamp(Stage stage) { ticks[stage] = TscClock::ticks(); }
+
+    bool isActive() const { return ticks[Received] != 0; }
+
+    /**
+     * @brief Nanoseconds from receipt to a stage (0 if it was not reached)
+     */
+    uint64_t sinceReceived(Stage stage) const { return sinceReceived(ticks[stage]); }
+
+    /**
+     * @brief Nanoseconds from receipt to a counter value taken later
+     */
+    uint64_t sinceReceived(uint64_t tick) const {
+        if (tick < ticks[Received] || !isActive()) {
+            return 0;
+        }
+        return static_cast<uint64_t>(TscClock::toNanoseconds(tick - ticks[Received]));
+    }
+};
+
+}
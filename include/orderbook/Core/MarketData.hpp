@@ -1,5 +1,7 @@
 #pragma once
 #include "Types.hpp"
+#include "InternTable.hpp"
+#include "../Utilities/TscClock.hpp"
 #include <vector>
 #include <optional>
 
@@ -7,6 +9,11 @@ namespace orderbook {
 
 /**
  * @brief Book update event for market data publishing
+ *
+ * Always describes a price level's state after the change, whether it came
+ * from a single operation or a batch: quantity is the level's total resting
+ * quantity and order_count its number of orders. Add means the level
+ * appeared, Modify that it changed, Remove that it is now empty.
  */
 struct BookUpdate {
     enum class Type { Add, Remove, Modify };
@@ -14,14 +21,15 @@ struct BookUpdate {
     Type type;
     Side side;
     Price price;
-    Quantity quantity;
-    size_t order_count;
+    Quantity quantity;          // Total resting at the level (0 for Remove)
+    size_t order_count;         // Orders resting at the level
     SequenceNumber sequence;
     Timestamp timestamp;
+    SymbolId symbol_id;
     
-    BookUpdate(Type t, Side s, Price p, Quantity q, size_t count, SequenceNumber seq)
+    BookUpdate(Type t, Side s, Price p, Quantity q, size_t count, SequenceNumber seq, SymbolId sym = 0)
         : type(t), side(s), price(p), quantity(q), order_count(count), sequence(seq),
-          timestamp(std::chrono::system_clock::now()) {}
+          timestamp(TscClock::now()), symbol_id(sym) {}
 };
 
 /**
@@ -49,7 +57,7 @@ struct ExecutionReport {
         : order_id(id), exec_type(exec), order_status(status), side(s), price(p), 
           quantity(q), filled_quantity(filled), leaves_quantity(q - filled),
           symbol(std::move(sym)), account(std::move(acc)),
-          timestamp(std::chrono::system_clock::now()) {}
+          timestamp(TscClock::now()) {}
 };
 
 }
\ No newline at end of file
@@ -2,7 +2,10 @@
 #include "Types.hpp"
 #include "Order.hpp"
 #include "Interfaces.hpp"
+#include "LatencyTrace.hpp"
 #include "MarketData.hpp"
+#include "MatchingKernel.hpp"
+#include "../Utilities/InlineVector.hpp"
 #include <vector>
 #include <memory>
 #include <atomic>
@@ -15,13 +18,21 @@ class PriceLevel;
 
 /**
  * @brief Result of order matching operation
+ *
+ * Trades and reports are kept inline for the common case (a few fills and
+ * the one report for the incoming order), so a typical match does not
+ * allocate; larger sweeps spill to the heap.
  */
 struct MatchResult {
-    std::vector<Trade> trades;                    // All trades generated from matching
-    std::vector<ExecutionReport> execution_reports; // FIX execution reports for all affected orders
+    using TradeList = InlineVector<Trade, 4>;
+    using ReportList = InlineVector<ExecutionReport, 1>;
+
+    TradeList trades;                            // All trades generated from matching
+    ReportList execution_reports;                // FIX execution reports for the incoming order
     std::optional<Order> remaining_order;         // Remaining unfilled portion (if any)
     bool fully_filled;                           // True if incoming order was completely filled
     Quantity total_filled_quantity;              // Total quantity filled
+    LatencyTrace* trace = nullptr;               // Stamped by the book when set (not cleared per match)
     
     MatchResult() : fully_filled(false), total_filled_quantity(0) {}
     
@@ -43,13 +54,14 @@ public:
     /**
      * @brief Constructor with dependency injection
      * @param logger Logger for trade execution logging
+     * @param tick_size Instrument tick size used for exact price comparison
      */
-    explicit MatchingEngine(LoggerPtr logger = nullptr);
+    explicit MatchingEngine(LoggerPtr logger = nullptr, TickSize tick_size = TickSize{});
     
     /**
      * @brief Match an incoming order against the order book
      * @param incoming_order The order to match
-     * @param opposite_side_levels Price levels on the opposite side for matching
+     * @param opposite_side_levels Opposite-side price levels ordered best price first
      * @return MatchResult containing trades and remaining order
      */
     MatchResult matchOrder(Order& incoming_order, 
@@ -58,7 +70,7 @@ public:
     /**
      * @brief Match a buy order against ask levels
      * @param buy_order The incoming buy order
-     * @param ask_levels Ask price levels sorted by price (ascending)
+     * @param ask_levels Ask price levels sorted by price (ascending, best first); not re-sorted
      * @return MatchResult with trades and remaining order
      */
     MatchResult matchBuyOrder(Order& buy_order, 
@@ -67,7 +79,7 @@ public:
     /**
      * @brief Match a sell order against bid levels
      * @param sell_order The incoming sell order
-     * @param bid_levels Bid price levels sorted by price (descending)
+     * @param bid_levels Bid price levels sorted by price (descending, best first); not re-sorted
      * @return MatchResult with trades and remaining order
      */
     MatchResult matchSellOrder(Order& sell_order, 
@@ -90,6 +102,12 @@ public:
      */
     void resetTradeCounter() { trade_counter_.store(1); }
     
+    /**
+     * @brief Get the tick size used for price comparison
+     * @return Tick size
+     */
+    const TickSize& getTickSize() const { return tick_size_; }
+    
     /**
      * @brief Generate execution report for order fill
      * @param order The order that was filled
@@ -135,43 +153,19 @@ public:
 private:
     // Dependencies
     LoggerPtr logger_;
+    TickSize tick_size_;
     
     // Trade ID generation (thread-safe)
     std::atomic<uint64_t> trade_counter_{1};
     
     /**
-     * @brief Execute a trade between two orders
-     * @param aggressive_order The incoming order (taker)
-     * @param passive_order The resting order (maker)
-     * @param trade_price Price at which trade executes
-     * @param trade_quantity Quantity to trade
-     * @return Generated Trade object
-     */
-    Trade executeTrade(Order& aggressive_order, 
-                      Order& passive_order,
-                      Price trade_price, 
-                      Quantity trade_quantity);
-    
-    /**
-     * @brief Match against a single price level
-     * @param incoming_order The order to match
-     * @param price_level The price level to match against
-     * @param trades Vector to append trades to
-     * @return Quantity filled from this price level
-     */
-    Quantity matchAgainstPriceLevel(Order& incoming_order,
-                                   PriceLevel& price_level,
-                                   std::vector<Trade>& trades);
-    
-    /**
-     * @brief Check if orders can match based on price
-     * @param buy_price Buy order price
-     * @param sell_price Sell order price
-     * @return true if prices cross (can match)
+     * @brief Match an incoming order using the kernel for its side
+     * @param incoming_order The incoming order
+     * @param opposite_side_levels Opposite-side levels, best first; empty levels are skipped
+     * @return MatchResult with trades and remaining order
      */
-    static bool canMatch(Price buy_price, Price sell_price) {
-        return buy_price >= sell_price;
-    }
+    template<Side IncomingSide>
+    MatchResult matchSide(Order& incoming_order, std::vector<PriceLevel>& opposite_side_levels);
     
     /**
      * @brief Determine trade price based on price-time priority
@@ -188,20 +182,8 @@ private:
     /**
      * @brief Log trade execution for monitoring
      * @param trade The executed trade
-     * @param latency_ns Execution latency in nanoseconds
-     */
-    void logTradeExecution(const Trade& trade, uint64_t latency_ns);
-    
-    /**
-     * @brief Validate trade parameters
-     * @param aggressive_order Incoming order
-     * @param passive_order Resting order
-     * @param quantity Trade quantity
-     * @return true if trade is valid
      */
-    static bool validateTrade(const Order& aggressive_order,
-                            const Order& passive_order,
-                            Quantity quantity);
+    void logTradeExecution(const Trade& trade);
 };
 
 }
\ No newline at end of file
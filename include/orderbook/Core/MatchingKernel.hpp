@@ -0,0 +1,124 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+/**
+ * @brief Price-time priority matching loop shared by OrderBook and MatchingEngine
+ *
+ * Specialized on the incoming order's side, so the crossing test and the
+ * buy/sell roles in a trade are fixed at compile time and the inner loop
+ * has no side branches. The kernel only walks levels and fills orders;
+ * what a fill means to the caller (trade IDs, publishing, releasing
+ * resting orders) is passed in as callables, which inline into the loop.
+ */
+template<Side IncomingSide>
+struct MatchingKernel {
+    static constexpr Side RestingSide = IncomingSide == Side::Buy ? Side::Sell : Side::Buy;
+
+    /**
+     * @brief Check whether an incoming price reaches a resting price
+     * @param incoming_ticks Incoming order price in ticks
+     * @param resting_ticks Resting level price in ticks
+     * @return true if the prices cross
+     */
+    static constexpr bool crosses(PriceTicks incoming_ticks, PriceTicks resting_ticks) {
+        if constexpr (IncomingSide == Side::Buy) {
+            return incoming_ticks >= resting_ticks;
+        } else {
+            return incoming_ticks <= resting_ticks;
+        }
+    }
+
+    /**
+     * @brief Build the trade record for a fill
+     * @param id Trade ID
+     * @param incoming Incoming (aggressive) order
+     * @param resting Resting (passive) order
+     * @param price Execution price (the resting level's price)
+     * @param quantity Fill quantity
+     * @return Trade with buy and sell order IDs assigned by side
+     */
+    static Trade makeTrade(TradeId id, const Order& incoming, const Order& resting,
+                           Price price, Quantity quantity) {
+        if constexpr (IncomingSide == Side::Buy) {
+            return Trade(id.value, incoming.id, resting.id, price, quantity, incoming.symbol_id);
+        } else {
+            return Trade(id.value, resting.id, incoming.id, price, quantity, incoming.symbol_id);
+        }
+    }
+
+    /**
+     * @brief Fill an incoming order against one level in time priority
+     *
+     * on_fill(resting, level, quantity) runs after both orders and the level
+     * have been updated. A fully filled resting order has already been
+     * unlinked from the level, and the callback may release it.
+     * @param incoming Incoming order
+     * @param level Resting level
+     * @param on_fill Called once per fill
+     * @return Quantity filled at this level
+     */
+    template<typename OnFill>
+    static Quantity matchLevel(Order& incoming, PriceLevel& level, OnFill&& on_fill) {
+        Quantity filled = 0;
+        Order* resting = level.getFirstOrder();
+
+        while (resting && !incoming.isFullyFilled()) {
+            Quantity quantity = std::min(incoming.remainingQuantity(), resting->remainingQuantity());
+            if (quantity == 0) break;
+
+            // Capture the successor first; a filled order is unlinked from the level below
+            Order* next = resting->next;
+
+            incoming.fill(quantity);
+            resting->fill(quantity);
+            level.updateQuantity(resting, quantity);
+            filled += quantity;
+
+            bool resting_filled = resting->isFullyFilled();
+            on_fill(*resting, level, quantity);
+            if (!resting_filled) break;     // Incoming order is done
+            resting = next;
+        }
+
+        return filled;
+    }
+
+    /**
+     * @brief Match an incoming order against crossing levels, best first
+     * @param incoming Incoming order
+     * @param incoming_ticks Incoming order price in ticks
+     * @param next_level Returns the best remaining resting level, or nullptr
+     * @param on_fill Called once per fill, as in matchLevel
+     * @param on_level_emptied Called with each level matched down to empty,
+     *                         before the next level is requested
+     * @return Total quantity filled
+     */
+    template<typename NextLevel, typename OnFill, typename OnLevelEmptied>
+    static Quantity match(Order& incoming, PriceTicks incoming_ticks, NextLevel&& next_level,
+                          OnFill&& on_fill, OnLevelEmptied&& on_level_emptied) {
+        Quantity filled = 0;
+
+        while (!incoming.isFullyFilled()) {
+            PriceLevel* level = next_level();
+            if (!level || !crosses(incoming_ticks, level->ticks)) {
+                break; // No more matches possible
+            }
+
+            filled += matchLevel(incoming, *level, on_fill);
+
+            // A level that survives matching means the incoming order ran out or matching stalled
+            if (!level->isEmpty()) {
+                break;
+            }
+            on_level_emptied(*level);
+        }
+
+        return filled;
+    }
+};
+
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "BookCommand.hpp"
+#include "OrderBookRouter.hpp"
+#include "Interfaces.hpp"
+#include "../Utilities/RingBuffer.hpp"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace orderbook {
+
+class Config;
+class MetricsWriter;
+
+/**
+ * @brief Multi-threaded matching runtime with one single-writer thread per shard
+ *
+ * Each shard thread owns the books the router pinned to it and is the only
+ * thread that ever mutates them, so books need no locks. Commands reach a
+ * shard through a bounded MPSC ring (any number of submitters). Results go
+ * to a result handler called on the shard thread when one is set; otherwise
+ * to a bounded SPSC ring that a single consumer polls when result_queue_size
+ * is non-zero; otherwise they are counted and discarded. A full result ring
+ * back-pressures its shard only while the runtime is running.
+ *
+ * While the runtime is running, books must not be touched directly from other
+ * threads. Books must be registered with the router before start().
+ *
+ * With pre_trade_risk enabled, submit() runs the router's stateless risk
+ * checks (order size, price range, fat-finger band) on the submitting
+ * thread, so gateway threads check in parallel and the shard thread only
+ * runs the position check, in order with matching.
+ */
+class MatchingRuntime {
+public:
+    /**
+     * @brief How an idle shard thread waits for commands
+     */
+    enum class WaitStrategy {
+        BusyPoll,       // Spin with a CPU pause hint; lowest latency, burns a core
+        Backoff         // Spin, then yield, then sleep briefly
+    };
+
+    /**
+     * @brief Runtime settings
+     */
+    struct RuntimeConfig {
+        size_t command_queue_size = 65536;  // Inbound slots per shard
+        size_t result_queue_size = 0;       // Outbound slots per shard for pollResults() (0 = not queued)
+        size_t max_batch = 256;             // Commands applied per wake-up
+        WaitStrategy wait_strategy = WaitStrategy::Backoff;
+        std::vector<int> cpu_affinity;      // CPU for shard i (empty or -1 = unpinned)
+        bool pre_trade_risk = false;        // Run stateless risk checks in submit()
+        MemoryArena::ArenaConfig arena;     // Backing for shard rings (node follows cpu_affinity)
+    };
+
+    explicit MatchingRuntime(OrderBookRouter& router, LoggerPtr logger = nullptr);
+    MatchingRuntime(OrderBookRouter& router, LoggerPtr logger, const RuntimeConfig& config);
+    MatchingRuntime(OrderBookRouter& router, LoggerPtr logger, std::shared_ptr<Config> config);
+    ~MatchingRuntime();
+
+    MatchingRuntime(const MatchingRuntime&) = delete;
+    MatchingRuntime& operator=(const MatchingRuntime&) = delete;
+
+    /**
+     * @brief Start one thread per router shard
+     */
+    void start();
+
+    /**
+     * @brief Apply every queued command, then stop and join the shard threads
+     */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    using ResultHandler = std::function<void(BookCommandResult&)>;
+
+    /**
+     * @brief Deliver results to a handler instead of the result rings
+     *
+     * The handler runs on each shard thread after every batch, in command
+     * order, so handlers for different shards run in parallel. Set it before
+     * start().
+     * @param handler Callable taking BookCommandResult&
+     */
+    void setResultHandler(ResultHandler handler);
+
+    using BookVisitor = std::function<void(SymbolId, OrderBook&)>;
+
+    /**
+     * @brief Run a visitor over every book on the thread that owns it
+     *
+     * Each shard thread visits its books between two batches, so the visitor
+     * sees every book at a command boundary and may read it without locks;
+     * it should be quick, since the shard applies nothing meanwhile. Shards
+     * visit in parallel, so a visitor for books on different shards must be
+     * thread-safe. When the runtime is stopped, the books are visited on the
+     * calling thread.
+     * @param visitor Callable taking (SymbolId, OrderBook&); blocks until every book was visited
+     */
+    void visitBooks(const BookVisitor& visitor);
+
+    /**
+     * @brief Queue a command for the shard that owns its symbol (any thread)
+     * @param command Command to queue
+     * @return Error if the symbol is unknown, the shard's queue is full, or
+     *         (with pre_trade_risk) the order fails a stateless risk check
+     */
+    Result<bool> submit(const BookCommand& command);
+
+    /**
+     * @brief Consume results from every shard (single consumer thread only)
+     * @param consumer Callable taking BookCommandResult&
+     * @param max_per_shard Maximum results taken from each shard
+     * @return Number of results consumed
+     */
+    template<typename Consumer>
+    size_t pollResults(Consumer&& consumer, size_t max_per_shard = 1024) {
+        size_t total = 0;
+        for (auto& shard : shards_) {
+            total += shard->results.drain(max_per_shard, consumer);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Parse a wait strategy name ("busy_poll" or "backoff")
+     * @param name Strategy name from configuration
+     * @return Parsed strategy (Backoff for unknown names)
+     */
+    static WaitStrategy parseWaitStrategy(const std::string& name);
+    
+    /**
+     * @brief Read runtime settings from the [matching] section
+     * @param config Configuration source
+     * @return Settings with defaults for missing keys
+     */
+    static RuntimeConfig loadConfiguration(std::shared_ptr<Config> config);
+
+    // Statistics
+    size_t getShardCount() const { return shards_.size(); }
+    uint64_t getProcessedCount(size_t shard) const;
+    uint64_t getRejectedSubmits() const { return rejected_submits_.load(std::memory_order_relaxed); }
+    uint64_t getRiskRejects() const { return risk_rejects_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedResults() const { return dropped_results_.load(std::memory_order_relaxed); }
+    const RuntimeConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Add shard queue depths and counters to a scrape (any thread)
+     *
+     * Queue depths are read from the rings' indices without taking a slot,
+     * so they are approximate while producers and consumers are active.
+     * @param out Scrape being built
+     */
+    void exportMetrics(MetricsWriter& out) const;
+
+private:
+    struct Shard {
+        Shard(size_t command_capacity, size_t result_capacity, std::unique_ptr<MemoryArena> ring_arena)
+            : arena(std::move(ring_arena)),
+              commands(command_capacity, arena.get()), results(result_capacity, arena.get()) {}
+
+        std::unique_ptr<MemoryArena> arena;             // Owns the ring slots when enabled; outlives the rings
+        MpscRing<BookCommand> commands;
+        SpscRing<BookCommandResult> results;
+        std::vector<BookCommand> batch;                 // Commands taken in one wake-up
+        std::vector<BookCommandResult> batch_results;
+        std::thread thread;
+        alignas(CacheLineSize) std::atomic<uint64_t> processed{0};
+        std::atomic<const BookVisitor*> visit{nullptr};    // Pending visitBooks() request
+    };
+
+    OrderBookRouter& router_;
+    LoggerPtr logger_;
+    RuntimeConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> rejected_submits_{0};
+    std::atomic<uint64_t> risk_rejects_{0};
+    std::atomic<uint64_t> dropped_results_{0};
+    ResultHandler result_handler_;
+    std::mutex visit_mutex_;                            // Serializes visitBooks() with stop()
+
+    void createShards();
+    Result<bool> push(uint32_t shard, const BookCommand& command);
+    void runShard(size_t index);
+    void applyBatch(size_t index, Shard& shard);
+    void deliverResults(size_t index, Shard& shard);
+    void visitShard(size_t index, Shard& shard);
+    void pinThread(size_t index);
+};
+
+}
@@ -1,57 +1,69 @@
 #pragma once
 #include "Types.hpp"
+#include "InternTable.hpp"
+#include "../Utilities/TscClock.hpp"
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace orderbook {
 
 /**
  * @brief Represents a trading order with all necessary fields
- * Optimized for high-performance order book operations with cache-friendly layout
- * SIMD-ready with proper alignment for vectorized operations
+ * Hot matching fields fit in a single 64-byte cache line; symbol and account are
+ * interned IDs and the entry timestamp lives in OrderMetadata, so walking a
+ * PriceLevel queue touches exactly one line per order.
  */
 struct alignas(64) Order {  // 64-byte alignment for cache line optimization and SIMD
     // Core order identification and pricing (hot data)
-    OrderId id;
-    Price price;
-    Quantity quantity;
+    OrderId id{0};
+    Price price = 0.0;
+    Quantity quantity = 0;
     Quantity filled_quantity = 0;
     
-    // Order characteristics
-    Side side;
-    OrderType type;
-    TimeInForce tif = TimeInForce::GTC;
-    OrderStatus status = OrderStatus::New;
-    
     // Linked list pointers for price level management (hot data for matching)
     Order* next = nullptr;
     Order* prev = nullptr;
     
-    // Timestamps and metadata (less frequently accessed)
-    Timestamp timestamp;
-    std::string symbol;
-    std::string account;
+    // Interned instrument and account
+    SymbolId symbol_id = InternTable::EmptyId;
+    AccountId account_id = InternTable::EmptyId;
+    
+    // Order characteristics
+    Side side = Side::Buy;
+    OrderType type = OrderType::Limit;
+    TimeInForce tif = TimeInForce::GTC;
+    OrderStatus status = OrderStatus::New;
     
     // Constructors
-    Order(uint64_t id, Side side, OrderType type, Price price, Quantity quantity, std::string symbol)
-        : id(OrderId(id)), price(price), quantity(quantity), side(side), type(type),
-          symbol(std::move(symbol)), timestamp(std::chrono::system_clock::now()) {}
+    Order(uint64_t id, Side side, OrderType type, Price price, Quantity quantity, std::string_view symbol)
+        : id(OrderId(id)), price(price), quantity(quantity),
+          symbol_id(InternTable::symbols().intern(symbol)), side(side), type(type) {}
+    
+    Order(uint64_t id, Side side, OrderType type, TimeInForce tif, Price price, Quantity quantity, 
+          std::string_view symbol, std::string_view account = {})
+        : id(OrderId(id)), price(price), quantity(quantity),
+          symbol_id(InternTable::symbols().intern(symbol)),
+          account_id(InternTable::accounts().intern(account)),
+          side(side), type(type), tif(tif) {}
     
     Order(uint64_t id, Side side, OrderType type, TimeInForce tif, Price price, Quantity quantity, 
-          std::string symbol, std::string account = "")
-        : id(OrderId(id)), price(price), quantity(quantity), side(side), type(type), tif(tif),
-          symbol(std::move(symbol)), account(std::move(account)), 
-          timestamp(std::chrono::system_clock::now()) {}
+          SymbolId symbol, AccountId account)
+        : id(OrderId(id)), price(price), quantity(quantity),
+          symbol_id(symbol), account_id(account), side(side), type(type), tif(tif) {}
     
     // Default constructor for object pooling
     Order() = default;
     
-    // Move constructor and assignment for efficiency
+    // No owned resources, so copies are a single cache-line memcpy
+    Order(const Order&) = default;
+    Order& operator=(const Order&) = default;
     Order(Order&& other) noexcept = default;
     Order& operator=(Order&& other) noexcept = default;
     
-    // Delete copy constructor to prevent accidental copying
-    Order(const Order&) = delete;
-    Order& operator=(const Order&) = delete;
+    // Cold lookups of the interned strings
+    const std::string& symbol() const { return InternTable::symbols().name(symbol_id); }
+    const std::string& account() const { return InternTable::accounts().name(account_id); }
     
     // Utility methods
     bool isFullyFilled() const { return filled_quantity >= quantity; }
@@ -59,6 +71,7 @@ struct alignas(64) Order {  // 64-byte alignment for cache line optimization and
     bool isBuy() const { return side == Side::Buy; }
     bool isSell() const { return side == Side::Sell; }
     bool isActive() const { return status == OrderStatus::New || status == OrderStatus::PartiallyFilled; }
+    bool isImmediate() const { return type == OrderType::Market || tif != TimeInForce::GTC; }  // Never rests
     
     /**
      * @brief Fill order with specified quantity
@@ -113,22 +126,22 @@ struct alignas(64) Order {  // 64-byte alignment for cache line optimization and
      * @brief Reset order for object pooling
      */
     void reset() {
-        id = OrderId(0);
-        price = 0.0;
-        quantity = 0;
-        filled_quantity = 0;
-        side = Side::Buy;
-        type = OrderType::Limit;
-        tif = TimeInForce::GTC;
-        status = OrderStatus::New;
-        next = nullptr;
-        prev = nullptr;
-        symbol.clear();
-        account.clear();
-        timestamp = std::chrono::system_clock::now();
+        *this = Order();
     }
 };
 
+static_assert(sizeof(Order) == 64, "Order hot record must occupy exactly one cache line");
+
+/**
+ * @brief Cold per-order data kept out of the matching cache line
+ */
+struct OrderMetadata {
+    Timestamp timestamp;     // Time the order entered the book
+    
+    OrderMetadata() : timestamp(TscClock::now()) {}
+    explicit OrderMetadata(Timestamp ts) : timestamp(ts) {}
+};
+
 /**
  * @brief Represents a trade execution
  * SIMD-aligned for vectorized processing
@@ -140,12 +153,17 @@ struct alignas(32) Trade {  // 32-byte alignment for SIMD operations
     Price price;
     Quantity quantity;
     Timestamp timestamp;
-    std::string symbol;
+    SymbolId symbol_id;
     
-    Trade(uint64_t trade_id, OrderId buy_id, OrderId sell_id, Price p, Quantity q, std::string sym)
+    Trade(uint64_t trade_id, OrderId buy_id, OrderId sell_id, Price p, Quantity q, SymbolId sym)
         : id(TradeId(trade_id)), buy_order_id(buy_id), sell_order_id(sell_id), 
-          price(p), quantity(q), symbol(std::move(sym)), 
-          timestamp(std::chrono::system_clock::now()) {}
+          price(p), quantity(q), timestamp(TscClock::now()), symbol_id(sym) {}
+    
+    // Default constructor for object pooling
+    Trade() : id(TradeId(0)), buy_order_id(OrderId(0)), sell_order_id(OrderId(0)),
+              price(0.0), quantity(0), symbol_id(InternTable::EmptyId) {}
+    
+    const std::string& symbol() const { return InternTable::symbols().name(symbol_id); }
 };
 
 /**
@@ -177,13 +195,14 @@ struct Portfolio {
  * Optimized for high-performance order book operations
  */
 struct PriceLevel {
-    Price price;
+    PriceTicks ticks;   // Exact level key used for comparisons and lookups
+    Price price;        // Decimal view of ticks for reporting
     Quantity total_quantity = 0;
     size_t order_count = 0;
     Order* head = nullptr;
     Order* tail = nullptr;
     
-    explicit PriceLevel(Price p) : price(p) {}
+    PriceLevel(Price p, PriceTicks t) : ticks(t), price(p) {}
     
     /**
      * @brief Add order to the end of the queue (FIFO)
@@ -283,6 +302,16 @@ struct PriceLevel {
     }
 };
 
+/**
+ * @brief Node in a book's list of one account's resting orders
+ * Kept outside Order so the order stays one cache line; used for mass cancels
+ */
+struct AccountOrderLink {
+    Order* order = nullptr;
+    AccountOrderLink* prev = nullptr;
+    AccountOrderLink* next = nullptr;
+};
+
 /**
  * @brief Order location for fast lookup
  * Used for O(1) order cancellation and modification
@@ -291,8 +320,12 @@ struct OrderLocation {
     Order* order;
     PriceLevel* price_level;
     Side side;
+    OrderMetadata metadata;     // Cold data; never touched while matching
+    AccountOrderLink* account_link = nullptr;   // Null for orders without an account
     
     OrderLocation(Order* o, PriceLevel* pl, Side s) : order(o), price_level(pl), side(s) {}
+    OrderLocation(Order* o, PriceLevel* pl, Side s, const OrderMetadata& m) 
+        : order(o), price_level(pl), side(s), metadata(m) {}
     
     /**
      * @brief Check if location is valid
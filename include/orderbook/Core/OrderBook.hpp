@@ -3,13 +3,25 @@
 #include "Order.hpp"
 #include "Interfaces.hpp"
 #include "MarketData.hpp"
+#include "PriceLadder.hpp"
+#include "MatchingEngine.hpp"
+#include "MatchingKernel.hpp"
+#include "BookCommand.hpp"
+#include "DepthSnapshot.hpp"
+#include "../Utilities/MemoryAllocators.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <optional>
 #include <memory>
+#include <string>
 
 namespace orderbook {
 
+class Config;
+class MetricsWriter;
+
 // PriceLevel is defined in Order.hpp
 
 /**
@@ -17,58 +29,357 @@ namespace orderbook {
  */
 class OrderBook {
 public:
+    /**
+     * @brief Per-instrument book settings
+     */
+    struct BookConfig {
+        /**
+         * @brief Price level storage layout
+         */
+        enum class StorageMode {
+            SortedVector,   // Sorted std::vector of levels with a hash index
+            Ladder          // Direct-indexed tick ladder with best-price cursors
+        };
+        
+        std::string symbol = "BTC/USD";
+        Price tick_size = 0.01;     // Minimum price increment; prices are stored as whole ticks
+        StorageMode storage = StorageMode::Ladder;
+        size_t ladder_levels = PriceLadder::DefaultCapacity;  // Initial ladder width in ticks
+        size_t ladder_max_levels = PriceLadder::DefaultMaxCapacity;  // Price band: widest ladder window in ticks
+        size_t max_orders = 0;      // Orders to pre-allocate at startup (0 = grow on demand)
+        size_t depth_levels = 5;    // Levels per side in published depth (0 = no depth updates)
+        size_t query_levels = 0;    // Levels per side mirrored for cross-thread depth queries (0 = off)
+        MemoryArena::ArenaConfig arena;     // Backing for pools and ladders (disabled = heap)
+    };
+    
     // Constructor with dependency injection
     OrderBook(RiskManagerPtr risk_manager = nullptr,
               MarketDataPublisherPtr market_data = nullptr,
               LoggerPtr logger = nullptr);
+    OrderBook(RiskManagerPtr risk_manager,
+              MarketDataPublisherPtr market_data,
+              LoggerPtr logger,
+              const BookConfig& config);
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
     
     // Core operations
     OrderResult addOrder(const Order& order);
     CancelResult cancelOrder(OrderId id);
+    
+    /**
+     * @brief Add an order and collect the trades it generates
+     * @param order Incoming order
+     * @param result Cleared, then filled with trades, fill totals and any resting
+     *               remainder; execution_reports is left empty. Reuse it across
+     *               calls to avoid reallocating the trade vector. Market, IOC and
+     *               FOK orders never rest, so their unfilled quantity is cancelled
+     *               and remaining_order stays empty
+     * @return Order ID or error, as addOrder(order)
+     */
+    OrderResult addOrder(const Order& order, MatchResult& result);
+    
+    /**
+     * @brief Change a resting order's price and/or quantity
+     *
+     * A quantity reduction at the same price is applied in place and keeps
+     * the order's time priority. An increase sends it to the back of its
+     * level, and a price change moves it to the back of the new level with
+     * one unlink and one link. Reducing the quantity to no more than has
+     * already filled leaves nothing to rest, so the order is cancelled.
+     * @param id Resting order
+     * @param new_price New limit price (0 = unchanged)
+     * @param new_quantity New total order quantity (0 = unchanged)
+     * @return true or an error (unknown order, off-tick price)
+     */
     ModifyResult modifyOrder(OrderId id, Price new_price, Quantity new_quantity);
     
+    /**
+     * @brief Cancel a set of resting orders in one sweep
+     *
+     * Each order is journaled as a cancel and leaves the book as with
+     * cancelOrder, but book updates are coalesced to one per touched level
+     * and best prices and depth are published once, as in applyBatch.
+     * IDs that are not resting here are skipped.
+     * @param ids Orders to cancel
+     * @param count Number of IDs
+     * @param cancelled If not null, the IDs actually cancelled are appended
+     * @return Number of orders cancelled
+     */
+    size_t cancelOrders(const OrderId* ids, size_t count, std::vector<OrderId>* cancelled = nullptr);
+    
+    /**
+     * @brief Cancel every resting order of one account in one sweep
+     *
+     * Walks the account's order list rather than the whole book.
+     * @param account Interned account (EmptyId cancels nothing)
+     * @param cancelled If not null, the IDs cancelled are appended
+     * @return Number of orders cancelled
+     */
+    size_t cancelAccountOrders(AccountId account, std::vector<OrderId>* cancelled = nullptr);
+    
+    /**
+     * @brief Cancel every resting order in one sweep
+     * @param cancelled If not null, the IDs cancelled are appended
+     * @return Number of orders cancelled
+     */
+    size_t cancelAllOrders(std::vector<OrderId>* cancelled = nullptr);
+    
+    /**
+     * @brief Apply a burst of commands in one pass
+     *
+     * Commands run strictly in order, each seeing the effects of the ones
+     * before it, and trades are published as they happen. Book updates are
+     * coalesced to one per touched level carrying the level's final total
+     * quantity and order count, and best prices and depth are published at
+     * most once, after the last command.
+     * @param commands Commands for this book (their symbol_id is not checked)
+     * @param count Number of commands
+     * @param results One result per command is appended, in order
+     */
+    void applyBatch(const BookCommand* commands, size_t count, std::vector<BookCommandResult>& results);
+    void applyBatch(const std::vector<BookCommand>& commands, std::vector<BookCommandResult>& results) {
+        applyBatch(commands.data(), commands.size(), results);
+    }
+    
     // Market data queries
     std::optional<Price> bestBid() const;
     std::optional<Price> bestAsk() const;
     BestPrices getBestPrices() const;
     MarketDepth getDepth(size_t levels) const;
     
+    /**
+     * @brief Seqlocked mirror of the top query_levels per side (nullptr when query_levels is 0)
+     *
+     * Readable from any thread without locking the book. Read it into a
+     * DepthView to answer several queries against one consistent state.
+     */
+    const DepthSnapshot* getDepthSnapshot() const { return depth_snapshot_.get(); }
+    
+    /**
+     * @brief Depth queries over the mirrored levels, safe from any thread
+     *
+     * Each call reads the snapshot into a per-thread DepthView first. The
+     * side is the one walked: Sell (asks) to price a buy. Without a mirror
+     * they return 0 / nullopt.
+     */
+    Quantity quantityToPrice(Side side, Price limit) const;
+    std::optional<Price> vwapForSize(Side side, Quantity size) const;
+    std::optional<Price> priceForSize(Side side, Quantity size) const;
+    
     // Statistics
     size_t getOrderCount() const;
     size_t getBidLevelCount() const;
     size_t getAskLevelCount() const;
+    size_t getOrderPoolCapacity() const { return order_pool_.capacity(); }
+    
+    /**
+     * @brief Book state published for monitoring threads
+     *
+     * Refreshed with relaxed stores by the thread that owns the book after
+     * every operation (once per applyBatch), so any thread may read it while
+     * the book is matching. Fields are individually current; they are not
+     * one consistent snapshot.
+     */
+    struct alignas(64) BookMetrics {
+        std::atomic<uint64_t> orders{0};
+        std::atomic<uint64_t> bid_levels{0};
+        std::atomic<uint64_t> ask_levels{0};
+        std::atomic<Price> best_bid{0.0};           // 0 when the side is empty
+        std::atomic<Price> best_ask{0.0};
+        std::atomic<Quantity> best_bid_quantity{0};
+        std::atomic<Quantity> best_ask_quantity{0};
+        std::atomic<uint64_t> trades{0};            // Trades executed by this book
+        std::atomic<uint64_t> order_pool_capacity{0};
+    };
+    
+    const BookMetrics& getMetrics() const { return metrics_; }
+    
+    /**
+     * @brief Add this book's published metrics to a scrape (any thread)
+     * @param out Scrape being built; samples are labelled with the symbol
+     */
+    void exportMetrics(MetricsWriter& out) const;
+    
+    // Configuration
+    const BookConfig& getConfig() const { return config_; }
+    const TickSize& getTickSize() const { return tick_size_; }
+    
+    /**
+     * @brief Journal every inbound operation and trade from now on
+     * @param journal Journal to write to (nullptr = stop journaling)
+     */
+    void setJournal(OrderJournalPtr journal) { journal_ = std::move(journal); }
+    
+    /**
+     * @brief Make trade IDs issued from now on exceed last_trade_id
+     *
+     * Trade IDs are shared by all books; call this after restoring state
+     * (e.g. replaying a journal) so new trades do not reuse recorded IDs.
+     * @param last_trade_id Highest trade ID already issued
+     */
+    static void advanceTradeIds(uint64_t last_trade_id);
+    static uint64_t getNextTradeId();
+    
+    /**
+     * @brief Make book update sequence numbers issued from now on exceed last_sequence
+     * @param last_sequence Highest sequence already published
+     */
+    static void advanceBookSequence(SequenceNumber last_sequence);
+    static SequenceNumber getBookSequence();
+    
+    /**
+     * @brief Append the book's full state to a snapshot buffer
+     *
+     * Writes one BookSnapshotHeader section: every resting order in level
+     * and queue order, the account names they use, and the trade and book
+     * update counters. A single sequential pass with no allocation per
+     * order, so a matching thread can take it between commands; writing
+     * the buffer out is left to the caller.
+     * @param out Buffer the section is appended to
+     * @param journal_sequence Last journal record this state reflects (0 = none)
+     */
+    void saveSnapshot(std::vector<char>& out, uint64_t journal_sequence) const;
+    
+    /**
+     * @brief Restore a section written by saveSnapshot into this empty book
+     *
+     * Rebuilds levels, queues and the order index, advances the trade ID
+     * and book update counters past the saved ones, and publishes the
+     * restored best prices and depth.
+     * @param data Start of the section
+     * @param size Bytes available from data
+     * @return Journal sequence the section reflects, or an error if the book
+     *         is not empty or the section is malformed or for another book
+     */
+    Result<uint64_t> loadSnapshot(const char* data, size_t size);
+    
+    /**
+     * @brief Read book settings from the [orderbook] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static BookConfig loadConfiguration(std::shared_ptr<Config> config);
 
 private:
+    // Instrument configuration
+    BookConfig config_;
+    TickSize tick_size_;
+    SymbolId symbol_id_;        // Interned config_.symbol, stamped on market data
+    
+    // Owns the memory behind the pools and ladders below when enabled, so it
+    // is declared first and destroyed last
+    std::unique_ptr<MemoryArena> arena_;
+    
+    // Price levels live in a node pool so their addresses never change;
+    // the side structures below only hold pointers into it
+    static constexpr size_t LevelPoolBlockBytes = 256 * sizeof(PriceLevel);
+    PoolAllocator<PriceLevel, LevelPoolBlockBytes> level_pool_;
+    
+    // Single-threaded arena for resting orders; pre-warmed to max_orders
+    static constexpr size_t OrderPoolBlockBytes = 1024 * sizeof(Order);
+    PoolAllocator<Order, OrderPoolBlockBytes> order_pool_;
+    
     // Optimized storage
-    std::vector<PriceLevel> bids_;
-    std::vector<PriceLevel> asks_;
-    std::unordered_map<Price, PriceLevel*> price_index_;
-    std::unordered_map<OrderId, OrderLocation, OrderIdHash> order_index_;
+    std::vector<PriceLevel*> bids_;
+    std::vector<PriceLevel*> asks_;
+    std::unordered_map<PriceTicks, PriceLevel*> bid_index_;
+    std::unordered_map<PriceTicks, PriceLevel*> ask_index_;
+    PriceLadder bid_ladder_;
+    PriceLadder ask_ladder_;
+    FlatHashMap<OrderId, OrderLocation, OrderIdHash> order_index_;
+    
+    // Each account's resting orders as a list of pooled links, headed by
+    // dense AccountId, so a mass cancel never scans other accounts' orders
+    static constexpr size_t AccountLinkPoolBlockBytes = 1024 * sizeof(AccountOrderLink);
+    PoolAllocator<AccountOrderLink, AccountLinkPoolBlockBytes> account_link_pool_;
+    std::vector<AccountOrderLink*> account_orders_;
+    std::vector<OrderId> mass_cancel_ids_;      // Reused by account and whole-book cancels
+    
+    // Receives trades while addOrder(order, result) runs
+    MatchResult* match_sink_ = nullptr;
+    MatchResult command_match_;     // Reused by applyCommand() for each Add
+    
+    // Set while applying an Add whose stateless risk checks ran before submission
+    bool risk_prechecked_ = false;
+    
+    // Last published BBO and depth. A level change marks them dirty only when
+    // it lands at or inside the published window, and they are rebuilt (into
+    // reused buffers) and republished only when dirty and actually different
+    BestPrices published_bbo_;
+    MarketDepth published_depth_;
+    MarketDepth scratch_depth_;
+    bool bbo_dirty_ = false;
+    bool depth_dirty_ = false;
+    
+    // Cross-thread query mirror, rewritten after operations that change a
+    // level inside it
+    std::unique_ptr<DepthSnapshot> depth_snapshot_;
+    bool snapshot_dirty_ = false;
+    
+    // Levels touched while applyBatch runs, in first-touch order, indexed by
+    // ticks per side; their final state is published when the batch ends
+    struct BatchLevel {
+        Side side;
+        PriceTicks ticks;
+        Price price;
+        bool created;           // First change added the level's only order
+    };
+    bool batching_ = false;
+    std::vector<BatchLevel> batch_levels_;
+    FlatHashMap<PriceTicks, size_t> batch_bid_levels_;
+    FlatHashMap<PriceTicks, size_t> batch_ask_levels_;
     
     // Dependencies
     RiskManagerPtr risk_manager_;
     MarketDataPublisherPtr market_data_;
     LoggerPtr logger_;
+    OrderJournalPtr journal_;
+    
+    // Monitoring view, written only by publishMetrics()
+    uint64_t trade_count_ = 0;
+    BookMetrics metrics_;
     
     // Helper methods
-    PriceLevel* findOrCreatePriceLevel(Price price, Side side);
+    PriceLevel* findOrCreatePriceLevel(PriceTicks ticks, Side side);
+    const PriceLevel* findPriceLevel(PriceTicks ticks, Side side) const;
     void removePriceLevel(PriceLevel* level, Side side);
-    void maintainSortedOrder();
-    void rebuildPriceIndex();
+    void removeRestingOrder(const OrderLocation& location);
+    AccountOrderLink* linkAccountOrder(Order* order);
+    void unlinkAccountOrder(AccountOrderLink* link);
+    bool usesLadder() const { return config_.storage == BookConfig::StorageMode::Ladder; }
+    const PriceLevel* bestLevel(Side side) const;
+    PriceLevel* bestLevel(Side side) {
+        return const_cast<PriceLevel*>(static_cast<const OrderBook*>(this)->bestLevel(side));
+    }
+    std::unordered_map<PriceTicks, PriceLevel*>& indexFor(Side side) {
+        return side == Side::Buy ? bid_index_ : ask_index_;
+    }
     void publishMarketDataUpdate();
+    void publishMetrics();
+    void markLevelChanged(Side side, Price price);
+    void fillDepth(MarketDepth& depth, size_t levels) const;
+    void refreshDepthSnapshot();
+    template<typename Visitor>
+    void forEachLevelFromBest(Side side, size_t levels, Visitor&& visitor) const;
     void publishBookUpdate(BookUpdate::Type type, Side side, Price price, 
                           Quantity quantity, size_t order_count);
+    void publishLevelUpdate(Side side, const PriceLevel& level, bool added);
+    void recordBatchLevel(BookUpdate::Type type, Side side, Price price, size_t order_count);
+    void publishBatchLevels();
+    void applyCommand(const BookCommand& command, BookCommandResult& result);
     
     // Matching and trade execution
-    void processMatching(Order& incoming_order);
-    void executeMatching(Order& incoming_order, std::vector<PriceLevel>& opposite_levels);
-    void matchAgainstPriceLevel(Order& incoming_order, PriceLevel& price_level);
-    void executeTrade(Order& aggressive_order, Order& passive_order, 
-                     Price trade_price, Quantity trade_quantity);
+    OrderResult addImmediateOrder(const Order& order);
+    template<Side IncomingSide>
+    bool canFill(PriceTicks incoming_ticks, Quantity quantity) const;
+    void processMatching(Order& incoming_order, PriceTicks incoming_ticks);
+    template<Side IncomingSide>
+    void executeMatching(Order& incoming_order, PriceTicks incoming_ticks);
+    void executeTrade(const Order& aggressive_order, const Order& passive_order, const Trade& trade);
     
     // Constants
     static constexpr size_t InitialCapacity = 1024;
-    static constexpr Price MinPriceIncrement = 0.01;
 };
 
 }
\ No newline at end of file
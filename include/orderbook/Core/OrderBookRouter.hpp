@@ -0,0 +1,147 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "OrderBook.hpp"
+#include "InternTable.hpp"
+#include "Interfaces.hpp"
+#include <vector>
+#include <memory>
+#include <string_view>
+#include <limits>
+
+namespace orderbook {
+
+class MetricsWriter;
+
+/**
+ * @brief Registry of one OrderBook per instrument with O(1) dispatch
+ *
+ * Books are stored in a vector indexed by interned SymbolId, so routing an
+ * order is one bounds check and one load. Each book is also assigned to a
+ * shard; all books of a shard are meant to be driven by the same matching
+ * thread so every book has a single writer.
+ *
+ * Books are registered at startup. addBook() must not run concurrently with
+ * dispatch; lookups and routing are safe from many threads as long as each
+ * book is only mutated by the thread that owns its shard.
+ */
+class OrderBookRouter {
+public:
+    static constexpr uint32_t AutoShard = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Router settings
+     */
+    struct RouterConfig {
+        size_t shard_count = 1;     // Number of matching shards books are spread across
+        std::vector<int> shard_cpus;    // CPU each shard runs on (empty or -1 = unknown); places book arenas
+    };
+
+    OrderBookRouter(RiskManagerPtr risk_manager = nullptr,
+                    MarketDataPublisherPtr market_data = nullptr,
+                    LoggerPtr logger = nullptr);
+    OrderBookRouter(RiskManagerPtr risk_manager,
+                    MarketDataPublisherPtr market_data,
+                    LoggerPtr logger,
+                    const RouterConfig& config);
+    OrderBookRouter(const OrderBookRouter&) = delete;
+    OrderBookRouter& operator=(const OrderBookRouter&) = delete;
+
+    /**
+     * @brief Create the book for an instrument
+     * @param config Book settings (config.symbol names the instrument)
+     * @param shard Shard to pin the book to, or AutoShard for round-robin
+     * @return Interned symbol ID or error if the symbol is already registered
+     */
+    Result<SymbolId> addBook(const OrderBook::BookConfig& config, uint32_t shard = AutoShard);
+
+    /**
+     * @brief Get the book for a symbol ID
+     * @param symbol Interned symbol ID
+     * @return Book or nullptr if no book is registered
+     */
+    OrderBook* getBook(SymbolId symbol) const {
+        return symbol < books_.size() ? books_[symbol].get() : nullptr;
+    }
+
+    /**
+     * @brief Get the book for a symbol name
+     * @param symbol Instrument symbol
+     * @return Book or nullptr if no book is registered
+     */
+    OrderBook* getBook(std::string_view symbol) const;
+
+    // Operations routed by symbol
+    OrderResult addOrder(const Order& order);
+    OrderResult addOrder(const Order& order, MatchResult& result);
+    CancelResult cancelOrder(SymbolId symbol, OrderId id);
+    ModifyResult modifyOrder(SymbolId symbol, OrderId id, Price new_price, Quantity new_quantity);
+
+    /**
+     * @brief Cancel every resting order of an account in every book
+     *
+     * Each book is swept with OrderBook::cancelAccountOrders. Not
+     * synchronized: the caller must own every book (e.g. before matching
+     * threads start, or from a single-threaded setup).
+     * @param account Interned account
+     * @return Number of orders cancelled
+     */
+    size_t cancelAccountOrders(AccountId account);
+
+    /**
+     * @brief Get the shard that owns a symbol
+     * @param symbol Interned symbol ID
+     * @return Shard index or AutoShard if no book is registered
+     */
+    uint32_t getShard(SymbolId symbol) const {
+        return symbol < shard_of_.size() ? shard_of_[symbol] : AutoShard;
+    }
+
+    /**
+     * @brief Get the symbols pinned to a shard
+     * @param shard Shard index
+     * @return Symbol IDs in registration order
+     */
+    const std::vector<SymbolId>& getShardSymbols(uint32_t shard) const;
+
+    /**
+     * @brief Visit every registered book
+     * @param visitor Callable taking (SymbolId, OrderBook&)
+     */
+    template<typename Visitor>
+    void forEachBook(Visitor&& visitor) const {
+        for (SymbolId symbol : symbols_) {
+            visitor(symbol, *books_[symbol]);
+        }
+    }
+
+    /**
+     * @brief Add every book's published metrics to a scrape (any thread)
+     * @param out Scrape being built
+     */
+    void exportMetrics(MetricsWriter& out) const;
+
+    size_t getBookCount() const { return symbols_.size(); }
+    size_t getShardCount() const { return shards_.size(); }
+    const std::vector<SymbolId>& getSymbols() const { return symbols_; }
+    const RouterConfig& getConfig() const { return config_; }
+    const RiskManagerPtr& getRiskManager() const { return risk_manager_; }
+
+private:
+    RouterConfig config_;
+
+    // Indexed by SymbolId; unregistered IDs hold nullptr / AutoShard
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    std::vector<uint32_t> shard_of_;
+
+    std::vector<SymbolId> symbols_;                 // Registered symbols in order
+    std::vector<std::vector<SymbolId>> shards_;     // Symbols per shard
+    uint32_t next_shard_ = 0;
+
+    // Shared by every book
+    RiskManagerPtr risk_manager_;
+    MarketDataPublisherPtr market_data_;
+    LoggerPtr logger_;
+};
+
+}
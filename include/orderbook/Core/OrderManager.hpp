@@ -2,7 +2,7 @@
 #include "Types.hpp"
 #include "Order.hpp"
 #include "Interfaces.hpp"
-#include <unordered_map>
+#include "../Utilities/FlatHashMap.hpp"
 #include <memory>
 #include <atomic>
 
@@ -117,10 +117,10 @@ public:
 
 private:
     // Order storage with O(1) lookup
-    std::unordered_map<OrderId, std::unique_ptr<Order>, OrderIdHash> orders_;
+    FlatHashMap<OrderId, std::unique_ptr<Order>, OrderIdHash> orders_;
     
     // Order location tracking for fast book operations
-    std::unordered_map<OrderId, OrderLocation, OrderIdHash> order_locations_;
+    FlatHashMap<OrderId, OrderLocation, OrderIdHash> order_locations_;
     
     // Atomic counter for order ID generation
     std::atomic<uint64_t> next_order_id_;
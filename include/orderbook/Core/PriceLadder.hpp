@@ -0,0 +1,306 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "../Utilities/MemoryArena.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Direct-indexed price ladder for one side of the book
+ *
+ * Levels are addressed by tick offset from a moving anchor price, so lookup,
+ * insert and erase are O(1). A bitmap of occupied slots lets the best-price
+ * cursor move to the next non-empty level one 64-slot word at a time.
+ * The ladder stores pointers only; PriceLevel ownership stays with the caller.
+ * Slot and bitmap storage can be drawn from the book's MemoryArena.
+ *
+ * The window never grows past max_capacity ticks, so one level priced far
+ * from the rest cannot blow up the slot array; insert() refuses it instead.
+ */
+class PriceLadder {
+public:
+    static constexpr size_t DefaultCapacity = 4096;
+    static constexpr size_t DefaultMaxCapacity = size_t{1} << 20;
+
+    /**
+     * @brief Constructor
+     * @param side Book side (Buy keeps the highest price as best, Sell the lowest)
+     * @param capacity Initial number of tick slots (rounded up to a multiple of 64)
+     * @param arena Arena for slot storage (nullptr = heap; must outlive the ladder)
+     * @param max_capacity Widest the window may grow, in ticks (rounded up to a multiple of 64)
+     */
+    explicit PriceLadder(Side side, size_t capacity = DefaultCapacity, MemoryArena* arena = nullptr,
+                         size_t max_capacity = DefaultMaxCapacity)
+        : side_(side), max_capacity_(roundCapacity(max_capacity)),
+          slots_(ArenaAllocator<PriceLevel*>(arena)), bitmap_(ArenaAllocator<uint64_t>(arena)) {
+        size_t initial = roundCapacity(capacity);
+        resize(initial < max_capacity_ ? initial : max_capacity_);
+    }
+
+    /**
+     * @brief Find the level at a price
+     * @param ticks Price in ticks
+     * @return Level pointer or nullptr if no level exists
+     */
+    PriceLevel* find(PriceTicks ticks) const {
+        if (!contains(ticks)) return nullptr;
+        return slots_[slotOf(ticks)];
+    }
+
+    /**
+     * @brief Whether a level at this price can be inserted without exceeding max_capacity
+     * @param ticks Price in ticks
+     */
+    bool fits(PriceTicks ticks) const {
+        if (count_ == 0 || contains(ticks)) return true;
+        PriceTicks low, high;
+        occupiedRange(low, high);
+        return spanOf(low < ticks ? low : ticks, high > ticks ? high : ticks) <= max_capacity_;
+    }
+
+    /**
+     * @brief Insert a level, re-anchoring or growing the ladder if needed
+     * @param level Level to insert (must not already be present)
+     * @return false if the price lies outside the widest allowed window or the
+     *         grown window could not be allocated; the ladder is unchanged then
+     */
+    bool insert(PriceLevel* level) {
+        if (!level) return false;
+
+        if (count_ == 0) {
+            // Centre an empty ladder on the first price it sees
+            anchor_ = level->ticks - static_cast<PriceTicks>(slots_.size() / 2);
+        } else if (!contains(level->ticks) && !recenter(level->ticks)) {
+            return false;
+        }
+
+        size_t slot = slotOf(level->ticks);
+        slots_[slot] = level;
+        bitmap_[slot >> 6] |= (uint64_t{1} << (slot & 63));
+        ++count_;
+
+        if (best_ == NoSlot || isBetter(slot, best_)) {
+            best_ = slot;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove the level at a price
+     * @param ticks Price in ticks
+     */
+    void erase(PriceTicks ticks) {
+        if (!contains(ticks)) return;
+        size_t slot = slotOf(ticks);
+        if (!slots_[slot]) return;
+
+        slots_[slot] = nullptr;
+        bitmap_[slot >> 6] &= ~(uint64_t{1} << (slot & 63));
+        --count_;
+
+        if (slot == best_) {
+            best_ = count_ == 0 ? NoSlot : nextOccupied(slot);
+        }
+    }
+
+    /**
+     * @brief Get the best level (highest bid or lowest ask)
+     * @return Best level or nullptr if the side is empty
+     */
+    PriceLevel* best() const {
+        return best_ == NoSlot ? nullptr : slots_[best_];
+    }
+
+    /**
+     * @brief Get the next non-empty level behind a given level
+     * @param level Current level
+     * @return Next worse level or nullptr if none
+     */
+    PriceLevel* next(const PriceLevel* level) const {
+        if (!level || !contains(level->ticks)) return nullptr;
+        size_t slot = nextOccupied(slotOf(level->ticks));
+        return slot == NoSlot ? nullptr : slots_[slot];
+    }
+
+    /**
+     * @brief Visit up to max_levels levels from the best price outwards
+     * @param max_levels Maximum number of levels to visit
+     * @param visitor Callable taking const PriceLevel&
+     */
+    template<typename Visitor>
+    void forEachFromBest(size_t max_levels, Visitor&& visitor) const {
+        size_t slot = best_;
+        for (size_t visited = 0; slot != NoSlot && visited < max_levels; ++visited) {
+            visitor(*slots_[slot]);
+            slot = nextOccupied(slot);
+        }
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+    size_t maxCapacity() const { return max_capacity_; }
+    PriceTicks anchor() const { return anchor_; }
+
+private:
+    static constexpr size_t NoSlot = static_cast<size_t>(-1);
+
+    Side side_;
+    size_t max_capacity_;
+    PriceTicks anchor_ = 0;          // Price of slot 0
+    size_t count_ = 0;
+    size_t best_ = NoSlot;
+    std::vector<PriceLevel*, ArenaAllocator<PriceLevel*>> slots_;
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> bitmap_;   // One bit per slot, set when occupied
+
+    static size_t roundCapacity(size_t capacity) {
+        return capacity < 64 ? 64 : (capacity + 63) & ~size_t{63};
+    }
+
+    void resize(size_t capacity) {
+        slots_.assign(capacity, nullptr);
+        bitmap_.assign(capacity / 64, 0);
+    }
+
+    bool contains(PriceTicks ticks) const {
+        return ticks >= anchor_ && ticks - anchor_ < static_cast<PriceTicks>(slots_.size());
+    }
+
+    size_t slotOf(PriceTicks ticks) const {
+        return static_cast<size_t>(ticks - anchor_);
+    }
+
+    bool isBetter(size_t a, size_t b) const {
+        return side_ == Side::Buy ? a > b : a < b;
+    }
+
+    static size_t spanOf(PriceTicks low, PriceTicks high) {
+        return static_cast<size_t>(high - low) + 1;
+    }
+
+    /**
+     * @brief Lowest and highest occupied prices (ladder must not be empty)
+     */
+    void occupiedRange(PriceTicks& low, PriceTicks& high) const {
+        size_t first = 0;
+        while (!bitmap_[first]) ++first;
+        size_t last = bitmap_.size() - 1;
+        while (!bitmap_[last]) --last;
+        low = anchor_ + static_cast<PriceTicks>((first << 6) + lowestBit(bitmap_[first]));
+        high = anchor_ + static_cast<PriceTicks>((last << 6) + highestBit(bitmap_[last]));
+    }
+
+    /**
+     * @brief Move the window so it covers both the current levels and a new price
+     * @param ticks Price that must fit after re-anchoring
+     * @return false if the combined span exceeds max_capacity or allocation fails
+     */
+    bool recenter(PriceTicks ticks) {
+        PriceTicks low, high;
+        occupiedRange(low, high);
+        low = ticks < low ? ticks : low;
+        high = ticks > high ? ticks : high;
+
+        size_t span = spanOf(low, high);
+        if (span > max_capacity_) {
+            return false;
+        }
+
+        // Double for headroom, but never past the band
+        size_t capacity = slots_.size();
+        while (capacity < span * 2 && capacity < max_capacity_) {
+            capacity *= 2;
+        }
+        capacity = capacity < max_capacity_ ? capacity : max_capacity_;
+
+        // Allocated before any state changes, so a failure leaves the ladder intact
+        std::vector<PriceLevel*, ArenaAllocator<PriceLevel*>> new_slots(slots_.get_allocator());
+        std::vector<uint64_t, ArenaAllocator<uint64_t>> new_bitmap(bitmap_.get_allocator());
+        try {
+            new_slots.assign(capacity, nullptr);
+            new_bitmap.assign(capacity / 64, 0);
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+
+        // Leave headroom on both sides of the occupied range
+        PriceTicks new_anchor = low - static_cast<PriceTicks>((capacity - span) / 2);
+        size_t new_best = NoSlot;
+        for (PriceLevel* level : slots_) {
+            if (!level) continue;
+            size_t slot = static_cast<size_t>(level->ticks - new_anchor);
+            new_slots[slot] = level;
+            new_bitmap[slot >> 6] |= (uint64_t{1} << (slot & 63));
+            if (new_best == NoSlot || isBetter(slot, new_best)) {
+                new_best = slot;
+            }
+        }
+
+        slots_.swap(new_slots);
+        bitmap_.swap(new_bitmap);
+        anchor_ = new_anchor;
+        best_ = new_best;
+        return true;
+    }
+
+    /**
+     * @brief Find the next occupied slot moving away from the best price
+     * @param slot Starting slot (excluded)
+     * @return Occupied slot or NoSlot
+     */
+    size_t nextOccupied(size_t slot) const {
+        if (side_ == Side::Buy) {
+            // Bids get worse as the price falls
+            if (slot == 0) return NoSlot;
+            --slot;
+            size_t word = slot >> 6;
+            uint64_t bits = bitmap_[word] & (~uint64_t{0} >> (63 - (slot & 63)));
+            while (true) {
+                if (bits) return (word << 6) + highestBit(bits);
+                if (word == 0) return NoSlot;
+                bits = bitmap_[--word];
+            }
+        }
+
+        // Asks get worse as the price rises
+        ++slot;
+        if (slot >= slots_.size()) return NoSlot;
+        size_t word = slot >> 6;
+        uint64_t bits = bitmap_[word] & (~uint64_t{0} << (slot & 63));
+        while (true) {
+            if (bits) return (word << 6) + lowestBit(bits);
+            if (++word >= bitmap_.size()) return NoSlot;
+            bits = bitmap_[word];
+        }
+    }
+
+    static size_t lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return index;
+#else
+        return static_cast<size_t>(__builtin_ctzll(bits));
+#endif
+    }
+
+    static size_t highestBit(uint64_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, bits);
+        return index;
+#else
+        return 63 - static_cast<size_t>(__builtin_clzll(bits));
+#endif
+    }
+};
+
+}
@@ -1,7 +1,11 @@
 #pragma once
 #include <cstdint>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <string_view>
+#include <optional>
 #include <variant>
 #include <functional>
 
@@ -17,10 +21,14 @@ namespace orderbook {
         constexpr bool operator<(const OrderId& other) const { return value < other.value; }
     };
 
-    // Custom hash function for OrderId to use in unordered_map
+    // Hash for OrderId keys. std::hash<uint64_t> is the identity on libstdc++,
+    // so sequential IDs are run through a 64-bit finalizer (splitmix64) first.
     struct OrderIdHash {
         std::size_t operator()(const OrderId& id) const {
-            return std::hash<uint64_t>{}(id.value);
+            uint64_t x = id.value;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return static_cast<std::size_t>(x ^ (x >> 31));
         }
     };
 
@@ -36,10 +44,121 @@ namespace orderbook {
 
     // Template-friendly type aliases
     using Price = double;
+    using PriceTicks = int64_t;  // Fixed-point price expressed as a whole number of ticks
     using Quantity = uint64_t;
     using Timestamp = std::chrono::system_clock::time_point;
     using SequenceNumber = uint64_t;
 
+    /**
+     * @brief Per-instrument tick size for fixed-point price conversion
+     * 
+     * The tick is kept as an exact decimal (units * 10^-decimals) so wire prices
+     * can be converted to integer ticks without going through floating point.
+     */
+    class TickSize {
+    public:
+        static constexpr int MaxDecimals = 9;
+        
+        explicit TickSize(Price size = 0.01) : size_(size > 0.0 ? size : 0.01) {
+            int64_t scale = 1;
+            for (decimals_ = 0; decimals_ < MaxDecimals; ++decimals_, scale *= 10) {
+                double scaled = size_ * static_cast<double>(scale);
+                if (std::abs(scaled - std::round(scaled)) < 1e-9 * std::max(1.0, scaled)) {
+                    break;
+                }
+            }
+            units_ = std::max<int64_t>(1, std::llround(size_ * static_cast<double>(scale)));
+            size_ = static_cast<double>(units_) / static_cast<double>(scale);
+            inverse_ = 1.0 / size_;
+        }
+        
+        /**
+         * @brief Convert a decimal price to the nearest tick
+         * @param price Decimal price
+         * @return Price in ticks
+         */
+        PriceTicks toTicks(Price price) const {
+            return static_cast<PriceTicks>(std::llround(price * inverse_));
+        }
+        
+        /**
+         * @brief Convert ticks back to a decimal price
+         * @param ticks Price in ticks
+         * @return Decimal price
+         */
+        Price toPrice(PriceTicks ticks) const {
+            return static_cast<Price>(ticks) * size_;
+        }
+        
+        /**
+         * @brief Check whether a decimal price lies on the tick grid
+         * @param price Decimal price
+         * @return true if price is a whole number of ticks
+         */
+        bool isOnTick(Price price) const {
+            double ticks = price * inverse_;
+            return std::abs(ticks - std::round(ticks)) < 1e-6;
+        }
+        
+        /**
+         * @brief Parse a decimal string (e.g. FIX tag 44) directly into ticks
+         * @param text Decimal text such as "101.25" or "-3"
+         * @return Ticks, or nullopt if malformed or not on the tick grid
+         */
+        std::optional<PriceTicks> parse(std::string_view text) const {
+            size_t pos = 0;
+            bool negative = false;
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+                negative = text[pos] == '-';
+                ++pos;
+            }
+            
+            int64_t scaled = 0;
+            int integer_digits = 0;
+            int fraction_digits = 0;
+            bool seen_point = false;
+            
+            for (; pos < text.size(); ++pos) {
+                char c = text[pos];
+                if (c == '.') {
+                    if (seen_point) return std::nullopt;
+                    seen_point = true;
+                    continue;
+                }
+                if (c < '0' || c > '9') return std::nullopt;
+                
+                if (!seen_point) {
+                    if (++integer_digits > 18 - decimals_) return std::nullopt;
+                    scaled = scaled * 10 + (c - '0');
+                } else if (fraction_digits < decimals_) {
+                    scaled = scaled * 10 + (c - '0');
+                    ++fraction_digits;
+                } else if (c != '0') {
+                    return std::nullopt; // More precision than the tick allows
+                }
+            }
+            
+            if (integer_digits == 0 && fraction_digits == 0) return std::nullopt;
+            for (; fraction_digits < decimals_; ++fraction_digits) {
+                scaled *= 10;
+            }
+            if (scaled % units_ != 0) return std::nullopt;
+            
+            PriceTicks ticks = scaled / units_;
+            return negative ? -ticks : ticks;
+        }
+        
+        Price size() const { return size_; }
+        int decimals() const { return decimals_; }
+        int64_t units() const { return units_; }
+        
+    private:
+        Price size_;
+        double inverse_ = 100.0;
+        int decimals_ = 0;
+        int64_t units_ = 1;
+    };
+
     // Core enums
     enum class Side : uint8_t { Buy, Sell };
     enum class OrderType : uint8_t { Limit, Market };
@@ -0,0 +1,163 @@
+#pragma once
+#include "MarketDataFeed.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Decouples a slow market data subscriber from the publishing thread
+ *
+ * Subscribed to a MarketDataPublisher in place of the real subscriber. The
+ * publisher's callbacks only record the update under a short lock: trades
+ * are queued, book updates keep the latest state of each (symbol, side,
+ * price) level, and best prices and depth keep only the latest snapshot
+ * per symbol. A delivery thread hands the accumulated state to the
+ * downstream subscriber once per interval, or as soon as the subscriber has
+ * returned from the previous batch when the interval is zero.
+ *
+ * Book updates carry level totals, so the latest one per level is the
+ * level's state at delivery. Its type is relative to the previous delivery:
+ * a level that appeared in the interval is delivered as Add, one that was
+ * there before as Modify, and Remove only when the level is empty at
+ * delivery; a level that appeared and emptied within one interval is not
+ * delivered at all.
+ *
+ * Trades are delivered losslessly and in order. Conflated updates carry the
+ * sequence number of the latest update they replace, so sequence gaps are
+ * expected on those streams.
+ */
+class ConflatingSubscriber : public IMarketDataSubscriber {
+public:
+    /**
+     * @brief Conflation settings
+     */
+    struct ConflationConfig {
+        std::chrono::microseconds interval{1000};   // Minimum time between deliveries (0 = when idle)
+    };
+
+    /**
+     * @brief Delivery counters
+     */
+    struct Stats {
+        uint64_t updates_received = 0;      // Non-trade updates from the publisher
+        uint64_t updates_delivered = 0;     // Non-trade updates passed downstream
+        uint64_t trades_delivered = 0;
+        uint64_t batches_delivered = 0;
+    };
+
+    ConflatingSubscriber(std::shared_ptr<IMarketDataSubscriber> downstream, LoggerPtr logger = nullptr);
+    ConflatingSubscriber(std::shared_ptr<IMarketDataSubscriber> downstream, LoggerPtr logger,
+                         const ConflationConfig& config);
+    ~ConflatingSubscriber() override;
+
+    ConflatingSubscriber(const ConflatingSubscriber&) = delete;
+    ConflatingSubscriber& operator=(const ConflatingSubscriber&) = delete;
+
+    /**
+     * @brief Start the delivery thread
+     */
+    void start();
+
+    /**
+     * @brief Deliver anything still pending and stop the delivery thread
+     */
+    void stop();
+
+    // IMarketDataSubscriber, called on the publishing thread; never waits on downstream
+    void onTrade(const Trade& trade, SequenceNumber sequence) override;
+    void onBookUpdate(const BookUpdate& update) override;
+    void onBestPrices(const BestPrices& prices, SequenceNumber sequence) override;
+    void onDepth(const MarketDepth& depth, SequenceNumber sequence) override;
+
+    const std::shared_ptr<IMarketDataSubscriber>& getDownstream() const { return downstream_; }
+    Stats getStats() const;
+
+    /**
+     * @brief Read conflation settings from the [market_data] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static ConflationConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    struct LevelKey {
+        SymbolId symbol;
+        Side side;
+        Price price;
+
+        bool operator==(const LevelKey& other) const {
+            return symbol == other.symbol && side == other.side && price == other.price;
+        }
+    };
+
+    struct LevelKeyHash {
+        size_t operator()(const LevelKey& key) const {
+            return std::hash<double>{}(key.price) ^ (static_cast<size_t>(key.symbol) << 1) ^
+                   static_cast<size_t>(key.side);
+        }
+    };
+
+    /**
+     * @brief A level's state since the previous delivery
+     */
+    struct PendingLevel {
+        BookUpdate latest;          // Level state as of the newest update
+        bool appeared;              // The interval's first update created the level
+    };
+
+    /**
+     * @brief Updates accumulated between two deliveries
+     */
+    struct Batch {
+        std::vector<std::pair<Trade, SequenceNumber>> trades;
+        FlatHashMap<LevelKey, PendingLevel, LevelKeyHash> levels;
+        FlatHashMap<SymbolId, std::pair<BestPrices, SequenceNumber>> best_prices;
+        FlatHashMap<SymbolId, std::pair<MarketDepth, SequenceNumber>> depths;
+
+        bool empty() const {
+            return trades.empty() && levels.empty() && best_prices.empty() && depths.empty();
+        }
+
+        void clear() {
+            trades.clear();
+            levels.clear();
+            best_prices.clear();
+            depths.clear();
+        }
+
+        void swap(Batch& other) {
+            trades.swap(other.trades);
+            levels.swap(other.levels);
+            best_prices.swap(other.best_prices);
+            depths.swap(other.depths);
+        }
+    };
+
+    std::shared_ptr<IMarketDataSubscriber> downstream_;
+    LoggerPtr logger_;
+    ConflationConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    Batch pending_;             // Filled by the publisher under mutex_
+    Batch delivering_;          // Owned by the delivery thread
+    bool running_ = false;
+    std::thread thread_;
+
+    Stats stats_;               // Guarded by mutex_
+
+    void run();
+    size_t deliver(Batch& batch);
+    void wakeIfFirst(bool was_empty);
+};
+
+}
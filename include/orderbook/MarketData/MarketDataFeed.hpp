@@ -12,6 +12,9 @@
 
 namespace orderbook {
 
+class ConflatingSubscriber;
+class MetricsWriter;
+
 /**
  * @brief Market data subscriber interface for receiving updates
  */
@@ -53,7 +56,7 @@ public:
 class MarketDataPublisher : public IMarketDataPublisher {
 public:
     explicit MarketDataPublisher(LoggerPtr logger = nullptr);
-    ~MarketDataPublisher() = default;
+    ~MarketDataPublisher();
     
     // IMarketDataPublisher interface implementation
     void publishTrade(const Trade& trade) override;
@@ -62,10 +65,24 @@ public:
     void publishDepth(const MarketDepth& depth) override;
     void subscribe(std::function<void(const std::string&)> callback) override;
     
-    // Enhanced subscriber management
+    // Enhanced subscriber management. Changes wait for in-flight publishes,
+    // so they must not be made from inside a subscriber callback.
     void subscribe(std::shared_ptr<IMarketDataSubscriber> subscriber);
     void unsubscribe(std::shared_ptr<IMarketDataSubscriber> subscriber);
     
+    /**
+     * @brief Subscribe through a conflation stage with its own delivery thread
+     *
+     * The subscriber's callbacks run on that thread, so a slow subscriber
+     * only delays its own updates. Trades are delivered losslessly; book
+     * updates, best prices and depth are conflated to the latest state.
+     * unsubscribe() with the same subscriber stops the stage.
+     * @param subscriber Downstream subscriber
+     * @param interval Minimum time between deliveries (0 = whenever the subscriber is idle)
+     */
+    void subscribeConflated(std::shared_ptr<IMarketDataSubscriber> subscriber,
+                            std::chrono::microseconds interval);
+    
     // Statistics and monitoring
     SequenceNumber getSequenceNumber() const;
     size_t getSubscriberCount() const;
@@ -84,19 +101,70 @@ public:
     
     PublishingStats getStats() const;
     void resetStats();
+    
+    /**
+     * @brief Add publishing counters and the subscriber count to a scrape (any thread)
+     * @param out Scrape being built
+     */
+    void exportMetrics(MetricsWriter& out) const;
 
 private:
-    // Subscriber management
-    std::vector<std::function<void(const std::string&)>> string_subscribers_;
-    std::vector<std::weak_ptr<IMarketDataSubscriber>> typed_subscribers_;
-    mutable std::mutex subscribers_mutex_;
+    /**
+     * @brief Immutable set of subscribers
+     *
+     * Publishing reads the current registry without locking. Subscribe and
+     * unsubscribe build a modified copy, swap it in and free the old one
+     * once no publisher can still be reading it.
+     */
+    struct Registry {
+        std::vector<std::function<void(const std::string&)>> string_subscribers;
+        std::vector<std::weak_ptr<IMarketDataSubscriber>> typed_subscribers;
+    };
+    
+    /**
+     * @brief Keeps the current registry alive for the duration of one publish
+     */
+    class RegistryGuard {
+    public:
+        explicit RegistryGuard(const MarketDataPublisher& publisher);
+        ~RegistryGuard();
+        RegistryGuard(const RegistryGuard&) = delete;
+        RegistryGuard& operator=(const RegistryGuard&) = delete;
+        
+        const Registry& operator*() const { return *registry_; }
+        const Registry* operator->() const { return registry_; }
+        
+    private:
+        std::atomic<uint64_t>* readers_;
+        const Registry* registry_;
+    };
+    
+    struct alignas(64) ReaderCount {
+        mutable std::atomic<uint64_t> count{0};
+    };
+    
+    // Subscriber management. Readers register in readers_[epoch % 2]; a
+    // writer flips the epoch and waits for the old parity to drain.
+    std::atomic<const Registry*> registry_;
+    alignas(64) std::atomic<uint64_t> registry_epoch_{0};
+    ReaderCount readers_[2];
+    std::mutex registry_mutex_;     // Serializes subscribe/unsubscribe
+    std::vector<std::shared_ptr<ConflatingSubscriber>> conflated_subscribers_;  // Owned; guarded by registry_mutex_
     
     // Sequence numbering for gap detection
     std::atomic<SequenceNumber> sequence_number_;
     
-    // Performance tracking
-    mutable std::mutex stats_mutex_;
-    PublishingStats stats_;
+    // Performance tracking, updated with relaxed atomics from any publishing thread
+    struct AtomicStats {
+        std::atomic<uint64_t> trades_published{0};
+        std::atomic<uint64_t> book_updates_published{0};
+        std::atomic<uint64_t> best_price_updates_published{0};
+        std::atomic<uint64_t> depth_updates_published{0};
+        std::atomic<uint64_t> total_latency_ns{0};
+        std::atomic<uint64_t> max_latency_ns{0};
+        std::atomic<uint64_t> min_latency_ns{UINT64_MAX};
+    };
+    AtomicStats stats_;
     
     // Logging
     LoggerPtr logger_;
@@ -108,18 +176,20 @@ private:
     std::string formatDepthMessage(const MarketDepth& depth, SequenceNumber seq) const;
     
     // Notification methods
-    void notifyStringSubscribers(const std::string& message);
-    void notifyTypedSubscribers(const Trade& trade, SequenceNumber seq);
-    void notifyTypedSubscribers(const BookUpdate& update);
-    void notifyTypedSubscribers(const BestPrices& prices, SequenceNumber seq);
-    void notifyTypedSubscribers(const MarketDepth& depth, SequenceNumber seq);
+    void notifyStringSubscribers(const Registry& registry, const std::string& message);
+    template<typename Callback>
+    void notifyTypedSubscribers(const Registry& registry, Callback&& callback);
+    
+    /**
+     * @brief Publish a modified registry and free the old one after a grace period
+     * @param update Applied to a copy of the current registry (registry_mutex_ held)
+     */
+    template<typename Update>
+    void updateRegistry(Update&& update);
     
     // Performance tracking
     void recordLatency(uint64_t latency_ns);
     uint64_t getCurrentTimeNs() const;
-    
-    // Cleanup expired weak pointers
-    void cleanupExpiredSubscribers();
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+#include "MarketDataFeed.hpp"
+#include <boost/asio.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+class OrderBook;
+
+/**
+ * @brief Wire format of the multicast feed
+ *
+ * Every datagram starts with a PacketHeader followed by message_count
+ * messages. All fields are little-endian and unaligned; each message starts
+ * with its type and total length so readers can skip types they do not know.
+ *
+ * On the incremental channel, PacketHeader::sequence is the feed sequence
+ * of the first message and the following messages are numbered
+ * consecutively, so a gap in the feed sequence means lost messages. On the
+ * snapshot channel it numbers the datagrams, and each SnapshotStart gives
+ * the incremental sequence the snapshot is current up to.
+ */
+namespace multicast {
+
+enum class Channel : uint8_t { Incremental = 0, Snapshot = 1 };
+
+enum class MessageType : uint8_t {
+    Trade = 'T',
+    BookUpdate = 'U',
+    SnapshotStart = 'S',
+    SnapshotLevel = 'L'
+};
+
+constexpr uint8_t ProtocolVersion = 1;
+
+#pragma pack(push, 1)
+struct PacketHeader {
+    uint64_t sequence;
+    uint16_t message_count;
+    Channel channel;
+    uint8_t version;
+    uint32_t reserved;
+};
+
+struct MessageHeader {
+    MessageType type;
+    uint8_t length;             // Whole message, header included
+};
+
+struct TradeMessage {
+    MessageHeader header;
+    SymbolId symbol_id;
+    uint64_t trade_id;
+    Price price;
+    Quantity quantity;
+    int64_t timestamp_ns;
+};
+
+struct BookUpdateMessage {
+    MessageHeader header;
+    SymbolId symbol_id;
+    uint8_t side;               // Side
+    uint8_t update_type;        // BookUpdate::Type
+    Price price;
+    Quantity quantity;          // Level total after the update, as in a snapshot level
+    uint32_t order_count;
+    SequenceNumber book_sequence;
+    int64_t timestamp_ns;
+};
+
+struct SnapshotStartMessage {
+    MessageHeader header;
+    SymbolId symbol_id;
+    uint64_t last_sequence;     // Incremental messages up to this sequence are reflected
+    uint16_t bid_count;
+    uint16_t ask_count;
+    int64_t timestamp_ns;
+};
+
+struct SnapshotLevelMessage {
+    MessageHeader header;
+    SymbolId symbol_id;
+    uint8_t side;
+    Price price;
+    Quantity quantity;
+    uint32_t order_count;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PacketHeader) == 16, "Packet header layout is part of the wire format");
+
+}
+
+/**
+ * @brief Market data subscriber that republishes trades and book updates over UDP multicast
+ *
+ * The publishing thread only encodes each update into the datagram being
+ * filled. A feed thread sends datagrams as they fill up, or about
+ * flush_interval after their first message otherwise, so several messages
+ * share a datagram under load and the matching path never makes a syscall.
+ *
+ * A second multicast group carries periodic depth snapshots for late
+ * joiners and gap recovery. Books are not internally synchronized, so the
+ * feed does not read them directly: the snapshot source passed to
+ * setSnapshotSource() calls the visitor for each book while that book is
+ * not being modified, e.g. under the matching shard's lock.
+ */
+class MulticastFeedPublisher : public IMarketDataSubscriber {
+public:
+    using BookVisitor = std::function<void(const OrderBook&)>;
+    using SnapshotSource = std::function<void(const BookVisitor&)>;
+
+    /**
+     * @brief Feed settings
+     */
+    struct FeedConfig {
+        std::string incremental_group = "239.255.0.1";
+        uint16_t incremental_port = 30001;
+        std::string snapshot_group = "239.255.0.2";
+        uint16_t snapshot_port = 30002;
+        std::string interface_address;                  // Outbound interface (empty = default route)
+        int ttl = 1;
+        bool loopback = true;                           // Deliver to receivers on this host too
+        size_t max_datagram = 1400;                     // Bytes, kept under a typical MTU
+        std::chrono::microseconds flush_interval{100};  // How long a partial datagram waits
+        std::chrono::milliseconds snapshot_interval{1000};
+        size_t snapshot_levels = 10;                    // Levels per side in snapshots
+    };
+
+    /**
+     * @brief Feed counters
+     */
+    struct Stats {
+        uint64_t messages_sent = 0;         // Incremental messages
+        uint64_t datagrams_sent = 0;        // Incremental datagrams
+        uint64_t snapshots_sent = 0;        // Book snapshots
+        uint64_t send_errors = 0;
+    };
+
+    explicit MulticastFeedPublisher(LoggerPtr logger = nullptr);
+    MulticastFeedPublisher(LoggerPtr logger, const FeedConfig& config);
+    ~MulticastFeedPublisher() override;
+
+    MulticastFeedPublisher(const MulticastFeedPublisher&) = delete;
+    MulticastFeedPublisher& operator=(const MulticastFeedPublisher&) = delete;
+
+    /**
+     * @brief Set where snapshots come from; must be called before start()
+     */
+    void setSnapshotSource(SnapshotSource source) { snapshot_source_ = std::move(source); }
+
+    /**
+     * @brief Open the sending socket and start the feed thread
+     * @return true on success, or the socket error
+     */
+    Result<bool> start();
+
+    /**
+     * @brief Send anything still pending and stop the feed thread
+     */
+    void stop();
+
+    // IMarketDataSubscriber, called on the publishing thread
+    void onTrade(const Trade& trade, SequenceNumber sequence) override;
+    void onBookUpdate(const BookUpdate& update) override;
+    void onBestPrices(const BestPrices&, SequenceNumber) override {}
+    void onDepth(const MarketDepth&, SequenceNumber) override {}
+
+    /**
+     * @brief Sequence of the last incremental message encoded (0 before the first)
+     */
+    uint64_t getLastSequence() const;
+    Stats getStats() const;
+    const FeedConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Read feed settings from the [multicast] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static FeedConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    using Datagram = std::vector<uint8_t>;
+
+    LoggerPtr logger_;
+    FeedConfig config_;
+    SnapshotSource snapshot_source_;
+
+    boost::asio::io_context io_context_;
+    boost::asio::ip::udp::socket socket_;
+    boost::asio::ip::udp::endpoint incremental_endpoint_;
+    boost::asio::ip::udp::endpoint snapshot_endpoint_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    Datagram filling_;                      // Incremental datagram being built
+    uint16_t filling_count_ = 0;
+    std::vector<Datagram> ready_;           // Sealed, waiting for the feed thread
+    std::vector<Datagram> spare_;           // Sent buffers kept for reuse
+    uint64_t next_sequence_ = 1;
+    bool running_ = false;
+    std::thread thread_;
+    Stats stats_;                           // Guarded by mutex_
+
+    // Feed thread only
+    uint64_t next_snapshot_packet_ = 1;
+    Datagram snapshot_datagram_;
+    uint16_t snapshot_count_ = 0;
+
+    void run();
+
+    /**
+     * @brief Append one message to the incremental datagram (mutex_ held)
+     * @return true if the feed thread needs waking
+     */
+    template<typename Message>
+    bool appendIncremental(const Message& message);
+    void sealFilling();
+
+    void publishSnapshots();
+    void publishSnapshot(const OrderBook& book);
+    template<typename Message>
+    void appendSnapshot(const Message& message);
+    void flushSnapshot();
+
+    bool send(const Datagram& datagram, const boost::asio::ip::udp::endpoint& endpoint);
+};
+
+}
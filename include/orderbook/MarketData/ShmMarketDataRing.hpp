@@ -0,0 +1,240 @@
+#pragma once
+#include "MarketDataFeed.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Fixed-layout market data record as stored in a shared-memory ring
+ *
+ * One cache line per record. Prices are IEEE doubles and timestamps are
+ * nanoseconds since the system clock epoch, so readers in other processes
+ * need nothing beyond this header. Trades are published anonymously (no
+ * order IDs), as on a public feed.
+ */
+struct alignas(64) ShmMarketDataRecord {
+    enum class Type : uint8_t { Trade = 1, BookUpdate = 2, BestPrices = 3 };
+
+    static constexpr uint8_t HasBid = 0x01;     // BestPrices flags
+    static constexpr uint8_t HasAsk = 0x02;
+
+    uint64_t version;           // Seqlock word, owned by the ring
+    SequenceNumber sequence;    // Publisher sequence (book sequence for BookUpdate)
+    int64_t timestamp_ns;
+    SymbolId symbol_id;
+    Type type;
+    uint8_t side;               // Side, for BookUpdate
+    uint8_t update_type;        // BookUpdate::Type, for BookUpdate
+    uint8_t flags;
+
+    struct TradeFields {
+        uint64_t trade_id;
+        Price price;
+        Quantity quantity;
+    };
+
+    struct BookFields {
+        Price price;
+        Quantity quantity;      // Level total after the update
+        uint64_t order_count;
+    };
+
+    struct BestFields {
+        Price bid;
+        Quantity bid_size;
+        Price ask;
+        Quantity ask_size;
+    };
+
+    union {
+        TradeFields trade;
+        BookFields book;
+        BestFields best;
+    };
+};
+
+static_assert(sizeof(ShmMarketDataRecord) == 64, "Shared-memory records must stay one cache line");
+static_assert(std::is_trivially_copyable<ShmMarketDataRecord>::value, "Shared-memory records must be POD");
+
+/**
+ * @brief Layout of the mapped segment, shared by writer and readers
+ *
+ * A header followed by a power-of-two array of records. Record i holds ring
+ * position p (1-based) where i = (p - 1) % capacity; its version is 2p - 1
+ * while being written and 2p once complete, so a reader can tell an empty
+ * slot, a slot being written and a slot already overwritten by a later lap
+ * apart without any other shared state.
+ */
+struct ShmRingHeader {
+    static constexpr uint64_t Magic = 0x474E4952444D424Full;   // "OBMDRING", little-endian
+    static constexpr uint32_t Version = 1;
+
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t record_size;
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> write_position;  // Last completed ring position
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring positions must be lock-free across processes");
+
+/**
+ * @brief Producer side of a shared-memory market data ring
+ *
+ * Creates (or recreates) a POSIX shared-memory segment, normally visible
+ * under /dev/shm, and publishes records into it without blocking on
+ * readers: a slow reader is overrun rather than slowing the writer down.
+ * Concurrent calls to write() are serialized by a spin flag, so one writer
+ * can be fed from several publishing threads.
+ */
+class ShmRingWriter {
+public:
+    /**
+     * @param name Segment name (e.g. "/orderbook_md")
+     * @param capacity Record count, rounded up to a power of two
+     */
+    ShmRingWriter(std::string name, size_t capacity);
+    ~ShmRingWriter();
+
+    ShmRingWriter(const ShmRingWriter&) = delete;
+    ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+    /**
+     * @brief Create and map the segment
+     * @return true on success, or an error describing the failing call
+     */
+    Result<bool> open();
+
+    /**
+     * @brief Unmap and remove the segment; mapped readers keep their view
+     */
+    void close();
+
+    bool isOpen() const { return header_ != nullptr; }
+
+    /**
+     * @brief Publish a record
+     * @param record Record to copy; its version field is ignored
+     * @return Ring position the record was written at (0 if the ring is closed)
+     */
+    uint64_t write(const ShmMarketDataRecord& record);
+
+    const std::string& getName() const { return name_; }
+    size_t getCapacity() const { return capacity_; }
+
+private:
+    std::string name_;
+    size_t capacity_;
+    size_t mapped_size_ = 0;
+    ShmRingHeader* header_ = nullptr;
+    ShmMarketDataRecord* records_ = nullptr;
+    uint64_t position_ = 0;                     // Guarded by write_flag_
+    std::atomic_flag write_flag_ = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief Consumer side of a shared-memory market data ring
+ *
+ * Maps an existing segment read-only. Reads never make syscalls: tryRead()
+ * polls the next slot and copies it out. A reader that falls more than a
+ * ring behind skips to the oldest record still available and counts the
+ * skipped records as missed.
+ */
+class ShmRingReader {
+public:
+    explicit ShmRingReader(std::string name);
+    ~ShmRingReader();
+
+    ShmRingReader(const ShmRingReader&) = delete;
+    ShmRingReader& operator=(const ShmRingReader&) = delete;
+
+    /**
+     * @brief Map the segment and start after its latest record
+     * @return true on success, or an error if the segment is missing or incompatible
+     */
+    Result<bool> open();
+    void close();
+
+    bool isOpen() const { return header_ != nullptr; }
+
+    /**
+     * @brief Copy out the next record if one is available
+     * @param record Receives the record
+     * @return true if a record was read
+     */
+    bool tryRead(ShmMarketDataRecord& record);
+
+    /**
+     * @brief Restart from the oldest record still held by the ring
+     */
+    void rewind();
+
+    uint64_t getPosition() const { return next_position_ - 1; }      // Last position read
+    uint64_t getMissedRecords() const { return missed_records_; }
+    uint64_t getAvailable() const;
+
+private:
+    std::string name_;
+    size_t mapped_size_ = 0;
+    const ShmRingHeader* header_ = nullptr;
+    const ShmMarketDataRecord* records_ = nullptr;
+    uint64_t mask_ = 0;
+    uint64_t next_position_ = 1;
+    uint64_t missed_records_ = 0;
+
+    uint64_t oldestAvailable() const;
+};
+
+/**
+ * @brief Market data subscriber that forwards updates into a shared-memory ring
+ *
+ * Subscribe it to a MarketDataPublisher to expose trades, book updates and
+ * best prices to other processes on the host. Depth snapshots are
+ * variable-length and are not forwarded; readers rebuild depth from book
+ * updates.
+ */
+class ShmRingPublisher : public IMarketDataSubscriber {
+public:
+    /**
+     * @brief Ring settings
+     */
+    struct RingConfig {
+        std::string name;               // Segment name; empty disables the ring
+        size_t capacity = 65536;        // Records
+    };
+
+    explicit ShmRingPublisher(const RingConfig& config);
+
+    /**
+     * @brief Create the segment
+     * @return true on success, or the reason the segment could not be created
+     */
+    Result<bool> open() { return writer_.open(); }
+    bool isOpen() const { return writer_.isOpen(); }
+
+    void onTrade(const Trade& trade, SequenceNumber sequence) override;
+    void onBookUpdate(const BookUpdate& update) override;
+    void onBestPrices(const BestPrices& prices, SequenceNumber sequence) override;
+    void onDepth(const MarketDepth&, SequenceNumber) override {}
+
+    const ShmRingWriter& getWriter() const { return writer_; }
+
+    /**
+     * @brief Read ring settings from the [market_data] section
+     * @param config Configuration object
+     * @return Settings (ring disabled when config is null)
+     */
+    static RingConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    ShmRingWriter writer_;
+};
+
+}
@@ -13,8 +13,11 @@ namespace orderbook::fix {
     constexpr char MSG_TYPE_EXECUTION_REPORT = '8';
     constexpr char MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST = 'G';
     constexpr char MSG_TYPE_ORDER_CANCEL_REQUEST = 'F';
+    constexpr char MSG_TYPE_ORDER_MASS_CANCEL_REQUEST = 'q';
+    constexpr char MSG_TYPE_ORDER_MASS_CANCEL_REPORT = 'r';
     
     // Standard FIX Tags
+    constexpr int TAG_ACCOUNT = 1;
     constexpr int TAG_BEGIN_STRING = 8;
     constexpr int TAG_BODY_LENGTH = 9;
     constexpr int TAG_CHECKSUM = 10;
@@ -43,6 +46,19 @@ namespace orderbook::fix {
     constexpr int TAG_LAST_PX = 31;
     constexpr int TAG_HEARTBT_INT = 108;
     constexpr int TAG_TEST_REQ_ID = 112;
+    constexpr int TAG_TEXT = 58;
+    constexpr int TAG_MASS_CANCEL_REQUEST_TYPE = 530;
+    constexpr int TAG_MASS_CANCEL_RESPONSE = 531;
+    constexpr int TAG_MASS_CANCEL_REJECT_REASON = 532;
+    constexpr int TAG_TOTAL_AFFECTED_ORDERS = 533;
+    
+    // User-defined tags echoing a LatencyTrace in execution reports
+    constexpr int TAG_TRACE_RECEIVED_TICKS = 5001;      // Server TSC counter at receipt
+    constexpr int TAG_TRACE_PARSED_NS = 5002;           // Stage times in ns since receipt
+    constexpr int TAG_TRACE_DISPATCHED_NS = 5003;
+    constexpr int TAG_TRACE_RISK_CHECKED_NS = 5004;
+    constexpr int TAG_TRACE_MATCHED_NS = 5005;
+    constexpr int TAG_TRACE_ENCODED_NS = 5006;
     
     // Side values
     constexpr char SIDE_BUY = '1';
@@ -70,8 +86,17 @@ namespace orderbook::fix {
     constexpr char EXEC_TYPE_PARTIAL_FILL = '1';
     constexpr char EXEC_TYPE_FILL = '2';
     constexpr char EXEC_TYPE_CANCELLED = '4';
+    constexpr char EXEC_TYPE_REPLACED = '5';
     constexpr char EXEC_TYPE_REJECTED = '8';
     
+    // Mass Cancel Request Type values (also echoed as the accepted Mass Cancel Response)
+    constexpr char MASS_CANCEL_BY_SYMBOL = '1';
+    constexpr char MASS_CANCEL_ALL = '7';
+    constexpr char MASS_CANCEL_RESPONSE_REJECTED = '0';
+    
+    // Mass Cancel Reject Reason values
+    constexpr int MASS_CANCEL_REJECT_UNKNOWN_SECURITY = 1;
+    
     // FIX Protocol constants
     constexpr char FIELD_DELIMITER = '\x01';  // SOH character
     constexpr const char* BEGIN_STRING_44 = "FIX.4.4";
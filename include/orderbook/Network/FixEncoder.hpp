@@ -0,0 +1,108 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "FixParser.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace orderbook {
+
+/**
+ * @brief Allocation-free encoder for outbound ExecutionReports (and client orders)
+ *
+ * The session-constant header bytes (SenderCompID and TargetCompID) are
+ * rendered once when the session IDs are set. Fields are written straight
+ * into a caller-owned buffer with hand-rolled integer and fixed-point
+ * formatting. The "YYYYMMDD-HH:MM:SS" part of each timestamp is cached and
+ * re-rendered only when the second changes.
+ *
+ * The body is written after a reserved gap at the front of the buffer. Once
+ * its length is known, BeginString and BodyLength are written backwards into
+ * the gap and the CheckSum is appended, so nothing is moved or rebuilt.
+ *
+ * Output is byte-for-byte what FixMessageParser::generateExecutionReport
+ * produces, plus the latency trace fields when a report carries a trace.
+ * Client sessions use the same machinery for New Order Singles. An encoder
+ * is not thread-safe; use one per session.
+ */
+class FixEncoder {
+public:
+    explicit FixEncoder(TickSize tickSize = TickSize{});
+    FixEncoder(const std::string& senderCompId, const std::string& targetCompId,
+               TickSize tickSize = TickSize{});
+
+    /**
+     * @brief Set the session identifiers and re-render the header template
+     * @param senderCompId Sender component ID (tag 49)
+     * @param targetCompId Target component ID (tag 56)
+     */
+    void setSessionIds(const std::string& senderCompId, const std::string& targetCompId);
+
+    /**
+     * @brief Set the tick size used to format Price (44) and LastPx (31)
+     * @param tickSize Instrument tick size
+     */
+    void setTickSize(TickSize tickSize) { tickSize_ = tickSize; }
+
+    const TickSize& getTickSize() const { return tickSize_; }
+
+    /**
+     * @brief Encode an execution report stamped with the current time
+     * @param execReport Report fields
+     * @param msgSeqNum Outgoing sequence number (tag 34)
+     * @param buffer Reusable output buffer; grown only when a report needs more room
+     * @return Complete message, viewing buffer until it is next encoded into
+     */
+    std::string_view encodeExecutionReport(const FixMessageParser::ExecutionReport& execReport,
+                                           SequenceNumber msgSeqNum, std::string& buffer);
+
+    /**
+     * @brief Encode an execution report with an explicit SendingTime
+     * @param execReport Report fields
+     * @param msgSeqNum Outgoing sequence number (tag 34)
+     * @param sendingTime SendingTime (tag 52)
+     * @param buffer Reusable output buffer; grown only when a report needs more room
+     * @return Complete message, viewing buffer until it is next encoded into
+     */
+    std::string_view encodeExecutionReport(const FixMessageParser::ExecutionReport& execReport,
+                                           SequenceNumber msgSeqNum,
+                                           std::chrono::system_clock::time_point sendingTime,
+                                           std::string& buffer);
+
+    /**
+     * @brief Encode a New Order Single (client side, e.g. load generation)
+     * @param order Order fields; Account (1) is omitted when empty, Price (44) for market orders
+     * @param msgSeqNum Outgoing sequence number (tag 34)
+     * @param sendingTime SendingTime (tag 52)
+     * @param buffer Reusable output buffer; grown only when an order needs more room
+     * @return Complete message, viewing buffer until it is next encoded into
+     */
+    std::string_view encodeNewOrderSingle(const FixMessageParser::NewOrderSingle& order,
+                                          SequenceNumber msgSeqNum,
+                                          std::chrono::system_clock::time_point sendingTime,
+                                          std::string& buffer);
+
+private:
+    // Room kept in front of the body for "8=FIX.4.4|9=<length>|"
+    static constexpr size_t PrefixReserve = 32;
+
+    TickSize tickSize_;
+    std::string compIds_;           // "49=<sender>|56=<target>|"
+
+    // Timestamp prefix cache
+    int64_t cachedSecond_ = INT64_MIN;
+    char cachedPrefix_[17] = {};    // "YYYYMMDD-HH:MM:SS"
+
+    char* writeTimestamp(char* out, std::chrono::system_clock::time_point timestamp);
+    char* writeHeader(char* out, char msgType, SequenceNumber msgSeqNum,
+                      std::chrono::system_clock::time_point sendingTime);
+
+    /**
+     * @brief Write BeginString and BodyLength in front of the body and append the CheckSum
+     * @return The whole message
+     */
+    std::string_view finishMessage(char* bodyStart, char* out);
+};
+
+}
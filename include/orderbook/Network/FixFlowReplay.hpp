@@ -0,0 +1,62 @@
+#pragma once
+#include "../Persistence/OrderFlowReplay.hpp"
+#include "FixMessageView.hpp"
+#include "FixOrderGateway.hpp"
+#include "FixParser.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Applies replayed events through the FIX order-entry path
+ *
+ * Every event is encoded up front as a FIX 4.4 NewOrderSingle,
+ * OrderCancelReplaceRequest or OrderCancelRequest. Applying one then does what a
+ * session does with an inbound message: parse it into a FixMessageView,
+ * decode the order request and hand it to a FixOrderGateway. Sockets and
+ * session framing are not involved, and the gateway's client has no
+ * session, so execution reports are not built or sent.
+ *
+ * Recorded order IDs become ClOrdIDs; a replace gets a new ClOrdID and
+ * later requests for the order refer to it.
+ */
+class FixFlowTarget : public OrderFlowTarget {
+public:
+    /**
+     * @param router Books to trade against (must outlive the target)
+     * @param logger Logger for gateway diagnostics
+     */
+    explicit FixFlowTarget(OrderBookRouter& router, LoggerPtr logger = nullptr);
+
+    void prepare(const std::vector<OrderFlowEvent>& events) override;
+    bool apply(const OrderFlowEvent& event, size_t index) override;
+
+    const FixOrderGateway& getGateway() const { return gateway_; }
+
+    /**
+     * @brief Read order-entry messages from a FIX log
+     *
+     * Each line holding "8=FIX" is taken as one message, with '|' accepted
+     * in place of SOH. NewOrderSingle, OrderCancelReplaceRequest and
+     * OrderCancelRequest messages become events; everything else is
+     * skipped. ClOrdIDs are numbered in order of appearance, and a message
+     * naming an OrigClOrdID acts on the order it refers to. Timestamps come
+     * from TransactTime (60), or SendingTime (52) without one.
+     * @param path Log file
+     * @return Events in file order, or an error if the file cannot be read
+     */
+    static Result<std::vector<OrderFlowEvent>> loadFixLog(const std::string& path);
+
+private:
+    OrderBookRouter& router_;
+    FixOrderGateway gateway_;
+    std::shared_ptr<FixOrderGateway::Client> client_;
+    FixMessageParser parser_;
+    FixMessageView view_;
+    std::vector<FixOrderRequest> batch_;    // One request, reused
+    std::vector<std::string> messages_;     // Encoded events, by index
+};
+
+}
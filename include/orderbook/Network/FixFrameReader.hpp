@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Splits a byte stream into whole FIX messages using BodyLength
+ *
+ * Socket reads land directly in the reader's buffer through writePtr() and
+ * commit(). drain() then walks the buffered bytes, reads tag 9 at the start
+ * of each message to find where it ends, and hands every complete message to
+ * the consumer as a view into the buffer. A partial message at the end stays
+ * buffered until the rest arrives.
+ *
+ * The buffer behaves as a ring that is compacted instead of wrapped: when the
+ * free tail gets short, the unread bytes (at most one partial message) are
+ * moved to the front, so every message the consumer sees is contiguous.
+ *
+ * Bytes that do not start a well-formed frame (missing "8=", malformed or
+ * oversized BodyLength, or no "10=" where the trailer should be) are skipped
+ * up to the next "8=" and counted in getDiscardedBytes().
+ */
+class FixFrameReader {
+public:
+    static constexpr size_t DefaultBufferSize = 64 * 1024;
+    static constexpr size_t DefaultMaxMessageSize = 16 * 1024;
+
+    /**
+     * @param bufferSize Buffer capacity; raised to hold two maximum-size messages if smaller
+     * @param maxMessageSize Largest accepted message, header and trailer included
+     */
+    explicit FixFrameReader(size_t bufferSize = DefaultBufferSize,
+                            size_t maxMessageSize = DefaultMaxMessageSize);
+
+    /**
+     * @brief Start of the free space for the next socket read
+     *
+     * Compacts the buffer first when less than a maximum-size message fits.
+     */
+    char* writePtr();
+
+    /**
+     * @brief Bytes available at writePtr()
+     */
+    size_t writable() const { return buffer_.size() - writePos_; }
+
+    /**
+     * @brief Mark bytes written at writePtr() as received
+     * @param bytes Number of bytes the read produced
+     */
+    void commit(size_t bytes) { writePos_ += bytes; }
+
+    /**
+     * @brief Deliver every complete buffered message
+     * @param consumer Called as bool(std::string_view message); return false to stop early
+     * @return Number of messages delivered
+     *
+     * Views are valid until the next call to writePtr().
+     */
+    template<typename Consumer>
+    size_t drain(Consumer&& consumer) {
+        size_t delivered = 0;
+        std::string_view message;
+        while (nextFrame(message)) {
+            ++delivered;
+            if (!consumer(message)) {
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    size_t buffered() const { return writePos_ - readPos_; }
+    uint64_t getDiscardedBytes() const { return discardedBytes_; }
+    size_t getMaxMessageSize() const { return maxMessageSize_; }
+
+    /**
+     * @brief Drop all buffered bytes (e.g. when the connection is reset)
+     */
+    void reset() { readPos_ = writePos_ = 0; }
+
+private:
+    std::vector<char> buffer_;
+    size_t readPos_ = 0;
+    size_t writePos_ = 0;
+    size_t maxMessageSize_;
+    uint64_t discardedBytes_ = 0;
+
+    bool nextFrame(std::string_view& message);
+    void resync();
+};
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include "../Utilities/LatencyHistogram.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Tick-to-trade load generator for a FIX order-entry server
+ *
+ * Opens many client FixSessions, logs them in, then sends limit New Order
+ * Singles from all of them at a fixed aggregate rate, alternating sides
+ * with prices spread around a mid so that a share of orders trade on
+ * arrival. Each order is timed from just before it is encoded to the read
+ * that delivers its acknowledgement (round trip) and, if it traded on
+ * arrival, its first fill (tick to trade).
+ *
+ * Sends follow a fixed schedule per session. Latency is also measured from
+ * when an order was due, so a generator or server that falls behind shows
+ * up in the tail instead of quietly lowering the offered rate.
+ *
+ * When the server traces latency ([network] latency_trace), every
+ * acknowledgement carries the server's stage stamps, and the round trip is
+ * split into stages that add up to it:
+ *
+ * - inbound:  client encode and write, the network and the server's read
+ * - parse:    server parse, up to the end of the read's parse pass
+ * - queue:    batch dispatch and waiting for the shard lock
+ * - risk:     journal write and pre-trade risk check
+ * - match:    matching and the book update
+ * - encode:   building and encoding the acknowledgement
+ * - outbound: write queueing and syscall, the network and the client's read
+ *
+ * Inbound and outbound compare the server's TSC with the generator's, so
+ * they are only meaningful on one host; the server-side stages are
+ * meaningful anywhere.
+ *
+ * Each generator thread records into its own histograms, merged at the end.
+ */
+class FixLoadGenerator {
+public:
+    enum Stage : uint8_t { Inbound, Parse, Queue, Risk, Match, Encode, Outbound, StageCount };
+
+    /**
+     * @brief Load settings
+     */
+    struct LoadConfig {
+        std::string host = "127.0.0.1";
+        uint16_t port = 5000;
+        std::string target_comp_id = "ORDERBOOK_SERVER";
+        size_t sessions = 100;
+        double rate = 10000.0;              // New orders per second across all sessions
+        double duration_seconds = 10.0;     // Measured sending time
+        double warmup_seconds = 1.0;        // Sending before measurement starts
+        std::string symbol = "BTC/USD";
+        Price price = 100.0;                // Mid the order prices are spread around
+        int64_t price_range_ticks = 5;      // Prices are uniform within mid +/- this many ticks
+        Quantity quantity = 10;
+        TickSize tick_size = TickSize{};
+        size_t io_threads = 1;              // Generator threads the sessions are spread over
+    };
+
+    /**
+     * @brief Measurements for a whole run (nanoseconds)
+     */
+    struct Report {
+        LatencyHistogram ack;                   // Send to acknowledgement
+        LatencyHistogram response;              // Scheduled send to acknowledgement
+        LatencyHistogram fill;                  // Send to first fill, orders that traded on arrival
+        LatencyHistogram stages[StageCount];    // Acknowledgement round trip split by server stamps
+        uint64_t sent = 0;                      // Measured orders sent
+        uint64_t acknowledged = 0;
+        uint64_t rejected = 0;
+        uint64_t traded = 0;                    // Orders that traded on arrival
+        uint64_t traced = 0;                    // Acknowledgements carrying server stamps
+        uint64_t unmatched = 0;                 // Responses for orders no longer tracked
+        size_t sessions = 0;                    // Sessions that logged in
+        double seconds = 0.0;                   // Measured sending time
+        int64_t max_lag_ns = 0;                 // Furthest behind schedule an order was sent
+
+        double throughput() const { return seconds > 0.0 ? acknowledged / seconds : 0.0; }
+
+        /**
+         * @brief Add another thread's measurements to this one
+         */
+        void merge(const Report& other);
+    };
+
+    explicit FixLoadGenerator(LoggerPtr logger = nullptr);
+    FixLoadGenerator(LoggerPtr logger, const LoadConfig& config);
+
+    /**
+     * @brief Connect, send for warmup plus duration, wait for responses, disconnect
+     * @return Measurements (held on the heap; the histograms are large), or an
+     *         error if no session could log in
+     */
+    Result<std::unique_ptr<Report>> run() const;
+
+    const LoadConfig& getConfig() const { return config_; }
+
+    static const char* stageName(Stage stage);
+
+    /**
+     * @brief Read load settings from the [load_generator] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static LoadConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    LoggerPtr logger_;
+    LoadConfig config_;
+};
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "FixConstants.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+namespace orderbook {
+
+/**
+ * @brief Zero-copy view of a FIX message
+ *
+ * parse() scans the SOH-delimited buffer once with the vectorized kernels in
+ * FixSimd.hpp and records each field as an (offset, length) pair into the
+ * caller's buffer. Tags below MaxDirectTag, which covers every standard tag
+ * the engine reads, are stored in a flat array indexed by tag number; higher
+ * tags go to a small overflow list. A view can be reused across messages
+ * without clearing, and parsing a well-formed message performs no heap
+ * allocation.
+ *
+ * The view does not own the buffer; it must stay alive while the view is used.
+ * When a tag repeats, the last occurrence wins.
+ */
+class FixMessageView {
+public:
+    static constexpr int MaxDirectTag = 256;
+    static constexpr size_t MaxOverflowFields = 32;
+
+    FixMessageView() = default;
+
+    /**
+     * @brief Parse a raw FIX message
+     * @param raw Complete message including BeginString and CheckSum
+     * @param validateChecksum Also verify tag 10 against the bytes before it
+     * @return true if the message is well formed
+     */
+    bool parse(std::string_view raw, bool validateChecksum = false);
+
+    /**
+     * @brief Get a field value
+     * @param tag FIX tag number
+     * @return View into the buffer, or an empty view if the tag is absent
+     */
+    std::string_view get(int tag) const {
+        const FieldRef* ref = find(tag);
+        return ref ? raw_.substr(ref->offset, ref->length) : std::string_view{};
+    }
+
+    bool has(int tag) const { return find(tag) != nullptr; }
+
+    /**
+     * @brief Get the first character of a field
+     * @param tag FIX tag number
+     * @param defaultValue Value returned when the tag is absent or empty
+     * @return Field character
+     */
+    char getChar(int tag, char defaultValue = '\0') const {
+        std::string_view value = get(tag);
+        return value.empty() ? defaultValue : value.front();
+    }
+
+    /**
+     * @brief Parse an unsigned integer field straight from the buffer
+     * @param tag FIX tag number
+     * @return Value, or nullopt if absent, non-numeric or out of range
+     */
+    std::optional<uint64_t> getUInt(int tag) const;
+
+    /**
+     * @brief Parse a signed integer field straight from the buffer
+     * @param tag FIX tag number
+     * @return Value, or nullopt if absent, non-numeric or out of range
+     */
+    std::optional<int64_t> getInt(int tag) const;
+
+    /**
+     * @brief Parse a price field straight from the buffer into ticks
+     * @param tag FIX tag number
+     * @param tickSize Instrument tick size
+     * @return Price in ticks, or nullopt if absent, malformed or off the tick grid
+     */
+    std::optional<PriceTicks> getPriceTicks(int tag, const TickSize& tickSize) const {
+        std::string_view value = get(tag);
+        return value.empty() ? std::nullopt : tickSize.parse(value);
+    }
+
+    /**
+     * @brief Copy a field into a string (for fields that must outlive the buffer)
+     * @param tag FIX tag number
+     * @return Field value or empty string
+     */
+    std::string getString(int tag) const { return std::string(get(tag)); }
+
+    char msgType() const { return msgType_; }
+    bool isValid() const { return isValid_; }
+    const std::string& errorMessage() const { return errorMessage_; }
+    std::string_view raw() const { return raw_; }
+    size_t fieldCount() const { return fieldCount_; }
+
+private:
+    struct FieldRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        uint32_t generation = 0;    // Field is present only if this matches generation_
+    };
+
+    struct OverflowField {
+        int tag = 0;
+        FieldRef ref;
+    };
+
+    std::string_view raw_;
+    std::array<FieldRef, MaxDirectTag> direct_{};
+    std::array<OverflowField, MaxOverflowFields> overflow_{};
+    size_t overflowCount_ = 0;
+    size_t fieldCount_ = 0;
+    uint32_t generation_ = 0;
+    char msgType_ = '\0';
+    bool isValid_ = false;
+    std::string errorMessage_;
+
+    const FieldRef* find(int tag) const {
+        if (tag >= 0 && tag < MaxDirectTag) {
+            const FieldRef& ref = direct_[tag];
+            return ref.generation == generation_ ? &ref : nullptr;
+        }
+        for (size_t i = 0; i < overflowCount_; ++i) {
+            if (overflow_[i].tag == tag) {
+                return &overflow_[i].ref;
+            }
+        }
+        return nullptr;
+    }
+
+    bool fail(std::string message) {
+        errorMessage_ = std::move(message);
+        isValid_ = false;
+        return false;
+    }
+};
+
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/OrderBookRouter.hpp"
+#include "../Core/MatchingRuntime.hpp"
+#include "../Core/MatchingEngine.hpp"
+#include "../Core/Interfaces.hpp"
+#include "FixParser.hpp"
+#include "FixSession.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Shared entry point from FIX sessions into the order books
+ *
+ * Sessions hand over the order requests parsed from one socket read, and
+ * the gateway applies them to the router's books in a single pass. Each
+ * router shard has a mutex, held across consecutive requests for the same
+ * shard. Trades come back in a reused MatchResult and are turned straight
+ * into execution reports for both sides, including resting orders that
+ * belong to other sessions.
+ *
+ * Given a MatchingRuntime, the gateway instead submits each request to the
+ * command ring of the shard that owns the book and takes no shard lock on
+ * session threads. Results come back through the runtime's result handler,
+ * and every report for a shard's orders is sent from that shard's thread.
+ * ClOrdIDs are claimed at submission, so a duplicate is refused even before
+ * the first order reaches its book.
+ *
+ * The gateway is the only record of FIX orders: it keeps the fill state
+ * needed for reports, and the books keep the orders themselves.
+ *
+ * New orders that arrive with a LatencyTrace are stamped at dispatch and
+ * after matching, and the trace rides on that order's acknowledgement and
+ * fills (not on the resting side's reports).
+ */
+class FixOrderGateway {
+public:
+    /**
+     * @brief Order-entry state of one session
+     *
+     * Created with createClient() and owned by the session's handler.
+     * ClOrdIDs are scoped to the client.
+     */
+    class Client {
+    public:
+        explicit Client(std::weak_ptr<FixSession> session) : session_(std::move(session)) {}
+
+    private:
+        friend class FixOrderGateway;
+
+        struct OrderRef {
+            OrderId id;
+            SymbolId symbol;
+            Side side;
+        };
+
+        std::weak_ptr<FixSession> session_;
+        std::mutex mutex_;      // Orders can be filled from other sessions' threads
+        FlatHashMap<std::string, OrderRef> orders_;    // Working orders by ClOrdID
+    };
+
+    /**
+     * @param router Books to trade against (must outlive the gateway)
+     * @param logger Logger for rejects and diagnostics
+     */
+    explicit FixOrderGateway(OrderBookRouter& router, LoggerPtr logger = nullptr);
+
+    /**
+     * @brief Gateway that matches through a runtime's shard threads
+     *
+     * Installs the runtime's result handler, so it is created before
+     * runtime.start(), and the runtime is stopped before the gateway goes.
+     * @param router Books the runtime owns (must outlive the gateway)
+     * @param runtime Runtime the requests are submitted to
+     * @param logger Logger for rejects and diagnostics
+     */
+    FixOrderGateway(OrderBookRouter& router, MatchingRuntime& runtime, LoggerPtr logger = nullptr);
+
+    /**
+     * @brief Create the order-entry state for a session
+     * @param session Session that receives this client's execution reports
+     */
+    std::shared_ptr<Client> createClient(std::weak_ptr<FixSession> session);
+
+    /**
+     * @brief Apply a session's requests in arrival order
+     * @param client Client the requests came from
+     * @param requests Requests parsed from one read
+     */
+    void processBatch(const std::shared_ptr<Client>& client, const std::vector<FixOrderRequest>& requests);
+
+    // Single-request entry points
+    void submitNewOrder(const std::shared_ptr<Client>& client, const FixMessageParser::NewOrderSingle& newOrder);
+    void submitCancelReplace(const std::shared_ptr<Client>& client,
+                             const FixMessageParser::OrderCancelReplaceRequest& cancelReplace);
+    void submitCancel(const std::shared_ptr<Client>& client, const FixMessageParser::OrderCancelRequest& cancel);
+    
+    /**
+     * @brief Cancel every working order of a client (e.g. when its session drops)
+     *
+     * Each book the client has orders in is swept once with
+     * OrderBook::cancelOrders. Cancel reports go out only while the
+     * session is still logged in.
+     * @param client Client whose orders are cancelled
+     * @return Number of orders cancelled (with a runtime: submitted for cancel)
+     */
+    size_t cancelClientOrders(const std::shared_ptr<Client>& client);
+
+    /**
+     * @brief Visit every book while its shard is locked against matching
+     *
+     * With a runtime, each book is visited on its shard thread between two
+     * batches; the visitor is still called for one book at a time.
+     * @param visitor Callable taking (SymbolId, const OrderBook&)
+     */
+    template<typename Visitor>
+    void forEachBook(Visitor&& visitor) const {
+        if (runtime_) {
+            std::mutex visitMutex;
+            runtime_->visitBooks([&visitor, &visitMutex](SymbolId symbol, OrderBook& book) {
+                std::lock_guard<std::mutex> lock(visitMutex);
+                visitor(symbol, static_cast<const OrderBook&>(book));
+            });
+            return;
+        }
+        for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+            std::lock_guard<std::mutex> lock(shards_[shard]->mutex);
+            for (SymbolId symbol : router_.getShardSymbols(shard)) {
+                visitor(symbol, static_cast<const OrderBook&>(*router_.getBook(symbol)));
+            }
+        }
+    }
+
+    size_t getWorkingOrderCount() const;
+    uint64_t getOrdersAccepted() const { return ordersAccepted_.load(std::memory_order_relaxed); }
+    uint64_t getOrdersRejected() const { return ordersRejected_.load(std::memory_order_relaxed); }
+    uint64_t getFillsReported() const { return fillsReported_.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief A FIX order resting in (or being matched by) a book
+     */
+    struct LiveOrder {
+        std::weak_ptr<Client> client;
+        std::string clOrdId;
+        SymbolId symbol = 0;
+        Side side = Side::Buy;
+        Quantity orderQty = 0;
+        Price price = 0.0;
+        Quantity cumQty = 0;
+        double notional = 0.0;      // Sum of fill price * quantity, for AvgPx
+    };
+
+    /**
+     * @brief Completion of one mass cancel whose cancels run through the runtime
+     */
+    struct MassCancel {
+        std::weak_ptr<Client> client;
+        FixMessageParser::OrderMassCancelReport report;
+        std::atomic<size_t> pending{0};
+        std::atomic<size_t> cancelled{0};
+    };
+
+    /**
+     * @brief A request in flight through the runtime
+     *
+     * Allocated on the session thread, carried in BookCommand::tag and
+     * released by the result handler on the shard thread.
+     */
+    struct PendingRequest {
+        FixOrderRequest::Type type = FixOrderRequest::Type::New;
+        std::weak_ptr<Client> client;
+        std::string clOrdId;
+        std::string origClOrdId;
+        std::string symbol;
+        Side side = Side::Buy;
+        Quantity orderQty = 0;
+        Price price = 0.0;
+        LatencyTrace trace;
+        bool traced = false;
+        std::shared_ptr<MassCancel> massCancel;     // Set for the cancels of one mass cancel
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;       // With a runtime, only the shard thread and statistics take it
+        FlatHashMap<OrderId, LiveOrder, OrderIdHash> orders;
+        MatchResult match;                              // Reused for every add
+        FixMessageParser::ExecutionReport report;       // Reused for every report
+    };
+
+    /**
+     * @brief Holds at most one shard lock while a batch runs
+     */
+    class ShardLock {
+    public:
+        explicit ShardLock(FixOrderGateway& gateway) : gateway_(gateway) {}
+        Shard& acquire(uint32_t shard);
+
+    private:
+        FixOrderGateway& gateway_;
+        std::unique_lock<std::mutex> lock_;
+        uint32_t held_ = OrderBookRouter::AutoShard;
+    };
+
+    OrderBookRouter& router_;
+    MatchingRuntime* runtime_ = nullptr;
+    LoggerPtr logger_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> nextOrderId_{1};
+    std::atomic<uint64_t> nextExecId_{1};
+    std::atomic<uint64_t> ordersAccepted_{0};
+    std::atomic<uint64_t> ordersRejected_{0};
+    std::atomic<uint64_t> fillsReported_{0};
+
+    void handleNewOrder(ShardLock& lock, const std::shared_ptr<Client>& client,
+                        const FixMessageParser::NewOrderSingle& newOrder,
+                        const LatencyTrace* inboundTrace = nullptr);
+    void handleCancelReplace(ShardLock& lock, const std::shared_ptr<Client>& client,
+                             const FixMessageParser::OrderCancelReplaceRequest& cancelReplace);
+    void handleCancel(ShardLock& lock, const std::shared_ptr<Client>& client,
+                      const FixMessageParser::OrderCancelRequest& cancel);
+    void handleMassCancel(ShardLock& lock, const std::shared_ptr<Client>& client,
+                          const FixMessageParser::OrderMassCancelRequest& massCancel);
+    
+    /**
+     * @brief Cancel a client's working orders, one book sweep per symbol
+     * @param symbol Only orders in this book (nullopt = every book)
+     * @param side Only orders on this side (nullopt = both)
+     * @return Number of orders cancelled
+     */
+    size_t cancelClientOrders(ShardLock& lock, const std::shared_ptr<Client>& client,
+                              std::optional<SymbolId> symbol, std::optional<Side> side);
+
+    /**
+     * @brief Report both sides of every trade and retire filled orders
+     * @param trades Trades one incoming order generated
+     * @param aggressor Incoming order whose fills carry trace
+     * @param trace Latency trace of the incoming order (nullptr = untraced)
+     */
+    void reportTrades(Shard& shard, const MatchResult::TradeList& trades, OrderId aggressor,
+                      const LatencyTrace* trace);
+
+    // Runtime mode: submission on session threads, completion on shard threads
+    void submitRequest(const BookCommand& command, std::unique_ptr<PendingRequest> request);
+    size_t submitClientCancels(const std::shared_ptr<Client>& client, std::optional<SymbolId> symbol,
+                               std::optional<Side> side, const std::shared_ptr<MassCancel>& massCancel);
+    void onResult(BookCommandResult& result);
+    void completeNewOrder(Shard& shard, PendingRequest& request, const BookCommandResult& result);
+    void completeCancelReplace(Shard& shard, PendingRequest& request, const BookCommandResult& result);
+    void completeCancel(Shard& shard, PendingRequest& request, const BookCommandResult& result);
+    void completeMassCancel(MassCancel& massCancel);
+
+    /**
+     * @brief Send an execution report for a live order to its owning session
+     * @param trace Latency trace to echo in the report (nullptr = none)
+     */
+    void sendReport(Shard& shard, OrderId id, const LiveOrder& order, char execType, char ordStatus,
+                    Quantity lastQty = 0, Price lastPx = 0.0, const LatencyTrace* trace = nullptr);
+
+    /**
+     * @brief Send a rejection execution report to a client
+     */
+    void sendReject(const std::shared_ptr<Client>& client, const std::string& clOrdId,
+                    const std::string& symbol, Side side, const std::string& reason);
+
+    /**
+     * @brief Find a client's working order by ClOrdID
+     */
+    std::optional<Client::OrderRef> findClientOrder(const std::shared_ptr<Client>& client,
+                                                    const std::string& clOrdId);
+    void forgetClientOrder(const std::shared_ptr<Client>& client, const std::string& clOrdId);
+};
+
+}
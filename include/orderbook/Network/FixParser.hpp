@@ -1,7 +1,9 @@
 #pragma once
+#include "../Core/LatencyTrace.hpp"
 #include "../Core/Order.hpp"
 #include "../Core/Types.hpp"
 #include "FixConstants.hpp"
+#include "FixMessageView.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -49,6 +51,7 @@ public:
         OrderType orderType;
         TimeInForce timeInForce;
         Price price;
+        PriceTicks priceTicks = 0;
         Quantity quantity;
         std::string account;
         std::chrono::system_clock::time_point transactTime;
@@ -67,8 +70,9 @@ public:
         Side side;
         OrderType orderType;
         TimeInForce timeInForce;
-        Price price;
-        Quantity quantity;
+        Price price = 0.0;
+        PriceTicks priceTicks = 0;
+        Quantity quantity = 0;
         std::string account;
         std::chrono::system_clock::time_point transactTime;
         
@@ -90,6 +94,36 @@ public:
         std::string errorMessage;
     };
     
+    /**
+     * @brief Order Mass Cancel Request message data
+     */
+    struct OrderMassCancelRequest {
+        std::string clOrdId;
+        char massCancelRequestType = fix::MASS_CANCEL_ALL;  // By symbol or all of the session's orders
+        std::string symbol;             // Required when cancelling by symbol
+        std::optional<Side> side;       // Only this side when set
+        std::chrono::system_clock::time_point transactTime;
+        
+        bool isValid = false;
+        std::string errorMessage;
+    };
+    
+    /**
+     * @brief Order Mass Cancel Report message data
+     */
+    struct OrderMassCancelReport {
+        std::string clOrdId;
+        std::string orderId;
+        char massCancelRequestType = fix::MASS_CANCEL_ALL;
+        char massCancelResponse = fix::MASS_CANCEL_RESPONSE_REJECTED;  // Request type when accepted
+        int rejectReason = 0;           // Only sent when rejected
+        size_t totalAffectedOrders = 0;
+        std::string symbol;
+        std::optional<Side> side;
+        std::string text;
+        std::chrono::system_clock::time_point transactTime;
+    };
+    
     /**
      * @brief Execution Report message data
      */
@@ -109,12 +143,25 @@ public:
         Quantity cumQty;
         Price avgPx;
         std::chrono::system_clock::time_point transactTime;
+        const LatencyTrace* trace = nullptr;    // Echoed in tags 5001-5006 when set (FixEncoder only)
         
         ExecutionReport() = default;
     };
 
 public:
-    FixMessageParser() = default;
+    explicit FixMessageParser(TickSize tickSize = TickSize{}) : tickSize_(tickSize) {}
+    
+    /**
+     * @brief Set the instrument tick size used for price conversion
+     * @param tickSize Tick size for the traded instrument
+     */
+    void setTickSize(TickSize tickSize) { tickSize_ = tickSize; }
+    
+    /**
+     * @brief Get the tick size used for price conversion
+     * @return Current tick size
+     */
+    const TickSize& getTickSize() const { return tickSize_; }
     
     /**
      * @brief Parse a raw FIX message
@@ -123,12 +170,30 @@ public:
      */
     FixMessage parseMessage(const std::string& rawMessage);
     
+    /**
+     * @brief Parse a raw FIX message into a reusable zero-copy view
+     * @param rawMessage Raw FIX message (must outlive the view)
+     * @param view View to fill
+     * @return true if the message is well formed
+     */
+    bool parseMessage(std::string_view rawMessage, FixMessageView& view) const {
+        return view.parse(rawMessage, validateChecksum_);
+    }
+    
+    /**
+     * @brief Enable verification of inbound CheckSum (tag 10) values
+     * @param enabled true to reject messages whose checksum does not match
+     */
+    void setValidateChecksum(bool enabled) { validateChecksum_ = enabled; }
+    bool getValidateChecksum() const { return validateChecksum_; }
+    
     /**
      * @brief Parse New Order Single message
      * @param fixMsg Parsed FIX message
      * @return NewOrderSingle data structure
      */
     NewOrderSingle parseNewOrderSingle(const FixMessage& fixMsg);
+    NewOrderSingle parseNewOrderSingle(const FixMessageView& fixMsg);
     
     /**
      * @brief Parse Order Cancel Replace Request message
@@ -136,6 +201,7 @@ public:
      * @return OrderCancelReplaceRequest data structure
      */
     OrderCancelReplaceRequest parseOrderCancelReplaceRequest(const FixMessage& fixMsg);
+    OrderCancelReplaceRequest parseOrderCancelReplaceRequest(const FixMessageView& fixMsg);
     
     /**
      * @brief Parse Order Cancel Request message
@@ -143,6 +209,15 @@ public:
      * @return OrderCancelRequest data structure
      */
     OrderCancelRequest parseOrderCancelRequest(const FixMessage& fixMsg);
+    OrderCancelRequest parseOrderCancelRequest(const FixMessageView& fixMsg);
+    
+    /**
+     * @brief Parse Order Mass Cancel Request message
+     * @param fixMsg Parsed FIX message
+     * @return OrderMassCancelRequest data structure; only cancels by symbol
+     *         and of all orders are accepted
+     */
+    OrderMassCancelRequest parseOrderMassCancelRequest(const FixMessageView& fixMsg);
     
     /**
      * @brief Generate Execution Report message
@@ -157,6 +232,19 @@ public:
                                       const std::string& targetCompId,
                                       SequenceNumber msgSeqNum);
     
+    /**
+     * @brief Generate Order Mass Cancel Report message
+     * @param report Mass cancel outcome
+     * @param senderCompId Sender component ID
+     * @param targetCompId Target component ID
+     * @param msgSeqNum Message sequence number
+     * @return FIX message string
+     */
+    std::string generateOrderMassCancelReport(const OrderMassCancelReport& report,
+                                              const std::string& senderCompId,
+                                              const std::string& targetCompId,
+                                              SequenceNumber msgSeqNum);
+    
     /**
      * @brief Generate Heartbeat message
      * @param senderCompId Sender component ID
@@ -212,6 +300,9 @@ public:
                              const std::string& text);
 
 private:
+    TickSize tickSize_;
+    bool validateChecksum_ = false;
+    
     /**
      * @brief Calculate FIX message checksum
      * @param message Message without checksum field
@@ -1,31 +1,46 @@
 #pragma once
-#include "../Core/OrderManager.hpp"
-#include "../Risk/RiskManager.hpp"
 #include "FixSession.hpp"
 #include "FixMessageHandler.hpp"
+#include "FixOrderGateway.hpp"
+#include "IoContextPool.hpp"
 #include <boost/asio.hpp>
 #include <memory>
 #include <vector>
 #include <string>
 #include <atomic>
+#include <mutex>
 
 namespace orderbook {
 
+class Config;
+class MetricsWriter;
+
 /**
  * @brief FIX Protocol Server
- * Manages multiple FIX sessions and handles incoming connections
+ * Manages multiple FIX sessions and handles incoming connections.
+ * The receive mode follows the IO pool the server is given: on a pool in
+ * BusyPoll mode, sessions are read by that pool's spinning threads instead
+ * of through async reads.
  */
 class FixServer {
 public:
     /**
      * @brief Constructor
      * @param io_context IO context for async operations
-     * @param orderManager Order management system
-     * @param riskManager Risk management system
+     * @param gateway Gateway into the order books shared by all sessions
      */
     FixServer(boost::asio::io_context& io_context,
-             std::shared_ptr<OrderManager> orderManager,
-             std::shared_ptr<RiskManager> riskManager);
+             std::shared_ptr<FixOrderGateway> gateway);
+    
+    /**
+     * @brief Constructor spreading sessions over an IO context pool
+     * @param io_context IO context that runs the acceptor
+     * @param ioPool Pool whose contexts run the sessions (must outlive the server)
+     * @param gateway Gateway into the order books shared by all sessions
+     */
+    FixServer(boost::asio::io_context& io_context,
+             IoContextPool& ioPool,
+             std::shared_ptr<FixOrderGateway> gateway);
     
     /**
      * @brief Start the server on specified port
@@ -39,18 +54,62 @@ public:
      */
     void stop();
     
+    /**
+     * @brief Port the server is listening on (useful after start(0, ...))
+     */
+    uint16_t getPort() const;
+    
+    /**
+     * @brief Apply session settings from configuration to every accepted session
+     * @param config Configuration object ([network] section)
+     */
+    void loadConfiguration(std::shared_ptr<Config> config);
+    
+    /**
+     * @brief Trace each order's server-side latency stages into its execution reports
+     *
+     * Overrides [network] latency_trace for sessions accepted afterwards.
+     */
+    void setLatencyTrace(bool enabled) { latencyTrace_ = enabled; }
+    
+    /**
+     * @brief Cancel a session's working orders when it disconnects
+     *
+     * Overrides [network] cancel_on_disconnect.
+     */
+    void setCancelOnDisconnect(bool enabled) { cancelOnDisconnect_ = enabled; }
+    
+    /**
+     * @brief Receive function for sessions on a busy-polling IO pool
+     *
+     * Lets a kernel-bypass stack serve this listener's reads; applies to
+     * sessions accepted afterwards. Without it polled sessions read their
+     * sockets directly. Ignored unless the pool runs in BusyPoll mode.
+     */
+    void setReceiveHook(FixSession::ReceiveHook hook) { receiveHook_ = hook; }
+    
     /**
      * @brief Get server statistics
      */
     struct ServerStats {
         size_t activeConnections;
         size_t totalConnections;
-        size_t messagesProcessed;
+        size_t messagesProcessed;   // Inbound messages over every session, past and present
+        size_t messagesSent;
         size_t ordersProcessed;
         std::chrono::system_clock::time_point startTime;
     };
     
     ServerStats getStats() const;
+    
+    /**
+     * @brief Add connection and message counters to a scrape
+     *
+     * Reads the session list under the server's session mutex, so it only
+     * contends with accepts and disconnects, never with matching.
+     * @param out Scrape being built
+     */
+    void exportMetrics(MetricsWriter& out) const;
 
 private:
     /**
@@ -65,13 +124,21 @@ private:
      */
     void handleAccept(std::shared_ptr<FixSession> session, const boost::system::error_code& error);
     
+    /**
+     * @brief Wire handlers and start an accepted session
+     * @param session New FIX session
+     * @param context Pool context index the session runs on, or NoPoolContext
+     */
+    void registerSession(std::shared_ptr<FixSession> session, size_t context);
+    
     /**
      * @brief Handle session events
      * @param session Session that generated the event
+     * @param handler Message handler of that session (may be null once released)
      * @param state New session state
      * @param reason Reason for state change
      */
-    void handleSessionEvent(std::shared_ptr<FixSession> session, 
+    void handleSessionEvent(std::shared_ptr<FixSession> session, std::shared_ptr<FixMessageHandler> handler,
                           FixSession::SessionState state, const std::string& reason);
     
     /**
@@ -81,23 +148,31 @@ private:
 
 private:
     // Network components
+    static constexpr size_t NoPoolContext = SIZE_MAX;
+    
     boost::asio::io_context& ioContext_;
+    IoContextPool* ioPool_ = nullptr;   // Sessions run on ioContext_ when null
     boost::asio::ip::tcp::acceptor acceptor_;
     
     // Core components
-    std::shared_ptr<OrderManager> orderManager_;
-    std::shared_ptr<RiskManager> riskManager_;
+    std::shared_ptr<FixOrderGateway> gateway_;
     
     // Session management
     std::vector<std::shared_ptr<FixSession>> sessions_;
     std::vector<std::shared_ptr<FixMessageHandler>> messageHandlers_;
+    mutable std::mutex sessionsMutex_;
     
     // Server configuration
     std::string senderCompId_;
+    std::shared_ptr<Config> config_;    // Applied to each accepted session when set
+    bool latencyTrace_ = false;
+    std::atomic<bool> cancelOnDisconnect_{false};
+    FixSession::ReceiveHook receiveHook_ = nullptr;
     
     // Statistics
     std::atomic<size_t> totalConnections_{0};
-    std::atomic<size_t> messagesProcessed_{0};
+    size_t retiredMessagesReceived_ = 0;    // Counts of cleaned-up sessions; guarded by sessionsMutex_
+    size_t retiredMessagesSent_ = 0;
     std::atomic<size_t> ordersProcessed_{0};
     std::chrono::system_clock::time_point startTime_;
     
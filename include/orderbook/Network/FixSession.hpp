@@ -2,13 +2,16 @@
 #include "../Core/Order.hpp"
 #include "../Core/Types.hpp"
 #include "../Core/Interfaces.hpp"
+#include "../Core/LatencyTrace.hpp"
 #include "FixParser.hpp"
+#include "FixEncoder.hpp"
+#include "FixFrameReader.hpp"
 #include <boost/asio.hpp>
 #include <functional>
 #include <memory>
 #include <string>
 #include <chrono>
-#include <queue>
+#include <vector>
 #include <mutex>
 #include <atomic>
 
@@ -16,6 +19,22 @@ namespace orderbook {
 
 class Config;
 
+/**
+ * @brief One parsed order-entry message, queued for batch dispatch
+ *
+ * Only the member matching type is filled in.
+ */
+struct FixOrderRequest {
+    enum class Type : uint8_t { New, CancelReplace, Cancel, MassCancel };
+
+    Type type = Type::New;
+    FixMessageParser::NewOrderSingle newOrder;
+    FixMessageParser::OrderCancelReplaceRequest cancelReplace;
+    FixMessageParser::OrderCancelRequest cancel;
+    FixMessageParser::OrderMassCancelRequest massCancel;
+    LatencyTrace trace;     // Receipt and parse stamps when the session traces latency
+};
+
 /**
  * @brief FIX 4.4 Session Management
  * Handles async TCP connection, message parsing, sequence numbers, and heartbeats
@@ -41,6 +60,17 @@ public:
     using CancelReplaceHandler = std::function<void(const FixMessageParser::OrderCancelReplaceRequest&)>;
     using CancelHandler = std::function<void(const FixMessageParser::OrderCancelRequest&)>;
     using SessionEventHandler = std::function<void(SessionState, const std::string&)>;
+    using OrderBatchHandler = std::function<void(std::vector<FixOrderRequest>&)>;
+    using ExecutionReportHandler = std::function<void(const FixMessageView&)>;
+    
+    /**
+     * @brief Receive function for polled sessions, e.g. a kernel-bypass stack's recv
+     *
+     * Reads at most length bytes from the connection without blocking.
+     * Returns the bytes read, 0 when nothing is pending, or a negative value
+     * when the connection is closed (errno 0) or failed (errno set).
+     */
+    using ReceiveHook = long (*)(boost::asio::ip::tcp::socket::native_handle_type fd, void* buffer, size_t length);
     
     /**
      * @brief Constructor for server-side session (accepting connection)
@@ -103,6 +133,18 @@ public:
      */
     void sendExecutionReport(const FixMessageParser::ExecutionReport& execReport);
     
+    /**
+     * @brief Send order mass cancel report
+     * @param report Mass cancel outcome
+     */
+    void sendOrderMassCancelReport(const FixMessageParser::OrderMassCancelReport& report);
+    
+    /**
+     * @brief Send a New Order Single (client side)
+     * @param order Order to send; transactTime is sent as given
+     */
+    void sendNewOrderSingle(const FixMessageParser::NewOrderSingle& order);
+    
     /**
      * @brief Send heartbeat message
      * @param testReqId Optional test request ID
@@ -124,6 +166,61 @@ public:
     void setCancelHandler(CancelHandler handler) { cancelHandler_ = std::move(handler); }
     void setSessionEventHandler(SessionEventHandler handler) { sessionEventHandler_ = std::move(handler); }
     
+    /**
+     * @brief Receive order-entry messages in batches instead of one callback each
+     *
+     * When set, New Order Single, Cancel/Replace and Cancel requests parsed
+     * from one socket read are collected and handed over together once the
+     * read has been processed; the per-message handlers are not called.
+     */
+    void setOrderBatchHandler(OrderBatchHandler handler) { orderBatchHandler_ = std::move(handler); }
+    
+    /**
+     * @brief Receive inbound execution reports (client side)
+     *
+     * The handler sees the parsed message, valid only for the call. Without
+     * a handler execution reports are rejected as unsupported.
+     */
+    void setExecutionReportHandler(ExecutionReportHandler handler) { executionReportHandler_ = std::move(handler); }
+    
+    /**
+     * @brief Stamp each read and the orders parsed from it for latency tracing
+     *
+     * Batched New Order Singles then carry a LatencyTrace to the gateway,
+     * which echoes it in the order's execution reports.
+     */
+    void setLatencyTrace(bool enabled) { traceLatency_ = enabled; }
+    bool isLatencyTraced() const { return traceLatency_; }
+    
+    /**
+     * @brief TscClock counter when the read being processed completed (0 unless tracing)
+     *
+     * Valid inside handlers, for timing messages from their arrival.
+     */
+    uint64_t getReadTicks() const { return readTicks_; }
+    
+    /**
+     * @brief Receive by polling instead of completion-based async reads (server side)
+     *
+     * Puts the socket in non-blocking mode and sets SO_BUSY_POLL where the
+     * platform has it. Once started, the session does not read by itself:
+     * the thread running its io_context must call pollReceive() in a loop.
+     * Must be called before start().
+     * @param busyPollMicros SO_BUSY_POLL budget in microseconds (0 = leave unset)
+     * @param hook Receive function to use instead of the socket's own (nullptr = socket read)
+     */
+    void enablePolledReceive(int busyPollMicros, ReceiveHook hook = nullptr);
+    bool isPolledReceive() const { return polledReceive_; }
+    
+    /**
+     * @brief Read whatever is pending without blocking and process every complete message
+     *
+     * Only for polled sessions, and only on the thread that runs the
+     * session's io_context, so it never overlaps the session's handlers.
+     * @return false once the session is closed and should no longer be polled
+     */
+    bool pollReceive();
+    
     /**
      * @brief Set session identifiers
      * @param senderCompId Sender component ID
@@ -171,51 +268,82 @@ public:
     void loadConfiguration(std::shared_ptr<Config> config);
 
 private:
+    /**
+     * @brief Disable Nagle on the connected socket
+     * Otherwise a report written while the previous one is still unacknowledged
+     * waits for the peer's delayed ACK or its next message.
+     */
+    void disableNagle();
+    
     /**
      * @brief Start reading messages
      */
     void startRead();
     
     /**
-     * @brief Read message header to determine length
+     * @brief Read the next chunk from the socket and process every complete message in it
      */
     void readMessage();
     
+    /**
+     * @brief Frame and process bytes a read placed in the frame reader
+     * @param bytes Bytes the read produced
+     */
+    void consumeRead(size_t bytes);
+    
     /**
      * @brief Process received message
-     * @param message Raw message string
+     * @param message One complete FIX message, viewing the frame reader's buffer
+     */
+    void processMessage(std::string_view message);
+    
+    /**
+     * @brief Hand the order requests collected from the current read to the batch handler
      */
-    void processMessage(const std::string& message);
+    void flushOrderBatch();
     
     /**
      * @brief Handle different message types
      */
-    void handleLogon(const FixMessageParser::FixMessage& msg);
-    void handleLogout(const FixMessageParser::FixMessage& msg);
-    void handleHeartbeat(const FixMessageParser::FixMessage& msg);
-    void handleTestRequest(const FixMessageParser::FixMessage& msg);
-    void handleNewOrderSingle(const FixMessageParser::FixMessage& msg);
-    void handleOrderCancelReplaceRequest(const FixMessageParser::FixMessage& msg);
-    void handleOrderCancelRequest(const FixMessageParser::FixMessage& msg);
-    void handleReject(const FixMessageParser::FixMessage& msg);
+    void handleLogon(const FixMessageView& msg);
+    void handleLogout(const FixMessageView& msg);
+    void handleHeartbeat(const FixMessageView& msg);
+    void handleTestRequest(const FixMessageView& msg);
+    void handleNewOrderSingle(const FixMessageView& msg);
+    void handleOrderCancelReplaceRequest(const FixMessageView& msg);
+    void handleOrderCancelRequest(const FixMessageView& msg);
+    void handleOrderMassCancelRequest(const FixMessageView& msg);
+    void handleExecutionReport(const FixMessageView& msg);
+    void handleReject(const FixMessageView& msg);
     
     /**
      * @brief Send message with proper sequencing
      * @param message FIX message to send
      */
-    void sendMessage(const std::string& message);
+    void sendMessage(std::string_view message);
     
     /**
-     * @brief Write message to socket
+     * @brief Append message to the pending write batch
      * @param message Message to write
+     *
+     * Starts a write immediately unless one is in flight or the cork window
+     * is open, in which case the message goes out with the next batch.
      */
-    void writeMessage(const std::string& message);
+    void writeMessage(std::string_view message);
     
     /**
-     * @brief Perform actual write operation
+     * @brief Write the whole pending batch with one gathered async_write
+     *
+     * Runs on the strand with writeMutex_ held and writing_ set; clears
+     * writing_ once nothing is left to send.
      */
     void doWrite();
     
+    /**
+     * @brief Take an empty segment from the pool (or allocate one)
+     */
+    std::string acquireSegment();
+    
     /**
      * @brief Start heartbeat timer
      */
@@ -260,6 +388,9 @@ private:
     
     /**
      * @brief Generate next outgoing sequence number
+     *
+     * Call with encodeMutex_ held and queue the message before releasing it,
+     * so messages sent from different threads reach the wire in sequence.
      * @return Next sequence number
      */
     SequenceNumber getNextOutgoingSeqNum() { return ++outgoingSeqNum_; }
@@ -273,12 +404,19 @@ private:
 private:
     // Network components
     boost::asio::io_context& ioContext_;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;   // Serializes all socket and timer work
     boost::asio::ip::tcp::socket socket_;
     boost::asio::steady_timer heartbeatTimer_;
     boost::asio::steady_timer testRequestTimer_;
+    boost::asio::steady_timer corkTimer_;
     
     // FIX protocol components
     FixMessageParser parser_;
+    FixMessageView inboundView_;    // Reused for every inbound message
+    FixEncoder encoder_;            // Execution reports, the bulk of outbound traffic
+    std::string encodeBuffer_;      // Reused for every encoded execution report
+    std::mutex encodeMutex_;        // Guards encoder_ and encodeBuffer_; every send holds it from
+                                    // taking its MsgSeqNum until the message is queued
     std::string senderCompId_;
     std::string targetCompId_;
     
@@ -286,6 +424,7 @@ private:
     std::atomic<SessionState> state_{SessionState::Disconnected};
     std::atomic<SequenceNumber> incomingSeqNum_{0};
     std::atomic<SequenceNumber> outgoingSeqNum_{0};
+    bool logonAnswered_{false};     // Accepted sessions answer the initiator's logon once
     
     // Heartbeat management
     int heartbeatInterval_{fix::HEARTBEAT_INTERVAL};
@@ -298,6 +437,17 @@ private:
     CancelReplaceHandler cancelReplaceHandler_;
     CancelHandler cancelHandler_;
     SessionEventHandler sessionEventHandler_;
+    OrderBatchHandler orderBatchHandler_;
+    ExecutionReportHandler executionReportHandler_;
+    std::vector<FixOrderRequest> pendingOrders_;    // Order requests from the current read
+    
+    // Polled receive (busy-poll IO threads)
+    bool polledReceive_{false};
+    ReceiveHook receiveHook_{nullptr};
+    
+    // Latency tracing
+    bool traceLatency_{false};
+    uint64_t readTicks_{0};         // Completion of the current read
     
     // Statistics
     mutable std::mutex statsMutex_;
@@ -307,12 +457,20 @@ private:
     size_t heartbeatsReceived_{0};
     std::chrono::system_clock::time_point sessionStartTime_;
     
-    // Message buffer
-    std::array<char, 8192> readBuffer_;
-    std::string messageBuffer_;
-    
-    // Write queue for thread safety
-    std::queue<std::string> writeQueue_;
+    // Inbound bytes, split into whole messages by BodyLength
+    FixFrameReader frameReader_;
+    
+    // Outbound batching: messages are appended to pooled segments and each
+    // batch goes out as one scatter-gather write
+    static constexpr size_t WriteSegmentSize = 16 * 1024;
+    static constexpr size_t MaxPooledSegments = 64;
+    std::vector<std::string> pendingSegments_;
+    std::vector<std::string> inflightSegments_;
+    std::vector<std::string> segmentPool_;
+    std::vector<boost::asio::const_buffer> inflightBuffers_;
+    size_t pendingBytes_{0};
+    std::chrono::microseconds corkWindow_{0};   // 0 writes as soon as the socket is free
+    bool corkArmed_{false};
     std::mutex writeMutex_;
     bool writing_{false};
     
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace orderbook::fix::simd {
+
+// Marks a field with no '=' separator
+constexpr uint32_t NoEquals = UINT32_MAX;
+
+/**
+ * @brief Byte offsets of one SOH-delimited field
+ */
+struct FieldBounds {
+    uint32_t start;     // First byte of the tag
+    uint32_t equals;    // First '=' in the field, or NoEquals
+    uint32_t end;       // Terminating SOH, or the buffer size for a trailing field
+};
+
+/**
+ * @brief Name of the kernel selected at compile time ("avx2", "sse2" or "scalar")
+ */
+const char* kernelName();
+
+/**
+ * @brief Locate fields by scanning for SOH and '=' a vector register at a time
+ *
+ * Empty fields (consecutive SOH bytes) are skipped. Scanning stops early when
+ * out is full; call again with the updated pos to continue.
+ *
+ * @param data Message bytes
+ * @param size Message length
+ * @param pos In: offset to start scanning at. Out: offset to resume from
+ * @param out Receives field bounds
+ * @param capacity Number of entries available in out
+ * @return Number of fields written
+ */
+size_t scanFields(const char* data, size_t size, size_t& pos,
+                  FieldBounds* out, size_t capacity);
+
+/**
+ * @brief Sum of all bytes, 32 bytes per step with AVX2
+ * @param data Bytes to sum
+ * @param size Number of bytes
+ * @return Byte sum (take % 256 for a FIX checksum)
+ */
+uint32_t byteSum(const char* data, size_t size);
+
+/**
+ * @brief FIX CheckSum (tag 10) of a byte range
+ * @param data Bytes up to, not including, the "10=" field
+ * @param size Number of bytes
+ * @return Checksum value 0-255
+ */
+inline uint8_t checksum(const char* data, size_t size) {
+    return static_cast<uint8_t>(byteSum(data, size) & 0xFF);
+}
+
+}
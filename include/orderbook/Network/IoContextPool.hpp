@@ -0,0 +1,136 @@
+#pragma once
+#include "../Core/Interfaces.hpp"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Pool of io_contexts, each run by its own thread
+ *
+ * Every accepted session is bound to one context for its whole life, so its
+ * reads, parsing and writes stay on one thread and are spread across cores
+ * with the other sessions. acquire() picks a context round-robin or by
+ * fewest live sessions; release() is called when the session goes away.
+ *
+ * In BusyPoll mode the threads never sleep: each one spins between
+ * running ready handlers (timers, writes) with poll() and calling the
+ * pollers registered on its context, which read their sockets without
+ * blocking. Every thread then keeps a core busy even when idle.
+ */
+class IoContextPool {
+public:
+    enum class AssignmentPolicy { RoundRobin, LeastLoaded };
+    enum class RunMode {
+        Blocking,       // Threads block in run() until a completion arrives
+        BusyPoll        // Threads spin on poll() and the registered pollers
+    };
+
+    /**
+     * @brief Called on every busy-poll pass; returns false to be dropped
+     */
+    using Poller = std::function<bool()>;
+
+    /**
+     * @brief Pool settings
+     */
+    struct PoolConfig {
+        size_t threads = 1;
+        AssignmentPolicy policy = AssignmentPolicy::RoundRobin;
+        std::vector<int> cpu_affinity;  // CPU per thread; missing or negative entries are not pinned
+        RunMode mode = RunMode::Blocking;
+        int busy_poll_us = 50;          // SO_BUSY_POLL budget for polled sockets (0 = leave unset)
+    };
+
+    explicit IoContextPool(LoggerPtr logger = nullptr);
+    IoContextPool(LoggerPtr logger, const PoolConfig& config);
+    IoContextPool(LoggerPtr logger, std::shared_ptr<Config> config);
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    /**
+     * @brief Launch one thread per context
+     */
+    void start();
+
+    /**
+     * @brief Stop every context and join the threads
+     */
+    void stop();
+
+    /**
+     * @brief Choose a context for a new session and count it against that context
+     * @return Context index
+     */
+    size_t acquire();
+
+    /**
+     * @brief Return a session's slot to its context
+     * @param index Index previously returned by acquire()
+     */
+    void release(size_t index);
+
+    /**
+     * @brief Poll something on a context's thread (BusyPoll mode only)
+     *
+     * The poller is added from that thread, after handlers already posted
+     * to the context, and runs there until it returns false or the pool stops.
+     * @param index Context index
+     * @param poller Callable run on every pass
+     */
+    void addPoller(size_t index, Poller poller);
+
+    boost::asio::io_context& getContext(size_t index) { return contexts_[index]->context; }
+    size_t getLoad(size_t index) const { return contexts_[index]->sessions.load(std::memory_order_relaxed); }
+    size_t size() const { return contexts_.size(); }
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    bool isBusyPoll() const { return config_.mode == RunMode::BusyPoll; }
+    const PoolConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Parse an assignment policy name ("round_robin" or "least_loaded")
+     */
+    static AssignmentPolicy parsePolicy(const std::string& name);
+
+    /**
+     * @brief Parse a receive mode name ("async" or "busy_poll")
+     */
+    static RunMode parseRunMode(const std::string& name);
+
+    /**
+     * @brief Read pool settings from the [network] section
+     * @param config Configuration object
+     * @return Pool settings (defaults when config is null)
+     */
+    static PoolConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    struct Context {
+        boost::asio::io_context context{1};
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{context.get_executor()};
+        std::atomic<size_t> sessions{0};
+        std::vector<Poller> pollers;    // Only touched by the context's thread
+        std::thread thread;
+    };
+
+    LoggerPtr logger_;
+    PoolConfig config_;
+    std::vector<std::unique_ptr<Context>> contexts_;
+    std::atomic<size_t> next_{0};
+    std::atomic<bool> running_{false};
+
+    void createContexts();
+    void runContext(size_t index);
+    void busyPoll(Context& context);
+};
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include "../Utilities/Metrics.hpp"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Prometheus scrape endpoint for engine internals
+ *
+ * Serves GET /metrics over plain HTTP/1.0 from its own thread and
+ * io_context, rendering the registry's collectors on every request. The
+ * collectors only read values the owning threads publish with relaxed
+ * atomics, so a scrape never takes a lock a matching thread holds.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Endpoint settings
+     */
+    struct ServerConfig {
+        std::string address = "127.0.0.1";     // Listen address
+        uint16_t port = 0;                      // Listen port (0 = disabled in configuration)
+    };
+
+    MetricsServer(std::shared_ptr<MetricsRegistry> registry, LoggerPtr logger = nullptr);
+    MetricsServer(std::shared_ptr<MetricsRegistry> registry, LoggerPtr logger, const ServerConfig& config);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief Bind the listener and start the serving thread
+     * @return true on success, or the socket error
+     */
+    Result<bool> start();
+
+    /**
+     * @brief Close the listener and join the serving thread
+     */
+    void stop();
+
+    /**
+     * @brief Port the endpoint is listening on (useful with port 0)
+     */
+    uint16_t getPort() const;
+
+    uint64_t getScrapeCount() const { return scrapes_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Read endpoint settings from the [metrics] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static ServerConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    static constexpr size_t MaxRequestBytes = 8192;
+
+    struct Connection;
+
+    std::shared_ptr<MetricsRegistry> registry_;
+    LoggerPtr logger_;
+    ServerConfig config_;
+
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::thread thread_;
+    bool running_ = false;
+    std::atomic<uint64_t> scrapes_{0};
+
+    void accept();
+    void serve(std::shared_ptr<Connection> connection);
+    std::string respond(const std::string& request_line);
+};
+
+}
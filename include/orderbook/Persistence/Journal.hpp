@@ -0,0 +1,271 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Fixed-layout journal record, one cache line each
+ *
+ * Records carry interned symbol and account IDs, which only mean something
+ * inside the process that wrote them, so the journal defines each ID with a
+ * Symbol or Account record before its first use. A reader maps IDs through
+ * the most recent definition it has seen.
+ */
+struct alignas(64) JournalRecord {
+    enum class Type : uint8_t { Add = 1, Cancel = 2, Modify = 3, Trade = 4, Symbol = 5, Account = 6 };
+
+    static constexpr size_t MaxNameLength = 35;
+
+    uint64_t sequence;          // 1-based slot number; stored last, so 0 marks an unfinished slot
+    int64_t timestamp_ns;
+    SymbolId symbol_id;         // Book the record belongs to
+    Type type;
+    uint8_t side;               // Side, for Add
+    uint8_t order_type;         // OrderType, for Add
+    uint8_t tif;                // TimeInForce, for Add
+
+    struct OrderFields {
+        uint64_t order_id;
+        Price price;            // New price for Modify
+        Quantity quantity;      // New quantity for Modify
+        AccountId account_id;
+        uint32_t reserved;
+    };
+
+    struct TradeFields {
+        uint64_t trade_id;
+        uint64_t buy_order_id;
+        uint64_t sell_order_id;
+        Price price;
+        Quantity quantity;
+    };
+
+    struct NameFields {
+        uint32_t id;
+        uint8_t length;
+        char name[MaxNameLength];   // Longer names are truncated
+    };
+
+    union {
+        OrderFields order;
+        TradeFields trade;
+        NameFields name;
+    };
+};
+
+static_assert(sizeof(JournalRecord) == 64, "Journal records must stay one cache line");
+static_assert(std::is_trivially_copyable<JournalRecord>::value, "Journal records must be POD");
+
+/**
+ * @brief First 64 bytes of a journal file; the records follow
+ */
+struct alignas(64) JournalHeader {
+    static constexpr uint64_t Magic = 0x4C4E524A4B4F4F42ull;   // "BOOKJRNL", little-endian
+    static constexpr uint32_t Version = 1;
+
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t record_size;
+    uint64_t capacity;          // Records the file was pre-allocated for
+    int64_t created_ns;
+};
+
+static_assert(sizeof(JournalHeader) == 64, "Journal header layout is part of the file format");
+
+/**
+ * @brief Write-ahead journal of book commands and trades in a memory-mapped file
+ *
+ * The file is pre-allocated for a fixed number of records and mapped once,
+ * so appending is a slot claim and a 64-byte copy with no syscall. Books on
+ * different shards may share a writer: each append claims the next slot
+ * with one atomic increment and publishes the record by storing its
+ * sequence last.
+ *
+ * Durability is a group commit: a sync thread msyncs everything completed
+ * since the previous pass every sync_interval, so one msync covers every
+ * record appended in that window. With sync_interval 0 the pages are left
+ * to the OS, which survives a process crash but not a host crash.
+ *
+ * Reopening an existing file resumes after its last complete record.
+ */
+class JournalWriter : public IOrderJournal {
+public:
+    /**
+     * @brief Journal settings
+     */
+    struct JournalConfig {
+        std::string path;                               // Journal file (empty = journal disabled)
+        size_t capacity = 1 << 20;                      // Records the file is pre-allocated for
+        std::chrono::microseconds sync_interval{1000};  // Group commit period (0 = no msync)
+        bool prefault = true;                           // Map every page at open so appends never fault
+    };
+
+    /**
+     * @brief Journal counters
+     */
+    struct Stats {
+        uint64_t records = 0;               // Records in the file, recovered ones included
+        uint64_t recovered = 0;             // Records already in the file at open
+        uint64_t durable_sequence = 0;      // Last record covered by an msync
+        uint64_t syncs = 0;
+        uint64_t dropped = 0;               // Appends lost because the file was full
+    };
+
+    explicit JournalWriter(LoggerPtr logger = nullptr);
+    JournalWriter(LoggerPtr logger, const JournalConfig& config);
+    ~JournalWriter() override;
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    /**
+     * @brief Create or reopen the file, map it and start the sync thread
+     * @return true on success, or an error describing the failing call
+     */
+    Result<bool> open();
+
+    /**
+     * @brief Sync everything appended so far, stop the sync thread and unmap
+     */
+    void close();
+
+    bool isOpen() const { return records_ != nullptr; }
+
+    /**
+     * @brief Append a record
+     * @param record Record to copy; its sequence field is ignored
+     * @return Sequence the record was written at (0 if closed or full)
+     */
+    uint64_t append(const JournalRecord& record);
+
+    /**
+     * @brief Msync every record completed so far
+     * @return true on success, or the msync error
+     */
+    Result<bool> sync();
+
+    // IOrderJournal, called on the books' matching threads
+    void recordAdd(SymbolId symbol, const Order& order) override;
+    void recordCancel(SymbolId symbol, OrderId id) override;
+    void recordModify(SymbolId symbol, OrderId id, Price new_price, Quantity new_quantity) override;
+    void recordTrade(const Trade& trade) override;
+
+    /**
+     * @brief Last sequence covered by an msync; callers that must not
+     *        acknowledge before durability can wait for it to pass theirs
+     */
+    uint64_t getDurableSequence() const { return durable_sequence_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Last sequence claimed so far; read on a book's matching thread
+     *        it covers every record that book has appended
+     */
+    uint64_t getLastSequence() const {
+        uint64_t last = next_sequence_.load(std::memory_order_relaxed) - 1;
+        return last < capacity_ ? last : capacity_;
+    }
+    Stats getStats() const;
+    const JournalConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Read journal settings from the [journal] section
+     * @param config Configuration object
+     * @return Settings (journal disabled when config is null)
+     */
+    static JournalConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    // IDs up to this many get a definition only once per process
+    static constexpr uint32_t MaxTrackedIds = 1 << 16;
+
+    LoggerPtr logger_;
+    JournalConfig config_;
+
+    int fd_ = -1;
+    size_t mapped_size_ = 0;
+    size_t capacity_ = 0;
+    char* base_ = nullptr;
+    JournalRecord* records_ = nullptr;
+
+    std::atomic<uint64_t> next_sequence_{1};
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t recovered_ = 0;
+
+    std::unique_ptr<std::atomic<bool>[]> defined_symbols_;
+    std::unique_ptr<std::atomic<bool>[]> defined_accounts_;
+
+    // Group commit
+    mutable std::mutex sync_mutex_;
+    std::condition_variable sync_wake_;
+    std::thread sync_thread_;
+    bool running_ = false;
+    uint64_t synced_slots_ = 0;                 // Guarded by sync_mutex_
+    uint64_t syncs_ = 0;                        // Guarded by sync_mutex_
+    std::atomic<uint64_t> durable_sequence_{0};
+
+    void runSync();
+    Result<bool> syncLocked();
+    uint64_t completedPrefix(uint64_t from) const;
+    void recover();
+
+    void define(JournalRecord::Type type, uint32_t id);
+    void defineSymbol(SymbolId symbol);
+    void defineAccount(AccountId account);
+};
+
+/**
+ * @brief Sequential reader over the complete records of a journal file
+ *
+ * Stops at the first slot that was never finished (a crash mid-append, or
+ * the end of what has been written so far); later calls to next() pick up
+ * records appended since.
+ */
+class JournalReader {
+public:
+    explicit JournalReader(std::string path);
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    /**
+     * @brief Map the file read-only
+     * @return true on success, or an error if the file is missing or not a journal
+     */
+    Result<bool> open();
+    void close();
+
+    bool isOpen() const { return records_ != nullptr; }
+
+    /**
+     * @brief Get the next complete record
+     * @return Record in the mapping, or nullptr at the end of the complete records
+     */
+    const JournalRecord* next();
+
+    uint64_t getLastSequence() const { return next_sequence_ - 1; }   // Last record read
+    size_t getCapacity() const { return capacity_; }
+
+private:
+    std::string path_;
+    size_t mapped_size_ = 0;
+    size_t capacity_ = 0;
+    const char* base_ = nullptr;
+    const JournalRecord* records_ = nullptr;
+    uint64_t next_sequence_ = 1;
+};
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "Journal.hpp"
+#include "../Core/OrderBook.hpp"
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace orderbook {
+
+class OrderBookRouter;
+
+/**
+ * @brief Rebuilds book state by applying a journal's commands to a router's books
+ *
+ * Adds, cancels and modifies go through the books exactly as they did when
+ * recorded, so levels, queues and (with a risk manager) positions come back
+ * as they were. Trades are not applied: matching regenerates them, and
+ * each recorded trade is compared with the regenerated one for its book to
+ * catch divergence. The books should have no journal attached while
+ * replaying, or the replay is journaled again.
+ *
+ * After a snapshot restore, skipThrough() marks each restored book's
+ * journal position so only the tail after it is applied.
+ */
+class JournalReplayer {
+public:
+    /**
+     * @brief Replay counters
+     */
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t adds = 0;
+        uint64_t cancels = 0;
+        uint64_t modifies = 0;
+        uint64_t rejected = 0;              // Commands the book rejected (as it did when recorded)
+        uint64_t trades = 0;                // Recorded trades checked
+        uint64_t trade_mismatches = 0;      // Recorded trades matching did not reproduce
+        uint64_t unknown_books = 0;         // Commands for symbols the router has no book for
+        uint64_t skipped = 0;               // Records already reflected in a restored snapshot
+        uint64_t last_sequence = 0;
+        uint64_t last_trade_id = 0;         // Highest recorded trade ID
+    };
+
+    explicit JournalReplayer(OrderBookRouter& router, LoggerPtr logger = nullptr);
+
+    /**
+     * @brief Apply every complete record of a journal file
+     *
+     * Afterwards new trade IDs continue past the highest recorded one.
+     * @param path Journal file
+     * @return Counters for the whole replay, or an error if the file cannot be read
+     */
+    Result<Stats> replay(const std::string& path);
+
+    /**
+     * @brief Skip a book's records up to and including a journal sequence
+     * @param symbol Book, by this process's symbol ID
+     * @param sequence Last sequence its restored state already reflects
+     */
+    void skipThrough(SymbolId symbol, uint64_t sequence) { skip_through_[symbol] = sequence; }
+
+    /**
+     * @brief Apply one record
+     */
+    void apply(const JournalRecord& record);
+
+    /**
+     * @brief Count regenerated trades no recorded trade matched as mismatches
+     *
+     * replay() calls this at the end; call it after the last apply() otherwise.
+     */
+    void finish();
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    OrderBookRouter& router_;
+    LoggerPtr logger_;
+    Stats stats_;
+
+    // Journal IDs to this process's interned IDs, per the latest definition
+    std::vector<SymbolId> symbols_;
+    std::vector<AccountId> accounts_;
+
+    // Regenerated trades per book, waiting for their recorded counterparts
+    std::unordered_map<SymbolId, std::deque<Trade>> pending_trades_;
+    std::unordered_map<SymbolId, uint64_t> skip_through_;
+    MatchResult match_result_;
+
+    SymbolId mapSymbol(SymbolId journal_id) const;
+    AccountId mapAccount(AccountId journal_id) const;
+    void define(std::vector<uint32_t>& ids, InternTable& table, const JournalRecord& record);
+    void checkTrade(SymbolId symbol, const JournalRecord& record);
+};
+
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/InternTable.hpp"
+#include "../Core/MatchingEngine.hpp"
+#include "../Utilities/LatencyHistogram.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+class OrderBookRouter;
+
+/**
+ * @brief One recorded order-entry command
+ */
+struct OrderFlowEvent {
+    enum class Type : uint8_t { Add, Cancel, Modify };
+
+    int64_t timestamp_ns = 0;       // Capture time; only differences between events matter
+    Type type = Type::Add;
+    SymbolId symbol = InternTable::EmptyId;
+    uint64_t order_id = 0;
+    Side side = Side::Buy;
+    OrderType order_type = OrderType::Limit;
+    TimeInForce tif = TimeInForce::GTC;
+    Price price = 0.0;              // New price for Modify
+    Quantity quantity = 0;          // New quantity for Modify
+    AccountId account = InternTable::EmptyId;
+};
+
+/**
+ * @brief Loads recorded order flow into memory, so parsing is not timed
+ */
+class OrderFlowCapture {
+public:
+    /**
+     * @brief Read the adds, cancels and modifies of a journal
+     * @param path Journal file written by JournalWriter
+     * @return Events in journal order, with this process's interned IDs
+     */
+    static Result<std::vector<OrderFlowEvent>> loadJournal(const std::string& path);
+
+    /**
+     * @brief Read a CSV capture
+     *
+     * One event per line:
+     * timestamp_ns,action,symbol,order_id,side,type,tif,price,quantity,account
+     * where action is add, cancel or modify (or the FIX MsgTypes D, F, G),
+     * side is buy/sell (1/2), type limit/market and tif gtc/ioc/fok. Cancels
+     * only need the first four columns. Blank lines, lines starting with '#'
+     * and a header line are skipped.
+     * @param path CSV file
+     * @return Events in file order, or an error naming the first bad line
+     */
+    static Result<std::vector<OrderFlowEvent>> loadCsv(const std::string& path);
+};
+
+/**
+ * @brief Where replayed events are applied
+ */
+class OrderFlowTarget {
+public:
+    virtual ~OrderFlowTarget() = default;
+
+    /**
+     * @brief Called once before the timed run, e.g. to pre-encode messages
+     */
+    virtual void prepare(const std::vector<OrderFlowEvent>& events) { (void)events; }
+
+    /**
+     * @brief Apply one event
+     * @param event Event to apply
+     * @param index Position of the event in the prepared sequence
+     * @return false if the event was rejected
+     */
+    virtual bool apply(const OrderFlowEvent& event, size_t index) = 0;
+};
+
+/**
+ * @brief Applies events directly to a router's books
+ */
+class RouterFlowTarget : public OrderFlowTarget {
+public:
+    explicit RouterFlowTarget(OrderBookRouter& router) : router_(router) {}
+
+    bool apply(const OrderFlowEvent& event, size_t index) override;
+
+    uint64_t getTrades() const { return trades_; }
+
+private:
+    OrderBookRouter& router_;
+    MatchResult match_;         // Reused for every add
+    uint64_t trades_ = 0;
+};
+
+/**
+ * @brief Drives recorded order flow into a target and measures every operation
+ *
+ * Events are applied one at a time on the calling thread, either back to
+ * back or at the recorded pace (optionally sped up). Each operation's
+ * service time (the call into the target) goes into a histogram for its
+ * type. When paced, response time is measured from when the event was due
+ * rather than from when it was sent, so time spent behind schedule shows up
+ * in the tail instead of being hidden by the replay slowing down.
+ */
+class OrderFlowReplay {
+public:
+    /**
+     * @brief How fast events are sent
+     */
+    enum class Pace {
+        AsFastAsPossible,           // Back to back
+        Recorded                    // At the capture's timestamps, divided by speed
+    };
+
+    /**
+     * @brief Replay settings
+     */
+    struct ReplayConfig {
+        Pace pace = Pace::AsFastAsPossible;
+        double speed = 1.0;         // Recorded pace multiplier
+        size_t warmup_events = 0;   // Leading events applied but not measured
+    };
+
+    /**
+     * @brief Measurements for one operation type
+     */
+    struct OperationReport {
+        LatencyHistogram service;   // Nanoseconds inside the target
+        LatencyHistogram response;  // Nanoseconds from due time to completion (paced runs only)
+        uint64_t rejected = 0;
+    };
+
+    /**
+     * @brief Measurements for a whole run
+     */
+    struct Report {
+        OperationReport add;
+        OperationReport cancel;
+        OperationReport modify;
+        uint64_t events = 0;        // Measured events
+        double seconds = 0.0;       // Wall time of the measured events
+        int64_t max_lag_ns = 0;     // Furthest behind schedule an event was sent (paced runs)
+
+        double throughput() const { return seconds > 0.0 ? events / seconds : 0.0; }
+        const OperationReport& forType(OrderFlowEvent::Type type) const;
+        OperationReport& forType(OrderFlowEvent::Type type);
+    };
+
+    OrderFlowReplay();
+    explicit OrderFlowReplay(const ReplayConfig& config);
+
+    /**
+     * @brief Prepare the target, then apply every event and measure it
+     * @param events Recorded flow
+     * @param target Where events are applied
+     * @return Measurements (held on the heap; the histograms are large)
+     */
+    std::unique_ptr<Report> run(const std::vector<OrderFlowEvent>& events, OrderFlowTarget& target) const;
+
+    const ReplayConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Parse a pace name ("recorded" or "max")
+     * @param name Pace from configuration or the command line
+     * @return Parsed pace (AsFastAsPossible for unknown names)
+     */
+    static Pace parsePace(const std::string& name);
+
+    /**
+     * @brief Read replay settings from the [replay] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static ReplayConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    ReplayConfig config_;
+};
+
+}
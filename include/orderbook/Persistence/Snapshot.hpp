@@ -0,0 +1,175 @@
+#pragma once
+#include "Journal.hpp"
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+class OrderBook;
+class OrderBookRouter;
+class MatchingRuntime;
+
+/**
+ * @brief First bytes of a snapshot file; one BookSnapshotHeader section per book follows
+ */
+struct SnapshotFileHeader {
+    static constexpr uint64_t Magic = 0x46504E534B4F4F42ull;   // "BOOKSNPF", little-endian
+    static constexpr uint32_t Version = 1;
+
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t book_count;
+    int64_t taken_ns;
+};
+
+/**
+ * @brief Takes point-in-time snapshots of every book and writes them to one file
+ *
+ * Each book is copied into its own buffer on the thread that owns it
+ * (between two batches with a MatchingRuntime), together with the journal
+ * sequence its state reflects, so books on different shards need not stop
+ * at the same moment. The buffers are then written out on a background
+ * thread to a temporary file that replaces the snapshot with a rename, so
+ * the file on disk is always a complete snapshot.
+ */
+class SnapshotWriter {
+public:
+    /**
+     * @brief Snapshot settings
+     */
+    struct SnapshotConfig {
+        std::string path;           // Snapshot file (empty = snapshots disabled)
+    };
+
+    /**
+     * @brief Snapshot counters
+     */
+    struct Stats {
+        uint64_t snapshots = 0;             // Snapshots written
+        uint64_t failures = 0;              // Writes that failed
+        uint64_t books = 0;                 // Books in the last snapshot
+        uint64_t bytes = 0;                 // Size of the last snapshot
+        int64_t capture_ns = 0;             // Longest single-book copy in the last snapshot
+        int64_t write_ns = 0;               // Time the last write took
+    };
+
+    explicit SnapshotWriter(LoggerPtr logger = nullptr);
+    SnapshotWriter(LoggerPtr logger, const SnapshotConfig& config);
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    /**
+     * @brief Record the journal position of each book from this journal
+     * @param journal Journal the books write to (nullptr = positions are 0)
+     */
+    void setJournal(std::shared_ptr<JournalWriter> journal) { journal_ = std::move(journal); }
+
+    /**
+     * @brief Snapshot the books of a running (or stopped) runtime
+     *
+     * Each shard copies its books between batches; the call returns once
+     * every book is copied, while the file is still being written.
+     * @return true once the write has started, or an error if a previous
+     *         snapshot is still being written or no path is set
+     */
+    Result<bool> capture(MatchingRuntime& runtime);
+
+    /**
+     * @brief Snapshot a router's books on the calling thread
+     *
+     * No other thread may be changing the books meanwhile.
+     * @return As capture(runtime)
+     */
+    Result<bool> capture(const OrderBookRouter& router);
+
+    /**
+     * @brief Wait for the snapshot being written, if any
+     * @return Outcome of the last write
+     */
+    Result<bool> wait();
+
+    bool isWriting() const;
+    Stats getStats() const;
+    const SnapshotConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Read snapshot settings from the [snapshot] section
+     * @param config Configuration object
+     * @return Settings (snapshots disabled when config is null)
+     */
+    static SnapshotConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    LoggerPtr logger_;
+    SnapshotConfig config_;
+    std::shared_ptr<JournalWriter> journal_;
+
+    // Sections indexed by symbol ID; a book only ever writes its own slot
+    std::vector<std::vector<char>> sections_;
+    std::vector<int64_t> capture_ns_;
+
+    mutable std::mutex mutex_;
+    std::thread writer_;
+    bool writing_ = false;                      // Guarded by mutex_
+    Result<bool> last_result_ = Result<bool>::success(true);   // Guarded by mutex_
+    Stats stats_;                               // Guarded by mutex_
+
+    template<typename VisitAll>
+    Result<bool> captureBooks(VisitAll&& visit_all);
+    void captureBook(SymbolId symbol, const OrderBook& book);
+    Result<bool> writeFile(uint64_t& bytes, uint64_t& books);
+};
+
+/**
+ * @brief Restores books from a snapshot file written by SnapshotWriter
+ *
+ * Each section goes to the router's book for its symbol, which must be
+ * empty; sections for symbols the router has no book for are skipped. The
+ * journal position of every restored book is kept, so a JournalReplayer can
+ * then apply only the records after it.
+ */
+class SnapshotLoader {
+public:
+    /**
+     * @brief Restore counters
+     */
+    struct Stats {
+        uint64_t books = 0;                 // Books restored
+        uint64_t orders = 0;                // Resting orders restored
+        uint64_t unknown_books = 0;         // Sections for symbols the router has no book for
+        int64_t taken_ns = 0;               // When the snapshot was taken
+    };
+
+    explicit SnapshotLoader(OrderBookRouter& router, LoggerPtr logger = nullptr);
+
+    /**
+     * @brief Restore every book in a snapshot file
+     * @param path Snapshot file
+     * @return Counters, or an error if the file cannot be read or a section
+     *         fails to load (books before it stay restored)
+     */
+    Result<Stats> load(const std::string& path);
+
+    /**
+     * @brief Last journal sequence each restored book reflects
+     */
+    const std::unordered_map<SymbolId, uint64_t>& getJournalSequences() const { return journal_sequences_; }
+
+private:
+    OrderBookRouter& router_;
+    LoggerPtr logger_;
+    std::unordered_map<SymbolId, uint64_t> journal_sequences_;
+};
+
+}
@@ -2,8 +2,14 @@
 #include "../Core/Types.hpp"
 #include "../Core/Interfaces.hpp"
 #include "../Core/Order.hpp"
-#include <unordered_map>
+#include "../Utilities/FlatHashMap.hpp"
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace orderbook {
 
@@ -11,6 +17,26 @@ class Config;
 
 /**
  * @brief Concrete implementation of risk management
+ *
+ * Positions are kept per (account, symbol) in flat arrays indexed by the
+ * interned IDs orders already carry: one row of symbol slots per account,
+ * allocated on the account's first order. Each slot holds the position
+ * together with its precomputed limits, so checkOrder() and onFill() are a
+ * few loads and compares with no string hashing or map inserts.
+ *
+ * Shards may share one manager. Each symbol is matched by one shard, so
+ * every slot has a single writer; slots are relaxed atomics so
+ * getPortfolio() can read them from any thread. The string-keyed
+ * validateOrder()/updatePosition()/getPortfolio() interface remains for
+ * callers outside the matching path.
+ *
+ * The position check counts filled position only: quantity resting in the
+ * book is not open exposure until it trades.
+ *
+ * Limits are published as immutable sets behind an atomic pointer, so
+ * checks on submitting threads always see one whole set while
+ * setLimits() or a reload swaps in the next. Replaced sets are kept until
+ * the manager goes, like position rows, so a reader never sees one freed.
  */
 class RiskManager : public IRiskManager {
 public:
@@ -20,37 +46,107 @@ public:
         Price min_price = 0.01;
         int64_t max_position = 100000;
         int64_t min_position = -100000;
+        double fat_finger_percent = 0.0;    // Max limit price distance from the reference price (0 = off)
+        size_t max_accounts = 4096;     // Position table size in account IDs (fixed at construction)
+        size_t max_symbols = 1024;      // Position table size in symbol IDs (fixed at construction)
     };
-    
-    explicit RiskManager(const RiskLimits& limits = RiskLimits{}, LoggerPtr logger = nullptr);
+
+    explicit RiskManager(LoggerPtr logger = nullptr);
+    explicit RiskManager(const RiskLimits& limits, LoggerPtr logger = nullptr);
     explicit RiskManager(std::shared_ptr<Config> config, LoggerPtr logger = nullptr);
-    
+    ~RiskManager() override;
+
+    RiskManager(const RiskManager&) = delete;
+    RiskManager& operator=(const RiskManager&) = delete;
+
     // IRiskManager interface implementation
     RiskCheck validateOrder(const Order& order, const Portfolio& portfolio) override;
     void updatePosition(const Trade& trade) override;
     const Portfolio& getPortfolio(const std::string& account) const override;
-    
+    RiskCheck checkOrder(const Order& order) override;
+    RiskCheck checkOrderStateless(const Order& order) const override;
+    RiskCheck checkOrderPosition(const Order& order) override;
+    void onFill(const Trade& trade, AccountId buy_account, AccountId sell_account) override;
+
     // Configuration
     void setLimits(const RiskLimits& limits);
-    const RiskLimits& getLimits() const;
+    const RiskLimits& getLimits() const { return *limits_.load(std::memory_order_acquire); }
     void loadConfiguration(std::shared_ptr<Config> config);
     void reloadConfiguration();
-    
-    // Account management
+
+    /**
+     * @brief Override the position limits for one account and symbol
+     * @param account Interned account ID
+     * @param symbol Interned symbol ID
+     * @param min_position Lowest allowed net position
+     * @param max_position Highest allowed net position
+     */
+    void setPositionLimits(AccountId account, SymbolId symbol, int64_t min_position, int64_t max_position);
+
+    /**
+     * @brief Get the net position for an account and symbol
+     * @return Signed position (0 if never traded)
+     */
+    int64_t getPosition(AccountId account, SymbolId symbol) const;
+
+    /**
+     * @brief Set the price fat-finger bands are measured from
+     *
+     * Fills update it to the last trade price; set it at startup (e.g. to the
+     * previous close) so the band applies before a symbol first trades.
+     * @param symbol Interned symbol ID
+     * @param price Reference price (0 = no band until the first fill)
+     */
+    void setReferencePrice(SymbolId symbol, Price price);
+    Price getReferencePrice(SymbolId symbol) const;
+
+    // Account management (for the string-keyed updatePosition path)
     void associateOrderWithAccount(OrderId order_id, const std::string& account);
     std::string getAccountForOrder(OrderId order_id) const;
 
 private:
-    RiskLimits limits_;
-    mutable std::unordered_map<std::string, Portfolio> portfolios_;
-    std::unordered_map<OrderId, std::string, OrderIdHash> order_to_account_;
+    // One (account, symbol) position with its precomputed limits; written by
+    // the shard that matches the symbol
+    struct PositionSlot {
+        std::atomic<int64_t> position{0};
+        std::atomic<int64_t> min_position{0};
+        std::atomic<int64_t> max_position{0};
+        std::atomic<Price> last_price{0.0};
+    };
+
+    std::atomic<const RiskLimits*> limits_{nullptr};
     std::shared_ptr<Config> config_;
     LoggerPtr logger_;
-    
+
+    // Row per account, indexed by AccountId; rows are never freed or moved
+    std::unique_ptr<std::atomic<PositionSlot*>[]> rows_;
+    size_t row_capacity_ = 0;
+    size_t row_width_ = 0;
+
+    // Last trade (or configured) price per symbol, for fat-finger bands
+    std::unique_ptr<std::atomic<Price>[]> reference_prices_;
+
+    // Guards row creation, limit overrides, the order map and the portfolio cache
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<const RiskLimits>> limit_sets_;        // Every set published so far
+    std::map<std::pair<AccountId, SymbolId>, std::pair<int64_t, int64_t>> limit_overrides_;
+    FlatHashMap<OrderId, AccountId, OrderIdHash> order_to_account_;
+    mutable std::unordered_map<std::string, Portfolio> portfolios_;     // Snapshots for getPortfolio()
+
+    PositionSlot* findSlot(AccountId account, SymbolId symbol) const;
+    PositionSlot* slotFor(AccountId account, SymbolId symbol);
+    PositionSlot* createRow(AccountId account);
+    void publishLimits(const RiskLimits& limits);
+    void applyLimits(PositionSlot* row, AccountId account) const;
+    void allocateRows();
+    void releaseRows();
+
     // Validation helpers
-    bool validateOrderSize(Quantity quantity) const;
-    bool validatePrice(Price price) const;
-    bool validatePosition(const Portfolio& portfolio, const Order& order) const;
+    bool validateOrderSize(const RiskLimits& limits, Quantity quantity) const;
+    bool validatePrice(const RiskLimits& limits, Price price) const;
+    bool validatePriceBand(const RiskLimits& limits, const Order& order) const;
+    bool validatePosition(const RiskLimits& limits, const Portfolio& portfolio, const Order& order) const;
+    RiskCheck reject(const Order& order, const std::string& reason) const;
 };
 
-}
\ No newline at end of file
+}
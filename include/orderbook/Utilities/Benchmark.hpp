@@ -0,0 +1,233 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "TscClock.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Keep a value (and what it depends on) from being optimized away
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+/**
+ * @brief Timing loop handed to a benchmark function
+ *
+ * The function does its setup, then runs exactly iterations() timed
+ * iterations with `while (state.keepRunning()) { ... }`. Work that must
+ * not be timed (refilling a book a sweep emptied, say) goes between
+ * pauseTiming() and resumeTiming(); each pair costs a few hundred
+ * nanoseconds, so pause once per batch of iterations where possible.
+ */
+class BenchmarkState {
+public:
+    BenchmarkState(const std::vector<int64_t>& args, uint64_t iterations)
+        : args_(args), iterations_(iterations), remaining_(iterations) {}
+
+    BenchmarkState(const BenchmarkState&) = delete;
+    BenchmarkState& operator=(const BenchmarkState&) = delete;
+
+    /**
+     * @brief Start the timer on the first call, stop it after the last iteration
+     * @return true while iterations remain
+     */
+    bool keepRunning() {
+        if (running_ && remaining_ != 0) {
+            --remaining_;
+            return true;
+        }
+        return advance();
+    }
+
+    void pauseTiming();
+    void resumeTiming();
+
+    /**
+     * @brief Argument i of this instance (e.g. the book depth)
+     */
+    int64_t range(size_t i = 0) const { return args_.at(i); }
+    uint64_t iterations() const { return iterations_; }
+
+    // Work done by the whole run; reported per second of real time
+    void setItemsProcessed(uint64_t items) { items_processed_ = items; }
+    void setBytesProcessed(uint64_t bytes) { bytes_processed_ = bytes; }
+
+    /**
+     * @brief Report an extra value with the run (e.g. trades per iteration)
+     */
+    void setCounter(const std::string& name, double value);
+    void setLabel(std::string label) { label_ = std::move(label); }
+
+    /**
+     * @brief Mark the run failed; it is reported with the message and no timings
+     */
+    void skipWithError(std::string message);
+
+    bool isSkipped() const { return !error_.empty(); }
+
+private:
+    friend class BenchmarkRunner;
+
+    bool advance();
+
+    std::vector<int64_t> args_;
+    uint64_t iterations_;
+    uint64_t remaining_;
+    bool running_ = false;
+    bool finished_ = false;
+    bool paused_ = false;
+
+    uint64_t start_ticks_ = 0;
+    double start_cpu_ = 0.0;
+    int64_t real_ns_ = 0;
+    double cpu_ns_ = 0.0;
+
+    uint64_t items_processed_ = 0;
+    uint64_t bytes_processed_ = 0;
+    std::vector<std::pair<std::string, double>> counters_;
+    std::string label_;
+    std::string error_;
+};
+
+/**
+ * @brief A registered benchmark function and the argument sets to run it with
+ */
+class Benchmark {
+public:
+    using Function = void (*)(BenchmarkState&);
+
+    Benchmark(std::string name, Function function) : name_(std::move(name)), function_(function) {}
+
+    /**
+     * @brief Add one instance, run with these arguments
+     */
+    Benchmark* args(std::vector<int64_t> values);
+
+    /**
+     * @brief Add one single-argument instance per value
+     */
+    Benchmark* argValues(const std::vector<int64_t>& values);
+
+    /**
+     * @brief Name the arguments in reported names ("BM_Add/depth:100" rather than "BM_Add/100")
+     */
+    Benchmark* argNames(std::vector<std::string> names);
+
+    /**
+     * @brief Run a fixed number of iterations instead of scaling to the minimum time
+     */
+    Benchmark* iterations(uint64_t count);
+
+    /**
+     * @brief Add a benchmark to the process-wide registry
+     * @return The benchmark, for chaining argument sets
+     */
+    static Benchmark* registerBenchmark(const char* name, Function function);
+    static const std::vector<std::unique_ptr<Benchmark>>& registry();
+
+private:
+    friend class BenchmarkRunner;
+
+    std::string instanceName(size_t instance) const;
+    static std::vector<std::unique_ptr<Benchmark>>& mutableRegistry();
+
+    std::string name_;
+    Function function_;
+    std::vector<std::vector<int64_t>> arg_sets_;
+    std::vector<std::string> arg_names_;
+    uint64_t fixed_iterations_ = 0;
+};
+
+/**
+ * @brief Runs registered benchmarks and reports them
+ *
+ * Each instance is first run with a growing iteration count until one run
+ * lasts at least min_time; that run is reported, and with repetitions > 1
+ * the same count is run again and mean, median and stddev aggregates are
+ * added. Reports go to the console or as JSON in the layout Google
+ * Benchmark writes (context plus a benchmarks array, times in ns per
+ * iteration), so its comparison tooling and dashboards can read them.
+ */
+class BenchmarkRunner {
+public:
+    struct RunnerConfig {
+        std::string filter = ".*";      // ECMAScript regex matched against instance names
+        double min_time = 0.5;          // Seconds per reported run
+        int repetitions = 1;
+    };
+
+    /**
+     * @brief One reported run or aggregate
+     */
+    struct Run {
+        std::string name;               // e.g. "BM_AddOrder/depth:100" or "..._mean"
+        std::string run_name;           // Instance name without the aggregate suffix
+        size_t family_index = 0;
+        size_t instance_index = 0;
+        bool aggregate = false;
+        std::string aggregate_name;
+        int repetitions = 1;
+        int repetition_index = 0;
+        uint64_t iterations = 0;
+        double real_time_ns = 0.0;      // Per iteration
+        double cpu_time_ns = 0.0;       // Per iteration, process CPU time
+        double items_per_second = 0.0;
+        double bytes_per_second = 0.0;
+        std::vector<std::pair<std::string, double>> counters;
+        std::string label;
+        std::string error;
+    };
+
+    BenchmarkRunner();
+    explicit BenchmarkRunner(const RunnerConfig& config);
+
+    /**
+     * @brief Run every registered instance matching the filter
+     * @param on_run Called with each run as it is reported (nullptr = none)
+     * @return Runs in order, or an error if the filter is not a valid regex
+     */
+    Result<std::vector<Run>> runAll(void (*on_run)(const Run&) = nullptr) const;
+
+    /**
+     * @brief Registered instance names matching the filter
+     */
+    Result<std::vector<std::string>> list() const;
+
+    static void printConsoleHeader();
+    static void printConsoleRun(const Run& run);
+
+    /**
+     * @brief Serialize runs as Google Benchmark style JSON
+     * @param runs Runs to write
+     * @param executable Reported as context.executable
+     */
+    static std::string toJson(const std::vector<Run>& runs, const std::string& executable);
+
+private:
+    Run runInstance(const Benchmark& benchmark, size_t instance, uint64_t iterations) const;
+    static void addAggregates(std::vector<Run>& runs, size_t first);
+
+    RunnerConfig config_;
+};
+
+}
+
+#define ORDERBOOK_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define ORDERBOOK_BENCHMARK_CONCAT(a, b) ORDERBOOK_BENCHMARK_CONCAT_INNER(a, b)
+
+// Register a function as a benchmark: ORDERBOOK_BENCHMARK(BM_Add)->argValues({10, 100});
+#define ORDERBOOK_BENCHMARK(function) \
+    static ::orderbook::Benchmark* ORDERBOOK_BENCHMARK_CONCAT(_benchmark_, __LINE__) = \
+        ::orderbook::Benchmark::registerBenchmark(#function, function)
@@ -0,0 +1,400 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+
+namespace orderbook {
+
+/**
+ * @brief Open-addressing hash map with Robin Hood probing
+ *
+ * Entries live inline in one power-of-two array, so a lookup is usually a
+ * single cache line with no pointer chase, and inserts do not allocate
+ * until the table grows. Each slot records how far its entry sits from its
+ * home slot; inserts displace entries that are closer to home, which keeps
+ * probe sequences short even at high load. Erase shifts the following
+ * entries back instead of leaving tombstones, so lookups never slow down
+ * as orders churn.
+ *
+ * Hash values are spread with a Fibonacci multiply before taking the high
+ * bits, so identity hashes (e.g. sequential IDs) still distribute evenly.
+ *
+ * Differences from std::unordered_map: any insert or erase may move other
+ * entries, which invalidates iterators, pointers and references into the
+ * map; erase(iterator) does not return the next position.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;     // Key must not be modified through iterators
+    using size_type = size_t;
+
+private:
+    struct Slot {
+        uint32_t distance = 0;      // 0 = empty, otherwise probe distance + 1
+        alignas(value_type) unsigned char storage[sizeof(value_type)];
+
+        value_type& entry() { return *std::launder(reinterpret_cast<value_type*>(storage)); }
+        const value_type& entry() const { return *std::launder(reinterpret_cast<const value_type*>(storage)); }
+    };
+
+    template<bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using SlotPtr = std::conditional_t<Const, const Slot*, Slot*>;
+
+        Iterator() = default;
+        Iterator(SlotPtr slot, SlotPtr end) : slot_(slot), end_(end) { skipEmpty(); }
+
+        // iterator -> const_iterator
+        template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : slot_(other.slot_), end_(other.end_) {}
+
+        reference operator*() const { return slot_->entry(); }
+        pointer operator->() const { return &slot_->entry(); }
+
+        Iterator& operator++() {
+            ++slot_;
+            skipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.slot_ == b.slot_; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.slot_ != b.slot_; }
+
+    private:
+        friend class FlatHashMap;
+        template<bool> friend class Iterator;
+
+        SlotPtr slot_ = nullptr;
+        SlotPtr end_ = nullptr;
+
+        void skipEmpty() {
+            while (slot_ != end_ && slot_->distance == 0) {
+                ++slot_;
+            }
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    /**
+     * @brief Constructor
+     * @param capacity Number of entries to hold without growing
+     */
+    explicit FlatHashMap(size_t capacity) { reserve(capacity); }
+
+    FlatHashMap(const FlatHashMap& other) : hash_(other.hash_), equal_(other.equal_) {
+        reserve(other.size_);
+        for (const auto& entry : other) {
+            insertNew(value_type(entry));
+        }
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : slots_(std::move(other.slots_)), capacity_(other.capacity_), size_(other.size_),
+          shift_(other.shift_), hash_(std::move(other.hash_)), equal_(std::move(other.equal_)) {
+        other.capacity_ = 0;
+        other.size_ = 0;
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this != &other) {
+            FlatHashMap copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            slots_ = std::move(other.slots_);
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            shift_ = other.shift_;
+            hash_ = std::move(other.hash_);
+            equal_ = std::move(other.equal_);
+            other.capacity_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~FlatHashMap() { destroyAll(); }
+
+    void swap(FlatHashMap& other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(shift_, other.shift_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    iterator begin() { return iterator(slots_.get(), slots_.get() + capacity_); }
+    iterator end() { return iterator(slots_.get() + capacity_, slots_.get() + capacity_); }
+    const_iterator begin() const { return const_iterator(slots_.get(), slots_.get() + capacity_); }
+    const_iterator end() const { return const_iterator(slots_.get() + capacity_, slots_.get() + capacity_); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Find an entry
+     * @param key Key to look up
+     * @return Iterator to the entry or end()
+     */
+    iterator find(const Key& key) {
+        size_t index = findIndex(key);
+        return index == NotFound ? end() : iterator(slots_.get() + index, slots_.get() + capacity_);
+    }
+
+    const_iterator find(const Key& key) const {
+        size_t index = findIndex(key);
+        return index == NotFound ? end() : const_iterator(slots_.get() + index, slots_.get() + capacity_);
+    }
+
+    size_t count(const Key& key) const { return findIndex(key) == NotFound ? 0 : 1; }
+    bool contains(const Key& key) const { return findIndex(key) != NotFound; }
+
+    /**
+     * @brief Insert an entry if the key is not present
+     * @param key Key of the new entry
+     * @param args Arguments forwarded to the Value constructor
+     * @return Iterator to the entry, and true if it was inserted
+     */
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        size_t index = findIndex(key);
+        if (index != NotFound) {
+            return { iterator(slots_.get() + index, slots_.get() + capacity_), false };
+        }
+        growForInsert();
+        index = insertNew(value_type(std::piecewise_construct,
+                                     std::forward_as_tuple(std::forward<K>(key)),
+                                     std::forward_as_tuple(std::forward<Args>(args)...)));
+        return { iterator(slots_.get() + index, slots_.get() + capacity_), true };
+    }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+        return try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry) {
+        return try_emplace(entry.first, entry.second);
+    }
+
+    /**
+     * @brief Insert an entry or overwrite the value of an existing one
+     */
+    template<typename K, typename V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the value for a key, default-constructing it if absent
+     */
+    Value& operator[](const Key& key) {
+        return try_emplace(key).first->second;
+    }
+
+    /**
+     * @brief Remove the entry at a position
+     * @param position Valid iterator into this map
+     */
+    void erase(const_iterator position) {
+        eraseIndex(static_cast<size_t>(position.slot_ - slots_.get()));
+    }
+
+    /**
+     * @brief Remove the entry for a key
+     * @return Number of entries removed (0 or 1)
+     */
+    size_t erase(const Key& key) {
+        size_t index = findIndex(key);
+        if (index == NotFound) {
+            return 0;
+        }
+        eraseIndex(index);
+        return 1;
+    }
+
+    /**
+     * @brief Remove every entry, keeping the allocated table
+     */
+    void clear() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (slots_[i].distance != 0) {
+                slots_[i].entry().~value_type();
+                slots_[i].distance = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    /**
+     * @brief Size the table so count entries fit without growing
+     * @param count Expected number of entries
+     */
+    void reserve(size_t count) {
+        size_t needed = MinCapacity;
+        while (needed * MaxLoadNumerator < count * MaxLoadDenominator) {
+            needed *= 2;
+        }
+        if (needed > capacity_) {
+            rehash(needed);
+        }
+    }
+
+private:
+    static constexpr size_t NotFound = ~size_t{0};
+    static constexpr size_t MinCapacity = 16;
+
+    // Grow once the table is 3/4 full
+    static constexpr size_t MaxLoadNumerator = 3;
+    static constexpr size_t MaxLoadDenominator = 4;
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    unsigned shift_ = 64;
+    Hash hash_;
+    KeyEqual equal_;
+
+    size_t home(const Key& key) const {
+        // Fibonacci hashing: the high bits of the product depend on every bit of the hash
+        uint64_t mixed = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(mixed >> shift_);
+    }
+
+    size_t findIndex(const Key& key) const {
+        if (size_ == 0) {
+            return NotFound;
+        }
+        const size_t mask = capacity_ - 1;
+        size_t index = home(key);
+        for (uint32_t distance = 1;; ++distance) {
+            const Slot& slot = slots_[index];
+            // Robin Hood invariant: the key would have displaced anything closer to home
+            if (slot.distance < distance) {
+                return NotFound;
+            }
+            if (slot.distance == distance && equal_(slot.entry().first, key)) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    /**
+     * @brief Place an entry known to be absent; capacity must already allow it
+     * @return Slot index where the entry ended up
+     */
+    size_t insertNew(value_type&& entry) {
+        const size_t mask = capacity_ - 1;
+        size_t index = home(entry.first);
+        size_t placed = NotFound;
+        uint32_t distance = 1;
+
+        value_type carried(std::move(entry));
+        for (;; ++distance, index = (index + 1) & mask) {
+            Slot& slot = slots_[index];
+            if (slot.distance == 0) {
+                ::new (static_cast<void*>(slot.storage)) value_type(std::move(carried));
+                slot.distance = distance;
+                ++size_;
+                return placed == NotFound ? index : placed;
+            }
+            if (slot.distance < distance) {
+                // Take the slot from the entry closer to home and carry it onwards
+                std::swap(carried, slot.entry());
+                std::swap(distance, slot.distance);
+                if (placed == NotFound) {
+                    placed = index;
+                }
+            }
+        }
+    }
+
+    void eraseIndex(size_t index) {
+        const size_t mask = capacity_ - 1;
+        slots_[index].entry().~value_type();
+        slots_[index].distance = 0;
+        --size_;
+
+        // Backward shift: pull following displaced entries one slot closer to home
+        for (size_t next = (index + 1) & mask; slots_[next].distance > 1; next = (next + 1) & mask) {
+            ::new (static_cast<void*>(slots_[index].storage)) value_type(std::move(slots_[next].entry()));
+            slots_[index].distance = slots_[next].distance - 1;
+            slots_[next].entry().~value_type();
+            slots_[next].distance = 0;
+            index = next;
+        }
+    }
+
+    void growForInsert() {
+        if (capacity_ == 0) {
+            rehash(MinCapacity);
+        } else if ((size_ + 1) * MaxLoadDenominator > capacity_ * MaxLoadNumerator) {
+            rehash(capacity_ * 2);
+        }
+    }
+
+    void rehash(size_t newCapacity) {
+        std::unique_ptr<Slot[]> old = std::move(slots_);
+        size_t oldCapacity = capacity_;
+
+        slots_ = std::make_unique<Slot[]>(newCapacity);
+        capacity_ = newCapacity;
+        size_ = 0;
+        shift_ = 64;
+        for (size_t c = newCapacity; c > 1; c >>= 1) {
+            --shift_;
+        }
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (old[i].distance != 0) {
+                insertNew(std::move(old[i].entry()));
+                old[i].entry().~value_type();
+            }
+        }
+    }
+
+    void destroyAll() {
+        if (slots_) {
+            clear();
+        }
+    }
+};
+
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace orderbook {
+
+/**
+ * @brief Vector with room for the first N elements inside the object
+ *
+ * Up to N elements are constructed in place in the object itself, so a
+ * container that usually holds only a few elements never touches the heap.
+ * Past N, the elements move to a heap buffer that grows geometrically and
+ * is kept across clear(), so a reused container stops allocating once it
+ * has seen its largest size.
+ *
+ * Differences from std::vector: moving an InlineVector that is still
+ * inline moves its elements one by one, which invalidates iterators,
+ * pointers and references into the source; swap() is not provided.
+ */
+template<typename T, size_t N>
+class InlineVector {
+    static_assert(N > 0, "InlineVector needs at least one inline element");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t inline_capacity = N;
+
+    InlineVector() = default;
+
+    InlineVector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+
+    InlineVector(const InlineVector& other) {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    InlineVector(InlineVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        takeFrom(other);
+    }
+
+    ~InlineVector() {
+        clear();
+        releaseHeap();
+    }
+
+    InlineVector& operator=(const InlineVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    InlineVector& operator=(InlineVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            if (other.isInline()) {
+                // Keep our own heap buffer, if any, for later growth
+                std::uninitialized_move(other.begin(), other.end(), data_);
+                size_ = other.size_;
+                other.clear();
+            } else {
+                releaseHeap();
+                takeFrom(other);
+            }
+        }
+        return *this;
+    }
+
+    // Element access
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+
+    T& at(size_t index) {
+        if (index >= size_) throw std::out_of_range("InlineVector::at");
+        return data_[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("InlineVector::at");
+        return data_[index];
+    }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    // Iterators
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return data_; }
+    const_iterator cend() const { return data_ + size_; }
+
+    // Capacity
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief True while the elements are stored inside the object
+     */
+    bool isInline() const { return data_ == inlineData(); }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            grow(capacity);
+        }
+    }
+
+    // Modifiers
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // Construct first: args may refer to an element about to move
+            T value(std::forward<Args>(args)...);
+            grow(capacity_ * 2);
+            return *::new (static_cast<void*>(data_ + size_++)) T(std::move(value));
+        }
+        return *::new (static_cast<void*>(data_ + size_++)) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        data_[--size_].~T();
+    }
+
+    /**
+     * @brief Destroy all elements; any heap buffer is kept for reuse
+     */
+    void clear() {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+private:
+    T* data_ = inlineData();
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+
+    T* inlineData() { return std::launder(reinterpret_cast<T*>(storage_)); }
+    const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+    void grow(size_t capacity) {
+        T* buffer = std::allocator<T>().allocate(capacity);
+        std::uninitialized_move(begin(), end(), buffer);
+        size_t count = size_;
+        clear();
+        releaseHeap();
+        data_ = buffer;
+        size_ = count;
+        capacity_ = capacity;
+    }
+
+    void releaseHeap() {
+        if (!isInline()) {
+            std::allocator<T>().deallocate(data_, capacity_);
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Expects this to be empty and inline
+    void takeFrom(InlineVector& other) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+};
+
+}
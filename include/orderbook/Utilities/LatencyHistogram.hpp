@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Fixed-bucket log-linear latency histogram (HDR style)
+ *
+ * Values below SubBuckets get a bucket each; above that every power of two
+ * is split into SubBuckets / 2 linear buckets, so any recorded value is
+ * reported within 1/64 (1.6%) of itself across the whole range. Recording
+ * is an index computation and an increment, with no allocation and no
+ * sorting, and histograms from several threads or runs merge by adding
+ * counts. Values past MaxValue land in the last bucket.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SubBucketBits = 7;
+    static constexpr uint64_t SubBuckets = 1ull << SubBucketBits;          // 128
+    static constexpr uint32_t MaxShift = 40;                               // Up to ~2^47 ns (39 hours)
+    static constexpr size_t BucketCount = SubBuckets + MaxShift * (SubBuckets / 2);
+    static constexpr uint64_t MaxValue = (SubBuckets << MaxShift) - 1;
+
+    /**
+     * @brief Bucket a value falls into
+     */
+    static size_t bucketFor(uint64_t value) {
+        if (value < SubBuckets) {
+            return static_cast<size_t>(value);
+        }
+        value = std::min(value, MaxValue);
+        uint32_t shift = highestBit(value) - (SubBucketBits - 1);
+        return static_cast<size_t>(SubBuckets + (shift - 1) * (SubBuckets / 2) +
+                                   ((value >> shift) - SubBuckets / 2));
+    }
+
+    /**
+     * @brief Largest value that falls into a bucket
+     */
+    static uint64_t bucketUpperBound(size_t bucket) {
+        if (bucket < SubBuckets) {
+            return bucket;
+        }
+        uint64_t shift = (bucket - SubBuckets) / (SubBuckets / 2) + 1;
+        uint64_t sub = (bucket - SubBuckets) % (SubBuckets / 2) + SubBuckets / 2;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void record(uint64_t value) {
+        ++counts_[bucketFor(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief Add another histogram's samples to this one
+     */
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BucketCount; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() {
+        counts_.fill(0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    /**
+     * @brief Value at a percentile
+     * @param percentile 0 to 100 (e.g. 99.9)
+     * @return Upper bound of the bucket holding that sample, capped at the
+     *         largest recorded value, or 0 when empty
+     */
+    uint64_t percentile(double percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        double clamped = std::min(std::max(percentile, 0.0), 100.0);
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * count_ + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ > 0 ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ > 0 ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /**
+     * @brief Visit every non-empty bucket in value order
+     * @param visitor Callable taking (uint64_t upper_bound, uint64_t count)
+     */
+    template<typename Visitor>
+    void forEachBucket(Visitor&& visitor) const {
+        for (size_t i = 0; i < BucketCount; ++i) {
+            if (counts_[i] > 0) {
+                visitor(bucketUpperBound(i), counts_[i]);
+            }
+        }
+    }
+
+private:
+    friend class AtomicLatencyHistogram;
+
+    std::array<uint64_t, BucketCount> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+
+    static uint32_t highestBit(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<uint32_t>(index);
+#else
+        return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+    }
+};
+
+/**
+ * @brief LatencyHistogram that can be read while another thread records
+ *
+ * Counters are relaxed atomics. Meant to be written by one thread: the
+ * increments are then uncontended and stay in that thread's cache, and
+ * readers fold a copy into a plain LatencyHistogram when they need one. A
+ * copy taken mid-record may be one sample out between count and buckets.
+ */
+class AtomicLatencyHistogram {
+public:
+    void record(uint64_t value) {
+        counts_[LatencyHistogram::bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        // New extremes are rare once warmed up, so these rarely loop
+        uint64_t min = min_.load(std::memory_order_relaxed);
+        while (value < min && !min_.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+        }
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Add this histogram's samples to a plain one
+     */
+    void addTo(LatencyHistogram& histogram) const {
+        for (size_t i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            histogram.counts_[i] += counts_[i].load(std::memory_order_relaxed);
+        }
+        histogram.count_ += count_.load(std::memory_order_relaxed);
+        histogram.sum_ += sum_.load(std::memory_order_relaxed);
+        histogram.min_ = std::min(histogram.min_, min_.load(std::memory_order_relaxed));
+        histogram.max_ = std::max(histogram.max_, max_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Clear every counter (samples recorded meanwhile may survive in part)
+     */
+    void reset() {
+        for (auto& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<uint64_t>, LatencyHistogram::BucketCount> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_{0};
+};
+
+}
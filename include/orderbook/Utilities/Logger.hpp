@@ -1,10 +1,18 @@
 #pragma once
 #include "../Core/Types.hpp"
 #include "../Core/Interfaces.hpp"
+#include "RingBuffer.hpp"
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <initializer_list>
+#include <chrono>
+#include <vector>
 
 namespace orderbook {
 
@@ -12,6 +20,10 @@ class Config;
 
 /**
  * @brief Concrete implementation of structured logging
+ *
+ * In synchronous mode each call formats and writes on the calling thread. In
+ * async mode callers copy a fixed-size binary record into a per-thread SPSC
+ * ring and a background thread formats, writes, rotates and flushes in batches.
  */
 class Logger : public ILogger {
 public:
@@ -22,9 +34,14 @@ public:
         bool json_format = true;
         size_t max_file_size = 100 * 1024 * 1024; // 100MB
         size_t max_files = 5;
+        bool async = false;                    // Format and write on a background thread; context and
+                                               // message beyond ~200 bytes cost the caller a heap copy
+        size_t async_queue_size = 8192;        // Records per producer thread
+        size_t async_flush_interval_ms = 10;   // Drain thread idle wait
     };
     
-    explicit Logger(const LogConfig& config = LogConfig{});
+    Logger();
+    explicit Logger(const LogConfig& config);
     explicit Logger(std::shared_ptr<Config> config);
     ~Logger();
     
@@ -54,13 +71,79 @@ public:
     const LogConfig& getConfig() const;
     void loadConfiguration(std::shared_ptr<Config> config);
     static LogLevel parseLogLevel(const std::string& level_str);
+    
+    /**
+     * @brief Check whether the async backend is running
+     * @return true if records are queued for the drain thread
+     */
+    bool isAsync() const { return async_running_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Get number of async records dropped because a ring was full
+     * @return Dropped record count since construction
+     */
+    uint64_t getDroppedRecords() const { return dropped_records_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Block until every queued async record has been written
+     */
+    void flush();
 
 private:
+    // Selects how the drain thread renders a record's fields and arguments
+    enum class RecordFormat : uint8_t {
+        Text,           // fields: context, message
+        Performance,    // args: latency; fields: operation, key, value, ...
+        Throughput,     // args: count, duration; fields: operation
+        LatencyStats,   // args: min, max, avg; fields: operation
+        MemoryUsage     // args: used, allocated; fields: component
+    };
+    
+    /**
+     * @brief Fixed-size binary log record passed to the drain thread
+     * Fields are stored as 16-bit length-prefixed strings in text. Fields
+     * that do not fit go, encoded the same way, to a heap buffer the record
+     * owns until the drain thread renders it, so async lines match sync ones.
+     */
+    struct alignas(CacheLineSize) LogRecord {
+        static constexpr size_t TextCapacity = 208;
+        
+        int64_t timestamp_ns = 0;   // system_clock nanoseconds since epoch
+        uint64_t args[3] = {};
+        std::string* overflow = nullptr;    // All fields, when they exceed text
+        LogLevel level = LogLevel::INFO;
+        RecordFormat format = RecordFormat::Text;
+        bool truncated = false;
+        uint16_t text_size = 0;
+        char text[TextCapacity];
+    };
+    static_assert(sizeof(LogRecord) == 256, "LogRecord should stay four cache lines");
+    
+    struct ProducerRing {
+        explicit ProducerRing(size_t capacity) : ring(capacity) {}
+        ~ProducerRing();
+        SpscRing<LogRecord> ring;
+        std::atomic<bool> retired{false};   // Set when the producer thread exits
+    };
+    
     LogConfig config_;
     std::unique_ptr<std::ofstream> file_stream_;
     std::mutex log_mutex_;
     size_t current_file_size_;
     
+    // Async backend
+    const uint64_t instance_id_;
+    std::atomic<bool> async_running_{false};
+    std::atomic<uint64_t> dropped_records_{0};
+    std::atomic<uint64_t> drained_passes_{0};
+    std::thread drain_thread_;
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<ProducerRing>> rings_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    
+    static std::atomic<uint64_t> next_instance_id_;
+    
     static std::shared_ptr<Logger> global_logger_;
     static std::mutex global_mutex_;
     
@@ -68,12 +151,38 @@ private:
     void writeToFile(const std::string& formatted_message);
     void writeToConsole(const std::string& formatted_message);
     std::string formatMessage(LogLevel level, const std::string& message, 
-                             const std::string& context);
+                             const std::string& context,
+                             std::chrono::system_clock::time_point time);
     std::string formatJsonMessage(LogLevel level, const std::string& message, 
-                                 const std::string& context);
+                                 const std::string& context,
+                                 std::chrono::system_clock::time_point time);
+    std::string formatLine(LogLevel level, const std::string& message,
+                           const std::string& context,
+                           std::chrono::system_clock::time_point time);
     std::string logLevelToString(LogLevel level);
     void rotateLogFile();
     bool shouldLog(LogLevel level) const;
+    
+    // Message bodies shared by the synchronous and async paths
+    std::string renderPerformance(std::string_view operation, uint64_t latency_ns,
+                                  const std::vector<std::pair<std::string, std::string>>& metrics) const;
+    std::string renderThroughput(std::string_view operation, uint64_t count, uint64_t duration_ns) const;
+    std::string renderLatencyStats(std::string_view operation, uint64_t min_ns, uint64_t max_ns, uint64_t avg_ns) const;
+    std::string renderMemoryUsage(std::string_view component, size_t bytes_used, size_t bytes_allocated) const;
+    
+    // Async backend helpers
+    void startAsync();
+    void stopAsync();
+    void drainLoop();
+    ProducerRing* producerRing();
+    void enqueue(LogLevel level, RecordFormat format,
+                 std::initializer_list<uint64_t> args,
+                 std::initializer_list<std::string_view> fields,
+                 const std::vector<std::pair<std::string, std::string>>* metrics = nullptr);
+    static void appendField(LogRecord& record, std::string_view field);
+    static void appendField(std::string& overflow, std::string_view field);
+    void writeRecords(std::vector<LogRecord>& records);
+    std::string renderRecord(const LogRecord& record);
 };
 
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <limits>
 #include <cstddef>
+#include <cstdlib>
 #include <new>
 #include <type_traits>
+#include <utility>
+#include "MemoryArena.hpp"
 
 namespace orderbook {
 
@@ -190,31 +195,43 @@ thread_local std::vector<void*> StackSTLAllocator<T, StackSize>::heap_allocated_
 
 /**
  * @brief Memory pool allocator for fixed-size objects
- * Optimized for frequent allocation/deallocation of same-sized objects
+ * Optimized for frequent allocation/deallocation of same-sized objects.
+ * Blocks come from the heap, or from a MemoryArena when one is given
+ * (the arena must outlive the pool).
  */
 template<typename T, size_t BlockSize = 1024>
 class PoolAllocator {
 public:
     static constexpr size_t BLOCK_SIZE = BlockSize;
     static constexpr size_t OBJECTS_PER_BLOCK = BLOCK_SIZE / sizeof(T);
+    static_assert(OBJECTS_PER_BLOCK > 0, "BlockSize must hold at least one object");
+    static_assert(sizeof(T) >= sizeof(T*), "Pooled objects must be able to hold a free-list link");
     
     struct Block {
         alignas(T) char data[BLOCK_SIZE];
         Block* next = nullptr;
     };
     
-    PoolAllocator() {
+    explicit PoolAllocator(MemoryArena* arena = nullptr) : arena_(arena) {
         allocateNewBlock();
     }
     
     ~PoolAllocator() {
         while (blocks_) {
             Block* next = blocks_->next;
-            delete blocks_;
+            if (arena_) {
+                blocks_->~Block();      // Storage is released with the arena
+            } else {
+                delete blocks_;
+            }
             blocks_ = next;
         }
     }
     
+    // Non-copyable: blocks are owned exclusively
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+    
     T* allocate() {
         if (!free_list_) {
             allocateNewBlock();
@@ -222,6 +239,7 @@ public:
         
         T* result = free_list_;
         free_list_ = *reinterpret_cast<T**>(free_list_);
+        ++in_use_;
         return result;
     }
     
@@ -230,6 +248,49 @@ public:
         
         *reinterpret_cast<T**>(ptr) = free_list_;
         free_list_ = ptr;
+        --in_use_;
+    }
+    
+    /**
+     * @brief Pre-allocate blocks so that at least count objects fit without growing
+     * @param count Number of objects to reserve capacity for
+     */
+    void reserve(size_t count) {
+        while (capacity_ < count) {
+            allocateNewBlock();
+        }
+    }
+    
+    /**
+     * @brief Get number of objects currently handed out
+     * @return Live object count
+     */
+    size_t in_use() const { return in_use_; }
+    
+    /**
+     * @brief Get number of objects the allocated blocks can hold
+     * @return Total capacity
+     */
+    size_t capacity() const { return capacity_; }
+    
+    /**
+     * @brief Allocate and construct an object in place
+     * @param args Constructor arguments
+     * @return Pointer to the constructed object
+     */
+    template<typename... Args>
+    T* construct(Args&&... args) {
+        return new (allocate()) T(std::forward<Args>(args)...);
+    }
+    
+    /**
+     * @brief Destroy an object and return its slot to the pool
+     * @param ptr Object previously returned by construct()
+     */
+    void destroy(T* ptr) {
+        if (!ptr) return;
+        ptr->~T();
+        deallocate(ptr);
     }
     
     /**
@@ -239,26 +300,30 @@ public:
         size_t blocks_allocated;
         size_t objects_per_block;
         size_t total_capacity;
+        size_t objects_in_use;
     };
     
     Stats getStats() const {
-        size_t block_count = 0;
-        Block* current = blocks_;
-        while (current) {
-            ++block_count;
-            current = current->next;
-        }
-        
         return {
-            block_count,
+            capacity_ / OBJECTS_PER_BLOCK,
             OBJECTS_PER_BLOCK,
-            block_count * OBJECTS_PER_BLOCK
+            capacity_,
+            in_use_
         };
     }
     
 private:
     void allocateNewBlock() {
-        Block* new_block = new Block();
+        Block* new_block = nullptr;
+        if (arena_) {
+            void* storage = arena_->allocate(sizeof(Block), alignof(Block));
+            if (!storage) {
+                throw std::bad_alloc();
+            }
+            new_block = new (storage) Block();
+        } else {
+            new_block = new Block();
+        }
         new_block->next = blocks_;
         blocks_ = new_block;
         
@@ -271,10 +336,14 @@ private:
             *reinterpret_cast<T**>(obj) = free_list_;
             free_list_ = obj;
         }
+        capacity_ += OBJECTS_PER_BLOCK;
     }
     
+    MemoryArena* arena_ = nullptr;
     Block* blocks_ = nullptr;
     T* free_list_ = nullptr;
+    size_t capacity_ = 0;
+    size_t in_use_ = 0;
 };
 
 /**
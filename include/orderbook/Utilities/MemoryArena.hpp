@@ -0,0 +1,230 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+class Config;
+
+/**
+ * @brief Bump arena over large mappings, optionally huge-page backed and NUMA bound
+ *
+ * Memory is mapped in chunks, bound to a NUMA node before it is first
+ * touched, and pre-faulted so the owning thread never takes a page fault on
+ * it later. Explicit huge pages (MAP_HUGETLB) fall back to transparent huge
+ * pages, and those to ordinary pages, when the kernel cannot provide them.
+ *
+ * Allocations live until the arena is destroyed; deallocate() only keeps a
+ * block for reuse by a later request of exactly the same size (e.g. a
+ * ladder re-centred at the same width). An arena is owned by one thread at
+ * a time and is not synchronized.
+ */
+class MemoryArena {
+public:
+    /**
+     * @brief Page backing requested for the arena's chunks
+     */
+    enum class PageMode {
+        Normal,         // Ordinary pages
+        Transparent,    // 2MB-aligned chunks advised for transparent huge pages
+        Huge2MB,        // Explicit 2MB huge pages from the hugetlb pool
+        Huge1GB         // Explicit 1GB huge pages from the hugetlb pool
+    };
+
+    /**
+     * @brief Arena settings
+     */
+    struct ArenaConfig {
+        bool enabled = false;           // Off: callers allocate the ordinary way
+        PageMode pages = PageMode::Transparent;
+        int numa_node = -1;             // Node to bind chunks to (-1 = first-touch placement)
+        size_t chunk_bytes = 2 * 1024 * 1024;   // Minimum mapping size (rounded up to the page size)
+        bool prefault = true;           // Touch every page when a chunk is mapped
+    };
+
+    /**
+     * @brief Mapping totals over every arena in the process
+     */
+    struct GlobalStats {
+        std::atomic<uint64_t> mapped_bytes{0};
+        std::atomic<uint64_t> explicit_huge_bytes{0};   // Backed by MAP_HUGETLB
+        std::atomic<uint64_t> transparent_bytes{0};     // Advised for transparent huge pages
+        std::atomic<uint64_t> fallbacks{0};             // Chunks that got a weaker backing than requested
+        std::atomic<uint64_t> numa_bind_failures{0};
+    };
+
+    explicit MemoryArena(const ArenaConfig& config);
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /**
+     * @brief Allocate from the current chunk, mapping a new one when it is full
+     * @param bytes Size of the block
+     * @param alignment Power-of-two alignment (at most the page size)
+     * @return Block, or nullptr if no memory could be mapped
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Keep a block for reuse by a later allocation of the same size
+     */
+    void deallocate(void* ptr, size_t bytes);
+
+    /**
+     * @brief Backing of the most recently mapped chunk
+     */
+    PageMode getBacking() const { return backing_; }
+    const ArenaConfig& getConfig() const { return config_; }
+    size_t getMappedBytes() const { return mapped_bytes_; }
+    size_t getUsedBytes() const { return used_bytes_; }
+
+    static const GlobalStats& getGlobalStats() { return global_stats_; }
+
+    /**
+     * @brief NUMA node a CPU belongs to
+     * @return Node index, or -1 if unknown
+     */
+    static int nodeOfCpu(int cpu);
+
+    /**
+     * @brief NUMA node of the CPU the calling thread is running on
+     * @return Node index, or -1 if unknown
+     */
+    static int currentNode();
+
+    static PageMode parsePageMode(const std::string& name);
+    static const char* pageModeName(PageMode mode);
+
+    /**
+     * @brief Read arena settings from the [memory] section
+     * @param config Configuration object
+     * @return Settings (defaults when config is null)
+     */
+    static ArenaConfig loadConfiguration(std::shared_ptr<Config> config);
+
+private:
+    struct Chunk {
+        void* base;
+        size_t bytes;
+        bool mapped;            // From mmap (else from aligned_alloc)
+    };
+
+    struct FreeBlock {
+        void* ptr;
+        size_t bytes;
+    };
+
+    ArenaConfig config_;
+    PageMode backing_;
+    std::vector<Chunk> chunks_;
+    std::vector<FreeBlock> free_blocks_;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    size_t used_bytes_ = 0;
+
+    static GlobalStats global_stats_;
+
+    bool mapChunk(size_t min_bytes);
+};
+
+/**
+ * @brief Standard allocator drawing from a MemoryArena (or the heap when null)
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(MemoryArena* arena = nullptr) noexcept : arena_(arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t count) {
+        if (!arena_) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        void* ptr = arena_->allocate(count * sizeof(T), alignof(T));
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        if (!arena_) {
+            ::operator delete(ptr);
+            return;
+        }
+        arena_->deallocate(ptr, count * sizeof(T));
+    }
+
+    MemoryArena* arena() const noexcept { return arena_; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena_ != other.arena(); }
+
+private:
+    MemoryArena* arena_;
+};
+
+/**
+ * @brief Deleter for arrays made by makeArenaArray()
+ */
+template<typename T>
+struct ArenaArrayDeleter {
+    size_t count = 0;
+    bool from_arena = false;
+
+    void operator()(T* ptr) const {
+        if (!from_arena) {
+            delete[] ptr;
+            return;
+        }
+        // The arena owns the storage; only the elements are torn down
+        for (size_t i = 0; i < count; ++i) {
+            ptr[i].~T();
+        }
+    }
+};
+
+template<typename T>
+using ArenaArray = std::unique_ptr<T[], ArenaArrayDeleter<T>>;
+
+/**
+ * @brief Value-initialized array in an arena, or on the heap when arena is null
+ * @param arena Arena that must outlive the array (nullptr = heap)
+ * @param count Number of elements
+ */
+template<typename T>
+ArenaArray<T> makeArenaArray(MemoryArena* arena, size_t count) {
+    if (!arena) {
+        return ArenaArray<T>(new T[count](), ArenaArrayDeleter<T>{count, false});
+    }
+    void* storage = arena->allocate(count * sizeof(T), alignof(T));
+    if (!storage) {
+        throw std::bad_alloc();
+    }
+    T* elements = static_cast<T*>(storage);
+    for (size_t i = 0; i < count; ++i) {
+        new (elements + i) T();
+    }
+    return ArenaArray<T>(elements, ArenaArrayDeleter<T>{count, true});
+}
+
+}
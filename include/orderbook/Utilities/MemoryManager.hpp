@@ -1,6 +1,7 @@
 #pragma once
 #include "ObjectPool.hpp"
 #include "MemoryAllocators.hpp"
+#include "Metrics.hpp"
 #include "../Core/Order.hpp"
 #include <memory>
 #include <atomic>
@@ -19,8 +20,8 @@ public:
      */
     struct MemoryStats {
         // Object pool statistics
-        ObjectPool<Order>::Stats order_pool;
-        ObjectPool<Trade>::Stats trade_pool;
+        ObjectPoolStats order_pool;
+        ObjectPoolStats trade_pool;
         
         // Allocator statistics
         size_t stack_allocations = 0;
@@ -48,7 +49,7 @@ public:
      * @brief Acquire an order from the pool
      * @return RAII wrapper for pooled order
      */
-    ObjectPool<Order>::PooledObject acquireOrder() {
+    ObjectPools::OrderPool::PooledObject acquireOrder() {
         auto start = std::chrono::high_resolution_clock::now();
         auto result = ObjectPools::getOrderPool().acquire();
         auto end = std::chrono::high_resolution_clock::now();
@@ -61,7 +62,7 @@ public:
      * @brief Acquire a trade from the pool
      * @return RAII wrapper for pooled trade
      */
-    ObjectPool<Trade>::PooledObject acquireTrade() {
+    ObjectPools::TradePool::PooledObject acquireTrade() {
         auto start = std::chrono::high_resolution_clock::now();
         auto result = ObjectPools::getTradePool().acquire();
         auto end = std::chrono::high_resolution_clock::now();
@@ -130,7 +131,7 @@ public:
      */
     void prewarmPools() {
         // Pre-allocate orders
-        std::vector<ObjectPool<Order>::PooledObject> orders;
+        std::vector<ObjectPools::OrderPool::PooledObject> orders;
         orders.reserve(1000);
         for (int i = 0; i < 1000; ++i) {
             orders.push_back(acquireOrder());
@@ -138,7 +139,7 @@ public:
         orders.clear(); // Return all to pool
         
         // Pre-allocate trades
-        std::vector<ObjectPool<Trade>::PooledObject> trades;
+        std::vector<ObjectPools::TradePool::PooledObject> trades;
         trades.reserve(500);
         for (int i = 0; i < 500; ++i) {
             trades.push_back(acquireTrade());
@@ -181,6 +182,45 @@ public:
         return stats;
     }
     
+    /**
+     * @brief Add pool occupancy, aligned allocation and arena usage to a scrape (any thread)
+     *
+     * Pool counters are atomics, except that walking the thread caches takes
+     * the pool mutex that only pool growth and cache registration contend on.
+     * @param out Scrape being built
+     */
+    void exportMetrics(MetricsWriter& out) const {
+        MemoryStats stats = getStats();
+        auto pool = [&out](const char* name, const ObjectPoolStats& pool_stats) {
+            out.gauge("pool_objects", "Objects owned by a global object pool",
+                      static_cast<double>(pool_stats.pool_size), {{"pool", name}});
+            out.gauge("pool_available", "Pooled objects not currently acquired",
+                      static_cast<double>(pool_stats.available), {{"pool", name}});
+            out.counter("pool_grown_total", "Objects created after the initial pre-allocation",
+                        static_cast<double>(pool_stats.total_created), {{"pool", name}});
+        };
+        pool("order", stats.order_pool);
+        pool("trade", stats.trade_pool);
+        out.gauge("aligned_memory_bytes", "Bytes held in SIMD-aligned allocations",
+                  static_cast<double>(stats.total_memory_used));
+        out.gauge("aligned_memory_peak_bytes", "Peak bytes held in SIMD-aligned allocations",
+                  static_cast<double>(stats.peak_memory_used));
+        out.counter("aligned_allocations_total", "SIMD-aligned allocations made",
+                    static_cast<double>(stats.aligned_allocations));
+        
+        const MemoryArena::GlobalStats& arenas = MemoryArena::getGlobalStats();
+        out.gauge("arena_mapped_bytes", "Bytes mapped by book and ring arenas",
+                  static_cast<double>(arenas.mapped_bytes.load(std::memory_order_relaxed)));
+        out.counter("arena_huge_page_bytes_total", "Arena bytes mapped from the hugetlb pool",
+                    static_cast<double>(arenas.explicit_huge_bytes.load(std::memory_order_relaxed)));
+        out.counter("arena_transparent_bytes_total", "Arena bytes advised for transparent huge pages",
+                    static_cast<double>(arenas.transparent_bytes.load(std::memory_order_relaxed)));
+        out.counter("arena_page_fallbacks_total", "Arena chunks mapped with weaker pages than configured",
+                    static_cast<double>(arenas.fallbacks.load(std::memory_order_relaxed)));
+        out.counter("arena_numa_bind_failures_total", "Arena chunks that could not be bound to their node",
+                    static_cast<double>(arenas.numa_bind_failures.load(std::memory_order_relaxed)));
+    }
+    
     /**
      * @brief Reset statistics
      */
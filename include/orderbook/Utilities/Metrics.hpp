@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Builds a scrape in the Prometheus text exposition format (0.0.4)
+ *
+ * Samples may be added in any order; each metric family's HELP and TYPE
+ * lines are written once and its samples are grouped under them, so a
+ * collector can walk books or shards and emit several families per item.
+ */
+class MetricsWriter {
+public:
+    using Label = std::pair<std::string_view, std::string_view>;
+    using Labels = std::initializer_list<Label>;
+
+    /**
+     * @brief Add a sample of a monotonically increasing counter
+     * @param name Family name (without the "orderbook_" prefix)
+     * @param help One-line description, used the first time the family appears
+     * @param value Current value
+     * @param labels Label names and values identifying this sample
+     */
+    void counter(std::string_view name, std::string_view help, double value, Labels labels = {}) {
+        sample("counter", name, help, value, labels);
+    }
+
+    /**
+     * @brief Add a sample of a value that can go up and down
+     */
+    void gauge(std::string_view name, std::string_view help, double value, Labels labels = {}) {
+        sample("gauge", name, help, value, labels);
+    }
+
+    /**
+     * @brief Scrape text with every family added so far
+     */
+    std::string str() const;
+
+    void clear();
+
+    static constexpr std::string_view Prefix = "orderbook_";
+
+private:
+    struct Family {
+        std::string name;
+        std::string header;     // HELP and TYPE lines
+        std::string samples;
+    };
+
+    std::vector<Family> families_;                      // In first-seen order
+    std::unordered_map<std::string, size_t> index_;
+
+    void sample(std::string_view type, std::string_view name, std::string_view help,
+                double value, Labels labels);
+};
+
+/**
+ * @brief Set of metric collectors rendered together on each scrape
+ *
+ * Collectors run on the scraping thread. They must only read values their
+ * owners publish for other threads (relaxed atomics or other lock-free
+ * snapshots), so that a scrape never stalls a matching or IO thread.
+ */
+class MetricsRegistry {
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+
+    /**
+     * @brief Add a collector; called for every later scrape
+     */
+    void addCollector(Collector collector);
+
+    /**
+     * @brief Run every collector and render the result
+     * @return Prometheus text exposition
+     */
+    std::string scrape();
+
+    size_t getCollectorCount() const;
+
+private:
+    mutable std::mutex mutex_;      // Guards collectors_ and serializes scrapes
+    std::vector<Collector> collectors_;
+};
+
+}
@@ -1,12 +1,44 @@
 #pragma once
+#include "../Core/Order.hpp"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace orderbook {
 
+/**
+ * @brief Object pool statistics, shared by all pool variants
+ */
+struct ObjectPoolStats {
+    size_t available;       // Objects ready to be acquired
+    size_t total_created;   // Objects created after construction because the pool ran dry
+    size_t pool_size;       // Objects held by the pool
+};
+
+namespace detail {
+
+template<typename T, typename = void>
+struct HasReset : std::false_type {};
+
+template<typename T>
+struct HasReset<T, std::void_t<decltype(std::declval<T&>().reset())>> : std::true_type {};
+
+// Call T::reset() on a reused object, if T has one
+template<typename T>
+void resetPooledObject(T& object) {
+    if constexpr (HasReset<T>::value) {
+        object.reset();
+    }
+}
+
+}
+
 /**
  * @brief Thread-safe object pool for high-performance object reuse
  * Reduces memory allocation overhead by reusing objects
@@ -100,9 +132,7 @@ public:
         T* raw_ptr = obj.release();
         
         // Reset object if it has a reset method
-        if constexpr (requires(T t) { t.reset(); }) {
-            raw_ptr->reset();
-        }
+        detail::resetPooledObject(*raw_ptr);
         
         return PooledObject(raw_ptr, this);
     }
@@ -110,11 +140,7 @@ public:
     /**
      * @brief Get pool statistics
      */
-    struct Stats {
-        size_t available;
-        size_t total_created;
-        size_t pool_size;
-    };
+    using Stats = ObjectPoolStats;
     
     Stats getStats() const {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -152,18 +178,367 @@ private:
     size_t total_created_{0};
 };
 
+/**
+ * @brief Object pool with per-thread caches over a lock-free shared free list
+ *
+ * Each thread keeps up to CacheSize free objects of its own, so most
+ * acquires and returns touch no shared state at all. An empty cache takes
+ * half a cache's worth of objects from the shared list in one CAS, and a
+ * full one hands half back the same way. The shared list is a Treiber stack
+ * of node indices whose head carries a 32-bit tag bumped on every change,
+ * which rules out ABA. Objects acquired on one thread may be returned on
+ * another, so orders, trades and buffers can move between network and
+ * matching threads.
+ *
+ * Objects are created in chunks and live as long as the pool; only growth
+ * takes a mutex. Each thread caches objects for one pool of a given type at
+ * a time: using a second pool of the same type hands the cache back to the
+ * first. A thread's cache is handed back when it exits, and cached objects
+ * keep the pool's storage alive until then. As with ObjectPool, every
+ * PooledObject must be destroyed before its pool.
+ */
+template<typename T, size_t CacheSize = 32>
+class LockFreeObjectPool {
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    static_assert(CacheSize >= 2, "Thread cache must hold at least two objects");
+
+    struct Node {
+        T object;
+        std::atomic<uint32_t> next{0};
+        uint32_t index = 0;
+    };
+    struct Shared;
+
+public:
+    /**
+     * @brief RAII wrapper for pooled objects
+     * Automatically returns object to pool when destroyed
+     */
+    class PooledObject {
+    public:
+        PooledObject(Node* node, LockFreeObjectPool* pool) : node_(node), pool_(pool) {}
+        
+        ~PooledObject() {
+            if (node_ && pool_) {
+                pool_->returnObject(node_);
+            }
+        }
+        
+        // Move semantics only
+        PooledObject(PooledObject&& other) noexcept 
+            : node_(other.node_), pool_(other.pool_) {
+            other.node_ = nullptr;
+            other.pool_ = nullptr;
+        }
+        
+        PooledObject& operator=(PooledObject&& other) noexcept {
+            if (this != &other) {
+                if (node_ && pool_) {
+                    pool_->returnObject(node_);
+                }
+                node_ = other.node_;
+                pool_ = other.pool_;
+                other.node_ = nullptr;
+                other.pool_ = nullptr;
+            }
+            return *this;
+        }
+        
+        // Delete copy operations
+        PooledObject(const PooledObject&) = delete;
+        PooledObject& operator=(const PooledObject&) = delete;
+        
+        T* get() const { return node_ ? &node_->object : nullptr; }
+        T& operator*() const { return node_->object; }
+        T* operator->() const { return &node_->object; }
+        
+        explicit operator bool() const { return node_ != nullptr; }
+        
+    private:
+        Node* node_;
+        LockFreeObjectPool* pool_;
+    };
+    
+    using Stats = ObjectPoolStats;
+    
+    /**
+     * @brief Constructor with initial pool size
+     * @param initial_size Number of objects to pre-allocate
+     */
+    explicit LockFreeObjectPool(size_t initial_size = 1000) : shared_(std::make_shared<Shared>()) {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (initial_size > 0) {
+            shared_->grow(initial_size, nullptr, 0);
+        }
+    }
+    
+    ~LockFreeObjectPool() {
+        // Other threads' caches release the storage when they exit or switch pools
+        ThreadCache& cache = threadCache();
+        if (cache.shared == shared_) {
+            cache.detach();
+        }
+    }
+    
+    LockFreeObjectPool(const LockFreeObjectPool&) = delete;
+    LockFreeObjectPool& operator=(const LockFreeObjectPool&) = delete;
+    
+    /**
+     * @brief Get an object from the pool
+     * @return RAII wrapper containing the object
+     */
+    PooledObject acquire() {
+        ThreadCache& cache = attachedCache();
+        
+        uint32_t count = cache.count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            count = refill(cache);
+        }
+        
+        Node* node = cache.items[--count];
+        cache.count.store(count, std::memory_order_relaxed);
+        
+        detail::resetPooledObject(node->object);
+        return PooledObject(node, this);
+    }
+    
+    /**
+     * @brief Get pool statistics
+     *
+     * available counts the shared free list and every thread cache.
+     */
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        size_t available = shared_->free_count.load(std::memory_order_relaxed);
+        for (const ThreadCache* cache : shared_->caches) {
+            available += cache->count.load(std::memory_order_relaxed);
+        }
+        return {
+            available,
+            shared_->total_created,
+            shared_->node_count.load(std::memory_order_relaxed)
+        };
+    }
+    
+private:
+    static constexpr uint32_t NullIndex = UINT32_MAX;
+    static constexpr uint32_t ChunkShift = 8;
+    static constexpr uint32_t ChunkSize = 1u << ChunkShift;
+    static constexpr uint32_t MaxChunks = 1u << 16;     // Up to 16M objects per pool
+    static constexpr size_t TransferBatch = CacheSize / 2;
+    
+    struct ThreadCache;
+    
+    // Object storage and the shared free list; outlives the pool while thread caches hold it
+    struct Shared {
+        std::unique_ptr<std::atomic<Node*>[]> chunks{new std::atomic<Node*>[MaxChunks]()};
+        std::atomic<uint64_t> head{pack(NullIndex, 0)};    // Tag in the high half, index in the low
+        std::atomic<size_t> free_count{0};
+        std::atomic<size_t> node_count{0};
+        
+        // Guards growth, total_created and cache registration
+        std::mutex mutex;
+        size_t total_created = 0;
+        std::vector<ThreadCache*> caches;
+        
+        ~Shared() {
+            for (uint32_t chunk = 0; chunk < MaxChunks; ++chunk) {
+                delete[] chunks[chunk].load(std::memory_order_relaxed);
+            }
+        }
+        
+        Node* nodeAt(uint32_t index) const {
+            Node* chunk = chunks[index >> ChunkShift].load(std::memory_order_acquire);
+            return chunk ? chunk + (index & (ChunkSize - 1)) : nullptr;
+        }
+        
+        // Push nodes already linked first..last through next
+        void pushChain(Node* first, Node* last, size_t count) {
+            uint64_t current = head.load(std::memory_order_relaxed);
+            do {
+                last->next.store(indexOf(current), std::memory_order_relaxed);
+            } while (!head.compare_exchange_weak(current, pack(first->index, tagOf(current) + 1),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+            free_count.fetch_add(count, std::memory_order_relaxed);
+        }
+        
+        // Pop up to max nodes in one CAS; nodes are never freed, so walking a stale chain is safe
+        size_t popBatch(Node** out, size_t max) {
+            uint64_t current = head.load(std::memory_order_acquire);
+            for (;;) {
+                uint32_t index = indexOf(current);
+                size_t popped = 0;
+                while (popped < max && index != NullIndex) {
+                    Node* node = nodeAt(index);
+                    if (!node) break;   // Stale index; the CAS below fails
+                    out[popped++] = node;
+                    index = node->next.load(std::memory_order_relaxed);
+                }
+                if (popped == 0) {
+                    return 0;
+                }
+                if (head.compare_exchange_weak(current, pack(index, tagOf(current) + 1),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+                    free_count.fetch_sub(popped, std::memory_order_relaxed);
+                    return popped;
+                }
+            }
+        }
+        
+        /**
+         * @brief Create at least count objects (mutex held)
+         *
+         * The first take objects go to out; the rest join the free list.
+         */
+        void grow(size_t count, Node** out, size_t take) {
+            size_t created = 0;
+            size_t pushed = 0;
+            Node* first = nullptr;
+            Node* last = nullptr;
+            
+            while (created < count) {
+                size_t base = node_count.load(std::memory_order_relaxed);
+                if (base / ChunkSize >= MaxChunks) {
+                    throw std::bad_alloc();
+                }
+                
+                Node* chunk = new Node[ChunkSize];
+                for (uint32_t i = 0; i < ChunkSize; ++i) {
+                    Node& node = chunk[i];
+                    node.index = static_cast<uint32_t>(base + i);
+                    if (take > 0) {
+                        out[--take] = &node;
+                    } else {
+                        if (last) {
+                            last->next.store(node.index, std::memory_order_relaxed);
+                        } else {
+                            first = &node;
+                        }
+                        last = &node;
+                        ++pushed;
+                    }
+                }
+                chunks[base / ChunkSize].store(chunk, std::memory_order_release);
+                node_count.store(base + ChunkSize, std::memory_order_relaxed);
+                created += ChunkSize;
+            }
+            
+            if (first) {
+                pushChain(first, last, pushed);
+            }
+        }
+        
+        static uint64_t pack(uint32_t index, uint32_t tag) {
+            return (static_cast<uint64_t>(tag) << 32) | index;
+        }
+        static uint32_t indexOf(uint64_t value) { return static_cast<uint32_t>(value); }
+        static uint32_t tagOf(uint64_t value) { return static_cast<uint32_t>(value >> 32); }
+    };
+    
+    // Free objects one thread holds for one pool
+    struct ThreadCache {
+        std::shared_ptr<Shared> shared;
+        Node* items[CacheSize];
+        std::atomic<uint32_t> count{0};     // Written by the owning thread only
+        
+        ~ThreadCache() { detach(); }
+        
+        void attach(const std::shared_ptr<Shared>& pool) {
+            std::lock_guard<std::mutex> lock(pool->mutex);
+            pool->caches.push_back(this);
+            shared = pool;
+        }
+        
+        // Hand every cached object back and unregister
+        void detach() {
+            if (!shared) return;
+            giveBack(count.load(std::memory_order_relaxed));
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                auto& caches = shared->caches;
+                caches.erase(std::find(caches.begin(), caches.end(), this));
+            }
+            shared.reset();
+        }
+        
+        // Push the n oldest cached objects to the shared list
+        void giveBack(uint32_t n) {
+            if (n == 0) return;
+            for (uint32_t i = 0; i + 1 < n; ++i) {
+                items[i]->next.store(items[i + 1]->index, std::memory_order_relaxed);
+            }
+            shared->pushChain(items[0], items[n - 1], n);
+            
+            uint32_t remaining = count.load(std::memory_order_relaxed) - n;
+            std::copy(items + n, items + n + remaining, items);
+            count.store(remaining, std::memory_order_relaxed);
+        }
+    };
+    
+    std::shared_ptr<Shared> shared_;
+    
+    static ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+    
+    ThreadCache& attachedCache() {
+        ThreadCache& cache = threadCache();
+        if (cache.shared != shared_) {
+            cache.detach();
+            cache.attach(shared_);
+        }
+        return cache;
+    }
+    
+    // Fill an empty cache from the shared list, growing the pool if it is empty
+    uint32_t refill(ThreadCache& cache) {
+        size_t taken = shared_->popBatch(cache.items, TransferBatch);
+        if (taken == 0) {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            taken = shared_->popBatch(cache.items, TransferBatch);
+            if (taken == 0) {
+                shared_->grow(ChunkSize, cache.items, TransferBatch);
+                shared_->total_created += ChunkSize;
+                taken = TransferBatch;
+            }
+        }
+        return static_cast<uint32_t>(taken);
+    }
+    
+    /**
+     * @brief Return object to pool (called by PooledObject destructor)
+     * @param node Node holding the object
+     */
+    void returnObject(Node* node) {
+        ThreadCache& cache = attachedCache();
+        if (cache.count.load(std::memory_order_relaxed) == CacheSize) {
+            cache.giveBack(TransferBatch);
+        }
+        uint32_t count = cache.count.load(std::memory_order_relaxed);
+        cache.items[count] = node;
+        cache.count.store(count + 1, std::memory_order_relaxed);
+    }
+};
+
 /**
  * @brief Global object pools for common types
+ *
+ * Lock-free, so pooled orders and trades can be shared between network
+ * and matching threads.
  */
 class ObjectPools {
 public:
-    static ObjectPool<Order>& getOrderPool() {
-        static ObjectPool<Order> pool(2000); // Pre-allocate 2000 orders
+    using OrderPool = LockFreeObjectPool<Order>;
+    using TradePool = LockFreeObjectPool<Trade>;
+    
+    static OrderPool& getOrderPool() {
+        static OrderPool pool(2000); // Pre-allocate 2000 orders
         return pool;
     }
     
-    static ObjectPool<Trade>& getTradePool() {
-        static ObjectPool<Trade> pool(1000); // Pre-allocate 1000 trades
+    static TradePool& getTradePool() {
+        static TradePool pool(1000); // Pre-allocate 1000 trades
         return pool;
     }
     
@@ -171,8 +546,8 @@ public:
      * @brief Get statistics for all pools
      */
     struct AllStats {
-        ObjectPool<Order>::Stats order_pool;
-        ObjectPool<Trade>::Stats trade_pool;
+        ObjectPoolStats order_pool;
+        ObjectPoolStats trade_pool;
     };
     
     static AllStats getAllStats() {
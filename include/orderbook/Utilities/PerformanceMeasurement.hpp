@@ -1,7 +1,11 @@
 #pragma once
+#include "LatencyHistogram.hpp"
+#include "TscClock.hpp"
 #include <chrono>
 #include <vector>
+#include <array>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <string>
@@ -14,12 +18,25 @@ namespace orderbook {
 /**
  * @brief High-precision performance measurement utilities
  * Provides latency and throughput measurement with minimal overhead
+ *
+ * Each measured call site registers its operation name once and gets a
+ * small integer ID. Samples go into per-thread log-linear histograms
+ * indexed by that ID, with relaxed atomic increments on counters no other
+ * thread writes, so recording takes no lock, does no lookup and allocates
+ * only on a thread's first sample for a site. The per-thread histograms are
+ * merged only when statistics are read. Percentiles are exact to the
+ * histogram resolution (about 1.6%) over every sample since the last reset.
+ * Scoped timers read the TSC directly (see TscClock), so a measurement
+ * costs two counter reads rather than two clock_gettime calls.
  */
 class PerformanceMeasurement {
 public:
-    using Clock = std::chrono::high_resolution_clock;
+    using Clock = TscClock;
     using TimePoint = Clock::time_point;
     using Duration = std::chrono::nanoseconds;
+    using SiteId = uint32_t;
+
+    static constexpr SiteId MaxSites = 128;
     
     /**
      * @brief Performance statistics for an operation
@@ -31,8 +48,10 @@ public:
         Duration max_latency{Duration::zero()};
         Duration avg_latency{Duration::zero()};
         Duration p50_latency{Duration::zero()};
+        Duration p90_latency{Duration::zero()};
         Duration p95_latency{Duration::zero()};
         Duration p99_latency{Duration::zero()};
+        Duration p999_latency{Duration::zero()};
         Duration total_time{Duration::zero()};
         double throughput_ops_per_sec = 0.0;
         
@@ -46,13 +65,15 @@ public:
      */
     class ScopedTimer {
     public:
+        ScopedTimer(SiteId site, PerformanceMeasurement& perf)
+            : site_(site), perf_(perf), start_ticks_(Clock::ticks()) {}
+        
+        // Ad-hoc timing by name; registers (or looks up) the site under a lock
         ScopedTimer(const std::string& operation_name, PerformanceMeasurement& perf)
-            : operation_name_(operation_name), perf_(perf), start_time_(Clock::now()) {}
+            : ScopedTimer(perf.registerSite(operation_name), perf) {}
         
         ~ScopedTimer() {
-            auto end_time = Clock::now();
-            auto duration = std::chrono::duration_cast<Duration>(end_time - start_time_);
-            perf_.recordLatency(operation_name_, duration);
+            perf_.recordLatency(site_, Duration(Clock::toNanoseconds(Clock::ticks() - start_ticks_)));
         }
         
         // Non-copyable, non-movable
@@ -62,9 +83,9 @@ public:
         ScopedTimer& operator=(ScopedTimer&&) = delete;
         
     private:
-        std::string operation_name_;
+        SiteId site_;
         PerformanceMeasurement& perf_;
-        TimePoint start_time_;
+        uint64_t start_ticks_;
     };
     
     /**
@@ -106,6 +127,30 @@ public:
         return instance;
     }
     
+    /**
+     * @brief Get the ID of an operation, registering it on first use
+     *
+     * Call once per call site (PERF_MEASURE keeps the ID in a static);
+     * every site naming the same operation shares its histograms.
+     * @param operation_name Name of the operation
+     * @return Site ID (sites past MaxSites share the last ID)
+     */
+    SiteId registerSite(const std::string& operation_name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = site_ids_.find(operation_name);
+        if (it != site_ids_.end()) {
+            return it->second;
+        }
+        if (site_names_.size() == MaxSites) {
+            return MaxSites - 1;
+        }
+        SiteId site = static_cast<SiteId>(site_names_.size());
+        site_names_.push_back(operation_name);
+        site_ids_.emplace(operation_name, site);
+        site_since_[site] = Clock::now();
+        return site;
+    }
+    
     /**
      * @brief Create a scoped timer for an operation
      * @param operation_name Name of the operation being measured
@@ -116,24 +161,37 @@ public:
     }
     
     /**
-     * @brief Record latency for an operation
+     * @brief Record latency for a registered site (lock-free)
+     * @param site ID from registerSite()
+     * @param latency Measured latency
+     */
+    void recordLatency(SiteId site, Duration latency) {
+        AtomicLatencyHistogram* histogram = localHistogram(site);
+        histogram->record(static_cast<uint64_t>(std::max<Duration::rep>(latency.count(), 0)));
+    }
+    
+    /**
+     * @brief Record latency for an operation by name
      * @param operation_name Name of the operation
      * @param latency Measured latency
      */
     void recordLatency(const std::string& operation_name, Duration latency) {
+        recordLatency(registerSite(operation_name), latency);
+    }
+    
+    /**
+     * @brief Merge every thread's samples for an operation
+     * @param operation_name Name of the operation
+     * @return Histogram of latencies in nanoseconds (empty if never measured)
+     */
+    LatencyHistogram getHistogram(const std::string& operation_name) const {
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto& samples = latency_samples_[operation_name];
-        samples.push_back(latency);
-        
-        // Limit sample size to prevent unbounded growth
-        constexpr size_t MAX_SAMPLES = 10000;
-        if (samples.size() > MAX_SAMPLES) {
-            samples.erase(samples.begin(), samples.begin() + (samples.size() - MAX_SAMPLES));
+        LatencyHistogram histogram;
+        auto it = site_ids_.find(operation_name);
+        if (it != site_ids_.end()) {
+            mergeSite(it->second, histogram);
         }
-        
-        // Update throughput
-        throughput_measurements_[operation_name].recordOperation();
+        return histogram;
     }
     
     /**
@@ -144,37 +202,11 @@ public:
     OperationStats getOperationStats(const std::string& operation_name) const {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        auto it = latency_samples_.find(operation_name);
-        if (it == latency_samples_.end() || it->second.empty()) {
+        auto it = site_ids_.find(operation_name);
+        if (it == site_ids_.end()) {
             return OperationStats{operation_name, 0};
         }
-        
-        const auto& samples = it->second;
-        OperationStats stats;
-        stats.operation_name = operation_name;
-        stats.sample_count = samples.size();
-        
-        // Calculate basic statistics
-        stats.min_latency = *std::min_element(samples.begin(), samples.end());
-        stats.max_latency = *std::max_element(samples.begin(), samples.end());
-        stats.total_time = std::accumulate(samples.begin(), samples.end(), Duration::zero());
-        stats.avg_latency = Duration(stats.total_time.count() / samples.size());
-        
-        // Calculate percentiles
-        auto sorted_samples = samples;
-        std::sort(sorted_samples.begin(), sorted_samples.end());
-        
-        stats.p50_latency = sorted_samples[samples.size() * 50 / 100];
-        stats.p95_latency = sorted_samples[samples.size() * 95 / 100];
-        stats.p99_latency = sorted_samples[samples.size() * 99 / 100];
-        
-        // Get throughput
-        auto throughput_it = throughput_measurements_.find(operation_name);
-        if (throughput_it != throughput_measurements_.end()) {
-            stats.throughput_ops_per_sec = throughput_it->second.getCurrentThroughput();
-        }
-        
-        return stats;
+        return siteStats(it->second);
     }
     
     /**
@@ -185,8 +217,11 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         
         std::unordered_map<std::string, OperationStats> all_stats;
-        for (const auto& [operation_name, samples] : latency_samples_) {
-            all_stats[operation_name] = getOperationStats(operation_name);
+        for (SiteId site = 0; site < site_names_.size(); ++site) {
+            OperationStats stats = siteStats(site);
+            if (stats.sample_count > 0) {
+                all_stats[site_names_[site]] = std::move(stats);
+            }
         }
         
         return all_stats;
@@ -194,13 +229,20 @@ public:
     
     /**
      * @brief Reset all measurements
+     *
+     * Sites stay registered. Samples recorded while the reset runs may be
+     * partly kept.
      */
     void reset() {
         std::lock_guard<std::mutex> lock(mutex_);
-        latency_samples_.clear();
-        for (auto& [name, throughput] : throughput_measurements_) {
-            throughput.reset();
+        for (const auto& slot : thread_slots_) {
+            for (const auto& entry : slot->histograms) {
+                if (AtomicLatencyHistogram* histogram = entry.load(std::memory_order_acquire)) {
+                    histogram->reset();
+                }
+            }
         }
+        site_since_.fill(Clock::now());
     }
     
     /**
@@ -254,14 +296,113 @@ public:
     }
     
 private:
-    PerformanceMeasurement() = default;
+    /**
+     * @brief One recording thread's histograms, by site
+     *
+     * Slots outlive their threads: a thread that exits hands its slot back
+     * with its samples in it, and the next new thread records into it.
+     */
+    struct ThreadSlot {
+        std::array<std::atomic<AtomicLatencyHistogram*>, MaxSites> histograms{};
+        std::atomic<bool> in_use{true};
+        
+        ~ThreadSlot() {
+            for (auto& entry : histograms) {
+                delete entry.load(std::memory_order_relaxed);
+            }
+        }
+    };
+    
+    /**
+     * @brief Binds the calling thread to a slot; returns it at thread exit
+     */
+    struct ThreadBinding {
+        ThreadSlot* slot = nullptr;
+        
+        ~ThreadBinding() {
+            if (slot) {
+                slot->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+    
+    PerformanceMeasurement() {
+        site_since_.fill(Clock::now());
+    }
     ~PerformanceMeasurement() {
         stopMonitoring();
     }
     
+    AtomicLatencyHistogram* localHistogram(SiteId site) {
+        thread_local ThreadBinding binding;
+        if (!binding.slot) {
+            binding.slot = acquireSlot();
+        }
+        // Only this thread stores into its slot, so a relaxed load sees its own writes
+        std::atomic<AtomicLatencyHistogram*>& entry = binding.slot->histograms[std::min(site, MaxSites - 1)];
+        AtomicLatencyHistogram* histogram = entry.load(std::memory_order_relaxed);
+        if (!histogram) {
+            histogram = new AtomicLatencyHistogram();
+            entry.store(histogram, std::memory_order_release);
+        }
+        return histogram;
+    }
+    
+    ThreadSlot* acquireSlot() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& slot : thread_slots_) {
+            bool free = false;
+            if (slot->in_use.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+                return slot.get();
+            }
+        }
+        thread_slots_.push_back(std::make_unique<ThreadSlot>());
+        return thread_slots_.back().get();
+    }
+    
+    // Callers hold mutex_
+    void mergeSite(SiteId site, LatencyHistogram& histogram) const {
+        for (const auto& slot : thread_slots_) {
+            if (const AtomicLatencyHistogram* local = slot->histograms[site].load(std::memory_order_acquire)) {
+                local->addTo(histogram);
+            }
+        }
+    }
+    
+    OperationStats siteStats(SiteId site) const {
+        LatencyHistogram histogram;
+        mergeSite(site, histogram);
+        
+        OperationStats stats;
+        stats.operation_name = site_names_[site];
+        stats.sample_count = histogram.count();
+        if (stats.sample_count == 0) {
+            return stats;
+        }
+        
+        stats.min_latency = Duration(histogram.min());
+        stats.max_latency = Duration(histogram.max());
+        stats.avg_latency = Duration(static_cast<Duration::rep>(histogram.mean()));
+        stats.total_time = Duration(static_cast<Duration::rep>(histogram.mean() * histogram.count()));
+        stats.p50_latency = Duration(histogram.percentile(50.0));
+        stats.p90_latency = Duration(histogram.percentile(90.0));
+        stats.p95_latency = Duration(histogram.percentile(95.0));
+        stats.p99_latency = Duration(histogram.percentile(99.0));
+        stats.p999_latency = Duration(histogram.percentile(99.9));
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - site_since_[site]).count();
+        if (elapsed > 0) {
+            stats.throughput_ops_per_sec = stats.sample_count * 1000.0 / elapsed;
+        }
+        
+        return stats;
+    }
+    
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::vector<Duration>> latency_samples_;
-    std::unordered_map<std::string, ThroughputMeasurement> throughput_measurements_;
+    std::vector<std::string> site_names_;                   // By site ID
+    std::unordered_map<std::string, SiteId> site_ids_;
+    std::array<TimePoint, MaxSites> site_since_;           // Registration or last reset
+    std::vector<std::unique_ptr<ThreadSlot>> thread_slots_;
     
     // Continuous monitoring
     std::atomic<bool> monitoring_active_{false};
@@ -275,6 +416,9 @@ private:
  */
 class PerformanceValidator {
 public:
+    using Duration = PerformanceMeasurement::Duration;
+    using OperationStats = PerformanceMeasurement::OperationStats;
+    
     /**
      * @brief Performance targets from requirements
      */
@@ -339,7 +483,7 @@ public:
         // Validate throughput
         if (stats.throughput_ops_per_sec < targets.min_throughput_ops_per_sec) {
             result.passed = false;
-            result.failure_reason += (result.failure_reason.empty() ? "" : "; ") +
+            result.failure_reason += std::string(result.failure_reason.empty() ? "" : "; ") +
                 "Throughput below target: " + std::to_string(stats.throughput_ops_per_sec) +
                 " ops/sec < " + std::to_string(targets.min_throughput_ops_per_sec) + " ops/sec";
         }
@@ -368,12 +512,17 @@ public:
     }
 };
 
-// Convenience macros for performance measurement
+// Convenience macros for performance measurement. The site ID is looked up
+// once per call site and kept in a function-local static.
+#define PERF_MEASURE_CONCAT_INNER(a, b) a##b
+#define PERF_MEASURE_CONCAT(a, b) PERF_MEASURE_CONCAT_INNER(a, b)
+
 #define PERF_MEASURE(operation_name) \
-    auto _perf_timer = orderbook::PerformanceMeasurement::getInstance().createTimer(operation_name)
+    static const orderbook::PerformanceMeasurement::SiteId PERF_MEASURE_CONCAT(_perf_site_, __LINE__) = \
+        orderbook::PerformanceMeasurement::getInstance().registerSite(operation_name); \
+    orderbook::PerformanceMeasurement::ScopedTimer PERF_MEASURE_CONCAT(_perf_measure_, __LINE__)( \
+        PERF_MEASURE_CONCAT(_perf_site_, __LINE__), orderbook::PerformanceMeasurement::getInstance())
 
-#define PERF_MEASURE_SCOPE(operation_name) \
-    orderbook::PerformanceMeasurement::ScopedTimer _perf_timer(operation_name, \
-        orderbook::PerformanceMeasurement::getInstance())
+#define PERF_MEASURE_SCOPE(operation_name) PERF_MEASURE(operation_name)
 
 } // namespace orderbook
\ No newline at end of file
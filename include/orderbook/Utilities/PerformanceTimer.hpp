@@ -1,7 +1,9 @@
 #pragma once
+#include "TscClock.hpp"
 #include <chrono>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace orderbook {
 
@@ -9,11 +11,18 @@ class ILogger;
 
 /**
  * @brief RAII-style performance timer for measuring operation latency
+ * Timing uses TscClock ticks. Given a string literal the name is only
+ * copied when the timer logs, so a timer without a logger costs one
+ * counter read.
  */
 class PerformanceTimer {
 public:
     explicit PerformanceTimer(const std::string& operation_name, 
                              std::shared_ptr<ILogger> logger = nullptr);
+    
+    // operation_name must outlive the timer (PERF_TIMER passes literals)
+    explicit PerformanceTimer(const char* operation_name,
+                             std::shared_ptr<ILogger> logger = nullptr);
     ~PerformanceTimer();
     
     // Get elapsed time without logging
@@ -26,9 +35,10 @@ public:
     void addMetric(const std::string& key, const std::string& value);
     
 private:
-    std::string operation_name_;
+    const char* operation_literal_ = nullptr;
+    std::string operation_name_;        // Used when operation_literal_ is null
     std::shared_ptr<ILogger> logger_;
-    std::chrono::high_resolution_clock::time_point start_time_;
+    uint64_t start_ticks_;
     std::vector<std::pair<std::string, std::string>> additional_metrics_;
     bool logged_;
 };
@@ -0,0 +1,293 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include "MemoryArena.hpp"
+
+namespace orderbook {
+
+// Cache line size used to keep producer and consumer indices apart
+constexpr size_t CacheLineSize = 64;
+
+/**
+ * @brief Bounded single-producer single-consumer ring buffer
+ *
+ * Exactly one thread may push and exactly one thread may pop. Capacity is
+ * rounded up to a power of two so index wrapping is a mask. Head and tail live
+ * on separate cache lines, and each side caches the other's index so the
+ * shared line is only re-read when the ring looks full or empty. T must be
+ * default constructible; slots are constructed up front and reused.
+ */
+template<typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of slots (rounded up to a power of two)
+     * @param arena Arena for the slots (nullptr = heap; must outlive the ring)
+     */
+    explicit SpscRing(size_t capacity, MemoryArena* arena = nullptr)
+        : capacity_(roundCapacity(capacity)), mask_(capacity_ - 1),
+          slots_(makeArenaArray<T>(arena, capacity_)) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Push an element (producer thread only)
+     * @param value Element to push
+     * @return false if the ring is full
+     */
+    template<typename U>
+    bool tryPush(U&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= capacity_) {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get a slot to fill in place (producer thread only)
+     * Call commit() once the slot is written.
+     * @return Slot pointer or nullptr if the ring is full
+     */
+    T* claim() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= capacity_) {
+                return nullptr;
+            }
+        }
+        return &slots_[tail & mask_];
+    }
+
+    /**
+     * @brief Publish the slot returned by claim() (producer thread only)
+     */
+    void commit() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pop an element (consumer thread only)
+     * @param out Receives the element
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop up to max_items elements into a callback (consumer thread only)
+     * @param max_items Maximum number of elements to consume
+     * @param consumer Callable taking T&
+     * @return Number of elements consumed
+     */
+    template<typename Consumer>
+    size_t drain(size_t max_items, Consumer&& consumer) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        size_t available = cached_tail_ - head;
+        size_t count = available < max_items ? available : max_items;
+
+        for (size_t i = 0; i < count; ++i) {
+            consumer(slots_[(head + i) & mask_]);
+        }
+
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Approximate number of queued elements
+     * @return Element count (exact only when both sides are idle)
+     */
+    size_t size() const {
+        // Head first: tail only grows, so it cannot be read behind the head
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t roundCapacity(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    ArenaArray<T> slots_;
+
+    // Consumer side
+    alignas(CacheLineSize) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // Producer side
+    alignas(CacheLineSize) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
+
+/**
+ * @brief Bounded multi-producer single-consumer ring buffer
+ *
+ * Any number of threads may push; one thread pops. Each slot carries a
+ * sequence number (Vyukov's bounded queue), so producers claim slots with a
+ * single CAS on the tail and the consumer never touches a shared counter
+ * other than its own head.
+ */
+template<typename T>
+class MpscRing {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of slots (rounded up to a power of two)
+     * @param arena Arena for the slots (nullptr = heap; must outlive the ring)
+     */
+    explicit MpscRing(size_t capacity, MemoryArena* arena = nullptr)
+        : capacity_(roundCapacity(capacity)), mask_(capacity_ - 1),
+          slots_(makeArenaArray<Slot>(arena, capacity_)) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Push an element (any thread)
+     * @param value Element to push
+     * @return false if the ring is full
+     */
+    template<typename U>
+    bool tryPush(U&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[tail & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(tail);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value = std::forward<U>(value);
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Slot still holds an unconsumed element
+            } else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pop an element (consumer thread only)
+     * @param out Receives the element
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return false;
+        }
+
+        out = std::move(slot.value);
+        slot.sequence.store(head_ + capacity_, std::memory_order_release);
+        head_published_.store(++head_, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop up to max_items elements into a callback (consumer thread only)
+     * Stops at the first slot a producer has claimed but not yet published.
+     * @param max_items Maximum number of elements to consume
+     * @param consumer Callable taking T&
+     * @return Number of elements consumed
+     */
+    template<typename Consumer>
+    size_t drain(size_t max_items, Consumer&& consumer) {
+        size_t count = 0;
+        while (count < max_items) {
+            Slot& slot = slots_[head_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+                break;
+            }
+            consumer(slot.value);
+            slot.sequence.store(head_ + capacity_, std::memory_order_release);
+            ++head_;
+            ++count;
+        }
+        if (count > 0) {
+            head_published_.store(head_, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Approximate number of queued elements
+     * @return Element count (exact only when all sides are idle)
+     */
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_published_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t roundCapacity(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    ArenaArray<Slot> slots_;
+
+    // Producer side
+    alignas(CacheLineSize) std::atomic<size_t> tail_{0};
+
+    // Consumer side
+    alignas(CacheLineSize) size_t head_ = 0;
+    std::atomic<size_t> head_published_{0};   // Copy of head_ for size()
+};
+
+}
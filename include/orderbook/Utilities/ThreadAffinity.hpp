@@ -0,0 +1,41 @@
+#pragma once
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Whether pinCurrentThread() can work on this platform
+ */
+constexpr bool threadPinningSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Pin the calling thread to one CPU
+ * @param cpu CPU index
+ * @return true if the affinity was applied
+ */
+inline bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+}
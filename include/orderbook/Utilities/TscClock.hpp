@@ -0,0 +1,188 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ORDERBOOK_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Wall clock read from the CPU timestamp counter
+ *
+ * An invariant TSC ticks at a constant rate on every core, so after a
+ * one-off calibration against the OS clocks a timestamp is one rdtsc and a
+ * multiply, with no clock_gettime. Tick differences give latencies;
+ * now() maps ticks onto the wall clock from a single anchor taken at
+ * calibration, so it drifts from NTP-corrected system time by some
+ * parts per million. Where wall time must be exact (FIX SendingTime,
+ * logs) use std::chrono::system_clock.
+ *
+ * Without an invariant TSC (or off x86) ticks are steady_clock
+ * nanoseconds, and everything still works at clock_gettime cost.
+ *
+ * Calibration spins for CalibrationWindow on first use; call calibrate()
+ * at startup to keep that off the first measured operation.
+ */
+class TscClock {
+public:
+    using duration = std::chrono::system_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::system_clock::time_point;
+    static constexpr bool is_steady = false;
+
+    static constexpr std::chrono::milliseconds CalibrationWindow{20};
+
+    /**
+     * @brief Raw counter value (unordered; may run ahead of earlier loads)
+     */
+    static uint64_t ticks() noexcept {
+#ifdef ORDERBOOK_HAS_TSC
+        if (calibration().tsc) {
+            return __rdtsc();
+        }
+#endif
+        return steadyNanoseconds();
+    }
+
+    /**
+     * @brief Raw counter value read after every earlier instruction has completed
+     */
+    static uint64_t ticksOrdered() noexcept {
+#ifdef ORDERBOOK_HAS_TSC
+        if (calibration().tsc) {
+            unsigned int aux;
+            return __rdtscp(&aux);
+        }
+#endif
+        return steadyNanoseconds();
+    }
+
+    /**
+     * @brief Nanoseconds spanned by a tick difference
+     */
+    static int64_t toNanoseconds(uint64_t elapsed_ticks) noexcept {
+        return static_cast<int64_t>(static_cast<double>(elapsed_ticks) * calibration().ns_per_tick);
+    }
+
+    /**
+     * @brief Wall-clock time of a counter value
+     */
+    static time_point fromTicks(uint64_t tick) noexcept {
+        const Calibration& c = calibration();
+        double offset = static_cast<double>(static_cast<int64_t>(tick - c.anchor_ticks)) * c.ns_per_tick;
+        return time_point(std::chrono::duration_cast<duration>(
+            std::chrono::nanoseconds(c.anchor_ns + static_cast<int64_t>(offset))));
+    }
+
+    static time_point now() noexcept { return fromTicks(ticks()); }
+
+    /**
+     * @brief Current wall-clock time in nanoseconds since the epoch
+     */
+    static int64_t nowNanoseconds() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Calibrate now rather than on first use
+     */
+    static void calibrate() noexcept { (void)calibration(); }
+
+    static bool usesTsc() noexcept { return calibration().tsc; }
+    static double ticksPerNanosecond() noexcept { return 1.0 / calibration().ns_per_tick; }
+
+private:
+    struct Calibration {
+        bool tsc = false;
+        double ns_per_tick = 1.0;
+        uint64_t anchor_ticks = 0;
+        int64_t anchor_ns = 0;          // Wall clock at anchor_ticks
+    };
+
+    static uint64_t steadyNanoseconds() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static int64_t wallNanoseconds() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static bool hasInvariantTsc() noexcept {
+#ifdef ORDERBOOK_HAS_TSC
+        // CPUID 0x80000007, EDX bit 8: TSC runs at a constant rate in every P/C-state
+#ifdef _MSC_VER
+        int regs[4];
+        __cpuid(regs, 0x80000000);
+        if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+            return false;
+        }
+        __cpuid(regs, 0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#else
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) {
+            return false;
+        }
+        if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        return (edx & (1u << 8)) != 0;
+#endif
+#else
+        return false;
+#endif
+    }
+
+    static Calibration measure() noexcept {
+        Calibration c;
+        c.anchor_ticks = steadyNanoseconds();
+        c.anchor_ns = wallNanoseconds();
+#ifdef ORDERBOOK_HAS_TSC
+        if (!hasInvariantTsc()) {
+            return c;
+        }
+
+        // Pair each clock read with the counter midway across it
+        auto sample = [](auto read_clock, uint64_t& tick) {
+            uint64_t before = __rdtsc();
+            auto value = read_clock();
+            tick = before + (__rdtsc() - before) / 2;
+            return value;
+        };
+        uint64_t start_ticks, end_ticks, anchor_ticks;
+        int64_t start_ns = static_cast<int64_t>(sample(steadyNanoseconds, start_ticks));
+        int64_t anchor_ns = sample(wallNanoseconds, anchor_ticks);
+        int64_t end_ns = start_ns;
+        while (end_ns - start_ns < std::chrono::nanoseconds(CalibrationWindow).count()) {
+            end_ns = static_cast<int64_t>(sample(steadyNanoseconds, end_ticks));
+        }
+        if (end_ticks <= start_ticks) {
+            return c;
+        }
+
+        c.tsc = true;
+        c.ns_per_tick = static_cast<double>(end_ns - start_ns) / static_cast<double>(end_ticks - start_ticks);
+        c.anchor_ticks = anchor_ticks;
+        c.anchor_ns = anchor_ns;
+#endif
+        return c;
+    }
+
+    static const Calibration& calibration() noexcept {
+        static const Calibration calibration = measure();
+        return calibration;
+    }
+};
+
+}
@@ -0,0 +1,240 @@
+#include "orderbook/Core/DepthSnapshot.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ORDERBOOK_DEPTH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORDERBOOK_DEPTH_SSE2 1
+#endif
+
+namespace orderbook {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(ORDERBOOK_DEPTH_AVX2) || defined(ORDERBOOK_DEPTH_SSE2)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Inclusive prefix sum, a vector register at a time
+ *
+ * Each register is scanned in log2(lanes) shift-and-add steps, then the
+ * running total of the previous registers is broadcast and added.
+ */
+void prefixSum(const uint64_t* in, uint64_t* out, size_t count) {
+    size_t i = 0;
+    uint64_t carry = 0;
+
+#if defined(ORDERBOOK_DEPTH_AVX2)
+    __m256i total = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        // [a b c d] -> [a a+b b+c c+d] -> [a a+b a+b+c a+b+c+d]
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)),
+                                                   _mm256_setzero_si256(), 0x03));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)),
+                                                   _mm256_setzero_si256(), 0x0F));
+        x = _mm256_add_epi64(x, total);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+        total = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    carry = i > 0 ? out[i - 1] : 0;
+#elif defined(ORDERBOOK_DEPTH_SSE2)
+    __m128i total = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi64(x, total);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+        total = _mm_unpackhi_epi64(x, x);
+    }
+    carry = i > 0 ? out[i - 1] : 0;
+#endif
+
+    for (; i < count; ++i) {
+        carry += in[i];
+        out[i] = carry;
+    }
+}
+
+void prefixSum(const double* in, double* out, size_t count) {
+    size_t i = 0;
+    double carry = 0.0;
+
+#if defined(ORDERBOOK_DEPTH_AVX2)
+    __m256d total = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(in + i);
+        x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0)),
+                                             _mm256_setzero_pd(), 0x1));
+        x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 0, 0, 0)),
+                                             _mm256_setzero_pd(), 0x3));
+        x = _mm256_add_pd(x, total);
+        _mm256_storeu_pd(out + i, x);
+        total = _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    carry = i > 0 ? out[i - 1] : 0.0;
+#elif defined(ORDERBOOK_DEPTH_SSE2)
+    __m128d total = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2) {
+        __m128d x = _mm_loadu_pd(in + i);
+        x = _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+        x = _mm_add_pd(x, total);
+        _mm_storeu_pd(out + i, x);
+        total = _mm_unpackhi_pd(x, x);
+    }
+    carry = i > 0 ? out[i - 1] : 0.0;
+#endif
+
+    for (; i < count; ++i) {
+        carry += in[i];
+        out[i] = carry;
+    }
+}
+
+}
+
+Quantity DepthView::quantityTo(Side side, Price limit) const {
+    const Levels& side_levels = levels(side);
+    const PriceTicks* ticks = side_levels.ticks.data();
+    double limit_ticks = limit / tick_size_.size();
+
+    // Bids run down from the best price and asks up, so the levels inside the limit are a prefix
+    size_t inside = 0;
+    if (side == Side::Buy) {
+        PriceTicks worst = static_cast<PriceTicks>(std::ceil(limit_ticks - 1e-9));
+        inside = std::partition_point(ticks, ticks + side_levels.count,
+                                      [worst](PriceTicks t) { return t >= worst; }) - ticks;
+    } else {
+        PriceTicks worst = static_cast<PriceTicks>(std::floor(limit_ticks + 1e-9));
+        inside = std::partition_point(ticks, ticks + side_levels.count,
+                                      [worst](PriceTicks t) { return t <= worst; }) - ticks;
+    }
+    return inside > 0 ? side_levels.cumulative_quantity[inside - 1] : 0;
+}
+
+std::optional<Price> DepthView::vwapTo(Side side, Quantity size) const {
+    const Levels& side_levels = levels(side);
+    size_t level = levelFilling(side_levels, size);
+    if (size == 0 || level == side_levels.count) {
+        return std::nullopt;
+    }
+
+    // Whole levels before the one that completes the fill, then part of it
+    Quantity before = level > 0 ? side_levels.cumulative_quantity[level - 1] : 0;
+    double notional = level > 0 ? side_levels.cumulative_notional[level - 1] : 0.0;
+    notional += static_cast<double>(size - before) * tick_size_.toPrice(side_levels.ticks[level]);
+    return notional / static_cast<double>(size);
+}
+
+std::optional<Price> DepthView::priceFor(Side side, Quantity size) const {
+    const Levels& side_levels = levels(side);
+    size_t level = levelFilling(side_levels, size);
+    if (level == side_levels.count) {
+        return std::nullopt;
+    }
+    return tick_size_.toPrice(side_levels.ticks[level]);
+}
+
+size_t DepthView::levelFilling(const Levels& levels, Quantity size) const {
+    const Quantity* cumulative = levels.cumulative_quantity.data();
+    return std::lower_bound(cumulative, cumulative + levels.count, size) - cumulative;
+}
+
+static_assert(std::atomic<PriceTicks>::is_always_lock_free && std::atomic<Quantity>::is_always_lock_free &&
+              std::atomic<double>::is_always_lock_free, "Depth levels must copy without locks");
+
+DepthSnapshot::DepthSnapshot(size_t levels, TickSize tick_size)
+    : capacity_(levels), tick_size_(tick_size) {
+    for (Levels* side : {&bids_, &asks_}) {
+        side->ticks = std::make_unique<std::atomic<PriceTicks>[]>(capacity_);
+        side->quantity = std::make_unique<std::atomic<Quantity>[]>(capacity_);
+        side->notional = std::make_unique<std::atomic<double>[]>(capacity_);
+    }
+}
+
+void DepthSnapshot::read(DepthView& view) const {
+    view.tick_size_ = tick_size_;
+    for (DepthView::Levels* side : {&view.bids_, &view.asks_}) {
+        if (side->ticks.size() < capacity_) {
+            side->ticks.resize(capacity_);
+            side->quantity.resize(capacity_);
+            side->notional.resize(capacity_);
+            side->cumulative_quantity.resize(capacity_);
+            side->cumulative_notional.resize(capacity_);
+        }
+    }
+
+    auto copy = [this](const Levels& from, DepthView::Levels& to) {
+        // Values torn by a concurrent write are caught by the version check;
+        // relaxed loads of aligned words compile to plain moves
+        to.count = std::min(from.count.load(std::memory_order_relaxed), capacity_);
+        for (size_t i = 0; i < to.count; ++i) {
+            to.ticks[i] = from.ticks[i].load(std::memory_order_relaxed);
+            to.quantity[i] = from.quantity[i].load(std::memory_order_relaxed);
+            to.notional[i] = from.notional[i].load(std::memory_order_relaxed);
+        }
+    };
+
+    for (;;) {
+        uint64_t version = version_.load(std::memory_order_acquire);
+        if (version & 1) {
+            cpuRelax();
+            continue;
+        }
+        copy(bids_, view.bids_);
+        copy(asks_, view.asks_);
+        view.book_sequence_ = book_sequence_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version_.load(std::memory_order_relaxed) == version) {
+            view.version_ = version;
+            break;
+        }
+    }
+
+    // Prefix sums run on the reader's copy, outside the retry loop
+    for (DepthView::Levels* side : {&view.bids_, &view.asks_}) {
+        prefixSum(side->quantity.data(), side->cumulative_quantity.data(), side->count);
+        prefixSum(side->notional.data(), side->cumulative_notional.data(), side->count);
+    }
+}
+
+bool DepthSnapshot::covers(Side side, PriceTicks ticks) const {
+    const Levels& levels = side == Side::Buy ? bids_ : asks_;
+    if (levels.written < capacity_) {
+        return capacity_ > 0;
+    }
+    PriceTicks worst = levels.ticks[levels.written - 1].load(std::memory_order_relaxed);
+    return side == Side::Buy ? ticks >= worst : ticks <= worst;
+}
+
+void DepthSnapshot::beginWrite() {
+    // Odd version while the arrays are in flux
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void DepthSnapshot::writeLevel(Side side, size_t index, PriceTicks ticks, Quantity quantity, Price price) {
+    Levels& levels = sideOf(side);
+    levels.ticks[index].store(ticks, std::memory_order_relaxed);
+    levels.quantity[index].store(quantity, std::memory_order_relaxed);
+    levels.notional[index].store(price * static_cast<double>(quantity), std::memory_order_relaxed);
+}
+
+void DepthSnapshot::endWrite(size_t bid_count, size_t ask_count, SequenceNumber book_sequence) {
+    bids_.written = bid_count;
+    asks_.written = ask_count;
+    bids_.count.store(bid_count, std::memory_order_relaxed);
+    asks_.count.store(ask_count, std::memory_order_relaxed);
+    book_sequence_.store(book_sequence, std::memory_order_relaxed);
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+}
@@ -11,7 +11,7 @@ namespace orderbook {
 class TestMarketDataSubscriber : public IMarketDataSubscriber {
 public:
     void onTrade(const Trade& trade, SequenceNumber sequence) override {
-        std::cout << "TRADE [" << sequence << "]: " << trade.symbol 
+        std::cout << "TRADE [" << sequence << "]: " << trade.symbol() 
                   << " " << trade.quantity << "@" << trade.price 
                   << " (Buy: " << trade.buy_order_id.value 
                   << ", Sell: " << trade.sell_order_id.value << ")" << std::endl;
@@ -21,7 +21,7 @@ void testBasicMatching() {
     
     // Create price levels
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(99.0, 9900);
     ask_levels.back().addOrder(&sell_order);
     
     // Match buy order against ask levels
@@ -65,7 +65,7 @@ void testFullFill() {
     
     // Create price levels
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(99.0, 9900);
     ask_levels.back().addOrder(&sell_order);
     
     // Match buy order
@@ -104,11 +104,11 @@ void testMultiplePriceLevels() {
     
     // Create price levels
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(99.0, 9900);
     ask_levels.back().addOrder(&sell_order1);
-    ask_levels.emplace_back(100.0);
+    ask_levels.emplace_back(100.0, 10000);
     ask_levels.back().addOrder(&sell_order2);
-    ask_levels.emplace_back(101.0);
+    ask_levels.emplace_back(101.0, 10100);
     ask_levels.back().addOrder(&sell_order3);
     
     // Match buy order
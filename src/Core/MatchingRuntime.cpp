@@ -0,0 +1,350 @@
+#include "orderbook/Core/MatchingRuntime.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/Metrics.hpp"
+#include "orderbook/Utilities/ThreadAffinity.hpp"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Backoff thresholds in idle iterations
+constexpr uint32_t SpinIterations = 1024;
+constexpr uint32_t YieldIterations = 1024 + 64;
+constexpr auto IdleSleep = std::chrono::microseconds(50);
+
+}
+
+MatchingRuntime::MatchingRuntime(OrderBookRouter& router, LoggerPtr logger)
+    : MatchingRuntime(router, std::move(logger), RuntimeConfig{}) {
+}
+
+MatchingRuntime::MatchingRuntime(OrderBookRouter& router, LoggerPtr logger, const RuntimeConfig& config)
+    : router_(router), logger_(std::move(logger)), config_(config) {
+    createShards();
+}
+
+MatchingRuntime::MatchingRuntime(OrderBookRouter& router, LoggerPtr logger, std::shared_ptr<Config> config)
+    : router_(router), logger_(std::move(logger)), config_(loadConfiguration(config)) {
+    createShards();
+}
+
+MatchingRuntime::~MatchingRuntime() {
+    stop();
+}
+
+void MatchingRuntime::start() {
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shards_[i]->thread = std::thread(&MatchingRuntime::runShard, this, i);
+    }
+
+    LOG_INFO(logger_, "Matching runtime started with " + std::to_string(shards_.size()) + " shard(s)",
+                      "MatchingRuntime::start");
+}
+
+void MatchingRuntime::stop() {
+    // A visit in progress needs the shard threads, so it finishes first
+    std::lock_guard<std::mutex> lock(visit_mutex_);
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+
+    LOG_INFO(logger_, "Matching runtime stopped", "MatchingRuntime::stop");
+}
+
+void MatchingRuntime::setResultHandler(ResultHandler handler) {
+    if (running_.load(std::memory_order_acquire)) {
+        LOG_WARN(logger_, "Result handler must be set before start(); ignored",
+                          "MatchingRuntime::setResultHandler");
+        return;
+    }
+    result_handler_ = std::move(handler);
+}
+
+Result<bool> MatchingRuntime::submit(const BookCommand& command) {
+    uint32_t shard = router_.getShard(command.order.symbol_id);
+    if (shard >= shards_.size()) {
+        return Result<bool>::error("Unknown symbol ID: " + std::to_string(command.order.symbol_id));
+    }
+
+    const RiskManagerPtr& risk = router_.getRiskManager();
+    if (config_.pre_trade_risk && risk && command.type == BookCommand::Type::Add) {
+        auto risk_check = risk->checkOrderStateless(command.order);
+        if (risk_check.isRejected()) {
+            risk_rejects_.fetch_add(1, std::memory_order_relaxed);
+            return Result<bool>::error("Risk validation failed: " + risk_check.reason);
+        }
+
+        BookCommand checked = command;
+        checked.risk_prechecked = true;
+        return push(shard, checked);
+    }
+    return push(shard, command);
+}
+
+Result<bool> MatchingRuntime::push(uint32_t shard, const BookCommand& command) {
+    if (!shards_[shard]->commands.tryPush(command)) {
+        rejected_submits_.fetch_add(1, std::memory_order_relaxed);
+        return Result<bool>::error("Shard " + std::to_string(shard) + " command queue full");
+    }
+    return Result<bool>::success(true);
+}
+
+void MatchingRuntime::visitBooks(const BookVisitor& visitor) {
+    std::lock_guard<std::mutex> lock(visit_mutex_);
+    if (!running_.load(std::memory_order_acquire)) {
+        router_.forEachBook(visitor);
+        return;
+    }
+
+    for (auto& shard : shards_) {
+        shard->visit.store(&visitor, std::memory_order_release);
+    }
+    for (auto& shard : shards_) {
+        while (shard->visit.load(std::memory_order_acquire) != nullptr) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+MatchingRuntime::WaitStrategy MatchingRuntime::parseWaitStrategy(const std::string& name) {
+    return name == "busy_poll" || name == "busy" ? WaitStrategy::BusyPoll : WaitStrategy::Backoff;
+}
+
+MatchingRuntime::RuntimeConfig MatchingRuntime::loadConfiguration(std::shared_ptr<Config> config) {
+    RuntimeConfig runtime;
+    if (!config) {
+        return runtime;
+    }
+    
+    runtime.command_queue_size = static_cast<size_t>(
+        config->getInt("matching", "queue_size", static_cast<int>(runtime.command_queue_size)));
+    runtime.result_queue_size = static_cast<size_t>(
+        config->getInt("matching", "result_queue_size", static_cast<int>(runtime.result_queue_size)));
+    runtime.max_batch = static_cast<size_t>(
+        config->getInt("matching", "max_batch", static_cast<int>(runtime.max_batch)));
+    runtime.wait_strategy = parseWaitStrategy(config->getString("matching", "wait_strategy", "backoff"));
+    runtime.pre_trade_risk = config->getBool("matching", "pre_trade_risk", runtime.pre_trade_risk);
+    
+    runtime.arena = MemoryArena::loadConfiguration(config);
+    
+    // Comma-separated CPU list, one entry per shard
+    std::istringstream cpus(config->getString("matching", "cpu_affinity", ""));
+    for (std::string cpu; std::getline(cpus, cpu, ',');) {
+        try {
+            runtime.cpu_affinity.push_back(std::stoi(cpu));
+        } catch (const std::exception&) {
+            runtime.cpu_affinity.push_back(-1);
+        }
+    }
+    
+    return runtime;
+}
+
+uint64_t MatchingRuntime::getProcessedCount(size_t shard) const {
+    return shard < shards_.size() ? shards_[shard]->processed.load(std::memory_order_relaxed) : 0;
+}
+
+void MatchingRuntime::exportMetrics(MetricsWriter& out) const {
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        const Shard& shard = *shards_[i];
+        std::string index = std::to_string(i);
+        out.gauge("shard_queue_depth", "Entries waiting in a shard ring",
+                  static_cast<double>(shard.commands.size()), {{"shard", index}, {"queue", "commands"}});
+        out.gauge("shard_queue_depth", "Entries waiting in a shard ring",
+                  static_cast<double>(shard.results.size()), {{"shard", index}, {"queue", "results"}});
+        out.gauge("shard_queue_capacity", "Slots in a shard ring",
+                  static_cast<double>(shard.commands.capacity()), {{"shard", index}, {"queue", "commands"}});
+        out.gauge("shard_queue_capacity", "Slots in a shard ring",
+                  static_cast<double>(shard.results.capacity()), {{"shard", index}, {"queue", "results"}});
+        out.counter("shard_commands_processed_total", "Commands applied by a shard thread",
+                    static_cast<double>(shard.processed.load(std::memory_order_relaxed)), {{"shard", index}});
+    }
+    out.counter("runtime_rejected_submits_total", "Commands refused because a shard queue was full",
+                static_cast<double>(rejected_submits_.load(std::memory_order_relaxed)));
+    out.counter("runtime_dropped_results_total", "Results discarded with no handler or queue to take them",
+                static_cast<double>(dropped_results_.load(std::memory_order_relaxed)));
+    out.counter("runtime_risk_rejects_total", "Orders rejected by pre-trade risk checks in submit()",
+                static_cast<double>(risk_rejects_.load(std::memory_order_relaxed)));
+}
+
+void MatchingRuntime::createShards() {
+    if (config_.max_batch == 0) {
+        config_.max_batch = 1;
+    }
+    for (size_t i = 0; i < router_.getShardCount(); ++i) {
+        // Ring slots go on the node of the CPU the shard thread is pinned to
+        std::unique_ptr<MemoryArena> arena;
+        if (config_.arena.enabled) {
+            MemoryArena::ArenaConfig arena_config = config_.arena;
+            if (arena_config.numa_node < 0 && i < config_.cpu_affinity.size()) {
+                arena_config.numa_node = MemoryArena::nodeOfCpu(config_.cpu_affinity[i]);
+            }
+            arena = std::make_unique<MemoryArena>(arena_config);
+        }
+        shards_.push_back(std::make_unique<Shard>(config_.command_queue_size, config_.result_queue_size,
+                                                  std::move(arena)));
+        shards_.back()->batch.reserve(config_.max_batch);
+        shards_.back()->batch_results.reserve(config_.max_batch);
+    }
+}
+
+void MatchingRuntime::runShard(size_t index) {
+    pinThread(index);
+
+    Shard& shard = *shards_[index];
+    uint32_t idle = 0;
+
+    while (true) {
+        visitShard(index, shard);
+
+        size_t applied = shard.commands.drain(config_.max_batch, [&shard](BookCommand& command) {
+            shard.batch.push_back(std::move(command));
+        });
+
+        if (applied > 0) {
+            applyBatch(index, shard);
+            shard.processed.fetch_add(applied, std::memory_order_relaxed);
+            idle = 0;
+            continue;
+        }
+
+        // Queue is empty; once stopped there is nothing left to apply
+        if (!running_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        if (config_.wait_strategy == WaitStrategy::BusyPoll || idle < SpinIterations) {
+            cpuRelax();
+        } else if (idle < YieldIterations) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(IdleSleep);
+        }
+        idle = std::min(idle + 1, YieldIterations);
+    }
+}
+
+void MatchingRuntime::applyBatch(size_t index, Shard& shard) {
+    auto& batch = shard.batch;
+    auto& results = shard.batch_results;
+
+    // Consecutive commands for the same book go through one OrderBook batch;
+    // runs are applied in arrival order, so ordering holds across books too
+    size_t begin = 0;
+    while (begin < batch.size()) {
+        SymbolId symbol = batch[begin].order.symbol_id;
+        size_t end = begin + 1;
+        while (end < batch.size() && batch[end].order.symbol_id == symbol) {
+            ++end;
+        }
+
+        if (OrderBook* book = router_.getBook(symbol)) {
+            book->applyBatch(&batch[begin], end - begin, results);
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                BookCommandResult result;
+                result.type = batch[i].type;
+                result.order_id = batch[i].order.id;
+                result.symbol_id = symbol;
+                result.source = batch[i].source;
+                result.tag = batch[i].tag;
+                result.error = "Unknown symbol ID: " + std::to_string(symbol);
+                results.push_back(std::move(result));
+            }
+        }
+        begin = end;
+    }
+
+    deliverResults(index, shard);
+    batch.clear();
+    results.clear();
+}
+
+void MatchingRuntime::deliverResults(size_t index, Shard& shard) {
+    auto& results = shard.batch_results;
+    if (result_handler_) {
+        for (auto& result : results) {
+            result_handler_(result);
+        }
+        return;
+    }
+    if (config_.result_queue_size == 0) {
+        dropped_results_.fetch_add(results.size(), std::memory_order_relaxed);
+        return;
+    }
+
+    // A slow consumer back-pressures the shard while running; visits are still
+    // served meanwhile, and once stopping nothing waits on a consumer that may be gone
+    for (auto& result : results) {
+        while (!shard.results.tryPush(std::move(result))) {
+            if (!running_.load(std::memory_order_acquire)) {
+                dropped_results_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            visitShard(index, shard);
+            cpuRelax();
+        }
+    }
+}
+
+void MatchingRuntime::visitShard(size_t index, Shard& shard) {
+    const BookVisitor* visitor = shard.visit.load(std::memory_order_acquire);
+    if (!visitor) {
+        return;
+    }
+    for (SymbolId symbol : router_.getShardSymbols(static_cast<uint32_t>(index))) {
+        if (OrderBook* book = router_.getBook(symbol)) {
+            (*visitor)(symbol, *book);
+        }
+    }
+    shard.visit.store(nullptr, std::memory_order_release);
+}
+
+void MatchingRuntime::pinThread(size_t index) {
+    if (index >= config_.cpu_affinity.size() || config_.cpu_affinity[index] < 0) {
+        return;
+    }
+    int cpu = config_.cpu_affinity[index];
+
+    if (!threadPinningSupported()) {
+        LOG_WARN(logger_, "CPU pinning is not supported on this platform; shard " + std::to_string(index) +
+                          " left unpinned",
+                          "MatchingRuntime::pinThread");
+        return;
+    }
+    if (!pinCurrentThread(cpu)) {
+        LOG_WARN(logger_, "Failed to pin shard " + std::to_string(index) + " to CPU " + std::to_string(cpu),
+                          "MatchingRuntime::pinThread");
+        return;
+    }
+    LOG_INFO(logger_, "Pinned shard " + std::to_string(index) + " to CPU " + std::to_string(cpu),
+                      "MatchingRuntime::pinThread");
+}
+
+}
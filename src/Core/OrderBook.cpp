@@ -1,25 +1,308 @@
 #include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/BookSnapshot.hpp"
 #include "orderbook/Utilities/PerformanceTimer.hpp"
 #include "orderbook/Utilities/MemoryManager.hpp"
 #include "orderbook/Utilities/PerformanceMeasurement.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/Metrics.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 
 namespace orderbook {
 
+namespace {
+
+// Trade IDs are unique across all books, which may match on different threads
+std::atomic<uint64_t> next_trade_id{1};
+
+// Book update sequence numbers, shared the same way for gap detection
+std::atomic<SequenceNumber> book_sequence{0};
+
+void advanceCounter(std::atomic<uint64_t>& counter, uint64_t value) {
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    while (current < value &&
+           !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+template<typename T>
+void appendBytes(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+int64_t toNanoseconds(Timestamp timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+}
+
 // Constructor with dependency injection
 OrderBook::OrderBook(RiskManagerPtr risk_manager,
                      MarketDataPublisherPtr market_data,
                      LoggerPtr logger)
-    : risk_manager_(risk_manager), market_data_(market_data), logger_(logger) {
+    : OrderBook(std::move(risk_manager), std::move(market_data), std::move(logger), BookConfig{}) {
+}
+
+OrderBook::OrderBook(RiskManagerPtr risk_manager,
+                     MarketDataPublisherPtr market_data,
+                     LoggerPtr logger,
+                     const BookConfig& config)
+    : config_(config), tick_size_(config.tick_size),
+      symbol_id_(InternTable::symbols().intern(config.symbol)),
+      arena_(config.arena.enabled ? std::make_unique<MemoryArena>(config.arena) : nullptr),
+      level_pool_(arena_.get()), order_pool_(arena_.get()),
+      bid_ladder_(Side::Buy, usesLadder() ? config.ladder_levels : 0, arena_.get(), config.ladder_max_levels),
+      ask_ladder_(Side::Sell, usesLadder() ? config.ladder_levels : 0, arena_.get(), config.ladder_max_levels),
+      account_link_pool_(arena_.get()),
+      risk_manager_(risk_manager), market_data_(market_data), logger_(logger) {
     
     // Reserve capacity for typical number of price levels
-    bids_.reserve(InitialCapacity);
-    asks_.reserve(InitialCapacity);
+    if (!usesLadder()) {
+        bids_.reserve(InitialCapacity);
+        asks_.reserve(InitialCapacity);
+    }
+    
+    // Pre-warm the order arena and index so steady-state adds never allocate
+    if (config_.max_orders > 0) {
+        order_pool_.reserve(config_.max_orders);
+        order_index_.reserve(config_.max_orders);
+        account_link_pool_.reserve(config_.max_orders);
+    }
+    if (config_.query_levels > 0) {
+        depth_snapshot_ = std::make_unique<DepthSnapshot>(config_.query_levels, tick_size_);
+    }
+    publishMetrics();
+    
+    LOG_INFO(logger_, "OrderBook initialized for " + config_.symbol +
+                      " tick size " + std::to_string(tick_size_.size()) +
+                      " storage " + (usesLadder() ? "ladder" : "sorted_vector") +
+                      (arena_ ? std::string(" arena ") + MemoryArena::pageModeName(arena_->getBacking()) +
+                                " node " + std::to_string(config_.arena.numa_node) : std::string()),
+                      "OrderBook::Constructor");
+}
+
+void OrderBook::advanceTradeIds(uint64_t last_trade_id) {
+    advanceCounter(next_trade_id, last_trade_id + 1);
+}
+
+uint64_t OrderBook::getNextTradeId() {
+    return next_trade_id.load(std::memory_order_relaxed);
+}
+
+void OrderBook::advanceBookSequence(SequenceNumber last_sequence) {
+    advanceCounter(book_sequence, last_sequence);
+}
+
+SequenceNumber OrderBook::getBookSequence() {
+    return book_sequence.load(std::memory_order_relaxed);
+}
+
+OrderBook::BookConfig OrderBook::loadConfiguration(std::shared_ptr<Config> config) {
+    BookConfig book;
+    if (!config) {
+        return book;
+    }
+    book.symbol = config->getString("orderbook", "symbol", book.symbol);
+    book.tick_size = config->getDouble("orderbook", "tick_size", book.tick_size);
+    book.storage = config->getString("orderbook", "storage", "ladder") == "vector"
+        ? BookConfig::StorageMode::SortedVector
+        : BookConfig::StorageMode::Ladder;
+    book.ladder_levels = static_cast<size_t>(
+        config->getInt("orderbook", "ladder_levels", static_cast<int>(book.ladder_levels)));
+    book.ladder_max_levels = static_cast<size_t>(
+        config->getInt("orderbook", "ladder_max_levels", static_cast<int>(book.ladder_max_levels)));
+    book.max_orders = static_cast<size_t>(config->getInt("orderbook", "max_orders", 1000000));
+    book.depth_levels = static_cast<size_t>(
+        config->getInt("orderbook", "depth_levels", static_cast<int>(book.depth_levels)));
+    book.query_levels = static_cast<size_t>(
+        config->getInt("orderbook", "query_levels", static_cast<int>(book.query_levels)));
+    book.arena = MemoryArena::loadConfiguration(config);
+    return book;
+}
+
+void OrderBook::saveSnapshot(std::vector<char>& out, uint64_t journal_sequence) const {
+    // Bids then asks, best level first, each level in queue order
+    auto forEachRestingOrder = [this](auto&& visit) {
+        auto visitLevel = [&visit](const PriceLevel& level) {
+            for (const Order* order = level.head; order; order = order->next) {
+                visit(*order, level);
+            }
+        };
+        for (Side side : {Side::Buy, Side::Sell}) {
+            if (usesLadder()) {
+                (side == Side::Buy ? bid_ladder_ : ask_ladder_)
+                    .forEachFromBest(std::numeric_limits<size_t>::max(), visitLevel);
+            } else {
+                const auto& levels = side == Side::Buy ? bids_ : asks_;
+                for (auto it = levels.rbegin(); it != levels.rend(); ++it) {
+                    visitLevel(**it);
+                }
+            }
+        }
+    };
+    
+    // Interned IDs only mean something in this process, so the accounts the
+    // orders use travel with the section
+    std::vector<AccountId> accounts;
+    std::vector<bool> named(InternTable::accounts().size(), false);
+    forEachRestingOrder([&](const Order& order, const PriceLevel&) {
+        if (order.account_id < named.size() && !named[order.account_id]) {
+            named[order.account_id] = true;
+            accounts.push_back(order.account_id);
+        }
+    });
+    
+    size_t start = out.size();
+    BookSnapshotHeader header{};
+    header.magic = BookSnapshotHeader::Magic;
+    header.layout_version = BookSnapshotHeader::Version;
+    header.order_record_size = sizeof(BookSnapshotOrder);
+    header.journal_sequence = journal_sequence;
+    header.next_trade_id = getNextTradeId();
+    header.book_sequence = getBookSequence();
+    header.taken_ns = toNanoseconds(std::chrono::system_clock::now());
+    header.tick_size = tick_size_.size();
+    header.order_count = order_index_.size();
+    header.account_count = static_cast<uint32_t>(accounts.size());
+    header.symbol_length = static_cast<uint32_t>(config_.symbol.size());
+    appendBytes(out, header);
+    out.insert(out.end(), config_.symbol.begin(), config_.symbol.end());
+    
+    for (AccountId account : accounts) {
+        const std::string& name = InternTable::accounts().name(account);
+        appendBytes(out, BookSnapshotName{account, static_cast<uint32_t>(name.size())});
+        out.insert(out.end(), name.begin(), name.end());
+    }
+    
+    out.reserve(out.size() + order_index_.size() * sizeof(BookSnapshotOrder));
+    forEachRestingOrder([&](const Order& order, const PriceLevel& level) {
+        BookSnapshotOrder record{};
+        record.order_id = order.id.value;
+        record.ticks = level.ticks;
+        record.quantity = order.quantity;
+        record.filled_quantity = order.filled_quantity;
+        auto location = order_index_.find(order.id);
+        record.entered_ns = location != order_index_.end() ? toNanoseconds(location->second.metadata.timestamp) : 0;
+        record.account_id = order.account_id;
+        record.side = static_cast<uint8_t>(order.side);
+        record.type = static_cast<uint8_t>(order.type);
+        record.tif = static_cast<uint8_t>(order.tif);
+        record.status = static_cast<uint8_t>(order.status);
+        appendBytes(out, record);
+    });
+    
+    uint64_t section_size = out.size() - start;
+    std::memcpy(out.data() + start + offsetof(BookSnapshotHeader, section_size), &section_size, sizeof(section_size));
+}
+
+Result<uint64_t> OrderBook::loadSnapshot(const char* data, size_t size) {
+    BookSnapshotHeader header;
+    if (size < sizeof(header)) {
+        return Result<uint64_t>::error("Snapshot section is truncated");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != BookSnapshotHeader::Magic || header.layout_version != BookSnapshotHeader::Version ||
+        header.order_record_size != sizeof(BookSnapshotOrder)) {
+        return Result<uint64_t>::error("Not a book snapshot section, or an unsupported layout");
+    }
+    if (header.section_size < sizeof(header) || header.section_size > size) {
+        return Result<uint64_t>::error("Snapshot section is truncated");
+    }
+    if (!order_index_.empty() || getBidLevelCount() > 0 || getAskLevelCount() > 0) {
+        return Result<uint64_t>::error("Snapshots can only be loaded into an empty book");
+    }
+    
+    // Check the whole layout before touching the book
+    const char* cursor = data + sizeof(header);
+    const char* end = data + header.section_size;
+    if (static_cast<size_t>(end - cursor) < header.symbol_length) {
+        return Result<uint64_t>::error("Snapshot section is truncated");
+    }
+    std::string_view symbol(cursor, header.symbol_length);
+    cursor += header.symbol_length;
+    if (symbol != config_.symbol) {
+        return Result<uint64_t>::error("Snapshot section is for " + std::string(symbol) + ", not " + config_.symbol);
+    }
+    if (header.tick_size != tick_size_.size()) {
+        return Result<uint64_t>::error("Snapshot tick size " + std::to_string(header.tick_size) +
+                                       " differs from the book's " + std::to_string(tick_size_.size()));
+    }
+    
+    std::unordered_map<uint32_t, AccountId> accounts;
+    for (uint32_t i = 0; i < header.account_count; ++i) {
+        BookSnapshotName name;
+        if (static_cast<size_t>(end - cursor) < sizeof(name)) {
+            return Result<uint64_t>::error("Snapshot section is truncated");
+        }
+        std::memcpy(&name, cursor, sizeof(name));
+        cursor += sizeof(name);
+        if (static_cast<size_t>(end - cursor) < name.length) {
+            return Result<uint64_t>::error("Snapshot section is truncated");
+        }
+        accounts[name.id] = InternTable::accounts().intern(std::string_view(cursor, name.length));
+        cursor += name.length;
+    }
+    if (static_cast<uint64_t>(end - cursor) != header.order_count * sizeof(BookSnapshotOrder)) {
+        return Result<uint64_t>::error("Snapshot section order count does not match its size");
+    }
+    
+    if (header.order_count > config_.max_orders) {
+        order_pool_.reserve(header.order_count);
+        order_index_.reserve(header.order_count);
+    }
+    
+    // Appending in saved order rebuilds every queue as it was
+    size_t restored = 0;
+    for (uint64_t i = 0; i < header.order_count; ++i, cursor += sizeof(BookSnapshotOrder)) {
+        BookSnapshotOrder record;
+        std::memcpy(&record, cursor, sizeof(record));
+        
+        auto account = accounts.find(record.account_id);
+        Side side = static_cast<Side>(record.side);
+        Order* order_ptr = order_pool_.construct(Order(record.order_id, side, static_cast<OrderType>(record.type),
+                                                       static_cast<TimeInForce>(record.tif),
+                                                       tick_size_.toPrice(record.ticks), record.quantity, symbol_id_,
+                                                       account != accounts.end() ? account->second
+                                                                                 : InternTable::EmptyId));
+        order_ptr->filled_quantity = record.filled_quantity;
+        order_ptr->status = static_cast<OrderStatus>(record.status);
+        
+        PriceLevel* price_level = findOrCreatePriceLevel(record.ticks, side);
+        if (!price_level || order_index_.find(order_ptr->id) != order_index_.end()) {
+            LOG_ERROR(logger_, "Skipping snapshot order ID: " + std::to_string(record.order_id),
+                               "OrderBook::loadSnapshot");
+            order_pool_.destroy(order_ptr);
+            continue;
+        }
+        price_level->addOrder(order_ptr);
+        
+        Timestamp entered(std::chrono::duration_cast<Timestamp::duration>(std::chrono::nanoseconds(record.entered_ns)));
+        OrderLocation location(order_ptr, price_level, side, OrderMetadata(entered));
+        location.account_link = linkAccountOrder(order_ptr);
+        order_index_.emplace(order_ptr->id, location);
+        ++restored;
+    }
     
-    if (logger_) {
-        logger_->info("OrderBook initialized", "OrderBook::Constructor");
+    // Counters are shared by all books, so they only ever move forward
+    if (header.next_trade_id > 0) {
+        advanceTradeIds(header.next_trade_id - 1);
     }
+    advanceBookSequence(header.book_sequence);
+    
+    bbo_dirty_ = true;
+    depth_dirty_ = config_.depth_levels > 0;
+    snapshot_dirty_ = depth_snapshot_ != nullptr;
+    publishMarketDataUpdate();
+    
+    LOG_INFO(logger_, "Restored " + std::to_string(restored) + " orders for " + config_.symbol +
+                      " from snapshot at journal sequence " + std::to_string(header.journal_sequence),
+                      "OrderBook::loadSnapshot");
+    return Result<uint64_t>::success(header.journal_sequence);
 }
 
 // Core operations
@@ -27,282 +310,470 @@ OrderResult OrderBook::addOrder(const Order& order) {
     PERF_TIMER("OrderBook::addOrder", logger_);
     PERF_MEASURE("OrderBook::addOrder");
     
-    if (logger_) {
-        logger_->debug("Adding order ID: " + std::to_string(order.id.value) + 
-                      " Side: " + (order.side == Side::Buy ? "Buy" : "Sell") +
-                      " Price: " + std::to_string(order.price) +
-                      " Quantity: " + std::to_string(order.quantity), "OrderBook::addOrder");
+    // Write-ahead: the command is journaled before the book changes
+    if (journal_) {
+        journal_->recordAdd(symbol_id_, order);
     }
     
-    // Risk validation if risk manager is available
+    LOG_DEBUG(logger_, "Adding order ID: " + std::to_string(order.id.value) +
+                       " Side: " + (order.side == Side::Buy ? "Buy" : "Sell") +
+                       " Price: " + std::to_string(order.price) +
+                       " Quantity: " + std::to_string(order.quantity),
+                       "OrderBook::addOrder");
+    
+    // Risk validation if risk manager is available; keyed by the order's
+    // interned account and symbol, so no string lookups
     if (risk_manager_) {
-        // Associate order with account
-        std::string account = order.account.empty() ? "default" : order.account;
-        risk_manager_->associateOrderWithAccount(order.id, account);
-        
-        // Get the portfolio for the order's account
-        const Portfolio& portfolio = risk_manager_->getPortfolio(account);
-        auto risk_check = risk_manager_->validateOrder(order, portfolio);
+        auto risk_check = risk_prechecked_ ? risk_manager_->checkOrderPosition(order)
+                                           : risk_manager_->checkOrder(order);
         if (risk_check.isRejected()) {
-            if (logger_) {
-                logger_->error("Order rejected by risk manager: " + risk_check.reason, 
-                              "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value) + 
-                              " Account: " + account);
-            }
+            LOG_ERROR(logger_, "Order rejected by risk manager: " + risk_check.reason,
+                               "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value) +
+                               " Account: " + order.account());
             return OrderResult::error("Risk validation failed: " + risk_check.reason);
         }
         
-        if (logger_) {
-            logger_->debug("Order passed risk validation: " + risk_check.reason, 
-                          "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value) + 
-                          " Account: " + account);
-        }
+        LOG_DEBUG(logger_, "Order passed risk validation",
+                           "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value) +
+                           " Account: " + order.account());
+    }
+    
+    // Traced FIX orders record when the journal write and risk check are done
+    if (match_sink_ && match_sink_->trace) {
+        match_sink_->trace->stamp(LatencyTrace::RiskChecked);
     }
     
     // Check if order already exists
     if (order_index_.find(order.id) != order_index_.end()) {
-        if (logger_) {
-            logger_->error("Duplicate order ID: " + std::to_string(order.id.value), 
-                          "OrderBook::addOrder");
-        }
+        LOG_ERROR(logger_, "Duplicate order ID: " + std::to_string(order.id.value),
+                           "OrderBook::addOrder");
         return OrderResult::error("Order ID already exists");
     }
     
-    // Create a copy of the order for processing
-    auto order_copy = std::make_unique<Order>(order);
-    order_copy->timestamp = std::chrono::system_clock::now();
-    
-    // Find or create price level
-    PriceLevel* price_level = findOrCreatePriceLevel(order_copy->price, order_copy->side);
-    if (!price_level) {
-        if (logger_) {
-            logger_->error("Failed to create price level for price: " + std::to_string(order_copy->price) +
-                          " side: " + (order_copy->side == Side::Buy ? "Buy" : "Sell"), 
-                          "OrderBook::addOrder - OrderID: " + std::to_string(order_copy->id.value));
-        }
-        return OrderResult::error("Failed to create price level");
+    // Limit prices must lie on the instrument's tick grid
+    if (order.type == OrderType::Limit && !tick_size_.isOnTick(order.price)) {
+        LOG_ERROR(logger_, "Price " + std::to_string(order.price) + " is not a multiple of tick size " +
+                           std::to_string(tick_size_.size()),
+                           "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value));
+        return OrderResult::error("Price is not a multiple of tick size");
     }
     
-    // Add order to price level
-    price_level->addOrder(order_copy.get());
+    // Market, IOC and FOK orders match straight against the opposite side
+    if (order.isImmediate()) {
+        return addImmediateOrder(order);
+    }
     
-    // Add to order index for fast lookup
-    OrderLocation location(order_copy.get(), price_level, order_copy->side);
-    order_index_[order_copy->id] = location;
+    // A remainder that could not rest is refused before it can trade
+    if (usesLadder() && !(order.isBuy() ? bid_ladder_ : ask_ladder_).fits(tick_size_.toTicks(order.price))) {
+        LOG_ERROR(logger_, "Price " + std::to_string(order.price) + " is outside the price band",
+                           "OrderBook::addOrder - OrderID: " + std::to_string(order.id.value));
+        return OrderResult::error("Price is outside the price band");
+    }
     
-    // Release ownership - order is now managed by price level
-    Order* order_ptr = order_copy.release();
+    // Copy the order into the book's arena; no heap allocation on the hot path
+    Order* order_ptr = order_pool_.construct(order);
+    order_ptr->next = nullptr;
+    order_ptr->prev = nullptr;
     
-    // Maintain sorted order
-    maintainSortedOrder();
+    // Snap the price to its exact tick representation
+    PriceTicks order_ticks = tick_size_.toTicks(order_ptr->price);
+    order_ptr->price = tick_size_.toPrice(order_ticks);
+    OrderId order_id = order_ptr->id;
     
-    // Publish book update for order addition
-    publishBookUpdate(BookUpdate::Type::Add, order_ptr->side, order_ptr->price, 
-                     order_ptr->remainingQuantity(), price_level->order_count);
+    // Match first so a crossing order never rests against itself
+    processMatching(*order_ptr, order_ticks);
     
-    // Check for immediate matching opportunities
-    processMatching(*order_ptr);
+    if (order_ptr->isFullyFilled()) {
+        order_pool_.destroy(order_ptr);
+    } else {
+        // Find or create price level for the unfilled remainder
+        PriceLevel* price_level = findOrCreatePriceLevel(order_ticks, order_ptr->side);
+        if (!price_level) {
+            LOG_ERROR(logger_, "Failed to create price level for price: " + std::to_string(order_ptr->price) +
+                               " side: " + (order_ptr->side == Side::Buy ? "Buy" : "Sell"),
+                               "OrderBook::addOrder - OrderID: " + std::to_string(order_id.value));
+            order_pool_.destroy(order_ptr);
+            return OrderResult::error("Failed to create price level");
+        }
+        
+        // Add order to price level
+        price_level->addOrder(order_ptr);
+        
+        // Add to order index for fast lookup
+        OrderLocation location(order_ptr, price_level, order_ptr->side);
+        location.account_link = linkAccountOrder(order_ptr);
+        order_index_.emplace(order_id, location);
+        
+        // Publish book update for order addition
+        publishLevelUpdate(order_ptr->side, *price_level, true);
+    }
     
     // Publish market data update (best prices and depth)
     publishMarketDataUpdate();
     
-    if (logger_) {
-        logger_->info("Order added successfully ID: " + std::to_string(order_ptr->id.value), 
-                     "OrderBook::addOrder");
+    LOG_INFO(logger_, "Order added successfully ID: " + std::to_string(order_id.value),
+                      "OrderBook::addOrder");
+    
+    return OrderResult::success(order_id);
+}
+
+OrderResult OrderBook::addImmediateOrder(const Order& order) {
+    // Matched from a local copy: the order never enters the arena, a price level
+    // or the order index, and publishes no Add of its own
+    Order incoming = order;
+    incoming.next = nullptr;
+    incoming.prev = nullptr;
+    
+    // Market orders take any price on the opposite side
+    PriceTicks incoming_ticks;
+    if (incoming.type == OrderType::Market) {
+        incoming_ticks = incoming.isBuy() ? std::numeric_limits<PriceTicks>::max()
+                                          : std::numeric_limits<PriceTicks>::min();
+    } else {
+        incoming_ticks = tick_size_.toTicks(incoming.price);
+        incoming.price = tick_size_.toPrice(incoming_ticks);
     }
     
-    return OrderResult::success(order_ptr->id);
+    // Fill-or-kill: all of it against the liquidity available now, or nothing
+    if (incoming.tif == TimeInForce::FOK) {
+        bool fillable = incoming.isBuy() ? canFill<Side::Buy>(incoming_ticks, incoming.quantity)
+                                         : canFill<Side::Sell>(incoming_ticks, incoming.quantity);
+        if (!fillable) {
+            LOG_DEBUG(logger_, "Fill-or-kill order killed ID: " + std::to_string(incoming.id.value),
+                               "OrderBook::addImmediateOrder");
+            return OrderResult::success(incoming.id);
+        }
+    }
+    
+    processMatching(incoming, incoming_ticks);
+    
+    // Any remainder is cancelled rather than rested
+    if (!incoming.isFullyFilled()) {
+        LOG_DEBUG(logger_, "Cancelled unfilled remainder " + std::to_string(incoming.remainingQuantity()) +
+                           " of order ID: " + std::to_string(incoming.id.value),
+                           "OrderBook::addImmediateOrder");
+    }
+    
+    publishMarketDataUpdate();
+    
+    LOG_INFO(logger_, "Immediate order executed ID: " + std::to_string(incoming.id.value) +
+                      " filled: " + std::to_string(incoming.filled_quantity),
+                      "OrderBook::addImmediateOrder");
+    
+    return OrderResult::success(incoming.id);
+}
+
+OrderResult OrderBook::addOrder(const Order& order, MatchResult& result) {
+    result.trades.clear();
+    result.execution_reports.clear();
+    result.remaining_order.reset();
+    result.fully_filled = false;
+    result.total_filled_quantity = 0;
+    
+    match_sink_ = &result;
+    OrderResult added = addOrder(order);
+    match_sink_ = nullptr;
+    
+    if (added.isSuccess()) {
+        result.fully_filled = result.total_filled_quantity >= order.quantity;
+        auto resting = order_index_.find(order.id);
+        if (resting != order_index_.end()) {
+            result.remaining_order = *resting->second.order;
+        }
+    }
+    return added;
 }
 
 CancelResult OrderBook::cancelOrder(OrderId id) {
     PERF_TIMER("OrderBook::cancelOrder", logger_);
     PERF_MEASURE("OrderBook::cancelOrder");
     
-    if (logger_) {
-        logger_->debug("Canceling order ID: " + std::to_string(id.value), "OrderBook::cancelOrder");
+    if (journal_) {
+        journal_->recordCancel(symbol_id_, id);
     }
     
+    LOG_DEBUG(logger_, "Canceling order ID: " + std::to_string(id.value),
+                       "OrderBook::cancelOrder");
+    
     // Find order in index
     auto it = order_index_.find(id);
     if (it == order_index_.end()) {
-        if (logger_) {
-            logger_->warn("Cancel requested for non-existent order ID: " + std::to_string(id.value), 
-                         "OrderBook::cancelOrder");
-        }
+        LOG_WARN(logger_, "Cancel requested for non-existent order ID: " + std::to_string(id.value),
+                          "OrderBook::cancelOrder");
         return CancelResult::error("Order not found");
     }
     
-    const OrderLocation& location = it->second;
+    const OrderLocation location = it->second;
     if (!location.isValid()) {
         return CancelResult::error("Invalid order location");
     }
     
-    // Store order details before removal for book update
-    Side order_side = location.order->side;
-    Price order_price = location.order->price;
-    Quantity remaining_qty = location.order->remainingQuantity();
-    
-    // Remove from price level
-    location.price_level->removeOrder(location.order);
-    
-    // Publish book update for order removal
-    publishBookUpdate(BookUpdate::Type::Remove, order_side, order_price, 
-                     remaining_qty, location.price_level->order_count);
-    
-    // Clean up empty price level
-    if (location.price_level->isEmpty()) {
-        removePriceLevel(location.price_level, location.side);
-    }
-    
-    // Remove from order index
+    // Remove from order index, then from its level and account
     order_index_.erase(it);
-    
-    // Delete the order
-    delete location.order;
+    removeRestingOrder(location);
     
     // Publish market data update (best prices and depth)
     publishMarketDataUpdate();
     
-    if (logger_) {
-        logger_->info("Order canceled successfully ID: " + std::to_string(id.value), 
-                     "OrderBook::cancelOrder");
-    }
+    LOG_INFO(logger_, "Order canceled successfully ID: " + std::to_string(id.value),
+                      "OrderBook::cancelOrder");
     
     return CancelResult::success(true);
 }
 
+size_t OrderBook::cancelOrders(const OrderId* ids, size_t count, std::vector<OrderId>* cancelled) {
+    PERF_TIMER("OrderBook::cancelOrders", logger_);
+    
+    // Swept as one batch: emptied levels go as they empty, and each touched
+    // level and the best prices and depth are published once at the end
+    bool outermost = !batching_;
+    batching_ = true;
+    
+    size_t removed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto it = order_index_.find(ids[i]);
+        if (it == order_index_.end() || !it->second.isValid()) {
+            continue;
+        }
+        if (journal_) {
+            journal_->recordCancel(symbol_id_, ids[i]);
+        }
+        
+        const OrderLocation location = it->second;
+        order_index_.erase(it);
+        removeRestingOrder(location);
+        
+        if (cancelled) {
+            cancelled->push_back(ids[i]);
+        }
+        ++removed;
+    }
+    
+    if (outermost) {
+        batching_ = false;
+        publishBatchLevels();
+        publishMarketDataUpdate();
+    }
+    
+    LOG_INFO(logger_, "Mass cancel removed " + std::to_string(removed) + " of " + std::to_string(count) +
+                      " orders from " + config_.symbol,
+                      "OrderBook::cancelOrders");
+    return removed;
+}
+
+size_t OrderBook::cancelAccountOrders(AccountId account, std::vector<OrderId>* cancelled) {
+    mass_cancel_ids_.clear();
+    if (account < account_orders_.size()) {
+        for (AccountOrderLink* link = account_orders_[account]; link; link = link->next) {
+            mass_cancel_ids_.push_back(link->order->id);
+        }
+    }
+    return cancelOrders(mass_cancel_ids_.data(), mass_cancel_ids_.size(), cancelled);
+}
+
+size_t OrderBook::cancelAllOrders(std::vector<OrderId>* cancelled) {
+    // Collected first: erasing from the index while iterating it is not allowed
+    mass_cancel_ids_.clear();
+    mass_cancel_ids_.reserve(order_index_.size());
+    for (const auto& entry : order_index_) {
+        mass_cancel_ids_.push_back(entry.first);
+    }
+    return cancelOrders(mass_cancel_ids_.data(), mass_cancel_ids_.size(), cancelled);
+}
+
 ModifyResult OrderBook::modifyOrder(OrderId id, Price new_price, Quantity new_quantity) {
     PERF_TIMER("OrderBook::modifyOrder", logger_);
     PERF_MEASURE("OrderBook::modifyOrder");
     
-    if (logger_) {
-        logger_->debug("Modifying order ID: " + std::to_string(id.value) +
-                      " New Price: " + std::to_string(new_price) +
-                      " New Quantity: " + std::to_string(new_quantity), "OrderBook::modifyOrder");
-    }
-    
     // Find order in index
     auto it = order_index_.find(id);
+    
+    // Cutting an order to what it has already filled leaves nothing to rest:
+    // it is journaled and removed as a cancel
+    if (it != order_index_.end() && it->second.isValid() && new_quantity > 0 &&
+        new_quantity <= it->second.order->filled_quantity) {
+        auto cancelled = cancelOrder(id);
+        return cancelled.isSuccess() ? ModifyResult::success(true) : ModifyResult::error(cancelled.error());
+    }
+    
+    if (journal_) {
+        journal_->recordModify(symbol_id_, id, new_price, new_quantity);
+    }
+    
+    LOG_DEBUG(logger_, "Modifying order ID: " + std::to_string(id.value) +
+                       " New Price: " + std::to_string(new_price) +
+                       " New Quantity: " + std::to_string(new_quantity),
+                       "OrderBook::modifyOrder");
+    
     if (it == order_index_.end()) {
         return ModifyResult::error("Order not found");
     }
     
-    const OrderLocation& location = it->second;
+    OrderLocation& location = it->second;
     if (!location.isValid()) {
         return ModifyResult::error("Invalid order location");
     }
     
     Order* order = location.order;
+    PriceLevel* level = location.price_level;
     
-    // If price is changing, we need to move the order to a different price level
-    if (new_price > 0 && std::abs(order->price - new_price) > MinPriceIncrement) {
-        // Store old details for book update
-        Price old_price = order->price;
-        Quantity old_remaining = order->remainingQuantity();
-        
-        // Remove from current price level
-        location.price_level->removeOrder(order);
+    if (new_price > 0 && !tick_size_.isOnTick(new_price)) {
+        return ModifyResult::error("Price is not a multiple of tick size");
+    }
+    PriceTicks new_ticks = new_price > 0 ? tick_size_.toTicks(new_price) : level->ticks;
+    Quantity target_quantity = new_quantity > 0 ? new_quantity : order->quantity;
+    
+    if (new_ticks == level->ticks) {
+        if (target_quantity == order->quantity) {
+            return ModifyResult::success(true);     // Nothing changes
+        }
         
-        // Publish book update for removal from old price level
-        publishBookUpdate(BookUpdate::Type::Remove, order->side, old_price, 
-                         old_remaining, location.price_level->order_count);
+        Quantity old_remaining = order->remainingQuantity();
+        bool keeps_priority = target_quantity < order->quantity;
         
-        // Clean up empty price level
-        if (location.price_level->isEmpty()) {
-            removePriceLevel(location.price_level, location.side);
+        // Fast path: a reduction at the same price is adjusted in place and keeps
+        // time priority; an increase goes to the back of the level's queue
+        if (!keeps_priority && order->next) {
+            level->removeOrder(order);
+            level->addOrder(order);
+            location.metadata.timestamp = TscClock::now();
         }
         
-        // Update order price
-        order->price = new_price;
+        order->quantity = target_quantity;
+        level->total_quantity = level->total_quantity - old_remaining + order->remainingQuantity();
         
-        // Find or create new price level
-        PriceLevel* new_price_level = findOrCreatePriceLevel(new_price, order->side);
-        if (!new_price_level) {
-            // Restore order to original price level if new level creation fails
-            order->price = old_price;
-            location.price_level->addOrder(order);
+        publishLevelUpdate(order->side, *level, false);
+    } else {
+        // Price change: the destination level is found or created before the order
+        // leaves its current one, so a failure leaves the book untouched
+        PriceLevel* new_level = findOrCreatePriceLevel(new_ticks, order->side);
+        if (!new_level) {
             return ModifyResult::error("Failed to create new price level");
         }
         
-        // Add to new price level
-        new_price_level->addOrder(order);
-        
-        // Publish book update for addition to new price level
-        publishBookUpdate(BookUpdate::Type::Add, order->side, new_price, 
-                         order->remainingQuantity(), new_price_level->order_count);
-        
-        // Update order index
-        order_index_[id] = OrderLocation(order, new_price_level, order->side);
-        
-        maintainSortedOrder();
-    }
-    
-    // Update quantity if specified
-    if (new_quantity > 0) {
-        // Store old quantity for book update
-        Quantity old_remaining = order->remainingQuantity();
-        
-        // Update price level quantity
-        PriceLevel* current_level = order_index_[id].price_level;
-        current_level->total_quantity -= old_remaining;
-        
-        order->quantity = new_quantity;
-        // Reset filled quantity if new quantity is smaller
-        if (order->filled_quantity > new_quantity) {
-            order->filled_quantity = new_quantity;
+        level->removeOrder(order);
+        publishLevelUpdate(order->side, *level, false);
+        if (level->isEmpty()) {
+            removePriceLevel(level, location.side);
         }
         
-        current_level->total_quantity += order->remainingQuantity();
+        // The new quantity is applied before linking, so the destination
+        // level's update already carries the final size
+        order->price = tick_size_.toPrice(new_ticks);
+        order->quantity = target_quantity;
+        new_level->addOrder(order);
+        publishLevelUpdate(order->side, *new_level, true);
         
-        // Publish book update for quantity modification
-        publishBookUpdate(BookUpdate::Type::Modify, order->side, order->price, 
-                         order->remainingQuantity(), current_level->order_count);
+        location.price_level = new_level;
+        location.metadata.timestamp = TscClock::now();  // Re-queued at the new price
     }
     
     // Publish market data update
     publishMarketDataUpdate();
     
-    if (logger_) {
-        logger_->info("Order modified successfully ID: " + std::to_string(id.value), 
-                     "OrderBook::modifyOrder");
-    }
+    LOG_INFO(logger_, "Order modified successfully ID: " + std::to_string(id.value),
+                      "OrderBook::modifyOrder");
     
     return ModifyResult::success(true);
 }
 
+void OrderBook::applyBatch(const BookCommand* commands, size_t count, std::vector<BookCommandResult>& results) {
+    PERF_TIMER("OrderBook::applyBatch", logger_);
+    
+    // A nested call joins the outer batch
+    bool outermost = !batching_;
+    batching_ = true;
+    
+    results.reserve(results.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        results.emplace_back();
+        applyCommand(commands[i], results.back());
+    }
+    
+    if (outermost) {
+        batching_ = false;
+        publishBatchLevels();
+        publishMarketDataUpdate();
+    }
+}
+
+void OrderBook::applyCommand(const BookCommand& command, BookCommandResult& result) {
+    result.type = command.type;
+    result.order_id = command.order.id;
+    result.symbol_id = command.order.symbol_id;
+    result.source = command.source;
+    result.tag = command.tag;
+    
+    switch (command.type) {
+        case BookCommand::Type::Add: {
+            risk_prechecked_ = command.risk_prechecked;
+            command_match_.trace = command.trace;
+            auto added = addOrder(command.order, command_match_);
+            command_match_.trace = nullptr;
+            risk_prechecked_ = false;
+            result.success = added.isSuccess();
+            if (added.isError()) result.error = added.error();
+            result.trades = command_match_.trades;
+            result.resting = command_match_.hasRemainingOrder()
+                ? command_match_.remaining_order->remainingQuantity() : 0;
+            break;
+        }
+        case BookCommand::Type::Cancel: {
+            auto cancelled = cancelOrder(command.order.id);
+            result.success = cancelled.isSuccess();
+            if (cancelled.isError()) result.error = cancelled.error();
+            break;
+        }
+        case BookCommand::Type::Modify: {
+            auto modified = modifyOrder(command.order.id, command.order.price, command.order.quantity);
+            result.success = modified.isSuccess();
+            if (modified.isError()) result.error = modified.error();
+            auto resting = order_index_.find(command.order.id);
+            result.resting = resting != order_index_.end() ? resting->second.order->remainingQuantity() : 0;
+            break;
+        }
+        case BookCommand::Type::MassCancel: {
+            result.cancelled = command.order.account_id == InternTable::EmptyId
+                ? cancelAllOrders()
+                : cancelAccountOrders(command.order.account_id);
+            result.success = true;
+            break;
+        }
+    }
+}
+
 // Market data queries with O(1) performance
 std::optional<Price> OrderBook::bestBid() const {
     PERF_MEASURE("OrderBook::bestBid");
-    if (bids_.empty()) {
+    const PriceLevel* level = bestLevel(Side::Buy);
+    if (!level) {
         return std::nullopt;
     }
-    // Best bid is at the end (highest price)
-    return bids_.back().price;
+    return level->price;
 }
 
 std::optional<Price> OrderBook::bestAsk() const {
     PERF_MEASURE("OrderBook::bestAsk");
-    if (asks_.empty()) {
+    const PriceLevel* level = bestLevel(Side::Sell);
+    if (!level) {
         return std::nullopt;
     }
-    // Best ask is at the end (lowest price)
-    return asks_.back().price;
+    return level->price;
 }
 
 BestPrices OrderBook::getBestPrices() const {
     BestPrices prices;
-    prices.timestamp = std::chrono::system_clock::now();
+    prices.timestamp = TscClock::now();
+    prices.symbol_id = symbol_id_;
     
-    if (!bids_.empty()) {
-        const auto& best_bid_level = bids_.back();
-        prices.bid = best_bid_level.price;
-        prices.bid_size = best_bid_level.total_quantity;
+    if (const PriceLevel* best_bid_level = bestLevel(Side::Buy)) {
+        prices.bid = best_bid_level->price;
+        prices.bid_size = best_bid_level->total_quantity;
     }
     
-    if (!asks_.empty()) {
-        const auto& best_ask_level = asks_.back();
-        prices.ask = best_ask_level.price;
-        prices.ask_size = best_ask_level.total_quantity;
+    if (const PriceLevel* best_ask_level = bestLevel(Side::Sell)) {
+        prices.ask = best_ask_level->price;
+        prices.ask_size = best_ask_level->total_quantity;
     }
     
     return prices;
@@ -310,35 +781,97 @@ BestPrices OrderBook::getBestPrices() const {
 
 MarketDepth OrderBook::getDepth(size_t levels) const {
     MarketDepth depth;
-    depth.timestamp = std::chrono::system_clock::now();
-    
-    // Get bid levels (highest to lowest)
-    size_t bid_count = std::min(levels, bids_.size());
-    depth.bids.reserve(bid_count);
+    fillDepth(depth, levels);
+    return depth;
+}
+
+template<typename Visitor>
+void OrderBook::forEachLevelFromBest(Side side, size_t levels, Visitor&& visitor) const {
+    if (usesLadder()) {
+        // Ladders walk outwards from the best-price cursor
+        (side == Side::Buy ? bid_ladder_ : ask_ladder_).forEachFromBest(levels, visitor);
+        return;
+    }
     
-    for (size_t i = 0; i < bid_count; ++i) {
-        const auto& level = bids_[bids_.size() - 1 - i]; // Start from best (end)
-        depth.bids.emplace_back(MarketDepth::Level{
+    // Sorted vectors keep the best level at the end
+    const auto& sorted = side == Side::Buy ? bids_ : asks_;
+    size_t count = std::min(levels, sorted.size());
+    for (size_t i = 0; i < count; ++i) {
+        visitor(static_cast<const PriceLevel&>(*sorted[sorted.size() - 1 - i]));
+    }
+}
+
+void OrderBook::fillDepth(MarketDepth& depth, size_t levels) const {
+    depth.timestamp = TscClock::now();
+    depth.symbol_id = symbol_id_;
+    depth.bids.clear();
+    depth.asks.clear();
+    
+    auto append_level = [](std::vector<MarketDepth::Level>& out, const PriceLevel& level) {
+        out.emplace_back(MarketDepth::Level{
             level.price, 
             level.total_quantity, 
             level.order_count
         });
-    }
+    };
     
-    // Get ask levels (lowest to highest)
-    size_t ask_count = std::min(levels, asks_.size());
-    depth.asks.reserve(ask_count);
+    depth.bids.reserve(std::min(levels, getBidLevelCount()));
+    depth.asks.reserve(std::min(levels, getAskLevelCount()));
     
-    for (size_t i = 0; i < ask_count; ++i) {
-        const auto& level = asks_[asks_.size() - 1 - i]; // Start from best (end)
-        depth.asks.emplace_back(MarketDepth::Level{
-            level.price, 
-            level.total_quantity, 
-            level.order_count
-        });
+    forEachLevelFromBest(Side::Buy, levels, [&](const PriceLevel& level) { append_level(depth.bids, level); });
+    forEachLevelFromBest(Side::Sell, levels, [&](const PriceLevel& level) { append_level(depth.asks, level); });
+}
+
+namespace {
+
+// Per-thread copy the single-call depth queries read the snapshot into
+DepthView& queryView() {
+    thread_local DepthView view;
+    return view;
+}
+
+}
+
+Quantity OrderBook::quantityToPrice(Side side, Price limit) const {
+    if (!depth_snapshot_) {
+        return 0;
     }
-    
-    return depth;
+    DepthView& view = queryView();
+    depth_snapshot_->read(view);
+    return view.quantityTo(side, limit);
+}
+
+std::optional<Price> OrderBook::vwapForSize(Side side, Quantity size) const {
+    if (!depth_snapshot_) {
+        return std::nullopt;
+    }
+    DepthView& view = queryView();
+    depth_snapshot_->read(view);
+    return view.vwapTo(side, size);
+}
+
+std::optional<Price> OrderBook::priceForSize(Side side, Quantity size) const {
+    if (!depth_snapshot_) {
+        return std::nullopt;
+    }
+    DepthView& view = queryView();
+    depth_snapshot_->read(view);
+    return view.priceFor(side, size);
+}
+
+void OrderBook::refreshDepthSnapshot() {
+    snapshot_dirty_ = false;
+    size_t bid_count = 0;
+    size_t ask_count = 0;
+    
+    depth_snapshot_->beginWrite();
+    forEachLevelFromBest(Side::Buy, depth_snapshot_->capacity(), [&](const PriceLevel& level) {
+        depth_snapshot_->writeLevel(Side::Buy, bid_count++, level.ticks, level.total_quantity, level.price);
+    });
+    forEachLevelFromBest(Side::Sell, depth_snapshot_->capacity(), [&](const PriceLevel& level) {
+        depth_snapshot_->writeLevel(Side::Sell, ask_count++, level.ticks, level.total_quantity, level.price);
+    });
+    depth_snapshot_->endWrite(bid_count, ask_count, getBookSequence());
 }
 
 // Statistics
@@ -347,25 +880,46 @@ size_t OrderBook::getOrderCount() const {
 }
 
 size_t OrderBook::getBidLevelCount() const {
-    return bids_.size();
+    return usesLadder() ? bid_ladder_.size() : bids_.size();
 }
 
 size_t OrderBook::getAskLevelCount() const {
-    return asks_.size();
+    return usesLadder() ? ask_ladder_.size() : asks_.size();
+}
+
+const PriceLevel* OrderBook::bestLevel(Side side) const {
+    if (usesLadder()) {
+        return side == Side::Buy ? bid_ladder_.best() : ask_ladder_.best();
+    }
+    const auto& levels = (side == Side::Buy) ? bids_ : asks_;
+    // Best price is kept at the back of the sorted vector
+    return levels.empty() ? nullptr : levels.back();
 }
 
 // Helper methods for price level management
-PriceLevel* OrderBook::findOrCreatePriceLevel(Price price, Side side) {
-    // Check if price level already exists in index
-    auto it = price_index_.find(price);
-    if (it != price_index_.end()) {
-        // Verify the price level is still valid
-        PriceLevel* level = it->second;
-        if (level && std::abs(level->price - price) < MinPriceIncrement) {
+PriceLevel* OrderBook::findOrCreatePriceLevel(PriceTicks ticks, Side side) {
+    if (usesLadder()) {
+        auto& ladder = (side == Side::Buy) ? bid_ladder_ : ask_ladder_;
+        if (PriceLevel* level = ladder.find(ticks)) {
             return level;
         }
-        // Remove invalid entry
-        price_index_.erase(it);
+        
+        PriceLevel* new_level = level_pool_.construct(tick_size_.toPrice(ticks), ticks);
+        if (!ladder.insert(new_level)) {
+            LOG_ERROR(logger_, "Price " + std::to_string(tick_size_.toPrice(ticks)) +
+                               " is outside the ladder price band of " + std::to_string(ladder.maxCapacity()) +
+                               " ticks", "OrderBook::findOrCreatePriceLevel");
+            level_pool_.destroy(new_level);
+            return nullptr;
+        }
+        return new_level;
+    }
+    
+    // Check if price level already exists in this side's index
+    auto& index = indexFor(side);
+    auto it = index.find(ticks);
+    if (it != index.end()) {
+        return it->second;
     }
     
     // Create new price level
@@ -375,305 +929,393 @@ PriceLevel* OrderBook::findOrCreatePriceLevel(Price price, Side side) {
     auto insert_pos = levels.end();
     if (side == Side::Buy) {
         // For bids: insert in ascending order (best bid at end)
-        insert_pos = std::lower_bound(levels.begin(), levels.end(), price,
-            [](const PriceLevel& level, Price p) {
-                return level.price < p;
+        insert_pos = std::lower_bound(levels.begin(), levels.end(), ticks,
+            [](const PriceLevel* level, PriceTicks t) {
+                return level->ticks < t;
             });
     } else {
         // For asks: insert in descending order (best ask at end)
-        insert_pos = std::lower_bound(levels.begin(), levels.end(), price,
-            [](const PriceLevel& level, Price p) {
-                return level.price > p;
+        insert_pos = std::lower_bound(levels.begin(), levels.end(), ticks,
+            [](const PriceLevel* level, PriceTicks t) {
+                return level->ticks > t;
             });
     }
     
-    // Insert new price level at correct position
-    auto inserted_it = levels.emplace(insert_pos, price);
-    PriceLevel* new_level = &(*inserted_it);
+    // Insert new price level at correct position; existing levels never move
+    Price price = tick_size_.toPrice(ticks);
+    PriceLevel* new_level = level_pool_.construct(price, ticks);
+    levels.insert(insert_pos, new_level);
     
     // Add to price index for O(1) lookup
-    price_index_[price] = new_level;
+    index[ticks] = new_level;
     
-    if (logger_) {
-        logger_->debug("Created new price level at " + std::to_string(price) + 
-                      " for " + (side == Side::Buy ? "bids" : "asks"), 
-                      "OrderBook::findOrCreatePriceLevel");
-    }
+    LOG_DEBUG(logger_, "Created new price level at " + std::to_string(price) +
+                       " for " + (side == Side::Buy ? "bids" : "asks"),
+                       "OrderBook::findOrCreatePriceLevel");
     
     return new_level;
 }
 
+const PriceLevel* OrderBook::findPriceLevel(PriceTicks ticks, Side side) const {
+    if (usesLadder()) {
+        return (side == Side::Buy ? bid_ladder_ : ask_ladder_).find(ticks);
+    }
+    const auto& index = side == Side::Buy ? bid_index_ : ask_index_;
+    auto it = index.find(ticks);
+    return it != index.end() ? it->second : nullptr;
+}
+
 void OrderBook::removePriceLevel(PriceLevel* level, Side side) {
     if (!level) {
-        if (logger_) {
-            logger_->warn("Attempted to remove null price level", "OrderBook::removePriceLevel");
-        }
+        LOG_WARN(logger_, "Attempted to remove null price level",
+                          "OrderBook::removePriceLevel");
         return;
     }
     
     // Verify the level is actually empty before removing
     if (!level->isEmpty()) {
-        if (logger_) {
-            logger_->warn("Attempted to remove non-empty price level at " + 
-                         std::to_string(level->price), "OrderBook::removePriceLevel");
-        }
+        LOG_WARN(logger_, "Attempted to remove non-empty price level at " +
+                          std::to_string(level->price),
+                          "OrderBook::removePriceLevel");
         return;
     }
     
     Price price = level->price;
     
-    // Remove from price index first
-    auto index_it = price_index_.find(price);
-    if (index_it != price_index_.end()) {
-        price_index_.erase(index_it);
+    if (usesLadder()) {
+        auto& ladder = (side == Side::Buy) ? bid_ladder_ : ask_ladder_;
+        ladder.erase(level->ticks);
+        level_pool_.destroy(level);
+        return;
     }
     
+    // Remove from price index first
+    indexFor(side).erase(level->ticks);
+    
     // Remove from appropriate vector
     auto& levels = (side == Side::Buy) ? bids_ : asks_;
     
-    // Find and remove the level efficiently
-    auto it = std::find_if(levels.begin(), levels.end(),
-        [level](const PriceLevel& pl) { return &pl == level; });
+    // Levels are kept sorted on insert, so locate by binary search on ticks
+    auto it = (side == Side::Buy)
+        ? std::lower_bound(levels.begin(), levels.end(), level->ticks,
+              [](const PriceLevel* pl, PriceTicks t) { return pl->ticks < t; })
+        : std::lower_bound(levels.begin(), levels.end(), level->ticks,
+              [](const PriceLevel* pl, PriceTicks t) { return pl->ticks > t; });
     
-    if (it != levels.end()) {
+    if (it != levels.end() && *it == level) {
         levels.erase(it);
+        level_pool_.destroy(level);
         
-        if (logger_) {
-            logger_->debug("Removed empty price level at " + std::to_string(price) + 
-                          " from " + (side == Side::Buy ? "bids" : "asks"), 
-                          "OrderBook::removePriceLevel");
-        }
+        LOG_DEBUG(logger_, "Removed empty price level at " + std::to_string(price) +
+                           " from " + (side == Side::Buy ? "bids" : "asks"),
+                           "OrderBook::removePriceLevel");
     } else {
-        if (logger_) {
-            logger_->warn("Price level not found in vector during removal at " + 
-                         std::to_string(price), "OrderBook::removePriceLevel");
-        }
+        LOG_WARN(logger_, "Price level not found in vector during removal at " +
+                          std::to_string(price),
+                          "OrderBook::removePriceLevel");
     }
 }
 
-void OrderBook::maintainSortedOrder() {
-    // Check if vectors are already sorted to avoid unnecessary work
-    bool bids_sorted = std::is_sorted(bids_.begin(), bids_.end(),
-        [](const PriceLevel& a, const PriceLevel& b) {
-            return a.price < b.price;
-        });
+void OrderBook::removeRestingOrder(const OrderLocation& location) {
+    Order* order = location.order;
+    PriceLevel* level = location.price_level;
     
-    bool asks_sorted = std::is_sorted(asks_.begin(), asks_.end(),
-        [](const PriceLevel& a, const PriceLevel& b) {
-            return a.price > b.price;
-        });
+    level->removeOrder(order);
+    publishLevelUpdate(location.side, *level, false);
     
-    // Only sort if necessary
-    if (!bids_sorted) {
-        std::sort(bids_.begin(), bids_.end(),
-            [](const PriceLevel& a, const PriceLevel& b) {
-                return a.price < b.price;
-            });
-        
-        if (logger_) {
-            logger_->debug("Sorted bid levels", "OrderBook::maintainSortedOrder");
-        }
+    // Clean up empty price level
+    if (level->isEmpty()) {
+        removePriceLevel(level, location.side);
     }
     
-    if (!asks_sorted) {
-        std::sort(asks_.begin(), asks_.end(),
-            [](const PriceLevel& a, const PriceLevel& b) {
-                return a.price > b.price;
-            });
-        
-        if (logger_) {
-            logger_->debug("Sorted ask levels", "OrderBook::maintainSortedOrder");
-        }
+    unlinkAccountOrder(location.account_link);
+    order_pool_.destroy(order);
+}
+
+AccountOrderLink* OrderBook::linkAccountOrder(Order* order) {
+    AccountId account = order->account_id;
+    if (account == InternTable::EmptyId) {
+        return nullptr;
+    }
+    if (account >= account_orders_.size()) {
+        account_orders_.resize(account + 1, nullptr);
     }
     
-    // Rebuild price index to ensure consistency after sorting
-    rebuildPriceIndex();
+    // Pushed at the head; order within an account's list does not matter
+    AccountOrderLink* link = account_link_pool_.construct();
+    link->order = order;
+    link->next = account_orders_[account];
+    if (link->next) {
+        link->next->prev = link;
+    }
+    account_orders_[account] = link;
+    return link;
 }
 
-void OrderBook::rebuildPriceIndex() {
-    price_index_.clear();
+void OrderBook::unlinkAccountOrder(AccountOrderLink* link) {
+    if (!link) {
+        return;
+    }
+    if (link->prev) {
+        link->prev->next = link->next;
+    } else {
+        account_orders_[link->order->account_id] = link->next;
+    }
+    if (link->next) {
+        link->next->prev = link->prev;
+    }
+    account_link_pool_.destroy(link);
+}
+
+namespace {
+
+bool sameTopOfBook(const BestPrices& a, const BestPrices& b) {
+    return a.bid == b.bid && a.ask == b.ask && a.bid_size == b.bid_size && a.ask_size == b.ask_size;
+}
+
+bool sameLevels(const std::vector<MarketDepth::Level>& a, const std::vector<MarketDepth::Level>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+        [](const MarketDepth::Level& x, const MarketDepth::Level& y) {
+            return x.price == y.price && x.quantity == y.quantity && x.order_count == y.order_count;
+        });
+}
+
+}
+
+void OrderBook::publishMarketDataUpdate() {
+    // A batch publishes once, when it ends
+    if (batching_) {
+        return;
+    }
     
-    // Add all bid levels to index
-    for (auto& level : bids_) {
-        price_index_[level.price] = &level;
+    publishMetrics();
+    if (snapshot_dirty_) {
+        refreshDepthSnapshot();
+    }
+    if (!market_data_) {
+        return;
     }
     
-    // Add all ask levels to index
-    for (auto& level : asks_) {
-        price_index_[level.price] = &level;
+    // Best prices with sub-10μs latency requirement
+    if (bbo_dirty_) {
+        bbo_dirty_ = false;
+        BestPrices prices = getBestPrices();
+        if (!sameTopOfBook(prices, published_bbo_)) {
+            published_bbo_ = prices;
+            market_data_->publishBestPrices(published_bbo_);
+        }
     }
     
-    if (logger_) {
-        logger_->debug("Rebuilt price index with " + std::to_string(price_index_.size()) + 
-                      " levels", "OrderBook::rebuildPriceIndex");
+    // Top depth_levels of each side
+    if (depth_dirty_) {
+        depth_dirty_ = false;
+        fillDepth(scratch_depth_, config_.depth_levels);
+        if (!sameLevels(scratch_depth_.bids, published_depth_.bids) ||
+            !sameLevels(scratch_depth_.asks, published_depth_.asks)) {
+            std::swap(published_depth_, scratch_depth_);
+            market_data_->publishDepth(published_depth_);
+        }
     }
 }
 
-void OrderBook::publishMarketDataUpdate() {
-    if (market_data_) {
-        // Publish best prices with sub-10μs latency requirement
-        BestPrices prices = getBestPrices();
-        market_data_->publishBestPrices(prices);
-        
-        // Publish market depth (top 5 levels) for full book updates
-        MarketDepth depth = getDepth(5);
-        market_data_->publishDepth(depth);
+void OrderBook::publishMetrics() {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    metrics_.orders.store(order_index_.size(), relaxed);
+    metrics_.bid_levels.store(getBidLevelCount(), relaxed);
+    metrics_.ask_levels.store(getAskLevelCount(), relaxed);
+    
+    const PriceLevel* bid = bestLevel(Side::Buy);
+    const PriceLevel* ask = bestLevel(Side::Sell);
+    metrics_.best_bid.store(bid ? bid->price : 0.0, relaxed);
+    metrics_.best_ask.store(ask ? ask->price : 0.0, relaxed);
+    metrics_.best_bid_quantity.store(bid ? bid->total_quantity : 0, relaxed);
+    metrics_.best_ask_quantity.store(ask ? ask->total_quantity : 0, relaxed);
+    
+    metrics_.trades.store(trade_count_, relaxed);
+    metrics_.order_pool_capacity.store(order_pool_.capacity(), relaxed);
+}
+
+void OrderBook::exportMetrics(MetricsWriter& out) const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    std::string_view symbol = config_.symbol;
+    
+    out.gauge("book_orders", "Resting orders", static_cast<double>(metrics_.orders.load(relaxed)),
+              {{"symbol", symbol}});
+    out.gauge("book_levels", "Price levels per side",
+              static_cast<double>(metrics_.bid_levels.load(relaxed)), {{"symbol", symbol}, {"side", "bid"}});
+    out.gauge("book_levels", "Price levels per side",
+              static_cast<double>(metrics_.ask_levels.load(relaxed)), {{"symbol", symbol}, {"side", "ask"}});
+    out.gauge("book_best_price", "Best price per side (0 when empty)",
+              metrics_.best_bid.load(relaxed), {{"symbol", symbol}, {"side", "bid"}});
+    out.gauge("book_best_price", "Best price per side (0 when empty)",
+              metrics_.best_ask.load(relaxed), {{"symbol", symbol}, {"side", "ask"}});
+    out.gauge("book_best_quantity", "Quantity at the best price per side",
+              static_cast<double>(metrics_.best_bid_quantity.load(relaxed)), {{"symbol", symbol}, {"side", "bid"}});
+    out.gauge("book_best_quantity", "Quantity at the best price per side",
+              static_cast<double>(metrics_.best_ask_quantity.load(relaxed)), {{"symbol", symbol}, {"side", "ask"}});
+    out.counter("book_trades_total", "Trades executed", static_cast<double>(metrics_.trades.load(relaxed)),
+                {{"symbol", symbol}});
+    out.gauge("book_order_pool_capacity", "Orders the book's arena holds without growing",
+              static_cast<double>(metrics_.order_pool_capacity.load(relaxed)), {{"symbol", symbol}});
+}
+
+void OrderBook::markLevelChanged(Side side, Price price) {
+    // Level prices are canonical toPrice(ticks) values, so comparing doubles is exact
+    bool buy = side == Side::Buy;
+    
+    const std::optional<Price>& best = buy ? published_bbo_.bid : published_bbo_.ask;
+    if (!best || (buy ? price >= *best : price <= *best)) {
+        bbo_dirty_ = true;
+    }
+    
+    if (config_.depth_levels == 0 || depth_dirty_) {
+        return;
+    }
+    const auto& levels = buy ? published_depth_.bids : published_depth_.asks;
+    if (levels.size() < config_.depth_levels ||
+        (buy ? price >= levels.back().price : price <= levels.back().price)) {
+        depth_dirty_ = true;
     }
 }
 
 void OrderBook::publishBookUpdate(BookUpdate::Type type, Side side, Price price, 
                                  Quantity quantity, size_t order_count) {
+    if (depth_snapshot_ && !snapshot_dirty_) {
+        snapshot_dirty_ = depth_snapshot_->covers(side, tick_size_.toTicks(price));
+    }
     if (market_data_) {
+        markLevelChanged(side, price);
+        if (batching_) {
+            recordBatchLevel(type, side, price, order_count);
+            return;
+        }
+        
         // Create sequence number for gap detection
-        static std::atomic<SequenceNumber> book_sequence{0};
         SequenceNumber seq = ++book_sequence;
         
-        BookUpdate update(type, side, price, quantity, order_count, seq);
+        BookUpdate update(type, side, price, quantity, order_count, seq, symbol_id_);
         market_data_->publishBookUpdate(update);
     }
 }
 
-void OrderBook::processMatching(Order& incoming_order) {
-    // Simple matching logic - check if we can match against opposite side
-    auto& opposite_levels = (incoming_order.side == Side::Buy) ? asks_ : bids_;
-    
-    if (opposite_levels.empty()) {
-        return; // No opposite side orders to match against
-    }
-    
-    // Find best opposite price
-    const auto& best_level = opposite_levels.back(); // Best price is at the end
-    
-    bool can_match = false;
-    if (incoming_order.side == Side::Buy) {
-        // Buy order can match if buy price >= ask price
-        can_match = incoming_order.price >= best_level.price;
-    } else {
-        // Sell order can match if sell price <= bid price
-        can_match = incoming_order.price <= best_level.price;
-    }
-    
-    if (can_match && !best_level.isEmpty()) {
-        // Execute trades
-        executeMatching(incoming_order, opposite_levels);
-    }
+void OrderBook::publishLevelUpdate(Side side, const PriceLevel& level, bool added) {
+    // An order added to an empty level created it; otherwise it was already there
+    BookUpdate::Type type = level.isEmpty() ? BookUpdate::Type::Remove
+                          : added && level.order_count == 1 ? BookUpdate::Type::Add
+                          : BookUpdate::Type::Modify;
+    publishBookUpdate(type, side, level.price, level.isEmpty() ? 0 : level.total_quantity, level.order_count);
 }
 
-void OrderBook::executeMatching(Order& incoming_order, std::vector<PriceLevel>& opposite_levels) {
-    // Sort levels for best price first
-    if (incoming_order.side == Side::Buy) {
-        // For buy orders, sort asks ascending (lowest price first)
-        std::sort(opposite_levels.begin(), opposite_levels.end(),
-                  [](const PriceLevel& a, const PriceLevel& b) {
-                      return a.price < b.price;
-                  });
-    } else {
-        // For sell orders, sort bids descending (highest price first)
-        std::sort(opposite_levels.begin(), opposite_levels.end(),
-                  [](const PriceLevel& a, const PriceLevel& b) {
-                      return a.price > b.price;
-                  });
+void OrderBook::recordBatchLevel(BookUpdate::Type type, Side side, Price price, size_t order_count) {
+    PriceTicks ticks = tick_size_.toTicks(price);
+    auto& index = side == Side::Buy ? batch_bid_levels_ : batch_ask_levels_;
+    if (index.try_emplace(ticks, batch_levels_.size()).second) {
+        batch_levels_.push_back(BatchLevel{side, ticks, price, type == BookUpdate::Type::Add && order_count == 1});
     }
-    
-    // Match against price levels
-    for (auto& level : opposite_levels) {
-        if (level.isEmpty() || incoming_order.isFullyFilled()) {
-            break;
-        }
-        
-        // Check if we can still match at this price
-        bool can_match = false;
-        if (incoming_order.side == Side::Buy) {
-            can_match = incoming_order.price >= level.price;
+}
+
+void OrderBook::publishBatchLevels() {
+    // One update per touched level with its state after the whole batch
+    for (const BatchLevel& touched : batch_levels_) {
+        const PriceLevel* level = findPriceLevel(touched.ticks, touched.side);
+        if (!level || level->isEmpty()) {
+            if (!touched.created) {
+                publishBookUpdate(BookUpdate::Type::Remove, touched.side, touched.price, 0, 0);
+            }
         } else {
-            can_match = incoming_order.price <= level.price;
+            publishBookUpdate(touched.created ? BookUpdate::Type::Add : BookUpdate::Type::Modify,
+                              touched.side, touched.price, level->total_quantity, level->order_count);
         }
-        
-        if (!can_match) {
-            break; // No more matches possible
-        }
-        
-        // Match against orders in this price level
-        matchAgainstPriceLevel(incoming_order, level);
     }
+    batch_levels_.clear();
+    batch_bid_levels_.clear();
+    batch_ask_levels_.clear();
 }
 
-void OrderBook::matchAgainstPriceLevel(Order& incoming_order, PriceLevel& price_level) {
-    Order* current_order = price_level.getFirstOrder();
-    
-    while (current_order && !incoming_order.isFullyFilled()) {
-        // Calculate trade quantity
-        Quantity trade_quantity = std::min(incoming_order.remainingQuantity(),
-                                          current_order->remainingQuantity());
-        
-        if (trade_quantity == 0) break;
-        
-        // Execute the trade
-        executeTrade(incoming_order, *current_order, price_level.price, trade_quantity);
-        
-        // Update price level quantity
-        price_level.updateQuantity(current_order, trade_quantity);
-        
-        // Publish book update for the passive order modification/removal
-        if (current_order->isFullyFilled()) {
-            // Order fully filled - publish removal
-            publishBookUpdate(BookUpdate::Type::Remove, current_order->side, 
-                             current_order->price, 0, price_level.order_count - 1);
-        } else {
-            // Order partially filled - publish modification
-            publishBookUpdate(BookUpdate::Type::Modify, current_order->side, 
-                             current_order->price, current_order->remainingQuantity(), 
-                             price_level.order_count);
-        }
-        
-        // Move to next order if current is fully filled
-        if (current_order->isFullyFilled()) {
-            Order* next_order = current_order->next;
-            
-            // Remove filled order from order index
-            auto it = order_index_.find(current_order->id);
-            if (it != order_index_.end()) {
-                order_index_.erase(it);
-            }
-            
-            // Delete the filled order
-            delete current_order;
-            current_order = next_order;
+void OrderBook::processMatching(Order& incoming_order, PriceTicks incoming_ticks) {
+    // Dispatch on side once; the matching loop itself is specialized per side
+    if (incoming_order.isBuy()) {
+        executeMatching<Side::Buy>(incoming_order, incoming_ticks);
+    } else {
+        executeMatching<Side::Sell>(incoming_order, incoming_ticks);
+    }
+}
+
+template<Side IncomingSide>
+bool OrderBook::canFill(PriceTicks incoming_ticks, Quantity quantity) const {
+    using Kernel = MatchingKernel<IncomingSide>;
+    
+    // Sum resting quantity over crossing levels, best first, stopping once it is enough
+    Quantity available = 0;
+    if (usesLadder()) {
+        const PriceLadder& ladder = Kernel::RestingSide == Side::Buy ? bid_ladder_ : ask_ladder_;
+        for (const PriceLevel* level = ladder.best();
+             level && Kernel::crosses(incoming_ticks, level->ticks); level = ladder.next(level)) {
+            available += level->total_quantity;
+            if (available >= quantity) return true;
         }
+        return false;
     }
     
-    // Clean up empty price level
-    if (price_level.isEmpty()) {
-        Side opposite_side = (incoming_order.side == Side::Buy) ? Side::Sell : Side::Buy;
-        removePriceLevel(&price_level, opposite_side);
+    // Best price is kept at the back of the sorted vector
+    const auto& levels = Kernel::RestingSide == Side::Buy ? bids_ : asks_;
+    for (auto it = levels.rbegin(); it != levels.rend() && Kernel::crosses(incoming_ticks, (*it)->ticks); ++it) {
+        available += (*it)->total_quantity;
+        if (available >= quantity) return true;
     }
+    return false;
 }
 
-void OrderBook::executeTrade(Order& aggressive_order, Order& passive_order, 
-                            Price trade_price, Quantity trade_quantity) {
-    // Fill both orders
-    aggressive_order.fill(trade_quantity);
-    passive_order.fill(trade_quantity);
-    
-    // Create trade record
-    static uint64_t trade_counter = 1;
-    TradeId trade_id(trade_counter++);
-    
-    // Determine buy/sell order IDs
-    OrderId buy_order_id = aggressive_order.isBuy() ? aggressive_order.id : passive_order.id;
-    OrderId sell_order_id = aggressive_order.isSell() ? aggressive_order.id : passive_order.id;
+template<Side IncomingSide>
+void OrderBook::executeMatching(Order& incoming_order, PriceTicks incoming_ticks) {
+    using Kernel = MatchingKernel<IncomingSide>;
+    
+    // Both storage modes keep the best opposite level at a known position, so walk
+    // from it level by level; levels emptied by matching are removed as we go
+    Kernel::match(incoming_order, incoming_ticks,
+        [this] { return bestLevel(Kernel::RestingSide); },
+        [this, &incoming_order](Order& resting_order, PriceLevel& price_level, Quantity trade_quantity) {
+            Trade trade = Kernel::makeTrade(TradeId(next_trade_id.fetch_add(1, std::memory_order_relaxed)),
+                                            incoming_order, resting_order, price_level.price, trade_quantity);
+            executeTrade(incoming_order, resting_order, trade);
+            
+            // Publish the passive level's new state; a filled order is already
+            // unlinked, so order_count excludes it
+            publishLevelUpdate(Kernel::RestingSide, price_level, false);
+            if (resting_order.isFullyFilled()) {
+                // Filled orders leave the index and go back to the arena
+                auto it = order_index_.find(resting_order.id);
+                if (it != order_index_.end()) {
+                    unlinkAccountOrder(it->second.account_link);
+                    order_index_.erase(it);
+                }
+                order_pool_.destroy(&resting_order);
+            }
+        },
+        [this](PriceLevel& price_level) {
+            removePriceLevel(&price_level, Kernel::RestingSide);
+        });
+}
+
+void OrderBook::executeTrade(const Order& aggressive_order, const Order& passive_order, const Trade& trade) {
+    ++trade_count_;
+    if (journal_) {
+        journal_->recordTrade(trade);
+    }
     
-    Trade trade(trade_id.value, buy_order_id, sell_order_id, 
-               trade_price, trade_quantity, aggressive_order.symbol);
+    if (match_sink_) {
+        match_sink_->trades.push_back(trade);
+        match_sink_->total_filled_quantity += trade.quantity;
+    }
     
     // Update positions through risk manager
     if (risk_manager_) {
-        risk_manager_->updatePosition(trade);
+        risk_manager_->onFill(trade,
+                              aggressive_order.isBuy() ? aggressive_order.account_id : passive_order.account_id,
+                              aggressive_order.isSell() ? aggressive_order.account_id : passive_order.account_id);
         
-        if (logger_) {
-            logger_->debug("Updated positions for trade ID: " + std::to_string(trade.id.value), 
-                          "OrderBook::executeTrade");
-        }
+        LOG_DEBUG(logger_, "Updated positions for trade ID: " + std::to_string(trade.id.value),
+                           "OrderBook::executeTrade");
     }
     
     // Publish trade to market data
@@ -681,28 +1323,29 @@ void OrderBook::executeTrade(Order& aggressive_order, Order& passive_order,
         market_data_->publishTrade(trade);
     }
     
-    // Log trade execution with risk context
-    if (logger_) {
-        std::string buy_account = risk_manager_ ? risk_manager_->getAccountForOrder(trade.buy_order_id) : "unknown";
-        std::string sell_account = risk_manager_ ? risk_manager_->getAccountForOrder(trade.sell_order_id) : "unknown";
+    // Log trade execution with risk context; formatting and portfolio lookups
+    // only happen when the level is enabled
+    if (logger_ && logger_->isEnabled(LogLevel::INFO)) {
+        const std::string& buy_account = aggressive_order.isBuy() ? aggressive_order.account() : passive_order.account();
+        const std::string& sell_account = aggressive_order.isSell() ? aggressive_order.account() : passive_order.account();
         
         logger_->info("Trade executed: ID=" + std::to_string(trade.id.value) + 
                      " Buy=" + std::to_string(trade.buy_order_id.value) + " (Account: " + buy_account + ")" +
                      " Sell=" + std::to_string(trade.sell_order_id.value) + " (Account: " + sell_account + ")" +
                      " Price=" + std::to_string(trade.price) + 
                      " Qty=" + std::to_string(trade.quantity) + 
-                     " Symbol=" + trade.symbol,
+                     " Symbol=" + trade.symbol(),
                      "OrderBook::executeTrade");
         
         // Log position updates
-        if (risk_manager_) {
+        if (risk_manager_ && logger_->isEnabled(LogLevel::DEBUG)) {
             const Portfolio& buy_portfolio = risk_manager_->getPortfolio(buy_account);
             const Portfolio& sell_portfolio = risk_manager_->getPortfolio(sell_account);
             
             logger_->debug("Position updates - Buy account " + buy_account + 
-                          " new position: " + std::to_string(buy_portfolio.getPosition(trade.symbol)) +
+                          " new position: " + std::to_string(buy_portfolio.getPosition(trade.symbol())) +
                           ", Sell account " + sell_account + 
-                          " new position: " + std::to_string(sell_portfolio.getPosition(trade.symbol)),
+                          " new position: " + std::to_string(sell_portfolio.getPosition(trade.symbol())),
                           "OrderBook::executeTrade");
         }
     }
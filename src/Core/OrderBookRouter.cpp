@@ -0,0 +1,130 @@
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Utilities/Metrics.hpp"
+#include <string>
+
+namespace orderbook {
+
+OrderBookRouter::OrderBookRouter(RiskManagerPtr risk_manager,
+                                 MarketDataPublisherPtr market_data,
+                                 LoggerPtr logger)
+    : OrderBookRouter(std::move(risk_manager), std::move(market_data),
+                      std::move(logger), RouterConfig{}) {
+}
+
+OrderBookRouter::OrderBookRouter(RiskManagerPtr risk_manager,
+                                 MarketDataPublisherPtr market_data,
+                                 LoggerPtr logger,
+                                 const RouterConfig& config)
+    : config_(config),
+      risk_manager_(std::move(risk_manager)),
+      market_data_(std::move(market_data)),
+      logger_(std::move(logger)) {
+    if (config_.shard_count == 0) {
+        config_.shard_count = 1;
+    }
+    shards_.resize(config_.shard_count);
+}
+
+Result<SymbolId> OrderBookRouter::addBook(const OrderBook::BookConfig& config, uint32_t shard) {
+    if (config.symbol.empty()) {
+        return Result<SymbolId>::error("Book symbol must not be empty");
+    }
+
+    if (shard != AutoShard && shard >= shards_.size()) {
+        return Result<SymbolId>::error("Shard " + std::to_string(shard) + " out of range for " +
+                                       config.symbol);
+    }
+
+    SymbolId symbol = InternTable::symbols().intern(config.symbol);
+    if (getBook(symbol)) {
+        return Result<SymbolId>::error("Book already registered for " + config.symbol);
+    }
+
+    if (shard == AutoShard) {
+        shard = next_shard_;
+        next_shard_ = static_cast<uint32_t>((next_shard_ + 1) % shards_.size());
+    }
+
+    if (symbol >= books_.size()) {
+        books_.resize(symbol + 1);
+        shard_of_.resize(symbol + 1, AutoShard);
+    }
+
+    // A book's arena goes on the NUMA node of the CPU its shard runs on,
+    // unless the configuration names a node explicitly
+    OrderBook::BookConfig book_config = config;
+    if (book_config.arena.enabled && book_config.arena.numa_node < 0 && shard < config_.shard_cpus.size()) {
+        book_config.arena.numa_node = MemoryArena::nodeOfCpu(config_.shard_cpus[shard]);
+    }
+
+    books_[symbol] = std::make_unique<OrderBook>(risk_manager_, market_data_, logger_, book_config);
+    shard_of_[symbol] = shard;
+    shards_[shard].push_back(symbol);
+    symbols_.push_back(symbol);
+
+    LOG_INFO(logger_, "Registered book " + config.symbol + " (ID " + std::to_string(symbol) +
+                      ") on shard " + std::to_string(shard),
+                      "OrderBookRouter::addBook");
+
+    return Result<SymbolId>::success(symbol);
+}
+
+OrderBook* OrderBookRouter::getBook(std::string_view symbol) const {
+    auto id = InternTable::symbols().find(symbol);
+    return id ? getBook(*id) : nullptr;
+}
+
+OrderResult OrderBookRouter::addOrder(const Order& order) {
+    OrderBook* book = getBook(order.symbol_id);
+    if (!book) {
+        return OrderResult::error("Unknown symbol: " + order.symbol());
+    }
+    return book->addOrder(order);
+}
+
+OrderResult OrderBookRouter::addOrder(const Order& order, MatchResult& result) {
+    OrderBook* book = getBook(order.symbol_id);
+    if (!book) {
+        return OrderResult::error("Unknown symbol: " + order.symbol());
+    }
+    return book->addOrder(order, result);
+}
+
+CancelResult OrderBookRouter::cancelOrder(SymbolId symbol, OrderId id) {
+    OrderBook* book = getBook(symbol);
+    if (!book) {
+        return CancelResult::error("Unknown symbol ID: " + std::to_string(symbol));
+    }
+    return book->cancelOrder(id);
+}
+
+ModifyResult OrderBookRouter::modifyOrder(SymbolId symbol, OrderId id,
+                                          Price new_price, Quantity new_quantity) {
+    OrderBook* book = getBook(symbol);
+    if (!book) {
+        return ModifyResult::error("Unknown symbol ID: " + std::to_string(symbol));
+    }
+    return book->modifyOrder(id, new_price, new_quantity);
+}
+
+size_t OrderBookRouter::cancelAccountOrders(AccountId account) {
+    size_t cancelled = 0;
+    for (SymbolId symbol : symbols_) {
+        cancelled += books_[symbol]->cancelAccountOrders(account);
+    }
+    return cancelled;
+}
+
+const std::vector<SymbolId>& OrderBookRouter::getShardSymbols(uint32_t shard) const {
+    static const std::vector<SymbolId> empty;
+    return shard < shards_.size() ? shards_[shard] : empty;
+}
+
+void OrderBookRouter::exportMetrics(MetricsWriter& out) const {
+    out.gauge("books", "Registered order books", static_cast<double>(symbols_.size()));
+    for (SymbolId symbol : symbols_) {
+        books_[symbol]->exportMetrics(out);
+    }
+}
+
+}
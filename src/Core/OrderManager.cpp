@@ -144,7 +144,7 @@ OrderLocation OrderManager::getOrderLocation(OrderId order_id) const {
 
 void OrderManager::setOrderLocation(OrderId order_id, const OrderLocation& location) {
     if (location.isValid()) {
-        order_locations_[order_id] = location;
+        order_locations_.insert_or_assign(order_id, location);
     }
 }
 
@@ -220,8 +220,8 @@ ValidationResult OrderManager::validateOrder(const Order& order) const {
     }
     
     // Validate symbol
-    if (!isValidSymbol(order.symbol)) {
-        return ValidationResult::error("Invalid symbol: " + order.symbol);
+    if (!isValidSymbol(order.symbol())) {
+        return ValidationResult::error("Invalid symbol: " + order.symbol());
     }
     
     // Validate filled quantity
@@ -275,11 +275,11 @@ void OrderManager::logOrderEvent(const std::string& event, const Order& order) c
     
     std::stringstream ss;
     ss << event << " OrderId=" << order.id.value 
-       << " Symbol=" << order.symbol
+       << " Symbol=" << order.symbol()
        << " Side=" << (order.isBuy() ? "BUY" : "SELL")
        << " Price=" << order.price
        << " Quantity=" << order.quantity
-       << " Account=" << order.account;
+       << " Account=" << order.account();
     
     logger_->info(ss.str(), "OrderManager");
 }
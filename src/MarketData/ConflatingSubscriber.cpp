@@ -0,0 +1,180 @@
+#include "orderbook/MarketData/ConflatingSubscriber.hpp"
+#include "orderbook/Utilities/Config.hpp"
+
+namespace orderbook {
+
+ConflatingSubscriber::ConflatingSubscriber(std::shared_ptr<IMarketDataSubscriber> downstream, LoggerPtr logger)
+    : ConflatingSubscriber(std::move(downstream), std::move(logger), ConflationConfig{}) {
+}
+
+ConflatingSubscriber::ConflatingSubscriber(std::shared_ptr<IMarketDataSubscriber> downstream, LoggerPtr logger,
+                                           const ConflationConfig& config)
+    : downstream_(std::move(downstream)), logger_(std::move(logger)), config_(config) {
+}
+
+ConflatingSubscriber::~ConflatingSubscriber() {
+    stop();
+}
+
+void ConflatingSubscriber::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || !downstream_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&ConflatingSubscriber::run, this);
+}
+
+void ConflatingSubscriber::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ConflatingSubscriber::onTrade(const Trade& trade, SequenceNumber sequence) {
+    bool was_empty;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_empty = pending_.empty();
+        pending_.trades.emplace_back(trade, sequence);
+    }
+    wakeIfFirst(was_empty);
+}
+
+void ConflatingSubscriber::onBookUpdate(const BookUpdate& update) {
+    bool was_empty;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_empty = pending_.empty();
+        auto slot = pending_.levels.try_emplace(LevelKey{update.symbol_id, update.side, update.price},
+                                                PendingLevel{update, update.type == BookUpdate::Type::Add});
+        if (!slot.second) {
+            // Updates carry level totals, so the newest replaces the state but
+            // not whether the level was there at the previous delivery
+            slot.first->second.latest = update;
+        }
+        ++stats_.updates_received;
+    }
+    wakeIfFirst(was_empty);
+}
+
+void ConflatingSubscriber::onBestPrices(const BestPrices& prices, SequenceNumber sequence) {
+    bool was_empty;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_empty = pending_.empty();
+        pending_.best_prices.insert_or_assign(prices.symbol_id, std::make_pair(prices, sequence));
+        ++stats_.updates_received;
+    }
+    wakeIfFirst(was_empty);
+}
+
+void ConflatingSubscriber::onDepth(const MarketDepth& depth, SequenceNumber sequence) {
+    bool was_empty;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_empty = pending_.empty();
+        auto slot = pending_.depths.try_emplace(depth.symbol_id, depth, sequence);
+        if (!slot.second) {
+            // Copy-assign so the pending snapshot reuses its level vectors
+            slot.first->second.first = depth;
+            slot.first->second.second = sequence;
+        }
+        ++stats_.updates_received;
+    }
+    wakeIfFirst(was_empty);
+}
+
+ConflatingSubscriber::Stats ConflatingSubscriber::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+ConflatingSubscriber::ConflationConfig ConflatingSubscriber::loadConfiguration(std::shared_ptr<Config> config) {
+    ConflationConfig conflation;
+    if (!config) {
+        return conflation;
+    }
+    conflation.interval = std::chrono::microseconds(
+        config->getInt("market_data", "conflation_interval_us", static_cast<int>(conflation.interval.count())));
+    return conflation;
+}
+
+void ConflatingSubscriber::wakeIfFirst(bool was_empty) {
+    // The delivery thread only sleeps on an empty batch
+    if (was_empty) {
+        wake_.notify_one();
+    }
+}
+
+void ConflatingSubscriber::run() {
+    auto last_delivery = std::chrono::steady_clock::now() - config_.interval;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return !running_ || !pending_.empty(); });
+        if (pending_.empty()) {
+            break;      // Stopped with nothing left to deliver
+        }
+
+        // Let updates accumulate until the cadence allows the next delivery
+        if (config_.interval.count() > 0) {
+            wake_.wait_until(lock, last_delivery + config_.interval, [this] { return !running_; });
+        }
+
+        pending_.swap(delivering_);
+        stats_.trades_delivered += delivering_.trades.size();
+        ++stats_.batches_delivered;
+
+        lock.unlock();
+        size_t delivered = deliver(delivering_);
+        delivering_.clear();
+        last_delivery = std::chrono::steady_clock::now();
+        lock.lock();
+        stats_.updates_delivered += delivered;
+    }
+}
+
+size_t ConflatingSubscriber::deliver(Batch& batch) {
+    size_t delivered = 0;
+    try {
+        // Trades first so book state never appears ahead of the fills that caused it
+        for (const auto& [trade, sequence] : batch.trades) {
+            downstream_->onTrade(trade, sequence);
+        }
+        for (auto& entry : batch.levels) {
+            PendingLevel& level = entry.second;
+            if (level.latest.type == BookUpdate::Type::Remove) {
+                if (level.appeared) {
+                    continue;       // Came and went since the last delivery
+                }
+            } else {
+                level.latest.type = level.appeared ? BookUpdate::Type::Add : BookUpdate::Type::Modify;
+            }
+            downstream_->onBookUpdate(level.latest);
+            ++delivered;
+        }
+        for (const auto& entry : batch.best_prices) {
+            downstream_->onBestPrices(entry.second.first, entry.second.second);
+            ++delivered;
+        }
+        for (const auto& entry : batch.depths) {
+            downstream_->onDepth(entry.second.first, entry.second.second);
+            ++delivered;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR(logger_, std::string("Subscriber threw during delivery: ") + e.what(),
+                           "ConflatingSubscriber::deliver");
+    }
+    return delivered;
+}
+
+}
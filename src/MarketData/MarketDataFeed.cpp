@@ -1,24 +1,53 @@
 #include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "orderbook/MarketData/ConflatingSubscriber.hpp"
 #include "orderbook/Utilities/PerformanceTimer.hpp"
+#include "orderbook/Utilities/Metrics.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <thread>
 
 namespace orderbook {
 
+MarketDataPublisher::RegistryGuard::RegistryGuard(const MarketDataPublisher& publisher) {
+    // Register under the current epoch, retrying if a writer flipped it in
+    // between; once registered, that writer's grace period covers us
+    while (true) {
+        uint64_t epoch = publisher.registry_epoch_.load();
+        readers_ = &publisher.readers_[epoch & 1].count;
+        readers_->fetch_add(1);
+        if (publisher.registry_epoch_.load() == epoch) {
+            break;
+        }
+        readers_->fetch_sub(1);
+    }
+    registry_ = publisher.registry_.load();
+}
+
+MarketDataPublisher::RegistryGuard::~RegistryGuard() {
+    readers_->fetch_sub(1, std::memory_order_release);
+}
+
 MarketDataPublisher::MarketDataPublisher(LoggerPtr logger) 
-    : sequence_number_(0), logger_(logger) {
+    : registry_(new Registry()), sequence_number_(0), logger_(logger) {
     if (logger_) {
         logger_->info("MarketDataPublisher initialized", "MarketDataPublisher::ctor");
     }
 }
 
+MarketDataPublisher::~MarketDataPublisher() {
+    for (auto& stage : conflated_subscribers_) {
+        stage->stop();
+    }
+    delete registry_.load();
+}
+
 void MarketDataPublisher::publishTrade(const Trade& trade) {
     PERF_TIMER("MarketDataPublisher::publishTrade", logger_);
     
     if (logger_) {
         logger_->debug("Publishing trade ID: " + std::to_string(trade.id.value) +
-                      " Symbol: " + trade.symbol + " Price: " + std::to_string(trade.price) +
+                      " Symbol: " + trade.symbol() + " Price: " + std::to_string(trade.price) +
                       " Quantity: " + std::to_string(trade.quantity), "MarketDataPublisher::publishTrade");
     }
     
@@ -27,21 +56,22 @@ void MarketDataPublisher::publishTrade(const Trade& trade) {
     // Generate sequence number for gap detection
     SequenceNumber seq = ++sequence_number_;
     
+    RegistryGuard registry(*this);
+    
     // Notify typed subscribers first (fastest path)
-    notifyTypedSubscribers(trade, seq);
+    notifyTypedSubscribers(*registry, [&trade, seq](IMarketDataSubscriber& subscriber) {
+        subscriber.onTrade(trade, seq);
+    });
     
-    // Format and notify string subscribers
-    std::string message = formatTradeMessage(trade, seq);
-    notifyStringSubscribers(message);
+    // Format only when someone consumes strings
+    if (!registry->string_subscribers.empty()) {
+        notifyStringSubscribers(*registry, formatTradeMessage(trade, seq));
+    }
     
     // Record performance metrics
     auto end_time = getCurrentTimeNs();
     recordLatency(end_time - start_time);
-    
-    {
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        stats_.trades_published++;
-    }
+    stats_.trades_published.fetch_add(1, std::memory_order_relaxed);
     
     if (logger_) {
         logger_->debug("Trade published successfully, sequence: " + std::to_string(seq), 
@@ -52,21 +82,22 @@ void MarketDataPublisher::publishTrade(const Trade& trade) {
 void MarketDataPublisher::publishBookUpdate(const BookUpdate& update) {
     auto start_time = getCurrentTimeNs();
     
+    RegistryGuard registry(*this);
+    
     // Notify typed subscribers
-    notifyTypedSubscribers(update);
+    notifyTypedSubscribers(*registry, [&update](IMarketDataSubscriber& subscriber) {
+        subscriber.onBookUpdate(update);
+    });
     
     // Format and notify string subscribers
-    std::string message = formatBookUpdateMessage(update);
-    notifyStringSubscribers(message);
+    if (!registry->string_subscribers.empty()) {
+        notifyStringSubscribers(*registry, formatBookUpdateMessage(update));
+    }
     
     // Record performance metrics
     auto end_time = getCurrentTimeNs();
     recordLatency(end_time - start_time);
-    
-    {
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        stats_.book_updates_published++;
-    }
+    stats_.book_updates_published.fetch_add(1, std::memory_order_relaxed);
 }
 
 void MarketDataPublisher::publishBestPrices(const BestPrices& prices) {
@@ -75,21 +106,22 @@ void MarketDataPublisher::publishBestPrices(const BestPrices& prices) {
     // Generate sequence number for gap detection
     SequenceNumber seq = ++sequence_number_;
     
+    RegistryGuard registry(*this);
+    
     // Notify typed subscribers
-    notifyTypedSubscribers(prices, seq);
+    notifyTypedSubscribers(*registry, [&prices, seq](IMarketDataSubscriber& subscriber) {
+        subscriber.onBestPrices(prices, seq);
+    });
     
     // Format and notify string subscribers
-    std::string message = formatBestPricesMessage(prices, seq);
-    notifyStringSubscribers(message);
+    if (!registry->string_subscribers.empty()) {
+        notifyStringSubscribers(*registry, formatBestPricesMessage(prices, seq));
+    }
     
     // Record performance metrics
     auto end_time = getCurrentTimeNs();
     recordLatency(end_time - start_time);
-    
-    {
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        stats_.best_price_updates_published++;
-    }
+    stats_.best_price_updates_published.fetch_add(1, std::memory_order_relaxed);
 }
 
 void MarketDataPublisher::publishDepth(const MarketDepth& depth) {
@@ -98,45 +130,81 @@ void MarketDataPublisher::publishDepth(const MarketDepth& depth) {
     // Generate sequence number for gap detection
     SequenceNumber seq = ++sequence_number_;
     
+    RegistryGuard registry(*this);
+    
     // Notify typed subscribers
-    notifyTypedSubscribers(depth, seq);
+    notifyTypedSubscribers(*registry, [&depth, seq](IMarketDataSubscriber& subscriber) {
+        subscriber.onDepth(depth, seq);
+    });
     
     // Format and notify string subscribers
-    std::string message = formatDepthMessage(depth, seq);
-    notifyStringSubscribers(message);
+    if (!registry->string_subscribers.empty()) {
+        notifyStringSubscribers(*registry, formatDepthMessage(depth, seq));
+    }
     
     // Record performance metrics
     auto end_time = getCurrentTimeNs();
     recordLatency(end_time - start_time);
-    
-    {
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        stats_.depth_updates_published++;
-    }
+    stats_.depth_updates_published.fetch_add(1, std::memory_order_relaxed);
 }
 
 void MarketDataPublisher::subscribe(std::function<void(const std::string&)> callback) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    string_subscribers_.push_back(std::move(callback));
+    updateRegistry([&callback](Registry& registry) {
+        registry.string_subscribers.push_back(std::move(callback));
+    });
 }
 
 void MarketDataPublisher::subscribe(std::shared_ptr<IMarketDataSubscriber> subscriber) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    typed_subscribers_.push_back(subscriber);
+    updateRegistry([&subscriber](Registry& registry) {
+        registry.typed_subscribers.push_back(subscriber);
+    });
+}
+
+void MarketDataPublisher::subscribeConflated(std::shared_ptr<IMarketDataSubscriber> subscriber,
+                                             std::chrono::microseconds interval) {
+    ConflatingSubscriber::ConflationConfig config;
+    config.interval = interval;
+    auto stage = std::make_shared<ConflatingSubscriber>(std::move(subscriber), logger_, config);
+    stage->start();
+    
+    updateRegistry([this, &stage](Registry& registry) {
+        registry.typed_subscribers.push_back(stage);
+        conflated_subscribers_.push_back(stage);
+    });
 }
 
 void MarketDataPublisher::unsubscribe(std::shared_ptr<IMarketDataSubscriber> subscriber) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    
-    // Remove matching subscribers
-    typed_subscribers_.erase(
-        std::remove_if(typed_subscribers_.begin(), typed_subscribers_.end(),
-            [&subscriber](const std::weak_ptr<IMarketDataSubscriber>& weak_sub) {
-                auto shared_sub = weak_sub.lock();
-                return !shared_sub || shared_sub == subscriber;
-            }),
-        typed_subscribers_.end()
-    );
+    std::vector<std::shared_ptr<ConflatingSubscriber>> stopped;
+    updateRegistry([this, &subscriber, &stopped](Registry& registry) {
+        // Conflation stages wrapping this subscriber go with it
+        auto stage_end = std::stable_partition(conflated_subscribers_.begin(), conflated_subscribers_.end(),
+            [&subscriber](const std::shared_ptr<ConflatingSubscriber>& stage) {
+                return stage->getDownstream() != subscriber;
+            });
+        stopped.assign(stage_end, conflated_subscribers_.end());
+        conflated_subscribers_.erase(stage_end, conflated_subscribers_.end());
+        
+        // Remove matching subscribers
+        registry.typed_subscribers.erase(
+            std::remove_if(registry.typed_subscribers.begin(), registry.typed_subscribers.end(),
+                [&subscriber, &stopped](const std::weak_ptr<IMarketDataSubscriber>& weak_sub) {
+                    auto shared_sub = weak_sub.lock();
+                    if (shared_sub == subscriber) {
+                        return true;
+                    }
+                    return std::any_of(stopped.begin(), stopped.end(),
+                        [&shared_sub](const std::shared_ptr<ConflatingSubscriber>& stage) {
+                            return stage == shared_sub;
+                        });
+                }),
+            registry.typed_subscribers.end()
+        );
+    });
+    
+    // Joined outside the lock so publishing is not held up by a final delivery
+    for (auto& stage : stopped) {
+        stage->stop();
+    }
 }
 
 SequenceNumber MarketDataPublisher::getSequenceNumber() const {
@@ -144,34 +212,67 @@ SequenceNumber MarketDataPublisher::getSequenceNumber() const {
 }
 
 size_t MarketDataPublisher::getSubscriberCount() const {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    
-    // Clean up expired subscribers before counting
-    const_cast<MarketDataPublisher*>(this)->cleanupExpiredSubscribers();
-    
-    return string_subscribers_.size() + typed_subscribers_.size();
+    RegistryGuard registry(*this);
+    
+    // Expired subscribers are only dropped on the next change, so skip them here
+    size_t live = std::count_if(registry->typed_subscribers.begin(), registry->typed_subscribers.end(),
+        [](const std::weak_ptr<IMarketDataSubscriber>& weak_sub) {
+            return !weak_sub.expired();
+        });
+    return registry->string_subscribers.size() + live;
 }
 
 uint64_t MarketDataPublisher::getTotalPublishedMessages() const {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    return stats_.trades_published + stats_.book_updates_published + 
-           stats_.best_price_updates_published + stats_.depth_updates_published;
+    return stats_.trades_published.load(std::memory_order_relaxed) +
+           stats_.book_updates_published.load(std::memory_order_relaxed) +
+           stats_.best_price_updates_published.load(std::memory_order_relaxed) +
+           stats_.depth_updates_published.load(std::memory_order_relaxed);
 }
 
 MarketDataPublisher::PublishingStats MarketDataPublisher::getStats() const {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    return stats_;
+    PublishingStats stats;
+    stats.trades_published = stats_.trades_published.load(std::memory_order_relaxed);
+    stats.book_updates_published = stats_.book_updates_published.load(std::memory_order_relaxed);
+    stats.best_price_updates_published = stats_.best_price_updates_published.load(std::memory_order_relaxed);
+    stats.depth_updates_published = stats_.depth_updates_published.load(std::memory_order_relaxed);
+    stats.total_latency_ns = stats_.total_latency_ns.load(std::memory_order_relaxed);
+    stats.max_latency_ns = stats_.max_latency_ns.load(std::memory_order_relaxed);
+    stats.min_latency_ns = stats_.min_latency_ns.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void MarketDataPublisher::resetStats() {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_ = PublishingStats{};
+    stats_.trades_published.store(0, std::memory_order_relaxed);
+    stats_.book_updates_published.store(0, std::memory_order_relaxed);
+    stats_.best_price_updates_published.store(0, std::memory_order_relaxed);
+    stats_.depth_updates_published.store(0, std::memory_order_relaxed);
+    stats_.total_latency_ns.store(0, std::memory_order_relaxed);
+    stats_.max_latency_ns.store(0, std::memory_order_relaxed);
+    stats_.min_latency_ns.store(UINT64_MAX, std::memory_order_relaxed);
+}
+
+void MarketDataPublisher::exportMetrics(MetricsWriter& out) const {
+    PublishingStats stats = getStats();
+    const char* help = "Market data messages published";
+    out.counter("md_published_total", help, static_cast<double>(stats.trades_published), {{"type", "trade"}});
+    out.counter("md_published_total", help, static_cast<double>(stats.book_updates_published),
+                {{"type", "book_update"}});
+    out.counter("md_published_total", help, static_cast<double>(stats.best_price_updates_published),
+                {{"type", "best_prices"}});
+    out.counter("md_published_total", help, static_cast<double>(stats.depth_updates_published),
+                {{"type", "depth"}});
+    out.counter("md_publish_latency_ns_total", "Nanoseconds spent fanning messages out to subscribers",
+                static_cast<double>(stats.total_latency_ns));
+    out.gauge("md_publish_latency_max_ns", "Slowest fan-out of one message",
+              static_cast<double>(stats.max_latency_ns));
+    out.gauge("md_subscribers", "Live market data subscribers", static_cast<double>(getSubscriberCount()));
+    out.gauge("md_sequence", "Last market data sequence number", static_cast<double>(getSequenceNumber()));
 }
 
 std::string MarketDataPublisher::formatTradeMessage(const Trade& trade, SequenceNumber seq) const {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(2);
-    oss << "TRADE|" << seq << "|" << trade.id.value << "|" << trade.symbol 
+    oss << "TRADE|" << seq << "|" << trade.id.value << "|" << trade.symbol() 
         << "|" << trade.price << "|" << trade.quantity 
         << "|" << trade.buy_order_id.value << "|" << trade.sell_order_id.value
         << "|" << std::chrono::duration_cast<std::chrono::microseconds>(
@@ -244,10 +345,8 @@ std::string MarketDataPublisher::formatDepthMessage(const MarketDepth& depth, Se
     return oss.str();
 }
 
-void MarketDataPublisher::notifyStringSubscribers(const std::string& message) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    
-    for (const auto& subscriber : string_subscribers_) {
+void MarketDataPublisher::notifyStringSubscribers(const Registry& registry, const std::string& message) {
+    for (const auto& subscriber : registry.string_subscribers) {
         try {
             subscriber(message);
         } catch (const std::exception& e) {
@@ -257,104 +356,62 @@ void MarketDataPublisher::notifyStringSubscribers(const std::string& message) {
     }
 }
 
-void MarketDataPublisher::notifyTypedSubscribers(const Trade& trade, SequenceNumber seq) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    
-    for (auto it = typed_subscribers_.begin(); it != typed_subscribers_.end();) {
-        if (auto subscriber = it->lock()) {
+template<typename Callback>
+void MarketDataPublisher::notifyTypedSubscribers(const Registry& registry, Callback&& callback) {
+    for (const auto& weak_sub : registry.typed_subscribers) {
+        // Expired entries stay in the shared registry until the next change
+        if (auto subscriber = weak_sub.lock()) {
             try {
-                subscriber->onTrade(trade, seq);
-                ++it;
+                callback(*subscriber);
             } catch (const std::exception& e) {
                 // Log error but continue with other subscribers
-                ++it;
             }
-        } else {
-            // Remove expired weak pointer
-            it = typed_subscribers_.erase(it);
         }
     }
 }
 
-void MarketDataPublisher::notifyTypedSubscribers(const BookUpdate& update) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+template<typename Update>
+void MarketDataPublisher::updateRegistry(Update&& update) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
     
-    for (auto it = typed_subscribers_.begin(); it != typed_subscribers_.end();) {
-        if (auto subscriber = it->lock()) {
-            try {
-                subscriber->onBookUpdate(update);
-                ++it;
-            } catch (const std::exception& e) {
-                // Log error but continue with other subscribers
-                ++it;
-            }
-        } else {
-            // Remove expired weak pointer
-            it = typed_subscribers_.erase(it);
-        }
-    }
-}
-
-void MarketDataPublisher::notifyTypedSubscribers(const BestPrices& prices, SequenceNumber seq) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    auto next = std::make_unique<Registry>(*registry_.load());
+    update(*next);
     
-    for (auto it = typed_subscribers_.begin(); it != typed_subscribers_.end();) {
-        if (auto subscriber = it->lock()) {
-            try {
-                subscriber->onBestPrices(prices, seq);
-                ++it;
-            } catch (const std::exception& e) {
-                // Log error but continue with other subscribers
-                ++it;
-            }
-        } else {
-            // Remove expired weak pointer
-            it = typed_subscribers_.erase(it);
-        }
-    }
-}
-
-void MarketDataPublisher::notifyTypedSubscribers(const MarketDepth& depth, SequenceNumber seq) {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    // Remove expired weak pointers
+    next->typed_subscribers.erase(
+        std::remove_if(next->typed_subscribers.begin(), next->typed_subscribers.end(),
+            [](const std::weak_ptr<IMarketDataSubscriber>& weak_sub) {
+                return weak_sub.expired();
+            }),
+        next->typed_subscribers.end()
+    );
     
-    for (auto it = typed_subscribers_.begin(); it != typed_subscribers_.end();) {
-        if (auto subscriber = it->lock()) {
-            try {
-                subscriber->onDepth(depth, seq);
-                ++it;
-            } catch (const std::exception& e) {
-                // Log error but continue with other subscribers
-                ++it;
-            }
-        } else {
-            // Remove expired weak pointer
-            it = typed_subscribers_.erase(it);
-        }
+    const Registry* previous = registry_.exchange(next.release());
+    
+    // Grace period: new publishes see the new registry, so once everyone
+    // registered under the old epoch has left, nobody can hold `previous`
+    uint64_t epoch = registry_epoch_.fetch_add(1);
+    while (readers_[epoch & 1].count.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
     }
+    delete previous;
 }
 
 void MarketDataPublisher::recordLatency(uint64_t latency_ns) {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.total_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
     
-    stats_.total_latency_ns += latency_ns;
-    stats_.max_latency_ns = std::max(stats_.max_latency_ns, latency_ns);
-    stats_.min_latency_ns = std::min(stats_.min_latency_ns, latency_ns);
+    uint64_t observed = stats_.max_latency_ns.load(std::memory_order_relaxed);
+    while (latency_ns > observed &&
+           !stats_.max_latency_ns.compare_exchange_weak(observed, latency_ns, std::memory_order_relaxed)) {
+    }
+    observed = stats_.min_latency_ns.load(std::memory_order_relaxed);
+    while (latency_ns < observed &&
+           !stats_.min_latency_ns.compare_exchange_weak(observed, latency_ns, std::memory_order_relaxed)) {
+    }
 }
 
 uint64_t MarketDataPublisher::getCurrentTimeNs() const {
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    return static_cast<uint64_t>(TscClock::nowNanoseconds());
 }
 
-void MarketDataPublisher::cleanupExpiredSubscribers() {
-    // Remove expired weak pointers
-    typed_subscribers_.erase(
-        std::remove_if(typed_subscribers_.begin(), typed_subscribers_.end(),
-            [](const std::weak_ptr<IMarketDataSubscriber>& weak_sub) {
-                return weak_sub.expired();
-            }),
-        typed_subscribers_.end()
-    );
 }
-
-}
\ No newline at end of file
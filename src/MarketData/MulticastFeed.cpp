@@ -0,0 +1,349 @@
+#include "orderbook/MarketData/MulticastFeed.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace orderbook {
+
+namespace {
+
+int64_t toNanoseconds(Timestamp timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+template<typename Message>
+multicast::MessageHeader headerFor(multicast::MessageType type) {
+    static_assert(sizeof(Message) <= std::numeric_limits<uint8_t>::max(), "Message length must fit its header");
+    return multicast::MessageHeader{type, static_cast<uint8_t>(sizeof(Message))};
+}
+
+void beginDatagram(std::vector<uint8_t>& datagram, uint64_t sequence, multicast::Channel channel) {
+    multicast::PacketHeader header{};
+    header.sequence = sequence;
+    header.channel = channel;
+    header.version = multicast::ProtocolVersion;
+    datagram.resize(sizeof(header));
+    std::memcpy(datagram.data(), &header, sizeof(header));
+}
+
+void setMessageCount(std::vector<uint8_t>& datagram, uint16_t count) {
+    std::memcpy(datagram.data() + offsetof(multicast::PacketHeader, message_count), &count, sizeof(count));
+}
+
+template<typename Message>
+void appendMessage(std::vector<uint8_t>& datagram, const Message& message) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&message);
+    datagram.insert(datagram.end(), bytes, bytes + sizeof(Message));
+}
+
+}
+
+MulticastFeedPublisher::MulticastFeedPublisher(LoggerPtr logger)
+    : MulticastFeedPublisher(std::move(logger), FeedConfig{}) {
+}
+
+MulticastFeedPublisher::MulticastFeedPublisher(LoggerPtr logger, const FeedConfig& config)
+    : logger_(std::move(logger)), config_(config), socket_(io_context_) {
+    // Every datagram must at least hold its header and one message
+    config_.max_datagram = std::max<size_t>(config_.max_datagram, 256);
+    config_.snapshot_levels = std::min<size_t>(config_.snapshot_levels, std::numeric_limits<uint16_t>::max());
+}
+
+MulticastFeedPublisher::~MulticastFeedPublisher() {
+    stop();
+}
+
+Result<bool> MulticastFeedPublisher::start() {
+    using boost::asio::ip::udp;
+    namespace mc = boost::asio::ip::multicast;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return Result<bool>::success(true);
+    }
+
+    try {
+        incremental_endpoint_ = udp::endpoint(boost::asio::ip::make_address(config_.incremental_group),
+                                              config_.incremental_port);
+        snapshot_endpoint_ = udp::endpoint(boost::asio::ip::make_address(config_.snapshot_group),
+                                           config_.snapshot_port);
+
+        socket_.open(incremental_endpoint_.protocol());
+        socket_.set_option(mc::hops(config_.ttl));
+        socket_.set_option(mc::enable_loopback(config_.loopback));
+        if (!config_.interface_address.empty()) {
+            socket_.set_option(mc::outbound_interface(boost::asio::ip::make_address_v4(config_.interface_address)));
+        }
+    } catch (const boost::system::system_error& e) {
+        boost::system::error_code ignored;
+        socket_.close(ignored);
+        return Result<bool>::error(std::string("Failed to open multicast socket: ") + e.what());
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MulticastFeedPublisher::run, this);
+    return Result<bool>::success(true);
+}
+
+void MulticastFeedPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+}
+
+void MulticastFeedPublisher::onTrade(const Trade& trade, SequenceNumber) {
+    multicast::TradeMessage message{};
+    message.header = headerFor<multicast::TradeMessage>(multicast::MessageType::Trade);
+    message.symbol_id = trade.symbol_id;
+    message.trade_id = trade.id.value;
+    message.price = trade.price;
+    message.quantity = trade.quantity;
+    message.timestamp_ns = toNanoseconds(trade.timestamp);
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        wake = appendIncremental(message);
+    }
+    if (wake) {
+        wake_.notify_one();
+    }
+}
+
+void MulticastFeedPublisher::onBookUpdate(const BookUpdate& update) {
+    multicast::BookUpdateMessage message{};
+    message.header = headerFor<multicast::BookUpdateMessage>(multicast::MessageType::BookUpdate);
+    message.symbol_id = update.symbol_id;
+    message.side = static_cast<uint8_t>(update.side);
+    message.update_type = static_cast<uint8_t>(update.type);
+    message.price = update.price;
+    message.quantity = update.quantity;
+    message.order_count = static_cast<uint32_t>(update.order_count);
+    message.book_sequence = update.sequence;
+    message.timestamp_ns = toNanoseconds(update.timestamp);
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        wake = appendIncremental(message);
+    }
+    if (wake) {
+        wake_.notify_one();
+    }
+}
+
+uint64_t MulticastFeedPublisher::getLastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_sequence_ - 1;
+}
+
+MulticastFeedPublisher::Stats MulticastFeedPublisher::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+MulticastFeedPublisher::FeedConfig MulticastFeedPublisher::loadConfiguration(std::shared_ptr<Config> config) {
+    FeedConfig feed;
+    if (!config) {
+        return feed;
+    }
+    feed.incremental_group = config->getString("multicast", "incremental_group", feed.incremental_group);
+    feed.incremental_port = static_cast<uint16_t>(
+        config->getInt("multicast", "incremental_port", feed.incremental_port));
+    feed.snapshot_group = config->getString("multicast", "snapshot_group", feed.snapshot_group);
+    feed.snapshot_port = static_cast<uint16_t>(
+        config->getInt("multicast", "snapshot_port", feed.snapshot_port));
+    feed.interface_address = config->getString("multicast", "interface", feed.interface_address);
+    feed.ttl = config->getInt("multicast", "ttl", feed.ttl);
+    feed.loopback = config->getBool("multicast", "loopback", feed.loopback);
+    feed.max_datagram = static_cast<size_t>(
+        config->getInt("multicast", "max_datagram", static_cast<int>(feed.max_datagram)));
+    feed.flush_interval = std::chrono::microseconds(
+        config->getInt("multicast", "flush_interval_us", static_cast<int>(feed.flush_interval.count())));
+    feed.snapshot_interval = std::chrono::milliseconds(
+        config->getInt("multicast", "snapshot_interval_ms", static_cast<int>(feed.snapshot_interval.count())));
+    feed.snapshot_levels = static_cast<size_t>(
+        config->getInt("multicast", "snapshot_levels", static_cast<int>(feed.snapshot_levels)));
+    return feed;
+}
+
+template<typename Message>
+bool MulticastFeedPublisher::appendIncremental(const Message& message) {
+    bool sealed = false;
+    if (filling_count_ > 0 && (filling_.size() + sizeof(Message) > config_.max_datagram ||
+                               filling_count_ == std::numeric_limits<uint16_t>::max())) {
+        sealFilling();
+        sealed = true;
+    }
+    if (filling_count_ == 0) {
+        if (filling_.capacity() == 0 && !spare_.empty()) {
+            filling_ = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        beginDatagram(filling_, next_sequence_, multicast::Channel::Incremental);
+    }
+    appendMessage(filling_, message);
+    ++next_sequence_;
+
+    // The feed thread sleeps until a datagram is started or sealed
+    return ++filling_count_ == 1 || sealed;
+}
+
+void MulticastFeedPublisher::sealFilling() {
+    setMessageCount(filling_, filling_count_);
+    stats_.messages_sent += filling_count_;
+    ready_.push_back(std::move(filling_));
+    filling_ = Datagram{};
+    filling_count_ = 0;
+}
+
+void MulticastFeedPublisher::run() {
+    auto next_snapshot = std::chrono::steady_clock::now() + config_.snapshot_interval;
+    std::vector<Datagram> sending;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        auto has_work = [this] { return !running_ || !ready_.empty() || filling_count_ > 0; };
+        if (snapshot_source_) {
+            wake_.wait_until(lock, next_snapshot, has_work);
+        } else {
+            wake_.wait(lock, has_work);
+        }
+
+        // Give a partial datagram up to flush_interval to fill before sending it
+        if (running_ && ready_.empty() && filling_count_ > 0) {
+            wake_.wait_for(lock, config_.flush_interval, [this] { return !running_ || !ready_.empty(); });
+        }
+        if (filling_count_ > 0 && (ready_.empty() || !running_)) {
+            sealFilling();
+        }
+
+        sending.swap(ready_);
+        bool stopping = !running_;
+        lock.unlock();
+
+        uint64_t errors = 0;
+        for (const auto& datagram : sending) {
+            errors += send(datagram, incremental_endpoint_) ? 0 : 1;
+        }
+
+        // Snapshots run without mutex_ so the source can take book locks first
+        auto now = std::chrono::steady_clock::now();
+        if (snapshot_source_ && !stopping && now >= next_snapshot) {
+            publishSnapshots();
+            next_snapshot = now + config_.snapshot_interval;
+        }
+
+        lock.lock();
+        stats_.datagrams_sent += sending.size() - errors;
+        stats_.send_errors += errors;
+        for (auto& datagram : sending) {
+            datagram.clear();
+            spare_.push_back(std::move(datagram));
+        }
+        sending.clear();
+
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void MulticastFeedPublisher::publishSnapshots() {
+    try {
+        snapshot_source_([this](const OrderBook& book) { publishSnapshot(book); });
+    } catch (const std::exception& e) {
+        LOG_ERROR(logger_, std::string("Snapshot source threw: ") + e.what(),
+                           "MulticastFeedPublisher::publishSnapshots");
+    }
+    flushSnapshot();
+}
+
+void MulticastFeedPublisher::publishSnapshot(const OrderBook& book) {
+    // Called while the book is quiescent, so every incremental message for it
+    // up to the current sequence is already reflected in the depth
+    MarketDepth depth = book.getDepth(config_.snapshot_levels);
+
+    multicast::SnapshotStartMessage start{};
+    start.header = headerFor<multicast::SnapshotStartMessage>(multicast::MessageType::SnapshotStart);
+    start.symbol_id = depth.symbol_id;
+    start.last_sequence = getLastSequence();
+    start.bid_count = static_cast<uint16_t>(depth.bids.size());
+    start.ask_count = static_cast<uint16_t>(depth.asks.size());
+    start.timestamp_ns = toNanoseconds(depth.timestamp);
+    appendSnapshot(start);
+
+    auto append_levels = [this, &depth](const std::vector<MarketDepth::Level>& levels, Side side) {
+        for (const auto& level : levels) {
+            multicast::SnapshotLevelMessage message{};
+            message.header = headerFor<multicast::SnapshotLevelMessage>(multicast::MessageType::SnapshotLevel);
+            message.symbol_id = depth.symbol_id;
+            message.side = static_cast<uint8_t>(side);
+            message.price = level.price;
+            message.quantity = level.quantity;
+            message.order_count = static_cast<uint32_t>(level.order_count);
+            appendSnapshot(message);
+        }
+    };
+    append_levels(depth.bids, Side::Buy);
+    append_levels(depth.asks, Side::Sell);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.snapshots_sent;
+}
+
+template<typename Message>
+void MulticastFeedPublisher::appendSnapshot(const Message& message) {
+    if (snapshot_count_ > 0 && snapshot_datagram_.size() + sizeof(Message) > config_.max_datagram) {
+        flushSnapshot();
+    }
+    if (snapshot_count_ == 0) {
+        beginDatagram(snapshot_datagram_, next_snapshot_packet_, multicast::Channel::Snapshot);
+    }
+    appendMessage(snapshot_datagram_, message);
+    ++snapshot_count_;
+}
+
+void MulticastFeedPublisher::flushSnapshot() {
+    if (snapshot_count_ == 0) {
+        return;
+    }
+    setMessageCount(snapshot_datagram_, snapshot_count_);
+    if (!send(snapshot_datagram_, snapshot_endpoint_)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.send_errors;
+    }
+    snapshot_datagram_.clear();
+    snapshot_count_ = 0;
+    ++next_snapshot_packet_;
+}
+
+bool MulticastFeedPublisher::send(const Datagram& datagram, const boost::asio::ip::udp::endpoint& endpoint) {
+    boost::system::error_code error;
+    socket_.send_to(boost::asio::buffer(datagram), endpoint, 0, error);
+    if (error) {
+        LOG_DEBUG(logger_, "Multicast send failed: " + error.message(), "MulticastFeedPublisher::send");
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,325 @@
+#include "orderbook/MarketData/ShmMarketDataRing.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Record versions are accessed atomically in place");
+
+// The version word is plain data in the record layout so records stay
+// copyable, but both sides only ever touch it atomically
+std::atomic<uint64_t>& versionOf(ShmMarketDataRecord& record) {
+    return *reinterpret_cast<std::atomic<uint64_t>*>(&record.version);
+}
+
+const std::atomic<uint64_t>& versionOf(const ShmMarketDataRecord& record) {
+    return *reinterpret_cast<const std::atomic<uint64_t>*>(&record.version);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 64;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+int64_t toNanoseconds(Timestamp timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+Result<bool> systemError(const std::string& call, const std::string& name) {
+    return Result<bool>::error(call + "(" + name + "): " + std::strerror(errno));
+}
+
+}
+
+// ShmRingWriter
+
+ShmRingWriter::ShmRingWriter(std::string name, size_t capacity)
+    : name_(std::move(name)), capacity_(roundUpToPowerOfTwo(capacity)) {
+}
+
+ShmRingWriter::~ShmRingWriter() {
+    close();
+}
+
+Result<bool> ShmRingWriter::open() {
+#ifdef __linux__
+    close();
+
+    // Start from a fresh object; readers still mapping a previous run keep it
+    // until they reopen
+    shm_unlink(name_.c_str());
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        return systemError("shm_open", name_);
+    }
+
+    size_t size = sizeof(ShmRingHeader) + capacity_ * sizeof(ShmMarketDataRecord);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        auto error = systemError("ftruncate", name_);
+        ::close(fd);
+        shm_unlink(name_.c_str());
+        return error;
+    }
+
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        auto error = systemError("mmap", name_);
+        shm_unlink(name_.c_str());
+        return error;
+    }
+
+    // The new object is zero-filled, so every record reads as never written
+    mapped_size_ = size;
+    header_ = static_cast<ShmRingHeader*>(base);
+    records_ = reinterpret_cast<ShmMarketDataRecord*>(static_cast<char*>(base) + sizeof(ShmRingHeader));
+    position_ = 0;
+
+    header_->layout_version = ShmRingHeader::Version;
+    header_->record_size = sizeof(ShmMarketDataRecord);
+    header_->capacity = capacity_;
+    header_->write_position.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = ShmRingHeader::Magic;      // Written last: readers check it first
+    return Result<bool>::success(true);
+#else
+    return Result<bool>::error("Shared-memory rings are not supported on this platform");
+#endif
+}
+
+void ShmRingWriter::close() {
+#ifdef __linux__
+    if (header_) {
+        munmap(header_, mapped_size_);
+        shm_unlink(name_.c_str());
+    }
+#endif
+    header_ = nullptr;
+    records_ = nullptr;
+    mapped_size_ = 0;
+}
+
+uint64_t ShmRingWriter::write(const ShmMarketDataRecord& record) {
+    if (!records_) {
+        return 0;
+    }
+
+    while (write_flag_.test_and_set(std::memory_order_acquire)) {
+    }
+
+    uint64_t position = ++position_;
+    ShmMarketDataRecord& slot = records_[(position - 1) & (capacity_ - 1)];
+    auto& version = versionOf(slot);
+
+    // Odd version while the payload is in flux
+    version.store(2 * position - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<char*>(&slot) + sizeof(slot.version),
+                reinterpret_cast<const char*>(&record) + sizeof(record.version),
+                sizeof(ShmMarketDataRecord) - sizeof(record.version));
+    version.store(2 * position, std::memory_order_release);
+    header_->write_position.store(position, std::memory_order_release);
+
+    write_flag_.clear(std::memory_order_release);
+    return position;
+}
+
+// ShmRingReader
+
+ShmRingReader::ShmRingReader(std::string name) : name_(std::move(name)) {
+}
+
+ShmRingReader::~ShmRingReader() {
+    close();
+}
+
+Result<bool> ShmRingReader::open() {
+#ifdef __linux__
+    close();
+
+    int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return systemError("shm_open", name_);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        auto error = systemError("fstat", name_);
+        ::close(fd);
+        return error;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size < sizeof(ShmRingHeader)) {
+        ::close(fd);
+        return Result<bool>::error("Segment " + name_ + " is too small for a ring header");
+    }
+
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return systemError("mmap", name_);
+    }
+
+    const auto* header = static_cast<const ShmRingHeader*>(base);
+    bool valid = header->magic == ShmRingHeader::Magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    valid = valid && header->layout_version == ShmRingHeader::Version &&
+            header->record_size == sizeof(ShmMarketDataRecord) &&
+            header->capacity != 0 && (header->capacity & (header->capacity - 1)) == 0 &&
+            size >= sizeof(ShmRingHeader) + header->capacity * sizeof(ShmMarketDataRecord);
+    if (!valid) {
+        munmap(base, size);
+        return Result<bool>::error("Segment " + name_ + " is not an initialized market data ring");
+    }
+
+    mapped_size_ = size;
+    header_ = header;
+    records_ = reinterpret_cast<const ShmMarketDataRecord*>(static_cast<const char*>(base) + sizeof(ShmRingHeader));
+    mask_ = header->capacity - 1;
+    next_position_ = header->write_position.load(std::memory_order_acquire) + 1;
+    missed_records_ = 0;
+    return Result<bool>::success(true);
+#else
+    return Result<bool>::error("Shared-memory rings are not supported on this platform");
+#endif
+}
+
+void ShmRingReader::close() {
+#ifdef __linux__
+    if (header_) {
+        munmap(const_cast<ShmRingHeader*>(header_), mapped_size_);
+    }
+#endif
+    header_ = nullptr;
+    records_ = nullptr;
+    mapped_size_ = 0;
+}
+
+bool ShmRingReader::tryRead(ShmMarketDataRecord& record) {
+    if (!records_) {
+        return false;
+    }
+
+    while (true) {
+        const ShmMarketDataRecord& slot = records_[(next_position_ - 1) & mask_];
+        const uint64_t expected = 2 * next_position_;
+
+        uint64_t version = versionOf(slot).load(std::memory_order_acquire);
+        if (version < expected) {
+            return false;       // Not written yet, or being written now
+        }
+        if (version == expected) {
+            std::memcpy(&record, &slot, sizeof(ShmMarketDataRecord));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            version = versionOf(slot).load(std::memory_order_relaxed);
+            if (version == expected) {
+                ++next_position_;
+                return true;
+            }
+        }
+
+        // Overrun: the writer has reused this slot for a later lap. Everything
+        // up to a ring before the slot's new position is gone.
+        uint64_t slot_position = (version + 1) / 2;
+        uint64_t resume = std::max(oldestAvailable(), slot_position - mask_);
+        missed_records_ += resume - next_position_;
+        next_position_ = resume;
+    }
+}
+
+void ShmRingReader::rewind() {
+    if (header_) {
+        next_position_ = oldestAvailable();
+    }
+}
+
+uint64_t ShmRingReader::getAvailable() const {
+    if (!header_) {
+        return 0;
+    }
+    uint64_t written = header_->write_position.load(std::memory_order_acquire);
+    return written >= next_position_ ? written - next_position_ + 1 : 0;
+}
+
+uint64_t ShmRingReader::oldestAvailable() const {
+    uint64_t written = header_->write_position.load(std::memory_order_acquire);
+    return written > mask_ ? written - mask_ : 1;
+}
+
+// ShmRingPublisher
+
+ShmRingPublisher::ShmRingPublisher(const RingConfig& config)
+    : writer_(config.name, config.capacity) {
+}
+
+void ShmRingPublisher::onTrade(const Trade& trade, SequenceNumber sequence) {
+    ShmMarketDataRecord record{};
+    record.sequence = sequence;
+    record.timestamp_ns = toNanoseconds(trade.timestamp);
+    record.symbol_id = trade.symbol_id;
+    record.type = ShmMarketDataRecord::Type::Trade;
+    record.trade.trade_id = trade.id.value;
+    record.trade.price = trade.price;
+    record.trade.quantity = trade.quantity;
+    writer_.write(record);
+}
+
+void ShmRingPublisher::onBookUpdate(const BookUpdate& update) {
+    ShmMarketDataRecord record{};
+    record.sequence = update.sequence;
+    record.timestamp_ns = toNanoseconds(update.timestamp);
+    record.symbol_id = update.symbol_id;
+    record.type = ShmMarketDataRecord::Type::BookUpdate;
+    record.side = static_cast<uint8_t>(update.side);
+    record.update_type = static_cast<uint8_t>(update.type);
+    record.book.price = update.price;
+    record.book.quantity = update.quantity;
+    record.book.order_count = update.order_count;
+    writer_.write(record);
+}
+
+void ShmRingPublisher::onBestPrices(const BestPrices& prices, SequenceNumber sequence) {
+    ShmMarketDataRecord record{};
+    record.sequence = sequence;
+    record.timestamp_ns = toNanoseconds(prices.timestamp);
+    record.symbol_id = prices.symbol_id;
+    record.type = ShmMarketDataRecord::Type::BestPrices;
+    if (prices.bid) {
+        record.flags |= ShmMarketDataRecord::HasBid;
+        record.best.bid = *prices.bid;
+        record.best.bid_size = prices.bid_size.value_or(0);
+    }
+    if (prices.ask) {
+        record.flags |= ShmMarketDataRecord::HasAsk;
+        record.best.ask = *prices.ask;
+        record.best.ask_size = prices.ask_size.value_or(0);
+    }
+    writer_.write(record);
+}
+
+ShmRingPublisher::RingConfig ShmRingPublisher::loadConfiguration(std::shared_ptr<Config> config) {
+    RingConfig ring;
+    if (!config) {
+        return ring;
+    }
+    ring.name = config->getString("market_data", "shm_ring_name", ring.name);
+    ring.capacity = static_cast<size_t>(
+        config->getInt("market_data", "shm_ring_capacity", static_cast<int>(ring.capacity)));
+    return ring;
+}
+
+}
@@ -0,0 +1,348 @@
+#include "orderbook/Network/FixEncoder.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Network/FixSimd.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+// Worst case for everything except the variable-length strings
+constexpr size_t FixedFieldBudget = 768;
+
+// Six latency trace fields of at most "5001=" plus 20 digits and SOH
+constexpr size_t TraceFieldBudget = 6 * 26;
+
+// Stage tags are numbered from the receipt tag in LatencyTrace::Stage order
+static_assert(TAG_TRACE_MATCHED_NS == TAG_TRACE_RECEIVED_TICKS + LatencyTrace::Matched &&
+                  TAG_TRACE_ENCODED_NS == TAG_TRACE_RECEIVED_TICKS + LatencyTrace::StageCount,
+              "Latency trace tags out of step with LatencyTrace::Stage");
+
+// Longest fixed-notation double with two decimals
+constexpr size_t MaxRoundedLength = 320;
+
+constexpr int64_t Pow10[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+    1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+    100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL
+};
+
+constexpr char DigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline char* writeUInt(char* out, uint64_t value) {
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    while (value >= 100) {
+        const char* pair = DigitPairs + (value % 100) * 2;
+        value /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (value >= 10) {
+        const char* pair = DigitPairs + value * 2;
+        *--p = pair[1];
+        *--p = pair[0];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+    size_t length = static_cast<size_t>(end - p);
+    std::memcpy(out, p, length);
+    return out + length;
+}
+
+// Zero-padded to exactly width digits
+inline char* writePadded(char* out, uint64_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+// Exact for on-grid prices, where no value sits on a rounding boundary
+inline char* writeFixed(char* out, double value, int decimals) {
+    int64_t scaled = std::llround(value * static_cast<double>(Pow10[decimals]));
+    uint64_t magnitude = static_cast<uint64_t>(scaled);
+    if (scaled < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    uint64_t scale = static_cast<uint64_t>(Pow10[decimals]);
+    out = writeUInt(out, magnitude / scale);
+    if (decimals > 0) {
+        *out++ = '.';
+        out = writePadded(out, magnitude % scale, decimals);
+    }
+    return out;
+}
+
+// Correctly rounded like printf("%.*f"), for values off the tick grid
+inline char* writeRounded(char* out, double value, int decimals) {
+    return std::to_chars(out, out + MaxRoundedLength, value, std::chars_format::fixed, decimals).ptr;
+}
+
+inline char* writeBytes(char* out, std::string_view bytes) {
+    std::memcpy(out, bytes.data(), bytes.size());
+    return out + bytes.size();
+}
+
+inline char* writeTag(char* out, int tag) {
+    out = writeUInt(out, static_cast<uint64_t>(tag));
+    *out++ = '=';
+    return out;
+}
+
+/**
+ * @brief Civil date from days since 1970-01-01 (proleptic Gregorian)
+ */
+inline void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+}
+
+FixEncoder::FixEncoder(TickSize tickSize) : tickSize_(tickSize) {
+    setSessionIds("", "");
+}
+
+FixEncoder::FixEncoder(const std::string& senderCompId, const std::string& targetCompId,
+                       TickSize tickSize)
+    : tickSize_(tickSize) {
+    setSessionIds(senderCompId, targetCompId);
+}
+
+void FixEncoder::setSessionIds(const std::string& senderCompId, const std::string& targetCompId) {
+    compIds_.clear();
+    compIds_ += std::to_string(TAG_SENDER_COMP_ID) + "=" + senderCompId + FIELD_DELIMITER;
+    compIds_ += std::to_string(TAG_TARGET_COMP_ID) + "=" + targetCompId + FIELD_DELIMITER;
+}
+
+std::string_view FixEncoder::encodeExecutionReport(const FixMessageParser::ExecutionReport& execReport,
+                                                   SequenceNumber msgSeqNum, std::string& buffer) {
+    return encodeExecutionReport(execReport, msgSeqNum, std::chrono::system_clock::now(), buffer);
+}
+
+std::string_view FixEncoder::encodeExecutionReport(const FixMessageParser::ExecutionReport& execReport,
+                                                   SequenceNumber msgSeqNum,
+                                                   std::chrono::system_clock::time_point sendingTime,
+                                                   std::string& buffer) {
+    size_t required = PrefixReserve + FixedFieldBudget + compIds_.size() +
+                      execReport.orderId.size() + execReport.clOrdId.size() +
+                      execReport.execId.size() + execReport.symbol.size() +
+                      (execReport.trace ? TraceFieldBudget : 0);
+    if (buffer.size() < required) {
+        buffer.resize(required);
+    }
+
+    char* const bodyStart = &buffer[PrefixReserve];
+    const int priceDecimals = tickSize_.decimals();
+    char* out = writeHeader(bodyStart, MSG_TYPE_EXECUTION_REPORT, msgSeqNum, sendingTime);
+
+    // Required fields for Execution Report
+    out = writeTag(out, TAG_ORDER_ID);
+    out = writeBytes(out, execReport.orderId);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_CLORD_ID);
+    out = writeBytes(out, execReport.clOrdId);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_EXEC_ID);
+    out = writeBytes(out, execReport.execId);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_EXEC_TYPE);
+    *out++ = execReport.execType;
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_ORD_STATUS);
+    *out++ = execReport.ordStatus;
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_SYMBOL);
+    out = writeBytes(out, execReport.symbol);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_SIDE);
+    *out++ = execReport.side == Side::Buy ? SIDE_BUY : SIDE_SELL;
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_ORDER_QTY);
+    out = writeUInt(out, execReport.orderQty);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_PRICE);
+    out = writeFixed(out, execReport.price, priceDecimals);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_LEAVES_QTY);
+    out = writeUInt(out, execReport.leavesQty);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_CUM_QTY);
+    out = writeUInt(out, execReport.cumQty);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_AVG_PX);
+    out = writeRounded(out, execReport.avgPx, 2);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_TRANSACT_TIME);
+    out = writeTimestamp(out, execReport.transactTime);
+    *out++ = FIELD_DELIMITER;
+
+    // Optional fields for fills
+    if (execReport.lastQty > 0) {
+        out = writeTag(out, TAG_LAST_QTY);
+        out = writeUInt(out, execReport.lastQty);
+        *out++ = FIELD_DELIMITER;
+        out = writeTag(out, TAG_LAST_PX);
+        out = writeFixed(out, execReport.lastPx, priceDecimals);
+        *out++ = FIELD_DELIMITER;
+    }
+
+    // Latency trace last, so the encode stamp covers the rest of the report
+    if (execReport.trace) {
+        const LatencyTrace& trace = *execReport.trace;
+        uint64_t encoded = trace.sinceReceived(TscClock::ticks());
+        out = writeTag(out, TAG_TRACE_RECEIVED_TICKS);
+        out = writeUInt(out, trace.ticks[LatencyTrace::Received]);
+        *out++ = FIELD_DELIMITER;
+        for (int stage = LatencyTrace::Parsed; stage < LatencyTrace::StageCount; ++stage) {
+            out = writeTag(out, TAG_TRACE_RECEIVED_TICKS + stage);
+            out = writeUInt(out, trace.sinceReceived(static_cast<LatencyTrace::Stage>(stage)));
+            *out++ = FIELD_DELIMITER;
+        }
+        out = writeTag(out, TAG_TRACE_ENCODED_NS);
+        out = writeUInt(out, encoded);
+        *out++ = FIELD_DELIMITER;
+    }
+
+    return finishMessage(bodyStart, out);
+}
+
+std::string_view FixEncoder::encodeNewOrderSingle(const FixMessageParser::NewOrderSingle& order,
+                                                  SequenceNumber msgSeqNum,
+                                                  std::chrono::system_clock::time_point sendingTime,
+                                                  std::string& buffer) {
+    size_t required = PrefixReserve + FixedFieldBudget + compIds_.size() +
+                      order.clOrdId.size() + order.symbol.size() + order.account.size();
+    if (buffer.size() < required) {
+        buffer.resize(required);
+    }
+
+    char* const bodyStart = &buffer[PrefixReserve];
+    char* out = writeHeader(bodyStart, MSG_TYPE_NEW_ORDER_SINGLE, msgSeqNum, sendingTime);
+
+    out = writeTag(out, TAG_CLORD_ID);
+    out = writeBytes(out, order.clOrdId);
+    *out++ = FIELD_DELIMITER;
+    if (!order.account.empty()) {
+        out = writeTag(out, TAG_ACCOUNT);
+        out = writeBytes(out, order.account);
+        *out++ = FIELD_DELIMITER;
+    }
+    out = writeTag(out, TAG_SYMBOL);
+    out = writeBytes(out, order.symbol);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_SIDE);
+    *out++ = order.side == Side::Buy ? SIDE_BUY : SIDE_SELL;
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_ORDER_QTY);
+    out = writeUInt(out, order.quantity);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_ORD_TYPE);
+    *out++ = order.orderType == OrderType::Market ? ORD_TYPE_MARKET : ORD_TYPE_LIMIT;
+    *out++ = FIELD_DELIMITER;
+    if (order.orderType == OrderType::Limit) {
+        out = writeTag(out, TAG_PRICE);
+        out = writeFixed(out, order.price, tickSize_.decimals());
+        *out++ = FIELD_DELIMITER;
+    }
+    out = writeTag(out, TAG_TIME_IN_FORCE);
+    *out++ = order.timeInForce == TimeInForce::IOC ? TIF_IOC
+           : order.timeInForce == TimeInForce::FOK ? TIF_FOK
+                                                   : TIF_GTC;
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_TRANSACT_TIME);
+    out = writeTimestamp(out, order.transactTime);
+    *out++ = FIELD_DELIMITER;
+
+    return finishMessage(bodyStart, out);
+}
+
+char* FixEncoder::writeHeader(char* out, char msgType, SequenceNumber msgSeqNum,
+                              std::chrono::system_clock::time_point sendingTime) {
+    // Header after BodyLength
+    out = writeTag(out, TAG_MSG_TYPE);
+    *out++ = msgType;
+    *out++ = FIELD_DELIMITER;
+    out = writeBytes(out, compIds_);
+    out = writeTag(out, TAG_MSG_SEQ_NUM);
+    out = writeUInt(out, msgSeqNum);
+    *out++ = FIELD_DELIMITER;
+    out = writeTag(out, TAG_SENDING_TIME);
+    out = writeTimestamp(out, sendingTime);
+    *out++ = FIELD_DELIMITER;
+    return out;
+}
+
+std::string_view FixEncoder::finishMessage(char* bodyStart, char* out) {
+    // BeginString and BodyLength go right-aligned into the reserved gap
+    char prefix[PrefixReserve];
+    char* p = writeTag(prefix, TAG_BEGIN_STRING);
+    p = writeBytes(p, BEGIN_STRING_44);
+    *p++ = FIELD_DELIMITER;
+    p = writeTag(p, TAG_BODY_LENGTH);
+    p = writeUInt(p, static_cast<uint64_t>(out - bodyStart));
+    *p++ = FIELD_DELIMITER;
+    size_t prefixLength = static_cast<size_t>(p - prefix);
+    char* const messageStart = bodyStart - prefixLength;
+    std::memcpy(messageStart, prefix, prefixLength);
+
+    uint8_t checksum = simd::checksum(messageStart, static_cast<size_t>(out - messageStart));
+    out = writeTag(out, TAG_CHECKSUM);
+    out = writePadded(out, checksum, 3);
+    *out++ = FIELD_DELIMITER;
+
+    return std::string_view(messageStart, static_cast<size_t>(out - messageStart));
+}
+
+char* FixEncoder::writeTimestamp(char* out, std::chrono::system_clock::time_point timestamp) {
+    int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        timestamp.time_since_epoch()).count();
+    int64_t second = millis >= 0 ? millis / 1000 : (millis - 999) / 1000;
+    int64_t fraction = millis - second * 1000;
+
+    if (second != cachedSecond_) {
+        int64_t days = second >= 0 ? second / 86400 : (second - 86399) / 86400;
+        int64_t secondOfDay = second - days * 86400;
+        int64_t year;
+        unsigned month;
+        unsigned day;
+        civilFromDays(days, year, month, day);
+
+        char* p = cachedPrefix_;
+        p = writePadded(p, static_cast<uint64_t>(year), 4);
+        p = writePadded(p, month, 2);
+        p = writePadded(p, day, 2);
+        *p++ = '-';
+        p = writePadded(p, static_cast<uint64_t>(secondOfDay / 3600), 2);
+        *p++ = ':';
+        p = writePadded(p, static_cast<uint64_t>(secondOfDay / 60 % 60), 2);
+        *p++ = ':';
+        writePadded(p, static_cast<uint64_t>(secondOfDay % 60), 2);
+        cachedSecond_ = second;
+    }
+
+    std::memcpy(out, cachedPrefix_, sizeof(cachedPrefix_));
+    out += sizeof(cachedPrefix_);
+    *out++ = '.';
+    return writePadded(out, static_cast<uint64_t>(fraction), 3);
+}
+
+}
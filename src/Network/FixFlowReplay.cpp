@@ -0,0 +1,340 @@
+#include "orderbook/Network/FixFlowReplay.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <unordered_map>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+char sideChar(Side side) {
+    return side == Side::Buy ? SIDE_BUY : SIDE_SELL;
+}
+
+char orderTypeChar(OrderType type) {
+    return type == OrderType::Market ? ORD_TYPE_MARKET : ORD_TYPE_LIMIT;
+}
+
+char tifChar(TimeInForce tif) {
+    switch (tif) {
+        case TimeInForce::IOC: return TIF_IOC;
+        case TimeInForce::FOK: return TIF_FOK;
+        default: return TIF_GTC;
+    }
+}
+
+/**
+ * @brief Builds one message body, then frames it with BeginString, BodyLength and CheckSum
+ */
+class MessageBuilder {
+public:
+    MessageBuilder(char msgType, uint64_t msgSeqNum) {
+        body_.reserve(160);
+        add(TAG_MSG_TYPE, std::string(1, msgType));
+        add(TAG_SENDER_COMP_ID, "REPLAY");
+        add(TAG_TARGET_COMP_ID, "ORDERBOOK");
+        add(TAG_MSG_SEQ_NUM, std::to_string(msgSeqNum));
+    }
+
+    MessageBuilder& add(int tag, const std::string& value) {
+        body_ += std::to_string(tag);
+        body_ += '=';
+        body_ += value;
+        body_ += FIELD_DELIMITER;
+        return *this;
+    }
+
+    MessageBuilder& add(int tag, char value) { return add(tag, std::string(1, value)); }
+
+    std::string finish() const {
+        std::string message = std::string("8=") + BEGIN_STRING_44 + FIELD_DELIMITER +
+                              "9=" + std::to_string(body_.size()) + FIELD_DELIMITER + body_;
+        unsigned checksum = 0;
+        for (char c : message) {
+            checksum += static_cast<unsigned char>(c);
+        }
+        char trailer[8];
+        std::snprintf(trailer, sizeof(trailer), "10=%03u", checksum % 256);
+        return message + trailer + FIELD_DELIMITER;
+    }
+
+private:
+    std::string body_;
+};
+
+std::string formatPrice(Price price, const TickSize& tick) {
+    // On-grid prices in the tick's own precision; anything else keeps enough
+    // digits for the parser to reject it, as the book would
+    char text[48];
+    std::snprintf(text, sizeof(text), "%.*f", tick.isOnTick(price) ? tick.decimals() : 9, price);
+    return text;
+}
+
+/**
+ * @brief Parse a UTCTimestamp ("YYYYMMDD-HH:MM:SS[.fff[fff[fff]]]")
+ * @return Nanoseconds since the epoch, or -1 if malformed
+ */
+int64_t parseUtcTimestamp(std::string_view text) {
+    if (text.size() < 17 || text[8] != '-' || text[11] != ':' || text[14] != ':') {
+        return -1;
+    }
+    auto digits = [&text](size_t pos, size_t count, int64_t& value) {
+        value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (text[i] < '0' || text[i] > '9') {
+                return false;
+            }
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    };
+    int64_t year, month, day, hour, minute, second;
+    if (!digits(0, 4, year) || !digits(4, 2, month) || !digits(6, 2, day) || !digits(9, 2, hour) ||
+        !digits(12, 2, minute) || !digits(15, 2, second)) {
+        return -1;
+    }
+
+    // Days from civil date (proleptic Gregorian)
+    year -= month <= 2 ? 1 : 0;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    int64_t days = era * 146097 + day_of_era - 719468;
+
+    int64_t nanoseconds = 0;
+    int64_t scale = 100000000;
+    if (text.size() > 17 && text[17] == '.') {
+        for (size_t i = 18; i < text.size() && scale > 0 && text[i] >= '0' && text[i] <= '9'; ++i) {
+            nanoseconds += (text[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    return ((days * 24 + hour) * 60 + minute) * 60 * 1000000000ll + second * 1000000000ll + nanoseconds;
+}
+
+}
+
+FixFlowTarget::FixFlowTarget(OrderBookRouter& router, LoggerPtr logger)
+    : router_(router), gateway_(router, std::move(logger)), batch_(1) {
+    // No session: the gateway still tracks fills but sends no reports
+    client_ = gateway_.createClient(std::weak_ptr<FixSession>());
+}
+
+void FixFlowTarget::prepare(const std::vector<OrderFlowEvent>& events) {
+    struct WorkingOrder {
+        std::string clOrdId;
+        uint32_t replaces = 0;
+        Side side = Side::Buy;
+        OrderType type = OrderType::Limit;
+        TimeInForce tif = TimeInForce::GTC;
+    };
+    std::unordered_map<uint64_t, WorkingOrder> orders;
+
+    // The gateway ignores TransactTime, so every message carries the same one
+    std::time_t now = std::time(nullptr);
+    char transactTime[32];
+    std::strftime(transactTime, sizeof(transactTime), "%Y%m%d-%H:%M:%S.000", std::gmtime(&now));
+
+    messages_.clear();
+    messages_.reserve(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        const OrderFlowEvent& event = events[i];
+        const OrderBook* book = router_.getBook(event.symbol);
+        TickSize tick = book ? book->getTickSize() : TickSize{};
+        std::string symbol(InternTable::symbols().name(event.symbol));
+        uint64_t seqNum = i + 1;
+
+        // Requests for orders the flow never added still go out, and are rejected
+        WorkingOrder& order = orders[event.order_id];
+        if (order.clOrdId.empty()) {
+            order.clOrdId = "o" + std::to_string(event.order_id);
+            order.side = event.side;
+            order.type = event.order_type;
+            order.tif = event.tif;
+        }
+
+        switch (event.type) {
+            case OrderFlowEvent::Type::Add: {
+                order.side = event.side;
+                order.type = event.order_type;
+                order.tif = event.tif;
+                MessageBuilder message(MSG_TYPE_NEW_ORDER_SINGLE, seqNum);
+                message.add(TAG_CLORD_ID, order.clOrdId)
+                       .add(TAG_SYMBOL, symbol)
+                       .add(TAG_SIDE, sideChar(event.side))
+                       .add(TAG_ORD_TYPE, orderTypeChar(event.order_type))
+                       .add(TAG_TIME_IN_FORCE, tifChar(event.tif));
+                if (event.order_type == OrderType::Limit) {
+                    message.add(TAG_PRICE, formatPrice(event.price, tick));
+                }
+                message.add(TAG_ORDER_QTY, std::to_string(event.quantity));
+                if (event.account != InternTable::EmptyId) {
+                    message.add(TAG_ACCOUNT, InternTable::accounts().name(event.account));
+                }
+                message.add(TAG_TRANSACT_TIME, transactTime);
+                messages_.push_back(message.finish());
+                break;
+            }
+            case OrderFlowEvent::Type::Modify: {
+                std::string clOrdId = "o" + std::to_string(event.order_id) + "." + std::to_string(++order.replaces);
+                MessageBuilder message(MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST, seqNum);
+                message.add(TAG_CLORD_ID, clOrdId)
+                       .add(TAG_ORIG_CLORD_ID, order.clOrdId)
+                       .add(TAG_SYMBOL, symbol)
+                       .add(TAG_SIDE, sideChar(order.side))
+                       .add(TAG_ORD_TYPE, orderTypeChar(order.type))
+                       .add(TAG_TIME_IN_FORCE, tifChar(order.tif));
+                if (event.price > 0.0) {
+                    message.add(TAG_PRICE, formatPrice(event.price, tick));
+                }
+                if (event.quantity > 0) {
+                    message.add(TAG_ORDER_QTY, std::to_string(event.quantity));
+                }
+                message.add(TAG_TRANSACT_TIME, transactTime);
+                messages_.push_back(message.finish());
+                order.clOrdId = std::move(clOrdId);
+                break;
+            }
+            case OrderFlowEvent::Type::Cancel: {
+                MessageBuilder message(MSG_TYPE_ORDER_CANCEL_REQUEST, seqNum);
+                message.add(TAG_CLORD_ID, "c" + std::to_string(i))
+                       .add(TAG_ORIG_CLORD_ID, order.clOrdId)
+                       .add(TAG_SYMBOL, symbol)
+                       .add(TAG_SIDE, sideChar(order.side))
+                       .add(TAG_TRANSACT_TIME, transactTime);
+                messages_.push_back(message.finish());
+                break;
+            }
+        }
+    }
+}
+
+bool FixFlowTarget::apply(const OrderFlowEvent& event, size_t index) {
+    if (index >= messages_.size()) {
+        return false;
+    }
+    if (const OrderBook* book = router_.getBook(event.symbol)) {
+        parser_.setTickSize(book->getTickSize());
+    }
+    if (!parser_.parseMessage(messages_[index], view_)) {
+        return false;
+    }
+
+    FixOrderRequest& request = batch_.front();
+    bool valid = false;
+    switch (view_.msgType()) {
+        case MSG_TYPE_NEW_ORDER_SINGLE:
+            request.type = FixOrderRequest::Type::New;
+            request.newOrder = parser_.parseNewOrderSingle(view_);
+            valid = request.newOrder.isValid;
+            break;
+        case MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST:
+            request.type = FixOrderRequest::Type::CancelReplace;
+            request.cancelReplace = parser_.parseOrderCancelReplaceRequest(view_);
+            valid = request.cancelReplace.isValid;
+            break;
+        case MSG_TYPE_ORDER_CANCEL_REQUEST:
+            request.type = FixOrderRequest::Type::Cancel;
+            request.cancel = parser_.parseOrderCancelRequest(view_);
+            valid = request.cancel.isValid;
+            break;
+        default:
+            break;
+    }
+    if (!valid) {
+        return false;
+    }
+
+    uint64_t rejected = gateway_.getOrdersRejected();
+    gateway_.processBatch(client_, batch_);
+    return gateway_.getOrdersRejected() == rejected;
+}
+
+Result<std::vector<OrderFlowEvent>> FixFlowTarget::loadFixLog(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return Result<std::vector<OrderFlowEvent>>::error("Cannot open " + path);
+    }
+
+    FixMessageView view;
+    std::unordered_map<std::string, uint64_t> orderIds;     // ClOrdID to replay order ID
+    uint64_t nextOrderId = 1;
+    auto orderFor = [&orderIds, &nextOrderId](const std::string& clOrdId) {
+        auto it = orderIds.find(clOrdId);
+        return it != orderIds.end() ? it->second : nextOrderId++;
+    };
+
+    std::vector<OrderFlowEvent> events;
+    for (std::string line; std::getline(file, line);) {
+        size_t start = line.find("8=FIX");
+        if (start == std::string::npos) {
+            continue;
+        }
+        std::string message = line.substr(start);
+        while (!message.empty() && (message.back() == '\r' || message.back() == '\n')) {
+            message.pop_back();
+        }
+        for (char& c : message) {
+            if (c == '|') {
+                c = FIELD_DELIMITER;
+            }
+        }
+        if (!view.parse(message)) {
+            continue;
+        }
+
+        OrderFlowEvent event;
+        std::string clOrdId = view.getString(TAG_CLORD_ID);
+        std::string origClOrdId = view.getString(TAG_ORIG_CLORD_ID);
+        switch (view.msgType()) {
+            case MSG_TYPE_NEW_ORDER_SINGLE:
+                event.type = OrderFlowEvent::Type::Add;
+                event.order_id = orderFor(clOrdId);
+                break;
+            case MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST:
+                event.type = OrderFlowEvent::Type::Modify;
+                event.order_id = orderFor(origClOrdId);
+                break;
+            case MSG_TYPE_ORDER_CANCEL_REQUEST:
+                event.type = OrderFlowEvent::Type::Cancel;
+                event.order_id = orderFor(origClOrdId);
+                break;
+            default:
+                continue;
+        }
+        if (!clOrdId.empty() && event.type != OrderFlowEvent::Type::Cancel) {
+            orderIds[clOrdId] = event.order_id;
+        }
+
+        event.symbol = InternTable::symbols().intern(view.get(TAG_SYMBOL));
+        event.account = InternTable::accounts().intern(view.get(TAG_ACCOUNT));
+        event.side = view.getChar(TAG_SIDE) == SIDE_SELL ? Side::Sell : Side::Buy;
+        event.order_type = view.getChar(TAG_ORD_TYPE) == ORD_TYPE_MARKET ? OrderType::Market : OrderType::Limit;
+        switch (view.getChar(TAG_TIME_IN_FORCE)) {
+            case TIF_IOC: event.tif = TimeInForce::IOC; break;
+            case TIF_FOK: event.tif = TimeInForce::FOK; break;
+            default: event.tif = TimeInForce::GTC; break;
+        }
+        std::string price = view.getString(TAG_PRICE);
+        event.price = price.empty() ? 0.0 : std::strtod(price.c_str(), nullptr);
+        event.quantity = view.getUInt(TAG_ORDER_QTY).value_or(0);
+
+        int64_t timestamp = parseUtcTimestamp(view.get(TAG_TRANSACT_TIME));
+        if (timestamp < 0) {
+            timestamp = parseUtcTimestamp(view.get(TAG_SENDING_TIME));
+        }
+        event.timestamp_ns = timestamp >= 0 ? timestamp : (events.empty() ? 0 : events.back().timestamp_ns);
+        events.push_back(event);
+    }
+    return Result<std::vector<OrderFlowEvent>>::success(std::move(events));
+}
+
+}
@@ -0,0 +1,136 @@
+#include "orderbook/Network/FixFrameReader.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+// "8=FIXT.1.1|" fits comfortably; anything longer is not a BeginString
+constexpr size_t MaxBeginStringField = 32;
+
+// BodyLength digits accepted before the SOH
+constexpr size_t MaxBodyLengthDigits = 7;
+
+// "10=NNN|"
+constexpr size_t TrailerSize = 7;
+
+}
+
+FixFrameReader::FixFrameReader(size_t bufferSize, size_t maxMessageSize)
+    : buffer_(std::max(bufferSize, 2 * maxMessageSize)), maxMessageSize_(maxMessageSize) {
+}
+
+char* FixFrameReader::writePtr() {
+    if (readPos_ == writePos_) {
+        readPos_ = writePos_ = 0;
+    } else if (writable() < maxMessageSize_ && readPos_ > 0) {
+        size_t unread = writePos_ - readPos_;
+        std::memmove(buffer_.data(), buffer_.data() + readPos_, unread);
+        readPos_ = 0;
+        writePos_ = unread;
+    }
+    return buffer_.data() + writePos_;
+}
+
+bool FixFrameReader::nextFrame(std::string_view& message) {
+    const char* data = buffer_.data();
+
+    while (writePos_ - readPos_ >= 2) {
+        const char* frame = data + readPos_;
+        const size_t available = writePos_ - readPos_;
+
+        if (frame[0] != '8' || frame[1] != '=') {
+            resync();
+            continue;
+        }
+
+        // End of the BeginString field
+        size_t limit = std::min(available, MaxBeginStringField);
+        const void* soh = std::memchr(frame, FIELD_DELIMITER, limit);
+        if (!soh) {
+            if (available < MaxBeginStringField) {
+                return false;
+            }
+            resync();
+            continue;
+        }
+        size_t pos = static_cast<size_t>(static_cast<const char*>(soh) - frame) + 1;
+
+        // BodyLength
+        if (available < pos + 2) {
+            return false;
+        }
+        if (frame[pos] != '9' || frame[pos + 1] != '=') {
+            resync();
+            continue;
+        }
+        pos += 2;
+
+        size_t bodyLength = 0;
+        size_t digits = 0;
+        bool malformed = false;
+        while (pos < available && frame[pos] != FIELD_DELIMITER) {
+            char c = frame[pos];
+            if (c < '0' || c > '9' || ++digits > MaxBodyLengthDigits) {
+                malformed = true;
+                break;
+            }
+            bodyLength = bodyLength * 10 + static_cast<size_t>(c - '0');
+            ++pos;
+        }
+        if (malformed) {
+            resync();
+            continue;
+        }
+        if (pos == available) {
+            return false;
+        }
+        if (digits == 0) {
+            resync();
+            continue;
+        }
+        ++pos;
+
+        size_t trailer = pos + bodyLength;
+        size_t total = trailer + TrailerSize;
+        if (total > maxMessageSize_) {
+            resync();
+            continue;
+        }
+        if (available < total) {
+            return false;
+        }
+        if (std::memcmp(frame + trailer, "10=", 3) != 0 || frame[total - 1] != FIELD_DELIMITER) {
+            resync();
+            continue;
+        }
+
+        message = std::string_view(frame, total);
+        readPos_ += total;
+        return true;
+    }
+    return false;
+}
+
+void FixFrameReader::resync() {
+    const char* data = buffer_.data();
+    size_t next = writePos_;
+
+    // Next "8=" that follows a field delimiter
+    for (size_t i = readPos_ + 1; i < writePos_; ++i) {
+        if (data[i] == '8' && data[i - 1] == FIELD_DELIMITER &&
+            (i + 1 == writePos_ || data[i + 1] == '=')) {
+            next = i;
+            break;
+        }
+    }
+
+    discardedBytes_ += next - readPos_;
+    readPos_ = next;
+}
+
+}
@@ -1,5 +1,7 @@
 #include "orderbook/Network/FixServer.hpp"
-#include "orderbook/Core/OrderManager.hpp"
+#include "orderbook/MarketData/MulticastFeed.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Core/MatchingRuntime.hpp"
 #include "orderbook/Risk/RiskManager.hpp"
 #include "orderbook/Utilities/Logger.hpp"
 #include <boost/asio.hpp>
@@ -11,7 +13,7 @@ namespace orderbook {
 
 /**
  * @brief Example demonstrating FIX protocol integration
- * Shows how to set up a FIX server with order management and risk controls
+ * Shows how to set up a FIX server matching against order books with risk controls
  */
 class FixIntegrationExample {
 public:
@@ -24,14 +26,37 @@ public:
         // Create logger
         auto logger = std::make_shared<Logger>(LogLevel::INFO);
         
-        // Create order manager
-        auto orderManager = std::make_shared<OrderManager>(logger);
-        
         // Create risk manager with default limits
         auto riskManager = std::make_shared<RiskManager>(logger);
         
+        // Create the books FIX orders are matched against
+        auto marketData = std::make_shared<MarketDataPublisher>(logger);
+        OrderBookRouter router(riskManager, marketData, logger);
+        for (const char* symbol : {"AAPL", "MSFT", "GOOGL"}) {
+            OrderBook::BookConfig book;
+            book.symbol = symbol;
+            router.addBook(book);
+        }
+        
+        // Each shard's books are matched on their own thread; the gateway submits to it
+        MatchingRuntime runtime(router, logger);
+        auto gateway = std::make_shared<FixOrderGateway>(router, runtime, logger);
+        runtime.start();
+        
+        // Republish the books over multicast, snapshotting each book on its shard thread
+        auto feed = std::make_shared<MulticastFeedPublisher>(logger);
+        feed->setSnapshotSource([&gateway](const MulticastFeedPublisher::BookVisitor& visit) {
+            gateway->forEachBook([&visit](SymbolId, const OrderBook& book) { visit(book); });
+        });
+        auto feedStarted = feed->start();
+        if (feedStarted.isError()) {
+            std::cerr << "Multicast feed disabled: " << feedStarted.error() << std::endl;
+        } else {
+            marketData->subscribe(feed);
+        }
+        
         // Create FIX server
-        FixServer fixServer(ioContext, orderManager, riskManager);
+        FixServer fixServer(ioContext, gateway);
         
         try {
             // Start FIX server on port 9878
@@ -49,6 +74,8 @@ public:
             std::cout << "Stopping FIX server..." << std::endl;
             fixServer.stop();
             ioContext.stop();
+            feed->stop();
+            runtime.stop();
             
             if (ioThread.joinable()) {
                 ioThread.join();
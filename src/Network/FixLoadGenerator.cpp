@@ -0,0 +1,410 @@
+#include "orderbook/Network/FixLoadGenerator.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Network/FixSession.hpp"
+#include "orderbook/Network/IoContextPool.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::chrono::seconds LogonTimeout{10};
+constexpr std::chrono::seconds DrainTimeout{2};
+constexpr size_t MinTrackedOrders = 64;
+constexpr size_t MaxTrackedOrders = 65536;
+
+uint64_t elapsed(uint64_t later, uint64_t earlier) {
+    return later > earlier ? later - earlier : 0;
+}
+
+/**
+ * @brief Counters shared by every session of a run
+ */
+struct RunState {
+    std::atomic<size_t> loggedIn{0};
+    std::atomic<size_t> disconnected{0};
+    std::atomic<int64_t> outstanding{0};    // Orders sent and not yet acknowledged or rejected
+};
+
+/**
+ * @brief One client session and its send schedule
+ *
+ * Everything here runs on the session's io_context thread, which is also
+ * the only writer of the report it records into.
+ */
+class LoadSession {
+public:
+    LoadSession(boost::asio::io_context& context, size_t index, const FixLoadGenerator::LoadConfig& config,
+                FixLoadGenerator::Report& report, RunState& state)
+        : timer_(context), config_(config), report_(report), state_(state),
+          session_(std::make_shared<FixSession>(context)), rng_(0x9E3779B97F4A7C15ull * (index + 1)) {
+        double perSession = config.rate / static_cast<double>(config.sessions);
+        size_t tracked = std::clamp<size_t>(static_cast<size_t>(perSession), MinTrackedOrders, MaxTrackedOrders);
+        size_t capacity = 1;
+        while (capacity < tracked) {
+            capacity <<= 1;
+        }
+        orders_.resize(capacity);
+        mask_ = capacity - 1;
+
+        interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / perSession));
+        midTicks_ = config.tick_size.toTicks(config.price);
+
+        order_.symbol = config.symbol;
+        order_.account = "LOAD" + std::to_string(index);
+        order_.orderType = OrderType::Limit;
+        order_.timeInForce = TimeInForce::GTC;
+        order_.quantity = config.quantity;
+        order_.isValid = true;
+
+        session_->setLatencyTrace(true);
+        session_->setSessionEventHandler([this](FixSession::SessionState sessionState, const std::string&) {
+            if (sessionState == FixSession::SessionState::LoggedIn) {
+                state_.loggedIn.fetch_add(1, std::memory_order_relaxed);
+            } else if (sessionState == FixSession::SessionState::Disconnected) {
+                state_.disconnected.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        session_->setExecutionReportHandler([this](const FixMessageView& msg) { onReport(msg); });
+    }
+
+    void connect(size_t index) {
+        session_->connect(config_.host, config_.port, "LOAD" + std::to_string(index), config_.target_comp_id);
+    }
+
+    /**
+     * @brief Send from first until stop, measuring orders due from measureFrom
+     */
+    void schedule(Clock::time_point first, Clock::time_point measureFrom, Clock::time_point stop) {
+        boost::asio::post(timer_.get_executor(), [this, first, measureFrom, stop]() {
+            nextDue_ = first;
+            measureFrom_ = measureFrom;
+            stop_ = stop;
+            timer_.expires_at(nextDue_);
+            timer_.async_wait([this](const boost::system::error_code& error) { onTimer(error); });
+        });
+    }
+
+    void close() { session_->close(); }
+    bool isLoggedIn() const { return session_->isLoggedIn(); }
+
+private:
+    struct TrackedOrder {
+        uint64_t seq = 0;           // ClOrdID; 0 = slot unused
+        uint64_t sendTicks = 0;
+        int64_t lagNs = 0;          // Sent this long after it was due
+        bool measured = false;
+        bool acknowledged = false;
+        bool traded = false;
+    };
+
+    void onTimer(const boost::system::error_code& error) {
+        if (error) {
+            return;
+        }
+
+        // Catch up on everything due, so falling behind shows as lag, not a lower rate
+        Clock::time_point now = Clock::now();
+        while (nextDue_ <= now && nextDue_ < stop_ && session_->isLoggedIn()) {
+            send(nextDue_, now);
+            nextDue_ += interval_;
+        }
+        if (nextDue_ < stop_ && session_->isLoggedIn()) {
+            timer_.expires_at(nextDue_);
+            timer_.async_wait([this](const boost::system::error_code& next) { onTimer(next); });
+        }
+    }
+
+    void send(Clock::time_point due, Clock::time_point now) {
+        uint64_t seq = ++nextSeq_;
+        TrackedOrder& tracked = orders_[seq & mask_];
+        if (tracked.seq != 0 && !tracked.acknowledged) {
+            state_.outstanding.fetch_sub(1, std::memory_order_relaxed);     // Evicted, never answered
+        }
+        tracked = TrackedOrder{};
+        tracked.seq = seq;
+        tracked.measured = due >= measureFrom_;
+        tracked.lagNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count();
+
+        // Alternate sides around the mid, so crossing orders trade on arrival
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        int64_t span = 2 * config_.price_range_ticks + 1;
+        int64_t offset = static_cast<int64_t>(rng_ % static_cast<uint64_t>(span)) - config_.price_range_ticks;
+        order_.side = (seq & 1) ? Side::Buy : Side::Sell;
+        order_.price = config_.tick_size.toPrice(midTicks_ + offset);
+
+        char digits[20];
+        auto end = std::to_chars(digits, digits + sizeof(digits), seq).ptr;
+        order_.clOrdId.assign(digits, end);
+        order_.transactTime = TscClock::now();
+
+        state_.outstanding.fetch_add(1, std::memory_order_relaxed);
+        if (tracked.measured) {
+            ++report_.sent;
+            report_.max_lag_ns = std::max(report_.max_lag_ns, tracked.lagNs);
+        }
+        tracked.sendTicks = TscClock::ticks();
+        session_->sendNewOrderSingle(order_);
+    }
+
+    void onReport(const FixMessageView& msg) {
+        uint64_t readTicks = session_->getReadTicks();
+        char execType = msg.getChar(TAG_EXEC_TYPE);
+        auto clOrdId = msg.getUInt(TAG_CLORD_ID);
+        TrackedOrder* tracked = clOrdId ? &orders_[*clOrdId & mask_] : nullptr;
+        if (!tracked || tracked->seq != *clOrdId) {
+            // Late fills of resting orders are expected; late acknowledgements are not
+            if (execType == EXEC_TYPE_NEW || execType == EXEC_TYPE_REJECTED) {
+                ++report_.unmatched;
+            }
+            return;
+        }
+
+        uint64_t roundTrip = static_cast<uint64_t>(TscClock::toNanoseconds(elapsed(readTicks, tracked->sendTicks)));
+        switch (execType) {
+            case EXEC_TYPE_NEW:
+                if (tracked->acknowledged) {
+                    return;
+                }
+                tracked->acknowledged = true;
+                state_.outstanding.fetch_sub(1, std::memory_order_relaxed);
+                if (tracked->measured) {
+                    ++report_.acknowledged;
+                    report_.ack.record(roundTrip);
+                    report_.response.record(roundTrip + static_cast<uint64_t>(std::max<int64_t>(tracked->lagNs, 0)));
+                    recordStages(msg, *tracked, readTicks);
+                }
+                break;
+            case EXEC_TYPE_REJECTED:
+                if (!tracked->acknowledged) {
+                    tracked->acknowledged = true;
+                    state_.outstanding.fetch_sub(1, std::memory_order_relaxed);
+                    if (tracked->measured) {
+                        ++report_.rejected;
+                    }
+                }
+                break;
+            case EXEC_TYPE_PARTIAL_FILL:
+            case EXEC_TYPE_FILL:
+                // Only fills on arrival carry the trace; later fills are this order resting
+                if (!tracked->traded && msg.has(TAG_TRACE_RECEIVED_TICKS)) {
+                    tracked->traded = true;
+                    if (tracked->measured) {
+                        ++report_.traded;
+                        report_.fill.record(roundTrip);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void recordStages(const FixMessageView& msg, const TrackedOrder& tracked, uint64_t readTicks) {
+        auto received = msg.getUInt(TAG_TRACE_RECEIVED_TICKS);
+        if (!received) {
+            return;
+        }
+        uint64_t parsed = msg.getUInt(TAG_TRACE_PARSED_NS).value_or(0);
+        uint64_t dispatched = msg.getUInt(TAG_TRACE_DISPATCHED_NS).value_or(parsed);
+        uint64_t riskChecked = msg.getUInt(TAG_TRACE_RISK_CHECKED_NS).value_or(dispatched);
+        uint64_t matched = msg.getUInt(TAG_TRACE_MATCHED_NS).value_or(riskChecked);
+        uint64_t encoded = msg.getUInt(TAG_TRACE_ENCODED_NS).value_or(matched);
+        uint64_t sinceReceived = static_cast<uint64_t>(TscClock::toNanoseconds(elapsed(readTicks, *received)));
+
+        ++report_.traced;
+        auto* stages = report_.stages;
+        stages[FixLoadGenerator::Inbound].record(
+            static_cast<uint64_t>(TscClock::toNanoseconds(elapsed(*received, tracked.sendTicks))));
+        stages[FixLoadGenerator::Parse].record(parsed);
+        stages[FixLoadGenerator::Queue].record(elapsed(dispatched, parsed));
+        stages[FixLoadGenerator::Risk].record(elapsed(riskChecked, dispatched));
+        stages[FixLoadGenerator::Match].record(elapsed(matched, riskChecked));
+        stages[FixLoadGenerator::Encode].record(elapsed(encoded, matched));
+        stages[FixLoadGenerator::Outbound].record(elapsed(sinceReceived, encoded));
+    }
+
+    boost::asio::steady_timer timer_;
+    const FixLoadGenerator::LoadConfig& config_;
+    FixLoadGenerator::Report& report_;
+    RunState& state_;
+    std::shared_ptr<FixSession> session_;
+
+    FixMessageParser::NewOrderSingle order_;    // Reused for every send
+    std::vector<TrackedOrder> orders_;          // By ClOrdID modulo capacity
+    size_t mask_ = 0;
+    uint64_t nextSeq_ = 0;
+    uint64_t rng_;
+    PriceTicks midTicks_ = 0;
+
+    Clock::duration interval_{};
+    Clock::time_point nextDue_;
+    Clock::time_point measureFrom_;
+    Clock::time_point stop_;
+};
+
+}
+
+void FixLoadGenerator::Report::merge(const Report& other) {
+    ack.merge(other.ack);
+    response.merge(other.response);
+    fill.merge(other.fill);
+    for (size_t i = 0; i < StageCount; ++i) {
+        stages[i].merge(other.stages[i]);
+    }
+    sent += other.sent;
+    acknowledged += other.acknowledged;
+    rejected += other.rejected;
+    traded += other.traded;
+    traced += other.traced;
+    unmatched += other.unmatched;
+    max_lag_ns = std::max(max_lag_ns, other.max_lag_ns);
+}
+
+FixLoadGenerator::FixLoadGenerator(LoggerPtr logger) : FixLoadGenerator(std::move(logger), LoadConfig{}) {}
+
+FixLoadGenerator::FixLoadGenerator(LoggerPtr logger, const LoadConfig& config)
+    : logger_(std::move(logger)), config_(config) {
+    config_.sessions = std::max<size_t>(config_.sessions, 1);
+    config_.io_threads = std::max<size_t>(config_.io_threads, 1);
+    config_.price_range_ticks = std::max<int64_t>(config_.price_range_ticks, 0);
+    if (config_.rate <= 0.0) {
+        config_.rate = LoadConfig{}.rate;
+    }
+}
+
+Result<std::unique_ptr<FixLoadGenerator::Report>> FixLoadGenerator::run() const {
+    using ReportResult = Result<std::unique_ptr<Report>>;
+    TscClock::calibrate();
+
+    IoContextPool::PoolConfig poolConfig;
+    poolConfig.threads = config_.io_threads;
+    IoContextPool pool(logger_, poolConfig);
+
+    // One report per thread; sessions record into their thread's
+    RunState state;
+    std::vector<std::unique_ptr<Report>> threadReports;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        threadReports.push_back(std::make_unique<Report>());
+    }
+
+    std::vector<std::unique_ptr<LoadSession>> sessions;
+    sessions.reserve(config_.sessions);
+    for (size_t i = 0; i < config_.sessions; ++i) {
+        size_t context = pool.acquire();
+        sessions.push_back(std::make_unique<LoadSession>(pool.getContext(context), i, config_,
+                                                         *threadReports[context], state));
+    }
+
+    pool.start();
+    try {
+        for (size_t i = 0; i < sessions.size(); ++i) {
+            sessions[i]->connect(i);
+        }
+    } catch (const std::exception& e) {
+        pool.stop();
+        return ReportResult::error(std::string("Cannot connect: ") + e.what());
+    }
+
+    Clock::time_point logonDeadline = Clock::now() + LogonTimeout;
+    while (state.loggedIn.load(std::memory_order_relaxed) + state.disconnected.load(std::memory_order_relaxed) <
+               sessions.size() &&
+           Clock::now() < logonDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    size_t loggedIn = 0;
+    for (const auto& session : sessions) {
+        loggedIn += session->isLoggedIn() ? 1 : 0;
+    }
+    if (loggedIn == 0) {
+        pool.stop();
+        return ReportResult::error("No session logged in to " + config_.host + ":" + std::to_string(config_.port));
+    }
+    LOG_INFO(logger_, std::to_string(loggedIn) + " of " + std::to_string(sessions.size()) + " sessions logged in",
+             "FixLoadGenerator::run");
+
+    // Sessions start staggered across one send interval, spreading the load evenly
+    auto interval = std::chrono::duration<double>(static_cast<double>(config_.sessions) / config_.rate);
+    Clock::time_point start = Clock::now() + std::chrono::milliseconds(10);
+    Clock::time_point measureFrom = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config_.warmup_seconds));
+    Clock::time_point stop = measureFrom + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config_.duration_seconds));
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        Clock::time_point first = start + std::chrono::duration_cast<Clock::duration>(
+            interval * (static_cast<double>(i) / static_cast<double>(sessions.size())));
+        sessions[i]->schedule(first, measureFrom, stop);
+    }
+
+    std::this_thread::sleep_until(stop);
+    Clock::time_point drainDeadline = Clock::now() + DrainTimeout;
+    while (state.outstanding.load(std::memory_order_relaxed) > 0 && Clock::now() < drainDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Threads are joined before the reports are read or the sessions closed
+    pool.stop();
+    for (auto& session : sessions) {
+        session->close();
+    }
+
+    auto report = std::make_unique<Report>();
+    for (const auto& threadReport : threadReports) {
+        report->merge(*threadReport);
+    }
+    report->sessions = loggedIn;
+    report->seconds = config_.duration_seconds;
+    return ReportResult::success(std::move(report));
+}
+
+const char* FixLoadGenerator::stageName(Stage stage) {
+    switch (stage) {
+        case Inbound: return "inbound";
+        case Parse: return "parse";
+        case Queue: return "queue";
+        case Risk: return "risk";
+        case Match: return "match";
+        case Encode: return "encode";
+        case Outbound: return "outbound";
+        default: return "unknown";
+    }
+}
+
+FixLoadGenerator::LoadConfig FixLoadGenerator::loadConfiguration(std::shared_ptr<Config> config) {
+    LoadConfig load;
+    if (!config) {
+        return load;
+    }
+    load.port = static_cast<uint16_t>(config->getInt("network", "port", load.port));
+    load.symbol = config->getString("orderbook", "symbol", load.symbol);
+    load.tick_size = TickSize(config->getDouble("orderbook", "tick_size", 0.01));
+    load.sessions = static_cast<size_t>(
+        config->getInt("load_generator", "sessions", static_cast<int>(load.sessions)));
+    load.rate = config->getDouble("load_generator", "rate", load.rate);
+    load.duration_seconds = config->getDouble("load_generator", "duration_s", load.duration_seconds);
+    load.warmup_seconds = config->getDouble("load_generator", "warmup_s", load.warmup_seconds);
+    load.price = config->getDouble("load_generator", "price", load.price);
+    load.price_range_ticks = config->getInt("load_generator", "price_range_ticks",
+                                            static_cast<int>(load.price_range_ticks));
+    load.quantity = static_cast<Quantity>(
+        config->getInt("load_generator", "quantity", static_cast<int>(load.quantity)));
+    load.io_threads = static_cast<size_t>(
+        config->getInt("load_generator", "io_threads", static_cast<int>(load.io_threads)));
+    return load;
+}
+
+}
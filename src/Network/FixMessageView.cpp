@@ -0,0 +1,164 @@
+#include "orderbook/Network/FixMessageView.hpp"
+#include "orderbook/Network/FixSimd.hpp"
+#include <limits>
+
+namespace orderbook {
+
+using namespace fix;
+
+bool FixMessageView::parse(std::string_view raw, bool validateChecksum) {
+    raw_ = raw;
+    overflowCount_ = 0;
+    fieldCount_ = 0;
+    msgType_ = '\0';
+    isValid_ = false;
+    errorMessage_.clear();
+
+    // A new generation invalidates every previously recorded field
+    if (++generation_ == 0) {
+        direct_.fill(FieldRef{});
+        generation_ = 1;
+    }
+
+    if (raw.empty()) {
+        return fail("Empty message");
+    }
+
+    const char* data = raw.data();
+    const size_t size = raw.size();
+    size_t checksumStart = size;
+    
+    // Field boundaries come from the SIMD scanner a batch at a time
+    constexpr size_t BatchSize = 64;
+    simd::FieldBounds bounds[BatchSize];
+    size_t scanPos = 0;
+
+    while (scanPos < size) {
+        size_t count = simd::scanFields(data, size, scanPos, bounds, BatchSize);
+
+        for (size_t f = 0; f < count; ++f) {
+            const simd::FieldBounds& field = bounds[f];
+            std::string_view text = raw.substr(field.start, field.end - field.start);
+
+            if (field.equals == simd::NoEquals || field.equals == field.start) {
+                return fail("Invalid field format: " + std::string(text));
+            }
+
+            // Tag digits before '='
+            int tag = 0;
+            for (uint32_t i = field.start; i < field.equals; ++i) {
+                char c = data[i];
+                if (c < '0' || c > '9') {
+                    return fail("Invalid field format: " + std::string(text));
+                }
+                if (tag > (std::numeric_limits<int>::max() - 9) / 10) {
+                    return fail("Tag out of range at offset " + std::to_string(field.start));
+                }
+                tag = tag * 10 + (c - '0');
+            }
+
+            FieldRef ref{field.equals + 1, field.end - field.equals - 1, generation_};
+
+            if (tag == TAG_CHECKSUM) {
+                checksumStart = field.start;
+            }
+
+            if (tag < MaxDirectTag) {
+                direct_[tag] = ref;
+            } else {
+                size_t slot = 0;
+                while (slot < overflowCount_ && overflow_[slot].tag != tag) {
+                    ++slot;
+                }
+                if (slot == overflowCount_) {
+                    if (overflowCount_ == MaxOverflowFields) {
+                        return fail("Too many high-numbered fields");
+                    }
+                    ++overflowCount_;
+                }
+                overflow_[slot] = OverflowField{tag, ref};
+            }
+
+            ++fieldCount_;
+        }
+    }
+
+    // Validate required header fields
+    if (!has(TAG_BEGIN_STRING) || !has(TAG_BODY_LENGTH) ||
+        !has(TAG_MSG_TYPE) || !has(TAG_CHECKSUM)) {
+        return fail("Missing required header fields");
+    }
+
+    // Validate FIX version
+    if (get(TAG_BEGIN_STRING) != BEGIN_STRING_44) {
+        return fail("Unsupported FIX version: " + std::string(get(TAG_BEGIN_STRING)));
+    }
+
+    std::string_view msgType = get(TAG_MSG_TYPE);
+    if (msgType.empty()) {
+        return fail("Missing message type");
+    }
+    msgType_ = msgType.front();
+
+    std::string_view checksum = get(TAG_CHECKSUM);
+    if (checksum.length() != 3) {
+        return fail("Invalid checksum format");
+    }
+
+    if (validateChecksum) {
+        auto expected = getUInt(TAG_CHECKSUM);
+        uint8_t actual = simd::checksum(data, checksumStart);
+        if (!expected || *expected != actual) {
+            return fail("Checksum mismatch: expected " + std::string(checksum) + 
+                        ", calculated " + std::to_string(actual));
+        }
+    }
+
+    isValid_ = true;
+    return true;
+}
+
+std::optional<uint64_t> FixMessageView::getUInt(int tag) const {
+    std::string_view value = get(tag);
+    if (value.empty()) {
+        return std::nullopt;
+    }
+
+    uint64_t result = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        uint64_t digit = static_cast<uint64_t>(c - '0');
+        if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            return std::nullopt;
+        }
+        result = result * 10 + digit;
+    }
+    return result;
+}
+
+std::optional<int64_t> FixMessageView::getInt(int tag) const {
+    std::string_view value = get(tag);
+    bool negative = !value.empty() && value.front() == '-';
+    if (negative) {
+        value.remove_prefix(1);
+    }
+    if (value.empty()) {
+        return std::nullopt;
+    }
+
+    uint64_t magnitude = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        magnitude = magnitude * 10 + static_cast<uint64_t>(c - '0');
+        if (magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0)) {
+            return std::nullopt;
+        }
+    }
+    return negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+}
+
+}
@@ -0,0 +1,808 @@
+#include "orderbook/Network/FixOrderGateway.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+// Marks the runtime commands this gateway submitted, so their tags can be trusted
+constexpr uint32_t GatewayCommandSource = 0x464958;     // "FIX"
+
+}
+
+FixOrderGateway::FixOrderGateway(OrderBookRouter& router, LoggerPtr logger)
+    : router_(router), logger_(std::move(logger)) {
+    size_t shardCount = std::max<size_t>(router_.getShardCount(), 1);
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+FixOrderGateway::FixOrderGateway(OrderBookRouter& router, MatchingRuntime& runtime, LoggerPtr logger)
+    : FixOrderGateway(router, std::move(logger)) {
+    runtime_ = &runtime;
+    runtime_->setResultHandler([this](BookCommandResult& result) { onResult(result); });
+}
+
+FixOrderGateway::Shard& FixOrderGateway::ShardLock::acquire(uint32_t shard) {
+    Shard& target = *gateway_.shards_[shard];
+    if (held_ != shard) {
+        // Never hold two shard locks at once
+        if (lock_.owns_lock()) {
+            lock_.unlock();
+        }
+        lock_ = std::unique_lock<std::mutex>(target.mutex);
+        held_ = shard;
+    }
+    return target;
+}
+
+std::shared_ptr<FixOrderGateway::Client> FixOrderGateway::createClient(std::weak_ptr<FixSession> session) {
+    return std::make_shared<Client>(std::move(session));
+}
+
+void FixOrderGateway::processBatch(const std::shared_ptr<Client>& client,
+                                   const std::vector<FixOrderRequest>& requests) {
+    ShardLock lock(*this);
+    for (const auto& request : requests) {
+        switch (request.type) {
+            case FixOrderRequest::Type::New:
+                handleNewOrder(lock, client, request.newOrder,
+                               request.trace.isActive() ? &request.trace : nullptr);
+                break;
+            case FixOrderRequest::Type::CancelReplace:
+                handleCancelReplace(lock, client, request.cancelReplace);
+                break;
+            case FixOrderRequest::Type::Cancel:
+                handleCancel(lock, client, request.cancel);
+                break;
+            case FixOrderRequest::Type::MassCancel:
+                handleMassCancel(lock, client, request.massCancel);
+                break;
+        }
+    }
+}
+
+void FixOrderGateway::submitNewOrder(const std::shared_ptr<Client>& client,
+                                     const FixMessageParser::NewOrderSingle& newOrder) {
+    ShardLock lock(*this);
+    handleNewOrder(lock, client, newOrder);
+}
+
+void FixOrderGateway::submitCancelReplace(const std::shared_ptr<Client>& client,
+                                          const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
+    ShardLock lock(*this);
+    handleCancelReplace(lock, client, cancelReplace);
+}
+
+void FixOrderGateway::submitCancel(const std::shared_ptr<Client>& client,
+                                   const FixMessageParser::OrderCancelRequest& cancel) {
+    ShardLock lock(*this);
+    handleCancel(lock, client, cancel);
+}
+
+size_t FixOrderGateway::cancelClientOrders(const std::shared_ptr<Client>& client) {
+    if (runtime_) {
+        return submitClientCancels(client, std::nullopt, std::nullopt, nullptr);
+    }
+    ShardLock lock(*this);
+    return cancelClientOrders(lock, client, std::nullopt, std::nullopt);
+}
+
+size_t FixOrderGateway::getWorkingOrderCount() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->orders.size();
+    }
+    return count;
+}
+
+void FixOrderGateway::handleNewOrder(ShardLock& lock, const std::shared_ptr<Client>& client,
+                                     const FixMessageParser::NewOrderSingle& newOrder,
+                                     const LatencyTrace* inboundTrace) {
+    if (!newOrder.isValid) {
+        sendReject(client, newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                   "Invalid order format: " + newOrder.errorMessage);
+        return;
+    }
+
+    auto symbol = InternTable::symbols().find(newOrder.symbol);
+    uint32_t shardIndex = symbol ? router_.getShard(*symbol) : OrderBookRouter::AutoShard;
+    if (shardIndex == OrderBookRouter::AutoShard || shardIndex >= shards_.size()) {
+        sendReject(client, newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                   "Unknown symbol: " + newOrder.symbol);
+        return;
+    }
+
+    if (runtime_) {
+        // The ClOrdID is claimed now; the result handler releases it if the order does not rest
+        OrderId id(nextOrderId_.fetch_add(1, std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> clientLock(client->mutex_);
+            if (!client->orders_.emplace(newOrder.clOrdId, Client::OrderRef{id, *symbol, newOrder.side}).second) {
+                sendReject(client, newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                           "Duplicate ClOrdID: " + newOrder.clOrdId);
+                return;
+            }
+        }
+
+        auto request = std::make_unique<PendingRequest>();
+        request->type = FixOrderRequest::Type::New;
+        request->client = client;
+        request->clOrdId = newOrder.clOrdId;
+        request->symbol = newOrder.symbol;
+        request->side = newOrder.side;
+        request->orderQty = newOrder.quantity;
+        request->price = newOrder.price;
+        if (inboundTrace) {
+            request->trace = *inboundTrace;
+            request->traced = true;
+            request->trace.stamp(LatencyTrace::Dispatched);
+        }
+
+        BookCommand command = BookCommand::add(
+            Order(id.value, newOrder.side, newOrder.orderType, newOrder.timeInForce, newOrder.price,
+                  newOrder.quantity, *symbol, InternTable::accounts().intern(newOrder.account)));
+        command.trace = request->traced ? &request->trace : nullptr;
+        submitRequest(command, std::move(request));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        if (client->orders_.count(newOrder.clOrdId) != 0) {
+            sendReject(client, newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                       "Duplicate ClOrdID: " + newOrder.clOrdId);
+            return;
+        }
+    }
+
+    Shard& shard = lock.acquire(shardIndex);
+    
+    // A traced order's stamps continue here and go back in its own reports
+    LatencyTrace trace;
+    LatencyTrace* traced = nullptr;
+    if (inboundTrace) {
+        trace = *inboundTrace;
+        traced = &trace;
+        traced->stamp(LatencyTrace::Dispatched);
+    }
+    
+    OrderId id(nextOrderId_.fetch_add(1, std::memory_order_relaxed));
+    Order order(id.value, newOrder.side, newOrder.orderType, newOrder.timeInForce,
+                newOrder.price, newOrder.quantity, *symbol, InternTable::accounts().intern(newOrder.account));
+
+    // Registered before matching so fills against it can be attributed
+    LiveOrder live;
+    live.client = client;
+    live.clOrdId = newOrder.clOrdId;
+    live.symbol = *symbol;
+    live.side = newOrder.side;
+    live.orderQty = newOrder.quantity;
+    live.price = newOrder.price;
+    shard.orders.emplace(id, std::move(live));
+
+    shard.match.trace = traced;
+    auto result = router_.addOrder(order, shard.match);
+    shard.match.trace = nullptr;
+    if (traced) {
+        traced->stamp(LatencyTrace::Matched);
+    }
+    if (result.isError()) {
+        shard.orders.erase(id);
+        sendReject(client, newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                   "Order rejected: " + result.error());
+        return;
+    }
+    ordersAccepted_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        auto it = shard.orders.find(id);
+        sendReport(shard, id, it->second, EXEC_TYPE_NEW, ORD_STATUS_NEW, 0, 0.0, traced);
+    }
+    reportTrades(shard, shard.match.trades, id, traced);
+
+    auto it = shard.orders.find(id);
+    if (it == shard.orders.end()) {
+        return;     // Filled on arrival
+    }
+
+    if (!shard.match.hasRemainingOrder()) {
+        // Nothing left in the book (e.g. an IOC remainder)
+        sendReport(shard, id, it->second, EXEC_TYPE_CANCELLED, ORD_STATUS_CANCELLED);
+        shard.orders.erase(it);
+        return;
+    }
+
+    std::lock_guard<std::mutex> clientLock(client->mutex_);
+    client->orders_.insert_or_assign(newOrder.clOrdId, Client::OrderRef{id, *symbol, newOrder.side});
+}
+
+void FixOrderGateway::handleCancelReplace(ShardLock& lock, const std::shared_ptr<Client>& client,
+                                          const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
+    if (!cancelReplace.isValid) {
+        if (auto session = client->session_.lock()) {
+            session->sendReject(0, "Invalid cancel replace request: " + cancelReplace.errorMessage);
+        }
+        return;
+    }
+
+    auto ref = findClientOrder(client, cancelReplace.origClOrdId);
+    if (!ref) {
+        sendReject(client, cancelReplace.clOrdId, cancelReplace.symbol, cancelReplace.side,
+                   "Original order not found: " + cancelReplace.origClOrdId);
+        return;
+    }
+
+    if (runtime_) {
+        auto request = std::make_unique<PendingRequest>();
+        request->type = FixOrderRequest::Type::CancelReplace;
+        request->client = client;
+        request->clOrdId = cancelReplace.clOrdId;
+        request->origClOrdId = cancelReplace.origClOrdId;
+        request->symbol = cancelReplace.symbol;
+        request->side = cancelReplace.side;
+        request->orderQty = cancelReplace.quantity;
+        request->price = cancelReplace.price;
+        submitRequest(BookCommand::modify(ref->symbol, ref->id, cancelReplace.price, cancelReplace.quantity),
+                      std::move(request));
+        return;
+    }
+
+    Shard& shard = lock.acquire(router_.getShard(ref->symbol));
+    auto it = shard.orders.find(ref->id);
+    if (it == shard.orders.end()) {
+        forgetClientOrder(client, cancelReplace.origClOrdId);
+        sendReject(client, cancelReplace.clOrdId, cancelReplace.symbol, cancelReplace.side,
+                   "Order is no longer working: " + cancelReplace.origClOrdId);
+        return;
+    }
+
+    auto result = router_.modifyOrder(ref->symbol, ref->id, cancelReplace.price, cancelReplace.quantity);
+    if (result.isError()) {
+        sendReject(client, cancelReplace.clOrdId, cancelReplace.symbol, cancelReplace.side,
+                   "Modify failed: " + result.error());
+        return;
+    }
+
+    LiveOrder& live = it->second;
+    live.clOrdId = cancelReplace.clOrdId;
+    if (cancelReplace.price > 0.0) {
+        live.price = cancelReplace.price;
+    }
+    if (cancelReplace.quantity > 0) {
+        live.orderQty = cancelReplace.quantity;
+    }
+
+    // Cut to what has already filled: the book cancelled the order
+    bool filled = live.cumQty >= live.orderQty;
+    {
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        client->orders_.erase(cancelReplace.origClOrdId);
+        if (!filled) {
+            client->orders_.insert_or_assign(cancelReplace.clOrdId, *ref);
+        }
+    }
+
+    sendReport(shard, ref->id, live, EXEC_TYPE_REPLACED,
+               filled ? ORD_STATUS_FILLED : live.cumQty > 0 ? ORD_STATUS_PARTIALLY_FILLED : ORD_STATUS_NEW);
+    if (filled) {
+        shard.orders.erase(it);
+    }
+}
+
+void FixOrderGateway::handleCancel(ShardLock& lock, const std::shared_ptr<Client>& client,
+                                   const FixMessageParser::OrderCancelRequest& cancel) {
+    if (!cancel.isValid) {
+        if (auto session = client->session_.lock()) {
+            session->sendReject(0, "Invalid cancel request: " + cancel.errorMessage);
+        }
+        return;
+    }
+
+    auto ref = findClientOrder(client, cancel.origClOrdId);
+    if (!ref) {
+        sendReject(client, cancel.clOrdId, cancel.symbol, cancel.side,
+                   "Original order not found: " + cancel.origClOrdId);
+        return;
+    }
+
+    if (runtime_) {
+        auto request = std::make_unique<PendingRequest>();
+        request->type = FixOrderRequest::Type::Cancel;
+        request->client = client;
+        request->clOrdId = cancel.clOrdId;
+        request->origClOrdId = cancel.origClOrdId;
+        request->symbol = cancel.symbol;
+        request->side = cancel.side;
+        submitRequest(BookCommand::cancel(ref->symbol, ref->id), std::move(request));
+        return;
+    }
+
+    Shard& shard = lock.acquire(router_.getShard(ref->symbol));
+    auto it = shard.orders.find(ref->id);
+    if (it == shard.orders.end()) {
+        forgetClientOrder(client, cancel.origClOrdId);
+        sendReject(client, cancel.clOrdId, cancel.symbol, cancel.side,
+                   "Order is no longer working: " + cancel.origClOrdId);
+        return;
+    }
+
+    auto result = router_.cancelOrder(ref->symbol, ref->id);
+    if (result.isError()) {
+        sendReject(client, cancel.clOrdId, cancel.symbol, cancel.side,
+                   "Cancel failed: " + result.error());
+        return;
+    }
+
+    it->second.clOrdId = cancel.clOrdId;
+    sendReport(shard, ref->id, it->second, EXEC_TYPE_CANCELLED, ORD_STATUS_CANCELLED);
+    shard.orders.erase(it);
+    forgetClientOrder(client, cancel.origClOrdId);
+}
+
+void FixOrderGateway::handleMassCancel(ShardLock& lock, const std::shared_ptr<Client>& client,
+                                       const FixMessageParser::OrderMassCancelRequest& massCancel) {
+    auto session = client->session_.lock();
+    if (!massCancel.isValid) {
+        if (session) {
+            session->sendReject(0, "Invalid mass cancel request: " + massCancel.errorMessage);
+        }
+        return;
+    }
+
+    FixMessageParser::OrderMassCancelReport report;
+    report.clOrdId = massCancel.clOrdId;
+    report.orderId = "0";   // Not one order
+    report.massCancelRequestType = massCancel.massCancelRequestType;
+    report.symbol = massCancel.symbol;
+    report.side = massCancel.side;
+
+    std::optional<SymbolId> symbol;
+    if (massCancel.massCancelRequestType == MASS_CANCEL_BY_SYMBOL) {
+        symbol = InternTable::symbols().find(massCancel.symbol);
+        if (!symbol || router_.getShard(*symbol) == OrderBookRouter::AutoShard) {
+            report.rejectReason = MASS_CANCEL_REJECT_UNKNOWN_SECURITY;
+            report.text = "Unknown symbol: " + massCancel.symbol;
+            symbol.reset();
+        }
+    }
+
+    if (report.rejectReason == 0 && runtime_) {
+        // Reported once the last of its cancels has been applied
+        auto pending = std::make_shared<MassCancel>();
+        pending->client = client;
+        pending->report = std::move(report);
+        pending->report.massCancelResponse = massCancel.massCancelRequestType;
+        pending->pending.store(1, std::memory_order_relaxed);
+        submitClientCancels(client, symbol, massCancel.side, pending);
+        if (pending->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            completeMassCancel(*pending);
+        }
+        return;
+    }
+
+    if (report.rejectReason == 0) {
+        report.totalAffectedOrders = cancelClientOrders(lock, client, symbol, massCancel.side);
+        report.massCancelResponse = massCancel.massCancelRequestType;
+    }
+
+    if (session) {
+        report.transactTime = std::chrono::system_clock::now();
+        session->sendOrderMassCancelReport(report);
+    }
+}
+
+size_t FixOrderGateway::cancelClientOrders(ShardLock& lock, const std::shared_ptr<Client>& client,
+                                           std::optional<SymbolId> symbol, std::optional<Side> side) {
+    // Copied out first: the client lock is never held while taking a shard lock
+    std::vector<Client::OrderRef> refs;
+    {
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        refs.reserve(client->orders_.size());
+        for (const auto& entry : client->orders_) {
+            if (!symbol || entry.second.symbol == *symbol) {
+                refs.push_back(entry.second);
+            }
+        }
+    }
+    if (refs.empty()) {
+        return 0;
+    }
+
+    // Grouped by shard and book, so each shard is locked once and each book swept once
+    std::sort(refs.begin(), refs.end(), [this](const Client::OrderRef& a, const Client::OrderRef& b) {
+        uint32_t shardA = router_.getShard(a.symbol);
+        uint32_t shardB = router_.getShard(b.symbol);
+        return shardA != shardB ? shardA < shardB : a.symbol < b.symbol;
+    });
+
+    std::vector<OrderId> ids;
+    std::vector<OrderId> cancelled;
+    std::vector<std::string> clOrdIds;
+    size_t total = 0;
+    for (size_t begin = 0; begin < refs.size();) {
+        SymbolId book = refs[begin].symbol;
+        size_t end = begin;
+        while (end < refs.size() && refs[end].symbol == book) {
+            ++end;
+        }
+
+        Shard& shard = lock.acquire(router_.getShard(book));
+
+        // Orders filled since the copy was taken are no longer in shard.orders
+        ids.clear();
+        for (size_t i = begin; i < end; ++i) {
+            auto it = shard.orders.find(refs[i].id);
+            if (it != shard.orders.end() && (!side || it->second.side == *side)) {
+                ids.push_back(refs[i].id);
+            }
+        }
+        begin = end;
+
+        cancelled.clear();
+        if (OrderBook* orderBook = router_.getBook(book)) {
+            orderBook->cancelOrders(ids.data(), ids.size(), &cancelled);
+        }
+
+        clOrdIds.clear();
+        for (OrderId id : cancelled) {
+            auto it = shard.orders.find(id);
+            sendReport(shard, id, it->second, EXEC_TYPE_CANCELLED, ORD_STATUS_CANCELLED);
+            clOrdIds.push_back(std::move(it->second.clOrdId));
+            shard.orders.erase(it);
+        }
+        total += cancelled.size();
+
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        for (const std::string& clOrdId : clOrdIds) {
+            client->orders_.erase(clOrdId);
+        }
+    }
+
+    LOG_INFO(logger_, "Mass cancel removed " + std::to_string(total) + " working orders",
+                      "FixOrderGateway::cancelClientOrders");
+    return total;
+}
+
+void FixOrderGateway::reportTrades(Shard& shard, const MatchResult::TradeList& trades, OrderId aggressor,
+                                   const LatencyTrace* trace) {
+    for (const Trade& trade : trades) {
+        for (OrderId id : {trade.buy_order_id, trade.sell_order_id}) {
+            auto it = shard.orders.find(id);
+            if (it == shard.orders.end()) {
+                continue;   // Not a FIX order
+            }
+
+            LiveOrder& live = it->second;
+            live.cumQty += trade.quantity;
+            live.notional += trade.price * static_cast<double>(trade.quantity);
+
+            bool filled = live.cumQty >= live.orderQty;
+            sendReport(shard, id, live, filled ? EXEC_TYPE_FILL : EXEC_TYPE_PARTIAL_FILL,
+                       filled ? ORD_STATUS_FILLED : ORD_STATUS_PARTIALLY_FILLED,
+                       trade.quantity, trade.price, id == aggressor ? trace : nullptr);
+            fillsReported_.fetch_add(1, std::memory_order_relaxed);
+
+            if (filled) {
+                if (auto owner = live.client.lock()) {
+                    forgetClientOrder(owner, live.clOrdId);
+                }
+                shard.orders.erase(it);
+            }
+        }
+    }
+}
+
+void FixOrderGateway::submitRequest(const BookCommand& command, std::unique_ptr<PendingRequest> request) {
+    BookCommand tagged = command;
+    tagged.source = GatewayCommandSource;
+    tagged.tag = reinterpret_cast<uintptr_t>(request.get());
+    auto submitted = runtime_->submit(tagged);
+    if (submitted.isSuccess()) {
+        request.release();      // Owned by the result handler from here
+        return;
+    }
+
+    // Refused before reaching a book (full queue or pre-trade risk)
+    auto client = request->client.lock();
+    switch (request->type) {
+        case FixOrderRequest::Type::New:
+            if (client) {
+                forgetClientOrder(client, request->clOrdId);
+                sendReject(client, request->clOrdId, request->symbol, request->side,
+                           "Order rejected: " + submitted.error());
+            }
+            break;
+        case FixOrderRequest::Type::CancelReplace:
+            if (client) {
+                sendReject(client, request->clOrdId, request->symbol, request->side,
+                           "Modify failed: " + submitted.error());
+            }
+            break;
+        case FixOrderRequest::Type::Cancel:
+            if (request->massCancel) {
+                if (request->massCancel->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    completeMassCancel(*request->massCancel);
+                }
+            } else if (client) {
+                sendReject(client, request->clOrdId, request->symbol, request->side,
+                           "Cancel failed: " + submitted.error());
+            }
+            break;
+        case FixOrderRequest::Type::MassCancel:
+            break;
+    }
+}
+
+size_t FixOrderGateway::submitClientCancels(const std::shared_ptr<Client>& client, std::optional<SymbolId> symbol,
+                                            std::optional<Side> side,
+                                            const std::shared_ptr<MassCancel>& massCancel) {
+    std::vector<std::pair<std::string, Client::OrderRef>> refs;
+    {
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        refs.reserve(client->orders_.size());
+        for (const auto& entry : client->orders_) {
+            if ((!symbol || entry.second.symbol == *symbol) && (!side || entry.second.side == *side)) {
+                refs.emplace_back(entry.first, entry.second);
+            }
+        }
+    }
+    if (massCancel) {
+        massCancel->pending.fetch_add(refs.size(), std::memory_order_relaxed);
+    }
+
+    // One Cancel per order; orders filled meanwhile fail quietly on their shard
+    for (const auto& [clOrdId, ref] : refs) {
+        auto request = std::make_unique<PendingRequest>();
+        request->type = FixOrderRequest::Type::Cancel;
+        request->client = client;
+        request->origClOrdId = clOrdId;
+        request->symbol = std::string(InternTable::symbols().name(ref.symbol));
+        request->side = ref.side;
+        request->massCancel = massCancel;
+        submitRequest(BookCommand::cancel(ref.symbol, ref.id), std::move(request));
+    }
+    return refs.size();
+}
+
+void FixOrderGateway::onResult(BookCommandResult& result) {
+    if (result.source != GatewayCommandSource) {
+        return;     // Submitted to the runtime by someone else
+    }
+    std::unique_ptr<PendingRequest> request(reinterpret_cast<PendingRequest*>(static_cast<uintptr_t>(result.tag)));
+
+    // Only this shard's thread reaches its orders; the lock keeps statistics readers safe
+    Shard& shard = *shards_[router_.getShard(result.symbol_id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    switch (request->type) {
+        case FixOrderRequest::Type::New:
+            completeNewOrder(shard, *request, result);
+            break;
+        case FixOrderRequest::Type::CancelReplace:
+            completeCancelReplace(shard, *request, result);
+            break;
+        case FixOrderRequest::Type::Cancel:
+            completeCancel(shard, *request, result);
+            break;
+        case FixOrderRequest::Type::MassCancel:
+            break;
+    }
+}
+
+void FixOrderGateway::completeNewOrder(Shard& shard, PendingRequest& request, const BookCommandResult& result) {
+    auto client = request.client.lock();
+    if (!result.success) {
+        if (client) {
+            forgetClientOrder(client, request.clOrdId);
+            sendReject(client, request.clOrdId, request.symbol, request.side, "Order rejected: " + result.error);
+        }
+        return;
+    }
+    ordersAccepted_.fetch_add(1, std::memory_order_relaxed);
+
+    const LatencyTrace* traced = nullptr;
+    if (request.traced) {
+        request.trace.stamp(LatencyTrace::Matched);
+        traced = &request.trace;
+    }
+
+    OrderId id = result.order_id;
+    LiveOrder live;
+    live.client = request.client;
+    live.clOrdId = request.clOrdId;
+    live.symbol = result.symbol_id;
+    live.side = request.side;
+    live.orderQty = request.orderQty;
+    live.price = request.price;
+    {
+        auto it = shard.orders.emplace(id, std::move(live)).first;
+        sendReport(shard, id, it->second, EXEC_TYPE_NEW, ORD_STATUS_NEW, 0, 0.0, traced);
+    }
+    reportTrades(shard, result.trades, id, traced);
+
+    auto it = shard.orders.find(id);
+    if (it != shard.orders.end() && result.resting == 0) {
+        // Nothing left in the book (e.g. an IOC remainder)
+        sendReport(shard, id, it->second, EXEC_TYPE_CANCELLED, ORD_STATUS_CANCELLED);
+        if (client) {
+            forgetClientOrder(client, request.clOrdId);
+        }
+        shard.orders.erase(it);
+    }
+}
+
+void FixOrderGateway::completeCancelReplace(Shard& shard, PendingRequest& request, const BookCommandResult& result) {
+    auto client = request.client.lock();
+    auto it = shard.orders.find(result.order_id);
+    if (it == shard.orders.end()) {
+        if (client) {
+            forgetClientOrder(client, request.origClOrdId);
+            sendReject(client, request.clOrdId, request.symbol, request.side,
+                       "Order is no longer working: " + request.origClOrdId);
+        }
+        return;
+    }
+    if (!result.success) {
+        if (client) {
+            sendReject(client, request.clOrdId, request.symbol, request.side, "Modify failed: " + result.error);
+        }
+        return;
+    }
+
+    LiveOrder& live = it->second;
+    live.clOrdId = request.clOrdId;
+    if (request.price > 0.0) {
+        live.price = request.price;
+    }
+    if (request.orderQty > 0) {
+        live.orderQty = request.orderQty;
+    }
+
+    // Cut to what has already filled: the book cancelled the order
+    bool filled = live.cumQty >= live.orderQty;
+    if (client) {
+        std::lock_guard<std::mutex> clientLock(client->mutex_);
+        client->orders_.erase(request.origClOrdId);
+        if (!filled) {
+            client->orders_.insert_or_assign(request.clOrdId, Client::OrderRef{result.order_id, live.symbol, live.side});
+        }
+    }
+
+    sendReport(shard, result.order_id, live, EXEC_TYPE_REPLACED,
+               filled ? ORD_STATUS_FILLED : live.cumQty > 0 ? ORD_STATUS_PARTIALLY_FILLED : ORD_STATUS_NEW);
+    if (filled) {
+        shard.orders.erase(it);
+    }
+}
+
+void FixOrderGateway::completeCancel(Shard& shard, PendingRequest& request, const BookCommandResult& result) {
+    auto client = request.client.lock();
+    auto it = shard.orders.find(result.order_id);
+    bool cancelled = result.success && it != shard.orders.end();
+    if (cancelled) {
+        if (!request.clOrdId.empty()) {
+            it->second.clOrdId = request.clOrdId;
+        }
+        sendReport(shard, result.order_id, it->second, EXEC_TYPE_CANCELLED, ORD_STATUS_CANCELLED);
+        shard.orders.erase(it);
+        if (client) {
+            forgetClientOrder(client, request.origClOrdId);
+        }
+    } else if (!request.massCancel && client) {
+        if (it == shard.orders.end()) {
+            forgetClientOrder(client, request.origClOrdId);
+            sendReject(client, request.clOrdId, request.symbol, request.side,
+                       "Order is no longer working: " + request.origClOrdId);
+        } else {
+            sendReject(client, request.clOrdId, request.symbol, request.side, "Cancel failed: " + result.error);
+        }
+    }
+
+    if (request.massCancel) {
+        if (cancelled) {
+            request.massCancel->cancelled.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (request.massCancel->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            completeMassCancel(*request.massCancel);
+        }
+    }
+}
+
+void FixOrderGateway::completeMassCancel(MassCancel& massCancel) {
+    massCancel.report.totalAffectedOrders = massCancel.cancelled.load(std::memory_order_relaxed);
+    LOG_INFO(logger_, "Mass cancel removed " + std::to_string(massCancel.report.totalAffectedOrders) +
+                      " working orders", "FixOrderGateway::completeMassCancel");
+
+    auto client = massCancel.client.lock();
+    auto session = client ? client->session_.lock() : nullptr;
+    if (session) {
+        massCancel.report.transactTime = std::chrono::system_clock::now();
+        session->sendOrderMassCancelReport(massCancel.report);
+    }
+}
+
+void FixOrderGateway::sendReport(Shard& shard, OrderId id, const LiveOrder& order, char execType, char ordStatus,
+                                 Quantity lastQty, Price lastPx, const LatencyTrace* trace) {
+    auto owner = order.client.lock();
+    if (!owner) {
+        return;
+    }
+    auto session = owner->session_.lock();
+    if (!session || !session->isLoggedIn()) {
+        return;
+    }
+
+    bool done = execType == EXEC_TYPE_CANCELLED;
+
+    FixMessageParser::ExecutionReport& report = shard.report;
+    report.orderId = std::to_string(id.value);
+    report.clOrdId = order.clOrdId;
+    report.execId = "EXEC" + std::to_string(nextExecId_.fetch_add(1, std::memory_order_relaxed));
+    report.execType = execType;
+    report.ordStatus = ordStatus;
+    report.symbol = InternTable::symbols().name(order.symbol);
+    report.side = order.side;
+    report.orderQty = order.orderQty;
+    report.price = order.price;
+    report.lastQty = lastQty;
+    report.lastPx = lastPx;
+    report.leavesQty = done || order.cumQty >= order.orderQty ? 0 : order.orderQty - order.cumQty;
+    report.cumQty = order.cumQty;
+    report.avgPx = order.cumQty > 0 ? order.notional / static_cast<double>(order.cumQty) : 0.0;
+    report.transactTime = std::chrono::system_clock::now();
+    report.trace = trace;
+
+    session->sendExecutionReport(report);
+}
+
+void FixOrderGateway::sendReject(const std::shared_ptr<Client>& client, const std::string& clOrdId,
+                                 const std::string& symbol, Side side, const std::string& reason) {
+    ordersRejected_.fetch_add(1, std::memory_order_relaxed);
+    LOG_DEBUG(logger_, "Rejected " + clOrdId + ": " + reason, "FixOrderGateway::sendReject");
+
+    auto session = client->session_.lock();
+    if (!session || !session->isLoggedIn()) {
+        return;
+    }
+
+    FixMessageParser::ExecutionReport report;
+    report.orderId = "0";   // No internal order ID for rejected orders
+    report.clOrdId = clOrdId;
+    report.execId = "EXEC" + std::to_string(nextExecId_.fetch_add(1, std::memory_order_relaxed));
+    report.execType = EXEC_TYPE_REJECTED;
+    report.ordStatus = ORD_STATUS_REJECTED;
+    report.symbol = symbol;
+    report.side = side;
+    report.orderQty = 0;
+    report.price = 0.0;
+    report.leavesQty = 0;
+    report.cumQty = 0;
+    report.avgPx = 0.0;
+    report.transactTime = std::chrono::system_clock::now();
+
+    session->sendExecutionReport(report);
+}
+
+std::optional<FixOrderGateway::Client::OrderRef> FixOrderGateway::findClientOrder(
+    const std::shared_ptr<Client>& client, const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(client->mutex_);
+    auto it = client->orders_.find(clOrdId);
+    if (it == client->orders_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void FixOrderGateway::forgetClientOrder(const std::shared_ptr<Client>& client, const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(client->mutex_);
+    client->orders_.erase(clOrdId);
+}
+
+}
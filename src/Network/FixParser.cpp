@@ -1,5 +1,6 @@
 #include "orderbook/Network/FixParser.hpp"
 #include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Network/FixSimd.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -88,198 +89,280 @@ FixMessageParser::FixMessage FixMessageParser::parseMessage(const std::string& r
 }
 
 FixMessageParser::NewOrderSingle FixMessageParser::parseNewOrderSingle(const FixMessage& fixMsg) {
-    NewOrderSingle nos;
-    
     if (!fixMsg.isValid) {
+        NewOrderSingle nos;
         nos.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage;
         return nos;
     }
     
-    if (fixMsg.msgType != MSG_TYPE_NEW_ORDER_SINGLE) {
+    FixMessageView view;
+    view.parse(fixMsg.rawMessage);
+    return parseNewOrderSingle(view);
+}
+
+FixMessageParser::NewOrderSingle FixMessageParser::parseNewOrderSingle(const FixMessageView& fixMsg) {
+    NewOrderSingle nos;
+    
+    if (!fixMsg.isValid()) {
+        nos.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage();
+        return nos;
+    }
+    
+    if (fixMsg.msgType() != MSG_TYPE_NEW_ORDER_SINGLE) {
         nos.errorMessage = "Not a New Order Single message";
         return nos;
     }
     
-    try {
-        // Required fields
-        nos.clOrdId = fixMsg.getField(TAG_CLORD_ID);
-        nos.symbol = fixMsg.getField(TAG_SYMBOL);
-        
-        if (nos.clOrdId.empty() || nos.symbol.empty()) {
-            nos.errorMessage = "Missing required fields (ClOrdID or Symbol)";
-            return nos;
-        }
-        
-        // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
-        if (sideStr.empty()) {
-            nos.errorMessage = "Missing Side field";
-            return nos;
-        }
-        nos.side = fixCharToSide(sideStr[0]);
-        
-        // Order Type
-        std::string ordTypeStr = fixMsg.getField(TAG_ORD_TYPE);
-        if (ordTypeStr.empty()) {
-            nos.errorMessage = "Missing OrdType field";
+    // Required fields
+    nos.clOrdId = fixMsg.getString(TAG_CLORD_ID);
+    nos.symbol = fixMsg.getString(TAG_SYMBOL);
+    
+    if (nos.clOrdId.empty() || nos.symbol.empty()) {
+        nos.errorMessage = "Missing required fields (ClOrdID or Symbol)";
+        return nos;
+    }
+    
+    // Side
+    char side = fixMsg.getChar(TAG_SIDE);
+    if (side == '\0') {
+        nos.errorMessage = "Missing Side field";
+        return nos;
+    }
+    nos.side = fixCharToSide(side);
+    
+    // Order Type
+    char ordType = fixMsg.getChar(TAG_ORD_TYPE);
+    if (ordType == '\0') {
+        nos.errorMessage = "Missing OrdType field";
+        return nos;
+    }
+    nos.orderType = fixCharToOrderType(ordType);
+    
+    // Quantity
+    if (!fixMsg.has(TAG_ORDER_QTY)) {
+        nos.errorMessage = "Missing OrderQty field";
+        return nos;
+    }
+    auto quantity = fixMsg.getUInt(TAG_ORDER_QTY);
+    if (!quantity) {
+        nos.errorMessage = "Invalid OrderQty: " + fixMsg.getString(TAG_ORDER_QTY);
+        return nos;
+    }
+    nos.quantity = *quantity;
+    
+    // Price (required for limit orders)
+    if (nos.orderType == OrderType::Limit) {
+        if (fixMsg.get(TAG_PRICE).empty()) {
+            nos.errorMessage = "Missing Price field for limit order";
             return nos;
         }
-        nos.orderType = fixCharToOrderType(ordTypeStr[0]);
-        
-        // Quantity
-        std::string qtyStr = fixMsg.getField(TAG_ORDER_QTY);
-        if (qtyStr.empty()) {
-            nos.errorMessage = "Missing OrderQty field";
+        auto ticks = fixMsg.getPriceTicks(TAG_PRICE, tickSize_);
+        if (!ticks) {
+            nos.errorMessage = "Price " + fixMsg.getString(TAG_PRICE) + " is not a multiple of tick size";
             return nos;
         }
-        nos.quantity = std::stoull(qtyStr);
-        
-        // Price (required for limit orders)
-        std::string priceStr = fixMsg.getField(TAG_PRICE);
-        if (nos.orderType == OrderType::Limit) {
-            if (priceStr.empty()) {
-                nos.errorMessage = "Missing Price field for limit order";
-                return nos;
-            }
-            nos.price = std::stod(priceStr);
-        } else {
-            nos.price = 0.0; // Market order
-        }
-        
-        // Time In Force (optional, default to GTC)
-        std::string tifStr = fixMsg.getField(TAG_TIME_IN_FORCE);
-        nos.timeInForce = tifStr.empty() ? TimeInForce::GTC : fixCharToTif(tifStr[0]);
-        
-        // Account (optional)
-        nos.account = fixMsg.getField(TAG_CLORD_ID); // Using ClOrdID as account for simplicity
-        
-        // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
-        nos.transactTime = transactTimeStr.empty() ? 
-            std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
-        
-        nos.isValid = true;
-        
-    } catch (const std::exception& e) {
-        nos.errorMessage = "Failed to parse New Order Single: " + std::string(e.what());
+        nos.priceTicks = *ticks;
+        nos.price = tickSize_.toPrice(*ticks);
+    } else {
+        nos.price = 0.0; // Market order
     }
     
+    // Time In Force (optional, default to GTC)
+    char tif = fixMsg.getChar(TAG_TIME_IN_FORCE);
+    nos.timeInForce = tif == '\0' ? TimeInForce::GTC : fixCharToTif(tif);
+    
+    // Account (optional; orders without one are their own account)
+    nos.account = fixMsg.has(TAG_ACCOUNT) ? fixMsg.getString(TAG_ACCOUNT) : nos.clOrdId;
+    
+    // Transaction Time
+    std::string_view transactTime = fixMsg.get(TAG_TRANSACT_TIME);
+    nos.transactTime = transactTime.empty() ? 
+        std::chrono::system_clock::now() : parseTimestamp(std::string(transactTime));
+    
+    nos.isValid = true;
     return nos;
 }
 
 FixMessageParser::OrderCancelReplaceRequest FixMessageParser::parseOrderCancelReplaceRequest(const FixMessage& fixMsg) {
-    OrderCancelReplaceRequest ocrr;
-    
     if (!fixMsg.isValid) {
+        OrderCancelReplaceRequest ocrr;
         ocrr.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage;
         return ocrr;
     }
     
-    if (fixMsg.msgType != MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST) {
+    FixMessageView view;
+    view.parse(fixMsg.rawMessage);
+    return parseOrderCancelReplaceRequest(view);
+}
+
+FixMessageParser::OrderCancelReplaceRequest FixMessageParser::parseOrderCancelReplaceRequest(const FixMessageView& fixMsg) {
+    OrderCancelReplaceRequest ocrr;
+    
+    if (!fixMsg.isValid()) {
+        ocrr.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage();
+        return ocrr;
+    }
+    
+    if (fixMsg.msgType() != MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST) {
         ocrr.errorMessage = "Not an Order Cancel Replace Request message";
         return ocrr;
     }
     
-    try {
-        // Required fields
-        ocrr.clOrdId = fixMsg.getField(TAG_CLORD_ID);
-        ocrr.origClOrdId = fixMsg.getField(TAG_ORIG_CLORD_ID);
-        ocrr.symbol = fixMsg.getField(TAG_SYMBOL);
-        
-        if (ocrr.clOrdId.empty() || ocrr.origClOrdId.empty() || ocrr.symbol.empty()) {
-            ocrr.errorMessage = "Missing required fields";
+    // Required fields
+    ocrr.clOrdId = fixMsg.getString(TAG_CLORD_ID);
+    ocrr.origClOrdId = fixMsg.getString(TAG_ORIG_CLORD_ID);
+    ocrr.symbol = fixMsg.getString(TAG_SYMBOL);
+    
+    if (ocrr.clOrdId.empty() || ocrr.origClOrdId.empty() || ocrr.symbol.empty()) {
+        ocrr.errorMessage = "Missing required fields";
+        return ocrr;
+    }
+    
+    // Side
+    char side = fixMsg.getChar(TAG_SIDE);
+    if (side != '\0') {
+        ocrr.side = fixCharToSide(side);
+    }
+    
+    // Order Type
+    char ordType = fixMsg.getChar(TAG_ORD_TYPE);
+    if (ordType != '\0') {
+        ocrr.orderType = fixCharToOrderType(ordType);
+    }
+    
+    // Quantity
+    if (!fixMsg.get(TAG_ORDER_QTY).empty()) {
+        auto quantity = fixMsg.getUInt(TAG_ORDER_QTY);
+        if (!quantity) {
+            ocrr.errorMessage = "Invalid OrderQty: " + fixMsg.getString(TAG_ORDER_QTY);
             return ocrr;
         }
-        
-        // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
-        if (!sideStr.empty()) {
-            ocrr.side = fixCharToSide(sideStr[0]);
-        }
-        
-        // Order Type
-        std::string ordTypeStr = fixMsg.getField(TAG_ORD_TYPE);
-        if (!ordTypeStr.empty()) {
-            ocrr.orderType = fixCharToOrderType(ordTypeStr[0]);
-        }
-        
-        // Quantity
-        std::string qtyStr = fixMsg.getField(TAG_ORDER_QTY);
-        if (!qtyStr.empty()) {
-            ocrr.quantity = std::stoull(qtyStr);
-        }
-        
-        // Price
-        std::string priceStr = fixMsg.getField(TAG_PRICE);
-        if (!priceStr.empty()) {
-            ocrr.price = std::stod(priceStr);
+        ocrr.quantity = *quantity;
+    }
+    
+    // Price
+    if (!fixMsg.get(TAG_PRICE).empty()) {
+        auto ticks = fixMsg.getPriceTicks(TAG_PRICE, tickSize_);
+        if (!ticks) {
+            ocrr.errorMessage = "Price " + fixMsg.getString(TAG_PRICE) + " is not a multiple of tick size";
+            return ocrr;
         }
-        
-        // Time In Force
-        std::string tifStr = fixMsg.getField(TAG_TIME_IN_FORCE);
-        ocrr.timeInForce = tifStr.empty() ? TimeInForce::GTC : fixCharToTif(tifStr[0]);
-        
-        // Account
-        ocrr.account = fixMsg.getField(TAG_CLORD_ID);
-        
-        // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
-        ocrr.transactTime = transactTimeStr.empty() ? 
-            std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
-        
-        ocrr.isValid = true;
-        
-    } catch (const std::exception& e) {
-        ocrr.errorMessage = "Failed to parse Order Cancel Replace Request: " + std::string(e.what());
+        ocrr.priceTicks = *ticks;
+        ocrr.price = tickSize_.toPrice(*ticks);
     }
     
+    // Time In Force
+    char tif = fixMsg.getChar(TAG_TIME_IN_FORCE);
+    ocrr.timeInForce = tif == '\0' ? TimeInForce::GTC : fixCharToTif(tif);
+    
+    // Account
+    ocrr.account = fixMsg.has(TAG_ACCOUNT) ? fixMsg.getString(TAG_ACCOUNT) : ocrr.clOrdId;
+    
+    // Transaction Time
+    std::string_view transactTime = fixMsg.get(TAG_TRANSACT_TIME);
+    ocrr.transactTime = transactTime.empty() ? 
+        std::chrono::system_clock::now() : parseTimestamp(std::string(transactTime));
+    
+    ocrr.isValid = true;
     return ocrr;
 }
 
 FixMessageParser::OrderCancelRequest FixMessageParser::parseOrderCancelRequest(const FixMessage& fixMsg) {
-    OrderCancelRequest ocr;
-    
     if (!fixMsg.isValid) {
+        OrderCancelRequest ocr;
         ocr.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage;
         return ocr;
     }
     
-    if (fixMsg.msgType != MSG_TYPE_ORDER_CANCEL_REQUEST) {
+    FixMessageView view;
+    view.parse(fixMsg.rawMessage);
+    return parseOrderCancelRequest(view);
+}
+
+FixMessageParser::OrderCancelRequest FixMessageParser::parseOrderCancelRequest(const FixMessageView& fixMsg) {
+    OrderCancelRequest ocr;
+    
+    if (!fixMsg.isValid()) {
+        ocr.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage();
+        return ocr;
+    }
+    
+    if (fixMsg.msgType() != MSG_TYPE_ORDER_CANCEL_REQUEST) {
         ocr.errorMessage = "Not an Order Cancel Request message";
         return ocr;
     }
     
-    try {
-        // Required fields
-        ocr.clOrdId = fixMsg.getField(TAG_CLORD_ID);
-        ocr.origClOrdId = fixMsg.getField(TAG_ORIG_CLORD_ID);
-        ocr.symbol = fixMsg.getField(TAG_SYMBOL);
-        
-        if (ocr.clOrdId.empty() || ocr.origClOrdId.empty() || ocr.symbol.empty()) {
-            ocr.errorMessage = "Missing required fields";
-            return ocr;
-        }
-        
-        // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
-        if (!sideStr.empty()) {
-            ocr.side = fixCharToSide(sideStr[0]);
-        }
-        
-        // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
-        ocr.transactTime = transactTimeStr.empty() ? 
-            std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
-        
-        ocr.isValid = true;
-        
-    } catch (const std::exception& e) {
-        ocr.errorMessage = "Failed to parse Order Cancel Request: " + std::string(e.what());
+    // Required fields
+    ocr.clOrdId = fixMsg.getString(TAG_CLORD_ID);
+    ocr.origClOrdId = fixMsg.getString(TAG_ORIG_CLORD_ID);
+    ocr.symbol = fixMsg.getString(TAG_SYMBOL);
+    
+    if (ocr.clOrdId.empty() || ocr.origClOrdId.empty() || ocr.symbol.empty()) {
+        ocr.errorMessage = "Missing required fields";
+        return ocr;
+    }
+    
+    // Side
+    char side = fixMsg.getChar(TAG_SIDE);
+    if (side != '\0') {
+        ocr.side = fixCharToSide(side);
     }
     
+    // Transaction Time
+    std::string_view transactTime = fixMsg.get(TAG_TRANSACT_TIME);
+    ocr.transactTime = transactTime.empty() ? 
+        std::chrono::system_clock::now() : parseTimestamp(std::string(transactTime));
+    
+    ocr.isValid = true;
     return ocr;
 }
 
+FixMessageParser::OrderMassCancelRequest FixMessageParser::parseOrderMassCancelRequest(const FixMessageView& fixMsg) {
+    OrderMassCancelRequest omcr;
+    
+    if (!fixMsg.isValid()) {
+        omcr.errorMessage = "Invalid FIX message: " + fixMsg.errorMessage();
+        return omcr;
+    }
+    
+    if (fixMsg.msgType() != MSG_TYPE_ORDER_MASS_CANCEL_REQUEST) {
+        omcr.errorMessage = "Not an Order Mass Cancel Request message";
+        return omcr;
+    }
+    
+    // Required fields
+    omcr.clOrdId = fixMsg.getString(TAG_CLORD_ID);
+    omcr.massCancelRequestType = fixMsg.getChar(TAG_MASS_CANCEL_REQUEST_TYPE);
+    if (omcr.clOrdId.empty() || omcr.massCancelRequestType == '\0') {
+        omcr.errorMessage = "Missing required fields";
+        return omcr;
+    }
+    
+    if (omcr.massCancelRequestType != MASS_CANCEL_BY_SYMBOL && omcr.massCancelRequestType != MASS_CANCEL_ALL) {
+        omcr.errorMessage = "Unsupported MassCancelRequestType: " + std::string(1, omcr.massCancelRequestType);
+        return omcr;
+    }
+    
+    omcr.symbol = fixMsg.getString(TAG_SYMBOL);
+    if (omcr.massCancelRequestType == MASS_CANCEL_BY_SYMBOL && omcr.symbol.empty()) {
+        omcr.errorMessage = "Symbol is required to cancel by symbol";
+        return omcr;
+    }
+    
+    // Optional side filter
+    char side = fixMsg.getChar(TAG_SIDE);
+    if (side != '\0') {
+        omcr.side = fixCharToSide(side);
+    }
+    
+    std::string_view transactTime = fixMsg.get(TAG_TRANSACT_TIME);
+    omcr.transactTime = transactTime.empty() ?
+        std::chrono::system_clock::now() : parseTimestamp(std::string(transactTime));
+    
+    omcr.isValid = true;
+    return omcr;
+}
+
 std::string FixMessageParser::generateExecutionReport(const ExecutionReport& execReport,
                                                     const std::string& senderCompId,
                                                     const std::string& targetCompId,
@@ -295,7 +378,7 @@ std::string FixMessageParser::generateExecutionReport(const ExecutionReport& exe
     body << TAG_SYMBOL << "=" << execReport.symbol << FIELD_DELIMITER;
     body << TAG_SIDE << "=" << sideToFixChar(execReport.side) << FIELD_DELIMITER;
     body << TAG_ORDER_QTY << "=" << execReport.orderQty << FIELD_DELIMITER;
-    body << TAG_PRICE << "=" << std::fixed << std::setprecision(2) << execReport.price << FIELD_DELIMITER;
+    body << TAG_PRICE << "=" << std::fixed << std::setprecision(tickSize_.decimals()) << execReport.price << FIELD_DELIMITER;
     body << TAG_LEAVES_QTY << "=" << execReport.leavesQty << FIELD_DELIMITER;
     body << TAG_CUM_QTY << "=" << execReport.cumQty << FIELD_DELIMITER;
     body << TAG_AVG_PX << "=" << std::fixed << std::setprecision(2) << execReport.avgPx << FIELD_DELIMITER;
@@ -304,12 +387,40 @@ std::string FixMessageParser::generateExecutionReport(const ExecutionReport& exe
     // Optional fields for fills
     if (execReport.lastQty > 0) {
         body << TAG_LAST_QTY << "=" << execReport.lastQty << FIELD_DELIMITER;
-        body << TAG_LAST_PX << "=" << std::fixed << std::setprecision(2) << execReport.lastPx << FIELD_DELIMITER;
+        body << TAG_LAST_PX << "=" << std::fixed << std::setprecision(tickSize_.decimals()) << execReport.lastPx << FIELD_DELIMITER;
     }
     
     return buildFixMessage(MSG_TYPE_EXECUTION_REPORT, body.str(), senderCompId, targetCompId, msgSeqNum);
 }
 
+std::string FixMessageParser::generateOrderMassCancelReport(const OrderMassCancelReport& report,
+                                                          const std::string& senderCompId,
+                                                          const std::string& targetCompId,
+                                                          SequenceNumber msgSeqNum) {
+    std::ostringstream body;
+    
+    body << TAG_CLORD_ID << "=" << report.clOrdId << FIELD_DELIMITER;
+    body << TAG_ORDER_ID << "=" << report.orderId << FIELD_DELIMITER;
+    body << TAG_MASS_CANCEL_REQUEST_TYPE << "=" << report.massCancelRequestType << FIELD_DELIMITER;
+    body << TAG_MASS_CANCEL_RESPONSE << "=" << report.massCancelResponse << FIELD_DELIMITER;
+    if (report.massCancelResponse == MASS_CANCEL_RESPONSE_REJECTED) {
+        body << TAG_MASS_CANCEL_REJECT_REASON << "=" << report.rejectReason << FIELD_DELIMITER;
+    }
+    body << TAG_TOTAL_AFFECTED_ORDERS << "=" << report.totalAffectedOrders << FIELD_DELIMITER;
+    if (!report.symbol.empty()) {
+        body << TAG_SYMBOL << "=" << report.symbol << FIELD_DELIMITER;
+    }
+    if (report.side) {
+        body << TAG_SIDE << "=" << sideToFixChar(*report.side) << FIELD_DELIMITER;
+    }
+    body << TAG_TRANSACT_TIME << "=" << formatTimestamp(report.transactTime) << FIELD_DELIMITER;
+    if (!report.text.empty()) {
+        body << TAG_TEXT << "=" << report.text << FIELD_DELIMITER;
+    }
+    
+    return buildFixMessage(MSG_TYPE_ORDER_MASS_CANCEL_REPORT, body.str(), senderCompId, targetCompId, msgSeqNum);
+}
+
 std::string FixMessageParser::generateHeartbeat(const std::string& senderCompId,
                                                const std::string& targetCompId,
                                                SequenceNumber msgSeqNum,
@@ -363,11 +474,7 @@ std::string FixMessageParser::generateReject(const std::string& senderCompId,
 // Private helper methods
 
 uint8_t FixMessageParser::calculateChecksum(const std::string& message) {
-    uint32_t sum = 0;
-    for (char c : message) {
-        sum += static_cast<uint8_t>(c);
-    }
-    return static_cast<uint8_t>(sum % 256);
+    return simd::checksum(message.data(), message.size());
 }
 
 std::string FixMessageParser::formatTimestamp(const std::chrono::system_clock::time_point& timestamp) {
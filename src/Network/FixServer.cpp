@@ -1,4 +1,6 @@
 #include "orderbook/Network/FixServer.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/Metrics.hpp"
 #include <iostream>
 #include <algorithm>
 
@@ -8,10 +10,17 @@ using namespace boost::asio;
 using namespace boost::asio::ip;
 
 FixServer::FixServer(boost::asio::io_context& io_context,
-                    std::shared_ptr<OrderManager> orderManager,
-                    std::shared_ptr<RiskManager> riskManager)
+                    std::shared_ptr<FixOrderGateway> gateway)
     : ioContext_(io_context), acceptor_(io_context),
-      orderManager_(std::move(orderManager)), riskManager_(std::move(riskManager)),
+      gateway_(std::move(gateway)),
+      startTime_(std::chrono::system_clock::now()) {
+}
+
+FixServer::FixServer(boost::asio::io_context& io_context,
+                    IoContextPool& ioPool,
+                    std::shared_ptr<FixOrderGateway> gateway)
+    : ioContext_(io_context), ioPool_(&ioPool), acceptor_(io_context),
+      gateway_(std::move(gateway)),
       startTime_(std::chrono::system_clock::now()) {
 }
 
@@ -46,9 +55,13 @@ void FixServer::stop() {
         acceptor_.close(ec);
         
         // Close all sessions
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
         for (auto& session : sessions_) {
             if (session) {
                 session->close();
+                auto sessionStats = session->getStats();
+                retiredMessagesReceived_ += sessionStats.messagesReceived;
+                retiredMessagesSent_ += sessionStats.messagesSent;
             }
         }
         
@@ -59,24 +72,79 @@ void FixServer::stop() {
     }
 }
 
+uint16_t FixServer::getPort() const {
+    boost::system::error_code ec;
+    auto endpoint = acceptor_.local_endpoint(ec);
+    return ec ? 0 : endpoint.port();
+}
+
+void FixServer::loadConfiguration(std::shared_ptr<Config> config) {
+    config_ = config;
+    if (config_) {
+        latencyTrace_ = config_->getBool("network", "latency_trace", false);
+        cancelOnDisconnect_ = config_->getBool("network", "cancel_on_disconnect", false);
+    }
+}
+
 FixServer::ServerStats FixServer::getStats() const {
     ServerStats stats;
-    stats.activeConnections = std::count_if(sessions_.begin(), sessions_.end(),
-        [](const std::shared_ptr<FixSession>& session) {
-            return session && session->isLoggedIn();
-        });
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    stats.activeConnections = 0;
+    stats.messagesProcessed = retiredMessagesReceived_;
+    stats.messagesSent = retiredMessagesSent_;
+    for (const auto& session : sessions_) {
+        if (!session) {
+            continue;
+        }
+        if (session->isLoggedIn()) {
+            ++stats.activeConnections;
+        }
+        auto sessionStats = session->getStats();
+        stats.messagesProcessed += sessionStats.messagesReceived;
+        stats.messagesSent += sessionStats.messagesSent;
+    }
     stats.totalConnections = totalConnections_.load();
-    stats.messagesProcessed = messagesProcessed_.load();
     stats.ordersProcessed = ordersProcessed_.load();
     stats.startTime = startTime_;
     return stats;
 }
 
+void FixServer::exportMetrics(MetricsWriter& out) const {
+    ServerStats stats = getStats();
+    out.gauge("fix_sessions_active", "Logged-in FIX sessions", static_cast<double>(stats.activeConnections));
+    out.counter("fix_connections_total", "FIX connections accepted", static_cast<double>(stats.totalConnections));
+    out.counter("fix_messages_total", "FIX messages over every session",
+                static_cast<double>(stats.messagesProcessed), {{"direction", "in"}});
+    out.counter("fix_messages_total", "FIX messages over every session",
+                static_cast<double>(stats.messagesSent), {{"direction", "out"}});
+    out.counter("fix_orders_total", "Order requests dispatched to the books",
+                static_cast<double>(stats.ordersProcessed));
+}
+
 void FixServer::startAccept() {
     if (!running_) {
         return;
     }
     
+    if (ioPool_) {
+        // The new socket is created directly on the context the session will live on
+        size_t context = ioPool_->acquire();
+        acceptor_.async_accept(ioPool_->getContext(context),
+            [this, context](const boost::system::error_code& error, tcp::socket socket) {
+                if (!error && running_) {
+                    auto newSession = std::make_shared<FixSession>(std::move(socket),
+                                                                   ioPool_->getContext(context));
+                    registerSession(newSession, context);
+                } else {
+                    ioPool_->release(context);
+                    handleAccept(nullptr, error);
+                    return;
+                }
+                startAccept();
+            });
+        return;
+    }
+    
     auto socket = std::make_unique<tcp::socket>(ioContext_);
     auto* socketPtr = socket.get();
     
@@ -93,55 +161,94 @@ void FixServer::startAccept() {
 
 void FixServer::handleAccept(std::shared_ptr<FixSession> session, const boost::system::error_code& error) {
     if (!error && running_ && session) {
-        ++totalConnections_;
-        
-        // Create message handler for this session
-        auto messageHandler = std::make_shared<FixMessageHandler>(orderManager_, riskManager_);
-        messageHandler->setFixSession(session);
-        
-        // Set up session handlers
-        session->setNewOrderHandler([messageHandler](const FixMessageParser::NewOrderSingle& newOrder) {
-            messageHandler->handleNewOrderSingle(newOrder);
-        });
-        
-        session->setCancelReplaceHandler([messageHandler](const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
-            messageHandler->handleOrderCancelReplaceRequest(cancelReplace);
-        });
-        
-        session->setCancelHandler([messageHandler](const FixMessageParser::OrderCancelRequest& cancelRequest) {
-            messageHandler->handleOrderCancelRequest(cancelRequest);
-        });
-        
-        session->setSessionEventHandler([this, session](FixSession::SessionState state, const std::string& reason) {
-            handleSessionEvent(session, state, reason);
-        });
-        
-        // Set session IDs (client will provide TargetCompID in logon)
-        session->setSessionIds(senderCompId_, "CLIENT"); // Default target, will be updated on logon
-        
-        // Store session and handler
+        registerSession(session, NoPoolContext);
+    } else if (error) {
+        std::cerr << "Accept error: " << error.message() << std::endl;
+    }
+    
+    // Continue accepting new connections
+    startAccept();
+}
+
+void FixServer::registerSession(std::shared_ptr<FixSession> session, size_t context) {
+    ++totalConnections_;
+    
+    // Create message handler for this session
+    auto messageHandler = std::make_shared<FixMessageHandler>(gateway_);
+    messageHandler->setFixSession(session);
+    
+    // Order requests from each read are matched in one pass
+    session->setOrderBatchHandler([this, messageHandler](std::vector<FixOrderRequest>& requests) {
+        ordersProcessed_ += requests.size();
+        messageHandler->handleOrderBatch(requests);
+    });
+    
+    // Set up session handlers
+    session->setNewOrderHandler([messageHandler](const FixMessageParser::NewOrderSingle& newOrder) {
+        messageHandler->handleNewOrderSingle(newOrder);
+    });
+    
+    session->setCancelReplaceHandler([messageHandler](const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
+        messageHandler->handleOrderCancelReplaceRequest(cancelReplace);
+    });
+    
+    session->setCancelHandler([messageHandler](const FixMessageParser::OrderCancelRequest& cancelRequest) {
+        messageHandler->handleOrderCancelRequest(cancelRequest);
+    });
+    
+    // The pool slot is returned once, on the first disconnect
+    auto released = std::make_shared<std::atomic<bool>>(false);
+    std::weak_ptr<FixSession> weakSession = session;
+    std::weak_ptr<FixMessageHandler> weakHandler = messageHandler;
+    session->setSessionEventHandler([this, weakSession, weakHandler, context, released](
+                                        FixSession::SessionState state, const std::string& reason) {
+        if (state == FixSession::SessionState::Disconnected && ioPool_ && context != NoPoolContext &&
+            !released->exchange(true)) {
+            ioPool_->release(context);
+        }
+        handleSessionEvent(weakSession.lock(), weakHandler.lock(), state, reason);
+    });
+    
+    if (config_) {
+        session->loadConfiguration(config_);
+    }
+    session->setLatencyTrace(latencyTrace_);
+    
+    // Set session IDs (client will provide TargetCompID in logon)
+    session->setSessionIds(senderCompId_, "CLIENT"); // Default target, will be updated on logon
+    
+    // Store session and handler
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
         sessions_.push_back(session);
         messageHandlers_.push_back(messageHandler);
         
-        // Start the session
-        session->start();
-        
-        std::cout << "New FIX session accepted. Total connections: " << totalConnections_.load() << std::endl;
-        
         // Clean up old sessions periodically
         if (sessions_.size() % 10 == 0) {
             cleanupSessions();
         }
-        
-    } else if (error) {
-        std::cerr << "Accept error: " << error.message() << std::endl;
     }
     
-    // Continue accepting new connections
-    startAccept();
+    // Start the session
+    bool polled = ioPool_ && context != NoPoolContext && ioPool_->isBusyPoll();
+    if (polled) {
+        session->enablePolledReceive(ioPool_->getConfig().busy_poll_us, receiveHook_);
+    }
+    session->start();
+    if (polled) {
+        // Posted after start(), so the first poll sees a started session; orders
+        // parsed on the polling thread go straight to the gateway from there
+        ioPool_->addPoller(context, [session]() { return session->pollReceive(); });
+    }
+    
+    std::cout << "New FIX session accepted";
+    if (context != NoPoolContext) {
+        std::cout << " on IO thread " << context << (polled ? " (busy-poll)" : "");
+    }
+    std::cout << ". Total connections: " << totalConnections_.load() << std::endl;
 }
 
-void FixServer::handleSessionEvent(std::shared_ptr<FixSession> session, 
+void FixServer::handleSessionEvent(std::shared_ptr<FixSession> session, std::shared_ptr<FixMessageHandler> handler,
                                  FixSession::SessionState state, const std::string& reason) {
     switch (state) {
         case FixSession::SessionState::LoggedIn:
@@ -149,6 +256,14 @@ void FixServer::handleSessionEvent(std::shared_ptr<FixSession> session,
             break;
         case FixSession::SessionState::Disconnected:
             std::cout << "Session disconnected: " << reason << std::endl;
+            // Runs on the thread closing the session, which may hold sessionsMutex_ (stop()),
+            // so the handler comes from the event rather than messageHandlers_
+            if (cancelOnDisconnect_ && handler) {
+                size_t cancelled = handler->cancelAllOrders();
+                if (cancelled > 0) {
+                    std::cout << "Cancelled " << cancelled << " working orders on disconnect" << std::endl;
+                }
+            }
             break;
         case FixSession::SessionState::LogoutSent:
             std::cout << "Session logout: " << reason << std::endl;
@@ -159,12 +274,17 @@ void FixServer::handleSessionEvent(std::shared_ptr<FixSession> session,
 }
 
 void FixServer::cleanupSessions() {
-    // Remove disconnected sessions
+    // Remove disconnected sessions (caller holds sessionsMutex_)
     auto sessionIt = sessions_.begin();
     auto handlerIt = messageHandlers_.begin();
     
     while (sessionIt != sessions_.end() && handlerIt != messageHandlers_.end()) {
         if (!*sessionIt || (*sessionIt)->getState() == FixSession::SessionState::Disconnected) {
+            if (*sessionIt) {
+                auto sessionStats = (*sessionIt)->getStats();
+                retiredMessagesReceived_ += sessionStats.messagesReceived;
+                retiredMessagesSent_ += sessionStats.messagesSent;
+            }
             sessionIt = sessions_.erase(sessionIt);
             handlerIt = messageHandlers_.erase(handlerIt);
         } else {
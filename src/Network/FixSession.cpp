@@ -5,6 +5,11 @@
 #include <boost/asio.hpp>
 #include <iostream>
 #include <sstream>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
 
 namespace orderbook {
 
@@ -13,8 +18,8 @@ using namespace boost::asio::ip;
 using namespace fix;
 
 FixSession::FixSession(tcp::socket socket, boost::asio::io_context& io_context, LoggerPtr logger)
-    : ioContext_(io_context), socket_(std::move(socket)), 
-      heartbeatTimer_(io_context), testRequestTimer_(io_context),
+    : ioContext_(io_context), strand_(make_strand(io_context)), socket_(std::move(socket)), 
+      heartbeatTimer_(io_context), testRequestTimer_(io_context), corkTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), logger_(logger) {
     if (logger_) {
         logger_->info("FixSession created (server-side)", "FixSession::ctor");
@@ -22,8 +27,8 @@ FixSession::FixSession(tcp::socket socket, boost::asio::io_context& io_context,
 }
 
 FixSession::FixSession(boost::asio::io_context& io_context, LoggerPtr logger)
-    : ioContext_(io_context), socket_(io_context), 
-      heartbeatTimer_(io_context), testRequestTimer_(io_context),
+    : ioContext_(io_context), strand_(make_strand(io_context)), socket_(io_context), 
+      heartbeatTimer_(io_context), testRequestTimer_(io_context), corkTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), logger_(logger) {
     if (logger_) {
         logger_->info("FixSession created (client-side)", "FixSession::ctor");
@@ -31,8 +36,8 @@ FixSession::FixSession(boost::asio::io_context& io_context, LoggerPtr logger)
 }
 
 FixSession::FixSession(boost::asio::io_context& io_context, std::shared_ptr<Config> config, LoggerPtr logger)
-    : ioContext_(io_context), socket_(io_context), 
-      heartbeatTimer_(io_context), testRequestTimer_(io_context),
+    : ioContext_(io_context), strand_(make_strand(io_context)), socket_(io_context), 
+      heartbeatTimer_(io_context), testRequestTimer_(io_context), corkTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), config_(config), logger_(logger) {
     loadConfiguration(config);
     if (logger_) {
@@ -48,9 +53,16 @@ void FixSession::start() {
     if (logger_) {
         logger_->info("Starting FIX session", "FixSession::start");
     }
-    updateState(SessionState::LoggedIn, "Session started");
-    startRead();
-    startHeartbeatTimer();
+    
+    // Everything the session does from here on runs on its strand
+    dispatch(strand_, [self = shared_from_this()]() {
+        self->updateState(SessionState::LoggedIn, "Session started");
+        self->disableNagle();
+        if (!self->polledReceive_) {
+            self->startRead();
+        }
+        self->startHeartbeatTimer();
+    });
 }
 
 void FixSession::connect(const std::string& host, uint16_t port,
@@ -65,31 +77,34 @@ void FixSession::connect(const std::string& host, uint16_t port,
     tcp::resolver resolver(ioContext_);
     auto endpoints = resolver.resolve(host, std::to_string(port));
     
-    async_connect(socket_, endpoints,
+    async_connect(socket_, endpoints, bind_executor(strand_,
         [self = shared_from_this()](boost::system::error_code ec, tcp::endpoint) {
             if (!ec) {
                 self->updateState(SessionState::LogonSent, "Connected, sending logon");
+                self->disableNagle();
                 self->sendLogon();
                 self->startRead();
                 self->startHeartbeatTimer();
             } else {
                 self->handleError(ec, "connect");
             }
-        });
+        }));
 }
 
 void FixSession::sendLogon(int heartBtInt) {
     heartbeatInterval_ = heartBtInt;
-    std::string logonMsg = parser_.generateLogon(senderCompId_, targetCompId_, 
-                                               getNextOutgoingSeqNum(), heartBtInt);
-    sendMessage(logonMsg);
+    {
+        std::lock_guard<std::mutex> lock(encodeMutex_);
+        sendMessage(parser_.generateLogon(senderCompId_, targetCompId_, getNextOutgoingSeqNum(), heartBtInt));
+    }
     updateState(SessionState::LogonSent, "Logon sent");
 }
 
 void FixSession::sendLogout(const std::string& text) {
-    std::string logoutMsg = parser_.generateLogout(senderCompId_, targetCompId_, 
-                                                 getNextOutgoingSeqNum(), text);
-    sendMessage(logoutMsg);
+    {
+        std::lock_guard<std::mutex> lock(encodeMutex_);
+        sendMessage(parser_.generateLogout(senderCompId_, targetCompId_, getNextOutgoingSeqNum(), text));
+    }
     updateState(SessionState::LogoutSent, "Logout sent: " + text);
 }
 
@@ -98,15 +113,39 @@ void FixSession::sendExecutionReport(const FixMessageParser::ExecutionReport& ex
         return;
     }
     
-    std::string execReportMsg = parser_.generateExecutionReport(execReport, senderCompId_, 
-                                                              targetCompId_, getNextOutgoingSeqNum());
+    std::lock_guard<std::mutex> lock(encodeMutex_);
+    std::string_view execReportMsg = encoder_.encodeExecutionReport(execReport, getNextOutgoingSeqNum(),
+                                                                    encodeBuffer_);
     sendMessage(execReportMsg);
 }
 
+void FixSession::sendOrderMassCancelReport(const FixMessageParser::OrderMassCancelReport& report) {
+    if (!isLoggedIn()) {
+        return;
+    }
+    
+    // Sequenced with the cancel reports sent for the same request
+    std::lock_guard<std::mutex> lock(encodeMutex_);
+    sendMessage(parser_.generateOrderMassCancelReport(report, senderCompId_, targetCompId_,
+                                                      getNextOutgoingSeqNum()));
+}
+
+void FixSession::sendNewOrderSingle(const FixMessageParser::NewOrderSingle& order) {
+    if (!isLoggedIn()) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(encodeMutex_);
+    std::string_view orderMsg = encoder_.encodeNewOrderSingle(order, getNextOutgoingSeqNum(),
+                                                              std::chrono::system_clock::now(), encodeBuffer_);
+    sendMessage(orderMsg);
+}
+
 void FixSession::sendHeartbeat(const std::string& testReqId) {
-    std::string heartbeatMsg = parser_.generateHeartbeat(senderCompId_, targetCompId_, 
-                                                       getNextOutgoingSeqNum(), testReqId);
-    sendMessage(heartbeatMsg);
+    {
+        std::lock_guard<std::mutex> lock(encodeMutex_);
+        sendMessage(parser_.generateHeartbeat(senderCompId_, targetCompId_, getNextOutgoingSeqNum(), testReqId));
+    }
     
     std::lock_guard<std::mutex> lock(statsMutex_);
     ++heartbeatsSent_;
@@ -114,14 +153,16 @@ void FixSession::sendHeartbeat(const std::string& testReqId) {
 }
 
 void FixSession::sendReject(SequenceNumber refSeqNum, const std::string& text) {
-    std::string rejectMsg = parser_.generateReject(senderCompId_, targetCompId_, 
-                                                 getNextOutgoingSeqNum(), refSeqNum, text);
-    sendMessage(rejectMsg);
+    std::lock_guard<std::mutex> lock(encodeMutex_);
+    sendMessage(parser_.generateReject(senderCompId_, targetCompId_, getNextOutgoingSeqNum(), refSeqNum, text));
 }
 
 void FixSession::setSessionIds(const std::string& senderCompId, const std::string& targetCompId) {
     senderCompId_ = senderCompId;
     targetCompId_ = targetCompId;
+    
+    std::lock_guard<std::mutex> lock(encodeMutex_);
+    encoder_.setSessionIds(senderCompId_, targetCompId_);
 }
 
 FixSession::SessionStats FixSession::getStats() const {
@@ -145,12 +186,78 @@ void FixSession::close() {
         boost::system::error_code ec;
         heartbeatTimer_.cancel(ec);
         testRequestTimer_.cancel(ec);
+        corkTimer_.cancel(ec);
         socket_.close(ec);
         
         updateState(SessionState::Disconnected, "Session closed");
     }
 }
 
+void FixSession::disableNagle() {
+    boost::system::error_code ec;
+    socket_.set_option(tcp::no_delay(true), ec);
+    if (ec && logger_) {
+        logger_->warn("Cannot set TCP_NODELAY: " + ec.message(), "FixSession::disableNagle");
+    }
+}
+
+void FixSession::enablePolledReceive(int busyPollMicros, ReceiveHook hook) {
+    polledReceive_ = true;
+    receiveHook_ = hook;
+    
+    boost::system::error_code ec;
+    socket_.non_blocking(true, ec);
+    if (ec) {
+        LOG_WARN(logger_, "Cannot make socket non-blocking: " + ec.message(), "FixSession::enablePolledReceive");
+    }
+    
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+    // Lets the kernel spin on the device queue inside recv instead of waiting for the interrupt
+    if (busyPollMicros > 0 &&
+        setsockopt(socket_.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &busyPollMicros, sizeof(busyPollMicros)) != 0) {
+        LOG_WARN(logger_, "Cannot set SO_BUSY_POLL (raising it above net.core.busy_read needs CAP_NET_ADMIN)",
+                 "FixSession::enablePolledReceive");
+    }
+#else
+    (void)busyPollMicros;
+#endif
+}
+
+bool FixSession::pollReceive() {
+    if (!socket_.is_open()) {
+        return false;
+    }
+    
+    size_t bytes = 0;
+    if (receiveHook_) {
+        errno = 0;
+        long received = receiveHook_(socket_.native_handle(), frameReader_.writePtr(), frameReader_.writable());
+        if (received == 0) {
+            return true;
+        }
+        if (received < 0) {
+            handleError(errno == 0 ? boost::system::error_code(boost::asio::error::eof)
+                                   : boost::system::error_code(errno, boost::system::system_category()),
+                        "read");
+            return false;
+        }
+        bytes = static_cast<size_t>(received);
+    } else {
+        boost::system::error_code ec;
+        bytes = socket_.read_some(buffer(frameReader_.writePtr(), frameReader_.writable()), ec);
+        if (ec == boost::asio::error::would_block || ec == boost::asio::error::try_again) {
+            return true;
+        }
+        if (ec) {
+            handleError(ec, "read");
+            return false;
+        }
+    }
+    
+    consumeRead(bytes);
+    return socket_.is_open();
+}
+
 void FixSession::startRead() {
     readMessage();
 }
@@ -158,25 +265,42 @@ void FixSession::startRead() {
 void FixSession::readMessage() {
     auto self = shared_from_this();
     
-    // Read until we find a complete FIX message (ending with SOH)
-    async_read_until(socket_, boost::asio::dynamic_buffer(messageBuffer_), FIELD_DELIMITER,
+    // Read as much as the socket has; a completion may carry many messages
+    socket_.async_read_some(buffer(frameReader_.writePtr(), frameReader_.writable()), bind_executor(strand_,
         [self](boost::system::error_code ec, std::size_t bytes_transferred) {
             if (!ec) {
-                // Extract the complete message
-                std::string message = self->messageBuffer_.substr(0, bytes_transferred);
-                self->messageBuffer_.erase(0, bytes_transferred);
-                
-                self->processMessage(message);
+                self->consumeRead(bytes_transferred);
                 
                 // Continue reading
-                self->readMessage();
+                if (self->socket_.is_open()) {
+                    self->readMessage();
+                }
             } else {
                 self->handleError(ec, "read");
             }
-        });
+        }));
+}
+
+void FixSession::consumeRead(size_t bytes) {
+    if (traceLatency_) {
+        readTicks_ = TscClock::ticks();
+    }
+    frameReader_.commit(bytes);
+    
+    uint64_t discarded = frameReader_.getDiscardedBytes();
+    frameReader_.drain([this](std::string_view message) {
+        processMessage(message);
+        return socket_.is_open();
+    });
+    flushOrderBatch();
+    
+    if (frameReader_.getDiscardedBytes() != discarded) {
+        LOG_WARN(logger_, "Discarded " + std::to_string(frameReader_.getDiscardedBytes() - discarded) +
+                          " unframed bytes", "FixSession::consumeRead");
+    }
 }
 
-void FixSession::processMessage(const std::string& message) {
+void FixSession::processMessage(std::string_view message) {
     PERF_TIMER("FixSession::processMessage", logger_);
     
     {
@@ -184,16 +308,13 @@ void FixSession::processMessage(const std::string& message) {
         ++messagesReceived_;
     }
     
-    if (logger_) {
-        logger_->debug("Processing FIX message: " + message.substr(0, std::min(message.length(), size_t(100))) + 
-                      (message.length() > 100 ? "..." : ""), "FixSession::processMessage");
-    }
+    LOG_DEBUG(logger_, "Processing FIX message: " + std::string(message.substr(0, 100)) + 
+                       (message.length() > 100 ? "..." : ""), "FixSession::processMessage");
     
-    // Parse the FIX message
-    auto fixMsg = parser_.parseMessage(message);
-    
-    if (!fixMsg.isValid) {
-        sendReject(incomingSeqNum_.load(), "Invalid message format: " + fixMsg.errorMessage);
+    // Parse the FIX message in place; fields stay views into message
+    FixMessageView& fixMsg = inboundView_;
+    if (!parser_.parseMessage(message, fixMsg)) {
+        sendReject(incomingSeqNum_.load(), "Invalid message format: " + fixMsg.errorMessage());
         return;
     }
     
@@ -201,14 +322,13 @@ void FixSession::processMessage(const std::string& message) {
     SequenceNumber expectedSeqNum = getNextIncomingSeqNum();
     SequenceNumber receivedSeqNum = 0;
     
-    try {
-        std::string seqNumStr = fixMsg.getField(TAG_MSG_SEQ_NUM);
-        if (!seqNumStr.empty()) {
-            receivedSeqNum = std::stoull(seqNumStr);
+    if (fixMsg.has(TAG_MSG_SEQ_NUM)) {
+        auto seqNum = fixMsg.getUInt(TAG_MSG_SEQ_NUM);
+        if (!seqNum) {
+            sendReject(expectedSeqNum, "Invalid sequence number");
+            return;
         }
-    } catch (const std::exception&) {
-        sendReject(expectedSeqNum, "Invalid sequence number");
-        return;
+        receivedSeqNum = *seqNum;
     }
     
     if (!validateSequenceNumber(expectedSeqNum, receivedSeqNum)) {
@@ -217,7 +337,7 @@ void FixSession::processMessage(const std::string& message) {
     }
     
     // Handle different message types
-    switch (fixMsg.msgType) {
+    switch (fixMsg.msgType()) {
         case MSG_TYPE_LOGON:
             handleLogon(fixMsg);
             break;
@@ -239,38 +359,51 @@ void FixSession::processMessage(const std::string& message) {
         case MSG_TYPE_ORDER_CANCEL_REQUEST:
             handleOrderCancelRequest(fixMsg);
             break;
+        case MSG_TYPE_ORDER_MASS_CANCEL_REQUEST:
+            handleOrderMassCancelRequest(fixMsg);
+            break;
         case MSG_TYPE_REJECT:
             handleReject(fixMsg);
             break;
+        case MSG_TYPE_EXECUTION_REPORT:
+            handleExecutionReport(fixMsg);
+            break;
         default:
-            sendReject(receivedSeqNum, "Unsupported message type: " + std::string(1, fixMsg.msgType));
+            sendReject(receivedSeqNum, "Unsupported message type: " + std::string(1, fixMsg.msgType()));
             break;
     }
 }
 
-void FixSession::handleLogon(const FixMessageParser::FixMessage& msg) {
+void FixSession::flushOrderBatch() {
+    if (pendingOrders_.empty()) {
+        return;
+    }
+    if (orderBatchHandler_) {
+        orderBatchHandler_(pendingOrders_);
+    }
+    pendingOrders_.clear();
+}
+
+void FixSession::handleLogon(const FixMessageView& msg) {
+    // Extract heartbeat interval
+    if (msg.has(TAG_HEARTBT_INT)) {
+        auto heartBtInt = msg.getInt(TAG_HEARTBT_INT);
+        heartbeatInterval_ = heartBtInt ? static_cast<int>(*heartBtInt) : HEARTBEAT_INTERVAL;
+    }
+    
     if (state_ == SessionState::LogonSent || state_ == SessionState::Disconnected) {
         updateState(SessionState::LoggedIn, "Logon received");
-        
-        // Extract heartbeat interval
-        std::string heartBtIntStr = msg.getField(TAG_HEARTBT_INT);
-        if (!heartBtIntStr.empty()) {
-            try {
-                heartbeatInterval_ = std::stoi(heartBtIntStr);
-            } catch (const std::exception&) {
-                heartbeatInterval_ = HEARTBEAT_INTERVAL;
-            }
-        }
-        
-        // Send logon response if we're the server
-        if (state_ == SessionState::Disconnected) {
-            sendLogon(heartbeatInterval_);
-        }
+    } else if (state_ == SessionState::LoggedIn && !logonAnswered_) {
+        // Accepted sessions start logged in; answer the initiator so it is too
+        logonAnswered_ = true;
+        std::lock_guard<std::mutex> lock(encodeMutex_);
+        sendMessage(parser_.generateLogon(senderCompId_, targetCompId_, getNextOutgoingSeqNum(),
+                                          heartbeatInterval_));
     }
 }
 
-void FixSession::handleLogout(const FixMessageParser::FixMessage& msg) {
-    std::string text = msg.getField(58); // Text field
+void FixSession::handleLogout(const FixMessageView& msg) {
+    std::string text = msg.getString(58); // Text field
     updateState(SessionState::Disconnecting, "Logout received: " + text);
     
     // Send logout response
@@ -278,7 +411,7 @@ void FixSession::handleLogout(const FixMessageParser::FixMessage& msg) {
     close();
 }
 
-void FixSession::handleHeartbeat(const FixMessageParser::FixMessage& msg) {
+void FixSession::handleHeartbeat(const FixMessageView& msg) {
     {
         std::lock_guard<std::mutex> lock(statsMutex_);
         ++heartbeatsReceived_;
@@ -286,67 +419,109 @@ void FixSession::handleHeartbeat(const FixMessageParser::FixMessage& msg) {
     }
     
     // Reset test request flag if this was a response
-    std::string testReqId = msg.getField(TAG_TEST_REQ_ID);
+    std::string testReqId = msg.getString(TAG_TEST_REQ_ID);
     if (!testReqId.empty()) {
         testRequestSent_ = false;
         testRequestTimer_.cancel();
     }
 }
 
-void FixSession::handleTestRequest(const FixMessageParser::FixMessage& msg) {
-    std::string testReqId = msg.getField(TAG_TEST_REQ_ID);
+void FixSession::handleTestRequest(const FixMessageView& msg) {
+    std::string testReqId = msg.getString(TAG_TEST_REQ_ID);
     sendHeartbeat(testReqId);
 }
 
-void FixSession::handleNewOrderSingle(const FixMessageParser::FixMessage& msg) {
+void FixSession::handleNewOrderSingle(const FixMessageView& msg) {
     if (!isLoggedIn()) {
         return;
     }
     
     auto newOrder = parser_.parseNewOrderSingle(msg);
-    if (newOrder.isValid && newOrderHandler_) {
+    if (newOrder.isValid && orderBatchHandler_) {
+        FixOrderRequest& request = pendingOrders_.emplace_back();
+        request.type = FixOrderRequest::Type::New;
+        request.newOrder = std::move(newOrder);
+        if (traceLatency_) {
+            request.trace.ticks[LatencyTrace::Received] = readTicks_;
+            request.trace.stamp(LatencyTrace::Parsed);
+        }
+    } else if (newOrder.isValid && newOrderHandler_) {
         newOrderHandler_(newOrder);
     } else {
         sendReject(incomingSeqNum_.load(), "Invalid New Order Single: " + newOrder.errorMessage);
     }
 }
 
-void FixSession::handleOrderCancelReplaceRequest(const FixMessageParser::FixMessage& msg) {
+void FixSession::handleOrderCancelReplaceRequest(const FixMessageView& msg) {
     if (!isLoggedIn()) {
         return;
     }
     
     auto cancelReplace = parser_.parseOrderCancelReplaceRequest(msg);
-    if (cancelReplace.isValid && cancelReplaceHandler_) {
+    if (cancelReplace.isValid && orderBatchHandler_) {
+        FixOrderRequest& request = pendingOrders_.emplace_back();
+        request.type = FixOrderRequest::Type::CancelReplace;
+        request.cancelReplace = std::move(cancelReplace);
+    } else if (cancelReplace.isValid && cancelReplaceHandler_) {
         cancelReplaceHandler_(cancelReplace);
     } else {
         sendReject(incomingSeqNum_.load(), "Invalid Cancel Replace Request: " + cancelReplace.errorMessage);
     }
 }
 
-void FixSession::handleOrderCancelRequest(const FixMessageParser::FixMessage& msg) {
+void FixSession::handleOrderCancelRequest(const FixMessageView& msg) {
     if (!isLoggedIn()) {
         return;
     }
     
     auto cancelRequest = parser_.parseOrderCancelRequest(msg);
-    if (cancelRequest.isValid && cancelHandler_) {
+    if (cancelRequest.isValid && orderBatchHandler_) {
+        FixOrderRequest& request = pendingOrders_.emplace_back();
+        request.type = FixOrderRequest::Type::Cancel;
+        request.cancel = std::move(cancelRequest);
+    } else if (cancelRequest.isValid && cancelHandler_) {
         cancelHandler_(cancelRequest);
     } else {
         sendReject(incomingSeqNum_.load(), "Invalid Cancel Request: " + cancelRequest.errorMessage);
     }
 }
 
-void FixSession::handleReject(const FixMessageParser::FixMessage& msg) {
-    std::string text = msg.getField(58); // Text field
-    std::string refSeqNum = msg.getField(45); // RefSeqNum field
+void FixSession::handleOrderMassCancelRequest(const FixMessageView& msg) {
+    if (!isLoggedIn()) {
+        return;
+    }
+    
+    // Mass cancels are only dispatched through the gateway batch path
+    auto massCancel = parser_.parseOrderMassCancelRequest(msg);
+    if (massCancel.isValid && orderBatchHandler_) {
+        FixOrderRequest& request = pendingOrders_.emplace_back();
+        request.type = FixOrderRequest::Type::MassCancel;
+        request.massCancel = std::move(massCancel);
+    } else if (massCancel.isValid) {
+        sendReject(incomingSeqNum_.load(), "Order Mass Cancel Request is not supported by this session");
+    } else {
+        sendReject(incomingSeqNum_.load(), "Invalid Order Mass Cancel Request: " + massCancel.errorMessage);
+    }
+}
+
+void FixSession::handleExecutionReport(const FixMessageView& msg) {
+    if (executionReportHandler_) {
+        executionReportHandler_(msg);
+    } else {
+        sendReject(incomingSeqNum_.load(), "Unsupported message type: " + std::string(1, msg.msgType()));
+    }
+}
+
+void FixSession::handleReject(const FixMessageView& msg) {
+    std::string text = msg.getString(58); // Text field
+    std::string refSeqNum = msg.getString(45); // RefSeqNum field
     
     if (sessionEventHandler_) {
         sessionEventHandler_(state_, "Message rejected - SeqNum: " + refSeqNum + ", Reason: " + text);
     }
 }
 
-void FixSession::sendMessage(const std::string& message) {
+void FixSession::sendMessage(std::string_view message) {
     {
         std::lock_guard<std::mutex> lock(statsMutex_);
         ++messagesSent_;
@@ -355,42 +530,110 @@ void FixSession::sendMessage(const std::string& message) {
     writeMessage(message);
 }
 
-void FixSession::writeMessage(const std::string& message) {
-    std::lock_guard<std::mutex> lock(writeMutex_);
-    
-    bool write_in_progress = !writeQueue_.empty();
-    writeQueue_.push(message);
-    
-    if (!write_in_progress) {
-        doWrite();
+void FixSession::writeMessage(std::string_view message) {
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        
+        if (pendingSegments_.empty() ||
+            (!pendingSegments_.back().empty() &&
+             pendingSegments_.back().size() + message.size() > WriteSegmentSize)) {
+            pendingSegments_.push_back(acquireSegment());
+        }
+        pendingSegments_.back().append(message);
+        pendingBytes_ += message.size();
+        
+        // An in-flight write picks up everything queued behind it on completion
+        if (writing_) {
+            return;
+        }
+        
+        // Hold small bursts briefly so they share one syscall
+        if (corkWindow_.count() > 0 && pendingBytes_ < WriteSegmentSize) {
+            if (!corkArmed_) {
+                corkArmed_ = true;
+                corkTimer_.expires_after(corkWindow_);
+                corkTimer_.async_wait(bind_executor(strand_,
+                    [self = shared_from_this()](const boost::system::error_code& error) {
+                        if (error) {
+                            return;
+                        }
+                        std::lock_guard<std::mutex> lock(self->writeMutex_);
+                        self->corkArmed_ = false;
+                        if (!self->writing_) {
+                            self->writing_ = true;
+                            self->doWrite();
+                        }
+                    }));
+            }
+            return;
+        }
+        
+        writing_ = true;
     }
+    
+    // Callers may be on any thread (e.g. matching results); the socket is
+    // only touched from the session's strand
+    dispatch(strand_, [self = shared_from_this()]() {
+        std::lock_guard<std::mutex> lock(self->writeMutex_);
+        self->doWrite();
+    });
 }
 
 void FixSession::doWrite() {
-    auto self = shared_from_this();
+    if (pendingBytes_ == 0) {
+        writing_ = false;
+        return;
+    }
+    
+    inflightSegments_.swap(pendingSegments_);
+    pendingBytes_ = 0;
+    
+    inflightBuffers_.clear();
+    for (const auto& segment : inflightSegments_) {
+        inflightBuffers_.push_back(buffer(segment));
+    }
     
-    async_write(socket_, buffer(writeQueue_.front()),
+    auto self = shared_from_this();
+    async_write(socket_, inflightBuffers_, bind_executor(strand_,
         [self](boost::system::error_code ec, std::size_t) {
             std::lock_guard<std::mutex> lock(self->writeMutex_);
             
-            if (!ec) {
-                self->writeQueue_.pop();
-                if (!self->writeQueue_.empty()) {
-                    self->doWrite();
+            // Return written segments to the pool
+            for (auto& segment : self->inflightSegments_) {
+                if (self->segmentPool_.size() < MaxPooledSegments) {
+                    segment.clear();
+                    self->segmentPool_.push_back(std::move(segment));
                 }
+            }
+            self->inflightSegments_.clear();
+            
+            if (!ec) {
+                self->doWrite();
             } else {
+                self->writing_ = false;
                 self->handleError(ec, "write");
             }
-        });
+        }));
+}
+
+std::string FixSession::acquireSegment() {
+    if (segmentPool_.empty()) {
+        std::string segment;
+        segment.reserve(WriteSegmentSize);
+        return segment;
+    }
+    std::string segment = std::move(segmentPool_.back());
+    segmentPool_.pop_back();
+    return segment;
 }
 
 void FixSession::startHeartbeatTimer() {
     heartbeatTimer_.expires_after(std::chrono::seconds(heartbeatInterval_));
     
     auto self = shared_from_this();
-    heartbeatTimer_.async_wait([self](const boost::system::error_code& error) {
+    heartbeatTimer_.async_wait(bind_executor(strand_, [self](const boost::system::error_code& error) {
         self->onHeartbeatTimeout(error);
-    });
+    }));
 }
 
 void FixSession::onHeartbeatTimeout(const boost::system::error_code& error) {
@@ -428,9 +671,9 @@ void FixSession::startTestRequestTimer() {
     testRequestTimer_.expires_after(std::chrono::seconds(heartbeatInterval_));
     
     auto self = shared_from_this();
-    testRequestTimer_.async_wait([self](const boost::system::error_code& error) {
+    testRequestTimer_.async_wait(bind_executor(strand_, [self](const boost::system::error_code& error) {
         self->onTestRequestTimeout(error);
-    });
+    }));
 }
 
 void FixSession::onTestRequestTimeout(const boost::system::error_code& error) {
@@ -477,6 +720,18 @@ void FixSession::loadConfiguration(std::shared_ptr<Config> config) {
     
     // Load network settings
     heartbeatInterval_ = config_->getInt("network", "heartbeat_interval", fix::HEARTBEAT_INTERVAL);
+    corkWindow_ = std::chrono::microseconds(config_->getInt("network", "write_coalesce_us", 0));
+    frameReader_ = FixFrameReader(
+        static_cast<size_t>(config_->getInt("network", "read_buffer_size",
+                                            static_cast<int>(FixFrameReader::DefaultBufferSize))),
+        static_cast<size_t>(config_->getInt("network", "max_message_size",
+                                            static_cast<int>(FixFrameReader::DefaultMaxMessageSize))));
+    
+    // Prices on the wire are converted using the instrument's tick size
+    parser_.setTickSize(TickSize(config_->getDouble("orderbook", "tick_size", 0.01)));
+    encoder_.setTickSize(parser_.getTickSize());
+    parser_.setValidateChecksum(config_->getBool("network", "validate_checksum", false));
+    traceLatency_ = config_->getBool("network", "latency_trace", false);
     
     // Load session identifiers if available
     std::string senderCompId = config_->getString("network", "sender_comp_id", "");
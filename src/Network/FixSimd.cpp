@@ -0,0 +1,171 @@
+#include "orderbook/Network/FixSimd.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ORDERBOOK_FIX_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORDERBOOK_FIX_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace orderbook::fix::simd {
+
+namespace {
+
+#if defined(ORDERBOOK_FIX_AVX2)
+constexpr size_t BlockSize = 32;
+#elif defined(ORDERBOOK_FIX_SSE2)
+constexpr size_t BlockSize = 16;
+#else
+constexpr size_t BlockSize = 0;
+#endif
+
+inline unsigned lowestBit(uint32_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+}
+
+#if defined(ORDERBOOK_FIX_AVX2) || defined(ORDERBOOK_FIX_SSE2)
+/**
+ * @brief Bitmasks of SOH and '=' bytes in one block
+ */
+inline void blockMasks(const char* p, uint32_t& soh, uint32_t& eq) {
+#if defined(ORDERBOOK_FIX_AVX2)
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    soh = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(FIELD_DELIMITER))));
+    eq = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('='))));
+#else
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    soh = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(bytes, _mm_set1_epi8(FIELD_DELIMITER))));
+    eq = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(bytes, _mm_set1_epi8('='))));
+#endif
+}
+#endif
+
+}
+
+const char* kernelName() {
+#if defined(ORDERBOOK_FIX_AVX2)
+    return "avx2";
+#elif defined(ORDERBOOK_FIX_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+size_t scanFields(const char* data, size_t size, size_t& pos,
+                  FieldBounds* out, size_t capacity) {
+    size_t count = 0;
+    size_t fieldStart = pos;
+    uint32_t equals = NoEquals;
+    size_t i = pos;
+
+    // Handles one structural byte; returns false once out is full
+    auto onDelimiter = [&](size_t index) {
+        if (index > fieldStart) {
+            out[count++] = FieldBounds{static_cast<uint32_t>(fieldStart), equals,
+                                       static_cast<uint32_t>(index)};
+        }
+        fieldStart = index + 1;
+        equals = NoEquals;
+        return count < capacity;
+    };
+
+    if (capacity == 0) {
+        return 0;
+    }
+
+#if defined(ORDERBOOK_FIX_AVX2) || defined(ORDERBOOK_FIX_SSE2)
+    for (; i + BlockSize <= size; i += BlockSize) {
+        uint32_t soh;
+        uint32_t eq;
+        blockMasks(data + i, soh, eq);
+
+        // Visit SOH and '=' bytes in buffer order
+        uint32_t structural = soh | eq;
+        while (structural) {
+            unsigned bit = lowestBit(structural);
+            size_t index = i + bit;
+            if (soh & (1u << bit)) {
+                if (!onDelimiter(index)) {
+                    pos = fieldStart;
+                    return count;
+                }
+            } else if (equals == NoEquals) {
+                equals = static_cast<uint32_t>(index);
+            }
+            structural &= structural - 1;
+        }
+    }
+#endif
+
+    // Scalar tail (or the whole buffer without SIMD)
+    for (; i < size; ++i) {
+        char c = data[i];
+        if (c == FIELD_DELIMITER) {
+            if (!onDelimiter(i)) {
+                pos = fieldStart;
+                return count;
+            }
+        } else if (c == '=' && equals == NoEquals) {
+            equals = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Field without a trailing SOH
+    if (fieldStart < size) {
+        out[count++] = FieldBounds{static_cast<uint32_t>(fieldStart), equals,
+                                   static_cast<uint32_t>(size)};
+    }
+    pos = size;
+    return count;
+}
+
+uint32_t byteSum(const char* data, size_t size) {
+    uint32_t sum = 0;
+    size_t i = 0;
+
+#if defined(ORDERBOOK_FIX_AVX2)
+    // SAD against zero adds each 8-byte lane into a 64-bit accumulator
+    __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, zero));
+    }
+    __m128i folded = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    folded = _mm_add_epi64(folded, _mm_unpackhi_epi64(folded, folded));
+    sum = static_cast<uint32_t>(_mm_cvtsi128_si32(folded));
+#elif defined(ORDERBOOK_FIX_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, zero));
+    }
+    acc = _mm_add_epi64(acc, _mm_unpackhi_epi64(acc, acc));
+    sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc));
+#endif
+
+    for (; i < size; ++i) {
+        sum += static_cast<uint8_t>(data[i]);
+    }
+    return sum;
+}
+
+}
@@ -0,0 +1,180 @@
+#include "orderbook/Network/IoContextPool.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/ThreadAffinity.hpp"
+#include <limits>
+#include <sstream>
+
+namespace orderbook {
+
+IoContextPool::IoContextPool(LoggerPtr logger)
+    : IoContextPool(std::move(logger), PoolConfig{}) {
+}
+
+IoContextPool::IoContextPool(LoggerPtr logger, const PoolConfig& config)
+    : logger_(std::move(logger)), config_(config) {
+    createContexts();
+}
+
+IoContextPool::IoContextPool(LoggerPtr logger, std::shared_ptr<Config> config)
+    : logger_(std::move(logger)), config_(loadConfiguration(config)) {
+    createContexts();
+}
+
+IoContextPool::~IoContextPool() {
+    stop();
+}
+
+void IoContextPool::start() {
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    for (size_t i = 0; i < contexts_.size(); ++i) {
+        contexts_[i]->thread = std::thread(&IoContextPool::runContext, this, i);
+    }
+
+    LOG_INFO(logger_, "IO context pool started with " + std::to_string(contexts_.size()) + " thread(s)" +
+                      (isBusyPoll() ? " busy-polling" : ""),
+                      "IoContextPool::start");
+}
+
+void IoContextPool::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    for (auto& context : contexts_) {
+        context->work.reset();
+        context->context.stop();
+    }
+    for (auto& context : contexts_) {
+        if (context->thread.joinable()) {
+            context->thread.join();
+        }
+    }
+
+    LOG_INFO(logger_, "IO context pool stopped", "IoContextPool::stop");
+}
+
+size_t IoContextPool::acquire() {
+    size_t index = 0;
+    if (config_.policy == AssignmentPolicy::LeastLoaded) {
+        size_t lowest = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < contexts_.size(); ++i) {
+            size_t load = contexts_[i]->sessions.load(std::memory_order_relaxed);
+            if (load < lowest) {
+                lowest = load;
+                index = i;
+            }
+        }
+    } else {
+        index = next_.fetch_add(1, std::memory_order_relaxed) % contexts_.size();
+    }
+
+    contexts_[index]->sessions.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void IoContextPool::release(size_t index) {
+    if (index < contexts_.size()) {
+        contexts_[index]->sessions.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void IoContextPool::addPoller(size_t index, Poller poller) {
+    if (index >= contexts_.size()) {
+        return;
+    }
+    Context& context = *contexts_[index];
+    boost::asio::post(context.context, [&context, poller = std::move(poller)]() mutable {
+        context.pollers.push_back(std::move(poller));
+    });
+}
+
+IoContextPool::AssignmentPolicy IoContextPool::parsePolicy(const std::string& name) {
+    return name == "least_loaded" ? AssignmentPolicy::LeastLoaded : AssignmentPolicy::RoundRobin;
+}
+
+IoContextPool::RunMode IoContextPool::parseRunMode(const std::string& name) {
+    return name == "busy_poll" ? RunMode::BusyPoll : RunMode::Blocking;
+}
+
+IoContextPool::PoolConfig IoContextPool::loadConfiguration(std::shared_ptr<Config> config) {
+    PoolConfig pool;
+    if (!config) {
+        return pool;
+    }
+
+    pool.threads = static_cast<size_t>(
+        config->getInt("network", "io_threads", static_cast<int>(pool.threads)));
+    pool.policy = parsePolicy(config->getString("network", "io_assignment", "round_robin"));
+    pool.mode = parseRunMode(config->getString("network", "receive_mode", "async"));
+    pool.busy_poll_us = config->getInt("network", "busy_poll_us", pool.busy_poll_us);
+
+    // Comma-separated CPU list, one entry per IO thread
+    std::istringstream cpus(config->getString("network", "io_cpu_affinity", ""));
+    for (std::string cpu; std::getline(cpus, cpu, ',');) {
+        try {
+            pool.cpu_affinity.push_back(std::stoi(cpu));
+        } catch (const std::exception&) {
+            pool.cpu_affinity.push_back(-1);
+        }
+    }
+
+    return pool;
+}
+
+void IoContextPool::createContexts() {
+    if (config_.threads == 0) {
+        config_.threads = 1;
+    }
+    for (size_t i = 0; i < config_.threads; ++i) {
+        contexts_.push_back(std::make_unique<Context>());
+    }
+}
+
+void IoContextPool::runContext(size_t index) {
+    if (index < config_.cpu_affinity.size() && config_.cpu_affinity[index] >= 0) {
+        int cpu = config_.cpu_affinity[index];
+        if (pinCurrentThread(cpu)) {
+            LOG_INFO(logger_, "Pinned IO thread " + std::to_string(index) + " to CPU " + std::to_string(cpu),
+                              "IoContextPool::runContext");
+        } else {
+            LOG_WARN(logger_, "Failed to pin IO thread " + std::to_string(index) + " to CPU " + std::to_string(cpu),
+                              "IoContextPool::runContext");
+        }
+    }
+
+    Context& context = *contexts_[index];
+    while (running_.load(std::memory_order_acquire)) {
+        try {
+            if (config_.mode == RunMode::BusyPoll) {
+                busyPoll(context);
+            } else {
+                context.context.run();
+            }
+            break;
+        } catch (const std::exception& e) {
+            // One failing handler must not take down every session on this thread
+            LOG_ERROR(logger_, "IO thread " + std::to_string(index) + " handler threw: " + e.what(),
+                               "IoContextPool::runContext");
+        }
+    }
+}
+
+void IoContextPool::busyPoll(Context& context) {
+    while (running_.load(std::memory_order_relaxed)) {
+        context.context.poll();
+        for (size_t i = 0; i < context.pollers.size();) {
+            if (context.pollers[i]()) {
+                ++i;
+                continue;
+            }
+            context.pollers[i] = std::move(context.pollers.back());
+            context.pollers.pop_back();
+        }
+    }
+}
+
+}
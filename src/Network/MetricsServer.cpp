@@ -0,0 +1,166 @@
+#include "orderbook/Network/MetricsServer.hpp"
+#include "orderbook/Utilities/Config.hpp"
+
+namespace orderbook {
+
+using boost::asio::ip::tcp;
+
+struct MetricsServer::Connection {
+    explicit Connection(tcp::socket s) : socket(std::move(s)), request(MaxRequestBytes) {}
+
+    tcp::socket socket;
+    boost::asio::streambuf request;
+    std::string response;
+};
+
+namespace {
+
+std::string httpResponse(const char* status, const char* content_type, const std::string& body) {
+    std::string response = "HTTP/1.0 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += content_type;
+    response += "\r\nContent-Length: " + std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+}
+
+MetricsServer::MetricsServer(std::shared_ptr<MetricsRegistry> registry, LoggerPtr logger)
+    : MetricsServer(std::move(registry), std::move(logger), ServerConfig{}) {
+}
+
+MetricsServer::MetricsServer(std::shared_ptr<MetricsRegistry> registry, LoggerPtr logger,
+                             const ServerConfig& config)
+    : registry_(std::move(registry)), logger_(std::move(logger)), config_(config), acceptor_(io_context_) {
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+Result<bool> MetricsServer::start() {
+    if (running_) {
+        return Result<bool>::success(true);
+    }
+
+    try {
+        tcp::endpoint endpoint(boost::asio::ip::make_address(config_.address), config_.port);
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(tcp::acceptor::reuse_address(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+    } catch (const boost::system::system_error& e) {
+        boost::system::error_code ignored;
+        acceptor_.close(ignored);
+        return Result<bool>::error(std::string("Failed to open metrics listener: ") + e.what());
+    }
+
+    running_ = true;
+    io_context_.restart();
+    accept();
+    thread_ = std::thread([this] { io_context_.run(); });
+
+    LOG_INFO(logger_, "Serving metrics on " + config_.address + ":" + std::to_string(getPort()) + "/metrics",
+                      "MetricsServer::start");
+    return Result<bool>::success(true);
+}
+
+void MetricsServer::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+
+    // Closing on the serving thread keeps the acceptor single-threaded
+    boost::asio::post(io_context_, [this] {
+        boost::system::error_code ignored;
+        acceptor_.close(ignored);
+        io_context_.stop();
+    });
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+uint16_t MetricsServer::getPort() const {
+    boost::system::error_code ec;
+    auto endpoint = acceptor_.local_endpoint(ec);
+    return ec ? 0 : endpoint.port();
+}
+
+MetricsServer::ServerConfig MetricsServer::loadConfiguration(std::shared_ptr<Config> config) {
+    ServerConfig server;
+    if (!config) {
+        return server;
+    }
+    server.address = config->getString("metrics", "address", server.address);
+    server.port = static_cast<uint16_t>(config->getInt("metrics", "port", server.port));
+    return server;
+}
+
+void MetricsServer::accept() {
+    acceptor_.async_accept([this](const boost::system::error_code& error, tcp::socket socket) {
+        if (error) {
+            if (error != boost::asio::error::operation_aborted) {
+                LOG_WARN(logger_, "Metrics accept failed: " + error.message(), "MetricsServer::accept");
+                accept();
+            }
+            return;
+        }
+        serve(std::make_shared<Connection>(std::move(socket)));
+        accept();
+    });
+}
+
+void MetricsServer::serve(std::shared_ptr<Connection> connection) {
+    boost::asio::async_read_until(connection->socket, connection->request, "\r\n\r\n",
+        [this, connection](const boost::system::error_code& error, size_t) {
+            if (error) {
+                // Oversized or truncated requests are dropped without a reply
+                return;
+            }
+
+            std::istream stream(&connection->request);
+            std::string request_line;
+            std::getline(stream, request_line);
+            if (!request_line.empty() && request_line.back() == '\r') {
+                request_line.pop_back();
+            }
+            connection->response = respond(request_line);
+
+            boost::asio::async_write(connection->socket, boost::asio::buffer(connection->response),
+                [connection](const boost::system::error_code&, size_t) {
+                    boost::system::error_code ignored;
+                    connection->socket.shutdown(tcp::socket::shutdown_both, ignored);
+                    connection->socket.close(ignored);
+                });
+        });
+}
+
+std::string MetricsServer::respond(const std::string& request_line) {
+    // Request line: METHOD SP TARGET SP VERSION
+    size_t method_end = request_line.find(' ');
+    size_t target_end = method_end == std::string::npos ? std::string::npos
+                                                        : request_line.find(' ', method_end + 1);
+    if (target_end == std::string::npos) {
+        return httpResponse("400 Bad Request", "text/plain", "Bad request\n");
+    }
+    std::string method = request_line.substr(0, method_end);
+    std::string target = request_line.substr(method_end + 1, target_end - method_end - 1);
+    target = target.substr(0, target.find('?'));
+
+    if (method != "GET") {
+        return httpResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    }
+    if (target != "/metrics") {
+        return httpResponse("404 Not Found", "text/plain", "Metrics are served at /metrics\n");
+    }
+
+    scrapes_.fetch_add(1, std::memory_order_relaxed);
+    return httpResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8", registry_->scrape());
+}
+
+}
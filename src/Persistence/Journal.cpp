@@ -0,0 +1,487 @@
+#include "orderbook/Persistence/Journal.hpp"
+#include "orderbook/Core/Order.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Record sequences are accessed atomically in place");
+
+// The sequence is plain data in the record layout so records stay copyable,
+// but writers and readers only ever touch it atomically
+std::atomic<uint64_t>& sequenceOf(JournalRecord& record) {
+    return *reinterpret_cast<std::atomic<uint64_t>*>(&record.sequence);
+}
+
+const std::atomic<uint64_t>& sequenceOf(const JournalRecord& record) {
+    return *reinterpret_cast<const std::atomic<uint64_t>*>(&record.sequence);
+}
+
+// Slots a crash can leave claimed but unfinished, one per appending thread,
+// are followed by at most a few finished ones; this many unwritten slots in
+// a row past the last complete record mark the end of what was written
+constexpr uint64_t RecoveryScanSlack = 1024;
+
+int64_t toNanoseconds(Timestamp timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+int64_t nowNanoseconds() {
+    return TscClock::nowNanoseconds();
+}
+
+Result<bool> systemError(const std::string& call, const std::string& path) {
+    return Result<bool>::error(call + "(" + path + "): " + std::strerror(errno));
+}
+
+bool validHeader(const JournalHeader& header) {
+    return header.magic == JournalHeader::Magic &&
+           header.layout_version == JournalHeader::Version &&
+           header.record_size == sizeof(JournalRecord) &&
+           header.capacity > 0;
+}
+
+}
+
+// JournalWriter
+
+JournalWriter::JournalWriter(LoggerPtr logger)
+    : JournalWriter(std::move(logger), JournalConfig{}) {
+}
+
+JournalWriter::JournalWriter(LoggerPtr logger, const JournalConfig& config)
+    : logger_(std::move(logger)), config_(config) {
+}
+
+JournalWriter::~JournalWriter() {
+    close();
+}
+
+Result<bool> JournalWriter::open() {
+#ifdef __linux__
+    close();
+    if (config_.path.empty()) {
+        return Result<bool>::error("Journal path is not set");
+    }
+
+    int fd = ::open(config_.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return systemError("open", config_.path);
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        auto error = systemError("fstat", config_.path);
+        ::close(fd);
+        return error;
+    }
+
+    // An existing journal keeps the capacity it was created with
+    size_t capacity = config_.capacity;
+    bool existing = info.st_size > 0;
+    if (existing) {
+        JournalHeader header{};
+        if (static_cast<size_t>(info.st_size) < sizeof(header) ||
+            pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            !validHeader(header) ||
+            static_cast<size_t>(info.st_size) < sizeof(header) + header.capacity * sizeof(JournalRecord)) {
+            ::close(fd);
+            return Result<bool>::error("File " + config_.path + " is not a journal");
+        }
+        capacity = static_cast<size_t>(header.capacity);
+    } else if (capacity == 0) {
+        ::close(fd);
+        return Result<bool>::error("Journal capacity must be positive");
+    }
+
+    size_t size = sizeof(JournalHeader) + capacity * sizeof(JournalRecord);
+    if (!existing) {
+        // Reserve the blocks now so an append can never hit a full disk mid-session
+        int rc = posix_fallocate(fd, 0, static_cast<off_t>(size));
+        if (rc != 0) {
+            errno = rc;
+            auto error = systemError("posix_fallocate", config_.path);
+            ::close(fd);
+            return error;
+        }
+    }
+
+    int flags = MAP_SHARED | (config_.prefault ? MAP_POPULATE : 0);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return systemError("mmap", config_.path);
+    }
+
+    base_ = static_cast<char*>(base);
+    mapped_size_ = size;
+    capacity_ = capacity;
+    records_ = reinterpret_cast<JournalRecord*>(base_ + sizeof(JournalHeader));
+    defined_symbols_.reset(new std::atomic<bool>[MaxTrackedIds]());
+    defined_accounts_.reset(new std::atomic<bool>[MaxTrackedIds]());
+
+    if (!existing) {
+        auto* header = reinterpret_cast<JournalHeader*>(base_);
+        header->magic = JournalHeader::Magic;
+        header->layout_version = JournalHeader::Version;
+        header->record_size = sizeof(JournalRecord);
+        header->capacity = capacity;
+        header->created_ns = nowNanoseconds();
+    }
+
+    recover();
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex_);
+        auto synced = syncLocked();
+        if (synced.isError()) {
+            LOG_WARN(logger_, "Initial journal sync failed: " + synced.error(), "JournalWriter::open");
+        }
+        running_ = config_.sync_interval.count() > 0;
+    }
+    if (running_) {
+        sync_thread_ = std::thread(&JournalWriter::runSync, this);
+    }
+
+    LOG_INFO(logger_, "Journal " + config_.path + " opened with " + std::to_string(recovered_) +
+                      " of " + std::to_string(capacity_) + " records used",
+                      "JournalWriter::open");
+    return Result<bool>::success(true);
+#else
+    return Result<bool>::error("Memory-mapped journals are not supported on this platform");
+#endif
+}
+
+void JournalWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex_);
+        running_ = false;
+    }
+    sync_wake_.notify_all();
+    if (sync_thread_.joinable()) {
+        sync_thread_.join();
+    }
+
+    if (records_) {
+        auto synced = sync();
+        if (synced.isError()) {
+            LOG_ERROR(logger_, "Final journal sync failed: " + synced.error(), "JournalWriter::close");
+        }
+#ifdef __linux__
+        munmap(base_, mapped_size_);
+#endif
+    }
+
+    base_ = nullptr;
+    records_ = nullptr;
+    mapped_size_ = 0;
+    capacity_ = 0;
+    next_sequence_.store(1, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    durable_sequence_.store(0, std::memory_order_relaxed);
+    recovered_ = 0;
+    synced_slots_ = 0;
+    syncs_ = 0;
+}
+
+uint64_t JournalWriter::append(const JournalRecord& record) {
+    if (!records_) {
+        return 0;
+    }
+
+    uint64_t sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+    if (sequence > capacity_) {
+        if (dropped_.fetch_add(1, std::memory_order_relaxed) == 0) {
+            LOG_ERROR(logger_, "Journal " + config_.path + " is full; records are being dropped",
+                               "JournalWriter::append");
+        }
+        return 0;
+    }
+
+    // The record becomes visible to readers and the sync thread once its sequence lands
+    JournalRecord& slot = records_[sequence - 1];
+    std::memcpy(reinterpret_cast<char*>(&slot) + sizeof(slot.sequence),
+                reinterpret_cast<const char*>(&record) + sizeof(record.sequence),
+                sizeof(JournalRecord) - sizeof(record.sequence));
+    sequenceOf(slot).store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+Result<bool> JournalWriter::sync() {
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    return syncLocked();
+}
+
+void JournalWriter::recordAdd(SymbolId symbol, const Order& order) {
+    defineSymbol(symbol);
+    defineAccount(order.account_id);
+
+    JournalRecord record{};
+    record.timestamp_ns = nowNanoseconds();
+    record.symbol_id = symbol;
+    record.type = JournalRecord::Type::Add;
+    record.side = static_cast<uint8_t>(order.side);
+    record.order_type = static_cast<uint8_t>(order.type);
+    record.tif = static_cast<uint8_t>(order.tif);
+    record.order.order_id = order.id.value;
+    record.order.price = order.price;
+    record.order.quantity = order.quantity;
+    record.order.account_id = order.account_id;
+    append(record);
+}
+
+void JournalWriter::recordCancel(SymbolId symbol, OrderId id) {
+    defineSymbol(symbol);
+
+    JournalRecord record{};
+    record.timestamp_ns = nowNanoseconds();
+    record.symbol_id = symbol;
+    record.type = JournalRecord::Type::Cancel;
+    record.order.order_id = id.value;
+    append(record);
+}
+
+void JournalWriter::recordModify(SymbolId symbol, OrderId id, Price new_price, Quantity new_quantity) {
+    defineSymbol(symbol);
+
+    JournalRecord record{};
+    record.timestamp_ns = nowNanoseconds();
+    record.symbol_id = symbol;
+    record.type = JournalRecord::Type::Modify;
+    record.order.order_id = id.value;
+    record.order.price = new_price;
+    record.order.quantity = new_quantity;
+    append(record);
+}
+
+void JournalWriter::recordTrade(const Trade& trade) {
+    defineSymbol(trade.symbol_id);
+
+    JournalRecord record{};
+    record.timestamp_ns = toNanoseconds(trade.timestamp);
+    record.symbol_id = trade.symbol_id;
+    record.type = JournalRecord::Type::Trade;
+    record.trade.trade_id = trade.id.value;
+    record.trade.buy_order_id = trade.buy_order_id.value;
+    record.trade.sell_order_id = trade.sell_order_id.value;
+    record.trade.price = trade.price;
+    record.trade.quantity = trade.quantity;
+    append(record);
+}
+
+JournalWriter::Stats JournalWriter::getStats() const {
+    Stats stats;
+    stats.records = std::min<uint64_t>(next_sequence_.load(std::memory_order_relaxed) - 1, capacity_);
+    stats.recovered = recovered_;
+    stats.durable_sequence = durable_sequence_.load(std::memory_order_acquire);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    stats.syncs = syncs_;
+    return stats;
+}
+
+JournalWriter::JournalConfig JournalWriter::loadConfiguration(std::shared_ptr<Config> config) {
+    JournalConfig journal;
+    if (!config) {
+        return journal;
+    }
+    journal.path = config->getString("journal", "path", journal.path);
+    journal.capacity = static_cast<size_t>(
+        config->getInt("journal", "capacity", static_cast<int>(journal.capacity)));
+    journal.sync_interval = std::chrono::microseconds(
+        config->getInt("journal", "sync_interval_us", static_cast<int>(journal.sync_interval.count())));
+    journal.prefault = config->getBool("journal", "prefault", journal.prefault);
+    return journal;
+}
+
+void JournalWriter::runSync() {
+    std::unique_lock<std::mutex> lock(sync_mutex_);
+    while (running_) {
+        sync_wake_.wait_for(lock, config_.sync_interval);
+        auto synced = syncLocked();
+        if (synced.isError()) {
+            LOG_ERROR(logger_, "Journal sync failed: " + synced.error(), "JournalWriter::runSync");
+        }
+    }
+}
+
+Result<bool> JournalWriter::syncLocked() {
+    if (!records_) {
+        return Result<bool>::success(true);
+    }
+
+    // Only the complete prefix counts; a slot still being written ends this pass
+    uint64_t end = completedPrefix(synced_slots_);
+    if (end == synced_slots_) {
+        return Result<bool>::success(true);
+    }
+
+#ifdef __linux__
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin_offset = sizeof(JournalHeader) + synced_slots_ * sizeof(JournalRecord);
+    size_t end_offset = sizeof(JournalHeader) + end * sizeof(JournalRecord);
+    begin_offset -= begin_offset % page;
+    if (msync(base_ + begin_offset, end_offset - begin_offset, MS_SYNC) != 0) {
+        return systemError("msync", config_.path);
+    }
+#endif
+
+    synced_slots_ = end;
+    ++syncs_;
+    durable_sequence_.store(end, std::memory_order_release);
+    return Result<bool>::success(true);
+}
+
+uint64_t JournalWriter::completedPrefix(uint64_t from) const {
+    uint64_t slot = from;
+    while (slot < capacity_ && sequenceOf(records_[slot]).load(std::memory_order_acquire) == slot + 1) {
+        ++slot;
+    }
+    return slot;
+}
+
+void JournalWriter::recover() {
+    uint64_t complete = completedPrefix(0);
+
+    // Anything past the first unfinished slot was never acknowledged as
+    // durable; clear it so it cannot be mistaken for records written from here on
+    uint64_t unwritten = 0;
+    for (uint64_t slot = complete; slot < capacity_ && unwritten < RecoveryScanSlack; ++slot) {
+        if (records_[slot].sequence == 0) {
+            ++unwritten;
+            continue;
+        }
+        unwritten = 0;
+        std::memset(static_cast<void*>(&records_[slot]), 0, sizeof(JournalRecord));
+    }
+
+    recovered_ = complete;
+    next_sequence_.store(complete + 1, std::memory_order_relaxed);
+}
+
+void JournalWriter::define(JournalRecord::Type type, uint32_t id) {
+    const std::string& name = type == JournalRecord::Type::Symbol ? InternTable::symbols().name(id)
+                                                                  : InternTable::accounts().name(id);
+    JournalRecord record{};
+    record.timestamp_ns = nowNanoseconds();
+    record.type = type;
+    record.name.id = id;
+    record.name.length = static_cast<uint8_t>(std::min(name.size(), JournalRecord::MaxNameLength));
+    std::memcpy(record.name.name, name.data(), record.name.length);
+    append(record);
+}
+
+void JournalWriter::defineSymbol(SymbolId symbol) {
+    if (symbol == InternTable::EmptyId) {
+        return;
+    }
+    if (symbol >= MaxTrackedIds) {
+        define(JournalRecord::Type::Symbol, symbol);
+        return;
+    }
+    // The flag is set after the definition's slot is claimed, so any record
+    // that sees it lands in a later slot
+    if (!defined_symbols_[symbol].load(std::memory_order_acquire)) {
+        define(JournalRecord::Type::Symbol, symbol);
+        defined_symbols_[symbol].store(true, std::memory_order_release);
+    }
+}
+
+void JournalWriter::defineAccount(AccountId account) {
+    if (account == InternTable::EmptyId) {
+        return;
+    }
+    if (account >= MaxTrackedIds) {
+        define(JournalRecord::Type::Account, account);
+        return;
+    }
+    if (!defined_accounts_[account].load(std::memory_order_acquire)) {
+        define(JournalRecord::Type::Account, account);
+        defined_accounts_[account].store(true, std::memory_order_release);
+    }
+}
+
+// JournalReader
+
+JournalReader::JournalReader(std::string path) : path_(std::move(path)) {
+}
+
+JournalReader::~JournalReader() {
+    close();
+}
+
+Result<bool> JournalReader::open() {
+#ifdef __linux__
+    close();
+
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return systemError("open", path_);
+    }
+
+    struct stat info {};
+    JournalHeader header{};
+    bool valid = fstat(fd, &info) == 0 &&
+                 static_cast<size_t>(info.st_size) >= sizeof(header) &&
+                 pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                 validHeader(header) &&
+                 static_cast<size_t>(info.st_size) >= sizeof(header) + header.capacity * sizeof(JournalRecord);
+    if (!valid) {
+        ::close(fd);
+        return Result<bool>::error("File " + path_ + " is not a journal");
+    }
+
+    size_t size = sizeof(JournalHeader) + static_cast<size_t>(header.capacity) * sizeof(JournalRecord);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return systemError("mmap", path_);
+    }
+
+    base_ = static_cast<const char*>(base);
+    mapped_size_ = size;
+    capacity_ = static_cast<size_t>(header.capacity);
+    records_ = reinterpret_cast<const JournalRecord*>(base_ + sizeof(JournalHeader));
+    next_sequence_ = 1;
+    return Result<bool>::success(true);
+#else
+    return Result<bool>::error("Memory-mapped journals are not supported on this platform");
+#endif
+}
+
+void JournalReader::close() {
+#ifdef __linux__
+    if (base_) {
+        munmap(const_cast<char*>(base_), mapped_size_);
+    }
+#endif
+    base_ = nullptr;
+    records_ = nullptr;
+    mapped_size_ = 0;
+    capacity_ = 0;
+}
+
+const JournalRecord* JournalReader::next() {
+    if (!records_ || next_sequence_ > capacity_) {
+        return nullptr;
+    }
+    const JournalRecord& slot = records_[next_sequence_ - 1];
+    if (sequenceOf(slot).load(std::memory_order_acquire) != next_sequence_) {
+        return nullptr;
+    }
+    ++next_sequence_;
+    return &slot;
+}
+
+}
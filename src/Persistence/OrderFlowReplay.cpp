@@ -0,0 +1,327 @@
+#include "orderbook/Persistence/OrderFlowReplay.hpp"
+#include "orderbook/Persistence/Journal.hpp"
+#include "orderbook/Core/Order.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+std::string lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+bool parseAction(const std::string& text, OrderFlowEvent::Type& type) {
+    std::string action = lowercase(text);
+    if (action == "add" || action == "new" || action == "d") {
+        type = OrderFlowEvent::Type::Add;
+    } else if (action == "cancel" || action == "f") {
+        type = OrderFlowEvent::Type::Cancel;
+    } else if (action == "modify" || action == "replace" || action == "g") {
+        type = OrderFlowEvent::Type::Modify;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseSide(const std::string& text, Side& side) {
+    std::string value = lowercase(text);
+    if (value == "buy" || value == "b" || value == "1") {
+        side = Side::Buy;
+    } else if (value == "sell" || value == "s" || value == "2") {
+        side = Side::Sell;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseOrderType(const std::string& text, OrderType& type) {
+    std::string value = lowercase(text);
+    if (value.empty() || value == "limit" || value == "2") {
+        type = OrderType::Limit;
+    } else if (value == "market" || value == "1") {
+        type = OrderType::Market;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseTif(const std::string& text, TimeInForce& tif) {
+    std::string value = lowercase(text);
+    if (value.empty() || value == "gtc" || value == "day" || value == "0" || value == "1") {
+        tif = TimeInForce::GTC;
+    } else if (value == "ioc" || value == "3") {
+        tif = TimeInForce::IOC;
+    } else if (value == "fok" || value == "4") {
+        tif = TimeInForce::FOK;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseCsvLine(const std::string& line, OrderFlowEvent& event) {
+    std::vector<std::string> fields;
+    std::istringstream stream(line);
+    for (std::string field; std::getline(stream, field, ',');) {
+        field.erase(0, field.find_first_not_of(" \t"));
+        field.erase(field.find_last_not_of(" \t\r") + 1);
+        fields.push_back(std::move(field));
+    }
+    if (fields.size() < 4 || !parseAction(fields[1], event.type) || fields[2].empty()) {
+        return false;
+    }
+    fields.resize(10);
+
+    try {
+        event.timestamp_ns = std::stoll(fields[0]);
+        event.order_id = std::stoull(fields[3]);
+        event.price = fields[7].empty() ? 0.0 : std::stod(fields[7]);
+        event.quantity = fields[8].empty() ? 0 : std::stoull(fields[8]);
+    } catch (const std::exception&) {
+        return false;
+    }
+    event.symbol = InternTable::symbols().intern(fields[2]);
+    event.account = InternTable::accounts().intern(fields[9]);
+
+    if (event.type == OrderFlowEvent::Type::Add) {
+        return parseSide(fields[4], event.side) && parseOrderType(fields[5], event.order_type) &&
+               parseTif(fields[6], event.tif) && event.quantity > 0;
+    }
+    return true;
+}
+
+}
+
+// OrderFlowCapture
+
+Result<std::vector<OrderFlowEvent>> OrderFlowCapture::loadJournal(const std::string& path) {
+    JournalReader reader(path);
+    auto opened = reader.open();
+    if (opened.isError()) {
+        return Result<std::vector<OrderFlowEvent>>::error(opened.error());
+    }
+
+    // Journal IDs to this process's interned IDs, per the latest definition
+    std::vector<SymbolId> symbols;
+    std::vector<AccountId> accounts;
+    auto define = [](std::vector<uint32_t>& ids, InternTable& table, const JournalRecord& record) {
+        if (record.name.id >= ids.size()) {
+            ids.resize(record.name.id + 1, InternTable::EmptyId);
+        }
+        size_t length = std::min<size_t>(record.name.length, JournalRecord::MaxNameLength);
+        ids[record.name.id] = table.intern(std::string_view(record.name.name, length));
+    };
+    auto map = [](const std::vector<uint32_t>& ids, uint32_t id) {
+        return id < ids.size() ? ids[id] : InternTable::EmptyId;
+    };
+
+    std::vector<OrderFlowEvent> events;
+    while (const JournalRecord* record = reader.next()) {
+        OrderFlowEvent event;
+        switch (record->type) {
+            case JournalRecord::Type::Symbol:
+                define(symbols, InternTable::symbols(), *record);
+                continue;
+            case JournalRecord::Type::Account:
+                define(accounts, InternTable::accounts(), *record);
+                continue;
+            case JournalRecord::Type::Add:
+                event.type = OrderFlowEvent::Type::Add;
+                event.side = static_cast<Side>(record->side);
+                event.order_type = static_cast<OrderType>(record->order_type);
+                event.tif = static_cast<TimeInForce>(record->tif);
+                event.account = map(accounts, record->order.account_id);
+                break;
+            case JournalRecord::Type::Cancel:
+                event.type = OrderFlowEvent::Type::Cancel;
+                break;
+            case JournalRecord::Type::Modify:
+                event.type = OrderFlowEvent::Type::Modify;
+                break;
+            default:
+                continue;
+        }
+        event.timestamp_ns = record->timestamp_ns;
+        event.symbol = map(symbols, record->symbol_id);
+        event.order_id = record->order.order_id;
+        event.price = record->order.price;
+        event.quantity = record->order.quantity;
+        events.push_back(event);
+    }
+    return Result<std::vector<OrderFlowEvent>>::success(std::move(events));
+}
+
+Result<std::vector<OrderFlowEvent>> OrderFlowCapture::loadCsv(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return Result<std::vector<OrderFlowEvent>>::error("Cannot open " + path);
+    }
+
+    std::vector<OrderFlowEvent> events;
+    size_t line_number = 0;
+    for (std::string line; std::getline(file, line);) {
+        ++line_number;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        // A header line starts with a column name rather than a timestamp
+        if (events.empty() && !std::isdigit(static_cast<unsigned char>(line[first])) && line[first] != '-') {
+            continue;
+        }
+
+        OrderFlowEvent event;
+        if (!parseCsvLine(line, event)) {
+            return Result<std::vector<OrderFlowEvent>>::error(path + ":" + std::to_string(line_number) +
+                                                              ": malformed event: " + line);
+        }
+        events.push_back(event);
+    }
+    return Result<std::vector<OrderFlowEvent>>::success(std::move(events));
+}
+
+// RouterFlowTarget
+
+bool RouterFlowTarget::apply(const OrderFlowEvent& event, size_t) {
+    switch (event.type) {
+        case OrderFlowEvent::Type::Add: {
+            Order order(event.order_id, event.side, event.order_type, event.tif, event.price, event.quantity,
+                        event.symbol, event.account);
+            bool added = router_.addOrder(order, match_).isSuccess();
+            trades_ += match_.trades.size();
+            return added;
+        }
+        case OrderFlowEvent::Type::Cancel:
+            return router_.cancelOrder(event.symbol, OrderId(event.order_id)).isSuccess();
+        case OrderFlowEvent::Type::Modify:
+            return router_.modifyOrder(event.symbol, OrderId(event.order_id), event.price, event.quantity).isSuccess();
+    }
+    return false;
+}
+
+// OrderFlowReplay
+
+const OrderFlowReplay::OperationReport& OrderFlowReplay::Report::forType(OrderFlowEvent::Type type) const {
+    switch (type) {
+        case OrderFlowEvent::Type::Cancel:
+            return cancel;
+        case OrderFlowEvent::Type::Modify:
+            return modify;
+        default:
+            return add;
+    }
+}
+
+OrderFlowReplay::OperationReport& OrderFlowReplay::Report::forType(OrderFlowEvent::Type type) {
+    return const_cast<OperationReport&>(static_cast<const Report*>(this)->forType(type));
+}
+
+OrderFlowReplay::OrderFlowReplay()
+    : OrderFlowReplay(ReplayConfig{}) {
+}
+
+OrderFlowReplay::OrderFlowReplay(const ReplayConfig& config)
+    : config_(config) {
+    if (config_.speed <= 0.0) {
+        config_.speed = 1.0;
+    }
+}
+
+std::unique_ptr<OrderFlowReplay::Report> OrderFlowReplay::run(const std::vector<OrderFlowEvent>& events,
+                                                              OrderFlowTarget& target) const {
+    using Clock = std::chrono::steady_clock;
+    auto report = std::make_unique<Report>();
+    target.prepare(events);
+    if (events.empty()) {
+        return report;
+    }
+
+    bool paced = config_.pace == Pace::Recorded;
+    int64_t first_timestamp = events.front().timestamp_ns;
+    Clock::time_point start = Clock::now();
+    Clock::time_point measured_start = start;
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        const OrderFlowEvent& event = events[i];
+        bool measured = i >= config_.warmup_events;
+        if (i == config_.warmup_events) {
+            measured_start = Clock::now();
+        }
+
+        // Due time on the replay clock; a capture that goes backwards is sent at once
+        Clock::time_point due = start;
+        if (paced) {
+            auto offset = static_cast<int64_t>((event.timestamp_ns - first_timestamp) / config_.speed);
+            due += std::chrono::nanoseconds(std::max<int64_t>(offset, 0));
+            while (Clock::now() < due) {
+                cpuRelax();
+            }
+        }
+
+        Clock::time_point sent = Clock::now();
+        bool accepted = target.apply(event, i);
+        Clock::time_point done = Clock::now();
+        if (!measured) {
+            continue;
+        }
+
+        OperationReport& operation = report->forType(event.type);
+        operation.service.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            done - sent).count()));
+        if (paced) {
+            operation.response.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                done - due).count()));
+            report->max_lag_ns = std::max<int64_t>(report->max_lag_ns,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(sent - due).count());
+        }
+        if (!accepted) {
+            ++operation.rejected;
+        }
+        ++report->events;
+    }
+
+    report->seconds = std::chrono::duration<double>(Clock::now() - measured_start).count();
+    return report;
+}
+
+OrderFlowReplay::Pace OrderFlowReplay::parsePace(const std::string& name) {
+    return name == "recorded" ? Pace::Recorded : Pace::AsFastAsPossible;
+}
+
+OrderFlowReplay::ReplayConfig OrderFlowReplay::loadConfiguration(std::shared_ptr<Config> config) {
+    ReplayConfig replay;
+    if (!config) {
+        return replay;
+    }
+    replay.pace = parsePace(config->getString("replay", "pace", "max"));
+    replay.speed = config->getDouble("replay", "speed", replay.speed);
+    replay.warmup_events = static_cast<size_t>(
+        config->getInt("replay", "warmup_events", static_cast<int>(replay.warmup_events)));
+    return replay;
+}
+
+}
@@ -0,0 +1,304 @@
+#include "orderbook/Persistence/Snapshot.hpp"
+#include "orderbook/Core/BookSnapshot.hpp"
+#include "orderbook/Core/MatchingRuntime.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+int64_t nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Result<bool> systemError(const std::string& call, const std::string& path) {
+    return Result<bool>::error(call + "(" + path + "): " + std::strerror(errno));
+}
+
+#ifdef __linux__
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+#endif
+
+}
+
+// SnapshotWriter
+
+SnapshotWriter::SnapshotWriter(LoggerPtr logger)
+    : SnapshotWriter(std::move(logger), SnapshotConfig{}) {
+}
+
+SnapshotWriter::SnapshotWriter(LoggerPtr logger, const SnapshotConfig& config)
+    : logger_(std::move(logger)), config_(config) {
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    wait();
+}
+
+Result<bool> SnapshotWriter::capture(MatchingRuntime& runtime) {
+    return captureBooks([this, &runtime]() {
+        runtime.visitBooks([this](SymbolId symbol, OrderBook& book) {
+            captureBook(symbol, book);
+        });
+    });
+}
+
+Result<bool> SnapshotWriter::capture(const OrderBookRouter& router) {
+    return captureBooks([this, &router]() {
+        router.forEachBook([this](SymbolId symbol, const OrderBook& book) {
+            captureBook(symbol, book);
+        });
+    });
+}
+
+template<typename VisitAll>
+Result<bool> SnapshotWriter::captureBooks(VisitAll&& visit_all) {
+    if (config_.path.empty()) {
+        return Result<bool>::error("Snapshot path is not set");
+    }
+    if (isWriting()) {
+        return Result<bool>::error("Previous snapshot of " + config_.path + " is still being written");
+    }
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    // One slot per symbol interned so far, which covers every registered
+    // book; buffers keep their capacity from one snapshot to the next
+    sections_.resize(InternTable::symbols().size());
+    for (auto& section : sections_) {
+        section.clear();
+    }
+    capture_ns_.assign(sections_.size(), 0);
+
+    visit_all();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_ = true;
+    }
+    writer_ = std::thread([this]() {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t bytes = 0;
+        uint64_t books = 0;
+        auto result = writeFile(bytes, books);
+        int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if (result.isError()) {
+            LOG_ERROR(logger_, "Snapshot failed: " + result.error(), "SnapshotWriter::capture");
+        } else {
+            LOG_INFO(logger_, "Wrote snapshot of " + std::to_string(books) + " book(s), " +
+                              std::to_string(bytes) + " bytes, to " + config_.path,
+                              "SnapshotWriter::capture");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (result.isError()) {
+            ++stats_.failures;
+        } else {
+            ++stats_.snapshots;
+            stats_.books = books;
+            stats_.bytes = bytes;
+            stats_.capture_ns = *std::max_element(capture_ns_.begin(), capture_ns_.end());
+            stats_.write_ns = elapsed;
+        }
+        last_result_ = std::move(result);
+        writing_ = false;
+    });
+    return Result<bool>::success(true);
+}
+
+void SnapshotWriter::captureBook(SymbolId symbol, const OrderBook& book) {
+    if (symbol >= sections_.size()) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // Read on the book's thread, so every record the book appended is covered
+    uint64_t journal_sequence = journal_ ? journal_->getLastSequence() : 0;
+    book.saveSnapshot(sections_[symbol], journal_sequence);
+
+    capture_ns_[symbol] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+Result<bool> SnapshotWriter::writeFile(uint64_t& bytes, uint64_t& books) {
+#ifdef __linux__
+    SnapshotFileHeader header{};
+    header.magic = SnapshotFileHeader::Magic;
+    header.layout_version = SnapshotFileHeader::Version;
+    header.taken_ns = nowNanoseconds();
+    for (const auto& section : sections_) {
+        header.book_count += section.empty() ? 0 : 1;
+    }
+
+    // Written beside the snapshot and renamed over it, so a crash mid-write
+    // leaves the previous snapshot in place
+    std::string temp_path = config_.path + ".tmp";
+    int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return systemError("open", temp_path);
+    }
+
+    bool written = writeAll(fd, reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes = sizeof(header);
+    for (const auto& section : sections_) {
+        if (!written) {
+            break;
+        }
+        written = writeAll(fd, section.data(), section.size());
+        bytes += section.size();
+    }
+    if (!written || fsync(fd) != 0) {
+        auto error = systemError(written ? "fsync" : "write", temp_path);
+        ::close(fd);
+        ::unlink(temp_path.c_str());
+        return error;
+    }
+    ::close(fd);
+
+    if (::rename(temp_path.c_str(), config_.path.c_str()) != 0) {
+        auto error = systemError("rename", temp_path);
+        ::unlink(temp_path.c_str());
+        return error;
+    }
+
+    // Make the rename itself durable
+    size_t slash = config_.path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : config_.path.substr(0, std::max<size_t>(slash, 1));
+    int directory_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directory_fd >= 0) {
+        fsync(directory_fd);
+        ::close(directory_fd);
+    }
+
+    books = header.book_count;
+    return Result<bool>::success(true);
+#else
+    (void)bytes;
+    (void)books;
+    return Result<bool>::error("Snapshots are not supported on this platform");
+#endif
+}
+
+Result<bool> SnapshotWriter::wait() {
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_result_;
+}
+
+bool SnapshotWriter::isWriting() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writing_;
+}
+
+SnapshotWriter::Stats SnapshotWriter::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+SnapshotWriter::SnapshotConfig SnapshotWriter::loadConfiguration(std::shared_ptr<Config> config) {
+    SnapshotConfig snapshot;
+    if (!config) {
+        return snapshot;
+    }
+    snapshot.path = config->getString("snapshot", "path", snapshot.path);
+    return snapshot;
+}
+
+// SnapshotLoader
+
+SnapshotLoader::SnapshotLoader(OrderBookRouter& router, LoggerPtr logger)
+    : router_(router), logger_(std::move(logger)) {
+}
+
+Result<SnapshotLoader::Stats> SnapshotLoader::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return Result<Stats>::error("Cannot open snapshot " + path);
+    }
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return Result<Stats>::error("Cannot read snapshot " + path);
+    }
+
+    SnapshotFileHeader header;
+    if (data.size() < sizeof(header)) {
+        return Result<Stats>::error("File " + path + " is not a snapshot");
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != SnapshotFileHeader::Magic || header.layout_version != SnapshotFileHeader::Version) {
+        return Result<Stats>::error("File " + path + " is not a snapshot");
+    }
+
+    Stats stats;
+    stats.taken_ns = header.taken_ns;
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.book_count; ++i) {
+        BookSnapshotHeader section;
+        size_t remaining = data.size() - offset;
+        if (remaining < sizeof(section)) {
+            return Result<Stats>::error("Snapshot " + path + " is truncated");
+        }
+        std::memcpy(&section, data.data() + offset, sizeof(section));
+        if (section.section_size < sizeof(section) || section.section_size > remaining ||
+            section.symbol_length > section.section_size - sizeof(section)) {
+            return Result<Stats>::error("Snapshot " + path + " is truncated");
+        }
+
+        std::string_view symbol(data.data() + offset + sizeof(section), section.symbol_length);
+        auto symbol_id = InternTable::symbols().find(symbol);
+        OrderBook* book = symbol_id ? router_.getBook(*symbol_id) : nullptr;
+        if (!book) {
+            ++stats.unknown_books;
+            LOG_WARN(logger_, "Snapshot has no configured book for " + std::string(symbol),
+                              "SnapshotLoader::load");
+        } else {
+            auto loaded = book->loadSnapshot(data.data() + offset, remaining);
+            if (loaded.isError()) {
+                return Result<Stats>::error("Snapshot of " + std::string(symbol) + ": " + loaded.error());
+            }
+            journal_sequences_[*symbol_id] = loaded.value();
+            ++stats.books;
+            stats.orders += book->getOrderCount();
+        }
+        offset += section.section_size;
+    }
+
+    LOG_INFO(logger_, "Restored " + std::to_string(stats.books) + " book(s) with " +
+                      std::to_string(stats.orders) + " orders from " + path,
+                      "SnapshotLoader::load");
+    return Result<Stats>::success(stats);
+}
+
+}
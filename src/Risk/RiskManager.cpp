@@ -5,119 +5,229 @@
 
 namespace orderbook {
 
-RiskManager::RiskManager(const RiskLimits& limits, LoggerPtr logger) 
-    : limits_(limits), logger_(logger) {
+RiskManager::RiskManager(LoggerPtr logger)
+    : RiskManager(RiskLimits{}, std::move(logger)) {
+}
+
+RiskManager::RiskManager(const RiskLimits& limits, LoggerPtr logger)
+    : logger_(logger) {
+    publishLimits(limits);
+    allocateRows();
     if (logger_) {
         logger_->info("RiskManager initialized with custom limits", "RiskManager::ctor");
     }
 }
 
-RiskManager::RiskManager(std::shared_ptr<Config> config, LoggerPtr logger) 
+RiskManager::RiskManager(std::shared_ptr<Config> config, LoggerPtr logger)
     : config_(config), logger_(logger) {
+    publishLimits(RiskLimits{});
     loadConfiguration(config);
+    allocateRows();
     if (logger_) {
         logger_->info("RiskManager initialized with configuration", "RiskManager::ctor");
     }
 }
 
+RiskManager::~RiskManager() {
+    releaseRows();
+}
+
+RiskCheck RiskManager::checkOrder(const Order& order) {
+    RiskCheck check = checkOrderStateless(order);
+    return check.isRejected() ? check : checkOrderPosition(order);
+}
+
+RiskCheck RiskManager::checkOrderStateless(const Order& order) const {
+    const RiskLimits& limits = getLimits();
+    if (!validateOrderSize(limits, order.quantity)) {
+        std::ostringstream oss;
+        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits.max_order_size;
+        return reject(order, oss.str());
+    }
+
+    // Market orders carry no price of their own
+    if (order.type == OrderType::Limit && !validatePrice(limits, order.price)) {
+        std::ostringstream oss;
+        oss << "Order price " << order.price << " outside allowed range ["
+            << limits.min_price << ", " << limits.max_price << "]";
+        return reject(order, oss.str());
+    }
+
+    if (order.type == OrderType::Limit && !validatePriceBand(limits, order)) {
+        std::ostringstream oss;
+        oss << "Order price " << order.price << " is more than " << limits.fat_finger_percent
+            << "% from reference price " << getReferencePrice(order.symbol_id);
+        return reject(order, oss.str());
+    }
+
+    return RiskCheck(RiskResult::Approved);
+}
+
+RiskCheck RiskManager::checkOrderPosition(const Order& order) {
+    PositionSlot* slot = slotFor(order.account_id, order.symbol_id);
+    if (!slot) {
+        return reject(order, "Account or symbol outside the risk position table");
+    }
+
+    int64_t position_change = static_cast<int64_t>(order.quantity);
+    if (order.side == Side::Sell) {
+        position_change = -position_change;
+    }
+    int64_t new_position = slot->position.load(std::memory_order_relaxed) + position_change;
+    if (new_position < slot->min_position.load(std::memory_order_relaxed) ||
+        new_position > slot->max_position.load(std::memory_order_relaxed)) {
+        return reject(order, "Order would exceed position limits for symbol " + order.symbol());
+    }
+
+    return RiskCheck(RiskResult::Approved);
+}
+
+void RiskManager::onFill(const Trade& trade, AccountId buy_account, AccountId sell_account) {
+    auto quantity = static_cast<int64_t>(trade.quantity);
+
+    // Buyer's position goes up, seller's down
+    if (PositionSlot* buy = slotFor(buy_account, trade.symbol_id)) {
+        buy->position.store(buy->position.load(std::memory_order_relaxed) + quantity, std::memory_order_relaxed);
+        buy->last_price.store(trade.price, std::memory_order_relaxed);
+    }
+    if (PositionSlot* sell = slotFor(sell_account, trade.symbol_id)) {
+        sell->position.store(sell->position.load(std::memory_order_relaxed) - quantity, std::memory_order_relaxed);
+        sell->last_price.store(trade.price, std::memory_order_relaxed);
+    }
+    setReferencePrice(trade.symbol_id, trade.price);
+}
+
 RiskCheck RiskManager::validateOrder(const Order& order, const Portfolio& portfolio) {
     PERF_TIMER("RiskManager::validateOrder", logger_);
-    
+
     if (logger_) {
         logger_->debug("Validating order ID: " + std::to_string(order.id.value) +
-                      " Symbol: " + order.symbol + " Quantity: " + std::to_string(order.quantity) +
+                      " Symbol: " + order.symbol() + " Quantity: " + std::to_string(order.quantity) +
                       " Price: " + std::to_string(order.price), "RiskManager::validateOrder");
     }
-    
+
+    const RiskLimits& limits = getLimits();
+
     // Validate order size
-    if (!validateOrderSize(order.quantity)) {
+    if (!validateOrderSize(limits, order.quantity)) {
         std::ostringstream oss;
-        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits_.max_order_size;
-        if (logger_) {
-            logger_->warn("Order size validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
-        return RiskCheck(RiskResult::Rejected, oss.str());
+        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits.max_order_size;
+        return reject(order, oss.str());
     }
-    
+
     // Validate price
-    if (!validatePrice(order.price)) {
+    if (!validatePrice(limits, order.price)) {
         std::ostringstream oss;
-        oss << "Order price " << order.price << " outside allowed range [" 
-            << limits_.min_price << ", " << limits_.max_price << "]";
-        if (logger_) {
-            logger_->warn("Order price validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
-        return RiskCheck(RiskResult::Rejected, oss.str());
+        oss << "Order price " << order.price << " outside allowed range ["
+            << limits.min_price << ", " << limits.max_price << "]";
+        return reject(order, oss.str());
     }
-    
+
     // Validate position limits
-    if (!validatePosition(portfolio, order)) {
-        std::ostringstream oss;
-        oss << "Order would exceed position limits for symbol " << order.symbol;
-        if (logger_) {
-            logger_->warn("Position limit validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
-        return RiskCheck(RiskResult::Rejected, oss.str());
+    if (!validatePosition(limits, portfolio, order)) {
+        return reject(order, "Order would exceed position limits for symbol " + order.symbol());
     }
-    
+
     if (logger_) {
-        logger_->debug("Order passed all risk validations", 
+        logger_->debug("Order passed all risk validations",
                       "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
     }
-    
+
     return RiskCheck(RiskResult::Approved, "Order passed all risk checks");
 }
 
 void RiskManager::updatePosition(const Trade& trade) {
     // Get accounts for the orders involved in the trade
-    std::string buy_account = getAccountForOrder(trade.buy_order_id);
-    std::string sell_account = getAccountForOrder(trade.sell_order_id);
-    
-    // Update buyer's position (positive quantity)
-    if (portfolios_.find(buy_account) == portfolios_.end()) {
-        portfolios_[buy_account] = Portfolio(buy_account);
-    }
-    portfolios_[buy_account].updatePosition(trade.symbol, static_cast<int64_t>(trade.quantity), trade.price);
-    
-    // Update seller's position (negative quantity)
-    if (portfolios_.find(sell_account) == portfolios_.end()) {
-        portfolios_[sell_account] = Portfolio(sell_account);
-    }
-    portfolios_[sell_account].updatePosition(trade.symbol, -static_cast<int64_t>(trade.quantity), trade.price);
+    AccountId buy_account = InternTable::accounts().intern(getAccountForOrder(trade.buy_order_id));
+    AccountId sell_account = InternTable::accounts().intern(getAccountForOrder(trade.sell_order_id));
+    onFill(trade, buy_account, sell_account);
 }
 
 void RiskManager::associateOrderWithAccount(OrderId order_id, const std::string& account) {
-    order_to_account_[order_id] = account;
+    AccountId id = InternTable::accounts().intern(account);
+    std::lock_guard<std::mutex> lock(mutex_);
+    order_to_account_[order_id] = id;
 }
 
 std::string RiskManager::getAccountForOrder(OrderId order_id) const {
-    auto it = order_to_account_.find(order_id);
-    if (it != order_to_account_.end()) {
-        return it->second;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = order_to_account_.find(order_id);
+        if (it != order_to_account_.end()) {
+            return InternTable::accounts().name(it->second);
+        }
     }
     // Return default account if not found
     return "account_" + std::to_string(order_id.value);
 }
 
 const Portfolio& RiskManager::getPortfolio(const std::string& account) const {
-    auto it = portfolios_.find(account);
-    if (it == portfolios_.end()) {
-        // Create new portfolio if it doesn't exist
-        portfolios_[account] = Portfolio(account);
-        return portfolios_[account];
+    // Orders without an account trade as "default", which is the empty account ID
+    std::optional<AccountId> id = (account.empty() || account == "default")
+        ? std::optional<AccountId>(InternTable::EmptyId)
+        : InternTable::accounts().find(account);
+
+    // Rebuilt from the position table on every call; off the matching path
+    std::lock_guard<std::mutex> lock(mutex_);
+    Portfolio& portfolio = portfolios_.insert_or_assign(account, Portfolio(account)).first->second;
+    if (id && *id < row_capacity_) {
+        if (const PositionSlot* row = rows_[*id].load(std::memory_order_acquire)) {
+            for (SymbolId symbol = 0; symbol < row_width_; ++symbol) {
+                int64_t position = row[symbol].position.load(std::memory_order_relaxed);
+                if (position != 0) {
+                    const std::string& name = InternTable::symbols().name(symbol);
+                    portfolio.positions[name] = position;
+                    portfolio.avg_prices[name] = row[symbol].last_price.load(std::memory_order_relaxed);
+                }
+            }
+        }
     }
-    return it->second;
+    return portfolio;
+}
+
+int64_t RiskManager::getPosition(AccountId account, SymbolId symbol) const {
+    const PositionSlot* slot = findSlot(account, symbol);
+    return slot ? slot->position.load(std::memory_order_relaxed) : 0;
+}
+
+void RiskManager::setReferencePrice(SymbolId symbol, Price price) {
+    if (symbol < row_width_) {
+        reference_prices_[symbol].store(price, std::memory_order_relaxed);
+    }
+}
+
+Price RiskManager::getReferencePrice(SymbolId symbol) const {
+    return symbol < row_width_ ? reference_prices_[symbol].load(std::memory_order_relaxed) : 0.0;
 }
 
 void RiskManager::setLimits(const RiskLimits& limits) {
-    limits_ = limits;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // The position table keeps the size it was built with
+    RiskLimits published = limits;
+    if (rows_) {
+        published.max_accounts = row_capacity_;
+        published.max_symbols = row_width_;
+    }
+    publishLimits(published);
+
+    // Re-derive every slot's limits
+    for (size_t account = 0; account < row_capacity_; ++account) {
+        if (PositionSlot* row = rows_[account].load(std::memory_order_acquire)) {
+            applyLimits(row, static_cast<AccountId>(account));
+        }
+    }
 }
 
-const RiskManager::RiskLimits& RiskManager::getLimits() const {
-    return limits_;
+void RiskManager::setPositionLimits(AccountId account, SymbolId symbol, int64_t min_position, int64_t max_position) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limit_overrides_[{account, symbol}] = {min_position, max_position};
+    if (account < row_capacity_ && symbol < row_width_) {
+        if (PositionSlot* row = rows_[account].load(std::memory_order_acquire)) {
+            row[symbol].min_position.store(min_position, std::memory_order_relaxed);
+            row[symbol].max_position.store(max_position, std::memory_order_relaxed);
+        }
+    }
 }
 
 void RiskManager::loadConfiguration(std::shared_ptr<Config> config) {
@@ -125,13 +235,20 @@ void RiskManager::loadConfiguration(std::shared_ptr<Config> config) {
     if (!config_) {
         return;
     }
-    
+
     // Load risk limits from configuration
-    limits_.max_order_size = config_->getInt("risk", "max_order_size", limits_.max_order_size);
-    limits_.max_price = config_->getDouble("risk", "max_price", limits_.max_price);
-    limits_.min_price = config_->getDouble("risk", "min_price", limits_.min_price);
-    limits_.max_position = config_->getInt("risk", "max_position", limits_.max_position);
-    limits_.min_position = config_->getInt("risk", "min_position", limits_.min_position);
+    RiskLimits limits = getLimits();
+    limits.max_order_size = config_->getInt("risk", "max_order_size", limits.max_order_size);
+    limits.max_price = config_->getDouble("risk", "max_price", limits.max_price);
+    limits.min_price = config_->getDouble("risk", "min_price", limits.min_price);
+    limits.max_position = config_->getInt("risk", "max_position", limits.max_position);
+    limits.min_position = config_->getInt("risk", "min_position", limits.min_position);
+    limits.fat_finger_percent = config_->getDouble("risk", "fat_finger_percent", limits.fat_finger_percent);
+    limits.max_accounts = static_cast<size_t>(
+        config_->getInt("risk", "max_accounts", static_cast<int>(limits.max_accounts)));
+    limits.max_symbols = static_cast<size_t>(
+        config_->getInt("risk", "max_symbols", static_cast<int>(limits.max_symbols)));
+    setLimits(limits);
 }
 
 void RiskManager::reloadConfiguration() {
@@ -140,25 +257,119 @@ void RiskManager::reloadConfiguration() {
     }
 }
 
-bool RiskManager::validateOrderSize(Quantity quantity) const {
-    return quantity > 0 && quantity <= limits_.max_order_size;
+RiskManager::PositionSlot* RiskManager::findSlot(AccountId account, SymbolId symbol) const {
+    if (account >= row_capacity_ || symbol >= row_width_) {
+        return nullptr;
+    }
+    PositionSlot* row = rows_[account].load(std::memory_order_acquire);
+    return row ? &row[symbol] : nullptr;
+}
+
+RiskManager::PositionSlot* RiskManager::slotFor(AccountId account, SymbolId symbol) {
+    if (account >= row_capacity_ || symbol >= row_width_) {
+        return nullptr;
+    }
+    PositionSlot* row = rows_[account].load(std::memory_order_acquire);
+    if (!row) {
+        row = createRow(account);
+    }
+    return &row[symbol];
+}
+
+RiskManager::PositionSlot* RiskManager::createRow(AccountId account) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PositionSlot* row = rows_[account].load(std::memory_order_acquire);
+    if (row) {
+        return row;     // Another shard got here first
+    }
+
+    row = new PositionSlot[row_width_];
+    applyLimits(row, account);
+    rows_[account].store(row, std::memory_order_release);
+
+    LOG_DEBUG(logger_, "Created risk position row for account " + InternTable::accounts().name(account),
+                       "RiskManager::createRow");
+    return row;
+}
+
+void RiskManager::publishLimits(const RiskLimits& limits) {
+    limit_sets_.push_back(std::make_unique<const RiskLimits>(limits));
+    limits_.store(limit_sets_.back().get(), std::memory_order_release);
+}
+
+void RiskManager::applyLimits(PositionSlot* row, AccountId account) const {
+    const RiskLimits& limits = getLimits();
+    for (size_t symbol = 0; symbol < row_width_; ++symbol) {
+        row[symbol].min_position.store(limits.min_position, std::memory_order_relaxed);
+        row[symbol].max_position.store(limits.max_position, std::memory_order_relaxed);
+    }
+
+    // Overrides are ordered by account, so this account's are contiguous
+    for (auto it = limit_overrides_.lower_bound({account, 0});
+         it != limit_overrides_.end() && it->first.first == account; ++it) {
+        SymbolId symbol = it->first.second;
+        if (symbol < row_width_) {
+            row[symbol].min_position.store(it->second.first, std::memory_order_relaxed);
+            row[symbol].max_position.store(it->second.second, std::memory_order_relaxed);
+        }
+    }
+}
+
+void RiskManager::allocateRows() {
+    row_capacity_ = getLimits().max_accounts;
+    row_width_ = getLimits().max_symbols;
+    rows_ = std::make_unique<std::atomic<PositionSlot*>[]>(row_capacity_);
+    for (size_t account = 0; account < row_capacity_; ++account) {
+        rows_[account].store(nullptr, std::memory_order_relaxed);
+    }
+    reference_prices_ = std::make_unique<std::atomic<Price>[]>(row_width_);
+    for (size_t symbol = 0; symbol < row_width_; ++symbol) {
+        reference_prices_[symbol].store(0.0, std::memory_order_relaxed);
+    }
+}
+
+void RiskManager::releaseRows() {
+    for (size_t account = 0; account < row_capacity_; ++account) {
+        delete[] rows_[account].load(std::memory_order_relaxed);
+    }
 }
 
-bool RiskManager::validatePrice(Price price) const {
-    return price >= limits_.min_price && price <= limits_.max_price;
+bool RiskManager::validateOrderSize(const RiskLimits& limits, Quantity quantity) const {
+    return quantity > 0 && quantity <= limits.max_order_size;
 }
 
-bool RiskManager::validatePosition(const Portfolio& portfolio, const Order& order) const {
-    int64_t current_position = portfolio.getPosition(order.symbol);
+bool RiskManager::validatePrice(const RiskLimits& limits, Price price) const {
+    return price >= limits.min_price && price <= limits.max_price;
+}
+
+bool RiskManager::validatePriceBand(const RiskLimits& limits, const Order& order) const {
+    Price reference = getReferencePrice(order.symbol_id);
+    if (limits.fat_finger_percent <= 0.0 || reference <= 0.0) {
+        return true;
+    }
+    Price band = reference * limits.fat_finger_percent / 100.0;
+    return order.price >= reference - band && order.price <= reference + band;
+}
+
+bool RiskManager::validatePosition(const RiskLimits& limits, const Portfolio& portfolio, const Order& order) const {
+    int64_t current_position = portfolio.getPosition(order.symbol());
     int64_t position_change = static_cast<int64_t>(order.quantity);
-    
+
     if (order.side == Side::Sell) {
         position_change = -position_change;
     }
-    
+
     int64_t new_position = current_position + position_change;
-    
-    return new_position >= limits_.min_position && new_position <= limits_.max_position;
+
+    return new_position >= limits.min_position && new_position <= limits.max_position;
+}
+
+RiskCheck RiskManager::reject(const Order& order, const std::string& reason) const {
+    if (logger_) {
+        logger_->warn("Risk check failed: " + reason,
+                     "RiskManager - OrderID: " + std::to_string(order.id.value));
+    }
+    return RiskCheck(RiskResult::Rejected, reason);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,487 @@
+#include "orderbook/Utilities/Benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <cstdlib>
+#else
+#include <unistd.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+// Upper bound on the iterations of one run, whatever min_time asks for
+constexpr uint64_t MaxIterations = 1000000000;
+
+// Process CPU time; clock() ticks in microseconds at best, too coarse to
+// bracket the short timed stretches between pauses
+double cpuNanoseconds() {
+#ifdef _WIN32
+    return static_cast<double>(std::clock()) * 1e9 / CLOCKS_PER_SEC;
+#else
+    timespec now{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) * 1e9 + static_cast<double>(now.tv_nsec);
+#endif
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "0";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.10g", value);
+    return text;
+}
+
+std::string hostName() {
+#ifdef _WIN32
+    const char* name = std::getenv("COMPUTERNAME");
+    return name ? name : "unknown";
+#else
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) != 0) {
+        return "unknown";
+    }
+    return name;
+#endif
+}
+
+std::string localDate() {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char text[40];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S%z", &local);
+    return text;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+double mean(const std::vector<double>& values) {
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    return sum / static_cast<double>(values.size());
+}
+
+double stddev(const std::vector<double>& values) {
+    double average = mean(values);
+    double sum = 0.0;
+    for (double value : values) {
+        sum += (value - average) * (value - average);
+    }
+    return std::sqrt(sum / static_cast<double>(values.size() - 1));
+}
+
+}
+
+// BenchmarkState implementation
+
+bool BenchmarkState::advance() {
+    if (!running_ && !finished_ && error_.empty()) {
+        running_ = true;
+        start_cpu_ = cpuNanoseconds();
+        start_ticks_ = TscClock::ticks();
+        if (remaining_ != 0) {
+            --remaining_;
+            return true;
+        }
+    }
+    if (running_) {
+        if (!paused_) {
+            uint64_t end_ticks = TscClock::ticks();
+            real_ns_ += TscClock::toNanoseconds(end_ticks - start_ticks_);
+            cpu_ns_ += cpuNanoseconds() - start_cpu_;
+        }
+        running_ = false;
+        paused_ = false;
+    }
+    finished_ = true;
+    return false;
+}
+
+void BenchmarkState::pauseTiming() {
+    if (!running_ || paused_) {
+        return;
+    }
+    uint64_t end_ticks = TscClock::ticks();
+    real_ns_ += TscClock::toNanoseconds(end_ticks - start_ticks_);
+    cpu_ns_ += cpuNanoseconds() - start_cpu_;
+    paused_ = true;
+}
+
+void BenchmarkState::resumeTiming() {
+    if (!running_ || !paused_) {
+        return;
+    }
+    paused_ = false;
+    start_cpu_ = cpuNanoseconds();
+    start_ticks_ = TscClock::ticks();
+}
+
+void BenchmarkState::setCounter(const std::string& name, double value) {
+    for (auto& counter : counters_) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    counters_.emplace_back(name, value);
+}
+
+void BenchmarkState::skipWithError(std::string message) {
+    error_ = message.empty() ? "skipped" : std::move(message);
+    remaining_ = 0;     // The next keepRunning() stops
+}
+
+// Benchmark implementation
+
+Benchmark* Benchmark::args(std::vector<int64_t> values) {
+    arg_sets_.push_back(std::move(values));
+    return this;
+}
+
+Benchmark* Benchmark::argValues(const std::vector<int64_t>& values) {
+    for (int64_t value : values) {
+        arg_sets_.push_back({value});
+    }
+    return this;
+}
+
+Benchmark* Benchmark::argNames(std::vector<std::string> names) {
+    arg_names_ = std::move(names);
+    return this;
+}
+
+Benchmark* Benchmark::iterations(uint64_t count) {
+    fixed_iterations_ = count;
+    return this;
+}
+
+std::string Benchmark::instanceName(size_t instance) const {
+    std::string name = name_;
+    if (instance < arg_sets_.size()) {
+        const auto& values = arg_sets_[instance];
+        for (size_t i = 0; i < values.size(); ++i) {
+            name += '/';
+            if (i < arg_names_.size() && !arg_names_[i].empty()) {
+                name += arg_names_[i] + ':';
+            }
+            name += std::to_string(values[i]);
+        }
+    }
+    if (fixed_iterations_ != 0) {
+        name += "/iterations:" + std::to_string(fixed_iterations_);
+    }
+    return name;
+}
+
+Benchmark* Benchmark::registerBenchmark(const char* name, Function function) {
+    auto& benchmarks = mutableRegistry();
+    benchmarks.push_back(std::make_unique<Benchmark>(name, function));
+    return benchmarks.back().get();
+}
+
+const std::vector<std::unique_ptr<Benchmark>>& Benchmark::registry() {
+    return mutableRegistry();
+}
+
+std::vector<std::unique_ptr<Benchmark>>& Benchmark::mutableRegistry() {
+    // Function-local so registration from other translation units' static
+    // initializers finds it constructed
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+// BenchmarkRunner implementation
+
+BenchmarkRunner::BenchmarkRunner() : BenchmarkRunner(RunnerConfig{}) {}
+
+BenchmarkRunner::BenchmarkRunner(const RunnerConfig& config) : config_(config) {
+    config_.repetitions = std::max(config_.repetitions, 1);
+}
+
+Result<std::vector<std::string>> BenchmarkRunner::list() const {
+    std::regex filter;
+    try {
+        filter = std::regex(config_.filter);
+    } catch (const std::regex_error& e) {
+        return Result<std::vector<std::string>>::error("Invalid filter '" + config_.filter + "': " + e.what());
+    }
+
+    std::vector<std::string> names;
+    for (const auto& benchmark : Benchmark::registry()) {
+        size_t instances = std::max<size_t>(benchmark->arg_sets_.size(), 1);
+        for (size_t i = 0; i < instances; ++i) {
+            std::string name = benchmark->instanceName(i);
+            if (std::regex_search(name, filter)) {
+                names.push_back(std::move(name));
+            }
+        }
+    }
+    return Result<std::vector<std::string>>::success(std::move(names));
+}
+
+Result<std::vector<BenchmarkRunner::Run>> BenchmarkRunner::runAll(void (*on_run)(const Run&)) const {
+    std::regex filter;
+    try {
+        filter = std::regex(config_.filter);
+    } catch (const std::regex_error& e) {
+        return Result<std::vector<Run>>::error("Invalid filter '" + config_.filter + "': " + e.what());
+    }
+
+    std::vector<Run> runs;
+    const auto& benchmarks = Benchmark::registry();
+    for (size_t family = 0; family < benchmarks.size(); ++family) {
+        const Benchmark& benchmark = *benchmarks[family];
+        size_t instances = std::max<size_t>(benchmark.arg_sets_.size(), 1);
+        for (size_t instance = 0; instance < instances; ++instance) {
+            if (!std::regex_search(benchmark.instanceName(instance), filter)) {
+                continue;
+            }
+
+            // Grow the iteration count until a run lasts min_time
+            uint64_t iterations = benchmark.fixed_iterations_ != 0 ? benchmark.fixed_iterations_ : 1;
+            Run run = runInstance(benchmark, instance, iterations);
+            while (benchmark.fixed_iterations_ == 0 && run.error.empty() && iterations < MaxIterations) {
+                double seconds = run.real_time_ns * static_cast<double>(iterations) / 1e9;
+                if (seconds >= config_.min_time) {
+                    break;
+                }
+                // Aim 40% past min_time; a run too short to trust only grows tenfold
+                double multiplier = seconds / config_.min_time > 0.1
+                    ? config_.min_time * 1.4 / seconds : 10.0;
+                uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * multiplier);
+                iterations = std::min(MaxIterations, std::max(iterations + 1, next));
+                run = runInstance(benchmark, instance, iterations);
+            }
+
+            size_t first = runs.size();
+            for (int repetition = 0; repetition < config_.repetitions; ++repetition) {
+                if (repetition > 0) {
+                    run = runInstance(benchmark, instance, iterations);
+                }
+                run.family_index = family;
+                run.instance_index = instance;
+                run.repetitions = config_.repetitions;
+                run.repetition_index = repetition;
+                runs.push_back(run);
+                if (on_run) {
+                    on_run(runs.back());
+                }
+            }
+            if (config_.repetitions > 1) {
+                addAggregates(runs, first);
+                if (on_run) {
+                    for (size_t i = first + config_.repetitions; i < runs.size(); ++i) {
+                        on_run(runs[i]);
+                    }
+                }
+            }
+        }
+    }
+    return Result<std::vector<Run>>::success(std::move(runs));
+}
+
+BenchmarkRunner::Run BenchmarkRunner::runInstance(const Benchmark& benchmark, size_t instance,
+                                                  uint64_t iterations) const {
+    static const std::vector<int64_t> no_args;
+    BenchmarkState state(instance < benchmark.arg_sets_.size() ? benchmark.arg_sets_[instance] : no_args,
+                         iterations);
+    benchmark.function_(state);
+
+    Run run;
+    run.name = benchmark.instanceName(instance);
+    run.run_name = run.name;
+    run.iterations = iterations;
+    run.label = state.label_;
+    run.error = state.error_;
+    if (run.error.empty() && !state.finished_) {
+        run.error = "benchmark did not run its keepRunning() loop to the end";
+    }
+    if (!run.error.empty()) {
+        return run;
+    }
+
+    double count = static_cast<double>(iterations);
+    run.real_time_ns = static_cast<double>(state.real_ns_) / count;
+    run.cpu_time_ns = state.cpu_ns_ / count;
+    if (state.real_ns_ > 0) {
+        double seconds = static_cast<double>(state.real_ns_) / 1e9;
+        run.items_per_second = static_cast<double>(state.items_processed_) / seconds;
+        run.bytes_per_second = static_cast<double>(state.bytes_processed_) / seconds;
+    }
+    run.counters = state.counters_;
+    return run;
+}
+
+void BenchmarkRunner::addAggregates(std::vector<Run>& runs, size_t first) {
+    std::vector<Run> repeated(runs.begin() + static_cast<std::ptrdiff_t>(first), runs.end());
+    for (const Run& run : repeated) {
+        if (!run.error.empty()) {
+            return;
+        }
+    }
+
+    struct Statistic {
+        const char* name;
+        double (*compute)(const std::vector<double>&);
+    };
+    const Statistic statistics[] = {
+        {"mean", mean},
+        {"median", [](const std::vector<double>& values) { return median(values); }},
+        {"stddev", stddev},
+    };
+
+    auto column = [&repeated](auto field) {
+        std::vector<double> values;
+        for (const Run& run : repeated) {
+            values.push_back(field(run));
+        }
+        return values;
+    };
+
+    for (const Statistic& statistic : statistics) {
+        Run aggregate = repeated.front();
+        aggregate.name = aggregate.run_name + "_" + statistic.name;
+        aggregate.aggregate = true;
+        aggregate.aggregate_name = statistic.name;
+        aggregate.repetition_index = 0;
+        aggregate.real_time_ns = statistic.compute(column([](const Run& r) { return r.real_time_ns; }));
+        aggregate.cpu_time_ns = statistic.compute(column([](const Run& r) { return r.cpu_time_ns; }));
+        aggregate.items_per_second = statistic.compute(column([](const Run& r) { return r.items_per_second; }));
+        aggregate.bytes_per_second = statistic.compute(column([](const Run& r) { return r.bytes_per_second; }));
+        for (size_t c = 0; c < aggregate.counters.size(); ++c) {
+            aggregate.counters[c].second = statistic.compute(column([c](const Run& r) {
+                return c < r.counters.size() ? r.counters[c].second : 0.0;
+            }));
+        }
+        runs.push_back(std::move(aggregate));
+    }
+}
+
+void BenchmarkRunner::printConsoleHeader() {
+    std::printf("%-52s %14s %14s %12s  %s\n", "Benchmark", "Time", "CPU", "Iterations", "Counters");
+    std::printf("%s\n", std::string(112, '-').c_str());
+}
+
+void BenchmarkRunner::printConsoleRun(const Run& run) {
+    if (!run.error.empty()) {
+        std::printf("%-52s ERROR: %s\n", run.name.c_str(), run.error.c_str());
+        return;
+    }
+    std::printf("%-52s %11.1f ns %11.1f ns %12llu ", run.name.c_str(), run.real_time_ns, run.cpu_time_ns,
+                static_cast<unsigned long long>(run.iterations));
+    if (run.items_per_second > 0.0) {
+        std::printf(" items/s=%.4g", run.items_per_second);
+    }
+    if (run.bytes_per_second > 0.0) {
+        std::printf(" bytes/s=%.4g", run.bytes_per_second);
+    }
+    for (const auto& counter : run.counters) {
+        std::printf(" %s=%.4g", counter.first.c_str(), counter.second);
+    }
+    if (!run.label.empty()) {
+        std::printf(" %s", run.label.c_str());
+    }
+    std::printf("\n");
+}
+
+std::string BenchmarkRunner::toJson(const std::vector<Run>& runs, const std::string& executable) {
+    std::ostringstream out;
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": " << jsonString(localDate()) << ",\n";
+    out << "    \"host_name\": " << jsonString(hostName()) << ",\n";
+    out << "    \"executable\": " << jsonString(executable) << ",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"mhz_per_cpu\": " << (TscClock::usesTsc() ? jsonNumber(TscClock::ticksPerNanosecond() * 1000.0) : "0")
+        << ",\n";
+    out << "    \"tsc_clock\": " << (TscClock::usesTsc() ? "true" : "false") << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run& run = runs[i];
+        out << (i ? ",\n" : "\n") << "    {\n";
+        out << "      \"name\": " << jsonString(run.name) << ",\n";
+        out << "      \"family_index\": " << run.family_index << ",\n";
+        out << "      \"per_family_instance_index\": " << run.instance_index << ",\n";
+        out << "      \"run_name\": " << jsonString(run.run_name) << ",\n";
+        out << "      \"run_type\": \"" << (run.aggregate ? "aggregate" : "iteration") << "\",\n";
+        out << "      \"repetitions\": " << run.repetitions << ",\n";
+        out << "      \"repetition_index\": " << run.repetition_index << ",\n";
+        if (run.aggregate) {
+            out << "      \"aggregate_name\": " << jsonString(run.aggregate_name) << ",\n";
+            out << "      \"aggregate_unit\": \"time\",\n";
+        }
+        out << "      \"threads\": 1,\n";
+        if (!run.error.empty()) {
+            out << "      \"error_occurred\": true,\n";
+            out << "      \"error_message\": " << jsonString(run.error) << "\n    }";
+            continue;
+        }
+        out << "      \"iterations\": " << run.iterations << ",\n";
+        out << "      \"real_time\": " << jsonNumber(run.real_time_ns) << ",\n";
+        out << "      \"cpu_time\": " << jsonNumber(run.cpu_time_ns) << ",\n";
+        out << "      \"time_unit\": \"ns\"";
+        if (run.items_per_second > 0.0) {
+            out << ",\n      \"items_per_second\": " << jsonNumber(run.items_per_second);
+        }
+        if (run.bytes_per_second > 0.0) {
+            out << ",\n      \"bytes_per_second\": " << jsonNumber(run.bytes_per_second);
+        }
+        for (const auto& counter : run.counters) {
+            out << ",\n      " << jsonString(counter.first) << ": " << jsonNumber(counter.second);
+        }
+        if (!run.label.empty()) {
+            out << ",\n      \"label\": " << jsonString(run.label);
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+}
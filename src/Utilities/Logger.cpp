@@ -7,13 +7,44 @@
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace orderbook {
 
 std::shared_ptr<Logger> Logger::global_logger_;
 std::mutex Logger::global_mutex_;
+std::atomic<uint64_t> Logger::next_instance_id_{1};
 
-Logger::Logger(const LogConfig& config) : config_(config), current_file_size_(0) {
+namespace {
+
+// Upper bound on records taken from one ring per drain pass
+constexpr size_t MaxDrainBatch = 1024;
+
+// Per-thread cache of this thread's ring for each async logger
+struct ThreadRings {
+    std::vector<std::pair<uint64_t, std::shared_ptr<void>>> entries;
+    std::vector<std::atomic<bool>*> retired_flags;
+    
+    ~ThreadRings() {
+        // Let the drain threads drop rings whose producer has gone
+        for (auto* flag : retired_flags) {
+            flag->store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRings thread_rings;
+
+}
+
+Logger::Logger() : Logger(LogConfig{}) {
+}
+
+Logger::Logger(const LogConfig& config) 
+    : config_(config), current_file_size_(0),
+      instance_id_(next_instance_id_.fetch_add(1, std::memory_order_relaxed)) {
+    setEnabledLevel(config_.min_level);
     if (!config_.filename.empty()) {
         file_stream_ = std::make_unique<std::ofstream>(config_.filename, std::ios::app);
         if (file_stream_->is_open()) {
@@ -22,13 +53,20 @@ Logger::Logger(const LogConfig& config) : config_(config), current_file_size_(0)
             current_file_size_ = file_stream_->tellp();
         }
     }
+    if (config_.async) {
+        startAsync();
+    }
 }
 
-Logger::Logger(std::shared_ptr<Config> config) : current_file_size_(0) {
+Logger::Logger(std::shared_ptr<Config> config) 
+    : current_file_size_(0),
+      instance_id_(next_instance_id_.fetch_add(1, std::memory_order_relaxed)) {
+    setEnabledLevel(config_.min_level);
     loadConfiguration(config);
 }
 
 Logger::~Logger() {
+    stopAsync();
     if (file_stream_ && file_stream_->is_open()) {
         file_stream_->close();
     }
@@ -45,10 +83,14 @@ void Logger::loadConfiguration(std::shared_ptr<Config> config) {
     config_.json_format = config->getBool("logging", "json_format", true);
     config_.max_file_size = config->getInt("logging", "max_file_size", 100 * 1024 * 1024);
     config_.max_files = config->getInt("logging", "max_files", 5);
+    config_.async = config->getBool("logging", "async", false);
+    config_.async_queue_size = config->getInt("logging", "async_queue_size", 8192);
+    config_.async_flush_interval_ms = config->getInt("logging", "async_flush_interval_ms", 10);
     
     // Parse log level
     std::string level_str = config->getString("logging", "level", "info");
     config_.min_level = parseLogLevel(level_str);
+    setEnabledLevel(config_.min_level);
     
     // Initialize file stream
     if (!config_.filename.empty()) {
@@ -59,6 +101,12 @@ void Logger::loadConfiguration(std::shared_ptr<Config> config) {
             current_file_size_ = file_stream_->tellp();
         }
     }
+    
+    if (config_.async) {
+        startAsync();
+    } else {
+        stopAsync();
+    }
 }
 
 LogLevel Logger::parseLogLevel(const std::string& level_str) {
@@ -78,14 +126,15 @@ void Logger::log(LogLevel level, const std::string& message, const std::string&
         return;
     }
     
+    if (isAsync()) {
+        enqueue(level, RecordFormat::Text, {}, {context, message});
+        return;
+    }
+    
     std::lock_guard<std::mutex> lock(log_mutex_);
     
-    std::string formatted_message;
-    if (config_.json_format) {
-        formatted_message = formatJsonMessage(level, message, context);
-    } else {
-        formatted_message = formatMessage(level, message, context);
-    }
+    std::string formatted_message = formatLine(level, message, context, 
+                                               std::chrono::system_clock::now());
     
     if (config_.console_output) {
         writeToConsole(formatted_message);
@@ -119,92 +168,121 @@ void Logger::logPerformance(const std::string& operation,
         return;
     }
     
+    if (isAsync()) {
+        enqueue(LogLevel::INFO, RecordFormat::Performance, {latency_ns}, 
+                {operation}, &additional_metrics);
+        return;
+    }
+    
+    log(LogLevel::INFO, renderPerformance(operation, latency_ns, additional_metrics), "PERF");
+}
+
+void Logger::logThroughput(const std::string& operation, uint64_t count, uint64_t duration_ns) {
+    if (!shouldLog(LogLevel::INFO)) {
+        return;
+    }
+    
+    if (isAsync()) {
+        enqueue(LogLevel::INFO, RecordFormat::Throughput, {count, duration_ns}, {operation});
+        return;
+    }
+    
+    log(LogLevel::INFO, renderThroughput(operation, count, duration_ns), "THROUGHPUT");
+}
+
+void Logger::logLatencyStats(const std::string& operation, uint64_t min_ns, uint64_t max_ns, uint64_t avg_ns) {
+    if (!shouldLog(LogLevel::INFO)) {
+        return;
+    }
+    
+    if (isAsync()) {
+        enqueue(LogLevel::INFO, RecordFormat::LatencyStats, {min_ns, max_ns, avg_ns}, {operation});
+        return;
+    }
+    
+    log(LogLevel::INFO, renderLatencyStats(operation, min_ns, max_ns, avg_ns), "LATENCY");
+}
+
+void Logger::logMemoryUsage(const std::string& component, size_t bytes_used, size_t bytes_allocated) {
+    if (!shouldLog(LogLevel::INFO)) {
+        return;
+    }
+    
+    if (isAsync()) {
+        enqueue(LogLevel::INFO, RecordFormat::MemoryUsage, {bytes_used, bytes_allocated}, {component});
+        return;
+    }
+    
+    log(LogLevel::INFO, renderMemoryUsage(component, bytes_used, bytes_allocated), "MEMORY");
+}
+
+std::string Logger::renderPerformance(std::string_view operation, uint64_t latency_ns,
+                                      const std::vector<std::pair<std::string, std::string>>& metrics) const {
+    std::ostringstream oss;
     if (config_.json_format) {
-        std::ostringstream oss;
         oss << "{\"type\":\"performance\",\"operation\":\"" << operation << "\""
             << ",\"latency_ns\":" << latency_ns;
         
-        for (const auto& [key, value] : additional_metrics) {
+        for (const auto& [key, value] : metrics) {
             oss << ",\"" << key << "\":\"" << value << "\"";
         }
         oss << "}";
-        
-        log(LogLevel::INFO, oss.str(), "PERF");
     } else {
-        std::ostringstream oss;
         oss << "Performance: " << operation << " took " << latency_ns << "ns";
         
-        for (const auto& [key, value] : additional_metrics) {
+        for (const auto& [key, value] : metrics) {
             oss << ", " << key << "=" << value;
         }
-        
-        log(LogLevel::INFO, oss.str(), "PERF");
     }
+    return oss.str();
 }
 
-void Logger::logThroughput(const std::string& operation, uint64_t count, uint64_t duration_ns) {
-    if (!shouldLog(LogLevel::INFO)) {
-        return;
-    }
-    
+std::string Logger::renderThroughput(std::string_view operation, uint64_t count, uint64_t duration_ns) const {
     double ops_per_sec = (count * 1e9) / duration_ns;
     
+    std::ostringstream oss;
     if (config_.json_format) {
-        std::ostringstream oss;
         oss << "{\"type\":\"throughput\",\"operation\":\"" << operation << "\""
             << ",\"count\":" << count << ",\"duration_ns\":" << duration_ns
             << ",\"ops_per_sec\":" << std::fixed << std::setprecision(2) << ops_per_sec << "}";
-        log(LogLevel::INFO, oss.str(), "THROUGHPUT");
     } else {
-        std::ostringstream oss;
         oss << "Throughput: " << operation << " processed " << count << " operations in "
             << duration_ns << "ns (" << std::fixed << std::setprecision(2) << ops_per_sec << " ops/sec)";
-        log(LogLevel::INFO, oss.str(), "THROUGHPUT");
     }
+    return oss.str();
 }
 
-void Logger::logLatencyStats(const std::string& operation, uint64_t min_ns, uint64_t max_ns, uint64_t avg_ns) {
-    if (!shouldLog(LogLevel::INFO)) {
-        return;
-    }
-    
+std::string Logger::renderLatencyStats(std::string_view operation, uint64_t min_ns, uint64_t max_ns, uint64_t avg_ns) const {
+    std::ostringstream oss;
     if (config_.json_format) {
-        std::ostringstream oss;
         oss << "{\"type\":\"latency_stats\",\"operation\":\"" << operation << "\""
             << ",\"min_ns\":" << min_ns << ",\"max_ns\":" << max_ns << ",\"avg_ns\":" << avg_ns << "}";
-        log(LogLevel::INFO, oss.str(), "LATENCY");
     } else {
-        std::ostringstream oss;
         oss << "Latency Stats: " << operation << " - min: " << min_ns << "ns, max: " 
             << max_ns << "ns, avg: " << avg_ns << "ns";
-        log(LogLevel::INFO, oss.str(), "LATENCY");
     }
+    return oss.str();
 }
 
-void Logger::logMemoryUsage(const std::string& component, size_t bytes_used, size_t bytes_allocated) {
-    if (!shouldLog(LogLevel::INFO)) {
-        return;
-    }
-    
+std::string Logger::renderMemoryUsage(std::string_view component, size_t bytes_used, size_t bytes_allocated) const {
     double utilization = bytes_allocated > 0 ? (double)bytes_used / bytes_allocated * 100.0 : 0.0;
     
+    std::ostringstream oss;
     if (config_.json_format) {
-        std::ostringstream oss;
         oss << "{\"type\":\"memory_usage\",\"component\":\"" << component << "\""
             << ",\"bytes_used\":" << bytes_used << ",\"bytes_allocated\":" << bytes_allocated
             << ",\"utilization_percent\":" << std::fixed << std::setprecision(2) << utilization << "}";
-        log(LogLevel::INFO, oss.str(), "MEMORY");
     } else {
-        std::ostringstream oss;
         oss << "Memory Usage: " << component << " - used: " << bytes_used << " bytes, allocated: "
             << bytes_allocated << " bytes (" << std::fixed << std::setprecision(2) << utilization << "% utilization)";
-        log(LogLevel::INFO, oss.str(), "MEMORY");
     }
+    return oss.str();
 }
 
 void Logger::setLogLevel(LogLevel level) {
     std::lock_guard<std::mutex> lock(log_mutex_);
     config_.min_level = level;
+    setEnabledLevel(level);
 }
 
 void Logger::setGlobalLogger(std::shared_ptr<Logger> logger) {
@@ -221,8 +299,15 @@ std::shared_ptr<Logger> Logger::getGlobalLogger() {
 }
 
 void Logger::setConfig(const LogConfig& config) {
-    std::lock_guard<std::mutex> lock(log_mutex_);
-    config_ = config;
+    stopAsync();
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        config_ = config;
+        setEnabledLevel(config_.min_level);
+    }
+    if (config_.async) {
+        startAsync();
+    }
 }
 
 const Logger::LogConfig& Logger::getConfig() const {
@@ -248,8 +333,14 @@ void Logger::writeToConsole(const std::string& formatted_message) {
     std::cout << formatted_message << std::endl;
 }
 
-std::string Logger::formatMessage(LogLevel level, const std::string& message, const std::string& context) {
-    auto now = std::chrono::system_clock::now();
+std::string Logger::formatLine(LogLevel level, const std::string& message, const std::string& context,
+                               std::chrono::system_clock::time_point time) {
+    return config_.json_format ? formatJsonMessage(level, message, context, time)
+                               : formatMessage(level, message, context, time);
+}
+
+std::string Logger::formatMessage(LogLevel level, const std::string& message, const std::string& context,
+                                  std::chrono::system_clock::time_point now) {
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -267,8 +358,8 @@ std::string Logger::formatMessage(LogLevel level, const std::string& message, co
     return oss.str();
 }
 
-std::string Logger::formatJsonMessage(LogLevel level, const std::string& message, const std::string& context) {
-    auto now = std::chrono::system_clock::now();
+std::string Logger::formatJsonMessage(LogLevel level, const std::string& message, const std::string& context,
+                                      std::chrono::system_clock::time_point now) {
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -330,7 +421,303 @@ void Logger::rotateLogFile() {
 }
 
 bool Logger::shouldLog(LogLevel level) const {
-    return level >= config_.min_level;
+    return isEnabled(level);
+}
+
+void Logger::startAsync() {
+    bool expected = false;
+    if (!async_running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return;
+    }
+    drain_thread_ = std::thread(&Logger::drainLoop, this);
 }
 
-}
\ No newline at end of file
+void Logger::stopAsync() {
+    if (!async_running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    wake_.notify_one();
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+}
+
+void Logger::flush() {
+    if (!isAsync()) {
+        return;
+    }
+    
+    // Two completed passes after the rings look empty guarantee their records were written
+    while (true) {
+        bool empty = true;
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            for (const auto& producer : rings_) {
+                empty = empty && producer->ring.empty();
+            }
+        }
+        uint64_t pass = drained_passes_.load(std::memory_order_acquire);
+        wake_.notify_one();
+        if (empty) {
+            while (drained_passes_.load(std::memory_order_acquire) < pass + 2 && isAsync()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+Logger::ProducerRing::~ProducerRing() {
+    // Records never drained still own their spilled fields
+    ring.drain(ring.capacity(), [](LogRecord& record) { delete record.overflow; });
+}
+
+Logger::ProducerRing* Logger::producerRing() {
+    for (const auto& [id, ring] : thread_rings.entries) {
+        if (id == instance_id_) {
+            return static_cast<ProducerRing*>(ring.get());
+        }
+    }
+    
+    // First record from this thread: register a fresh ring with the drain thread
+    auto ring = std::make_shared<ProducerRing>(config_.async_queue_size);
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(ring);
+    }
+    thread_rings.entries.emplace_back(instance_id_, ring);
+    thread_rings.retired_flags.push_back(&ring->retired);
+    return ring.get();
+}
+
+void Logger::appendField(std::string& overflow, std::string_view field) {
+    uint16_t prefix = static_cast<uint16_t>(std::min<size_t>(field.size(), std::numeric_limits<uint16_t>::max()));
+    overflow.append(reinterpret_cast<const char*>(&prefix), sizeof(prefix));
+    overflow.append(field.data(), prefix);
+}
+
+void Logger::appendField(LogRecord& record, std::string_view field) {
+    size_t room = LogRecord::TextCapacity - record.text_size;
+    if (room < sizeof(uint16_t)) {
+        record.truncated = true;
+        return;
+    }
+    
+    size_t length = std::min(field.size(), room - sizeof(uint16_t));
+    record.truncated = record.truncated || length < field.size();
+    uint16_t prefix = static_cast<uint16_t>(length);
+    std::memcpy(record.text + record.text_size, &prefix, sizeof(prefix));
+    std::memcpy(record.text + record.text_size + sizeof(prefix), field.data(), length);
+    record.text_size = static_cast<uint16_t>(record.text_size + sizeof(prefix) + length);
+}
+
+void Logger::enqueue(LogLevel level, RecordFormat format,
+                     std::initializer_list<uint64_t> args,
+                     std::initializer_list<std::string_view> fields,
+                     const std::vector<std::pair<std::string, std::string>>* metrics) {
+    ProducerRing* producer = producerRing();
+    LogRecord* record = producer->ring.claim();
+    if (!record) {
+        dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    record->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record->level = level;
+    record->format = format;
+    record->truncated = false;
+    std::copy(args.begin(), args.end(), record->args);
+    
+    record->text_size = 0;
+    record->overflow = nullptr;
+    
+    size_t needed = 0;
+    for (std::string_view field : fields) {
+        needed += sizeof(uint16_t) + field.size();
+    }
+    if (metrics) {
+        for (const auto& [key, value] : *metrics) {
+            needed += 2 * sizeof(uint16_t) + key.size() + value.size();
+        }
+    }
+    
+    // Rare long lines spill whole to the heap rather than being cut
+    auto append = [record](std::string_view field) {
+        if (record->overflow) {
+            record->truncated = record->truncated || field.size() > std::numeric_limits<uint16_t>::max();
+            appendField(*record->overflow, field);
+        } else {
+            appendField(*record, field);
+        }
+    };
+    if (needed > LogRecord::TextCapacity) {
+        record->overflow = new std::string();
+        record->overflow->reserve(needed);
+    }
+    for (std::string_view field : fields) {
+        append(field);
+    }
+    if (metrics) {
+        for (const auto& [key, value] : *metrics) {
+            append(key);
+            append(value);
+        }
+    }
+    
+    producer->ring.commit();
+}
+
+std::string Logger::renderRecord(const LogRecord& record) {
+    // The rendered line owns nothing from here on
+    std::unique_ptr<std::string> overflow(record.overflow);
+    const char* text = overflow ? overflow->data() : record.text;
+    size_t text_size = overflow ? overflow->size() : record.text_size;
+    
+    // Unpack the length-prefixed fields
+    std::vector<std::string_view> fields;
+    size_t pos = 0;
+    while (pos + sizeof(uint16_t) <= text_size) {
+        uint16_t length;
+        std::memcpy(&length, text + pos, sizeof(length));
+        fields.emplace_back(text + pos + sizeof(length), length);
+        pos += sizeof(length) + length;
+    }
+    auto field = [&](size_t index) {
+        return index < fields.size() ? fields[index] : std::string_view{};
+    };
+    
+    std::string message;
+    std::string context;
+    switch (record.format) {
+        case RecordFormat::Text:
+            context = std::string(field(0));
+            message = std::string(field(1));
+            break;
+        case RecordFormat::Performance: {
+            std::vector<std::pair<std::string, std::string>> metrics;
+            for (size_t i = 1; i + 1 < fields.size(); i += 2) {
+                metrics.emplace_back(std::string(fields[i]), std::string(fields[i + 1]));
+            }
+            message = renderPerformance(field(0), record.args[0], metrics);
+            context = "PERF";
+            break;
+        }
+        case RecordFormat::Throughput:
+            message = renderThroughput(field(0), record.args[0], record.args[1]);
+            context = "THROUGHPUT";
+            break;
+        case RecordFormat::LatencyStats:
+            message = renderLatencyStats(field(0), record.args[0], record.args[1], record.args[2]);
+            context = "LATENCY";
+            break;
+        case RecordFormat::MemoryUsage:
+            message = renderMemoryUsage(field(0), record.args[0], record.args[1]);
+            context = "MEMORY";
+            break;
+    }
+    
+    if (record.truncated) {
+        message += "...";
+    }
+    
+    std::chrono::system_clock::time_point time{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(record.timestamp_ns))};
+    return formatLine(record.level, message, context, time);
+}
+
+void Logger::writeRecords(std::vector<LogRecord>& records) {
+    // Rings are drained one after another; restore time order across threads
+    std::stable_sort(records.begin(), records.end(),
+                     [](const LogRecord& a, const LogRecord& b) { return a.timestamp_ns < b.timestamp_ns; });
+    
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    
+    std::string console_batch;
+    bool file_open = file_stream_ && file_stream_->is_open();
+    
+    for (const LogRecord& record : records) {
+        std::string line = renderRecord(record);
+        
+        if (config_.console_output) {
+            console_batch += line;
+            console_batch += '\n';
+        }
+        
+        if (file_open) {
+            *file_stream_ << line << '\n';
+            current_file_size_ += line.length() + 1;
+            if (current_file_size_ > config_.max_file_size) {
+                rotateLogFile();
+                file_open = file_stream_ && file_stream_->is_open();
+            }
+        }
+    }
+    
+    if (!console_batch.empty()) {
+        std::cout << console_batch << std::flush;
+    }
+    if (file_open) {
+        file_stream_->flush();
+    }
+}
+
+void Logger::drainLoop() {
+    std::vector<LogRecord> batch;
+    std::vector<std::shared_ptr<ProducerRing>> producers;
+    uint64_t reported_drops = 0;
+    
+    while (true) {
+        bool stopping = !async_running_.load(std::memory_order_acquire);
+        
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            // Forget rings whose producer thread has exited and that are fully drained
+            rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                        [](const std::shared_ptr<ProducerRing>& producer) {
+                                            return producer->retired.load(std::memory_order_acquire) &&
+                                                   producer->ring.empty();
+                                        }),
+                         rings_.end());
+            producers = rings_;
+        }
+        
+        for (const auto& producer : producers) {
+            producer->ring.drain(MaxDrainBatch, [&batch](LogRecord& record) {
+                batch.push_back(record);
+            });
+        }
+        
+        uint64_t drops = dropped_records_.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            LogRecord notice;
+            notice.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            notice.level = LogLevel::WARN;
+            appendField(notice, "Logger");
+            appendField(notice, "Dropped " + std::to_string(drops - reported_drops) + 
+                                " log records (async queue full)");
+            batch.push_back(notice);
+            reported_drops = drops;
+        }
+        
+        if (!batch.empty()) {
+            writeRecords(batch);
+            batch.clear();
+            drained_passes_.fetch_add(1, std::memory_order_release);
+            continue;
+        }
+        
+        drained_passes_.fetch_add(1, std::memory_order_release);
+        if (stopping) {
+            break;
+        }
+        
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait_for(lock, std::chrono::milliseconds(config_.async_flush_interval_ms));
+    }
+}
+
+}
@@ -0,0 +1,279 @@
+#include "orderbook/Utilities/MemoryArena.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace orderbook {
+
+namespace {
+
+constexpr size_t SmallPage = 4096;
+constexpr size_t HugePage2MB = size_t{1} << 21;
+constexpr size_t HugePage1GB = size_t{1} << 30;
+
+size_t pageSizeOf(MemoryArena::PageMode mode) {
+    switch (mode) {
+        case MemoryArena::PageMode::Huge1GB: return HugePage1GB;
+        case MemoryArena::PageMode::Huge2MB: return HugePage2MB;
+        case MemoryArena::PageMode::Transparent: return HugePage2MB;
+        case MemoryArena::PageMode::Normal: break;
+    }
+    return SmallPage;
+}
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifdef __linux__
+
+// From <linux/mempolicy.h>; spelled out so libnuma headers are not needed
+constexpr int MpolPreferred = 1;
+constexpr int HugeShift = 26;       // MAP_HUGE_SHIFT
+
+void* mapHugeTlb(size_t bytes, int page_shift) {
+    void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (page_shift << HugeShift), -1, 0);
+    return base == MAP_FAILED ? nullptr : base;
+}
+
+// Over-maps and trims so the chunk starts on a 2MB boundary the kernel can back with one huge page
+void* mapAligned(size_t bytes, size_t alignment) {
+    size_t span = bytes + alignment;
+    void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (start + alignment - 1) & ~(alignment - 1);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    size_t tail = (start + span) - (aligned + bytes);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+bool bindToNode(void* base, size_t bytes, int node) {
+    constexpr size_t MaskBits = sizeof(unsigned long) * 8;
+    if (node < 0 || static_cast<size_t>(node) >= MaskBits * 16) {
+        return false;
+    }
+    unsigned long mask[16] = {};
+    mask[node / MaskBits] = 1UL << (node % MaskBits);
+    // Preferred rather than strict binding: a full node spills instead of failing the fault
+    return syscall(SYS_mbind, base, bytes, MpolPreferred, mask, MaskBits * 16 + 1, 0) == 0;
+}
+
+#endif
+
+}
+
+MemoryArena::GlobalStats MemoryArena::global_stats_;
+
+MemoryArena::MemoryArena(const ArenaConfig& config)
+    : config_(config), backing_(config.pages) {
+}
+
+MemoryArena::~MemoryArena() {
+    for (const Chunk& chunk : chunks_) {
+#ifdef __linux__
+        if (chunk.mapped) {
+            munmap(chunk.base, chunk.bytes);
+            continue;
+        }
+#endif
+        std::free(chunk.base);
+    }
+    global_stats_.mapped_bytes.fetch_sub(mapped_bytes_, std::memory_order_relaxed);
+}
+
+void* MemoryArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+
+    // Exact-size reuse first; blocks are only ever returned by containers re-growing
+    for (size_t i = 0; i < free_blocks_.size(); ++i) {
+        if (free_blocks_[i].bytes == bytes &&
+            reinterpret_cast<uintptr_t>(free_blocks_[i].ptr) % alignment == 0) {
+            void* ptr = free_blocks_[i].ptr;
+            free_blocks_[i] = free_blocks_.back();
+            free_blocks_.pop_back();
+            return ptr;
+        }
+    }
+
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    if (!cursor_ || aligned + bytes > reinterpret_cast<uintptr_t>(limit_)) {
+        if (!mapChunk(bytes + alignment)) {
+            return nullptr;
+        }
+        aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    }
+
+    cursor_ = reinterpret_cast<char*>(aligned + bytes);
+    used_bytes_ += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void MemoryArena::deallocate(void* ptr, size_t bytes) {
+    if (ptr) {
+        free_blocks_.push_back(FreeBlock{ptr, bytes == 0 ? 1 : bytes});
+    }
+}
+
+bool MemoryArena::mapChunk(size_t min_bytes) {
+    size_t wanted = std::max(min_bytes, config_.chunk_bytes);
+    void* base = nullptr;
+    size_t bytes = 0;
+    bool mapped = true;
+    PageMode backing = config_.pages;
+
+#ifdef __linux__
+    // Explicit huge pages need a reserved hugetlb pool; step down when it is empty
+    if (backing == PageMode::Huge1GB) {
+        bytes = roundUp(wanted, HugePage1GB);
+        base = mapHugeTlb(bytes, 30);
+        if (!base) {
+            backing = PageMode::Huge2MB;
+        }
+    }
+    if (!base && backing == PageMode::Huge2MB) {
+        bytes = roundUp(wanted, HugePage2MB);
+        base = mapHugeTlb(bytes, 21);
+        if (!base) {
+            backing = PageMode::Transparent;
+        }
+    }
+    if (!base && backing == PageMode::Transparent) {
+        bytes = roundUp(wanted, HugePage2MB);
+        base = mapAligned(bytes, HugePage2MB);
+        if (base && madvise(base, bytes, MADV_HUGEPAGE) != 0) {
+            backing = PageMode::Normal;     // THP disabled or unsupported; the mapping is still usable
+        }
+    }
+    if (!base) {
+        backing = PageMode::Normal;
+        bytes = roundUp(wanted, SmallPage);
+        void* raw = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        base = raw == MAP_FAILED ? nullptr : raw;
+    }
+
+    // Bound before the first touch, which is what actually places the pages
+    if (base && config_.numa_node >= 0 && !bindToNode(base, bytes, config_.numa_node)) {
+        global_stats_.numa_bind_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    backing = PageMode::Normal;
+    bytes = roundUp(wanted, SmallPage);
+    base = std::aligned_alloc(SmallPage, bytes);
+    mapped = false;
+#endif
+
+    if (!base) {
+        return false;
+    }
+
+    if (config_.prefault) {
+        size_t stride = pageSizeOf(backing);
+        for (size_t offset = 0; offset < bytes; offset += stride) {
+            static_cast<volatile char*>(base)[offset] = 0;
+        }
+    }
+
+    if (backing != config_.pages) {
+        global_stats_.fallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (backing == PageMode::Huge1GB || backing == PageMode::Huge2MB) {
+        global_stats_.explicit_huge_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else if (backing == PageMode::Transparent) {
+        global_stats_.transparent_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    global_stats_.mapped_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    chunks_.push_back(Chunk{base, bytes, mapped});
+    backing_ = backing;
+    mapped_bytes_ += bytes;
+    cursor_ = static_cast<char*>(base);
+    limit_ = cursor_ + bytes;
+    return true;
+}
+
+int MemoryArena::nodeOfCpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) {
+        return -1;
+    }
+    // Each CPU directory links to its node as "nodeN"
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return -1;
+    }
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+int MemoryArena::currentNode() {
+#ifdef __linux__
+    return nodeOfCpu(sched_getcpu());
+#else
+    return -1;
+#endif
+}
+
+MemoryArena::PageMode MemoryArena::parsePageMode(const std::string& name) {
+    if (name == "2mb") return PageMode::Huge2MB;
+    if (name == "1gb") return PageMode::Huge1GB;
+    if (name == "none" || name == "off") return PageMode::Normal;
+    return PageMode::Transparent;
+}
+
+const char* MemoryArena::pageModeName(PageMode mode) {
+    switch (mode) {
+        case PageMode::Normal: return "none";
+        case PageMode::Transparent: return "transparent";
+        case PageMode::Huge2MB: return "2mb";
+        case PageMode::Huge1GB: return "1gb";
+    }
+    return "none";
+}
+
+MemoryArena::ArenaConfig MemoryArena::loadConfiguration(std::shared_ptr<Config> config) {
+    ArenaConfig arena;
+    if (!config) {
+        return arena;
+    }
+    arena.enabled = config->getBool("memory", "arenas", arena.enabled);
+    arena.pages = parsePageMode(config->getString("memory", "huge_pages", pageModeName(arena.pages)));
+    arena.numa_node = config->getInt("memory", "numa_node", arena.numa_node);
+    arena.chunk_bytes = static_cast<size_t>(config->getInt("memory", "arena_chunk_kb",
+                                                           static_cast<int>(arena.chunk_bytes / 1024))) * 1024;
+    arena.prefault = config->getBool("memory", "prefault", arena.prefault);
+    return arena;
+}
+
+}
@@ -0,0 +1,111 @@
+#include "orderbook/Utilities/Metrics.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace orderbook {
+
+namespace {
+
+void appendEscaped(std::string& out, std::string_view text, bool label_value) {
+    for (char c : text) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '"':
+                if (label_value) {
+                    out += "\\\"";
+                    break;
+                }
+                [[fallthrough]];
+            default: out += c; break;
+        }
+    }
+}
+
+void appendValue(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        out.append(buffer, static_cast<size_t>(length));
+    }
+}
+
+}
+
+void MetricsWriter::sample(std::string_view type, std::string_view name, std::string_view help,
+                           double value, Labels labels) {
+    std::string full_name(Prefix);
+    full_name += name;
+
+    auto [it, added] = index_.try_emplace(full_name, families_.size());
+    if (added) {
+        Family family;
+        family.name = full_name;
+        family.header = "# HELP " + full_name + " ";
+        appendEscaped(family.header, help, false);
+        family.header += "\n# TYPE " + full_name + " ";
+        family.header += type;
+        family.header += '\n';
+        families_.push_back(std::move(family));
+    }
+
+    std::string& out = families_[it->second].samples;
+    out += full_name;
+    if (labels.size() > 0) {
+        out += '{';
+        bool first = true;
+        for (const auto& [label, label_value] : labels) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            out += label;
+            out += "=\"";
+            appendEscaped(out, label_value, true);
+            out += '"';
+        }
+        out += '}';
+    }
+    out += ' ';
+    appendValue(out, value);
+    out += '\n';
+}
+
+std::string MetricsWriter::str() const {
+    std::string out;
+    for (const auto& family : families_) {
+        out += family.header;
+        out += family.samples;
+    }
+    return out;
+}
+
+void MetricsWriter::clear() {
+    families_.clear();
+    index_.clear();
+}
+
+void MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors_.push_back(std::move(collector));
+}
+
+std::string MetricsRegistry::scrape() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MetricsWriter writer;
+    for (const auto& collector : collectors_) {
+        collector(writer);
+    }
+    return writer.str();
+}
+
+size_t MetricsRegistry::getCollectorCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return collectors_.size();
+}
+
+}
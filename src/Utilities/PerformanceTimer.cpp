@@ -6,8 +6,16 @@ namespace orderbook {
 PerformanceTimer::PerformanceTimer(const std::string& operation_name, 
                                  std::shared_ptr<ILogger> logger)
     : operation_name_(operation_name)
-    , logger_(logger)
-    , start_time_(std::chrono::high_resolution_clock::now())
+    , logger_(std::move(logger))
+    , start_ticks_(TscClock::ticks())
+    , logged_(false) {
+}
+
+PerformanceTimer::PerformanceTimer(const char* operation_name,
+                                 std::shared_ptr<ILogger> logger)
+    : operation_literal_(operation_name)
+    , logger_(std::move(logger))
+    , start_ticks_(TscClock::ticks())
     , logged_(false) {
 }
 
@@ -18,9 +26,7 @@ PerformanceTimer::~PerformanceTimer() {
 }
 
 uint64_t PerformanceTimer::getElapsedNs() const {
-    auto end_time = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        end_time - start_time_).count();
+    return static_cast<uint64_t>(TscClock::toNanoseconds(TscClock::ticks() - start_ticks_));
 }
 
 void PerformanceTimer::stopAndLog() {
@@ -29,7 +35,11 @@ void PerformanceTimer::stopAndLog() {
     }
     
     uint64_t elapsed_ns = getElapsedNs();
-    logger_->logPerformance(operation_name_, elapsed_ns, additional_metrics_);
+    if (operation_literal_) {
+        logger_->logPerformance(operation_literal_, elapsed_ns, additional_metrics_);
+    } else {
+        logger_->logPerformance(operation_name_, elapsed_ns, additional_metrics_);
+    }
     logged_ = true;
 }
 
@@ -0,0 +1,488 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Network/FixEncoder.hpp"
+#include "orderbook/Network/FixMessageView.hpp"
+#include "orderbook/Network/FixParser.hpp"
+#include "orderbook/Utilities/Benchmark.hpp"
+#include "orderbook/Utilities/ObjectPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Books are centred on 100.00 with a 0.01 tick: level 0 is the touch,
+// level n the n-th price away from it on its side
+constexpr int64_t MidTicks = 10000;
+constexpr Quantity LevelQuantity = 100;
+
+// Resting orders added, cancelled or modified between untimed refills
+constexpr size_t Batch = 4096;
+
+const char* BenchSymbol = "BENCH";
+
+Price levelPrice(Side side, int64_t level) {
+    int64_t ticks = side == Side::Buy ? MidTicks - 1 - level : MidTicks + 1 + level;
+    return static_cast<double>(ticks) / 100.0;
+}
+
+/**
+ * @brief A default-configured book with no risk, market data or logging
+ */
+struct BookFixture {
+    OrderBook book;
+    SymbolId symbol;
+    AccountId account;
+    uint64_t next_id = 1;
+
+    BookFixture()
+        : book(nullptr, nullptr, nullptr, makeConfig()),
+          symbol(InternTable::symbols().intern(BenchSymbol)),
+          account(InternTable::accounts().intern("BENCH_ACCOUNT")) {}
+
+    static OrderBook::BookConfig makeConfig() {
+        OrderBook::BookConfig config;
+        config.symbol = BenchSymbol;
+        return config;
+    }
+
+    Order limit(Side side, Price price, Quantity quantity) {
+        return Order(next_id++, side, OrderType::Limit, TimeInForce::GTC, price, quantity, symbol, account);
+    }
+
+    // One resting order per level on both sides, so every benchmark starts at `depth`
+    void fill(int64_t depth) {
+        for (int64_t level = 0; level < depth; ++level) {
+            book.addOrder(limit(Side::Buy, levelPrice(Side::Buy, level), LevelQuantity));
+            book.addOrder(limit(Side::Sell, levelPrice(Side::Sell, level), LevelQuantity));
+        }
+    }
+
+    // Passive bids spread over the book's levels in a fixed random order
+    std::vector<OrderId> restBatch(const std::vector<int64_t>& levels) {
+        std::vector<OrderId> ids;
+        ids.reserve(levels.size());
+        for (int64_t level : levels) {
+            Order order = limit(Side::Buy, levelPrice(Side::Buy, level), LevelQuantity);
+            ids.push_back(order.id);
+            book.addOrder(order);
+        }
+        return ids;
+    }
+};
+
+std::vector<int64_t> randomLevels(int64_t depth, size_t count) {
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int64_t> pick(0, depth - 1);
+    std::vector<int64_t> levels(count);
+    for (auto& level : levels) {
+        level = pick(random);
+    }
+    return levels;
+}
+
+// Book operations
+
+void BM_AddOrder(BenchmarkState& state) {
+    BookFixture fixture;
+    fixture.fill(state.range(0));
+    std::vector<int64_t> levels = randomLevels(state.range(0), Batch);
+    std::vector<OrderId> added;
+    added.reserve(Batch);
+
+    size_t next = 0;
+    while (state.keepRunning()) {
+        Order order = fixture.limit(Side::Buy, levelPrice(Side::Buy, levels[next]), LevelQuantity);
+        added.push_back(order.id);
+        doNotOptimize(fixture.book.addOrder(order));
+        if (++next == Batch) {
+            state.pauseTiming();
+            for (OrderId id : added) {
+                fixture.book.cancelOrder(id);
+            }
+            added.clear();
+            next = 0;
+            state.resumeTiming();
+        }
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_CancelOrder(BenchmarkState& state) {
+    BookFixture fixture;
+    fixture.fill(state.range(0));
+    std::vector<int64_t> levels = randomLevels(state.range(0), Batch);
+    std::vector<OrderId> resting = fixture.restBatch(levels);
+
+    // Cancel in an order unrelated to arrival, so cancels hit every queue position
+    std::vector<size_t> order(Batch);
+    for (size_t i = 0; i < Batch; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(7));
+
+    size_t next = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(fixture.book.cancelOrder(resting[order[next]]));
+        if (++next == Batch) {
+            state.pauseTiming();
+            resting = fixture.restBatch(levels);
+            next = 0;
+            state.resumeTiming();
+        }
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// range(1): 0 moves each order to the next level and back, 1 toggles its
+// quantity down and back up at the same price
+void BM_ModifyOrder(BenchmarkState& state) {
+    int64_t depth = state.range(0);
+    bool quantity_only = state.range(1) != 0;
+    BookFixture fixture;
+    fixture.fill(depth);
+    std::vector<int64_t> levels = randomLevels(depth, Batch);
+    std::vector<OrderId> resting = fixture.restBatch(levels);
+    std::vector<bool> moved(Batch, false);
+
+    size_t next = 0;
+    while (state.keepRunning()) {
+        bool away = !moved[next];
+        moved[next] = away;
+        Price price = quantity_only ? levelPrice(Side::Buy, levels[next])
+                                    : levelPrice(Side::Buy, (levels[next] + (away ? 1 : 0)) % depth);
+        Quantity quantity = quantity_only && away ? LevelQuantity / 2 : LevelQuantity;
+        doNotOptimize(fixture.book.modifyOrder(resting[next], price, quantity));
+        if (++next == Batch) {
+            next = 0;
+        }
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// One aggressive buy takes a single order at each of range(0) ask levels
+void BM_SweepLevels(BenchmarkState& state) {
+    int64_t levels = state.range(0);
+    BookFixture fixture;
+    auto rebuild = [&fixture, levels]() {
+        for (int64_t level = 0; level < levels; ++level) {
+            fixture.book.addOrder(fixture.limit(Side::Sell, levelPrice(Side::Sell, level), LevelQuantity));
+        }
+    };
+    rebuild();
+
+    MatchResult result;
+    Price limit_price = levelPrice(Side::Sell, levels - 1);
+    Quantity quantity = LevelQuantity * static_cast<Quantity>(levels);
+    size_t trades = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(fixture.book.addOrder(fixture.limit(Side::Buy, limit_price, quantity), result));
+        trades += result.getTradeCount();
+        state.pauseTiming();
+        rebuild();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("trades_per_sweep", static_cast<double>(trades) / static_cast<double>(state.iterations()));
+}
+
+// FIX
+
+std::string frameFix(const std::string& body) {
+    using namespace fix;
+    std::string message = std::string("8=") + BEGIN_STRING_44 + FIELD_DELIMITER +
+                          "9=" + std::to_string(body.size()) + FIELD_DELIMITER + body;
+    unsigned checksum = 0;
+    for (char c : message) {
+        checksum += static_cast<unsigned char>(c);
+    }
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u", checksum % 256);
+    return message + trailer + FIELD_DELIMITER;
+}
+
+std::string sampleNewOrderSingle() {
+    std::string body = "35=D|49=CLIENT|56=ORDERBOOK|34=1024|52=20261014-09:30:00.123|11=CL000001234|1=ACCT01|"
+                       "55=BENCH|54=1|38=100|40=2|44=100.25|59=0|60=20261014-09:30:00.123|";
+    std::replace(body.begin(), body.end(), '|', fix::FIELD_DELIMITER);
+    return frameFix(body);
+}
+
+FixMessageParser::ExecutionReport sampleExecutionReport() {
+    FixMessageParser::ExecutionReport report;
+    report.orderId = "1234";
+    report.clOrdId = "CL000001234";
+    report.execId = "E000000005678";
+    report.execType = fix::EXEC_TYPE_PARTIAL_FILL;
+    report.ordStatus = fix::ORD_STATUS_PARTIALLY_FILLED;
+    report.symbol = BenchSymbol;
+    report.side = Side::Buy;
+    report.orderQty = 100;
+    report.price = 100.25;
+    report.lastQty = 40;
+    report.lastPx = 100.25;
+    report.leavesQty = 60;
+    report.cumQty = 40;
+    report.avgPx = 100.25;
+    report.transactTime = std::chrono::system_clock::now();
+    return report;
+}
+
+void BM_FixParseMessage(BenchmarkState& state) {
+    FixMessageParser parser;
+    std::string raw = sampleNewOrderSingle();
+    while (state.keepRunning()) {
+        doNotOptimize(parser.parseMessage(raw));
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * raw.size());
+}
+
+// Zero-copy view plus order decoding, as the session and gateway do it
+void BM_FixParseView(BenchmarkState& state) {
+    FixMessageParser parser;
+    FixMessageView view;
+    std::string raw = sampleNewOrderSingle();
+    while (state.keepRunning()) {
+        bool parsed = parser.parseMessage(raw, view);
+        doNotOptimize(parsed);
+        doNotOptimize(parser.parseNewOrderSingle(view));
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * raw.size());
+}
+
+void BM_FixGenerateExecutionReport(BenchmarkState& state) {
+    FixMessageParser parser;
+    FixMessageParser::ExecutionReport report = sampleExecutionReport();
+    SequenceNumber sequence = 1;
+    size_t bytes = 0;
+    while (state.keepRunning()) {
+        std::string message = parser.generateExecutionReport(report, "ORDERBOOK", "CLIENT", sequence++);
+        bytes += message.size();
+        doNotOptimize(message);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(bytes);
+}
+
+void BM_FixEncodeExecutionReport(BenchmarkState& state) {
+    FixEncoder encoder("ORDERBOOK", "CLIENT");
+    FixMessageParser::ExecutionReport report = sampleExecutionReport();
+    std::string buffer;
+    SequenceNumber sequence = 1;
+    size_t bytes = 0;
+    while (state.keepRunning()) {
+        std::string_view message = encoder.encodeExecutionReport(report, sequence++, buffer);
+        bytes += message.size();
+        doNotOptimize(message);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(bytes);
+}
+
+// Market data
+
+class CountingSubscriber : public IMarketDataSubscriber {
+public:
+    void onTrade(const Trade&, SequenceNumber) override { ++events_; }
+    void onBookUpdate(const BookUpdate&) override { ++events_; }
+    void onBestPrices(const BestPrices&, SequenceNumber) override { ++events_; }
+    void onDepth(const MarketDepth&, SequenceNumber) override { ++events_; }
+
+    uint64_t getEvents() const { return events_; }
+
+private:
+    uint64_t events_ = 0;
+};
+
+std::vector<std::shared_ptr<CountingSubscriber>> subscribe(MarketDataPublisher& publisher, int64_t count) {
+    std::vector<std::shared_ptr<CountingSubscriber>> subscribers;
+    for (int64_t i = 0; i < count; ++i) {
+        subscribers.push_back(std::make_shared<CountingSubscriber>());
+        publisher.subscribe(subscribers.back());
+    }
+    return subscribers;
+}
+
+void BM_PublishTrade(BenchmarkState& state) {
+    MarketDataPublisher publisher;
+    auto subscribers = subscribe(publisher, state.range(0));
+    Trade trade(1, OrderId(1), OrderId(2), 100.25, 40, InternTable::symbols().intern(BenchSymbol));
+    while (state.keepRunning()) {
+        publisher.publishTrade(trade);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_PublishBookUpdate(BenchmarkState& state) {
+    MarketDataPublisher publisher;
+    auto subscribers = subscribe(publisher, state.range(0));
+    BookUpdate update(BookUpdate::Type::Modify, Side::Buy, 99.99, 300, 3, 1,
+                      InternTable::symbols().intern(BenchSymbol));
+    while (state.keepRunning()) {
+        publisher.publishBookUpdate(update);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// Object pools: the timed thread acquires and releases while range(0) - 1
+// other threads do the same on the same pool
+
+template<typename Pool>
+void poolContention(BenchmarkState& state) {
+    Pool pool(4096);
+    int64_t others = state.range(0) - 1;
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> started{0};
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < others; ++i) {
+        threads.emplace_back([&pool, &stop, &started]() {
+            started.fetch_add(1, std::memory_order_relaxed);
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto object = pool.acquire();
+                doNotOptimize(object.get());
+            }
+        });
+    }
+    while (started.load(std::memory_order_relaxed) < others) {
+        std::this_thread::yield();
+    }
+
+    while (state.keepRunning()) {
+        auto object = pool.acquire();
+        doNotOptimize(object.get());
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_ObjectPool(BenchmarkState& state) {
+    poolContention<ObjectPool<Order>>(state);
+}
+
+void BM_LockFreeObjectPool(BenchmarkState& state) {
+    poolContention<LockFreeObjectPool<Order>>(state);
+}
+
+}
+
+ORDERBOOK_BENCHMARK(BM_AddOrder)->argNames({"depth"})->argValues({1, 10, 100, 1000});
+ORDERBOOK_BENCHMARK(BM_CancelOrder)->argNames({"depth"})->argValues({1, 10, 100, 1000});
+ORDERBOOK_BENCHMARK(BM_ModifyOrder)->argNames({"depth", "quantity_only"})
+    ->args({10, 0})->args({100, 0})->args({1000, 0})
+    ->args({10, 1})->args({100, 1})->args({1000, 1});
+ORDERBOOK_BENCHMARK(BM_SweepLevels)->argNames({"levels"})->argValues({1, 5, 10, 50, 100});
+ORDERBOOK_BENCHMARK(BM_FixParseMessage);
+ORDERBOOK_BENCHMARK(BM_FixParseView);
+ORDERBOOK_BENCHMARK(BM_FixGenerateExecutionReport);
+ORDERBOOK_BENCHMARK(BM_FixEncodeExecutionReport);
+ORDERBOOK_BENCHMARK(BM_PublishTrade)->argNames({"subscribers"})->argValues({0, 1, 4, 16, 64});
+ORDERBOOK_BENCHMARK(BM_PublishBookUpdate)->argNames({"subscribers"})->argValues({0, 1, 4, 16, 64});
+ORDERBOOK_BENCHMARK(BM_ObjectPool)->argNames({"threads"})->argValues({1, 2, 4, 8});
+ORDERBOOK_BENCHMARK(BM_LockFreeObjectPool)->argNames({"threads"})->argValues({1, 2, 4, 8});
+
+/**
+ * @brief Microbenchmarks for the order book's hot paths
+ * Each benchmark instance is timed over enough iterations to last
+ * --min-time; results print as a table and, with --json, are written in
+ * Google Benchmark's JSON layout so runs can be compared over time.
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkRunner::RunnerConfig config;
+    std::string json_path;
+    bool list_only = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            config.min_time = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            config.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--list") {
+            list_only = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options]\n";
+            std::cout << "Options:\n";
+            std::cout << "  --filter REGEX       Run only benchmarks whose name matches (default: all)\n";
+            std::cout << "  --min-time SECONDS   Minimum duration of each reported run (default: 0.5)\n";
+            std::cout << "  --repetitions N      Repeat each benchmark N times and add mean, median\n";
+            std::cout << "                       and stddev aggregates (default: 1)\n";
+            std::cout << "  --json FILE          Also write results as JSON ('-' = stdout only)\n";
+            std::cout << "  --list               List benchmark names and exit\n";
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (config.min_time <= 0.0) {
+        std::cerr << "--min-time must be positive\n";
+        return 1;
+    }
+
+    BenchmarkRunner runner(config);
+    auto names = runner.list();
+    if (names.isError()) {
+        std::cerr << names.error() << "\n";
+        return 1;
+    }
+    if (list_only) {
+        for (const auto& name : names.value()) {
+            std::cout << name << "\n";
+        }
+        return 0;
+    }
+
+    // Calibrate before anything is timed
+    TscClock::calibrate();
+
+    bool console = json_path != "-";
+    if (console) {
+        BenchmarkRunner::printConsoleHeader();
+    }
+    auto runs = runner.runAll(console ? BenchmarkRunner::printConsoleRun : nullptr);
+    if (runs.isError()) {
+        std::cerr << runs.error() << "\n";
+        return 1;
+    }
+
+    if (!json_path.empty()) {
+        std::string json = BenchmarkRunner::toJson(runs.value(), argv[0]);
+        if (json_path == "-") {
+            std::cout << json;
+        } else {
+            std::ofstream out(json_path);
+            if (!out || !(out << json)) {
+                std::cerr << "Cannot write " << json_path << "\n";
+                return 1;
+            }
+        }
+    }
+
+    for (const auto& run : runs.value()) {
+        if (!run.error.empty()) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "orderbook/Core/MatchingRuntime.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Network/FixLoadGenerator.hpp"
+#include "orderbook/Network/FixServer.hpp"
+#include "orderbook/Network/IoContextPool.hpp"
+#include "orderbook/Risk/RiskManager.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace orderbook;
+
+namespace {
+
+void printHeader() {
+    std::printf("%-10s %10s %9s %9s %9s %9s %9s %9s %9s %9s\n", "", "count", "min", "p50", "p90", "p99",
+                "p99.9", "p99.99", "max", "mean");
+}
+
+void printRow(const char* name, const LatencyHistogram& histogram) {
+    std::printf("%-10s %10llu %9llu %9llu %9llu %9llu %9llu %9llu %9llu %9.0f\n", name,
+                static_cast<unsigned long long>(histogram.count()),
+                static_cast<unsigned long long>(histogram.min()),
+                static_cast<unsigned long long>(histogram.percentile(50.0)),
+                static_cast<unsigned long long>(histogram.percentile(90.0)),
+                static_cast<unsigned long long>(histogram.percentile(99.0)),
+                static_cast<unsigned long long>(histogram.percentile(99.9)),
+                static_cast<unsigned long long>(histogram.percentile(99.99)),
+                static_cast<unsigned long long>(histogram.max()), histogram.mean());
+}
+
+void printBuckets(const char* name, const LatencyHistogram& histogram) {
+    std::cout << name << " buckets (upper bound ns, count):\n";
+    histogram.forEachBucket([](uint64_t upper, uint64_t count) {
+        std::cout << "  " << upper << " " << count << "\n";
+    });
+}
+
+// Each session is a socket on both ends when the server runs in-process
+void raiseFileLimit(size_t descriptors) {
+#ifndef _WIN32
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < descriptors) {
+        limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, descriptors);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#else
+    (void)descriptors;
+#endif
+}
+
+}
+
+/**
+ * @brief FIX tick-to-trade load generator
+ * Opens many FIX sessions against an order-entry server (or one started
+ * in-process), sends New Order Singles at a fixed rate and reports
+ * round-trip and tick-to-trade latency percentiles (nanoseconds), split into
+ * server stages when the server traces latency.
+ */
+int main(int argc, char* argv[]) {
+    std::string config_file = "config/orderbook.cfg";
+    std::string host;
+    long port = -1;
+    long sessions = -1;
+    double rate = 0.0;
+    double duration = -1.0;
+    double warmup = -1.0;
+    long threads = -1;
+    std::string symbol;
+    bool buckets = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--config" || arg == "-c") && i + 1 < argc) {
+            config_file = argv[++i];
+        } else if (arg == "--host" && i + 1 < argc) {
+            host = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = std::atol(argv[++i]);
+        } else if (arg == "--sessions" && i + 1 < argc) {
+            sessions = std::atol(argv[++i]);
+        } else if (arg == "--rate" && i + 1 < argc) {
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--duration" && i + 1 < argc) {
+            duration = std::atof(argv[++i]);
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            warmup = std::atof(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::atol(argv[++i]);
+        } else if (arg == "--symbol" && i + 1 < argc) {
+            symbol = argv[++i];
+        } else if (arg == "--buckets") {
+            buckets = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options]\n";
+            std::cout << "Options:\n";
+            std::cout << "  -c, --config FILE    Configuration (default: config/orderbook.cfg)\n";
+            std::cout << "  --host HOST          Server to load; without it a server is started in-process\n";
+            std::cout << "                       on a free port with latency tracing on\n";
+            std::cout << "  --port PORT          Server port (default: [network] port)\n";
+            std::cout << "  --sessions N         Concurrent FIX sessions\n";
+            std::cout << "  --rate N             New orders per second across all sessions\n";
+            std::cout << "  --duration SECONDS   Measured sending time\n";
+            std::cout << "  --warmup SECONDS     Sending time before measurement starts\n";
+            std::cout << "  --threads N          Generator IO threads\n";
+            std::cout << "  --symbol SYMBOL      Instrument to trade (default: [orderbook] symbol)\n";
+            std::cout << "  --buckets            Also print the raw histogram buckets\n";
+            std::cout << "Other settings come from the [load_generator] section of the configuration.\n";
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        auto config = std::make_shared<Config>(config_file);
+        FixLoadGenerator::LoadConfig load = FixLoadGenerator::loadConfiguration(config);
+        if (sessions > 0) {
+            load.sessions = static_cast<size_t>(sessions);
+        }
+        if (rate > 0.0) {
+            load.rate = rate;
+        }
+        if (duration >= 0.0) {
+            load.duration_seconds = duration;
+        }
+        if (warmup >= 0.0) {
+            load.warmup_seconds = warmup;
+        }
+        if (threads > 0) {
+            load.io_threads = static_cast<size_t>(threads);
+        }
+        if (!symbol.empty()) {
+            load.symbol = symbol;
+        }
+        if (port >= 0) {
+            load.port = static_cast<uint16_t>(port);
+        }
+        bool embedded = host.empty();
+        raiseFileLimit(load.sessions * (embedded ? 2 : 1) + 256);
+
+        // In-process server: one book for the load's symbol, configured like the server's,
+        // matched on its own shard thread
+        std::unique_ptr<OrderBookRouter> router;
+        std::unique_ptr<MatchingRuntime> runtime;
+        std::shared_ptr<FixOrderGateway> gateway;
+        std::unique_ptr<IoContextPool> server_pool;
+        boost::asio::io_context acceptor_context;
+        std::unique_ptr<FixServer> server;
+        std::thread acceptor_thread;
+        if (embedded) {
+            auto risk_manager = std::make_shared<RiskManager>(config);
+            router = std::make_unique<OrderBookRouter>(risk_manager, nullptr, nullptr);
+            OrderBook::BookConfig book_config = OrderBook::loadConfiguration(config);
+            book_config.symbol = load.symbol;
+            auto added = router->addBook(book_config);
+            if (added.isError()) {
+                std::cerr << "Cannot create book: " << added.error() << "\n";
+                return 1;
+            }
+            runtime = std::make_unique<MatchingRuntime>(*router, nullptr, config);
+            gateway = std::make_shared<FixOrderGateway>(*router, *runtime);
+            runtime->start();
+            server_pool = std::make_unique<IoContextPool>(nullptr, config);
+            server_pool->start();
+            server = std::make_unique<FixServer>(acceptor_context, *server_pool, gateway);
+            server->loadConfiguration(config);
+            server->setLatencyTrace(true);
+            server->start(port >= 0 ? load.port : 0, load.target_comp_id);
+            acceptor_thread = std::thread([&acceptor_context]() { acceptor_context.run(); });
+            load.host = "127.0.0.1";
+            load.port = server->getPort();
+        } else {
+            load.host = host;
+        }
+
+        FixLoadGenerator generator(nullptr, load);
+        auto result = generator.run();
+
+        if (embedded) {
+            server->stop();
+            acceptor_context.stop();
+            acceptor_thread.join();
+            server_pool->stop();
+            runtime->stop();
+        }
+        if (result.isError()) {
+            std::cerr << "Load run failed: " << result.error() << "\n";
+            return 1;
+        }
+        const FixLoadGenerator::Report& report = *result.value();
+
+        std::cout << "\n=== FIX Load Generator ===\n";
+        std::cout << "Target: " << load.host << ":" << load.port << (embedded ? " (in-process server)" : "")
+                  << "  Symbol: " << load.symbol << "\n";
+        std::cout << "Sessions: " << report.sessions << " of " << load.sessions << " logged in  Rate: "
+                  << load.rate << " orders/s  Duration: " << load.duration_seconds << "s after "
+                  << load.warmup_seconds << "s warmup\n\n";
+
+        std::cout << "Latency (ns):\n";
+        printHeader();
+        printRow("ack", report.ack);
+        printRow("fill", report.fill);
+        printRow("scheduled", report.response);
+        std::cout << "ack = send to acknowledgement, fill = send to first fill of orders that traded on\n"
+                  << "arrival, scheduled = acknowledgement measured from when the order was due\n";
+
+        if (report.traced > 0) {
+            std::cout << "\nAcknowledgement stages (ns):\n";
+            printHeader();
+            double total = 0.0;
+            for (int stage = 0; stage < FixLoadGenerator::StageCount; ++stage) {
+                printRow(FixLoadGenerator::stageName(static_cast<FixLoadGenerator::Stage>(stage)),
+                         report.stages[stage]);
+                total += report.stages[stage].mean();
+            }
+            std::cout << "Share of mean round trip:";
+            for (int stage = 0; stage < FixLoadGenerator::StageCount; ++stage) {
+                std::printf(" %s %.1f%%", FixLoadGenerator::stageName(static_cast<FixLoadGenerator::Stage>(stage)),
+                            total > 0.0 ? 100.0 * report.stages[stage].mean() / total : 0.0);
+            }
+            std::cout << "\n";
+            if (!embedded) {
+                std::cout << "inbound and outbound compare two hosts' clocks unless the server is local\n";
+            }
+        } else {
+            std::cout << "\nNo server stage stamps received; enable [network] latency_trace on the server\n";
+        }
+
+        std::cout << "\nSent " << report.sent << " orders, " << report.acknowledged << " acknowledged ("
+                  << static_cast<uint64_t>(report.throughput()) << "/second), " << report.rejected
+                  << " rejected, " << report.traded << " traded on arrival\n";
+        std::cout << "Max lag behind schedule: " << report.max_lag_ns << " ns";
+        if (report.unmatched > 0) {
+            std::cout << "  Untracked responses: " << report.unmatched;
+        }
+        std::cout << "\n";
+
+        if (buckets) {
+            std::cout << "\n";
+            printBuckets("ack", report.ack);
+            printBuckets("fill", report.fill);
+            for (int stage = 0; stage < FixLoadGenerator::StageCount; ++stage) {
+                printBuckets(FixLoadGenerator::stageName(static_cast<FixLoadGenerator::Stage>(stage)),
+                             report.stages[stage]);
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << "\n";
+        return 1;
+    }
+}
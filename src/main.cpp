@@ -1,15 +1,26 @@
 #include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Core/MatchingRuntime.hpp"
 #include "orderbook/Core/Order.hpp"
 #include "orderbook/Risk/RiskManager.hpp"
 #include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "orderbook/MarketData/ShmMarketDataRing.hpp"
+#include "orderbook/Network/MetricsServer.hpp"
+#include "orderbook/Persistence/Journal.hpp"
+#include "orderbook/Persistence/JournalReplayer.hpp"
+#include "orderbook/Persistence/Snapshot.hpp"
 #include "orderbook/Utilities/Logger.hpp"
 #include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include "orderbook/Utilities/MemoryManager.hpp"
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <sstream>
 
 using namespace orderbook;
 
@@ -321,6 +332,9 @@ int main(int argc, char* argv[]) {
         return app_config.help && argc > 1 ? 1 : 0;
     }
     
+    // Calibration spins briefly; do it before any order is timestamped
+    TscClock::calibrate();
+    
     try {
         // Initialize configuration
         std::cout << "Loading configuration from: " << app_config.config_file << "\n";
@@ -348,14 +362,114 @@ int main(int argc, char* argv[]) {
         auto market_data = std::make_shared<MarketDataPublisher>(logger);
         logger->info("Market data publisher initialized", "main");
         
+        // Optional shared-memory ring for consumers in other processes
+        std::shared_ptr<ShmRingPublisher> shm_ring;
+        auto ring_config = ShmRingPublisher::loadConfiguration(config);
+        if (!ring_config.name.empty()) {
+            shm_ring = std::make_shared<ShmRingPublisher>(ring_config);
+            auto opened = shm_ring->open();
+            if (opened.isError()) {
+                logger->warn("Shared-memory ring disabled: " + opened.error(), "main");
+            } else {
+                market_data->subscribe(shm_ring);
+                logger->info("Publishing market data to shared memory " + ring_config.name, "main");
+            }
+        }
+        
         // Initialize OrderBook with all dependencies
-        OrderBook book(risk_manager, market_data, logger);
+        OrderBook::BookConfig book_config = OrderBook::loadConfiguration(config);
+        
+        // One book per instrument; [orderbook] symbols lists extra instruments
+        OrderBookRouter::RouterConfig router_config;
+        router_config.shard_count = static_cast<size_t>(config->getInt("matching", "shards", 1));
+        router_config.shard_cpus = MatchingRuntime::loadConfiguration(config).cpu_affinity;
+        OrderBookRouter router(risk_manager, market_data, logger, router_config);
+        
+        std::vector<std::string> symbols{book_config.symbol};
+        std::istringstream symbol_list(config->getString("orderbook", "symbols", ""));
+        for (std::string symbol; std::getline(symbol_list, symbol, ',');) {
+            symbol.erase(0, symbol.find_first_not_of(" \t"));
+            symbol.erase(symbol.find_last_not_of(" \t") + 1);
+            if (!symbol.empty() && symbol != book_config.symbol) {
+                symbols.push_back(symbol);
+            }
+        }
+        
+        for (const auto& symbol : symbols) {
+            OrderBook::BookConfig instrument_config = book_config;
+            instrument_config.symbol = symbol;
+            auto added = router.addBook(instrument_config);
+            if (added.isError()) {
+                logger->warn("Skipping book: " + added.error(), "main");
+            }
+        }
+        
+        // Warm restart: the latest snapshot restores the books, then only the
+        // journal records after each book's snapshot position are replayed
+        auto snapshot_config = SnapshotWriter::loadConfiguration(config);
+        SnapshotLoader snapshot_loader(router, logger);
+        if (!snapshot_config.path.empty() && std::ifstream(snapshot_config.path)) {
+            auto restored = snapshot_loader.load(snapshot_config.path);
+            if (restored.isError()) {
+                logger->error("Snapshot restore failed: " + restored.error(), "main");
+            }
+        }
+        
+        // Optional write-ahead journal; records left by a previous run are
+        // replayed first to restore the books
+        std::shared_ptr<JournalWriter> journal;
+        auto journal_config = JournalWriter::loadConfiguration(config);
+        if (!journal_config.path.empty()) {
+            journal = std::make_shared<JournalWriter>(logger, journal_config);
+            auto opened = journal->open();
+            if (opened.isError()) {
+                logger->warn("Journal disabled: " + opened.error(), "main");
+                journal.reset();
+            } else {
+                if (journal->getStats().recovered > 0) {
+                    JournalReplayer replayer(router, logger);
+                    for (const auto& [symbol, sequence] : snapshot_loader.getJournalSequences()) {
+                        replayer.skipThrough(symbol, sequence);
+                    }
+                    auto replayed = replayer.replay(journal_config.path);
+                    if (replayed.isError()) {
+                        logger->error("Journal replay failed: " + replayed.error(), "main");
+                    }
+                }
+                router.forEachBook([&journal](SymbolId, OrderBook& instrument) {
+                    instrument.setJournal(journal);
+                });
+                logger->info("Journaling to " + journal_config.path, "main");
+            }
+        }
+        
+        OrderBook& book = *router.getBook(book_config.symbol);
         logger->info("OrderBook initialized with all dependencies", "main");
         
+        // Optional Prometheus endpoint; collectors only read published atomics
+        std::unique_ptr<MetricsServer> metrics_server;
+        auto metrics_config = MetricsServer::loadConfiguration(config);
+        if (metrics_config.port != 0) {
+            auto registry = std::make_shared<MetricsRegistry>();
+            registry->addCollector([&router](MetricsWriter& out) { router.exportMetrics(out); });
+            registry->addCollector([market_data](MetricsWriter& out) { market_data->exportMetrics(out); });
+            registry->addCollector([](MetricsWriter& out) { MemoryManager::getInstance().exportMetrics(out); });
+            
+            metrics_server = std::make_unique<MetricsServer>(registry, logger, metrics_config);
+            auto started = metrics_server->start();
+            if (started.isError()) {
+                logger->warn("Metrics endpoint disabled: " + started.error(), "main");
+                metrics_server.reset();
+            }
+        }
+        
         // Display configuration summary
         std::cout << "\n=== OrderBook Configuration ===\n";
         std::cout << "Symbol: " << config->getString("orderbook", "symbol", "BTC/USD") << "\n";
+        std::cout << "Books: " << router.getBookCount() << " across " 
+                  << router.getShardCount() << " shard(s)\n";
         std::cout << "Max Orders: " << config->getInt("orderbook", "max_orders", 1000000) << "\n";
+        std::cout << "Tick Size: " << book.getTickSize().size() << "\n";
         std::cout << "Risk Limits:\n";
         std::cout << "  Max Order Size: " << config->getInt("risk", "max_order_size", 10000) << "\n";
         std::cout << "  Max Position: " << config->getInt("risk", "max_position", 100000) << "\n";
@@ -407,6 +521,17 @@ int main(int argc, char* argv[]) {
             std::cout << "Ask Levels: " << book.getAskLevelCount() << "\n";
         }
         
+        // Snapshot the final state so the next start restores it directly
+        if (!snapshot_config.path.empty()) {
+            SnapshotWriter snapshots(logger, snapshot_config);
+            snapshots.setJournal(journal);
+            auto captured = snapshots.capture(router);
+            auto written = captured.isSuccess() ? snapshots.wait() : captured;
+            if (written.isError()) {
+                logger->error("Snapshot failed: " + written.error(), "main");
+            }
+        }
+        
         logger->info("OrderBook application completed successfully", "main");
         
     } catch (const std::exception& e) {
@@ -0,0 +1,218 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderBookRouter.hpp"
+#include "orderbook/Network/FixFlowReplay.hpp"
+#include "orderbook/Persistence/OrderFlowReplay.hpp"
+#include "orderbook/Risk/RiskManager.hpp"
+#include "orderbook/Utilities/Config.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+void printHeader() {
+    std::printf("%-8s %10s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "op", "count", "rejected", "min", "p50",
+                "p90", "p99", "p99.9", "p99.99", "max", "mean");
+}
+
+void printRow(const char* name, const LatencyHistogram& histogram, uint64_t rejected) {
+    std::printf("%-8s %10llu %9llu %9llu %9llu %9llu %9llu %9llu %9llu %9llu %9.0f\n", name,
+                static_cast<unsigned long long>(histogram.count()), static_cast<unsigned long long>(rejected),
+                static_cast<unsigned long long>(histogram.min()),
+                static_cast<unsigned long long>(histogram.percentile(50.0)),
+                static_cast<unsigned long long>(histogram.percentile(90.0)),
+                static_cast<unsigned long long>(histogram.percentile(99.0)),
+                static_cast<unsigned long long>(histogram.percentile(99.9)),
+                static_cast<unsigned long long>(histogram.percentile(99.99)),
+                static_cast<unsigned long long>(histogram.max()), histogram.mean());
+}
+
+void printBuckets(const char* name, const LatencyHistogram& histogram) {
+    std::cout << name << " buckets (upper bound ns, count):\n";
+    histogram.forEachBucket([](uint64_t upper, uint64_t count) {
+        std::cout << "  " << upper << " " << count << "\n";
+    });
+}
+
+}
+
+/**
+ * @brief Order-flow replay harness
+ * Loads a recorded order flow (journal, CSV or FIX log) into memory, then
+ * drives it into fresh books, either directly or through FIX parsing and
+ * the order gateway, back to back or at the recorded pace. Reports per
+ * operation latency percentiles (nanoseconds) and overall throughput.
+ */
+int main(int argc, char* argv[]) {
+    std::string config_file = "config/orderbook.cfg";
+    std::string journal_path;
+    std::string csv_path;
+    std::string fix_path;
+    std::string target_name = "book";
+    std::string pace_name;
+    double speed = 0.0;
+    long long warmup = -1;
+    bool with_risk = true;
+    bool buckets = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--config" || arg == "-c") && i + 1 < argc) {
+            config_file = argv[++i];
+        } else if (arg == "--journal" && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (arg == "--csv" && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (arg == "--fix" && i + 1 < argc) {
+            fix_path = argv[++i];
+        } else if (arg == "--target" && i + 1 < argc) {
+            target_name = argv[++i];
+        } else if (arg == "--pace" && i + 1 < argc) {
+            pace_name = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            speed = std::atof(argv[++i]);
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            warmup = std::atoll(argv[++i]);
+        } else if (arg == "--no-risk") {
+            with_risk = false;
+        } else if (arg == "--buckets") {
+            buckets = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options] (--journal FILE | --csv FILE | --fix FILE)\n";
+            std::cout << "Options:\n";
+            std::cout << "  -c, --config FILE    Configuration for the books (default: config/orderbook.cfg)\n";
+            std::cout << "  --journal FILE       Replay the commands of a journal\n";
+            std::cout << "  --csv FILE           Replay a CSV capture (see OrderFlowCapture::loadCsv)\n";
+            std::cout << "  --fix FILE           Replay the order-entry messages of a FIX log\n";
+            std::cout << "  --target book|fix    Apply to the books directly, or through FIX parsing\n";
+            std::cout << "                       and the order gateway (default: book)\n";
+            std::cout << "  --pace recorded|max  Send at the recorded pace or back to back\n";
+            std::cout << "  --speed X            Recorded pace multiplier\n";
+            std::cout << "  --warmup N           Apply the first N events without measuring them\n";
+            std::cout << "  --no-risk            Replay without a risk manager\n";
+            std::cout << "  --buckets            Also print the raw histogram buckets\n";
+            std::cout << "Pace, speed and warmup default to the [replay] section of the configuration.\n";
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (target_name != "book" && target_name != "fix") {
+        std::cerr << "Unknown target: " << target_name << "\n";
+        return 1;
+    }
+    if (journal_path.empty() + csv_path.empty() + fix_path.empty() != 2) {
+        std::cerr << "Give exactly one of --journal, --csv or --fix\n";
+        return 1;
+    }
+
+    try {
+        auto config = std::make_shared<Config>(config_file);
+        OrderFlowReplay::ReplayConfig replay_config = OrderFlowReplay::loadConfiguration(config);
+        if (!pace_name.empty()) {
+            replay_config.pace = OrderFlowReplay::parsePace(pace_name);
+        }
+        if (speed > 0.0) {
+            replay_config.speed = speed;
+        }
+        if (warmup >= 0) {
+            replay_config.warmup_events = static_cast<size_t>(warmup);
+        }
+
+        // Parsed up front so file reading is not part of the measurement
+        auto loaded = !journal_path.empty() ? OrderFlowCapture::loadJournal(journal_path)
+                    : !csv_path.empty()     ? OrderFlowCapture::loadCsv(csv_path)
+                                            : FixFlowTarget::loadFixLog(fix_path);
+        if (loaded.isError()) {
+            std::cerr << "Cannot load order flow: " << loaded.error() << "\n";
+            return 1;
+        }
+        const std::vector<OrderFlowEvent>& events = loaded.value();
+
+        // No logger: per-order logging would dominate the measurement
+        std::shared_ptr<RiskManager> risk_manager;
+        if (with_risk) {
+            risk_manager = std::make_shared<RiskManager>(config);
+        }
+
+        // One book for every symbol in the flow, configured like the server's
+        OrderBook::BookConfig book_config = OrderBook::loadConfiguration(config);
+        OrderBookRouter router(risk_manager, nullptr, nullptr);
+        std::set<SymbolId> symbols;
+        for (const auto& event : events) {
+            if (event.symbol != InternTable::EmptyId) {
+                symbols.insert(event.symbol);
+            }
+        }
+        for (SymbolId symbol : symbols) {
+            OrderBook::BookConfig instrument_config = book_config;
+            instrument_config.symbol = InternTable::symbols().name(symbol);
+            auto added = router.addBook(instrument_config);
+            if (added.isError()) {
+                std::cerr << "Skipping book: " << added.error() << "\n";
+            }
+        }
+
+        std::unique_ptr<OrderFlowTarget> target;
+        if (target_name == "fix") {
+            target = std::make_unique<FixFlowTarget>(router);
+        } else {
+            target = std::make_unique<RouterFlowTarget>(router);
+        }
+
+        bool paced = replay_config.pace == OrderFlowReplay::Pace::Recorded;
+        OrderFlowReplay replay(replay_config);
+        auto report = replay.run(events, *target);
+
+        std::cout << "=== Order Flow Replay ===\n";
+        std::cout << "Source: " << (!journal_path.empty() ? journal_path : !csv_path.empty() ? csv_path : fix_path)
+                  << " (" << events.size() << " events, " << symbols.size() << " symbol(s))\n";
+        std::cout << "Target: " << target_name << (with_risk ? "" : ", no risk") << "  Pace: ";
+        if (paced) {
+            std::cout << "recorded x" << replay_config.speed;
+        } else {
+            std::cout << "max";
+        }
+        std::cout << "  Warmup: " << replay_config.warmup_events << " events\n\n";
+
+        std::cout << "Service time (ns):\n";
+        printHeader();
+        printRow("add", report->add.service, report->add.rejected);
+        printRow("cancel", report->cancel.service, report->cancel.rejected);
+        printRow("modify", report->modify.service, report->modify.rejected);
+        if (paced) {
+            std::cout << "\nResponse time from scheduled send (ns):\n";
+            printHeader();
+            printRow("add", report->add.response, report->add.rejected);
+            printRow("cancel", report->cancel.response, report->cancel.rejected);
+            printRow("modify", report->modify.response, report->modify.rejected);
+            std::cout << "Max lag behind schedule: " << report->max_lag_ns << " ns\n";
+        }
+        std::cout << "\nMeasured " << report->events << " events in " << report->seconds * 1000.0 << "ms ("
+                  << static_cast<uint64_t>(report->throughput()) << " events/second)\n";
+        if (auto* router_target = dynamic_cast<RouterFlowTarget*>(target.get())) {
+            std::cout << "Trades: " << router_target->getTrades() << "\n";
+        } else if (auto* fix_target = dynamic_cast<FixFlowTarget*>(target.get())) {
+            std::cout << "Fills: " << fix_target->getGateway().getFillsReported() << "\n";
+        }
+
+        if (buckets) {
+            std::cout << "\n";
+            printBuckets("add", report->add.service);
+            printBuckets("cancel", report->cancel.service);
+            printBuckets("modify", report->modify.service);
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,150 @@
+#include "orderbook/MarketData/ConflatingSubscriber.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <map>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Written on the delivery thread; read after stop() joined it
+class RecordingSubscriber : public IMarketDataSubscriber {
+public:
+    std::vector<BookUpdate> updates;
+    std::vector<SequenceNumber> trade_sequences;
+
+    void onTrade(const Trade&, SequenceNumber sequence) override { trade_sequences.push_back(sequence); }
+    void onBookUpdate(const BookUpdate& update) override { updates.push_back(update); }
+    void onBestPrices(const BestPrices&, SequenceNumber) override {}
+    void onDepth(const MarketDepth&, SequenceNumber) override {}
+
+    const BookUpdate* at(Price price) const {
+        for (const BookUpdate& update : updates) {
+            if (update.price == price) {
+                return &update;
+            }
+        }
+        return nullptr;
+    }
+};
+
+BookUpdate level(BookUpdate::Type type, Price price, Quantity quantity, size_t orders, SequenceNumber sequence) {
+    return BookUpdate(type, Side::Buy, price, quantity, orders, sequence, 1);
+}
+
+// Deliver everything queued so far as one batch
+void flush(ConflatingSubscriber& conflator) {
+    conflator.start();
+    conflator.stop();
+}
+
+}
+
+void testSameLevelUpdatesConflateToState() {
+    auto downstream = std::make_shared<RecordingSubscriber>();
+    ConflatingSubscriber::ConflationConfig config;
+    config.interval = std::chrono::seconds(1);
+    ConflatingSubscriber conflator(downstream, nullptr, config);
+
+    // Levels 101 and 103 were delivered before this interval
+    conflator.onBookUpdate(level(BookUpdate::Type::Add, 101.0, 5, 1, 1));
+    conflator.onBookUpdate(level(BookUpdate::Type::Add, 103.0, 9, 1, 2));
+    flush(conflator);
+    CHECK(downstream->updates.size() == 2);
+    downstream->updates.clear();
+
+    // New level: added to, then reduced; one Add with the final state
+    conflator.onBookUpdate(level(BookUpdate::Type::Add, 100.0, 10, 1, 3));
+    conflator.onBookUpdate(level(BookUpdate::Type::Modify, 100.0, 25, 2, 4));
+    conflator.onTrade(Trade(1, OrderId(1), OrderId(2), 100.0, 10, 1), 5);
+    conflator.onBookUpdate(level(BookUpdate::Type::Modify, 100.0, 15, 1, 6));
+    // Existing level changed, then emptied: Remove
+    conflator.onBookUpdate(level(BookUpdate::Type::Modify, 101.0, 2, 1, 7));
+    conflator.onBookUpdate(level(BookUpdate::Type::Remove, 101.0, 0, 0, 8));
+    // Level that came and went inside the interval: nothing
+    conflator.onBookUpdate(level(BookUpdate::Type::Add, 102.0, 4, 1, 9));
+    conflator.onBookUpdate(level(BookUpdate::Type::Remove, 102.0, 0, 0, 10));
+    // Existing level emptied and refilled: Modify, never a Remove
+    conflator.onBookUpdate(level(BookUpdate::Type::Remove, 103.0, 0, 0, 11));
+    conflator.onBookUpdate(level(BookUpdate::Type::Add, 103.0, 7, 1, 12));
+    flush(conflator);
+
+    CHECK(downstream->trade_sequences.size() == 1 && downstream->trade_sequences[0] == 5);
+    CHECK(downstream->updates.size() == 3);
+
+    const BookUpdate* added = downstream->at(100.0);
+    CHECK(added && added->type == BookUpdate::Type::Add);
+    CHECK(added->quantity == 15 && added->order_count == 1 && added->sequence == 6);
+
+    const BookUpdate* removed = downstream->at(101.0);
+    CHECK(removed && removed->type == BookUpdate::Type::Remove && removed->order_count == 0);
+
+    CHECK(downstream->at(102.0) == nullptr);
+
+    const BookUpdate* refilled = downstream->at(103.0);
+    CHECK(refilled && refilled->type == BookUpdate::Type::Modify);
+    CHECK(refilled->quantity == 7 && refilled->order_count == 1);
+
+    auto stats = conflator.getStats();
+    CHECK(stats.updates_received == 11);
+    CHECK(stats.updates_delivered == 5);
+    CHECK(stats.trades_delivered == 1);
+
+    std::cout << "Same-level conflation test passed!" << std::endl;
+}
+
+void testConflatedFeedRebuildsBook() {
+    auto downstream = std::make_shared<RecordingSubscriber>();
+    auto conflator = std::make_shared<ConflatingSubscriber>(downstream);
+    auto publisher = std::make_shared<MarketDataPublisher>();
+    publisher->subscribe(conflator);
+
+    OrderBook::BookConfig config;
+    config.symbol = "CONF";
+    OrderBook book(nullptr, publisher, nullptr, config);
+
+    // Churn a few levels, delivering every few rounds; however the updates
+    // were conflated, the consumer must end up with the book's real levels
+    uint64_t id = 1;
+    for (int round = 0; round < 20; ++round) {
+        for (int tick = 0; tick < 5; ++tick) {
+            CHECK(book.addOrder(Order(id++, Side::Buy, OrderType::Limit, TimeInForce::GTC,
+                                      99.00 + tick * 0.01, 10 + round, "CONF", "a")).isSuccess());
+        }
+        CHECK(book.cancelOrder(OrderId(id - 5)).isSuccess());
+        CHECK(book.addOrder(Order(id++, Side::Sell, OrderType::Limit, TimeInForce::IOC,
+                                  99.02, 15, "CONF", "b")).isSuccess());
+        if (round % 3 == 2) {
+            flush(*conflator);
+        }
+    }
+    flush(*conflator);
+
+    std::map<Price, std::pair<Quantity, size_t>> rebuilt;
+    for (const BookUpdate& update : downstream->updates) {
+        if (update.type == BookUpdate::Type::Remove) {
+            CHECK(rebuilt.erase(update.price) == 1);
+        } else {
+            CHECK((update.type == BookUpdate::Type::Add) == (rebuilt.count(update.price) == 0));
+            rebuilt[update.price] = std::make_pair(update.quantity, update.order_count);
+        }
+    }
+
+    std::map<Price, std::pair<Quantity, size_t>> actual;
+    MarketDepth depth = book.getDepth(100);
+    for (const auto& bid : depth.bids) {
+        actual[bid.price] = std::make_pair(bid.quantity, bid.order_count);
+    }
+    CHECK(!actual.empty());
+    CHECK(rebuilt == actual);
+
+    std::cout << "Conflated rebuild test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testSameLevelUpdatesConflateToState);
+    RUN_TEST(testConflatedFeedRebuildsBook);
+    std::cout << "All ConflatingSubscriber tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "orderbook/Core/DepthSnapshot.hpp"
+#include "TestSupport.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+const TickSize Tick(0.25);
+
+// Bids from 100.00 down, asks from 100.25 up; quarter prices and whole
+// quantities keep every notional sum exact
+void writeBook(DepthSnapshot& snapshot, const std::vector<Quantity>& bids, const std::vector<Quantity>& asks,
+               SequenceNumber sequence) {
+    snapshot.beginWrite();
+    for (size_t i = 0; i < bids.size(); ++i) {
+        PriceTicks ticks = 400 - static_cast<PriceTicks>(i);
+        snapshot.writeLevel(Side::Buy, i, ticks, bids[i], Tick.toPrice(ticks));
+    }
+    for (size_t i = 0; i < asks.size(); ++i) {
+        PriceTicks ticks = 401 + static_cast<PriceTicks>(i);
+        snapshot.writeLevel(Side::Sell, i, ticks, asks[i], Tick.toPrice(ticks));
+    }
+    snapshot.endWrite(bids.size(), asks.size(), sequence);
+}
+
+}
+
+void testPrefixSumsAndQueries() {
+    // Odd sizes leave a scalar tail after the vector registers
+    std::mt19937_64 rng(7);
+    for (size_t count : {0, 1, 2, 3, 4, 5, 7, 8, 13, 37}) {
+        DepthSnapshot snapshot(37, Tick);
+        std::vector<Quantity> bids(count);
+        std::vector<Quantity> asks(count / 2);
+        for (Quantity& quantity : bids) quantity = 1 + rng() % 1000;
+        for (Quantity& quantity : asks) quantity = 1 + rng() % 1000;
+        writeBook(snapshot, bids, asks, count);
+
+        DepthView view;
+        snapshot.read(view);
+        CHECK(view.getBookSequence() == count);
+        CHECK(view.getVersion() % 2 == 0 && view.getVersion() == snapshot.getVersion());
+
+        for (Side side : {Side::Buy, Side::Sell}) {
+            const auto& levels = view.levels(side);
+            const auto& expected = side == Side::Buy ? bids : asks;
+            CHECK(levels.count == expected.size());
+            Quantity quantity = 0;
+            double notional = 0.0;
+            for (size_t i = 0; i < levels.count; ++i) {
+                quantity += expected[i];
+                notional += Tick.toPrice(levels.ticks[i]) * static_cast<double>(expected[i]);
+                CHECK(levels.cumulative_quantity[i] == quantity);
+                CHECK(levels.cumulative_notional[i] == notional);
+            }
+        }
+    }
+
+    // Queries over a known book: bids 10 @ 100.00, 20 @ 99.75, 30 @ 99.50
+    DepthSnapshot snapshot(4, Tick);
+    writeBook(snapshot, {10, 20, 30}, {5, 15}, 1);
+    DepthView view;
+    snapshot.read(view);
+
+    CHECK(view.quantityTo(Side::Buy, 99.75) == 30);
+    CHECK(view.quantityTo(Side::Buy, 99.60) == 30);
+    CHECK(view.quantityTo(Side::Buy, 100.10) == 0);
+    CHECK(view.quantityTo(Side::Sell, 101.00) == 20);
+
+    CHECK(view.priceFor(Side::Buy, 10) == 100.00);
+    CHECK(view.priceFor(Side::Buy, 11) == 99.75);
+    CHECK(!view.priceFor(Side::Buy, 61).has_value());
+
+    // 5 @ 100.25 and 5 @ 100.50
+    CHECK(view.vwapTo(Side::Sell, 10) == 100.375);
+    CHECK(!view.vwapTo(Side::Sell, 0).has_value());
+    CHECK(!view.vwapTo(Side::Sell, 21).has_value());
+
+    // The mirror covers anything better than its worst level once full
+    CHECK(snapshot.covers(Side::Sell, 1000));
+    writeBook(snapshot, {10, 20, 30, 40}, {5}, 2);
+    CHECK(snapshot.covers(Side::Buy, 397));
+    CHECK(!snapshot.covers(Side::Buy, 396));
+
+    std::cout << "Prefix sum and query test passed!" << std::endl;
+}
+
+void testReadersNeverSeeATornWrite() {
+    constexpr size_t Levels = 16;
+    constexpr SequenceNumber Writes = 50000;
+    DepthSnapshot snapshot(Levels, Tick);
+    writeBook(snapshot, {1}, {1}, 1);
+
+    // Every write fills its levels with its own sequence, so a copy mixing
+    // two writes shows up as a level that disagrees with the book sequence
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (SequenceNumber sequence = 2; sequence <= Writes; ++sequence) {
+            std::vector<Quantity> bids(1 + sequence % Levels, sequence);
+            std::vector<Quantity> asks(1 + (sequence / 3) % Levels, sequence);
+            writeBook(snapshot, bids, asks, sequence);
+        }
+        done.store(true);
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<uint64_t> reads{0};
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            DepthView view;
+            SequenceNumber last = 0;
+            do {
+                snapshot.read(view);
+                SequenceNumber sequence = view.getBookSequence();
+                CHECK(sequence >= last);
+                last = sequence;
+                CHECK(view.levels(Side::Buy).count == (sequence == 1 ? 1 : 1 + sequence % Levels));
+                for (Side side : {Side::Buy, Side::Sell}) {
+                    const auto& levels = view.levels(side);
+                    for (size_t i = 0; i < levels.count; ++i) {
+                        CHECK(levels.quantity[i] == sequence);
+                    }
+                    CHECK(levels.count == 0 || levels.cumulative_quantity[levels.count - 1] == levels.count * sequence);
+                }
+                reads.fetch_add(1);
+            } while (!done.load());
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    CHECK(reads.load() >= 2);
+
+    DepthView view;
+    snapshot.read(view);
+    CHECK(view.getBookSequence() == Writes);
+
+    std::cout << "Seqlock consistency test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testPrefixSumsAndQueries);
+    RUN_TEST(testReadersNeverSeeATornWrite);
+    std::cout << "All DepthSnapshot tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "orderbook/Network/FixFrameReader.hpp"
+#include "TestSupport.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// A well-formed message with the given body; '|' stands for SOH
+std::string frame(const std::string& body) {
+    std::string fields = body;
+    for (char& c : fields) {
+        if (c == '|') c = '\x01';
+    }
+    std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(fields.size()) + "\x01" + fields;
+    unsigned checksum = 0;
+    for (char c : message) checksum += static_cast<unsigned char>(c);
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", checksum % 256);
+    return message + trailer;
+}
+
+void feed(FixFrameReader& reader, const std::string& bytes) {
+    char* out = reader.writePtr();
+    CHECK(reader.writable() >= bytes.size());
+    std::memcpy(out, bytes.data(), bytes.size());
+    reader.commit(bytes.size());
+}
+
+std::vector<std::string> drainAll(FixFrameReader& reader) {
+    std::vector<std::string> messages;
+    reader.drain([&messages](std::string_view message) {
+        messages.emplace_back(message);
+        return true;
+    });
+    return messages;
+}
+
+}
+
+void testSplitsBackToBackMessages() {
+    FixFrameReader reader;
+    std::string a = frame("35=D|11=A|");
+    std::string b = frame("35=F|11=B|41=A|");
+    std::string c = frame("35=0|");
+    feed(reader, a + b + c);
+
+    auto messages = drainAll(reader);
+    CHECK(messages.size() == 3);
+    CHECK(messages[0] == a && messages[1] == b && messages[2] == c);
+    CHECK(reader.buffered() == 0);
+    CHECK(reader.getDiscardedBytes() == 0);
+
+    // A consumer returning false stops after the current message
+    feed(reader, a + b);
+    size_t delivered = reader.drain([](std::string_view) { return false; });
+    CHECK(delivered == 1);
+    CHECK(reader.buffered() == b.size());
+
+    std::cout << "Back-to-back framing test passed!" << std::endl;
+}
+
+void testPartialMessageWaitsForRest() {
+    FixFrameReader reader;
+    std::string message = frame("35=D|11=PARTIAL|55=BTC/USD|54=1|38=10|44=100.5|");
+
+    // One byte at a time: nothing is delivered until the trailer's SOH arrives
+    for (size_t i = 0; i + 1 < message.size(); ++i) {
+        feed(reader, message.substr(i, 1));
+        CHECK(drainAll(reader).empty());
+    }
+    feed(reader, message.substr(message.size() - 1));
+    auto messages = drainAll(reader);
+    CHECK(messages.size() == 1 && messages[0] == message);
+
+    // A split inside BodyLength's digits is still read as one length
+    std::string longer = frame(std::string("58=") + std::string(120, 'x') + "|");
+    size_t split = longer.find("9=") + 3;
+    feed(reader, longer.substr(0, split));
+    CHECK(drainAll(reader).empty());
+    feed(reader, longer.substr(split));
+    messages = drainAll(reader);
+    CHECK(messages.size() == 1 && messages[0] == longer);
+    CHECK(reader.getDiscardedBytes() == 0);
+
+    std::cout << "Partial message test passed!" << std::endl;
+}
+
+void testMalformedBytesAreSkipped() {
+    FixFrameReader reader(4096, 256);
+    std::string good = frame("35=D|11=GOOD|");
+
+    // Junk before a frame is skipped up to the next "8=" after a delimiter
+    std::string junk = "garbage\x01";
+    feed(reader, junk + good);
+    auto messages = drainAll(reader);
+    CHECK(messages.size() == 1 && messages[0] == good);
+    CHECK(reader.getDiscardedBytes() == junk.size());
+
+    // A BodyLength that overshoots lands off the trailer; the frame is dropped
+    std::string lying = frame("35=D|11=LIE|");
+    lying.replace(lying.find("9=") + 2, 2, "10");
+    feed(reader, lying + good);
+    messages = drainAll(reader);
+    CHECK(messages.size() == 1 && messages[0] == good);
+    CHECK(reader.getDiscardedBytes() == junk.size() + lying.size());
+
+    // Non-numeric and oversized lengths are refused without waiting for the body
+    uint64_t before = reader.getDiscardedBytes();
+    std::string bad_digits = "8=FIX.4.4\x01" "9=1x\x01";
+    std::string oversized = "8=FIX.4.4\x01" "9=100000\x01";
+    feed(reader, bad_digits + oversized + good);
+    messages = drainAll(reader);
+    CHECK(messages.size() == 1 && messages[0] == good);
+    CHECK(reader.getDiscardedBytes() == before + bad_digits.size() + oversized.size());
+
+    std::cout << "Malformed frame test passed!" << std::endl;
+}
+
+void testCompactionKeepsMessagesContiguous() {
+    // The minimum buffer holds two maximum-size messages, so partial tails
+    // are moved to the front many times over
+    FixFrameReader reader(0, 128);
+    std::vector<std::string> sent;
+    std::string stream;
+    for (int i = 0; i < 200; ++i) {
+        sent.push_back(frame("35=D|11=" + std::to_string(i) + "|"));
+        stream += sent.back();
+    }
+
+    std::vector<std::string> received;
+    size_t offset = 0;
+    while (offset < stream.size()) {
+        char* out = reader.writePtr();
+        size_t chunk = std::min<size_t>({reader.writable(), 37, stream.size() - offset});
+        std::memcpy(out, stream.data() + offset, chunk);
+        reader.commit(chunk);
+        offset += chunk;
+        for (auto& message : drainAll(reader)) {
+            received.push_back(std::move(message));
+        }
+    }
+
+    CHECK(received == sent);
+    CHECK(reader.buffered() == 0);
+    CHECK(reader.getDiscardedBytes() == 0);
+
+    std::cout << "Compaction test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testSplitsBackToBackMessages);
+    RUN_TEST(testPartialMessageWaitsForRest);
+    RUN_TEST(testMalformedBytesAreSkipped);
+    RUN_TEST(testCompactionKeepsMessagesContiguous);
+    std::cout << "All FixFrameReader tests passed!" << std::endl;
+    return 0;
+}
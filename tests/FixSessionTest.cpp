@@ -0,0 +1,110 @@
+#include "orderbook/Network/FixSession.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include "TestSupport.hpp"
+#include <boost/asio.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+using boost::asio::ip::tcp;
+
+namespace {
+
+FixMessageParser::ExecutionReport report(uint64_t id) {
+    FixMessageParser::ExecutionReport execReport;
+    execReport.orderId = std::to_string(id);
+    execReport.clOrdId = "C" + std::to_string(id);
+    execReport.execId = "E" + std::to_string(id);
+    execReport.execType = fix::EXEC_TYPE_FILL;
+    execReport.ordStatus = fix::ORD_STATUS_FILLED;
+    execReport.symbol = "SEQ";
+    execReport.side = Side::Buy;
+    execReport.orderQty = 10;
+    execReport.price = 100.0;
+    execReport.lastQty = 10;
+    execReport.lastPx = 100.0;
+    execReport.leavesQty = 0;
+    execReport.cumQty = 10;
+    execReport.avgPx = 100.0;
+    execReport.transactTime = std::chrono::system_clock::now();
+    return execReport;
+}
+
+// MsgSeqNum of every complete field in a raw outbound stream, in wire order
+std::vector<uint64_t> sequenceNumbers(const std::string& stream) {
+    std::vector<uint64_t> sequences;
+    const std::string tag = std::string(1, '\x01') + "34=";
+    for (size_t pos = stream.find(tag); pos != std::string::npos; pos = stream.find(tag, pos + 1)) {
+        size_t value = pos + tag.size();
+        size_t end = stream.find('\x01', value);
+        if (end == std::string::npos) {
+            break;      // Rest of the field not read yet
+        }
+        sequences.push_back(std::stoull(stream.substr(value, end - value)));
+    }
+    return sequences;
+}
+
+}
+
+void testConcurrentSendsStayInSequence() {
+    constexpr int Reports = 2000;
+    constexpr int Heartbeats = 2000;
+
+    boost::asio::io_context io;
+    auto guard = boost::asio::make_work_guard(io);
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+    tcp::socket peer(io);
+    peer.connect(acceptor.local_endpoint());
+    auto session = std::make_shared<FixSession>(acceptor.accept(), io, nullptr);
+    session->setSessionIds("SERVER", "CLIENT");
+
+    std::thread runner([&io]() { io.run(); });
+    session->start();
+    while (!session->isLoggedIn()) {
+        std::this_thread::yield();
+    }
+
+    // Reports come from a matching thread while the session's own
+    // heartbeats go out from another
+    std::thread reporter([&session]() {
+        for (int i = 0; i < Reports; ++i) {
+            session->sendExecutionReport(report(i + 1));
+        }
+    });
+    std::thread heartbeater([&session]() {
+        for (int i = 0; i < Heartbeats; ++i) {
+            session->sendHeartbeat();
+        }
+    });
+    reporter.join();
+    heartbeater.join();
+
+    // The wire must carry 1, 2, 3, ... with no reordering
+    std::string stream;
+    std::vector<uint64_t> sequences;
+    char buffer[65536];
+    while (sequences.size() < Reports + Heartbeats) {
+        size_t read = peer.read_some(boost::asio::buffer(buffer));
+        stream.append(buffer, read);
+        sequences = sequenceNumbers(stream);
+    }
+    CHECK(sequences.size() == Reports + Heartbeats);
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        CHECK(sequences[i] == i + 1);
+    }
+    CHECK(session->getStats().heartbeatsSent == Heartbeats);
+
+    boost::asio::post(io, [&session]() { session->close(); });
+    guard.reset();
+    runner.join();
+
+    std::cout << "Concurrent send sequencing test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testConcurrentSendsStayInSequence);
+    std::cout << "All FixSession tests passed!" << std::endl;
+    return 0;
+}
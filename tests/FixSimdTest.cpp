@@ -0,0 +1,136 @@
+#include "orderbook/Network/FixSimd.hpp"
+#include "TestSupport.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace orderbook::fix;
+
+namespace {
+
+// Byte-at-a-time reference for scanFields
+std::vector<simd::FieldBounds> referenceFields(const std::string& data) {
+    std::vector<simd::FieldBounds> fields;
+    size_t start = 0;
+    for (size_t i = 0; i <= data.size(); ++i) {
+        if (i < data.size() && data[i] != '\x01') {
+            continue;
+        }
+        if (i > start) {
+            uint32_t equals = simd::NoEquals;
+            for (size_t j = start; j < i; ++j) {
+                if (data[j] == '=') {
+                    equals = static_cast<uint32_t>(j);
+                    break;
+                }
+            }
+            fields.push_back({static_cast<uint32_t>(start), equals, static_cast<uint32_t>(i)});
+        }
+        start = i + 1;
+    }
+    return fields;
+}
+
+std::vector<simd::FieldBounds> scanAll(const std::string& data, size_t capacity) {
+    std::vector<simd::FieldBounds> fields;
+    std::vector<simd::FieldBounds> out(capacity);
+    size_t pos = 0;
+    while (true) {
+        size_t found = simd::scanFields(data.data(), data.size(), pos, out.data(), capacity);
+        fields.insert(fields.end(), out.begin(), out.begin() + found);
+        if (found < capacity) {
+            break;
+        }
+    }
+    return fields;
+}
+
+bool sameFields(const std::vector<simd::FieldBounds>& a, const std::vector<simd::FieldBounds>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].start != b[i].start || a[i].equals != b[i].equals || a[i].end != b[i].end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void testScanMatchesReference() {
+    std::cout << "Kernel: " << simd::kernelName() << std::endl;
+
+    std::string message = "8=FIX.4.4\x01" "9=42\x01" "35=D\x01" "49=CLIENT\x01" "56=SERVER\x01"
+                          "11=ORDER1\x01" "55=BTC/USD\x01" "54=1\x01" "38=100\x01" "44=50000.5\x01" "10=123\x01";
+    auto fields = scanAll(message, 64);
+    CHECK(sameFields(fields, referenceFields(message)));
+    CHECK(fields.size() == 11);
+    CHECK(message.compare(fields[2].start, fields[2].end - fields[2].start, "35=D") == 0);
+    CHECK(fields[2].equals == fields[2].start + 2);
+
+    // Empty fields are skipped, a field without '=' is flagged, and a trailing
+    // field without SOH ends at the buffer size
+    std::string odd = "\x01\x01" "35=D\x01\x01\x01" "junk\x01" "58=a=b\x01" "10=000";
+    fields = scanAll(odd, 64);
+    CHECK(sameFields(fields, referenceFields(odd)));
+    CHECK(fields.size() == 4);
+    CHECK(fields[1].equals == simd::NoEquals);
+    CHECK(fields[2].equals == fields[2].start + 2);
+    CHECK(fields[3].end == odd.size());
+
+    std::cout << "Scan reference test passed!" << std::endl;
+}
+
+void testScanRandomAcrossVectorBoundaries() {
+    // Lengths around 16 and 32 byte blocks, delimiters in every lane position
+    std::mt19937 rng(12345);
+    const char alphabet[] = {'\x01', '=', 'A', '7', '\x80', '\xff'};
+    for (int round = 0; round < 2000; ++round) {
+        size_t length = rng() % 200;
+        std::string data(length, 'x');
+        for (char& c : data) {
+            c = alphabet[rng() % sizeof(alphabet)];
+        }
+        // Capacity 1..8 also exercises resuming mid-block
+        size_t capacity = 1 + rng() % 8;
+        CHECK(sameFields(scanAll(data, capacity), referenceFields(data)));
+        CHECK(sameFields(scanAll(data, 256), referenceFields(data)));
+    }
+
+    std::cout << "Random scan test passed!" << std::endl;
+}
+
+void testByteSumMatchesScalar() {
+    std::mt19937 rng(6789);
+    std::string data(300, '\0');
+    for (char& c : data) {
+        c = static_cast<char>(rng() & 0xFF);
+    }
+
+    // Every length and a few misaligned starts; bytes >= 0x80 must not sign-extend
+    for (size_t offset = 0; offset < 4; ++offset) {
+        for (size_t length = 0; offset + length <= data.size(); ++length) {
+            uint32_t expected = 0;
+            for (size_t i = 0; i < length; ++i) {
+                expected += static_cast<unsigned char>(data[offset + i]);
+            }
+            CHECK(simd::byteSum(data.data() + offset, length) == expected);
+            CHECK(simd::checksum(data.data() + offset, length) == (expected & 0xFF));
+        }
+    }
+
+    std::string all_high(1000, '\xff');
+    CHECK(simd::byteSum(all_high.data(), all_high.size()) == 255u * 1000u);
+
+    std::cout << "Byte sum test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testScanMatchesReference);
+    RUN_TEST(testScanRandomAcrossVectorBoundaries);
+    RUN_TEST(testByteSumMatchesScalar);
+    std::cout << "All FixSimd tests passed!" << std::endl;
+    return 0;
+}
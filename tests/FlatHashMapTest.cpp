@@ -0,0 +1,165 @@
+#include "orderbook/Utilities/FlatHashMap.hpp"
+#include "TestSupport.hpp"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace orderbook;
+
+namespace {
+
+// Few distinct homes, so entries form long runs that wrap past the table's end
+struct CollidingHash {
+    size_t operator()(uint64_t key) const { return key % 3; }
+};
+
+// Counts live values so erase and backward shift can be checked for leaks and double destroys
+struct Tracked {
+    static int live;
+    uint64_t value = 0;
+
+    Tracked() { ++live; }
+    explicit Tracked(uint64_t v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+template<typename Map>
+void checkMatches(const Map& map, const std::unordered_map<uint64_t, uint64_t>& reference) {
+    CHECK(map.size() == reference.size());
+    for (const auto& [key, value] : reference) {
+        auto it = map.find(key);
+        CHECK(it != map.end());
+        CHECK(it->second.value == value);
+    }
+    size_t iterated = 0;
+    for (const auto& entry : map) {
+        CHECK(reference.count(entry.first) == 1);
+        ++iterated;
+    }
+    CHECK(iterated == reference.size());
+}
+
+}
+
+void testEraseShiftsClusterBack() {
+    {
+        FlatHashMap<uint64_t, Tracked, CollidingHash> map;
+        for (uint64_t key = 0; key < 12; ++key) {
+            CHECK(map.try_emplace(key, key * 10).second);
+        }
+        CHECK(!map.try_emplace(4, 999).second);
+        CHECK(map.find(4)->second.value == 40);
+
+        // Erase from the front, middle and back of each run; every survivor
+        // must still be reachable (a hole would end its probe early)
+        std::unordered_map<uint64_t, uint64_t> reference;
+        for (uint64_t key = 0; key < 12; ++key) {
+            reference[key] = key * 10;
+        }
+        for (uint64_t key : {0, 6, 11, 3, 7}) {
+            CHECK(map.erase(key) == 1);
+            reference.erase(key);
+            checkMatches(map, reference);
+        }
+        CHECK(map.erase(6) == 0);
+
+        // Erase by position, then reuse the freed slots
+        map.erase(map.find(1));
+        reference.erase(1);
+        checkMatches(map, reference);
+        for (uint64_t key : {0, 1, 3}) {
+            CHECK(map.emplace(key, key * 10).second);
+            reference[key] = key * 10;
+        }
+        checkMatches(map, reference);
+        CHECK(Tracked::live == static_cast<int>(map.size()));
+    }
+    CHECK(Tracked::live == 0);
+
+    std::cout << "Backward-shift erase test passed!" << std::endl;
+}
+
+void testRandomChurnMatchesReference() {
+    std::mt19937_64 rng(42);
+    {
+        FlatHashMap<uint64_t, Tracked, CollidingHash> colliding;
+        FlatHashMap<uint64_t, Tracked> spread;
+        std::unordered_map<uint64_t, uint64_t> reference;
+
+        for (int step = 0; step < 20000; ++step) {
+            uint64_t key = rng() % 256;
+            uint64_t action = rng() % 3;
+            if (action == 0) {
+                colliding.erase(key);
+                spread.erase(key);
+                reference.erase(key);
+            } else {
+                uint64_t value = rng();
+                colliding.insert_or_assign(key, Tracked(value));
+                spread.insert_or_assign(key, Tracked(value));
+                reference[key] = value;
+            }
+            if (step % 1000 == 0) {
+                checkMatches(colliding, reference);
+                checkMatches(spread, reference);
+            }
+        }
+        checkMatches(colliding, reference);
+        checkMatches(spread, reference);
+
+        // clear() keeps the table and destroys every entry
+        size_t capacity = spread.capacity();
+        spread.clear();
+        CHECK(spread.empty() && spread.capacity() == capacity);
+        CHECK(spread.find(reference.begin()->first) == spread.end());
+        CHECK(Tracked::live == static_cast<int>(colliding.size()));
+    }
+    CHECK(Tracked::live == 0);
+
+    std::cout << "Random churn test passed!" << std::endl;
+}
+
+void testStringKeysAndGrowth() {
+    FlatHashMap<std::string, int> map;
+    map.reserve(10);
+    size_t reserved = map.capacity();
+    for (int i = 0; i < 10; ++i) {
+        map["CLORD-" + std::to_string(i)] = i;
+    }
+    CHECK(map.capacity() == reserved);
+
+    for (int i = 10; i < 5000; ++i) {
+        map.emplace("CLORD-" + std::to_string(i), i);
+    }
+    CHECK(map.size() == 5000);
+    for (int i = 0; i < 5000; i += 2) {
+        CHECK(map.erase("CLORD-" + std::to_string(i)) == 1);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        auto it = map.find("CLORD-" + std::to_string(i));
+        CHECK((it != map.end()) == (i % 2 == 1));
+        if (it != map.end()) {
+            CHECK(it->second == i);
+        }
+    }
+
+    // Copies are independent
+    FlatHashMap<std::string, int> copy = map;
+    copy.erase("CLORD-1");
+    CHECK(map.contains("CLORD-1") && !copy.contains("CLORD-1"));
+
+    std::cout << "String key test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testEraseShiftsClusterBack);
+    RUN_TEST(testRandomChurnMatchesReference);
+    RUN_TEST(testStringKeysAndGrowth);
+    std::cout << "All FlatHashMap tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "orderbook/Utilities/Logger.hpp"
+#include "TestSupport.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+std::string logPath(const char* name) {
+    std::string path = "/tmp/orderbook_" + std::string(name) + "_" + std::to_string(::getpid()) + ".log";
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+}
+
+void testAsyncKeepsLongLinesWhole() {
+    std::string path = logPath("async");
+    Logger::LogConfig config;
+    config.filename = path;
+    config.console_output = false;
+    config.json_format = false;
+    config.min_level = LogLevel::DEBUG;
+    config.async = true;
+
+    // Long enough together to overflow a record's inline text
+    std::string context = "OrderBook::addOrder - OrderID: 123456789 Account: " + std::string(120, 'a');
+    std::string message = "Order rejected: " + std::string(400, 'm') + " end";
+    {
+        Logger logger(config);
+        CHECK(logger.isAsync());
+        logger.info("short message", "short context");
+        logger.info(message, context);
+
+        // From several threads, so spilled records cross rings
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&logger, &message, t]() {
+                for (int i = 0; i < 100; ++i) {
+                    logger.warn(message + " #" + std::to_string(t), "thread");
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        logger.logPerformance("op", 42, {{"key", std::string(300, 'k')}, {"value", "v"}});
+        logger.flush();
+        CHECK(logger.getDroppedRecords() == 0);
+    }
+
+    std::string contents = readFile(path);
+    CHECK(contents.find("short message") != std::string::npos);
+    CHECK(contents.find(context) != std::string::npos);
+    CHECK(contents.find(message) != std::string::npos);
+    CHECK(contents.find(std::string(300, 'k')) != std::string::npos);
+    CHECK(contents.find("...") == std::string::npos);
+    for (int t = 0; t < 4; ++t) {
+        std::string line = message + " #" + std::to_string(t);
+        size_t count = 0;
+        for (size_t pos = contents.find(line); pos != std::string::npos; pos = contents.find(line, pos + 1)) {
+            ++count;
+        }
+        CHECK(count == 100);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "Async long line test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testAsyncKeepsLongLinesWhole);
+    std::cout << "All Logger tests passed!" << std::endl;
+    return 0;
+}
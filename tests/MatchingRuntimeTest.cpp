@@ -0,0 +1,131 @@
+#include "orderbook/Core/MatchingRuntime.hpp"
+#include "TestSupport.hpp"
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+std::unique_ptr<OrderBookRouter> makeRouter(const char* symbol) {
+    auto router = std::make_unique<OrderBookRouter>();
+    OrderBook::BookConfig config;
+    config.symbol = symbol;
+    CHECK(router->addBook(config).isSuccess());
+    return router;
+}
+
+Order makeBid(uint64_t id, const char* symbol, Price price, Quantity quantity) {
+    return Order(id, Side::Buy, OrderType::Limit, TimeInForce::GTC, price, quantity, symbol, "a");
+}
+
+}
+
+void testUnconsumedResultsDoNotWedge() {
+    // Default: no handler and no result ring, so results are counted and dropped
+    {
+        auto router = makeRouter("RTA");
+        MatchingRuntime runtime(*router);
+        CHECK(runtime.getConfig().result_queue_size == 0);
+        for (uint64_t id = 1; id <= 100; ++id) {
+            CHECK(runtime.submit(BookCommand::add(makeBid(id, "RTA", 100.00 - id * 0.01, 1))).isSuccess());
+        }
+        runtime.start();
+        runtime.stop();
+        CHECK(runtime.getProcessedCount(0) == 100);
+        CHECK(runtime.getDroppedResults() == 100);
+        CHECK(router->getBook(InternTable::symbols().intern("RTA"))->getOrderCount() == 100);
+    }
+
+    // A small ring nobody polls: the shard waits for room while running, and
+    // stop() still applies every queued command and returns
+    {
+        auto router = makeRouter("RTB");
+        MatchingRuntime::RuntimeConfig config;
+        config.result_queue_size = 4;
+        config.max_batch = 8;
+        MatchingRuntime runtime(*router, nullptr, config);
+        for (uint64_t id = 1; id <= 100; ++id) {
+            CHECK(runtime.submit(BookCommand::add(makeBid(id, "RTB", 100.00 - id * 0.01, 1))).isSuccess());
+        }
+        runtime.start();
+        runtime.stop();
+        CHECK(!runtime.isRunning());
+        CHECK(runtime.getProcessedCount(0) == 100);
+
+        size_t polled = runtime.pollResults([](BookCommandResult& result) { CHECK(result.success); });
+        CHECK(polled > 0);
+        CHECK(polled + runtime.getDroppedResults() == 100);
+    }
+
+    std::cout << "Unconsumed results test passed!" << std::endl;
+}
+
+void testResultHandlerSeesTrades() {
+    auto router = makeRouter("RTC");
+    MatchingRuntime runtime(*router);
+
+    // Called on the shard thread only; read back after stop() joined it
+    std::vector<BookCommandResult> results;
+    runtime.setResultHandler([&results](BookCommandResult& result) { results.push_back(result); });
+    runtime.start();
+
+    CHECK(runtime.submit(BookCommand::add(makeBid(1, "RTC", 100.00, 10), 7, 1)).isSuccess());
+    CHECK(runtime.submit(BookCommand::add(
+        Order(2, Side::Sell, OrderType::Limit, TimeInForce::GTC, 100.00, 4, "RTC", "b"), 7, 2)).isSuccess());
+    CHECK(runtime.submit(BookCommand::add(
+        Order(3, Side::Sell, OrderType::Limit, TimeInForce::IOC, 100.00, 20, "RTC", "b"), 7, 3)).isSuccess());
+    runtime.stop();
+
+    CHECK(results.size() == 3);
+    CHECK(runtime.getDroppedResults() == 0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        CHECK(results[i].success);
+        CHECK(results[i].source == 7 && results[i].tag == i + 1);
+    }
+
+    // The resting bid rests whole; the seller fills 4 of it; the IOC takes the
+    // remaining 6 and nothing of it rests
+    CHECK(results[0].trades.empty() && results[0].resting == 10);
+    CHECK(results[1].trades.size() == 1 && results[1].trades[0].quantity == 4 && results[1].resting == 0);
+    CHECK(results[2].trades.size() == 1 && results[2].trades[0].quantity == 6 && results[2].resting == 0);
+
+    // A handler cannot be swapped in under a running runtime
+    runtime.start();
+    runtime.setResultHandler(nullptr);
+    CHECK(runtime.submit(BookCommand::add(makeBid(4, "RTC", 99.00, 1))).isSuccess());
+    runtime.stop();
+    CHECK(results.size() == 4);
+
+    std::cout << "Result handler test passed!" << std::endl;
+}
+
+void testVisitBooksWhileRunning() {
+    auto router = makeRouter("RTD");
+    MatchingRuntime runtime(*router);
+    runtime.start();
+    for (uint64_t id = 1; id <= 10; ++id) {
+        CHECK(runtime.submit(BookCommand::add(makeBid(id, "RTD", 100.00 - id * 0.01, 1))).isSuccess());
+    }
+
+    // The visit runs between batches; wait until every order has been applied
+    size_t orders = 0;
+    while (orders < 10) {
+        runtime.visitBooks([&orders](SymbolId, OrderBook& book) { orders = book.getOrderCount(); });
+    }
+    CHECK(orders == 10);
+    runtime.stop();
+
+    // Stopped: visited on this thread
+    runtime.visitBooks([&orders](SymbolId, OrderBook& book) { orders = book.getOrderCount(); });
+    CHECK(orders == 10);
+
+    std::cout << "Visit books test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testUnconsumedResultsDoNotWedge);
+    RUN_TEST(testResultHandlerSeesTrades);
+    RUN_TEST(testVisitBooksWhileRunning);
+    std::cout << "All MatchingRuntime tests passed!" << std::endl;
+    return 0;
+}
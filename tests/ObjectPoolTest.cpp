@@ -0,0 +1,162 @@
+#include "orderbook/Utilities/ObjectPool.hpp"
+#include "TestSupport.hpp"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Records who holds it, so a double hand-out is caught
+struct Tracked {
+    std::atomic<int> owner{0};
+    int resets = 0;
+
+    void reset() { ++resets; }
+};
+
+using Pool = LockFreeObjectPool<Tracked, 8>;
+
+void claim(Tracked& object, int who) {
+    int expected = 0;
+    CHECK(object.owner.compare_exchange_strong(expected, who));
+}
+
+void release(Tracked& object, int who) {
+    int expected = who;
+    CHECK(object.owner.compare_exchange_strong(expected, 0));
+}
+
+}
+
+void testReuseAndGrowth() {
+    Pool pool(16);
+    auto stats = pool.getStats();
+    CHECK(stats.pool_size >= 16 && stats.available == stats.pool_size);
+    CHECK(stats.total_created == 0);
+
+    // A returned object comes straight back from the thread's cache, reset
+    Tracked* first;
+    {
+        auto object = pool.acquire();
+        first = object.get();
+        CHECK(first->resets == 1);
+    }
+    {
+        auto object = pool.acquire();
+        CHECK(object.get() == first);
+        CHECK(object->resets == 2);
+    }
+
+    // Holding more than the pool has grows it; nothing is handed out twice
+    std::vector<Pool::PooledObject> held;
+    std::set<Tracked*> distinct;
+    size_t initial = pool.getStats().pool_size;
+    for (size_t i = 0; i < initial * 3; ++i) {
+        held.push_back(pool.acquire());
+        CHECK(distinct.insert(held.back().get()).second);
+    }
+    stats = pool.getStats();
+    CHECK(stats.pool_size >= initial * 3);
+    CHECK(stats.total_created > 0);
+    CHECK(stats.available + held.size() == stats.pool_size);
+
+    held.clear();
+    stats = pool.getStats();
+    CHECK(stats.available == stats.pool_size);
+
+    std::cout << "Reuse and growth test passed!" << std::endl;
+}
+
+void testConcurrentAcquireAndCrossThreadReturn() {
+    Pool pool(64);
+    constexpr int Threads = 4;
+    constexpr int Rounds = 20000;
+
+    // Half the objects are returned by whichever thread picks them up next
+    std::mutex handoff_mutex;
+    std::deque<Pool::PooledObject> handoff;
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t <= Threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<Pool::PooledObject> mine;
+            for (int round = 0; round < Rounds; ++round) {
+                auto object = pool.acquire();
+                claim(*object, t);
+                release(*object, t);
+                if (round % 2 == 0) {
+                    std::lock_guard<std::mutex> lock(handoff_mutex);
+                    handoff.push_back(std::move(object));
+                } else {
+                    mine.push_back(std::move(object));
+                }
+                if (mine.size() > 20) {
+                    mine.clear();
+                }
+                std::unique_lock<std::mutex> lock(handoff_mutex);
+                if (handoff.size() > 16) {
+                    Pool::PooledObject other = std::move(handoff.front());
+                    handoff.pop_front();
+                    lock.unlock();      // Returned to this thread's cache
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    handoff.clear();
+
+    // Exited threads handed their caches back
+    auto stats = pool.getStats();
+    CHECK(stats.available == stats.pool_size);
+
+    std::cout << "Concurrent acquire/return test passed!" << std::endl;
+}
+
+void testSwitchingPoolsOnOneThread() {
+    Pool a(8);
+    auto b = std::make_unique<Pool>(8);
+
+    // Alternating pools hands the cache back each time; objects go home
+    for (int i = 0; i < 100; ++i) {
+        auto from_a = a.acquire();
+        auto from_b = b->acquire();
+        CHECK(from_a.get() != from_b.get());
+    }
+    CHECK(a.getStats().available == a.getStats().pool_size);
+    CHECK(b->getStats().available == b->getStats().pool_size);
+
+    // A pool can go while another thread still caches its objects; the
+    // storage lives until that thread exits
+    std::atomic<int> stage{0};
+    std::thread holder([&b, &stage]() {
+        { auto object = b->acquire(); }
+        stage.store(1);
+        while (stage.load() != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while (stage.load() != 1) {
+        std::this_thread::yield();
+    }
+    b.reset();
+    stage.store(2);
+    holder.join();
+    { auto object = a.acquire(); }
+
+    std::cout << "Pool switching test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testReuseAndGrowth);
+    RUN_TEST(testConcurrentAcquireAndCrossThreadReturn);
+    RUN_TEST(testSwitchingPoolsOnOneThread);
+    std::cout << "All ObjectPool tests passed!" << std::endl;
+    return 0;
+}
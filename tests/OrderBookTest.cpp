@@ -0,0 +1,347 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Keeps every book update the book publishes
+class RecordingPublisher : public IMarketDataPublisher {
+public:
+    std::vector<BookUpdate> updates;
+    std::vector<Trade> trades;
+
+    void publishTrade(const Trade& trade) override { trades.push_back(trade); }
+    void publishBookUpdate(const BookUpdate& update) override { updates.push_back(update); }
+    void publishBestPrices(const BestPrices&) override {}
+    void publishDepth(const MarketDepth&) override {}
+    void subscribe(std::function<void(const std::string&)>) override {}
+
+    const BookUpdate* lastAt(Side side, Price price) const {
+        for (auto it = updates.rbegin(); it != updates.rend(); ++it) {
+            if (it->side == side && it->price == price) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// Remembers which kind of command each journaled request was
+class RecordingJournal : public IOrderJournal {
+public:
+    std::vector<char> commands;
+
+    void recordAdd(SymbolId, const Order&) override { commands.push_back('A'); }
+    void recordCancel(SymbolId, OrderId) override { commands.push_back('C'); }
+    void recordModify(SymbolId, OrderId, Price, Quantity) override { commands.push_back('M'); }
+    void recordTrade(const Trade&) override {}
+};
+
+OrderBook::BookConfig bookConfig() {
+    OrderBook::BookConfig config;
+    config.symbol = "BOOK";
+    return config;
+}
+
+// Level state a feed consumer rebuilds by applying each update in turn
+std::map<std::pair<Side, Price>, std::pair<Quantity, size_t>> replayLevels(const std::vector<BookUpdate>& updates) {
+    std::map<std::pair<Side, Price>, std::pair<Quantity, size_t>> levels;
+    for (const BookUpdate& update : updates) {
+        auto key = std::make_pair(update.side, update.price);
+        if (update.type == BookUpdate::Type::Remove) {
+            CHECK(update.quantity == 0 && update.order_count == 0);
+            levels.erase(key);
+        } else {
+            CHECK(update.order_count > 0);
+            levels[key] = std::make_pair(update.quantity, update.order_count);
+        }
+    }
+    return levels;
+}
+
+Order limit(uint64_t id, Side side, Price price, Quantity quantity, const char* account = "a",
+            TimeInForce tif = TimeInForce::GTC) {
+    return Order(id, side, OrderType::Limit, tif, price, quantity, "BOOK", account);
+}
+
+}
+
+void testFilledOrderLeavesCorrectLevelCount() {
+    auto publisher = std::make_shared<RecordingPublisher>();
+    OrderBook book(nullptr, publisher, nullptr, bookConfig());
+
+    // A single-order level filled completely reports an empty level
+    CHECK(book.addOrder(limit(1, Side::Sell, 100.00, 10)).isSuccess());
+    publisher->updates.clear();
+    CHECK(book.addOrder(limit(2, Side::Buy, 100.00, 10, "b")).isSuccess());
+    const BookUpdate* update = publisher->lastAt(Side::Sell, 100.00);
+    CHECK(update && update->type == BookUpdate::Type::Remove);
+    CHECK(update->order_count == 0);
+    CHECK(book.getAskLevelCount() == 0);
+
+    // Filling the first of two orders leaves one
+    CHECK(book.addOrder(limit(3, Side::Sell, 101.00, 5)).isSuccess());
+    CHECK(book.addOrder(limit(4, Side::Sell, 101.00, 7)).isSuccess());
+    publisher->updates.clear();
+    CHECK(book.addOrder(limit(5, Side::Buy, 101.00, 5, "b")).isSuccess());
+    update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->order_count == 1);
+
+    std::cout << "Filled order level count test passed!" << std::endl;
+}
+
+void testMassCancelByAccount() {
+    auto publisher = std::make_shared<RecordingPublisher>();
+    OrderBook book(nullptr, publisher, nullptr, bookConfig());
+
+    // Account "a" alone at 99.00, shares 99.50 with "b", and has an ask
+    CHECK(book.addOrder(limit(1, Side::Buy, 99.00, 10, "a")).isSuccess());
+    CHECK(book.addOrder(limit(2, Side::Buy, 99.50, 10, "a")).isSuccess());
+    CHECK(book.addOrder(limit(3, Side::Buy, 99.50, 20, "b")).isSuccess());
+    CHECK(book.addOrder(limit(4, Side::Sell, 101.00, 5, "a")).isSuccess());
+    CHECK(book.addOrder(limit(5, Side::Sell, 102.00, 5, "b")).isSuccess());
+    publisher->updates.clear();
+
+    std::vector<OrderId> cancelled;
+    CHECK(book.cancelAccountOrders(InternTable::accounts().intern("a"), &cancelled) == 3);
+    std::sort(cancelled.begin(), cancelled.end(),
+              [](OrderId x, OrderId y) { return x.value < y.value; });
+    CHECK(cancelled.size() == 3 && cancelled[0].value == 1 && cancelled[1].value == 2 && cancelled[2].value == 4);
+
+    CHECK(book.getOrderCount() == 2);
+    CHECK(book.getBidLevelCount() == 1 && book.bestBid() == 99.50);
+    CHECK(book.bestAsk() == 102.00);
+
+    // One update per touched level, describing it after the sweep
+    CHECK(publisher->updates.size() == 3);
+    const BookUpdate* emptied = publisher->lastAt(Side::Buy, 99.00);
+    CHECK(emptied && emptied->type == BookUpdate::Type::Remove && emptied->order_count == 0);
+    const BookUpdate* shared = publisher->lastAt(Side::Buy, 99.50);
+    CHECK(shared && shared->type == BookUpdate::Type::Modify && shared->order_count == 1);
+    CHECK(shared->quantity == 20);
+
+    // Cancelling again finds nothing; explicit IDs skip unknown ones
+    CHECK(book.cancelAccountOrders(InternTable::accounts().intern("a")) == 0);
+    OrderId ids[] = {OrderId(3), OrderId(99)};
+    CHECK(book.cancelOrders(ids, 2) == 1);
+    CHECK(book.getBidLevelCount() == 0);
+
+    CHECK(book.cancelAllOrders() == 1);
+    CHECK(book.getOrderCount() == 0);
+    CHECK(!book.bestAsk().has_value());
+
+    // The book keeps matching normally afterwards
+    CHECK(book.addOrder(limit(6, Side::Sell, 100.00, 5, "a")).isSuccess());
+    CHECK(book.addOrder(limit(7, Side::Buy, 100.00, 5, "b")).isSuccess());
+    CHECK(book.getOrderCount() == 0);
+
+    std::cout << "Mass cancel test passed!" << std::endl;
+}
+
+void testBatchAndSingleUpdatesAgree() {
+    SymbolId symbol = InternTable::symbols().intern("BOOK");
+    std::vector<BookCommand> commands = {
+        BookCommand::add(limit(1, Side::Buy, 99.00, 10)),
+        BookCommand::add(limit(2, Side::Buy, 99.00, 15)),
+        BookCommand::add(limit(3, Side::Sell, 101.00, 8)),
+        BookCommand::add(limit(4, Side::Sell, 101.00, 4)),
+        BookCommand::add(limit(5, Side::Buy, 101.00, 10, "b")),       // Fills 3, part of 4
+        BookCommand::modify(symbol, OrderId(2), 99.00, 5),             // Same level, smaller
+        BookCommand::modify(symbol, OrderId(1), 98.00, 0),             // Moves to a new level
+        BookCommand::add(limit(6, Side::Buy, 97.00, 3)),
+        BookCommand::cancel(symbol, OrderId(6)),                       // Level comes and goes
+    };
+
+    auto single_publisher = std::make_shared<RecordingPublisher>();
+    OrderBook single(nullptr, single_publisher, nullptr, bookConfig());
+    for (const BookCommand& command : commands) {
+        switch (command.type) {
+            case BookCommand::Type::Add:
+                CHECK(single.addOrder(command.order).isSuccess());
+                break;
+            case BookCommand::Type::Modify:
+                CHECK(single.modifyOrder(command.order.id, command.order.price, command.order.quantity).isSuccess());
+                break;
+            case BookCommand::Type::Cancel:
+                CHECK(single.cancelOrder(command.order.id).isSuccess());
+                break;
+            case BookCommand::Type::MassCancel:
+                break;
+        }
+    }
+
+    auto batch_publisher = std::make_shared<RecordingPublisher>();
+    OrderBook batched(nullptr, batch_publisher, nullptr, bookConfig());
+    std::vector<BookCommandResult> results;
+    batched.applyBatch(commands, results);
+    for (const auto& applied : results) {
+        CHECK(applied.success);
+    }
+
+    // Per-operation and per-batch updates both carry level totals, so
+    // replaying either stream gives the same book
+    auto from_single = replayLevels(single_publisher->updates);
+    auto from_batch = replayLevels(batch_publisher->updates);
+    CHECK(from_single == from_batch);
+    CHECK(from_single.size() == 3);
+    CHECK((from_single[{Side::Buy, 99.00}] == std::make_pair(Quantity{5}, size_t{1})));
+    CHECK((from_single[{Side::Buy, 98.00}] == std::make_pair(Quantity{10}, size_t{1})));
+    CHECK((from_single[{Side::Sell, 101.00}] == std::make_pair(Quantity{2}, size_t{1})));
+
+    // Each level is reported once per batch; a level created and emptied inside it not at all
+    CHECK(batch_publisher->updates.size() == 3);
+    CHECK(batch_publisher->lastAt(Side::Buy, 97.00) == nullptr);
+
+    std::cout << "Batch/single update agreement test passed!" << std::endl;
+}
+
+void testModifyToFilledQuantityCancels() {
+    auto publisher = std::make_shared<RecordingPublisher>();
+    auto journal = std::make_shared<RecordingJournal>();
+    OrderBook book(nullptr, publisher, nullptr, bookConfig());
+    book.setJournal(journal);
+
+    // Orders 1 and 3 share 101.00; 1 has filled 4 of 10, and 4 has filled 2 of 8
+    CHECK(book.addOrder(limit(1, Side::Sell, 101.00, 10)).isSuccess());
+    CHECK(book.addOrder(limit(2, Side::Buy, 101.00, 4, "b")).isSuccess());
+    CHECK(book.addOrder(limit(3, Side::Sell, 101.00, 5)).isSuccess());
+    CHECK(book.addOrder(limit(4, Side::Buy, 99.00, 8)).isSuccess());
+    CHECK(book.addOrder(limit(5, Side::Sell, 99.00, 2, "b")).isSuccess());
+    publisher->updates.clear();
+    journal->commands.clear();
+
+    // Cut to exactly what has filled: gone, and the level reports the survivor
+    CHECK(book.modifyOrder(OrderId(1), 0, 4).isSuccess());
+    CHECK(book.getOrderCount() == 2);
+    const BookUpdate* update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->type == BookUpdate::Type::Modify);
+    CHECK(update->quantity == 5 && update->order_count == 1);
+
+    // Cut below what has filled, with a price change: the level empties
+    // and no level appears at the new price
+    CHECK(book.modifyOrder(OrderId(4), 98.00, 1).isSuccess());
+    update = publisher->lastAt(Side::Buy, 99.00);
+    CHECK(update && update->type == BookUpdate::Type::Remove && update->order_count == 0);
+    CHECK(publisher->lastAt(Side::Buy, 98.00) == nullptr);
+    CHECK(book.getBidLevelCount() == 0 && book.bestAsk() == 101.00);
+
+    // Both were journaled as cancels, so a replay removes them the same way
+    CHECK((journal->commands == std::vector<char>{'C', 'C'}));
+    CHECK(book.modifyOrder(OrderId(1), 0, 2).isError());
+
+    // A cut that leaves something open still modifies
+    CHECK(book.modifyOrder(OrderId(3), 0, 3).isSuccess());
+    CHECK(journal->commands.back() == 'M');
+    CHECK(book.getOrderCount() == 1);
+
+    std::cout << "Modify to filled quantity test passed!" << std::endl;
+}
+
+void testImmediateOrders() {
+    auto publisher = std::make_shared<RecordingPublisher>();
+    OrderBook book(nullptr, publisher, nullptr, bookConfig());
+
+    CHECK(book.addOrder(limit(1, Side::Sell, 101.00, 5)).isSuccess());
+    CHECK(book.addOrder(limit(2, Side::Sell, 102.00, 5)).isSuccess());
+    CHECK(book.addOrder(limit(3, Side::Buy, 99.00, 10)).isSuccess());
+    publisher->updates.clear();
+    MarketDepth before = book.getDepth(10);
+
+    // A FOK the book cannot fill completely is killed whole, yet accepted
+    CHECK(book.addOrder(limit(4, Side::Buy, 102.00, 11, "b", TimeInForce::FOK)).isSuccess());
+    CHECK(book.addOrder(limit(5, Side::Buy, 101.00, 6, "b", TimeInForce::FOK)).isSuccess());
+    CHECK(publisher->trades.empty() && publisher->updates.empty());
+    CHECK(book.getOrderCount() == 3);
+    MarketDepth after = book.getDepth(10);
+    CHECK(after.asks.size() == before.asks.size() && after.bids.size() == before.bids.size());
+    for (size_t i = 0; i < after.asks.size(); ++i) {
+        CHECK(after.asks[i].price == before.asks[i].price && after.asks[i].quantity == before.asks[i].quantity);
+    }
+
+    // One that can fills completely, across levels
+    CHECK(book.addOrder(limit(6, Side::Buy, 102.00, 8, "b", TimeInForce::FOK)).isSuccess());
+    CHECK(publisher->trades.size() == 2);
+    CHECK(publisher->trades[0].price == 101.00 && publisher->trades[0].quantity == 5);
+    CHECK(publisher->trades[1].price == 102.00 && publisher->trades[1].quantity == 3);
+    CHECK(book.getAskLevelCount() == 1 && book.bestAsk() == 102.00);
+    const BookUpdate* update = publisher->lastAt(Side::Sell, 102.00);
+    CHECK(update && update->quantity == 2);
+    CHECK(publisher->lastAt(Side::Buy, 102.00) == nullptr);
+
+    // An IOC remainder is dropped: never indexed, never published as an Add
+    publisher->updates.clear();
+    publisher->trades.clear();
+    CHECK(book.addOrder(limit(7, Side::Sell, 99.00, 15, "b", TimeInForce::IOC)).isSuccess());
+    CHECK(publisher->trades.size() == 1 && publisher->trades[0].quantity == 10);
+    CHECK(publisher->updates.size() == 1);
+    update = publisher->lastAt(Side::Buy, 99.00);
+    CHECK(update && update->type == BookUpdate::Type::Remove);
+    CHECK(publisher->lastAt(Side::Sell, 99.00) == nullptr);
+    CHECK(book.getOrderCount() == 1 && book.getBidLevelCount() == 0);
+    CHECK(book.cancelOrder(OrderId(7)).isError());
+
+    // A market order against an empty side does nothing
+    CHECK(book.addOrder(limit(8, Side::Buy, 98.00, 1)).isSuccess());
+    CHECK(book.cancelOrder(OrderId(2)).isSuccess());
+    publisher->updates.clear();
+    publisher->trades.clear();
+    CHECK(book.addOrder(Order(9, Side::Buy, OrderType::Market, TimeInForce::IOC, 0.0, 5, "BOOK", "b")).isSuccess());
+    CHECK(publisher->trades.empty() && publisher->updates.empty());
+    CHECK(book.getOrderCount() == 1 && book.bestBid() == 98.00 && !book.bestAsk().has_value());
+
+    std::cout << "Immediate order test passed!" << std::endl;
+}
+
+void testSamePriceModifyPriority() {
+    auto publisher = std::make_shared<RecordingPublisher>();
+    OrderBook book(nullptr, publisher, nullptr, bookConfig());
+
+    CHECK(book.addOrder(limit(1, Side::Sell, 101.00, 10)).isSuccess());
+    CHECK(book.addOrder(limit(2, Side::Sell, 101.00, 10)).isSuccess());
+
+    // A reduction is applied in place and the level reports its new total
+    CHECK(book.modifyOrder(OrderId(1), 0, 6).isSuccess());
+    const BookUpdate* update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->type == BookUpdate::Type::Modify);
+    CHECK(update->quantity == 16 && update->order_count == 2);
+    CHECK(book.getDepth(1).asks[0].quantity == 16);
+
+    // ... and keeps the order at the front of the queue
+    CHECK(book.addOrder(limit(3, Side::Buy, 101.00, 4, "b")).isSuccess());
+    CHECK(publisher->trades.size() == 1 && publisher->trades[0].sell_order_id.value == 1);
+    update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->quantity == 12 && update->order_count == 2);
+
+    // An increase sends it behind order 2
+    CHECK(book.modifyOrder(OrderId(1), 0, 12).isSuccess());
+    update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->type == BookUpdate::Type::Modify);
+    CHECK(update->quantity == 18 && update->order_count == 2);
+    CHECK(book.getDepth(1).asks[0].quantity == 18);
+
+    publisher->trades.clear();
+    CHECK(book.addOrder(limit(4, Side::Buy, 101.00, 12, "b")).isSuccess());
+    CHECK(publisher->trades.size() == 2);
+    CHECK(publisher->trades[0].sell_order_id.value == 2 && publisher->trades[0].quantity == 10);
+    CHECK(publisher->trades[1].sell_order_id.value == 1 && publisher->trades[1].quantity == 2);
+    update = publisher->lastAt(Side::Sell, 101.00);
+    CHECK(update && update->quantity == 6 && update->order_count == 1);
+    CHECK(book.getDepth(1).asks[0].quantity == 6);
+
+    std::cout << "Same-price modify priority test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testFilledOrderLeavesCorrectLevelCount);
+    RUN_TEST(testMassCancelByAccount);
+    RUN_TEST(testBatchAndSingleUpdatesAgree);
+    RUN_TEST(testModifyToFilledQuantityCancels);
+    RUN_TEST(testImmediateOrders);
+    RUN_TEST(testSamePriceModifyPriority);
+    std::cout << "All OrderBook tests passed!" << std::endl;
+    return 0;
+}
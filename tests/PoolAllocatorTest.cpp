@@ -0,0 +1,108 @@
+#include "orderbook/Utilities/MemoryAllocators.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <set>
+#include <vector>
+
+using namespace orderbook;
+
+void testConstructDestroyReuse() {
+    PoolAllocator<PriceLevel, 1024> pool;
+    size_t initial_capacity = pool.capacity();
+    CHECK(initial_capacity == PoolAllocator<PriceLevel, 1024>::OBJECTS_PER_BLOCK);
+
+    PriceLevel* a = pool.construct(100.0, 10000);
+    PriceLevel* b = pool.construct(101.0, 10100);
+    CHECK(a != b);
+    CHECK(a->ticks == 10000);
+    CHECK(b->price == 101.0);
+    CHECK(pool.in_use() == 2);
+
+    // A freed slot is handed out again before the pool grows
+    pool.destroy(a);
+    CHECK(pool.in_use() == 1);
+    PriceLevel* c = pool.construct(102.0, 10200);
+    CHECK(c == a);
+    CHECK(c->ticks == 10200 && c->order_count == 0);
+    CHECK(pool.capacity() == initial_capacity);
+
+    pool.destroy(b);
+    pool.destroy(c);
+    CHECK(pool.in_use() == 0);
+
+    std::cout << "Construct/destroy reuse test passed!" << std::endl;
+}
+
+void testGrowthKeepsObjectsInPlace() {
+    PoolAllocator<PriceLevel, 1024> pool;
+    std::vector<PriceLevel*> levels;
+    size_t count = pool.capacity() * 5 + 3;
+    for (size_t i = 0; i < count; ++i) {
+        levels.push_back(pool.construct(static_cast<Price>(i), static_cast<PriceTicks>(i)));
+    }
+    CHECK(pool.in_use() == count);
+    CHECK(pool.capacity() >= count);
+
+    // Growing adds blocks; nothing already handed out moves
+    std::set<PriceLevel*> distinct(levels.begin(), levels.end());
+    CHECK(distinct.size() == count);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(levels[i]->ticks == static_cast<PriceTicks>(i));
+    }
+
+    pool.reserve(count * 2);
+    CHECK(pool.capacity() >= count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(levels[i]->ticks == static_cast<PriceTicks>(i));
+        pool.destroy(levels[i]);
+    }
+    CHECK(pool.in_use() == 0);
+
+    std::cout << "Growth stability test passed!" << std::endl;
+}
+
+void testLevelsStayValidAcrossInserts() {
+    // Sorted-vector mode inserts level pointers into the middle of the vector;
+    // order locations must keep pointing at the right levels
+    for (auto storage : {OrderBook::BookConfig::StorageMode::SortedVector,
+                         OrderBook::BookConfig::StorageMode::Ladder}) {
+        OrderBook::BookConfig config;
+        config.symbol = "POOL";
+        config.storage = storage;
+        OrderBook book(nullptr, nullptr, nullptr, config);
+
+        uint64_t id = 1;
+        // Interleave prices so every insert lands between existing levels
+        for (int round = 0; round < 4; ++round) {
+            for (int level = round; level < 200; level += 4) {
+                Price price = 100.00 - level * 0.01;
+                CHECK(book.addOrder(Order(id++, Side::Buy, OrderType::Limit, TimeInForce::GTC,
+                                          price, 1, "POOL", "a")).isSuccess());
+            }
+        }
+        CHECK(book.getBidLevelCount() == 200);
+        CHECK(book.bestBid() == 100.00);
+
+        // Cancels go through OrderLocation::price_level; every level must empty cleanly
+        for (uint64_t cancel = 1; cancel < id; cancel += 2) {
+            CHECK(book.cancelOrder(OrderId(cancel)).isSuccess());
+        }
+        CHECK(book.getBidLevelCount() == 100);
+        for (uint64_t cancel = 2; cancel < id; cancel += 2) {
+            CHECK(book.cancelOrder(OrderId(cancel)).isSuccess());
+        }
+        CHECK(book.getBidLevelCount() == 0);
+        CHECK(book.getOrderCount() == 0);
+        CHECK(!book.bestBid().has_value());
+    }
+
+    std::cout << "Level stability test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testConstructDestroyReuse);
+    RUN_TEST(testGrowthKeepsObjectsInPlace);
+    RUN_TEST(testLevelsStayValidAcrossInserts);
+    std::cout << "All PoolAllocator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "orderbook/Core/PriceLadder.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <deque>
+
+using namespace orderbook;
+
+namespace {
+
+// Levels outlive the ladder that points at them
+PriceLevel* makeLevel(std::deque<PriceLevel>& levels, PriceTicks ticks) {
+    levels.emplace_back(static_cast<Price>(ticks) * 0.01, ticks);
+    return &levels.back();
+}
+
+}
+
+void testBestAndNextOrdering() {
+    std::deque<PriceLevel> levels;
+    PriceLadder bids(Side::Buy, 64);
+    PriceLadder asks(Side::Sell, 64);
+
+    for (PriceTicks ticks : {100, 103, 98, 101}) {
+        CHECK(bids.insert(makeLevel(levels, ticks)));
+        CHECK(asks.insert(makeLevel(levels, ticks)));
+    }
+    CHECK(bids.size() == 4);
+
+    // Bids walk down from the highest price, asks up from the lowest
+    PriceTicks expected_bids[] = {103, 101, 100, 98};
+    size_t i = 0;
+    for (const PriceLevel* level = bids.best(); level; level = bids.next(level)) {
+        CHECK(level->ticks == expected_bids[i++]);
+    }
+    CHECK(i == 4);
+
+    PriceTicks expected_asks[] = {98, 100, 101, 103};
+    i = 0;
+    asks.forEachFromBest(3, [&](const PriceLevel& level) { CHECK(level.ticks == expected_asks[i++]); });
+    CHECK(i == 3);
+
+    // Erasing the best moves the cursor to the next occupied slot
+    bids.erase(103);
+    CHECK(bids.best()->ticks == 101);
+    asks.erase(98);
+    asks.erase(100);
+    CHECK(asks.best()->ticks == 101);
+    CHECK(asks.find(100) == nullptr);
+
+    std::cout << "Best and next ordering test passed!" << std::endl;
+}
+
+void testReanchorKeepsLevels() {
+    std::deque<PriceLevel> levels;
+    PriceLadder asks(Side::Sell, 64);
+
+    CHECK(asks.insert(makeLevel(levels, 1000)));
+    CHECK(asks.insert(makeLevel(levels, 1010)));
+    size_t initial_capacity = asks.capacity();
+
+    // Well outside the initial window on both sides
+    CHECK(asks.insert(makeLevel(levels, 5000)));
+    CHECK(asks.insert(makeLevel(levels, 10)));
+    CHECK(asks.capacity() > initial_capacity);
+    CHECK(asks.size() == 4);
+
+    for (PriceTicks ticks : {10, 1000, 1010, 5000}) {
+        CHECK(asks.find(ticks) != nullptr);
+        CHECK(asks.find(ticks)->ticks == ticks);
+    }
+    CHECK(asks.best()->ticks == 10);
+    CHECK(asks.next(asks.best())->ticks == 1000);
+
+    std::cout << "Re-anchor test passed!" << std::endl;
+}
+
+void testPriceBandRejectsFarLevels() {
+    std::deque<PriceLevel> levels;
+    PriceLadder bids(Side::Buy, 64, nullptr, 1024);
+    CHECK(bids.maxCapacity() == 1024);
+
+    CHECK(bids.insert(makeLevel(levels, 100000)));
+    CHECK(bids.insert(makeLevel(levels, 100500)));
+
+    // Span up to the band fits; one tick past it does not
+    CHECK(bids.fits(100000 + 1023));
+    CHECK(!bids.fits(100000 + 1024));
+    CHECK(!bids.fits(100000 + 10000000));
+
+    size_t capacity = bids.capacity();
+    PriceTicks anchor = bids.anchor();
+    CHECK(!bids.insert(makeLevel(levels, 100000 + 10000000)));
+
+    // A refused insert leaves the ladder exactly as it was
+    CHECK(bids.size() == 2);
+    CHECK(bids.capacity() == capacity);
+    CHECK(bids.anchor() == anchor);
+    CHECK(bids.best()->ticks == 100500);
+    CHECK(bids.next(bids.best())->ticks == 100000);
+
+    // And it keeps accepting prices inside the band
+    CHECK(bids.insert(makeLevel(levels, 100900)));
+    CHECK(bids.best()->ticks == 100900);
+    CHECK(bids.capacity() <= 1024);
+
+    std::cout << "Price band test passed!" << std::endl;
+}
+
+void testBookRejectsOrdersOutsideBand() {
+    OrderBook::BookConfig config;
+    config.symbol = "BAND";
+    config.ladder_levels = 64;
+    config.ladder_max_levels = 4096;
+    OrderBook book(nullptr, nullptr, nullptr, config);
+
+    CHECK(book.addOrder(Order(1, Side::Buy, OrderType::Limit, TimeInForce::GTC, 100.00, 10, "BAND", "a")).isSuccess());
+    CHECK(book.addOrder(Order(2, Side::Sell, OrderType::Limit, TimeInForce::GTC, 100.05, 10, "BAND", "a")).isSuccess());
+
+    // 1e7 ticks away: refused before matching, and nothing is left behind
+    auto far = book.addOrder(Order(3, Side::Sell, OrderType::Limit, TimeInForce::GTC, 100000.00, 5, "BAND", "a"));
+    CHECK(far.isError());
+    CHECK(book.getOrderCount() == 2);
+    CHECK(book.getAskLevelCount() == 1);
+    CHECK(book.bestAsk() == 100.05);
+
+    // The book keeps working afterwards
+    CHECK(book.addOrder(Order(4, Side::Sell, OrderType::Limit, TimeInForce::GTC, 100.10, 5, "BAND", "a")).isSuccess());
+    CHECK(book.getAskLevelCount() == 2);
+    CHECK(book.addOrder(Order(5, Side::Buy, OrderType::Limit, TimeInForce::GTC, 100.10, 15, "BAND", "a")).isSuccess());
+    CHECK(book.getAskLevelCount() == 0);
+
+    // Moving a resting order out of the band fails and leaves it in place
+    CHECK(book.modifyOrder(OrderId(1), 50000.00, 0).isError());
+    CHECK(book.bestBid() == 100.00);
+    CHECK(book.getOrderCount() == 1);
+
+    std::cout << "Book price band test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testBestAndNextOrdering);
+    RUN_TEST(testReanchorKeepsLevels);
+    RUN_TEST(testPriceBandRejectsFarLevels);
+    RUN_TEST(testBookRejectsOrdersOutsideBand);
+    std::cout << "All PriceLadder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "orderbook/Utilities/RingBuffer.hpp"
+#include "TestSupport.hpp"
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+void testSpscFullAndWrap() {
+    SpscRing<int> ring(5);
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.empty());
+
+    // Many laps around the ring; full at capacity, FIFO throughout
+    int next_push = 0;
+    int next_pop = 0;
+    for (int lap = 0; lap < 10; ++lap) {
+        while (ring.tryPush(next_push)) {
+            ++next_push;
+        }
+        CHECK(ring.size() == ring.capacity());
+
+        int value = -1;
+        for (int i = 0; i < 3; ++i) {
+            CHECK(ring.tryPop(value) && value == next_pop++);
+        }
+        size_t drained = ring.drain(2, [&next_pop](int& item) { CHECK(item == next_pop++); });
+        CHECK(drained == 2);
+    }
+
+    size_t drained = ring.drain(100, [&next_pop](int& item) { CHECK(item == next_pop++); });
+    CHECK(drained == 3);
+    CHECK(next_pop == next_push);
+    int value;
+    CHECK(!ring.tryPop(value));
+
+    // claim()/commit() publish in place
+    *ring.claim() = 42;
+    ring.commit();
+    CHECK(ring.tryPop(value) && value == 42);
+
+    std::cout << "SPSC full/wrap test passed!" << std::endl;
+}
+
+void testSpscAcrossThreads() {
+    SpscRing<uint64_t> ring(64);
+    constexpr uint64_t Count = 200000;
+
+    std::thread producer([&ring]() {
+        for (uint64_t i = 0; i < Count; ++i) {
+            while (!ring.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < Count) {
+        ring.drain(32, [&expected](uint64_t& item) { CHECK(item == expected++); });
+    }
+    producer.join();
+    CHECK(ring.empty());
+
+    std::cout << "SPSC threaded test passed!" << std::endl;
+}
+
+void testMpscKeepsPerProducerOrder() {
+    MpscRing<uint64_t> ring(128);
+    constexpr uint64_t Producers = 4;
+    constexpr uint64_t PerProducer = 50000;
+
+    // Each value carries its producer in the top bits and a sequence below
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < Producers; ++p) {
+        producers.emplace_back([&ring, p]() {
+            for (uint64_t i = 0; i < PerProducer; ++i) {
+                while (!ring.tryPush((p << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint64_t> next(Producers, 0);
+    uint64_t received = 0;
+    while (received < Producers * PerProducer) {
+        received += ring.drain(64, [&next](uint64_t& item) {
+            uint64_t producer = item >> 32;
+            CHECK(producer < Producers);
+            CHECK((item & 0xFFFFFFFF) == next[producer]);
+            ++next[producer];
+        });
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+    for (uint64_t count : next) {
+        CHECK(count == PerProducer);
+    }
+
+    uint64_t value;
+    CHECK(!ring.tryPop(value));
+    CHECK(ring.tryPush(uint64_t{7}) && ring.tryPop(value) && value == 7);
+
+    std::cout << "MPSC ordering test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testSpscFullAndWrap);
+    RUN_TEST(testSpscAcrossThreads);
+    RUN_TEST(testMpscKeepsPerProducerOrder);
+    std::cout << "All RingBuffer tests passed!" << std::endl;
+    return 0;
+}
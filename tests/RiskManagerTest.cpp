@@ -0,0 +1,65 @@
+#include "orderbook/Risk/RiskManager.hpp"
+#include "TestSupport.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+Order limit(uint64_t id, Quantity quantity, Price price) {
+    return Order(id, Side::Buy, OrderType::Limit, TimeInForce::GTC, price, quantity, "RISK", "a");
+}
+
+}
+
+void testChecksSeeWholeLimitSets() {
+    // Each set rejects the probe order for a different reason; only a mix of
+    // the two (size from one, price range from the other) would pass it
+    RiskManager::RiskLimits small_orders;
+    small_orders.max_order_size = 100;
+    small_orders.max_price = 200.0;
+    RiskManager::RiskLimits low_prices;
+    low_prices.max_order_size = 200;
+    low_prices.max_price = 100.0;
+
+    RiskManager risk(small_orders);
+    std::atomic<bool> done{false};
+    std::thread reloader([&]() {
+        for (int i = 0; i < 20000; ++i) {
+            risk.setLimits(i % 2 ? small_orders : low_prices);
+        }
+        done.store(true);
+    });
+
+    std::vector<std::thread> checkers;
+    for (int t = 0; t < 2; ++t) {
+        checkers.emplace_back([&]() {
+            uint64_t id = 0;
+            do {
+                CHECK(risk.checkOrderStateless(limit(++id, 150, 150.0)).isRejected());
+                CHECK(!risk.checkOrderStateless(limit(++id, 50, 50.0)).isRejected());
+            } while (!done.load());
+        });
+    }
+    reloader.join();
+    for (auto& checker : checkers) {
+        checker.join();
+    }
+
+    // The position table keeps its construction size across updates
+    RiskManager::RiskLimits resized = small_orders;
+    resized.max_accounts = 1;
+    risk.setLimits(resized);
+    CHECK(risk.getLimits().max_accounts == small_orders.max_accounts);
+    CHECK(risk.getLimits().max_order_size == 100);
+
+    std::cout << "Whole limit set test passed!" << std::endl;
+}
+
+int main() {
+    RUN_TEST(testChecksSeeWholeLimitSets);
+    std::cout << "All RiskManager tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Minimal checks for the behaviour tests
+ *
+ * Unlike assert(), CHECK stays active in Release builds, where NDEBUG is set.
+ */
+#define CHECK(...)                                                                          \
+    do {                                                                                    \
+        if (!(__VA_ARGS__)) {                                                               \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #__VA_ARGS__    \
+                      << std::endl;                                                         \
+            std::exit(1);                                                                   \
+        }                                                                                   \
+    } while (0)
+
+#define RUN_TEST(test)                                                                      \
+    do {                                                                                    \
+        std::cout << "Running " #test "..." << std::endl;                                   \
+        test();                                                                             \
+    } while (0)